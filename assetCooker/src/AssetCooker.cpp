@@ -0,0 +1,345 @@
+#include "AssetCooker.hpp"
+#include "platypus/core/Debug.hpp"
+#include "platypus/assets/Image.hpp"
+#include "platypus/assets/Font.hpp"
+#include "platypus/utils/UUID.hpp"
+#include "platypus/utils/FileUtils.hpp"
+#include "platypus/utils/Hash.hpp"
+#include "platypus/utils/ImageDataUtils.hpp"
+#include "platypus/utils/modelLoading/ModelLoading.hpp"
+#include "platypus/utils/modelLoading/CookedModel.hpp"
+
+#include <json.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <cctype>
+#include <cinttypes>
+
+
+namespace platypus
+{
+    namespace assetCooker
+    {
+        static const char* s_manifestFilename = "cook-manifest.txt";
+        // Bump this if the cooker's output changes without the formats' versions changing
+        static const uint32_t s_cookerVersion = 1;
+
+        static std::string to_lower(const std::string& str)
+        {
+            std::string lower = str;
+            std::transform(
+                lower.begin(),
+                lower.end(),
+                lower.begin(),
+                [](unsigned char c) { return (char)std::tolower(c); }
+            );
+            return lower;
+        }
+
+        // Normal maps and such have to stay in linear space.
+        // NOTE: There's no per asset import settings, so going by the name
+        static bool is_srgb_image(const std::string& sourcePath)
+        {
+            const std::string filename = to_lower(std::filesystem::path(sourcePath).filename().string());
+            return filename.find("normal") == std::string::npos;
+        }
+
+        std::string get_cooked_extension(const std::string& sourcePath)
+        {
+            const std::string extension = to_lower(std::filesystem::path(sourcePath).extension().string());
+            if (extension == ".gltf" || extension == ".glb")
+                return cooked_model_extension;
+            if (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" || extension == ".bmp")
+                return cooked_image_extension;
+            if (extension == ".ttf" || extension == ".otf")
+                return cooked_font_extension;
+            return "";
+        }
+
+        std::vector<std::string> get_gltf_dependencies(const std::string& gltfPath)
+        {
+            std::vector<std::string> dependencies;
+            std::ifstream file(gltfPath);
+            if (!file.is_open())
+                return dependencies;
+
+            nlohmann::json gltf = nlohmann::json::parse(file, nullptr, false);
+            if (gltf.is_discarded() || !gltf.contains("buffers"))
+                return dependencies;
+
+            const std::filesystem::path gltfDir = std::filesystem::path(gltfPath).parent_path();
+            for (const nlohmann::json& buffer : gltf["buffers"])
+            {
+                if (!buffer.contains("uri") || !buffer["uri"].is_string())
+                    continue;
+                const std::string uri = buffer["uri"].get<std::string>();
+                // Embedded buffers are already part of the .gltf's content
+                if (uri.rfind("data:", 0) == 0)
+                    continue;
+                dependencies.push_back((gltfDir / uri).string());
+            }
+            return dependencies;
+        }
+
+        AssetCooker::AssetCooker(
+            const std::string& inputDir,
+            const std::string& outputDir,
+            const CookSettings& settings
+        ) :
+            _inputDir(inputDir),
+            _outputDir(outputDir),
+            _settings(settings)
+        {
+        }
+
+        bool AssetCooker::cookAll()
+        {
+            if (!std::filesystem::is_directory(_inputDir))
+            {
+                Debug::log(
+                    "Input directory: " + _inputDir + " doesn't exist",
+                    PLATYPUS_CURRENT_FUNC_NAME,
+                    Debug::MessageType::PLATYPUS_ERROR
+                );
+                return false;
+            }
+            std::filesystem::create_directories(_outputDir);
+            if (!_settings.force)
+                readManifest();
+
+            // Sorted, so the output and the manifest don't depend on the directory iteration order
+            std::vector<std::string> relativePaths;
+            for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(_inputDir))
+            {
+                if (entry.is_regular_file())
+                    relativePaths.push_back(std::filesystem::relative(entry.path(), _inputDir).generic_string());
+            }
+            std::sort(relativePaths.begin(), relativePaths.end());
+
+            for (const std::string& relativePath : relativePaths)
+            {
+                switch (cookFile(relativePath))
+                {
+                    case CookResult::COOKED:
+                        ++_cookedCount;
+                        Debug::log("Cooked: " + relativePath);
+                        break;
+                    case CookResult::UP_TO_DATE:
+                        ++_upToDateCount;
+                        break;
+                    case CookResult::FAILED:
+                        ++_failedCount;
+                        Debug::log(
+                            "Failed to cook: " + relativePath,
+                            PLATYPUS_CURRENT_FUNC_NAME,
+                            Debug::MessageType::PLATYPUS_ERROR
+                        );
+                        break;
+                    default:
+                        break;
+                }
+            }
+
+            writeManifest();
+            return _failedCount == 0;
+        }
+
+        CookResult AssetCooker::cookFile(const std::string& relativePath)
+        {
+            const std::string cookedExtension = get_cooked_extension(relativePath);
+            if (cookedExtension.empty())
+                return CookResult::SKIPPED;
+
+            const std::string sourcePath = (std::filesystem::path(_inputDir) / relativePath).string();
+            std::filesystem::path outputPath = std::filesystem::path(_outputDir) / relativePath;
+            outputPath.replace_extension(cookedExtension);
+
+            // Like TestCube.gltf and TestCube.glb in the same directory
+            const std::string outputKey = outputPath.generic_string();
+            std::unordered_map<std::string, std::string>::const_iterator outputIt = _outputSources.find(outputKey);
+            if (outputIt != _outputSources.end())
+            {
+                Debug::log(
+                    "Sources: " + outputIt->second + " and " + relativePath + " "
+                    "would both cook into: " + outputKey,
+                    PLATYPUS_CURRENT_FUNC_NAME,
+                    Debug::MessageType::PLATYPUS_ERROR
+                );
+                return CookResult::FAILED;
+            }
+            _outputSources[outputKey] = relativePath;
+
+            const uint64_t sourceHash = hashSource(sourcePath);
+            std::unordered_map<std::string, uint64_t>::const_iterator manifestIt = _manifest.find(relativePath);
+            if (manifestIt != _manifest.end() &&
+                manifestIt->second == sourceHash &&
+                std::filesystem::exists(outputPath))
+            {
+                return CookResult::UP_TO_DATE;
+            }
+
+            std::filesystem::create_directories(outputPath.parent_path());
+            bool success = false;
+            if (cookedExtension == cooked_model_extension)
+                success = cookModel(sourcePath, outputPath.string());
+            else if (cookedExtension == cooked_image_extension)
+                success = cookImage(sourcePath, outputPath.string(), is_srgb_image(sourcePath));
+            else if (cookedExtension == cooked_font_extension)
+                success = cookFont(sourcePath, outputPath.string());
+
+            if (!success)
+            {
+                _manifest.erase(relativePath);
+                return CookResult::FAILED;
+            }
+            _manifest[relativePath] = sourceHash;
+            return CookResult::COOKED;
+        }
+
+        bool AssetCooker::cookModel(const std::string& sourcePath, const std::string& outputPath)
+        {
+            std::vector<MeshData> meshes;
+            std::vector<SkeletonData> skeletons;
+            if (!load_gltf_model(sourcePath, meshes, skeletons))
+                return false;
+
+            for (MeshData& meshData : meshes)
+                shrink_index_buffers(meshData);
+
+            write_file(outputPath, create_cooked_model(meshes, skeletons));
+            return true;
+        }
+
+        bool AssetCooker::cookImage(const std::string& sourcePath, const std::string& outputPath, bool sRGB)
+        {
+            int width = 0;
+            int height = 0;
+            int channels = 0;
+            PE_ubyte* pPixels = nullptr;
+            if (!Image::read_image_pixels(sourcePath, &width, &height, &channels, &pPixels))
+                return false;
+
+            const uint32_t mipLevelCount = get_mip_level_count(width, height);
+            std::vector<PE_ubyte> mipChain(get_mip_chain_size(width, height, channels, mipLevelCount));
+            memcpy(mipChain.data(), pPixels, (size_t)width * height * channels);
+            delete[] pPixels;
+            generate_mip_chain(mipChain.data(), width, height, channels, mipLevelCount, sRGB);
+
+            write_file(
+                outputPath,
+                Image::create_cooked_image(
+                    mipChain.data(),
+                    width,
+                    height,
+                    channels,
+                    mipLevelCount,
+                    sRGB,
+                    _settings.compressImages
+                )
+            );
+            return true;
+        }
+
+        bool AssetCooker::cookFont(const std::string& sourcePath, const std::string& outputPath)
+        {
+            const size_t uuidPool = UUID::occupy_pool();
+            bool success = false;
+            {
+                Font font(uuidPool);
+                if (font.loadGlyphs(sourcePath, _settings.fontPixelSize))
+                {
+                    write_file(outputPath, font.createCookedFont());
+                    success = true;
+                }
+            }
+            UUID::erase_pool(uuidPool);
+            return success;
+        }
+
+        uint64_t AssetCooker::hashSource(const std::string& sourcePath) const
+        {
+            // Anything changing the output has to be in the hash.
+            // NOTE: Only the settings affecting this type of asset
+            //  -> changing font size doesn't recook models and images
+            const std::string cookedExtension = get_cooked_extension(sourcePath);
+            std::string settings = std::to_string(s_cookerVersion) + " " + cookedExtension;
+            if (cookedExtension == cooked_model_extension)
+            {
+                settings += " " + std::to_string(cooked_model_version);
+            }
+            else if (cookedExtension == cooked_image_extension)
+            {
+                settings += " " + std::to_string(cooked_image_version);
+                settings += " " + std::to_string(_settings.compressImages);
+            }
+            else if (cookedExtension == cooked_font_extension)
+            {
+                settings += " " + std::to_string(cooked_font_version);
+                settings += " " + std::to_string(_settings.fontPixelSize);
+            }
+            uint64_t hash = hash_data(settings.data(), settings.size());
+
+            const std::vector<char> sourceData = read_file(sourcePath);
+            hash = hash_data(sourceData.data(), sourceData.size(), hash);
+
+            if (to_lower(std::filesystem::path(sourcePath).extension().string()) == ".gltf")
+            {
+                for (const std::string& dependency : get_gltf_dependencies(sourcePath))
+                {
+                    const std::vector<char> dependencyData = read_file(dependency);
+                    hash = hash_data(dependency.data(), dependency.size(), hash);
+                    hash = hash_data(dependencyData.data(), dependencyData.size(), hash);
+                }
+            }
+            return hash;
+        }
+
+        /*
+            Manifest format (text, one line per cooked source):
+                <hash as 16 hex digits> <source path relative to the input dir>
+        */
+        void AssetCooker::readManifest()
+        {
+            _manifest.clear();
+            std::ifstream file((std::filesystem::path(_outputDir) / s_manifestFilename).string());
+            if (!file.is_open())
+                return;
+
+            std::string line;
+            while (std::getline(file, line))
+            {
+                const size_t separator = line.find(' ');
+                if (separator == std::string::npos || separator == 0)
+                    continue;
+                const uint64_t hash = std::strtoull(line.substr(0, separator).c_str(), nullptr, 16);
+                _manifest[line.substr(separator + 1)] = hash;
+            }
+        }
+
+        void AssetCooker::writeManifest() const
+        {
+            std::vector<std::pair<std::string, uint64_t>> entries(_manifest.begin(), _manifest.end());
+            std::sort(entries.begin(), entries.end());
+
+            std::ofstream file((std::filesystem::path(_outputDir) / s_manifestFilename).string());
+            if (!file.is_open())
+            {
+                Debug::log(
+                    "Failed to write manifest to: " + _outputDir,
+                    PLATYPUS_CURRENT_FUNC_NAME,
+                    Debug::MessageType::PLATYPUS_ERROR
+                );
+                return;
+            }
+            char hashStr[17];
+            for (const std::pair<std::string, uint64_t>& entry : entries)
+            {
+                snprintf(hashStr, sizeof(hashStr), "%016" PRIx64, entry.second);
+                file << hashStr << " " << entry.first << "\n";
+            }
+        }
+    }
+}
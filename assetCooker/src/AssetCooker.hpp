@@ -0,0 +1,87 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+
+namespace platypus
+{
+    namespace assetCooker
+    {
+        struct CookSettings
+        {
+            // Cook everything, even if the manifest says it's up to date
+            bool force = false;
+            unsigned int fontPixelSize = 16;
+            bool compressImages = false;
+        };
+
+        enum class CookResult
+        {
+            COOKED,
+            UP_TO_DATE,
+            SKIPPED, // Not a cookable file
+            FAILED
+        };
+
+        // Converts source assets (glTF, images, fonts) from the input directory
+        // into the engine's cooked formats in the output directory, keeping the
+        // directory structure.
+        //
+        // Cooking is incremental: the output directory's manifest stores a hash of each
+        // source's content (including the .bin buffers of .gltf files), the settings
+        // and the cooked format versions. Sources whose hash hasn't changed and whose
+        // output still exists don't get cooked again.
+        class AssetCooker
+        {
+        private:
+            std::string _inputDir;
+            std::string _outputDir;
+            CookSettings _settings;
+
+            // Relative source path -> hash it was last cooked with
+            std::unordered_map<std::string, uint64_t> _manifest;
+            // Output path -> relative source path cooked into it on this run
+            std::unordered_map<std::string, std::string> _outputSources;
+
+            size_t _cookedCount = 0;
+            size_t _upToDateCount = 0;
+            size_t _failedCount = 0;
+
+        public:
+            AssetCooker(
+                const std::string& inputDir,
+                const std::string& outputDir,
+                const CookSettings& settings
+            );
+
+            // Returns false if anything failed to cook
+            bool cookAll();
+
+            inline size_t getCookedCount() const { return _cookedCount; }
+            inline size_t getUpToDateCount() const { return _upToDateCount; }
+            inline size_t getFailedCount() const { return _failedCount; }
+
+        private:
+            CookResult cookFile(const std::string& relativePath);
+
+            bool cookModel(const std::string& sourcePath, const std::string& outputPath);
+            bool cookImage(const std::string& sourcePath, const std::string& outputPath, bool sRGB);
+            bool cookFont(const std::string& sourcePath, const std::string& outputPath);
+
+            // Hash of everything affecting the cooked output of the source
+            uint64_t hashSource(const std::string& sourcePath) const;
+
+            void readManifest();
+            void writeManifest() const;
+        };
+
+        // Returns the cooked file's extension for the source or empty string if it isn't cookable
+        std::string get_cooked_extension(const std::string& sourcePath);
+
+        // Files referenced by the .gltf (buffers) that the cooked model depends on
+        std::vector<std::string> get_gltf_dependencies(const std::string& gltfPath);
+    }
+}
@@ -0,0 +1,66 @@
+#include "platypus/core/Debug.hpp"
+#include "AssetCooker.hpp"
+
+#include <string>
+#include <cstring>
+#include <cstdlib>
+
+
+using namespace platypus;
+using namespace assetCooker;
+
+static void print_usage()
+{
+    Debug::log(
+        "Usage: asset-cooker <inputDir> <outputDir> [--force] [--font-size <pixels>] [--lz4]\n"
+        "   --force         cook everything, even if up to date\n"
+        "   --font-size     pixel size to bake the fonts with (default 16)\n"
+        "   --lz4           LZ4 compress the images' pixels"
+    );
+}
+
+int main(int argc, const char** argv)
+{
+    if (argc < 3)
+    {
+        print_usage();
+        return 1;
+    }
+
+    CookSettings settings;
+    for (int i = 3; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--force") == 0)
+        {
+            settings.force = true;
+        }
+        else if (strcmp(argv[i], "--lz4") == 0)
+        {
+            settings.compressImages = true;
+        }
+        else if (strcmp(argv[i], "--font-size") == 0 && i + 1 < argc)
+        {
+            const int pixelSize = atoi(argv[++i]);
+            if (pixelSize <= 0)
+            {
+                print_usage();
+                return 1;
+            }
+            settings.fontPixelSize = (unsigned int)pixelSize;
+        }
+        else
+        {
+            print_usage();
+            return 1;
+        }
+    }
+
+    AssetCooker cooker(argv[1], argv[2], settings);
+    const bool success = cooker.cookAll();
+    Debug::log(
+        "Cooked: " + std::to_string(cooker.getCookedCount()) + " "
+        "up to date: " + std::to_string(cooker.getUpToDateCount()) + " "
+        "failed: " + std::to_string(cooker.getFailedCount())
+    );
+    return success ? 0 : 1;
+}
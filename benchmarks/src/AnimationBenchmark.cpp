@@ -0,0 +1,238 @@
+#include "Benchmarks.hpp"
+#include "platypus/assets/SkeletalAnimationData.hpp"
+#include "platypus/utils/UUID.hpp"
+
+#include <vector>
+
+using namespace platypus;
+
+
+// Samples local poses of all joints for many instances of the same animation,
+// each instance at a different time, advancing the time like SkeletalAnimationSystem.
+// Compares the old way of scanning the keys linearly for each joint against
+// SkeletalAnimationData::sampleJoints with and without keyframe cursors
+// and using a compressed animation.
+
+static const size_t s_jointCount = 50;
+static const float s_animationLength = 2.0f;
+static const float s_keysPerSecond = 30.0f;
+static const float s_deltaTime = 1.0f / 60.0f;
+
+static KeyframeAnimationData create_test_animation()
+{
+    KeyframeAnimationData animationData;
+    animationData.name = "BenchmarkAnimation";
+    animationData.length = s_animationLength;
+    animationData.keyframes.resize(s_jointCount);
+
+    // Smooth curves like in baked animations. Scale stays the same as usually.
+    const size_t keyCount = static_cast<size_t>(s_animationLength * s_keysPerSecond) + 1;
+    for (JointAnimationData& jointAnimData : animationData.keyframes)
+    {
+        Vector3f axis(random_float(-1.0f, 1.0f), random_float(-1.0f, 1.0f), random_float(-1.0f, 1.0f));
+        axis = axis.normalize();
+        const Vector3f translation(random_float(-1.0f, 1.0f), random_float(-1.0f, 1.0f), random_float(-1.0f, 1.0f));
+        const float frequency = random_float(0.5f, 3.0f);
+        const float phase = random_float(0.0f, 6.0f);
+        for (size_t i = 0; i < keyCount; ++i)
+        {
+            const float time = static_cast<float>(i) / s_keysPerSecond;
+            const float wave = std::sin(time * frequency + phase);
+            jointAnimData.translations.push_back(
+                { time, translation * (1.0f + 0.25f * wave) }
+            );
+            jointAnimData.rotations.push_back(
+                { time, Quaternion(axis, wave) }
+            );
+            jointAnimData.scales.push_back(
+                { time, Vector3f(1.0f, 1.0f, 1.0f) }
+            );
+        }
+    }
+    return animationData;
+}
+
+template <typename KeyType, typename ValueType, typename InterpolateFunc>
+static ValueType sample_linear_scan(
+    const std::vector<KeyType>& keys,
+    float time,
+    ValueType KeyType::* value,
+    InterpolateFunc interpolate
+)
+{
+    KeyType currentKey = keys[0];
+    KeyType nextKey = keys[0];
+    for (size_t i = 0; i < keys.size() - 1; ++i)
+    {
+        if (time < keys[i + 1].time)
+        {
+            currentKey = keys[i];
+            nextKey = keys[i + 1];
+            break;
+        }
+    }
+    const float amount = (time - currentKey.time) / (nextKey.time - currentKey.time);
+    if (amount <= 1.0f)
+        return interpolate(currentKey.*value, nextKey.*value, amount);
+    return currentKey.*value;
+}
+
+// Same as what SkeletalAnimationData::getBoneMatrix used to do (+ scale)
+static void sample_joints_linear_scan(
+    const KeyframeAnimationData& animationData,
+    float time,
+    JointPose* pOutPoses
+)
+{
+    auto lerpVector = [](const Vector3f& a, const Vector3f& b, float amount) { return a.lerp(b, amount); };
+    auto slerpQuaternion = [](const Quaternion& a, const Quaternion& b, float amount) { return a.slerp(b, amount); };
+    for (size_t i = 0; i < animationData.keyframes.size(); ++i)
+    {
+        const JointAnimationData& jointAnimData = animationData.keyframes[i];
+        pOutPoses[i].translation = sample_linear_scan(jointAnimData.translations, time, &TranslationKey::translation, lerpVector);
+        pOutPoses[i].rotation = sample_linear_scan(jointAnimData.rotations, time, &RotationKey::rotation, slerpQuaternion);
+        pOutPoses[i].scale = sample_linear_scan(jointAnimData.scales, time, &ScaleKey::scale, lerpVector);
+    }
+}
+
+static float max_pose_difference(const std::vector<JointPose>& a, const std::vector<JointPose>& b)
+{
+    float maxDiff = 0.0f;
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        maxDiff = std::max(maxDiff, max_difference(&a[i].translation.x, &b[i].translation.x, 1));
+        maxDiff = std::max(maxDiff, max_difference(&a[i].translation.y, &b[i].translation.y, 1));
+        maxDiff = std::max(maxDiff, max_difference(&a[i].translation.z, &b[i].translation.z, 1));
+        maxDiff = std::max(maxDiff, max_difference(&a[i].rotation.x, &b[i].rotation.x, 4));
+        maxDiff = std::max(maxDiff, max_difference(&a[i].scale.x, &b[i].scale.x, 1));
+        maxDiff = std::max(maxDiff, max_difference(&a[i].scale.y, &b[i].scale.y, 1));
+        maxDiff = std::max(maxDiff, max_difference(&a[i].scale.z, &b[i].scale.z, 1));
+    }
+    return maxDiff;
+}
+
+// sampleJoint has to give the same pose as sampleJoints for each joint.
+// NOTE: The test animation's joints all move differently -> comparing only against
+// joint 0 would miss sampleJoint sampling the wrong joint
+static bool check_single_joint_sampling(const SkeletalAnimationData& animation, float time)
+{
+    std::vector<JointPose> poses(s_jointCount);
+    animation.sampleJoints(time, poses.data(), poses.size());
+
+    std::vector<JointPose> singlePoses(s_jointCount);
+    for (size_t i = 0; i < s_jointCount; ++i)
+        singlePoses[i] = animation.sampleJoint(time, i);
+
+    const float maxDiff = max_pose_difference(poses, singlePoses);
+    const float lastToFirstDiff = max_pose_difference(
+        { singlePoses[s_jointCount - 1] },
+        { singlePoses[0] }
+    );
+    const bool passed = maxDiff < 0.0001f && lastToFirstDiff > 0.0001f;
+    printf(
+        "sampleJoint vs sampleJoints at %.3f: max diff: %g, joint %zu vs joint 0 diff: %g -> %s\n",
+        time,
+        maxDiff,
+        s_jointCount - 1,
+        lastToFirstDiff,
+        passed ? "OK" : "FAILED"
+    );
+    return passed;
+}
+
+void run_animation_benchmark(size_t instanceCount, int iterations)
+{
+    printf("== Animation sampling ==\n");
+    printf("Joints: %zu, instances: %zu, frames: %d\n", s_jointCount, instanceCount, iterations);
+
+    const size_t uuidPool = UUID::occupy_pool();
+    const KeyframeAnimationData animationData = create_test_animation();
+    SkeletalAnimationData animation(uuidPool, animationData);
+
+    AnimationCompression compression;
+    compression.translationTolerance = 0.001f;
+    compression.rotationTolerance = 0.001f;
+    compression.scaleTolerance = 0.001f;
+    compression.quantizeRotations = true;
+    SkeletalAnimationData compressedAnimation(uuidPool, animationData, compression);
+    printf(
+        "Serialized size: %zu bytes, compressed: %zu bytes\n",
+        animation.getSerializedSize(),
+        compressedAnimation.getSerializedSize()
+    );
+
+    check_single_joint_sampling(animation, 0.0f);
+    check_single_joint_sampling(animation, s_animationLength * 0.37f);
+    check_single_joint_sampling(compressedAnimation, s_animationLength * 0.81f);
+
+    std::vector<float> startTimes(instanceCount);
+    for (float& time : startTimes)
+        time = random_float(0.0f, s_animationLength);
+
+    std::vector<float> times(instanceCount);
+    std::vector<KeyframeCursor> cursors(instanceCount * s_jointCount);
+    std::vector<JointPose> baselinePoses(instanceCount * s_jointCount);
+    std::vector<JointPose> searchPoses(instanceCount * s_jointCount);
+    std::vector<JointPose> cursorPoses(instanceCount * s_jointCount);
+    std::vector<JointPose> compressedPoses(instanceCount * s_jointCount);
+
+    auto advanceTime = [](float& time)
+    {
+        time += s_deltaTime;
+        if (time >= s_animationLength)
+            time = 0.0f;
+    };
+
+    const size_t sampledJoints = instanceCount * s_jointCount;
+
+    times = startTimes;
+    double baselineTime = time_func([&]() {
+        for (size_t i = 0; i < instanceCount; ++i)
+        {
+            advanceTime(times[i]);
+            sample_joints_linear_scan(animationData, times[i], &baselinePoses[i * s_jointCount]);
+        }
+    }, sampledJoints, iterations);
+
+    times = startTimes;
+    double searchTime = time_func([&]() {
+        for (size_t i = 0; i < instanceCount; ++i)
+        {
+            advanceTime(times[i]);
+            animation.sampleJoints(times[i], &searchPoses[i * s_jointCount], s_jointCount);
+        }
+    }, sampledJoints, iterations);
+
+    times = startTimes;
+    double cursorTime = time_func([&]() {
+        for (size_t i = 0; i < instanceCount; ++i)
+        {
+            advanceTime(times[i]);
+            animation.sampleJoints(
+                times[i],
+                &cursorPoses[i * s_jointCount],
+                s_jointCount,
+                &cursors[i * s_jointCount]
+            );
+        }
+    }, sampledJoints, iterations);
+
+    times = startTimes;
+    cursors = std::vector<KeyframeCursor>(instanceCount * s_jointCount);
+    double compressedTime = time_func([&]() {
+        for (size_t i = 0; i < instanceCount; ++i)
+        {
+            advanceTime(times[i]);
+            compressedAnimation.sampleJoints(
+                times[i],
+                &compressedPoses[i * s_jointCount],
+                s_jointCount,
+                &cursors[i * s_jointCount]
+            );
+        }
+    }, sampledJoints, iterations);
+
+    print_benchmark_result("sampleJoints (binary search)", baselineTime, searchTime, max_pose_difference(baselinePoses, searchPoses));
+    print_benchmark_result("sampleJoints (cursors)", baselineTime, cursorTime, max_pose_difference(baselinePoses, cursorPoses));
+    print_benchmark_result("sampleJoints (compressed)", baselineTime, compressedTime, max_pose_difference(baselinePoses, compressedPoses));
+}
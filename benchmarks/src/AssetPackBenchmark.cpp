@@ -0,0 +1,191 @@
+#include "Benchmarks.hpp"
+#include "platypus/assets/AssetPack.hpp"
+#include "platypus/utils/FileUtils.hpp"
+
+#include <vector>
+#include <string>
+#include <cstring>
+
+using namespace platypus;
+
+
+// Compares getting a single asset out of the serialized assets the way
+// AssetManager::deserialize reads them (read the whole file into a vector
+// and walk through every asset before the wanted one) against finding it
+// from the memory mapped AssetPack's table of contents.
+//
+// The assets here are plain data blobs, standing in for meshes and images
+// (deserializing those requires the graphics device). Each load copies
+// the asset's data once, like creating the buffers copies it into staging.
+//
+// NOTE: The files are read right after writing them, so they're probably in
+// the OS file cache -> this measures mostly copying and parsing, not disk access.
+
+static const char* s_packFilepath = "platypus_asset_pack_benchmark.pack";
+static const char* s_sequentialFilepath = "platypus_asset_pack_benchmark.assets";
+
+class BlobAsset : public Asset
+{
+public:
+    std::vector<char> data;
+
+    BlobAsset(size_t uuidPool, size_t dataSize) :
+        Asset(uuidPool, AssetType::ASSET_TYPE_NONE, "blob", NULL_UUID, false),
+        data(dataSize)
+    {
+        for (size_t i = 0; i < dataSize; ++i)
+            data[i] = static_cast<char>(rand());
+    }
+
+    // Reads the serialized blob like the assets' deserialization constructors do
+    // (without the AssetManager, which the Asset's constructor would require)
+    BlobAsset(size_t uuidPool, const DataView& serializedData, size_t bufferPos) :
+        Asset(uuidPool, AssetType::ASSET_TYPE_NONE, "blob", read_id(serializedData, bufferPos), false)
+    {
+        const size_t dataSizePos = bufferPos + getSerializedBaseSize();
+        uint64_t dataSize = 0;
+        memcpy(&dataSize, serializedData.data() + dataSizePos, sizeof(uint64_t));
+        data.resize(dataSize);
+        memcpy(data.data(), serializedData.data() + dataSizePos + sizeof(uint64_t), dataSize);
+    }
+
+    virtual void serialize(std::vector<char>& targetBuffer) const override
+    {
+        const size_t prevSize = targetBuffer.size();
+        targetBuffer.resize(prevSize + getSerializedSize());
+        char* pBuf = targetBuffer.data() + prevSize;
+        serializeBase(pBuf);
+        size_t pos = getSerializedBaseSize();
+
+        const uint64_t dataSize = data.size();
+        memcpy(pBuf + pos, &dataSize, sizeof(uint64_t));
+        pos += sizeof(uint64_t);
+        memcpy(pBuf + pos, data.data(), data.size());
+    }
+
+    virtual size_t getSerializedSize() const override
+    {
+        return getSerializedBaseSize() + sizeof(uint64_t) + data.size();
+    }
+
+    static UUID_t read_id(const DataView& serializedData, size_t bufferPos)
+    {
+        UUID_t id = NULL_UUID;
+        memcpy(&id, serializedData.data() + bufferPos + sizeof(AssetType), sizeof(UUID_t));
+        return id;
+    }
+};
+
+static double time_milliseconds(const std::function<void()>& func, int iterations)
+{
+    func();
+    std::chrono::time_point<std::chrono::high_resolution_clock> beginTime = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        func();
+    std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - beginTime;
+    return duration.count() / iterations;
+}
+
+static void run_asset_pack_benchmark_count(size_t assetCount, size_t assetSize, int iterations)
+{
+    printf("-- Asset pack: %zu assets, %zu KB each --\n", assetCount, assetSize / 1024);
+
+    const size_t createPool = UUID::occupy_pool();
+    std::vector<Asset*> assets;
+    for (size_t i = 0; i < assetCount; ++i)
+        assets.push_back(new BlobAsset(createPool, assetSize));
+
+    // Same layout as AssetManager::serialize
+    std::vector<char> sequentialData(sizeof(uint32_t));
+    const uint32_t assetCountU32 = static_cast<uint32_t>(assetCount);
+    memcpy(sequentialData.data(), &assetCountU32, sizeof(uint32_t));
+    for (const Asset* pAsset : assets)
+        pAsset->serialize(sequentialData);
+    write_file(s_sequentialFilepath, sequentialData);
+    write_file(s_packFilepath, AssetPack::create(assets));
+
+    // The wanted asset is in the middle -> sequential loading has to go through half the file
+    const UUID_t wantedID = assets[assetCount / 2]->getID();
+    for (Asset* pAsset : assets)
+        delete pAsset;
+    UUID::erase_pool(createPool);
+
+    // Loaded assets go to their own pool, since they reuse the created assets' UUIDs
+    const size_t loadPool = UUID::occupy_pool();
+    bool found = true;
+
+    const double sequentialSingleTime = time_milliseconds(
+        [&]()
+        {
+            const std::vector<char> fileData = read_file(s_sequentialFilepath);
+            size_t pos = sizeof(uint32_t);
+            for (size_t i = 0; i < assetCount; ++i)
+            {
+                BlobAsset asset(loadPool, fileData, pos);
+                pos += asset.getSerializedSize();
+                if (asset.getID() == wantedID)
+                    break;
+            }
+        },
+        iterations
+    );
+
+    const double packSingleTime = time_milliseconds(
+        [&]()
+        {
+            AssetPack pack;
+            AssetPackEntry entry;
+            found &= pack.open(s_packFilepath) && pack.findEntry(wantedID, entry);
+            BlobAsset asset(loadPool, pack.getAssetData(entry), 0);
+        },
+        iterations
+    );
+
+    const double sequentialAllTime = time_milliseconds(
+        [&]()
+        {
+            const std::vector<char> fileData = read_file(s_sequentialFilepath);
+            size_t pos = sizeof(uint32_t);
+            for (size_t i = 0; i < assetCount; ++i)
+            {
+                BlobAsset asset(loadPool, fileData, pos);
+                pos += asset.getSerializedSize();
+            }
+        },
+        iterations
+    );
+
+    const double packAllTime = time_milliseconds(
+        [&]()
+        {
+            AssetPack pack;
+            found &= pack.open(s_packFilepath);
+            for (size_t i = 0; i < pack.getEntryCount(); ++i)
+                BlobAsset asset(loadPool, pack.getAssetData(pack.getEntry(i)), 0);
+        },
+        iterations
+    );
+    UUID::erase_pool(loadPool);
+
+    if (!found)
+        printf("FAILED TO FIND THE ASSET FROM THE PACK!\n");
+    printf("%-32s baseline: %8.3f ms  pack: %8.3f ms  speedup: %6.2fx\n", "load single asset", sequentialSingleTime, packSingleTime, sequentialSingleTime / packSingleTime);
+    printf("%-32s baseline: %8.3f ms  pack: %8.3f ms  speedup: %6.2fx\n", "load all assets", sequentialAllTime, packAllTime, sequentialAllTime / packAllTime);
+
+    remove(s_packFilepath);
+    remove(s_sequentialFilepath);
+}
+
+void run_asset_pack_benchmark(size_t count, int iterations)
+{
+    const size_t assetSize = 64 * 1024;
+    if (count > 0)
+    {
+        run_asset_pack_benchmark_count(count, assetSize, iterations);
+        return;
+    }
+
+    const size_t counts[] = { 100, 1000 };
+    for (size_t assetCount : counts)
+        run_asset_pack_benchmark_count(assetCount, assetSize, iterations);
+}
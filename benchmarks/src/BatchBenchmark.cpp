@@ -0,0 +1,157 @@
+#include "Benchmarks.hpp"
+#include "platypus/utils/Maths.hpp"
+
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+using namespace platypus;
+
+
+// Device side memory the Batcher allocates for a single mesh + material batch
+// as the object count grows.
+//
+// Baseline = single batch allocated for the worst case up front (and objects past
+// its length getting dropped), engine = fixed size chunks chained when needed.
+// Sizes match the ones given to the Batcher by the MasterRenderer.
+//
+// NOTE: The Batcher can't be created without a device, so this computes the allocations
+// the same way the Batcher does instead of measuring them.
+
+static const size_t s_framesInFlight = 2;
+
+struct BatchMemoryCase
+{
+    const char* name;
+    size_t entrySize;
+    size_t previousMaxLength;
+    size_t chunkLength;
+};
+
+static void print_memory_usage(const BatchMemoryCase& memoryCase, size_t objectCount)
+{
+    const size_t previousBytes = memoryCase.entrySize * memoryCase.previousMaxLength * s_framesInFlight;
+    const size_t droppedCount = objectCount > memoryCase.previousMaxLength ? objectCount - memoryCase.previousMaxLength : 0;
+
+    const size_t chunkCount = std::max<size_t>(1, (objectCount + memoryCase.chunkLength - 1) / memoryCase.chunkLength);
+    const size_t chunkedBytes = memoryCase.entrySize * memoryCase.chunkLength * chunkCount * s_framesInFlight;
+    printf(
+        "%-16s objects: %7zu  baseline: %8.1f KB (dropped: %6zu)  engine: %8.1f KB (chunks: %4zu)  used: %8.1f KB\n",
+        memoryCase.name,
+        objectCount,
+        (double)previousBytes / 1024.0,
+        droppedCount,
+        (double)chunkedBytes / 1024.0,
+        chunkCount,
+        (double)(memoryCase.entrySize * objectCount * s_framesInFlight) / 1024.0
+    );
+}
+
+void run_batch_memory_benchmark(size_t count)
+{
+    printf("== Batch memory (%zu frames in flight) ==\n", s_framesInFlight);
+    const size_t maxSkinnedMeshJoints = 50;
+    const BatchMemoryCase memoryCases[] = {
+        { "static", sizeof(Matrix4f), 1000, 512 },
+        { "static instanced", sizeof(Matrix4f), 1000, 1024 },
+        // NOTE: Joint palettes are in a storage buffer on desktop -> not aligned
+        { "skinned", sizeof(Matrix4f) * maxSkinnedMeshJoints, 500, 64 }
+    };
+
+    std::vector<size_t> objectCounts = { 1, 10, 100, 1000, 10000, 100000 };
+    if (count > 0)
+        objectCounts = { count };
+
+    for (const BatchMemoryCase& memoryCase : memoryCases)
+    {
+        for (size_t objectCount : objectCounts)
+            print_memory_usage(memoryCase, objectCount);
+    }
+}
+
+
+// Per frame writes of a batch chunk's entries when only part of the chunk is used.
+//
+// Baseline = entries copied to the host side copy and the whole buffer uploaded
+// afterwards (Buffer::updateHost + Buffer::updateDevice), engine = entries written
+// straight to the persistently mapped memory (Buffer::write + Buffer::flush).
+//
+// NOTE: Plain host memory stands in for the mapped device memory here.
+// Flushing host coherent memory is a no-op, so only the copies are measured.
+
+struct BatchUploadCase
+{
+    const char* name;
+    size_t entrySize;
+    size_t chunkLength;
+};
+
+static void run_batch_upload_benchmark_case(const BatchUploadCase& uploadCase, size_t objectCount, int iterations)
+{
+    const size_t entryCount = std::min(objectCount, uploadCase.chunkLength);
+    const size_t bufferSize = uploadCase.entrySize * uploadCase.chunkLength;
+    std::vector<float> inputData(uploadCase.entrySize / sizeof(float));
+    for (float& value : inputData)
+        value = random_float(-1.0f, 1.0f);
+
+    std::vector<char> hostData(bufferSize);
+    std::vector<char> baselineMappedData(bufferSize);
+    const double baselineTime = time_func(
+        [&]()
+        {
+            for (size_t i = 0; i < entryCount; ++i)
+                memcpy(hostData.data() + uploadCase.entrySize * i, inputData.data(), uploadCase.entrySize);
+            memcpy(baselineMappedData.data(), hostData.data(), bufferSize);
+        },
+        entryCount,
+        iterations
+    );
+
+    std::vector<char> engineMappedData(bufferSize);
+    const double engineTime = time_func(
+        [&]()
+        {
+            for (size_t i = 0; i < entryCount; ++i)
+                memcpy(engineMappedData.data() + uploadCase.entrySize * i, inputData.data(), uploadCase.entrySize);
+        },
+        entryCount,
+        iterations
+    );
+
+    const size_t usedSize = uploadCase.entrySize * entryCount;
+    const float maxDiff = memcmp(baselineMappedData.data(), engineMappedData.data(), usedSize) == 0 ? 0.0f : 1.0f;
+    char name[64];
+    snprintf(name, sizeof(name), "%s %zu/%zu", uploadCase.name, entryCount, uploadCase.chunkLength);
+    print_benchmark_result(name, baselineTime, engineTime, maxDiff);
+    printf(
+        "%-32s baseline: %8.1f KB  engine: %8.1f KB copied per frame\n",
+        "",
+        (double)(usedSize + bufferSize) / 1024.0,
+        (double)usedSize / 1024.0
+    );
+}
+
+void run_batch_upload_benchmark(size_t count, int iterations)
+{
+    printf("== Batch upload ==\n");
+    const size_t maxSkinnedMeshJoints = 50;
+    const BatchUploadCase uploadCases[] = {
+        { "static", sizeof(Matrix4f), 512 },
+        { "skinned", sizeof(Matrix4f) * maxSkinnedMeshJoints, 64 }
+    };
+
+    std::vector<size_t> objectCounts = { 10, 100, 1000 };
+    if (count > 0)
+        objectCounts = { count };
+
+    for (const BatchUploadCase& uploadCase : uploadCases)
+    {
+        for (size_t objectCount : objectCounts)
+        {
+            run_batch_upload_benchmark_case(uploadCase, objectCount, iterations);
+            // Rest would be the same full chunk
+            if (objectCount >= uploadCase.chunkLength)
+                break;
+        }
+    }
+}
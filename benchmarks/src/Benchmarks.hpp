@@ -0,0 +1,70 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+
+
+// NOTE: Requires the engine to be built first into ../build (same as shaderBuilder)
+
+void run_maths_benchmark(size_t count, int iterations);
+void run_animation_benchmark(size_t instanceCount, int iterations);
+// count 0 = run with 10k, 100k and 1M boxes
+void run_spatial_benchmark(size_t count, int iterations);
+// count 0 = run with 1 to 100k objects
+void run_batch_memory_benchmark(size_t count);
+// count 0 = run with 10 to 1000 objects per chunk
+void run_batch_upload_benchmark(size_t count, int iterations);
+// count 0 = run with 100, 1k and 10k batches
+void run_render_queue_benchmark(size_t count, int iterations);
+// size 0 = run with 256, 1024 and 2048 pixel square images
+void run_image_load_benchmark(size_t size, int iterations);
+// count 0 = run with 100 and 1000 assets
+void run_asset_pack_benchmark(size_t count, int iterations);
+// gridSize 0 = run with 64x64, 256x256 and 512x512 vertex grids
+void run_cooked_model_benchmark(size_t gridSize, int iterations);
+
+
+inline float random_float(float min, float max)
+{
+    return min + (max - min) * (static_cast<float>(rand()) / static_cast<float>(RAND_MAX));
+}
+
+inline float max_difference(const float* pA, const float* pB, size_t count)
+{
+    float maxDiff = 0.0f;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float diff = std::abs(pA[i] - pB[i]);
+        if (diff > maxDiff)
+            maxDiff = diff;
+    }
+    return maxDiff;
+}
+
+// Returns nanoseconds per element
+inline double time_func(const std::function<void()>& func, size_t elementCount, int iterations)
+{
+    // Warmup
+    func();
+    std::chrono::time_point<std::chrono::high_resolution_clock> beginTime = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        func();
+    std::chrono::duration<double, std::nano> duration = std::chrono::high_resolution_clock::now() - beginTime;
+    return duration.count() / (static_cast<double>(elementCount) * iterations);
+}
+
+// Baseline = the old or scalar implementation, engine = the current engine implementation
+inline void print_benchmark_result(const char* name, double baselineTime, double engineTime, float maxDiff)
+{
+    printf(
+        "%-32s baseline: %7.2f ns  engine: %7.2f ns  speedup: %5.2fx  max diff: %g\n",
+        name,
+        baselineTime,
+        engineTime,
+        baselineTime / engineTime,
+        maxDiff
+    );
+}
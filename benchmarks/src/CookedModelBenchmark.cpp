@@ -0,0 +1,199 @@
+#include "Benchmarks.hpp"
+#include "platypus/utils/modelLoading/ModelLoading.hpp"
+#include "platypus/utils/modelLoading/CookedModel.hpp"
+#include "platypus/utils/FileUtils.hpp"
+
+#include <vector>
+#include <string>
+#include <cstring>
+
+using namespace platypus;
+
+
+// Compares loading a model by parsing its glTF (.glb) file against loading
+// the cooked version of it, written by the asset cooker.
+// The model is a single grid mesh with positions, normals and tex coords.
+//
+// NOTE: Files are read right after writing them, so they're probably in the
+// OS file cache -> this measures mostly parsing, not disk access.
+
+static const char* s_glbFilepath = "platypus_cooked_model_benchmark.glb";
+static const char* s_cookedFilepath = "platypus_cooked_model_benchmark.pemodel";
+
+static void append_data(std::vector<char>& buffer, const void* pData, size_t size)
+{
+    const size_t prevSize = buffer.size();
+    buffer.resize(prevSize + size);
+    memcpy(buffer.data() + prevSize, pData, size);
+}
+
+// Writes a .glb with a single gridSize x gridSize vertex grid mesh
+static void write_grid_glb(const std::string& filepath, int gridSize)
+{
+    const size_t vertexCount = (size_t)gridSize * gridSize;
+    std::vector<float> positions;
+    std::vector<float> normals;
+    std::vector<float> texCoords;
+    positions.reserve(vertexCount * 3);
+    normals.reserve(vertexCount * 3);
+    texCoords.reserve(vertexCount * 2);
+    for (int z = 0; z < gridSize; ++z)
+    {
+        for (int x = 0; x < gridSize; ++x)
+        {
+            const float u = (float)x / (float)(gridSize - 1);
+            const float v = (float)z / (float)(gridSize - 1);
+            positions.insert(positions.end(), { u * 2.0f - 1.0f, random_float(-0.1f, 0.1f), v * 2.0f - 1.0f });
+            normals.insert(normals.end(), { 0.0f, 1.0f, 0.0f });
+            texCoords.insert(texCoords.end(), { u, v });
+        }
+    }
+
+    // NOTE: 32 bit indices even if they'd fit in 16 bits, like exporters
+    // usually do for big meshes -> cooking shrinks these if it can
+    std::vector<uint32_t> indices;
+    for (int z = 0; z < gridSize - 1; ++z)
+    {
+        for (int x = 0; x < gridSize - 1; ++x)
+        {
+            const uint32_t i = (uint32_t)(x + z * gridSize);
+            const uint32_t below = i + (uint32_t)gridSize;
+            indices.insert(indices.end(), { i, below, i + 1, i + 1, below, below + 1 });
+        }
+    }
+
+    std::vector<char> binChunk;
+    const size_t positionsOffset = binChunk.size();
+    append_data(binChunk, positions.data(), positions.size() * sizeof(float));
+    const size_t normalsOffset = binChunk.size();
+    append_data(binChunk, normals.data(), normals.size() * sizeof(float));
+    const size_t texCoordsOffset = binChunk.size();
+    append_data(binChunk, texCoords.data(), texCoords.size() * sizeof(float));
+    const size_t indicesOffset = binChunk.size();
+    append_data(binChunk, indices.data(), indices.size() * sizeof(uint32_t));
+    binChunk.resize((binChunk.size() + 3) & ~(size_t)3, 0);
+
+    const std::string vertexCountStr = std::to_string(vertexCount);
+    const std::string bufferView = "{\"buffer\":0,\"byteOffset\":";
+    std::string json =
+        "{\"asset\":{\"version\":\"2.0\"},\"scene\":0,\"scenes\":[{\"nodes\":[0]}],"
+        "\"nodes\":[{\"name\":\"Grid\",\"mesh\":0}],"
+        "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":1,\"TEXCOORD_0\":2},\"indices\":3}]}],"
+        "\"accessors\":["
+        "{\"bufferView\":0,\"componentType\":5126,\"count\":" + vertexCountStr + ",\"type\":\"VEC3\","
+        "\"min\":[-1,-0.1,-1],\"max\":[1,0.1,1]},"
+        "{\"bufferView\":1,\"componentType\":5126,\"count\":" + vertexCountStr + ",\"type\":\"VEC3\"},"
+        "{\"bufferView\":2,\"componentType\":5126,\"count\":" + vertexCountStr + ",\"type\":\"VEC2\"},"
+        "{\"bufferView\":3,\"componentType\":5125,\"count\":" + std::to_string(indices.size()) + ",\"type\":\"SCALAR\"}],"
+        "\"bufferViews\":[" +
+        bufferView + std::to_string(positionsOffset) + ",\"byteLength\":" + std::to_string(positions.size() * sizeof(float)) + "}," +
+        bufferView + std::to_string(normalsOffset) + ",\"byteLength\":" + std::to_string(normals.size() * sizeof(float)) + "}," +
+        bufferView + std::to_string(texCoordsOffset) + ",\"byteLength\":" + std::to_string(texCoords.size() * sizeof(float)) + "}," +
+        bufferView + std::to_string(indicesOffset) + ",\"byteLength\":" + std::to_string(indices.size() * sizeof(uint32_t)) + "}],"
+        "\"buffers\":[{\"byteLength\":" + std::to_string(binChunk.size()) + "}]}";
+    json.resize((json.size() + 3) & ~(size_t)3, ' ');
+
+    const uint32_t jsonChunkSize = (uint32_t)json.size();
+    const uint32_t binChunkSize = (uint32_t)binChunk.size();
+    const uint32_t header[3] = {
+        0x46546C67, // "glTF"
+        2,
+        (uint32_t)(sizeof(uint32_t) * 3 + sizeof(uint32_t) * 2 + jsonChunkSize + sizeof(uint32_t) * 2 + binChunkSize)
+    };
+    const uint32_t jsonChunkHeader[2] = { jsonChunkSize, 0x4E4F534A }; // "JSON"
+    const uint32_t binChunkHeader[2] = { binChunkSize, 0x004E4942 }; // "BIN"
+
+    std::vector<char> glb;
+    append_data(glb, header, sizeof(header));
+    append_data(glb, jsonChunkHeader, sizeof(jsonChunkHeader));
+    append_data(glb, json.data(), json.size());
+    append_data(glb, binChunkHeader, sizeof(binChunkHeader));
+    append_data(glb, binChunk.data(), binChunk.size());
+    write_file(filepath, glb);
+}
+
+static double time_milliseconds(const std::function<void()>& func, int iterations)
+{
+    func();
+    std::chrono::time_point<std::chrono::high_resolution_clock> beginTime = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        func();
+    std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - beginTime;
+    return duration.count() / iterations;
+}
+
+static void run_cooked_model_benchmark_size(int gridSize, int iterations)
+{
+    const size_t vertexCount = (size_t)gridSize * gridSize;
+    printf("-- Cooked model: %zu vertices --\n", vertexCount);
+
+    write_grid_glb(s_glbFilepath, gridSize);
+
+    // Same as the asset cooker does
+    std::vector<MeshData> cookMeshes;
+    std::vector<SkeletonData> cookSkeletons;
+    if (!load_gltf_model(s_glbFilepath, cookMeshes, cookSkeletons) || cookMeshes.empty())
+    {
+        printf("FAILED TO LOAD THE GLTF MODEL!\n");
+        remove(s_glbFilepath);
+        return;
+    }
+    for (MeshData& meshData : cookMeshes)
+        shrink_index_buffers(meshData);
+    write_file(s_cookedFilepath, create_cooked_model(cookMeshes, cookSkeletons));
+
+    bool success = true;
+    const double gltfTime = time_milliseconds(
+        [&]()
+        {
+            std::vector<MeshData> meshes;
+            std::vector<SkeletonData> skeletons;
+            success &= load_gltf_model(s_glbFilepath, meshes, skeletons);
+        },
+        iterations
+    );
+
+    std::vector<MeshData> cookedMeshes;
+    const double cookedTime = time_milliseconds(
+        [&]()
+        {
+            cookedMeshes.clear();
+            std::vector<SkeletonData> skeletons;
+            success &= load_cooked_model(s_cookedFilepath, cookedMeshes, skeletons);
+        },
+        iterations
+    );
+
+    // Vertices should be identical, indices only narrowed
+    const MeshData& cookedMesh = cookedMeshes[0];
+    const MeshData& sourceMesh = cookMeshes[0];
+    success &= cookedMesh.vertexBufferData.rawData == sourceMesh.vertexBufferData.rawData;
+
+    if (!success)
+        printf("COOKED MODEL DIDN'T MATCH THE GLTF MODEL!\n");
+    printf(
+        "%-32s baseline: %8.3f ms  cooked: %8.3f ms  speedup: %6.2fx  index size: %zu bytes\n",
+        "load model",
+        gltfTime,
+        cookedTime,
+        gltfTime / cookedTime,
+        cookedMesh.indexBufferData[0].elementSize
+    );
+
+    remove(s_glbFilepath);
+    remove(s_cookedFilepath);
+}
+
+void run_cooked_model_benchmark(size_t gridSize, int iterations)
+{
+    if (gridSize > 0)
+    {
+        run_cooked_model_benchmark_size((int)gridSize, iterations);
+        return;
+    }
+
+    // 256 * 256 vertices = max that fits 16 bit indices
+    const int gridSizes[] = { 64, 256, 512 };
+    for (int size : gridSizes)
+        run_cooked_model_benchmark_size(size, iterations);
+}
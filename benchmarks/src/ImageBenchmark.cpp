@@ -0,0 +1,169 @@
+#include "Benchmarks.hpp"
+#include "platypus/utils/ImageDataUtils.hpp"
+#include "platypus/utils/Compression.hpp"
+#include "platypus/utils/FileUtils.hpp"
+
+#include "stb_image.h"
+#include "stb_image_write.h"
+
+#include <vector>
+#include <string>
+#include <cstring>
+
+using namespace platypus;
+
+
+// Compares deserializing an image by decoding its source PNG (how Image was
+// always deserialized) against reading the pixels embedded in the asset pack,
+// raw and LZ4 compressed. The embedded versions include the full mip chain,
+// so the textures don't need to generate mipmaps either.
+//
+// NOTE: Files are read right after writing them, so they're probably in the
+// OS file cache -> this measures mostly decoding, not disk access.
+
+static const int s_channels = 4;
+static const char* s_pngFilepath = "platypus_image_benchmark.png";
+static const char* s_rawFilepath = "platypus_image_benchmark.raw";
+static const char* s_lz4Filepath = "platypus_image_benchmark.lz4";
+
+// Noisy = smooth gradients with per pixel noise, like photos (LZ4 can't do much with these)
+// Not noisy = flat shapes, like UI textures and atlases
+static std::vector<PE_ubyte> create_test_image(int size, bool noisy)
+{
+    std::vector<PE_ubyte> pixels((size_t)size * size * s_channels);
+    for (int y = 0; y < size; ++y)
+    {
+        for (int x = 0; x < size; ++x)
+        {
+            PE_ubyte* pPixel = pixels.data() + ((size_t)x + (size_t)y * size) * s_channels;
+            if (noisy)
+            {
+                const int noise = rand() % 8;
+                pPixel[0] = (PE_ubyte)((x * 255 / size + noise) & 0xFF);
+                pPixel[1] = (PE_ubyte)((y * 255 / size + noise) & 0xFF);
+                pPixel[2] = (PE_ubyte)(((x ^ y) & 0x3F) + noise);
+                pPixel[3] = 255;
+            }
+            else
+            {
+                const int cell = ((x / 64) + (y / 64) * 3) % 5;
+                pPixel[0] = (PE_ubyte)(cell * 50);
+                pPixel[1] = (PE_ubyte)(255 - cell * 40);
+                pPixel[2] = (PE_ubyte)((x / 16 % 2) * 128);
+                pPixel[3] = (PE_ubyte)(cell == 0 ? 0 : 255);
+            }
+        }
+    }
+    return pixels;
+}
+
+static double time_milliseconds(const std::function<void()>& func, int iterations)
+{
+    func();
+    std::chrono::time_point<std::chrono::high_resolution_clock> beginTime = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        func();
+    std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - beginTime;
+    return duration.count() / iterations;
+}
+
+static void run_image_load_benchmark_size(int size, bool noisy, int iterations)
+{
+    printf("-- Image: %dx%d RGBA, %s --\n", size, size, noisy ? "noisy" : "flat");
+
+    const std::vector<PE_ubyte> pixels = create_test_image(size, noisy);
+    stbi_write_png(s_pngFilepath, size, size, s_channels, pixels.data(), size * s_channels);
+
+    // "Cooking" the embedded versions
+    const uint32_t mipLevelCount = get_mip_level_count(size, size);
+    const size_t chainSize = get_mip_chain_size(size, size, s_channels, mipLevelCount);
+    std::vector<char> chain(chainSize);
+    const double cookTime = time_milliseconds(
+        [&]()
+        {
+            memcpy(chain.data(), pixels.data(), pixels.size());
+            generate_mip_chain((PE_ubyte*)chain.data(), size, size, s_channels, mipLevelCount, true);
+        },
+        1
+    );
+    std::vector<char> compressed;
+    const double compressTime = time_milliseconds(
+        [&]() { compressed = lz4_compress(chain.data(), chain.size()); },
+        1
+    );
+    write_file(s_rawFilepath, chain);
+    write_file(s_lz4Filepath, compressed);
+
+    size_t pngSize = 0;
+    const double pngTime = time_milliseconds(
+        [&]()
+        {
+            const std::vector<char> fileData = read_file(s_pngFilepath);
+            pngSize = fileData.size();
+            int width = 0;
+            int height = 0;
+            int channels = 0;
+            stbi_uc* pDecoded = stbi_load_from_memory(
+                (const stbi_uc*)fileData.data(),
+                (int)fileData.size(),
+                &width,
+                &height,
+                &channels,
+                0
+            );
+            stbi_image_free(pDecoded);
+        },
+        iterations
+    );
+
+    const double rawTime = time_milliseconds(
+        [&]()
+        {
+            const std::vector<char> fileData = read_file(s_rawFilepath);
+            std::vector<char> loaded(fileData.size());
+            memcpy(loaded.data(), fileData.data(), fileData.size());
+        },
+        iterations
+    );
+
+    bool lz4Valid = true;
+    const double lz4Time = time_milliseconds(
+        [&]()
+        {
+            const std::vector<char> fileData = read_file(s_lz4Filepath);
+            std::vector<char> loaded(chainSize);
+            lz4Valid &= lz4_decompress(fileData.data(), fileData.size(), loaded.data(), chainSize);
+        },
+        iterations
+    );
+
+    printf(
+        "cook: mip chain %.2f ms, lz4 compress %.2f ms%s\n",
+        cookTime,
+        compressTime,
+        lz4Valid ? "" : "  LZ4 DECOMPRESSION FAILED!"
+    );
+    printf("%-28s %8.3f ms  %8zu bytes (level 0 only)\n", "png decode (baseline)", pngTime, pngSize);
+    printf("%-28s %8.3f ms  %8zu bytes  speedup: %6.2fx\n", "embedded raw + mips", rawTime, chain.size(), pngTime / rawTime);
+    printf("%-28s %8.3f ms  %8zu bytes  speedup: %6.2fx\n", "embedded lz4 + mips", lz4Time, compressed.size(), pngTime / lz4Time);
+
+    remove(s_pngFilepath);
+    remove(s_rawFilepath);
+    remove(s_lz4Filepath);
+}
+
+void run_image_load_benchmark(size_t size, int iterations)
+{
+    for (bool noisy : { true, false })
+    {
+        if (size > 0)
+        {
+            run_image_load_benchmark_size((int)size, noisy, iterations);
+            continue;
+        }
+
+        const int sizes[] = { 256, 1024, 2048 };
+        for (int testSize : sizes)
+            run_image_load_benchmark_size(testSize, noisy, iterations);
+    }
+}
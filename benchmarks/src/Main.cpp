@@ -0,0 +1,41 @@
+#include "Benchmarks.hpp"
+#include <string>
+
+
+// Usage: platypus-benchmarks [all|maths|animation|spatial|batch|upload|queue|image|pack|cook] [count] [iterations]
+int main(int argc, const char** argv)
+{
+    const std::string benchmark = argc > 1 ? argv[1] : "all";
+    const int count = argc > 2 ? atoi(argv[2]) : 0;
+    const int iterations = argc > 3 ? atoi(argv[3]) : 0;
+    srand(1234);
+
+    if (benchmark == "all" || benchmark == "maths")
+        run_maths_benchmark(count > 0 ? count : 4096, iterations > 0 ? iterations : 200);
+
+    if (benchmark == "all" || benchmark == "animation")
+        run_animation_benchmark(count > 0 ? count : 1000, iterations > 0 ? iterations : 60);
+
+    if (benchmark == "all" || benchmark == "spatial")
+        run_spatial_benchmark(count, iterations > 0 ? iterations : 40);
+
+    if (benchmark == "all" || benchmark == "batch")
+        run_batch_memory_benchmark(count);
+
+    if (benchmark == "all" || benchmark == "upload")
+        run_batch_upload_benchmark(count, iterations > 0 ? iterations : 200);
+
+    if (benchmark == "all" || benchmark == "queue")
+        run_render_queue_benchmark(count, iterations > 0 ? iterations : 200);
+
+    if (benchmark == "all" || benchmark == "image")
+        run_image_load_benchmark(count, iterations > 0 ? iterations : 10);
+
+    if (benchmark == "all" || benchmark == "pack")
+        run_asset_pack_benchmark(count, iterations > 0 ? iterations : 10);
+
+    if (benchmark == "all" || benchmark == "cook")
+        run_cooked_model_benchmark(count, iterations > 0 ? iterations : 10);
+
+    return 0;
+}
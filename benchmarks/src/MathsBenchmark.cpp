@@ -0,0 +1,184 @@
+#include "Benchmarks.hpp"
+#include "platypus/utils/Maths.hpp"
+
+#include <vector>
+
+using namespace platypus;
+
+
+// Compares the scalar reference maths functions against the (possibly SIMD)
+// engine versions. Reports time per operation and the max difference of the results.
+
+static Quaternion random_quaternion()
+{
+    Vector3f axis(random_float(-1.0f, 1.0f), random_float(-1.0f, 1.0f), random_float(-1.0f, 1.0f));
+    axis = axis.normalize();
+    return Quaternion(axis, random_float(-3.0f, 3.0f));
+}
+
+static Matrix4f random_transformation_matrix()
+{
+    return scalar::create_transformation_matrix(
+        { random_float(-100.0f, 100.0f), random_float(-100.0f, 100.0f), random_float(-100.0f, 100.0f) },
+        random_quaternion(),
+        { random_float(0.5f, 2.0f), random_float(0.5f, 2.0f), random_float(0.5f, 2.0f) }
+    );
+}
+
+void run_maths_benchmark(size_t count, int iterations)
+{
+    printf("== Maths ==\n");
+    #ifdef PLATYPUS_MATHS_AVX
+        printf("Using AVX\n");
+    #elif defined(PLATYPUS_MATHS_SSE)
+        printf("Using SSE\n");
+    #else
+        printf("Using scalar maths only\n");
+    #endif
+    printf("Elements: %zu, iterations: %d\n", count, iterations);
+
+    std::vector<Matrix4f> left(count);
+    std::vector<Matrix4f> right(count);
+    std::vector<Vector4f> points(count);
+    std::vector<Quaternion> fromRotations(count);
+    std::vector<Quaternion> toRotations(count);
+    std::vector<float> amounts(count);
+    std::vector<Vector3f> positions(count);
+    std::vector<Vector3f> scales(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        left[i] = random_transformation_matrix();
+        right[i] = random_transformation_matrix();
+        points[i] = Vector4f(random_float(-10.0f, 10.0f), random_float(-10.0f, 10.0f), random_float(-10.0f, 10.0f), 1.0f);
+        fromRotations[i] = random_quaternion();
+        // Every 8th pair close to each other to also hit the lerp path
+        toRotations[i] = (i % 8) == 0 ? fromRotations[i] : random_quaternion();
+        amounts[i] = random_float(0.0f, 1.0f);
+        positions[i] = Vector3f(random_float(-100.0f, 100.0f), random_float(-100.0f, 100.0f), random_float(-100.0f, 100.0f));
+        scales[i] = Vector3f(random_float(0.5f, 2.0f), random_float(0.5f, 2.0f), random_float(0.5f, 2.0f));
+    }
+
+    std::vector<Matrix4f> scalarMatrices(count);
+    std::vector<Matrix4f> engineMatrices(count);
+    std::vector<Vector4f> scalarPoints(count);
+    std::vector<Vector4f> enginePoints(count);
+    std::vector<Quaternion> scalarRotations(count);
+    std::vector<Quaternion> engineRotations(count);
+
+    // Matrix * Matrix
+    {
+        double scalarTime = time_func([&]() {
+            for (size_t i = 0; i < count; ++i)
+                scalarMatrices[i] = scalar::multiply(left[i], right[i]);
+        }, count, iterations);
+        double engineTime = time_func([&]() {
+            multiply_matrices(left.data(), right.data(), engineMatrices.data(), count);
+        }, count, iterations);
+        print_benchmark_result(
+            "multiply_matrices",
+            scalarTime,
+            engineTime,
+            max_difference(&scalarMatrices[0][0], &engineMatrices[0][0], count * 16)
+        );
+    }
+
+    // Single Matrix * Matrix using the operator
+    {
+        double scalarTime = time_func([&]() {
+            for (size_t i = 0; i < count; ++i)
+                scalarMatrices[i] = scalar::multiply(left[i], right[i]);
+        }, count, iterations);
+        double engineTime = time_func([&]() {
+            for (size_t i = 0; i < count; ++i)
+                engineMatrices[i] = left[i] * right[i];
+        }, count, iterations);
+        print_benchmark_result(
+            "Matrix4f * Matrix4f",
+            scalarTime,
+            engineTime,
+            max_difference(&scalarMatrices[0][0], &engineMatrices[0][0], count * 16)
+        );
+    }
+
+    // Matrix * Vector
+    {
+        const Matrix4f& matrix = left[0];
+        double scalarTime = time_func([&]() {
+            for (size_t i = 0; i < count; ++i)
+                scalarPoints[i] = scalar::multiply(matrix, points[i]);
+        }, count, iterations);
+        double engineTime = time_func([&]() {
+            transform_points(matrix, points.data(), enginePoints.data(), count);
+        }, count, iterations);
+        print_benchmark_result(
+            "transform_points",
+            scalarTime,
+            engineTime,
+            max_difference(&scalarPoints[0].x, &enginePoints[0].x, count * 4)
+        );
+    }
+
+    // Inverse
+    {
+        double scalarTime = time_func([&]() {
+            for (size_t i = 0; i < count; ++i)
+                scalarMatrices[i] = scalar::inverse(left[i]);
+        }, count, iterations);
+        double engineTime = time_func([&]() {
+            for (size_t i = 0; i < count; ++i)
+                engineMatrices[i] = left[i].inverse();
+        }, count, iterations);
+        print_benchmark_result(
+            "Matrix4f::inverse",
+            scalarTime,
+            engineTime,
+            max_difference(&scalarMatrices[0][0], &engineMatrices[0][0], count * 16)
+        );
+    }
+
+    // Slerp
+    {
+        double scalarTime = time_func([&]() {
+            for (size_t i = 0; i < count; ++i)
+                scalarRotations[i] = scalar::slerp(fromRotations[i], toRotations[i], amounts[i]);
+        }, count, iterations);
+        double engineTime = time_func([&]() {
+            slerp_quaternions(
+                fromRotations.data(),
+                toRotations.data(),
+                amounts.data(),
+                engineRotations.data(),
+                count
+            );
+        }, count, iterations);
+        print_benchmark_result(
+            "slerp_quaternions",
+            scalarTime,
+            engineTime,
+            max_difference(&scalarRotations[0].x, &engineRotations[0].x, count * 4)
+        );
+    }
+
+    // Transformation matrix
+    {
+        double scalarTime = time_func([&]() {
+            for (size_t i = 0; i < count; ++i)
+                scalarMatrices[i] = scalar::create_transformation_matrix(positions[i], fromRotations[i], scales[i]);
+        }, count, iterations);
+        double engineTime = time_func([&]() {
+            create_transformation_matrices(
+                positions.data(),
+                fromRotations.data(),
+                scales.data(),
+                engineMatrices.data(),
+                count
+            );
+        }, count, iterations);
+        print_benchmark_result(
+            "create_transformation_matrices",
+            scalarTime,
+            engineTime,
+            max_difference(&scalarMatrices[0][0], &engineMatrices[0][0], count * 16)
+        );
+    }
+}
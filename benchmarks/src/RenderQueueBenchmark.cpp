@@ -0,0 +1,159 @@
+#include "Benchmarks.hpp"
+#include "platypus/graphics/renderers/RenderQueue.hpp"
+
+#include <vector>
+#include <algorithm>
+
+using namespace platypus;
+
+
+// Opaque batches of random pipeline, material and mesh combinations in the order
+// an unordered_map would give them (which is what Renderer3D used to draw).
+// Compares the state changes Renderer3D records with and without the RenderQueue
+// and the RenderQueue's radix sort against std::sort.
+//
+// NOTE: Batches here are never drawn -> pipelines are just unique addresses.
+
+static const size_t s_pipelineCount = 8;
+static const size_t s_materialsPerPipeline = 16;
+static const size_t s_meshCount = 64;
+static const float s_maxDepth = 1000.0f;
+
+struct StateChangeCounts
+{
+    size_t pipelineBinds = 0;
+    size_t descriptorSetBinds = 0;
+    size_t vertexBufferBinds = 0;
+};
+
+// Same comparisons as Renderer3D::recordCommandBuffer
+static StateChangeCounts count_state_changes(const std::vector<Batch*>& batches)
+{
+    StateChangeCounts counts;
+    const Pipeline* pBoundPipeline = nullptr;
+    UUID_t boundMaterial = NULL_UUID;
+    UUID_t boundMesh = NULL_UUID;
+    for (const Batch* pBatch : batches)
+    {
+        if (pBatch->pPipeline != pBoundPipeline)
+        {
+            ++counts.pipelineBinds;
+            pBoundPipeline = pBatch->pPipeline;
+            boundMaterial = NULL_UUID;
+        }
+        if (pBatch->materialID != boundMaterial)
+        {
+            ++counts.descriptorSetBinds;
+            boundMaterial = pBatch->materialID;
+        }
+        if (pBatch->meshID != boundMesh)
+        {
+            ++counts.vertexBufferBinds;
+            boundMesh = pBatch->meshID;
+        }
+    }
+    return counts;
+}
+
+static void run_render_queue_benchmark_count(size_t count, int iterations)
+{
+    printf("-- Batches: %zu --\n", count);
+    std::vector<uint8_t> pipelineStorage(s_pipelineCount);
+    std::vector<Batch> batches(count);
+    std::vector<Batch*> unsortedBatches(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const size_t pipelineIndex = (size_t)rand() % s_pipelineCount;
+        const size_t materialIndex = pipelineIndex * s_materialsPerPipeline + (size_t)rand() % s_materialsPerPipeline;
+        Batch& batch = batches[i];
+        batch.pPipeline = reinterpret_cast<Pipeline*>(&pipelineStorage[pipelineIndex]);
+        batch.materialID = (UUID_t)(materialIndex + 1);
+        batch.meshID = (UUID_t)((size_t)rand() % s_meshCount + 1);
+        batch.minDepth = random_float(0.0f, s_maxDepth);
+        batch.maxDepth = batch.minDepth;
+        unsortedBatches[i] = &batch;
+    }
+
+    RenderQueue renderQueue;
+    const double queueTime = time_func(
+        [&]()
+        {
+            renderQueue.begin(s_maxDepth);
+            for (Batch* pBatch : unsortedBatches)
+                renderQueue.add(RenderPassType::OPAQUE_PASS, pBatch);
+            renderQueue.sort();
+        },
+        count,
+        iterations
+    );
+
+    std::vector<RenderQueueItem> items(count);
+    std::vector<RenderQueueItem> sortBuffer(count);
+    std::vector<RenderQueueItem> radixItems(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const Batch* pBatch = unsortedBatches[i];
+        items[i].sortKey = RenderQueue::create_sort_key(
+            RenderPassType::OPAQUE_PASS,
+            (uint16_t)(reinterpret_cast<const uint8_t*>(pBatch->pPipeline) - pipelineStorage.data()),
+            (uint16_t)pBatch->materialID,
+            (uint16_t)pBatch->meshID,
+            pBatch->minDepth,
+            s_maxDepth
+        );
+        items[i].pBatch = unsortedBatches[i];
+    }
+    std::vector<RenderQueueItem> stdSortItems(count);
+    const double stdSortTime = time_func(
+        [&]()
+        {
+            stdSortItems = items;
+            std::sort(
+                stdSortItems.begin(),
+                stdSortItems.end(),
+                [](const RenderQueueItem& a, const RenderQueueItem& b) { return a.sortKey < b.sortKey; }
+            );
+        },
+        count,
+        iterations
+    );
+    const double radixSortTime = time_func(
+        [&]()
+        {
+            radixItems = items;
+            RenderQueue::radix_sort(radixItems.data(), sortBuffer.data(), count);
+        },
+        count,
+        iterations
+    );
+    float mismatchCount = 0.0f;
+    for (size_t i = 0; i < count; ++i)
+        mismatchCount += radixItems[i].sortKey != stdSortItems[i].sortKey ? 1.0f : 0.0f;
+    print_benchmark_result("std::sort vs radix_sort", stdSortTime, radixSortTime, mismatchCount);
+    printf("%-32s %7.2f ns per batch\n", "RenderQueue add + sort", queueTime);
+
+    const StateChangeCounts unsortedCounts = count_state_changes(unsortedBatches);
+    const StateChangeCounts sortedCounts = count_state_changes(renderQueue.getBatches(RenderPassType::OPAQUE_PASS));
+    printf(
+        "pipeline binds: %6zu -> %6zu  descriptor set binds: %6zu -> %6zu  vertex buffer binds: %6zu -> %6zu\n",
+        unsortedCounts.pipelineBinds,
+        sortedCounts.pipelineBinds,
+        unsortedCounts.descriptorSetBinds,
+        sortedCounts.descriptorSetBinds,
+        unsortedCounts.vertexBufferBinds,
+        sortedCounts.vertexBufferBinds
+    );
+}
+
+void run_render_queue_benchmark(size_t count, int iterations)
+{
+    printf("== Render queue ==\n");
+    if (count > 0)
+    {
+        run_render_queue_benchmark_count(count, iterations);
+        return;
+    }
+    run_render_queue_benchmark_count(100, iterations);
+    run_render_queue_benchmark_count(1000, iterations);
+    run_render_queue_benchmark_count(10000, iterations);
+}
@@ -0,0 +1,365 @@
+#include "Benchmarks.hpp"
+#include "platypus/utils/BVH.hpp"
+#include "platypus/utils/Bounds.hpp"
+#include "platypus/ecs/SpatialIndex.hpp"
+
+#include <vector>
+#include <algorithm>
+
+#ifdef PLATYPUS_MATHS_SSE
+    #include <immintrin.h>
+#endif
+
+using namespace platypus;
+
+
+// Boxes scattered evenly in a world whose size grows with the box count, so the
+// density stays the same. Compares BVH queries against testing every box
+// (which is what the renderer's frustum culling used to do) and refitting
+// against rebuilding the tree.
+
+static const float s_boxSpacing = 10.0f;
+static const float s_movingFraction = 0.1f;
+
+// Box is outside if it's completely behind any of the planes
+static inline bool box_outside_plane(const Vector4f& plane, const Vector3f& center, const Vector3f& extents)
+{
+    const float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+    const float radius = std::abs(plane.x) * extents.x + std::abs(plane.y) * extents.y + std::abs(plane.z) * extents.z;
+    return distance + radius < 0.0f;
+}
+
+// Tests every box against the frustum, 4 boxes at a time using SSE if available.
+// visibleBits get or'd into pOutResults[i] if the box is at least partially inside the frustum.
+static void cull_boxes(
+    const Frustum& frustum,
+    const Vector3f* pCenters,
+    const Vector3f* pExtents,
+    size_t count,
+    uint8_t* pOutResults,
+    uint8_t visibleBits
+)
+{
+    size_t i = 0;
+#ifdef PLATYPUS_MATHS_SSE
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4)
+    {
+        const Vector3f* c = pCenters + i;
+        const Vector3f* e = pExtents + i;
+        const __m128 cx = _mm_setr_ps(c[0].x, c[1].x, c[2].x, c[3].x);
+        const __m128 cy = _mm_setr_ps(c[0].y, c[1].y, c[2].y, c[3].y);
+        const __m128 cz = _mm_setr_ps(c[0].z, c[1].z, c[2].z, c[3].z);
+        const __m128 ex = _mm_setr_ps(e[0].x, e[1].x, e[2].x, e[3].x);
+        const __m128 ey = _mm_setr_ps(e[0].y, e[1].y, e[2].y, e[3].y);
+        const __m128 ez = _mm_setr_ps(e[0].z, e[1].z, e[2].z, e[3].z);
+
+        __m128 outside = zero;
+        for (const Vector4f& plane : frustum.planes)
+        {
+            __m128 distance = _mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(plane.x)), _mm_set1_ps(plane.w));
+            distance = _mm_add_ps(distance, _mm_mul_ps(cy, _mm_set1_ps(plane.y)));
+            distance = _mm_add_ps(distance, _mm_mul_ps(cz, _mm_set1_ps(plane.z)));
+
+            __m128 radius = _mm_mul_ps(ex, _mm_set1_ps(std::abs(plane.x)));
+            radius = _mm_add_ps(radius, _mm_mul_ps(ey, _mm_set1_ps(std::abs(plane.y))));
+            radius = _mm_add_ps(radius, _mm_mul_ps(ez, _mm_set1_ps(std::abs(plane.z))));
+
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+        }
+
+        const int outsideMask = _mm_movemask_ps(outside);
+        for (int j = 0; j < 4; ++j)
+        {
+            if ((outsideMask & (1 << j)) == 0)
+                pOutResults[i + j] |= visibleBits;
+        }
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        bool outside = false;
+        for (const Vector4f& plane : frustum.planes)
+        {
+            if (box_outside_plane(plane, pCenters[i], pExtents[i]))
+            {
+                outside = true;
+                break;
+            }
+        }
+        if (!outside)
+            pOutResults[i] |= visibleBits;
+    }
+}
+
+static bool brute_force_overlap(const AABB& a, const AABB& b)
+{
+    return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+        a.min.y <= b.max.y && a.max.y >= b.min.y &&
+        a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+static bool brute_force_sphere_overlap(const AABB& aabb, const BoundingSphere& sphere)
+{
+    const float x = std::max(aabb.min.x, std::min(sphere.center.x, aabb.max.x)) - sphere.center.x;
+    const float y = std::max(aabb.min.y, std::min(sphere.center.y, aabb.max.y)) - sphere.center.y;
+    const float z = std::max(aabb.min.z, std::min(sphere.center.z, aabb.max.z)) - sphere.center.z;
+    return x * x + y * y + z * z <= sphere.radius * sphere.radius;
+}
+
+static bool brute_force_ray_hit(const Vector3f& origin, const Vector3f& inverseDirection, const AABB& aabb, float& outDistance)
+{
+    const float tx0 = (aabb.min.x - origin.x) * inverseDirection.x;
+    const float tx1 = (aabb.max.x - origin.x) * inverseDirection.x;
+    const float ty0 = (aabb.min.y - origin.y) * inverseDirection.y;
+    const float ty1 = (aabb.max.y - origin.y) * inverseDirection.y;
+    const float tz0 = (aabb.min.z - origin.z) * inverseDirection.z;
+    const float tz1 = (aabb.max.z - origin.z) * inverseDirection.z;
+    const float tEnter = std::max(std::max(std::min(tx0, tx1), std::min(ty0, ty1)), std::max(std::min(tz0, tz1), 0.0f));
+    const float tExit = std::min(std::min(std::max(tx0, tx1), std::max(ty0, ty1)), std::max(tz0, tz1));
+    outDistance = tEnter;
+    return tEnter <= tExit;
+}
+
+static AABB create_random_box(float worldHalfSize)
+{
+    const Vector3f center(
+        random_float(-worldHalfSize, worldHalfSize),
+        random_float(-worldHalfSize, worldHalfSize),
+        random_float(-worldHalfSize, worldHalfSize)
+    );
+    const Vector3f extents(random_float(0.5f, 2.0f), random_float(0.5f, 2.0f), random_float(0.5f, 2.0f));
+    AABB aabb;
+    aabb.min = center - extents;
+    aabb.max = center + extents;
+    return aabb;
+}
+
+static AABB move_box(const AABB& aabb)
+{
+    const Vector3f offset(random_float(-0.5f, 0.5f), random_float(-0.5f, 0.5f), random_float(-0.5f, 0.5f));
+    AABB moved;
+    moved.min = aabb.min + offset;
+    moved.max = aabb.max + offset;
+    return moved;
+}
+
+static void run_spatial_benchmark_count(size_t count, int iterations)
+{
+    const float worldHalfSize = std::cbrt(static_cast<float>(count)) * s_boxSpacing * 0.5f;
+    printf("-- Boxes: %zu, world size: %.0f --\n", count, worldHalfSize * 2.0f);
+
+    std::vector<AABB> boxes(count);
+    std::vector<Vector3f> centers(count);
+    std::vector<Vector3f> extents(count);
+    std::vector<uint32_t> ids(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        boxes[i] = create_random_box(worldHalfSize);
+        centers[i] = boxes[i].getCenter();
+        extents[i] = boxes[i].getExtents();
+        ids[i] = static_cast<uint32_t>(i);
+    }
+
+    BVH bvh;
+    const double buildTime = time_func([&]() { bvh.build(boxes.data(), ids.data(), count); }, count, std::max(1, iterations / 10));
+    printf("%-32s %7.2f ns per box (%.2f ms), nodes: %zu\n", "BVH::build", buildTime, buildTime * count * 1.0e-6, bvh.getNodeCount());
+
+    // Refit vs rebuild with some of the boxes moving each frame
+    const size_t movingCount = static_cast<size_t>(static_cast<float>(count) * s_movingFraction);
+    std::vector<AABB> movedBoxes = boxes;
+    const double rebuildTime = time_func(
+        [&]()
+        {
+            for (size_t i = 0; i < movingCount; ++i)
+                movedBoxes[i] = move_box(movedBoxes[i]);
+            bvh.build(movedBoxes.data(), ids.data(), count);
+        },
+        count,
+        std::max(1, iterations / 10)
+    );
+    bvh.build(boxes.data(), ids.data(), count);
+    movedBoxes = boxes;
+    const double refitTime = time_func(
+        [&]()
+        {
+            for (size_t i = 0; i < movingCount; ++i)
+            {
+                movedBoxes[i] = move_box(movedBoxes[i]);
+                bvh.setItemBounds(i, movedBoxes[i]);
+            }
+            bvh.refit();
+        },
+        count,
+        iterations
+    );
+    print_benchmark_result("refit 10% moving", rebuildTime, refitTime, 0.0f);
+    bvh.build(boxes.data(), ids.data(), count);
+
+    // Frustum from the world's center
+    const Matrix4f projectionMatrix = create_perspective_projection_matrix(16.0f / 9.0f, 1.3f, 0.1f, worldHalfSize);
+    const Frustum frustum = create_frustum(projectionMatrix);
+    std::vector<uint8_t> cullResults(count);
+    size_t bruteForceVisible = 0;
+    const double bruteFrustumTime = time_func(
+        [&]()
+        {
+            std::fill(cullResults.begin(), cullResults.end(), 0);
+            cull_boxes(frustum, centers.data(), extents.data(), count, cullResults.data(), 1);
+            bruteForceVisible = 0;
+            for (uint8_t result : cullResults)
+                bruteForceVisible += result;
+        },
+        count,
+        iterations
+    );
+    std::vector<uint32_t> results;
+    const double bvhFrustumTime = time_func(
+        [&]()
+        {
+            results.clear();
+            bvh.queryFrustum(frustum, results);
+        },
+        count,
+        iterations
+    );
+    printf("frustum visible: %zu / %zu\n", results.size(), count);
+    print_benchmark_result("frustum query", bruteFrustumTime, bvhFrustumTime, std::abs((float)results.size() - (float)bruteForceVisible));
+
+    // AABB and sphere around the world's center
+    AABB queryBox;
+    queryBox.min = Vector3f(-worldHalfSize, -worldHalfSize, -worldHalfSize) * 0.1f;
+    queryBox.max = Vector3f(worldHalfSize, worldHalfSize, worldHalfSize) * 0.1f;
+    size_t bruteForceCount = 0;
+    const double bruteAABBTime = time_func(
+        [&]()
+        {
+            bruteForceCount = 0;
+            for (const AABB& box : boxes)
+                bruteForceCount += brute_force_overlap(box, queryBox) ? 1 : 0;
+        },
+        count,
+        iterations
+    );
+    const double bvhAABBTime = time_func(
+        [&]()
+        {
+            results.clear();
+            bvh.queryAABB(queryBox, results);
+        },
+        count,
+        iterations
+    );
+    print_benchmark_result("AABB query", bruteAABBTime, bvhAABBTime, std::abs((float)results.size() - (float)bruteForceCount));
+
+    BoundingSphere querySphere;
+    querySphere.radius = worldHalfSize * 0.1f;
+    const double bruteSphereTime = time_func(
+        [&]()
+        {
+            bruteForceCount = 0;
+            for (const AABB& box : boxes)
+                bruteForceCount += brute_force_sphere_overlap(box, querySphere) ? 1 : 0;
+        },
+        count,
+        iterations
+    );
+    const double bvhSphereTime = time_func(
+        [&]()
+        {
+            results.clear();
+            bvh.querySphere(querySphere, results);
+        },
+        count,
+        iterations
+    );
+    print_benchmark_result("sphere query", bruteSphereTime, bvhSphereTime, std::abs((float)results.size() - (float)bruteForceCount));
+
+    // Ray through the whole world from corner to corner, hits sorted like the picking would need
+    const Vector3f rayOrigin(-worldHalfSize, -worldHalfSize * 0.9f, -worldHalfSize * 0.8f);
+    const Vector3f rayDirection = (Vector3f(0, 0, 0) - rayOrigin).normalize();
+    const Vector3f inverseDirection(1.0f / rayDirection.x, 1.0f / rayDirection.y, 1.0f / rayDirection.z);
+    std::vector<RayQueryHit> bruteForceHits;
+    const double bruteRayTime = time_func(
+        [&]()
+        {
+            bruteForceHits.clear();
+            for (size_t i = 0; i < count; ++i)
+            {
+                float distance = 0.0f;
+                if (brute_force_ray_hit(rayOrigin, inverseDirection, boxes[i], distance))
+                    bruteForceHits.push_back({ ids[i], distance });
+            }
+            std::sort(
+                bruteForceHits.begin(),
+                bruteForceHits.end(),
+                [](const RayQueryHit& a, const RayQueryHit& b) { return a.distance < b.distance; }
+            );
+        },
+        count,
+        iterations
+    );
+    std::vector<RayQueryHit> hits;
+    const double bvhRayTime = time_func(
+        [&]()
+        {
+            hits.clear();
+            bvh.queryRay(rayOrigin, rayDirection, INFINITY, hits);
+        },
+        count,
+        iterations
+    );
+    const float closestDiff = hits.empty() || bruteForceHits.empty() ? 0.0f : std::abs(hits[0].distance - bruteForceHits[0].distance);
+    printf("ray hits: %zu\n", hits.size());
+    print_benchmark_result("ray query", bruteRayTime, bvhRayTime, std::abs((float)hits.size() - (float)bruteForceHits.size()) + closestDiff);
+
+    // Per frame maintenance of the SpatialIndex, baseline rebuilds a single tree every frame
+    std::vector<entityID_t> entities(count);
+    for (size_t i = 0; i < count; ++i)
+        entities[i] = static_cast<entityID_t>(i);
+    movedBoxes = boxes;
+    const double indexRebuildTime = time_func(
+        [&]()
+        {
+            for (size_t i = 0; i < movingCount; ++i)
+                movedBoxes[i] = move_box(movedBoxes[i]);
+            bvh.build(movedBoxes.data(), ids.data(), count);
+        },
+        count,
+        std::max(1, iterations / 10)
+    );
+    SpatialIndex spatialIndex;
+    spatialIndex.update(entities.data(), boxes.data(), count, true);
+    movedBoxes = boxes;
+    const double indexUpdateTime = time_func(
+        [&]()
+        {
+            for (size_t i = 0; i < movingCount; ++i)
+                movedBoxes[i] = move_box(movedBoxes[i]);
+            spatialIndex.update(entities.data(), movedBoxes.data(), movingCount, false);
+        },
+        count,
+        iterations
+    );
+    std::vector<entityID_t> visibleEntities;
+    spatialIndex.queryFrustum(frustum, visibleEntities);
+    printf(
+        "SpatialIndex static: %zu dynamic: %zu\n",
+        spatialIndex.getStatistics().staticEntityCount,
+        spatialIndex.getStatistics().dynamicEntityCount
+    );
+    print_benchmark_result("SpatialIndex::update 10% moving", indexRebuildTime, indexUpdateTime, 0.0f);
+}
+
+void run_spatial_benchmark(size_t count, int iterations)
+{
+    printf("== Spatial queries ==\n");
+    if (count > 0)
+    {
+        run_spatial_benchmark_count(count, iterations);
+        return;
+    }
+    run_spatial_benchmark_count(10000, iterations);
+    run_spatial_benchmark_count(100000, iterations);
+    run_spatial_benchmark_count(1000000, std::max(1, iterations / 4));
+}
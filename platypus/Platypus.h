@@ -24,6 +24,7 @@
 #include "core/InputManager.hpp"
 #include "core/InputEvent.hpp"
 #include "core/Timing.hpp"
+#include "core/JobSystem.hpp"
 #include "core/Debug.hpp"
 #include "core/SceneManager.hpp"
 #include "core/Memory.hpp"
@@ -32,8 +33,10 @@
 #include "ecs/systems/SkeletalAnimationSystem.hpp"
 #include "ecs/systems/LightSystem.hpp"
 #include "ecs/systems/System.hpp"
+#include "ecs/systems/SystemScheduler.hpp"
 #include "ecs/systems/TransformSystem.hpp"
 #include "ecs/Entity.hpp"
+#include "ecs/View.hpp"
 #include "ecs/components/Renderable.hpp"
 #include "ecs/components/Component.hpp"
 #include "ecs/components/Terrain.hpp"
@@ -47,7 +47,7 @@ namespace platypus
 
     Asset::Asset(
         AssetManager* pAssetManager,
-        const std::vector<char>& targetBuffer,
+        const DataView& targetBuffer,
         size_t bufferPos
     ) :
         _uuidPool(pAssetManager->getUUIDPool())
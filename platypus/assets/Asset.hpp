@@ -1,6 +1,7 @@
 #pragma once
 
 #include "platypus/utils/UUID.hpp"
+#include "platypus/utils/DataView.hpp"
 #include <string>
 #include <vector>
 
@@ -50,6 +51,9 @@ namespace platypus
         std::string _name;
         bool _persistent = false;
         bool _serializable = true;
+        // False if the deserialization constructor rejected the data.
+        // NOTE: Invalid assets don't add themselves to the AssetManager
+        bool _valid = true;
 
     public:
         Asset() = delete;
@@ -63,7 +67,7 @@ namespace platypus
         );
         Asset(
             AssetManager* pAssetManager,
-            const std::vector<char>& targetBuffer,
+            const DataView& targetBuffer,
             size_t bufferPos
         );
 
@@ -71,6 +75,8 @@ namespace platypus
 
         virtual void serialize(std::vector<char>& targetBuffer) const { }
         virtual size_t getSerializedSize() const { return 0; }
+        // Assets which have to exist before this one can be deserialized and finalized
+        virtual std::vector<UUID_t> getDependencies() const { return { }; }
 
         // TODO: Maybe this should be member var of Asset..?
         inline bool isPersistent() const { return _persistent; }
@@ -84,6 +90,7 @@ namespace platypus
         inline void setName(const std::string& name) { _name = name; }
         inline bool isSerializable() const { return _serializable; }
         inline void setSerializable(bool arg) { _serializable = arg; }
+        inline bool isValid() const { return _valid; }
 
     protected:
         // NOTE: pData must be at least asset_base_serialized_size
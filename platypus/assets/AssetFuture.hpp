@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Asset.hpp"
+#include <memory>
+#include <string>
+
+
+namespace platypus
+{
+    enum class AsyncLoadStatus
+    {
+        PENDING,
+        LOADED,
+        FAILED
+    };
+
+    // Shared between the AssetManager and the AssetFutures of a single async load.
+    // NOTE: Only accessed on the main thread! Workers never see this.
+    struct AsyncAssetState
+    {
+        AsyncLoadStatus status = AsyncLoadStatus::PENDING;
+        Asset* pAsset = nullptr;
+        std::string error;
+    };
+
+
+    // Handle to an asset being loaded by AssetManager's async load funcs.
+    // The asset becomes available after the AssetManager has finalized it on the main thread
+    // (AssetManager::finalizeAsyncLoads, called every frame by the Application).
+    //
+    // NOTE: The future doesn't own the asset! If the asset gets destroyed through the
+    // AssetManager, get() will return a dangling ptr. Prefer storing the asset's ID.
+    class AssetFuture
+    {
+    private:
+        std::shared_ptr<AsyncAssetState> _pState;
+
+    public:
+        AssetFuture() = default;
+        AssetFuture(const std::shared_ptr<AsyncAssetState>& pState) :
+            _pState(pState)
+        {}
+
+        // Invalid future = the load request got rejected immediately
+        inline bool isValid() const { return _pState != nullptr; }
+        inline bool isDone() const { return !_pState || _pState->status != AsyncLoadStatus::PENDING; }
+        inline bool isLoaded() const { return _pState && _pState->status == AsyncLoadStatus::LOADED; }
+        inline bool hasFailed() const { return !_pState || _pState->status == AsyncLoadStatus::FAILED; }
+
+        // Returns nullptr until loaded
+        inline Asset* get() const { return isLoaded() ? _pState->pAsset : nullptr; }
+
+        template <typename T>
+        inline T* getAs() const { return (T*)get(); }
+
+        inline UUID_t getID() const { return isLoaded() ? _pState->pAsset->getID() : NULL_UUID; }
+
+        inline std::string getError() const
+        {
+            return _pState ? _pState->error : "Load request was rejected";
+        }
+    };
+}
@@ -1,9 +1,13 @@
 #include "AssetManager.hpp"
 #include "platypus/graphics/Buffers.hpp"
+#include "platypus/graphics/Device.hpp"
+#include "platypus/core/Application.hpp"
 #include "platypus/core/Debug.hpp"
 #include "platypus/utils/modelLoading/ModelLoading.hpp"
 #include "platypus/Common.h"
 
+#include <chrono>
+
 
 namespace platypus
 {
@@ -15,6 +19,7 @@ namespace platypus
     AssetManager::~AssetManager()
     {
         destroyDefaultAssets();
+        closeAssetPacks();
 
         for (TextureSampler* pSampler : _textureSamplers)
             delete pSampler;
@@ -153,6 +158,8 @@ namespace platypus
 
     void AssetManager::destroyAssets()
     {
+        cancelAsyncLoads();
+
         std::unordered_map<UUID_t, Asset*>::iterator it;
         for (it = _assets.begin(); it != _assets.end(); ++it)
         {
@@ -212,7 +219,14 @@ namespace platypus
         destroyAsset(assetID);
     }
 
-    Image* AssetManager::createImage(PE_ubyte* pData, int width, int height, int channels, ImageFormat format)
+    Image* AssetManager::createImage(
+        PE_ubyte* pData,
+        int width,
+        int height,
+        int channels,
+        ImageFormat format,
+        uint32_t mipLevelCount
+    )
     {
         bool failure = false;
         if (!pData)
@@ -247,7 +261,18 @@ namespace platypus
             PLATYPUS_ASSERT(false);
             return nullptr;
         }
-        Image* pImage = new Image(_uuidPool, pData, width, height, channels, format);
+        Image* pImage = new Image(
+            _uuidPool,
+            pData,
+            width,
+            height,
+            channels,
+            format,
+            "",
+            NULL_UUID,
+            false,
+            mipLevelCount
+        );
         _assets[pImage->getID()] = pImage;
         return pImage;
     }
@@ -269,12 +294,16 @@ namespace platypus
         int height = -1;
         int channels = -1;
         PE_ubyte* pPixels = nullptr;
+        uint32_t mipLevelCount = 1;
+        bool sRGBMips = false;
         if (!Image::read_image_pixels(
                 filepath,
                 &width,
                 &height,
                 &channels,
-                &pPixels
+                &pPixels,
+                &mipLevelCount,
+                &sRGBMips
             ))
         {
             std::string error = "Failed to load image from: " + filepath;
@@ -286,17 +315,18 @@ namespace platypus
             _errors.push_back(error);
             return nullptr;
         }
-        Image* pImage = new Image(
-            _uuidPool,
+        Image* pImage = createLoadedImage(
+            filepath,
             pPixels,
             width,
             height,
             channels,
+            mipLevelCount,
+            sRGBMips,
             format,
             name,
             id
         );
-        pImage->setFilepath(filepath);
         delete[] pPixels;
         // Old way of loading images below...
         /*
@@ -311,7 +341,6 @@ namespace platypus
             return nullptr;
         }
         */
-        _assets[pImage->getID()] = pImage;
         return pImage;
     }
 
@@ -550,6 +579,7 @@ namespace platypus
             { } // animations
         );
         pMesh->storeHostsideBuffersOnDeserialization(storeHostsideBuffersOnDeserialization);
+        pMesh->calculateBounds(vertexData.data(), vertexData.size() * sizeof(float));
         _assets[pMesh->getID()] = pMesh;
         return pMesh;
     }
@@ -581,7 +611,8 @@ namespace platypus
         const std::string& name,
         UUID_t modelID,
         std::vector<UUID_t> meshIDs,
-        bool storeBuffersHostSide
+        bool storeBuffersHostSide,
+        const AnimationCompression& animationCompression
     )
     {
         if (!name.empty() && !nameAvailable(name))
@@ -593,7 +624,7 @@ namespace platypus
         std::vector<MeshData> loadedMeshes;
         std::vector<SkeletonData> loadedSkeletons;
         // NOTE: This is pretty fragile with animations and skinned meshes atm!
-        if (!load_gltf_model(filepath, loadedMeshes, loadedSkeletons))
+        if (!load_model_data(filepath, loadedMeshes, loadedSkeletons))
         {
             Debug::log(
                 "Failed to load model using filepath: " + filepath,
@@ -605,117 +636,20 @@ namespace platypus
             return nullptr;
         }
 
-        if (!loadedSkeletons.empty() && instanced)
-        {
-            Debug::log(
-                "Instancing not supported for skinned/animated meshes",
-                PLATYPUS_CURRENT_FUNC_NAME,
-                Debug::MessageType::PLATYPUS_ERROR
-            );
-            PLATYPUS_ASSERT(false);
-            return nullptr;
-        }
-
-        std::vector<Mesh*> createdMeshes;
-        for (size_t i = 0; i < loadedMeshes.size(); ++i)
-        {
-            const MeshData& meshData = loadedMeshes[i];
-            const std::string meshName = name + "." + meshData.name;
-            Buffer* pVertexBuffer = new Buffer(
-                (void*)meshData.vertexBufferData.rawData.data(),
-                meshData.vertexBufferData.elementSize,
-                meshData.vertexBufferData.length,
-                BufferUsageFlagBits::BUFFER_USAGE_VERTEX_BUFFER_BIT | BufferUsageFlagBits::BUFFER_USAGE_TRANSFER_DST_BIT,
-                BufferUpdateFrequency::BUFFER_UPDATE_FREQUENCY_STATIC,
-                storeBuffersHostSide
-            );
-            MeshBufferData useIndexBuffer = meshData.indexBufferData[0];
-            Buffer* pIndexBuffer = new Buffer(
-                (void*)useIndexBuffer.rawData.data(),
-                useIndexBuffer.elementSize,
-                useIndexBuffer.length,
-                BufferUsageFlagBits::BUFFER_USAGE_INDEX_BUFFER_BIT | BufferUsageFlagBits::BUFFER_USAGE_TRANSFER_DST_BIT,
-                BufferUpdateFrequency::BUFFER_UPDATE_FREQUENCY_STATIC,
-                storeBuffersHostSide
-            );
-
-            uint32_t meshPropertyFlags = 0;
-            if (!loadedSkeletons.empty())
-                meshPropertyFlags |= static_cast<uint32_t>(MeshPropertyFlagBits::TYPE_SKINNED);
-            else
-                meshPropertyFlags |= static_cast<uint32_t>(MeshPropertyFlagBits::TYPE_STATIC);
-
-            if (instanced)
-                meshPropertyFlags |= static_cast<uint32_t>(MeshPropertyFlagBits::INSTANCED);
-
-            // Add TANGENTS to mesh property flags if found from VertexBufferLayout
-            for (const VertexBufferElement& vertexBufferElement : meshData.vertexBufferLayout.getElements())
-            {
-                if (vertexBufferElement.getAttribType() == VertexAttributeType::TANGENT)
-                {
-                    meshPropertyFlags |= static_cast<uint32_t>(MeshPropertyFlagBits::HAS_TANGENTS);
-                    break;
-                }
-            }
-
-            if (instanced && (meshPropertyFlags & static_cast<uint32_t>(MeshPropertyFlagBits::TYPE_SKINNED)))
-            {
-                Debug::log(
-                    "Mesh had animations but was also marked to use instancing. "
-                    "Currently instanced animated meshes aren't supported!",
-                    PLATYPUS_CURRENT_FUNC_NAME,
-                    Debug::MessageType::PLATYPUS_ERROR
-                );
-                PLATYPUS_ASSERT(false);
-            }
-
-            UUID_t meshID = NULL_UUID;
-            if (i < meshIDs.size())
-                meshID = meshIDs[i];
-
-            UUID_t skeletonAssetID = NULL_UUID;
-            if (i < loadedSkeletons.size())
-            {
-                const SkeletonData& skeletonData = loadedSkeletons[i];
-
-                const std::string& skeletonName = skeletonData.name;
-                const size_t animationCount = skeletonData.animations.size();
-                std::vector<UUID_t> animationIDs(animationCount);
-                for (size_t animationIndex = 0; animationIndex < animationCount; ++animationIndex)
-                {
-                    SkeletalAnimationData* pSkeletalAnimationAsset = createSkeletalAnimation(
-                        skeletonData.animations[animationIndex]
-                    );
-                    animationIDs[animationIndex] = pSkeletalAnimationAsset->getID();
-                }
-
-                const Pose& skeletonPose = skeletonData.bindPose;
-                Skeleton* pSkeleton = createSkeleton(
-                    skeletonPose.joints,
-                    skeletonPose.jointChildMapping,
-                    animationIDs,
-                    skeletonName
-                );
-                skeletonAssetID = pSkeleton->getID();
-            }
+        Model* pModel = createLoadedModel(
+            filepath,
+            loadedMeshes,
+            loadedSkeletons,
+            instanced,
+            name,
+            modelID,
+            meshIDs,
+            storeBuffersHostSide,
+            animationCompression
+        );
 
-            Mesh* pMesh = new Mesh(
-                _uuidPool,
-                meshPropertyFlags,
-                meshData.vertexBufferLayout,
-                pVertexBuffer,
-                pIndexBuffer,
-                meshData.transformationMatrix,
-                skeletonAssetID,
-                meshName,
-                meshID
-            );
-            _assets[pMesh->getID()] = pMesh;
-            createdMeshes.push_back(pMesh);
-            pMesh->storeHostsideBuffersOnDeserialization(storeBuffersHostSide);
-        }
-        Model* pModel = new Model(_uuidPool, filepath, instanced, createdMeshes, name, modelID);
-        _assets[pModel->getID()] = pModel;
+        // Let the device copy the model's buffers while loading the next assets
+        Device::submit_uploads();
         return pModel;
     }
 
@@ -762,7 +696,8 @@ namespace platypus
     }
 
     SkeletalAnimationData* AssetManager::createSkeletalAnimation(
-        const KeyframeAnimationData& animationData
+        const KeyframeAnimationData& animationData,
+        const AnimationCompression& compression
     )
     {
         if (assetExists(animationData.name))
@@ -779,7 +714,8 @@ namespace platypus
 
         SkeletalAnimationData* pAnimationData = new SkeletalAnimationData(
             _uuidPool,
-            animationData
+            animationData,
+            compression
         );
         _assets[pAnimationData->getID()] = pAnimationData;
         return pAnimationData;
@@ -803,105 +739,439 @@ namespace platypus
         return pFont;
     }
 
-    const TextureSampler* AssetManager::createTextureSampler(
-        TextureSamplerFilterMode filterMode,
-        TextureSamplerAddressMode addressMode,
-        bool useMipmapping
+    // Results of the async loads' worker parts.
+    // NOTE: Written only by the worker and read only by the finalize func
+    // after the worker part has finished.
+    struct AsyncImageData
+    {
+        int width = -1;
+        int height = -1;
+        int channels = -1;
+        uint32_t mipLevelCount = 1;
+        bool sRGBMips = false;
+        PE_ubyte* pPixels = nullptr;
+        bool success = false;
+
+        ~AsyncImageData() { delete[] pPixels; }
+    };
+
+    struct AsyncFontData
+    {
+        Font* pFont = nullptr;
+        bool success = false;
+
+        ~AsyncFontData() { delete pFont; }
+    };
+
+    struct AsyncModelData
+    {
+        std::vector<MeshData> meshes;
+        std::vector<SkeletonData> skeletons;
+        bool success = false;
+    };
+
+    AssetFuture AssetManager::loadImageAsync(
+        const std::string& filepath,
+        ImageFormat format,
+        const std::string& name,
+        UUID_t id
     )
     {
-        if (getTextureSampler(filterMode, addressMode, useMipmapping))
+        if (!name.empty() && !nameAvailable(name))
         {
-            Debug::log(
-                "Texture sampler with given properties already exists!",
-                PLATYPUS_CURRENT_FUNC_NAME,
-                Debug::MessageType::PLATYPUS_ERROR
-            );
-            PLATYPUS_ASSERT(false);
+            _errors.push_back("Name " + name + " not available");
+            return AssetFuture();
         }
-        TextureSampler* pSampler = new TextureSampler(
-            filterMode,
-            addressMode,
-            useMipmapping,
-            0
-        );
-        //_textureSamplers.push_back({
-        //    filterMode,
-        //    addressMode,
-        //    useMipmapping,
-        //    0
-        //});
-        //return &_textureSamplers[_textureSamplers.size() - 1];
-        _textureSamplers.push_back(pSampler);
-        return pSampler;
-    }
 
-    const TextureSampler* AssetManager::getTextureSampler(
-        TextureSamplerFilterMode filterMode,
-        TextureSamplerAddressMode addressMode,
-        bool useMipmapping
-    ) const
-    {
-        for (size_t i = 0; i < _textureSamplers.size(); ++i)
-        {
-            const TextureSampler* pSampler = _textureSamplers[i];
-            if (pSampler->getFilterMode() == filterMode &&
-                pSampler->getAddressMode() == addressMode &&
-                pSampler->isMipmapped() == useMipmapping)
+        std::shared_ptr<AsyncImageData> pData = std::make_shared<AsyncImageData>();
+        return addAsyncLoad(
+            [pData, filepath]()
             {
-                return _textureSamplers[i];
+                pData->success = Image::read_image_pixels(
+                    filepath,
+                    &pData->width,
+                    &pData->height,
+                    &pData->channels,
+                    &pData->pPixels,
+                    &pData->mipLevelCount,
+                    &pData->sRGBMips
+                );
+            },
+            { },
+            [this, pData, filepath, format, name, id]() -> Asset*
+            {
+                if (!pData->success)
+                {
+                    std::string error = "Failed to load image from: " + filepath;
+                    Debug::log(
+                        error,
+                        PLATYPUS_CURRENT_FUNC_NAME,
+                        Debug::MessageType::PLATYPUS_ERROR
+                    );
+                    _errors.push_back(error);
+                    return nullptr;
+                }
+                if (!name.empty() && !nameAvailable(name))
+                {
+                    _errors.push_back("Name " + name + " not available");
+                    return nullptr;
+                }
+                return createLoadedImage(
+                    filepath,
+                    pData->pPixels,
+                    pData->width,
+                    pData->height,
+                    pData->channels,
+                    pData->mipLevelCount,
+                    pData->sRGBMips,
+                    format,
+                    name,
+                    id
+                );
             }
-        }
-        return nullptr;
+        );
     }
 
-    const TextureSampler* AssetManager::getOrCreateTextureSampler(
-        TextureSamplerFilterMode filterMode,
-        TextureSamplerAddressMode addressMode,
-        bool useMipmapping
+    AssetFuture AssetManager::loadTextureAsync(
+        const std::string& filepath,
+        ImageFormat format,
+        const TextureSampler* pSampler,
+        const std::string& name,
+        UUID_t id
     )
     {
-        const TextureSampler* pSampler = getTextureSampler(
-            filterMode,
-            addressMode,
-            useMipmapping
-        );
-        if (!pSampler)
+        if (!name.empty() && !nameAvailable(name))
         {
-            pSampler = createTextureSampler(
-                filterMode,
-                addressMode,
-                useMipmapping
-            );
+            _errors.push_back("Name " + name + " not available");
+            return AssetFuture();
         }
-        return pSampler;
-    }
 
-    bool AssetManager::assetExists(UUID_t assetID) const
-    {
-        std::unordered_map<UUID_t, Asset*>::const_iterator it = _assets.find(assetID);
-        if (it != _assets.end())
-            return true;
+        AssetFuture image = loadImageAsync(filepath, format);
+        if (!image.isValid())
+            return AssetFuture();
 
-        return false;
+        return whenLoaded(
+            { image },
+            [this, image, pSampler, name, id]() -> Asset*
+            {
+                return createTexture(image.getID(), pSampler, name, id);
+            }
+        );
     }
 
-    bool AssetManager::assetExists(UUID_t assetID, AssetType type) const
+    AssetFuture AssetManager::loadModelAsync(
+        const std::string& filepath,
+        bool instanced,
+        const std::string& name,
+        UUID_t modelID,
+        std::vector<UUID_t> meshIDs,
+        bool storeBuffersHostSide,
+        const AnimationCompression& animationCompression
+    )
     {
-        std::unordered_map<UUID_t, Asset*>::const_iterator it = _assets.find(assetID);
-        if (it != _assets.end())
+        if (!name.empty() && !nameAvailable(name))
         {
-            if (it->second->getType() == type)
-                return true;
+            _errors.push_back("Name " + name + " not available");
+            return AssetFuture();
         }
-        return false;
-    }
-
-    bool AssetManager::assetExists(const std::string& assetName) const
-    {
-        if (assetName.empty())
-            return false;
 
-        std::unordered_map<UUID_t, Asset*>::const_iterator it;
+        std::shared_ptr<AsyncModelData> pData = std::make_shared<AsyncModelData>();
+        return addAsyncLoad(
+            [pData, filepath]()
+            {
+                pData->success = load_model_data(filepath, pData->meshes, pData->skeletons);
+            },
+            { },
+            [
+                this,
+                pData,
+                filepath,
+                instanced,
+                name,
+                modelID,
+                meshIDs,
+                storeBuffersHostSide,
+                animationCompression
+            ]() -> Asset*
+            {
+                if (!pData->success)
+                {
+                    Debug::log(
+                        "Failed to load model using filepath: " + filepath,
+                        PLATYPUS_CURRENT_FUNC_NAME,
+                        Debug::MessageType::PLATYPUS_ERROR
+                    );
+                    _errors.push_back("Failed to load model with filepath: " + filepath);
+                    return nullptr;
+                }
+                if (!name.empty() && !nameAvailable(name))
+                {
+                    _errors.push_back("Name " + name + " not available");
+                    return nullptr;
+                }
+                return createLoadedModel(
+                    filepath,
+                    pData->meshes,
+                    pData->skeletons,
+                    instanced,
+                    name,
+                    modelID,
+                    meshIDs,
+                    storeBuffersHostSide,
+                    animationCompression
+                );
+            }
+        );
+    }
+
+    AssetFuture AssetManager::loadFontAsync(const std::string& filepath, unsigned int pixelSize)
+    {
+        // NOTE: Creating the Font here since generating its UUID isn't thread safe.
+        // It's owned by the load data until it gets added to the assets.
+        std::shared_ptr<AsyncFontData> pData = std::make_shared<AsyncFontData>();
+        pData->pFont = new Font(_uuidPool);
+        return addAsyncLoad(
+            [pData, filepath, pixelSize]()
+            {
+                pData->success = pData->pFont->loadGlyphs(filepath, pixelSize);
+            },
+            { },
+            [this, pData, filepath]() -> Asset*
+            {
+                if (!pData->success || !pData->pFont->createTexture())
+                {
+                    const std::string error = "Failed to load font from: " + filepath;
+                    Debug::log(
+                        error,
+                        PLATYPUS_CURRENT_FUNC_NAME,
+                        Debug::MessageType::PLATYPUS_ERROR
+                    );
+                    _errors.push_back(error);
+                    return nullptr;
+                }
+                Font* pFont = pData->pFont;
+                pData->pFont = nullptr;
+                _assets[pFont->getID()] = pFont;
+                return pFont;
+            }
+        );
+    }
+
+    AssetFuture AssetManager::whenLoaded(
+        const std::vector<AssetFuture>& dependencies,
+        const AsyncFinalizeFunc& finalizeFunc
+    )
+    {
+        return addAsyncLoad(nullptr, dependencies, finalizeFunc);
+    }
+
+    void AssetManager::finalizeAsyncLoads()
+    {
+        if (_asyncLoads.empty())
+            return;
+
+        JobSystem& jobSystem = Application::get_instance()->getJobSystem();
+        const bool hasWorkers = jobSystem.getWorkerCount() > 0;
+
+        std::chrono::time_point<std::chrono::high_resolution_clock> beginTime = std::chrono::high_resolution_clock::now();
+        // Always doing some work, even if a single finalize takes more than the budget
+        bool workDone = false;
+        size_t i = 0;
+        while (i < _asyncLoads.size())
+        {
+            if (workDone)
+            {
+                std::chrono::duration<float, std::milli> elapsed = std::chrono::high_resolution_clock::now() - beginTime;
+                if (elapsed.count() >= _asyncLoadBudget)
+                    break;
+            }
+
+            AsyncLoad* pLoad = _asyncLoads[i];
+            if (pLoad->counter.value.load() > 0)
+            {
+                // Without workers no one else executes the background jobs
+                if (!hasWorkers && jobSystem.executeBackgroundJob())
+                {
+                    workDone = true;
+                    continue;
+                }
+                ++i;
+                continue;
+            }
+
+            bool dependenciesLoaded = true;
+            std::string dependencyError;
+            for (const AssetFuture& dependency : pLoad->dependencies)
+            {
+                if (dependency.hasFailed())
+                {
+                    dependencyError = "Dependency failed to load: " + dependency.getError();
+                    break;
+                }
+                if (!dependency.isDone())
+                    dependenciesLoaded = false;
+            }
+
+            if (dependencyError.empty() && !dependenciesLoaded)
+            {
+                ++i;
+                continue;
+            }
+
+            AsyncAssetState& state = *pLoad->pState;
+            if (!dependencyError.empty())
+            {
+                state.status = AsyncLoadStatus::FAILED;
+                state.error = dependencyError;
+            }
+            else
+            {
+                const size_t errorCount = _errors.size();
+                Asset* pAsset = pLoad->finalizeFunc();
+                if (pAsset)
+                {
+                    state.status = AsyncLoadStatus::LOADED;
+                    state.pAsset = pAsset;
+                }
+                else
+                {
+                    state.status = AsyncLoadStatus::FAILED;
+                    state.error = _errors.size() > errorCount ? _errors.back() : "Failed to create asset";
+                }
+                workDone = true;
+            }
+
+            _asyncLoads.erase(_asyncLoads.begin() + i);
+            delete pLoad;
+        }
+
+        // Let the device copy the finalized assets' buffers while doing the rest of the frame
+        if (workDone)
+            Device::submit_uploads();
+    }
+
+    void AssetManager::cancelAsyncLoads()
+    {
+        if (_asyncLoads.empty())
+            return;
+
+        // The worker parts may already be running and access their load's counter
+        // -> need to wait for them
+        JobSystem& jobSystem = Application::get_instance()->getJobSystem();
+        for (AsyncLoad* pLoad : _asyncLoads)
+        {
+            jobSystem.wait(&pLoad->counter);
+            pLoad->pState->status = AsyncLoadStatus::FAILED;
+            pLoad->pState->error = "Load was cancelled";
+            delete pLoad;
+        }
+        Debug::log(
+            "Cancelled " + std::to_string(_asyncLoads.size()) + " pending async loads",
+            PLATYPUS_CURRENT_FUNC_NAME,
+            Debug::MessageType::PLATYPUS_WARNING
+        );
+        _asyncLoads.clear();
+    }
+
+    const TextureSampler* AssetManager::createTextureSampler(
+        TextureSamplerFilterMode filterMode,
+        TextureSamplerAddressMode addressMode,
+        bool useMipmapping
+    )
+    {
+        if (getTextureSampler(filterMode, addressMode, useMipmapping))
+        {
+            Debug::log(
+                "Texture sampler with given properties already exists!",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            PLATYPUS_ASSERT(false);
+        }
+        TextureSampler* pSampler = new TextureSampler(
+            filterMode,
+            addressMode,
+            useMipmapping,
+            0
+        );
+        //_textureSamplers.push_back({
+        //    filterMode,
+        //    addressMode,
+        //    useMipmapping,
+        //    0
+        //});
+        //return &_textureSamplers[_textureSamplers.size() - 1];
+        _textureSamplers.push_back(pSampler);
+        return pSampler;
+    }
+
+    const TextureSampler* AssetManager::getTextureSampler(
+        TextureSamplerFilterMode filterMode,
+        TextureSamplerAddressMode addressMode,
+        bool useMipmapping
+    ) const
+    {
+        for (size_t i = 0; i < _textureSamplers.size(); ++i)
+        {
+            const TextureSampler* pSampler = _textureSamplers[i];
+            if (pSampler->getFilterMode() == filterMode &&
+                pSampler->getAddressMode() == addressMode &&
+                pSampler->isMipmapped() == useMipmapping)
+            {
+                return _textureSamplers[i];
+            }
+        }
+        return nullptr;
+    }
+
+    const TextureSampler* AssetManager::getOrCreateTextureSampler(
+        TextureSamplerFilterMode filterMode,
+        TextureSamplerAddressMode addressMode,
+        bool useMipmapping
+    )
+    {
+        const TextureSampler* pSampler = getTextureSampler(
+            filterMode,
+            addressMode,
+            useMipmapping
+        );
+        if (!pSampler)
+        {
+            pSampler = createTextureSampler(
+                filterMode,
+                addressMode,
+                useMipmapping
+            );
+        }
+        return pSampler;
+    }
+
+    bool AssetManager::assetExists(UUID_t assetID) const
+    {
+        std::unordered_map<UUID_t, Asset*>::const_iterator it = _assets.find(assetID);
+        if (it != _assets.end())
+            return true;
+
+        return false;
+    }
+
+    bool AssetManager::assetExists(UUID_t assetID, AssetType type) const
+    {
+        std::unordered_map<UUID_t, Asset*>::const_iterator it = _assets.find(assetID);
+        if (it != _assets.end())
+        {
+            if (it->second->getType() == type)
+                return true;
+        }
+        return false;
+    }
+
+    bool AssetManager::assetExists(const std::string& assetName) const
+    {
+        if (assetName.empty())
+            return false;
+
+        std::unordered_map<UUID_t, Asset*>::const_iterator it;
         for (it = _assets.begin(); it != _assets.end(); ++it)
         {
             if (it->second->getName() == assetName)
@@ -1169,7 +1439,7 @@ namespace platypus
 
 
     size_t AssetManager::deserializeHeader(
-        const std::vector<char>& serializedData,
+        const DataView& serializedData,
         size_t* pAssetCount
     ) const
     {
@@ -1182,7 +1452,7 @@ namespace platypus
     }
 
     Asset* AssetManager::deserialize(
-        const std::vector<char>& serializedData,
+        const DataView& serializedData,
         size_t bufferReadPos,
         size_t& bufferReadEndPos
     )
@@ -1198,31 +1468,19 @@ namespace platypus
         memcpy(&type, pBuf, sizeof(AssetType));
         Debug::log("___TEST___attempting to read asset type: " + asset_type_to_string(type));
 
-        Asset* pAsset = nullptr;
-        switch (type)
+        Asset* pAsset = deserializeAsset(type, serializedData, bufferReadPos);
+        // NOTE: The rejected asset's size is unknown -> can't continue reading after it
+        if (!pAsset)
         {
-            case AssetType::ASSET_TYPE_MESH:     pAsset = new Mesh(this, serializedData, bufferReadPos); break;
-            case AssetType::ASSET_TYPE_MODEL:    pAsset = new Model(this, serializedData, bufferReadPos); break;
-            case AssetType::ASSET_TYPE_IMAGE:    pAsset = new Image(this, serializedData, bufferReadPos); break;
-            case AssetType::ASSET_TYPE_TEXTURE:  pAsset = new Texture(this, serializedData, bufferReadPos); break;
-            case AssetType::ASSET_TYPE_MATERIAL: pAsset = new Material(this, serializedData, bufferReadPos); break;
-            case AssetType::ASSET_TYPE_SKELETON: pAsset = new Skeleton(this, serializedData, bufferReadPos); break;
-            case AssetType::ASSET_TYPE_SKELETAL_ANIMATION_DATA: pAsset = new SkeletalAnimationData(this, serializedData, bufferReadPos); break;
-            default: {
-                Debug::log(
-                    "Invalid asset type: " + asset_type_to_string(type) + " for deserialization",
-                    PLATYPUS_CURRENT_FUNC_NAME,
-                    Debug::MessageType::PLATYPUS_ERROR
-                );
-                PLATYPUS_ASSERT(false);
-            }
+            bufferReadEndPos = bufferSize;
+            return nullptr;
         }
         bufferReadEndPos = bufferReadPos + pAsset->getSerializedSize();
         return pAsset;
     }
 
     std::unordered_map<std::string, Asset*> AssetManager::deserialize(
-        const std::vector<char>& serializedData,
+        const DataView& serializedData,
         size_t& lastReadPos
     )
     {
@@ -1242,6 +1500,8 @@ namespace platypus
                 offset,
                 offset
             );
+            if (!pAsset)
+                break;
             outAssets[pAsset->getName()] = pAsset;
         }
 
@@ -1296,6 +1556,48 @@ namespace platypus
         _materialAssetsToFinalize.clear();
     }
 
+    bool AssetManager::openAssetPack(const std::string& filepath)
+    {
+        AssetPack* pPack = new AssetPack;
+        if (!pPack->open(filepath))
+        {
+            delete pPack;
+            _errors.push_back("Failed to open asset pack: " + filepath);
+            return false;
+        }
+        _assetPacks.push_back(pPack);
+        return true;
+    }
+
+    void AssetManager::closeAssetPacks()
+    {
+        for (AssetPack* pPack : _assetPacks)
+            delete pPack;
+        _assetPacks.clear();
+    }
+
+    Asset* AssetManager::loadPackedAsset(UUID_t assetID)
+    {
+        std::unordered_map<UUID_t, Asset*>::const_iterator it = _assets.find(assetID);
+        if (it != _assets.end())
+            return it->second;
+
+        AssetPackEntry entry;
+        for (const AssetPack* pPack : _assetPacks)
+        {
+            if (pPack->findEntry(assetID, entry))
+                return loadPackedAsset(pPack, entry);
+        }
+
+        Debug::log(
+            "Asset with UUID: " + std::to_string(assetID) + " wasn't found from the open asset packs",
+            PLATYPUS_CURRENT_FUNC_NAME,
+            Debug::MessageType::PLATYPUS_ERROR
+        );
+        _errors.push_back("Asset: " + std::to_string(assetID) + " not found from asset packs");
+        return nullptr;
+    }
+
     std::vector<std::string> AssetManager::popErrors()
     {
         std::vector<std::string> errors = _errors;
@@ -1325,6 +1627,277 @@ namespace platypus
         return true;
     }
 
+    Image* AssetManager::createLoadedImage(
+        const std::string& filepath,
+        PE_ubyte* pPixels,
+        int width,
+        int height,
+        int channels,
+        uint32_t mipLevelCount,
+        bool sRGBMips,
+        ImageFormat format,
+        const std::string& name,
+        UUID_t id
+    )
+    {
+        Image* pImage = new Image(
+            _uuidPool,
+            pPixels,
+            width,
+            height,
+            channels,
+            format,
+            name,
+            id,
+            false,
+            mipLevelCount
+        );
+        pImage->setFilepath(filepath);
+        if (mipLevelCount > 1 && sRGBMips != is_srgb_format(format))
+        {
+            Debug::log(
+                "Image: " + filepath + " mips were filtered in different color space "
+                "than its format: " + image_format_to_string(format) + " uses. Regenerating mips.",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_WARNING
+            );
+            pImage->generateMipmaps();
+        }
+        _assets[pImage->getID()] = pImage;
+        return pImage;
+    }
+
+    Model* AssetManager::createLoadedModel(
+        const std::string& filepath,
+        const std::vector<MeshData>& loadedMeshes,
+        const std::vector<SkeletonData>& loadedSkeletons,
+        bool instanced,
+        const std::string& name,
+        UUID_t modelID,
+        const std::vector<UUID_t>& meshIDs,
+        bool storeBuffersHostSide,
+        const AnimationCompression& animationCompression
+    )
+    {
+        if (!loadedSkeletons.empty() && instanced)
+        {
+            Debug::log(
+                "Instancing not supported for skinned/animated meshes",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            PLATYPUS_ASSERT(false);
+            return nullptr;
+        }
+
+        std::vector<Mesh*> createdMeshes;
+        for (size_t i = 0; i < loadedMeshes.size(); ++i)
+        {
+            const MeshData& meshData = loadedMeshes[i];
+            const std::string meshName = name + "." + meshData.name;
+            Buffer* pVertexBuffer = new Buffer(
+                (void*)meshData.vertexBufferData.rawData.data(),
+                meshData.vertexBufferData.elementSize,
+                meshData.vertexBufferData.length,
+                BufferUsageFlagBits::BUFFER_USAGE_VERTEX_BUFFER_BIT | BufferUsageFlagBits::BUFFER_USAGE_TRANSFER_DST_BIT,
+                BufferUpdateFrequency::BUFFER_UPDATE_FREQUENCY_STATIC,
+                storeBuffersHostSide
+            );
+            MeshBufferData useIndexBuffer = meshData.indexBufferData[0];
+            Buffer* pIndexBuffer = new Buffer(
+                (void*)useIndexBuffer.rawData.data(),
+                useIndexBuffer.elementSize,
+                useIndexBuffer.length,
+                BufferUsageFlagBits::BUFFER_USAGE_INDEX_BUFFER_BIT | BufferUsageFlagBits::BUFFER_USAGE_TRANSFER_DST_BIT,
+                BufferUpdateFrequency::BUFFER_UPDATE_FREQUENCY_STATIC,
+                storeBuffersHostSide
+            );
+
+            uint32_t meshPropertyFlags = 0;
+            if (!loadedSkeletons.empty())
+                meshPropertyFlags |= static_cast<uint32_t>(MeshPropertyFlagBits::TYPE_SKINNED);
+            else
+                meshPropertyFlags |= static_cast<uint32_t>(MeshPropertyFlagBits::TYPE_STATIC);
+
+            if (instanced)
+                meshPropertyFlags |= static_cast<uint32_t>(MeshPropertyFlagBits::INSTANCED);
+
+            // Add TANGENTS to mesh property flags if found from VertexBufferLayout
+            for (const VertexBufferElement& vertexBufferElement : meshData.vertexBufferLayout.getElements())
+            {
+                if (vertexBufferElement.getAttribType() == VertexAttributeType::TANGENT)
+                {
+                    meshPropertyFlags |= static_cast<uint32_t>(MeshPropertyFlagBits::HAS_TANGENTS);
+                    break;
+                }
+            }
+
+            if (instanced && (meshPropertyFlags & static_cast<uint32_t>(MeshPropertyFlagBits::TYPE_SKINNED)))
+            {
+                Debug::log(
+                    "Mesh had animations but was also marked to use instancing. "
+                    "Currently instanced animated meshes aren't supported!",
+                    PLATYPUS_CURRENT_FUNC_NAME,
+                    Debug::MessageType::PLATYPUS_ERROR
+                );
+                PLATYPUS_ASSERT(false);
+            }
+
+            UUID_t meshID = NULL_UUID;
+            if (i < meshIDs.size())
+                meshID = meshIDs[i];
+
+            UUID_t skeletonAssetID = NULL_UUID;
+            if (i < loadedSkeletons.size())
+            {
+                const SkeletonData& skeletonData = loadedSkeletons[i];
+
+                const std::string& skeletonName = skeletonData.name;
+                const size_t animationCount = skeletonData.animations.size();
+                std::vector<UUID_t> animationIDs(animationCount);
+                for (size_t animationIndex = 0; animationIndex < animationCount; ++animationIndex)
+                {
+                    SkeletalAnimationData* pSkeletalAnimationAsset = createSkeletalAnimation(
+                        skeletonData.animations[animationIndex],
+                        animationCompression
+                    );
+                    animationIDs[animationIndex] = pSkeletalAnimationAsset->getID();
+                }
+
+                const Pose& skeletonPose = skeletonData.bindPose;
+                Skeleton* pSkeleton = createSkeleton(
+                    skeletonPose.joints,
+                    skeletonPose.jointChildMapping,
+                    animationIDs,
+                    skeletonName
+                );
+                skeletonAssetID = pSkeleton->getID();
+            }
+
+            Mesh* pMesh = new Mesh(
+                _uuidPool,
+                meshPropertyFlags,
+                meshData.vertexBufferLayout,
+                pVertexBuffer,
+                pIndexBuffer,
+                meshData.transformationMatrix,
+                skeletonAssetID,
+                meshName,
+                meshID
+            );
+            pMesh->setBounds(meshData.aabb, meshData.boundingSphere);
+            _assets[pMesh->getID()] = pMesh;
+            createdMeshes.push_back(pMesh);
+            pMesh->storeHostsideBuffersOnDeserialization(storeBuffersHostSide);
+        }
+        Model* pModel = new Model(_uuidPool, filepath, instanced, createdMeshes, name, modelID);
+        _assets[pModel->getID()] = pModel;
+        return pModel;
+    }
+
+    AssetFuture AssetManager::addAsyncLoad(
+        const JobSystem::Job& workerJob,
+        const std::vector<AssetFuture>& dependencies,
+        const AsyncFinalizeFunc& finalizeFunc
+    )
+    {
+        AsyncLoad* pLoad = new AsyncLoad;
+        pLoad->pState = std::make_shared<AsyncAssetState>();
+        pLoad->dependencies = dependencies;
+        pLoad->finalizeFunc = finalizeFunc;
+        if (workerJob)
+        {
+            JobSystem& jobSystem = Application::get_instance()->getJobSystem();
+            jobSystem.submitBackground(workerJob, &pLoad->counter);
+        }
+        _asyncLoads.push_back(pLoad);
+        return AssetFuture(pLoad->pState);
+    }
+
+    Asset* AssetManager::deserializeAsset(
+        AssetType type,
+        const DataView& serializedData,
+        size_t bufferReadPos
+    )
+    {
+        Asset* pAsset = nullptr;
+        switch (type)
+        {
+            case AssetType::ASSET_TYPE_MESH:     pAsset = new Mesh(this, serializedData, bufferReadPos); break;
+            case AssetType::ASSET_TYPE_MODEL:    pAsset = new Model(this, serializedData, bufferReadPos); break;
+            case AssetType::ASSET_TYPE_IMAGE:    pAsset = new Image(this, serializedData, bufferReadPos); break;
+            case AssetType::ASSET_TYPE_TEXTURE:  pAsset = new Texture(this, serializedData, bufferReadPos); break;
+            case AssetType::ASSET_TYPE_MATERIAL: pAsset = new Material(this, serializedData, bufferReadPos); break;
+            case AssetType::ASSET_TYPE_SKELETON: pAsset = new Skeleton(this, serializedData, bufferReadPos); break;
+            case AssetType::ASSET_TYPE_SKELETAL_ANIMATION_DATA: pAsset = new SkeletalAnimationData(this, serializedData, bufferReadPos); break;
+            default: {
+                Debug::log(
+                    "Invalid asset type: " + asset_type_to_string(type) + " for deserialization",
+                    PLATYPUS_CURRENT_FUNC_NAME,
+                    Debug::MessageType::PLATYPUS_ERROR
+                );
+                PLATYPUS_ASSERT(false);
+            }
+        }
+        if (pAsset && !pAsset->isValid())
+        {
+            Debug::log(
+                "Failed to deserialize asset of type: " + asset_type_to_string(type),
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            delete pAsset;
+            return nullptr;
+        }
+        return pAsset;
+    }
+
+    Asset* AssetManager::loadPackedAsset(const AssetPack* pPack, const AssetPackEntry& entry)
+    {
+        if (!_packedAssetsLoading.insert(entry.id).second)
+        {
+            Debug::log(
+                "Dependency cycle found at asset: " + std::to_string(entry.id) + " "
+                "in pack: " + pPack->getFilepath(),
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            _errors.push_back("Asset: " + std::to_string(entry.id) + " depends on itself");
+            return nullptr;
+        }
+
+        // NOTE: Dependencies don't have to be in the same pack
+        // (or in any pack if those exist already, like the default assets)
+        for (UUID_t dependencyID : pPack->getDependencies(entry))
+        {
+            if (!loadPackedAsset(dependencyID))
+            {
+                Debug::log(
+                    "Failed to load dependency: " + std::to_string(dependencyID) + " "
+                    "of asset: " + std::to_string(entry.id) + " from pack: " + pPack->getFilepath(),
+                    PLATYPUS_CURRENT_FUNC_NAME,
+                    Debug::MessageType::PLATYPUS_ERROR
+                );
+                _packedAssetsLoading.erase(entry.id);
+                return nullptr;
+            }
+        }
+        _packedAssetsLoading.erase(entry.id);
+
+        Asset* pAsset = deserializeAsset(entry.type, pPack->getAssetData(entry), 0);
+        if (!pAsset)
+            return nullptr;
+
+        PLATYPUS_ASSERT(pAsset->getID() == entry.id);
+        PLATYPUS_ASSERT(pAsset->getSerializedSize() == entry.dataSize);
+        // NOTE: Skeletons don't add themselves on deserialization
+        if (!assetExists(pAsset->getID()))
+            addExternalAsset(pAsset);
+
+        finalizeDeserialization();
+        return pAsset;
+    }
+
     bool AssetManager::validateAsset(
         const char* callLocation,
         UUID_t assetID,
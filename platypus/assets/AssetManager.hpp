@@ -8,15 +8,37 @@
 #include "Material.hpp"
 #include "Font.hpp"
 #include "SkeletalAnimationData.hpp"
+#include "AssetFuture.hpp"
+#include "AssetPack.hpp"
+#include "platypus/core/JobSystem.hpp"
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
+#include <functional>
 
 
 namespace platypus
 {
+    struct MeshData;
+    struct SkeletonData;
+
     class AssetManager
     {
+    public:
+        // Called on the main thread after the async load's worker part and dependencies
+        // have finished. Returns the created asset or nullptr on failure.
+        typedef std::function<Asset*()> AsyncFinalizeFunc;
+
     private:
+        struct AsyncLoad
+        {
+            std::shared_ptr<AsyncAssetState> pState;
+            std::vector<AssetFuture> dependencies;
+            // Counts the unfinished worker jobs of this load
+            JobCounter counter;
+            AsyncFinalizeFunc finalizeFunc;
+        };
+
         size_t _uuidPool = 0;
         std::unordered_map<UUID_t, Asset*> _assets;
         // NOTE: Why the fuck isn't _persistentAssets a set, like _defaultAssets or something?
@@ -52,6 +74,16 @@ namespace platypus
         std::unordered_map<UUID_t, UUID_t> _textureAssetsToFinalize;
         std::set<UUID_t> _materialAssetsToFinalize;
 
+        // In submission order -> dependencies are always before their dependents
+        std::vector<AsyncLoad*> _asyncLoads;
+        // Max time spent finalizing async loads per frame
+        float _asyncLoadBudget = 4.0f;
+
+        // Searched in the order these were opened
+        std::vector<AssetPack*> _assetPacks;
+        // Packed assets whose dependencies are being loaded, used to detect dependency cycles
+        std::unordered_set<UUID_t> _packedAssetsLoading;
+
     public:
         AssetManager();
         ~AssetManager();
@@ -60,7 +92,15 @@ namespace platypus
         void destroyAsset(UUID_t assetID);
         void destroyAsset(const std::string& assetName);
 
-        Image* createImage(PE_ubyte* pData, int width, int height, int channels, ImageFormat format);
+        // pData has to contain mipLevelCount mip levels
+        Image* createImage(
+            PE_ubyte* pData,
+            int width,
+            int height,
+            int channels,
+            ImageFormat format,
+            uint32_t mipLevelCount = 1
+        );
         Image* loadImage(
             const std::string& filepath,
             ImageFormat format,
@@ -147,7 +187,8 @@ namespace platypus
             const std::string& name,
             UUID_t modelID = NULL_UUID,
             std::vector<UUID_t> meshIDs = { },
-            bool storeBuffersHostSide = false
+            bool storeBuffersHostSide = false,
+            const AnimationCompression& animationCompression = AnimationCompression()
         );
 
         Model* createModel(
@@ -165,10 +206,68 @@ namespace platypus
         );
 
         SkeletalAnimationData* createSkeletalAnimation(
-            const KeyframeAnimationData& animationData
+            const KeyframeAnimationData& animationData,
+            const AnimationCompression& compression = AnimationCompression()
         );
         Font* loadFont(const std::string& filepath, unsigned int pixelSize);
 
+        // Async versions of the load funcs.
+        // File reading and decoding happens on the JobSystem's background queue,
+        // the actual assets (and their GPU resources) get created on the main thread
+        // by finalizeAsyncLoads within the frame's time budget.
+        // NOTE: Without worker threads (web) the decoding gets done by finalizeAsyncLoads as well,
+        // one file per frame at minimum.
+        AssetFuture loadImageAsync(
+            const std::string& filepath,
+            ImageFormat format,
+            const std::string& name = "",
+            UUID_t id = NULL_UUID
+        );
+        // The texture gets created after its image has loaded
+        AssetFuture loadTextureAsync(
+            const std::string& filepath,
+            ImageFormat format,
+            const TextureSampler* pSampler,
+            const std::string& name = "",
+            UUID_t id = NULL_UUID
+        );
+        AssetFuture loadModelAsync(
+            const std::string& filepath,
+            bool instanced,
+            const std::string& name,
+            UUID_t modelID = NULL_UUID,
+            std::vector<UUID_t> meshIDs = { },
+            bool storeBuffersHostSide = false,
+            const AnimationCompression& animationCompression = AnimationCompression()
+        );
+        AssetFuture loadFontAsync(const std::string& filepath, unsigned int pixelSize);
+
+        // Calls finalizeFunc on the main thread after all dependencies have loaded.
+        // Fails without calling finalizeFunc if any of the dependencies fails.
+        // For example creating a material after its textures:
+        //  AssetFuture material = pAssetManager->whenLoaded(
+        //      { diffuseTexture },
+        //      [pAssetManager, diffuseTexture]() {
+        //          return pAssetManager->createMaterial(NULL_UUID, { diffuseTexture.getID() }, { }, { });
+        //      }
+        //  );
+        AssetFuture whenLoaded(
+            const std::vector<AssetFuture>& dependencies,
+            const AsyncFinalizeFunc& finalizeFunc
+        );
+
+        // Finalizes the async loads which are ready, until the async load budget
+        // has been used. At least one load makes progress per call.
+        // NOTE: Called every frame by the Application!
+        void finalizeAsyncLoads();
+        // Waits for the pending async loads' worker parts and fails the loads.
+        // NOTE: Called by destroyAssets, so loads don't finish into the next scene.
+        void cancelAsyncLoads();
+
+        inline void setAsyncLoadBudget(float milliseconds) { _asyncLoadBudget = milliseconds; }
+        inline float getAsyncLoadBudget() const { return _asyncLoadBudget; }
+        inline size_t getPendingAsyncLoadCount() const { return _asyncLoads.size(); }
+
         const TextureSampler* createTextureSampler(
             TextureSamplerFilterMode filterMode,
             TextureSamplerAddressMode addressMode,
@@ -231,7 +330,7 @@ namespace platypus
 
         // Returns the position after the header in serializedData (where the actual data begins)
         size_t deserializeHeader(
-            const std::vector<char>& serializedData,
+            const DataView& serializedData,
             size_t* pAssetCount
         ) const;
 
@@ -241,18 +340,30 @@ namespace platypus
         // *The last read pos is stored in the bufferReadEndPos to be able to start reading the
         // next asset in the serializedData
         Asset* deserialize(
-            const std::vector<char>& serializedData,
+            const DataView& serializedData,
             size_t bufferReadPos,
             size_t& bufferReadEndPos
         );
 
         std::unordered_map<std::string, Asset*> deserialize(
-            const std::vector<char>& serializedData,
+            const DataView& serializedData,
             size_t& lastReadPos
         );
 
         void finalizeDeserialization();
 
+        // Maps the asset pack file for loadPackedAsset.
+        // Only the pack's table of contents gets read here.
+        bool openAssetPack(const std::string& filepath);
+        // NOTE: Assets loaded from the packs stay alive
+        void closeAssetPacks();
+        // Deserializes the asset from the first open pack containing it, after its dependencies
+        // (which don't exist yet) and finalizes them. Returns the existing asset if already loaded.
+        // NOTE: Finalizes all pending deserialization
+        //  -> don't call in the middle of the sequential deserialize.
+        Asset* loadPackedAsset(UUID_t assetID);
+        inline const std::vector<AssetPack*>& getAssetPacks() const { return _assetPacks; }
+
         std::vector<std::string> popErrors();
         std::string popError();
 
@@ -275,6 +386,44 @@ namespace platypus
         inline size_t getUUIDPool() const { return _uuidPool; }
 
     private:
+        // Creates the image asset from already read pixels.
+        // If the pixels had cooked mips filtered in the wrong color space
+        // for the format, the mips get regenerated.
+        Image* createLoadedImage(
+            const std::string& filepath,
+            PE_ubyte* pPixels,
+            int width,
+            int height,
+            int channels,
+            uint32_t mipLevelCount,
+            bool sRGBMips,
+            ImageFormat format,
+            const std::string& name,
+            UUID_t id
+        );
+        // Creates the model and its meshes, skeletons and animations
+        // from data loaded with load_model_data
+        Model* createLoadedModel(
+            const std::string& filepath,
+            const std::vector<MeshData>& loadedMeshes,
+            const std::vector<SkeletonData>& loadedSkeletons,
+            bool instanced,
+            const std::string& name,
+            UUID_t modelID,
+            const std::vector<UUID_t>& meshIDs,
+            bool storeBuffersHostSide,
+            const AnimationCompression& animationCompression
+        );
+
+        AssetFuture addAsyncLoad(
+            const JobSystem::Job& workerJob,
+            const std::vector<AssetFuture>& dependencies,
+            const AsyncFinalizeFunc& finalizeFunc
+        );
+
+        Asset* deserializeAsset(AssetType type, const DataView& serializedData, size_t bufferReadPos);
+        Asset* loadPackedAsset(const AssetPack* pPack, const AssetPackEntry& entry);
+
         bool validateAsset(
             const char* callLocation,
             UUID_t assetID,
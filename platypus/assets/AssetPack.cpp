@@ -0,0 +1,286 @@
+#include "AssetPack.hpp"
+#include "platypus/core/Debug.hpp"
+#include <algorithm>
+#include <cstring>
+
+
+namespace platypus
+{
+    static size_t align_pack_offset(size_t offset)
+    {
+        return (offset + asset_pack_data_alignment - 1) & ~(asset_pack_data_alignment - 1);
+    }
+
+    static void serialize_entry(char* pData, const AssetPackEntry& entry)
+    {
+        size_t pos = 0;
+        memcpy(pData + pos, &entry.id, sizeof(UUID_t));
+        pos += sizeof(UUID_t);
+
+        memcpy(pData + pos, &entry.type, sizeof(AssetType));
+        pos += sizeof(AssetType);
+
+        memcpy(pData + pos, &entry.dependencyCount, sizeof(uint32_t));
+        pos += sizeof(uint32_t);
+
+        memcpy(pData + pos, &entry.firstDependency, sizeof(uint64_t));
+        pos += sizeof(uint64_t);
+
+        memcpy(pData + pos, &entry.dataOffset, sizeof(uint64_t));
+        pos += sizeof(uint64_t);
+
+        memcpy(pData + pos, &entry.dataSize, sizeof(uint64_t));
+    }
+
+    static AssetPackEntry deserialize_entry(const char* pData)
+    {
+        AssetPackEntry entry;
+        size_t pos = 0;
+        memcpy(&entry.id, pData + pos, sizeof(UUID_t));
+        pos += sizeof(UUID_t);
+
+        memcpy(&entry.type, pData + pos, sizeof(AssetType));
+        pos += sizeof(AssetType);
+
+        memcpy(&entry.dependencyCount, pData + pos, sizeof(uint32_t));
+        pos += sizeof(uint32_t);
+
+        memcpy(&entry.firstDependency, pData + pos, sizeof(uint64_t));
+        pos += sizeof(uint64_t);
+
+        memcpy(&entry.dataOffset, pData + pos, sizeof(uint64_t));
+        pos += sizeof(uint64_t);
+
+        memcpy(&entry.dataSize, pData + pos, sizeof(uint64_t));
+        return entry;
+    }
+
+    AssetPack::~AssetPack()
+    {
+        close();
+    }
+
+    /*
+        Serialized format:
+            uint32_t magic
+            uint32_t version
+            uint32_t entryCount
+            uint32_t dependencyCount
+
+            AssetPackEntry entries[entryCount] (sorted by UUID)
+            UUID_t dependencies[dependencyCount]
+
+            assets' serialized data (each aligned to asset_pack_data_alignment)
+    */
+    std::vector<char> AssetPack::create(const std::vector<Asset*>& assets)
+    {
+        std::vector<Asset*> sortedAssets = assets;
+        std::sort(
+            sortedAssets.begin(),
+            sortedAssets.end(),
+            [](const Asset* pA, const Asset* pB) { return pA->getID() < pB->getID(); }
+        );
+
+        std::vector<AssetPackEntry> entries;
+        std::vector<UUID_t> dependencies;
+        std::vector<char> assetData;
+        entries.reserve(sortedAssets.size());
+        for (size_t i = 0; i < sortedAssets.size(); ++i)
+        {
+            const Asset* pAsset = sortedAssets[i];
+            if (i > 0 && sortedAssets[i - 1]->getID() == pAsset->getID())
+            {
+                Debug::log(
+                    "Asset: " + pAsset->getName() + " with UUID: " + std::to_string(pAsset->getID()) + " "
+                    "was included multiple times. Skipping duplicates.",
+                    PLATYPUS_CURRENT_FUNC_NAME,
+                    Debug::MessageType::PLATYPUS_WARNING
+                );
+                continue;
+            }
+
+            AssetPackEntry entry;
+            entry.id = pAsset->getID();
+            entry.type = pAsset->getType();
+
+            const std::vector<UUID_t> assetDependencies = pAsset->getDependencies();
+            entry.dependencyCount = static_cast<uint32_t>(assetDependencies.size());
+            entry.firstDependency = static_cast<uint64_t>(dependencies.size());
+            dependencies.insert(dependencies.end(), assetDependencies.begin(), assetDependencies.end());
+
+            // Data offsets are relative to the data section here and fixed below
+            // after the table of contents' size is known
+            assetData.resize(align_pack_offset(assetData.size()));
+            entry.dataOffset = static_cast<uint64_t>(assetData.size());
+            pAsset->serialize(assetData);
+            entry.dataSize = static_cast<uint64_t>(assetData.size() - entry.dataOffset);
+            PLATYPUS_ASSERT(entry.dataSize == pAsset->getSerializedSize());
+
+            entries.push_back(entry);
+        }
+
+        const size_t tocSize = asset_pack_header_size +
+            serialized_asset_pack_entry_size * entries.size() +
+            sizeof(UUID_t) * dependencies.size();
+        const size_t dataBegin = align_pack_offset(tocSize);
+
+        std::vector<char> buffer(dataBegin + assetData.size(), 0);
+        char* pBuf = buffer.data();
+
+        const uint32_t header[4] = {
+            asset_pack_magic,
+            asset_pack_version,
+            static_cast<uint32_t>(entries.size()),
+            static_cast<uint32_t>(dependencies.size())
+        };
+        memcpy(pBuf, header, asset_pack_header_size);
+        size_t pos = asset_pack_header_size;
+
+        for (AssetPackEntry& entry : entries)
+        {
+            entry.dataOffset += dataBegin;
+            serialize_entry(pBuf + pos, entry);
+            pos += serialized_asset_pack_entry_size;
+        }
+
+        if (!dependencies.empty())
+            memcpy(pBuf + pos, dependencies.data(), sizeof(UUID_t) * dependencies.size());
+        pos += sizeof(UUID_t) * dependencies.size();
+        PLATYPUS_ASSERT(pos == tocSize);
+
+        if (!assetData.empty())
+            memcpy(pBuf + dataBegin, assetData.data(), assetData.size());
+
+        return buffer;
+    }
+
+    bool AssetPack::open(const std::string& filepath)
+    {
+        close();
+        if (!_file.open(filepath))
+            return false;
+
+        const char* pData = _file.getData();
+        const size_t fileSize = _file.getSize();
+        uint32_t header[4] = { 0, 0, 0, 0 };
+        if (fileSize >= asset_pack_header_size)
+            memcpy(header, pData, asset_pack_header_size);
+
+        if (header[0] != asset_pack_magic || header[1] != asset_pack_version)
+        {
+            Debug::log(
+                "File: " + filepath + " wasn't an asset pack or its version(" + std::to_string(header[1]) + ") "
+                "wasn't supported. Current version is " + std::to_string(asset_pack_version),
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            _file.close();
+            return false;
+        }
+
+        const size_t entryCount = static_cast<size_t>(header[2]);
+        const size_t dependencyCount = static_cast<size_t>(header[3]);
+        const size_t tocSize = asset_pack_header_size +
+            serialized_asset_pack_entry_size * entryCount +
+            sizeof(UUID_t) * dependencyCount;
+        if (tocSize > fileSize)
+        {
+            Debug::log(
+                "Asset pack: " + filepath + " table of contents went past the end of the file",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            _file.close();
+            return false;
+        }
+
+        _entryCount = entryCount;
+        _dependencyCount = dependencyCount;
+        _pEntries = pData + asset_pack_header_size;
+        _pDependencies = _pEntries + serialized_asset_pack_entry_size * entryCount;
+
+        // NOTE: Validating only the table of contents here -> doesn't touch the assets' pages
+        UUID_t previousID = NULL_UUID;
+        for (size_t i = 0; i < _entryCount; ++i)
+        {
+            const AssetPackEntry entry = getEntry(i);
+            const bool validData = entry.dataOffset >= tocSize &&
+                entry.dataOffset <= fileSize &&
+                entry.dataSize <= fileSize - entry.dataOffset;
+            const bool validDependencies = entry.firstDependency <= _dependencyCount &&
+                entry.dependencyCount <= _dependencyCount - entry.firstDependency;
+            const bool sorted = i == 0 || entry.id > previousID;
+            if (!validData || !validDependencies || !sorted)
+            {
+                Debug::log(
+                    "Asset pack: " + filepath + " had invalid entry for asset: " + std::to_string(entry.id),
+                    PLATYPUS_CURRENT_FUNC_NAME,
+                    Debug::MessageType::PLATYPUS_ERROR
+                );
+                close();
+                return false;
+            }
+            previousID = entry.id;
+        }
+        return true;
+    }
+
+    void AssetPack::close()
+    {
+        _file.close();
+        _entryCount = 0;
+        _dependencyCount = 0;
+        _pEntries = nullptr;
+        _pDependencies = nullptr;
+    }
+
+    bool AssetPack::findEntry(UUID_t assetID, AssetPackEntry& outEntry) const
+    {
+        size_t begin = 0;
+        size_t end = _entryCount;
+        while (begin < end)
+        {
+            const size_t middle = begin + (end - begin) / 2;
+            UUID_t middleID = NULL_UUID;
+            memcpy(&middleID, _pEntries + serialized_asset_pack_entry_size * middle, sizeof(UUID_t));
+            if (middleID == assetID)
+            {
+                outEntry = getEntry(middle);
+                return true;
+            }
+            if (middleID < assetID)
+                begin = middle + 1;
+            else
+                end = middle;
+        }
+        return false;
+    }
+
+    AssetPackEntry AssetPack::getEntry(size_t index) const
+    {
+        PLATYPUS_ASSERT(index < _entryCount);
+        return deserialize_entry(_pEntries + serialized_asset_pack_entry_size * index);
+    }
+
+    std::vector<UUID_t> AssetPack::getDependencies(const AssetPackEntry& entry) const
+    {
+        std::vector<UUID_t> dependencies(entry.dependencyCount);
+        if (entry.dependencyCount > 0)
+        {
+            memcpy(
+                dependencies.data(),
+                _pDependencies + sizeof(UUID_t) * entry.firstDependency,
+                sizeof(UUID_t) * entry.dependencyCount
+            );
+        }
+        return dependencies;
+    }
+
+    DataView AssetPack::getAssetData(const AssetPackEntry& entry) const
+    {
+        return _file.getView().subView(
+            static_cast<size_t>(entry.dataOffset),
+            static_cast<size_t>(entry.dataSize)
+        );
+    }
+}
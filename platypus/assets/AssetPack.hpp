@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Asset.hpp"
+#include "platypus/utils/MappedFile.hpp"
+#include <vector>
+#include <string>
+
+
+namespace platypus
+{
+    constexpr uint32_t asset_pack_magic = 0x50414550; // "PEAP"
+    constexpr uint32_t asset_pack_version = 1;
+    // Each asset's data begins at multiple of this from the beginning of the pack
+    constexpr size_t asset_pack_data_alignment = 16;
+
+    struct AssetPackEntry
+    {
+        UUID_t id = NULL_UUID;
+        AssetType type = AssetType::ASSET_TYPE_NONE;
+        uint32_t dependencyCount = 0;
+        // Index of the first dependency in the pack's dependency table
+        uint64_t firstDependency = 0;
+        // From the beginning of the pack
+        uint64_t dataOffset = 0;
+        uint64_t dataSize = 0;
+    };
+
+    constexpr size_t asset_pack_header_size = sizeof(uint32_t) * 4;
+    constexpr size_t serialized_asset_pack_entry_size =
+        sizeof(UUID_t) +
+        sizeof(AssetType) +
+        sizeof(uint32_t) +
+        sizeof(uint64_t) * 3;
+
+    // Pack of serialized assets with a table of contents in front of the data,
+    // so single assets can be found and read without going through everything before them.
+    // The pack file is memory mapped -> only the pages of the assets actually read
+    // get read from disk and the assets deserialize straight from the mapped memory.
+    class AssetPack
+    {
+    private:
+        MappedFile _file;
+        size_t _entryCount = 0;
+        size_t _dependencyCount = 0;
+        // Point to the mapped file
+        const char* _pEntries = nullptr;
+        const char* _pDependencies = nullptr;
+
+    public:
+        AssetPack() = default;
+        AssetPack(const AssetPack&) = delete;
+        ~AssetPack();
+
+        // Serializes the assets into the pack format (to be written to file).
+        // NOTE: Doesn't add the assets' dependencies automatically
+        //  -> those have to be in the assets as well, unless they exist already
+        //  when the pack gets loaded (like the AssetManager's default assets).
+        static std::vector<char> create(const std::vector<Asset*>& assets);
+
+        // Maps the file and validates the header and the table of contents.
+        bool open(const std::string& filepath);
+        void close();
+
+        // Binary search from the table of contents (sorted by UUID)
+        bool findEntry(UUID_t assetID, AssetPackEntry& outEntry) const;
+        AssetPackEntry getEntry(size_t index) const;
+        std::vector<UUID_t> getDependencies(const AssetPackEntry& entry) const;
+        // The asset's serialized data in the mapped file
+        DataView getAssetData(const AssetPackEntry& entry) const;
+
+        inline bool isOpen() const { return _file.isOpen(); }
+        inline const std::string& getFilepath() const { return _file.getFilepath(); }
+        inline size_t getEntryCount() const { return _entryCount; }
+    };
+}
@@ -2,8 +2,12 @@
 #include "platypus/core/Application.hpp"
 #include "AssetManager.hpp"
 #include "platypus/core/Debug.hpp"
+#include "platypus/utils/MappedFile.hpp"
+#include "platypus/utils/ImageDataUtils.hpp"
 
 #include <cmath>
+#include <algorithm>
+#include <cstring>
 
 #include <utf8.h>
 
@@ -13,6 +17,19 @@
 
 namespace platypus
 {
+    // magic, version, pixelSize, atlasRowCount, tileWidth, maxCharHeight,
+    // maxBaselineDrop, atlasWidth, atlasMipLevelCount, glyphCount
+    static const size_t s_cookedFontHeaderSize = sizeof(uint32_t) * 10;
+    // codepoint + FontGlyphData
+    static const size_t s_cookedGlyphSize = sizeof(uint32_t) + sizeof(int32_t) * 6 + sizeof(uint32_t);
+
+    bool is_cooked_font_file(const std::string& filepath)
+    {
+        const size_t extensionLength = strlen(cooked_font_extension);
+        return filepath.size() >= extensionLength &&
+            filepath.compare(filepath.size() - extensionLength, extensionLength, cooked_font_extension) == 0;
+    }
+
     Font::Font(size_t uuidPool) :
         Asset(uuidPool, AssetType::ASSET_TYPE_FONT, "", NULL_UUID, false)
     {
@@ -22,8 +39,21 @@ namespace platypus
     {}
 
     bool Font::load(const std::string& filepath, unsigned int pixelSize)
+    {
+        return loadGlyphs(filepath, pixelSize) && createTexture();
+    }
+
+    bool Font::loadGlyphs(const std::string& filepath, unsigned int pixelSize)
     {
         _pixelSize = pixelSize;
+        if (is_cooked_font_file(filepath))
+        {
+            MappedFile file;
+            if (!file.open(filepath))
+                return false;
+            return loadCookedFont(file.getView(), filepath);
+        }
+
         // NOTE: Iterating all available glyphs with FT_Get_First_Char and FT_Get_Next_Char
         // doesn't include all glyphs, like scands, so need to do it like this atm...
         // TODO: Figure out a better way!
@@ -154,8 +184,9 @@ namespace platypus
         const unsigned int combinedGlyphBitmapWidth = textureAtlasRowCount * _textureAtlasTileWidth;
         const unsigned int combinedGlyphBitmapSize = combinedGlyphBitmapWidth * combinedGlyphBitmapWidth; // font texture atlas size in bytes
 
-        unsigned char* combinedGlyphBitmap = new unsigned char[combinedGlyphBitmapSize];
-        memset(combinedGlyphBitmap, 0, combinedGlyphBitmapSize);
+        _atlasPixels.assign(combinedGlyphBitmapSize, 0);
+        _atlasWidth = combinedGlyphBitmapWidth;
+        unsigned char* combinedGlyphBitmap = _atlasPixels.data();
 
         for (unsigned int apy = 0; apy < combinedGlyphBitmapWidth; ++apy)
         {
@@ -188,12 +219,34 @@ namespace platypus
         }
         */
 
+        _textureAtlasRowCount = textureAtlasRowCount;
+        _atlasMipLevelCount = 1;
+
+        FT_Done_Face(fontFace);
+        FT_Done_FreeType(freetypeLib);
+
+        return true;
+    }
+
+    bool Font::createTexture()
+    {
+        if (_atlasPixels.empty())
+        {
+            Debug::log(
+                "@Font::createTexture "
+                "No glyphs loaded! Font::loadGlyphs needs to succeed first",
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            PLATYPUS_ASSERT(false);
+            return false;
+        }
+
         // Create resources through AssetManager
         Application* pApp = Application::get_instance();
         if (!pApp)
         {
             Debug::log(
-                "@Font::createFont Application was nullptr!",
+                "@Font::createTexture Application was nullptr!",
                 Debug::MessageType::PLATYPUS_ERROR
             );
             // TODO: Separate asserts for ones remaining in release and ones used only in debug?
@@ -203,11 +256,12 @@ namespace platypus
         AssetManager* pAssetManager = pApp->getAssetManager();
 
         Image* pFontImgData = pAssetManager->createImage(
-            combinedGlyphBitmap,
-            combinedGlyphBitmapWidth,
-            combinedGlyphBitmapWidth,
+            _atlasPixels.data(),
+            (int)_atlasWidth,
+            (int)_atlasWidth,
             1,
-            ImageFormat::R8_UNORM
+            ImageFormat::R8_UNORM,
+            _atlasMipLevelCount
         );
         pFontImgData->setSerializable(false);
         _imageID = pFontImgData->getID();
@@ -218,15 +272,183 @@ namespace platypus
             TextureSamplerAddressMode::SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
             true // use mipmapping? -> NOTE: Why are we mipmapping this?
         );
-        pTexture->setAtlasRowCount(textureAtlasRowCount);
+        pTexture->setAtlasRowCount(_textureAtlasRowCount);
         pTexture->setSerializable(false);
         _textureID = pTexture->getID();
 
-        _textureAtlasRowCount = textureAtlasRowCount;
+        // Image has its own copy of the atlas
+        std::vector<unsigned char>().swap(_atlasPixels);
 
-        FT_Done_Face(fontFace);
-        FT_Done_FreeType(freetypeLib);
+        return true;
+    }
+
+    /*
+        Serialized format:
+            uint32_t magic
+            uint32_t version
+            uint32_t pixelSize
+            int32_t textureAtlasRowCount
+            int32_t textureAtlasTileWidth
+            int32_t maxCharHeight
+            int32_t maxBaselineDrop
+            uint32_t atlasWidth
+            uint32_t atlasMipLevelCount
+            uint32_t glyphCount
+
+            glyphs[glyphCount] (sorted by codepoint):
+                uint32_t codepoint
+                FontGlyphData's fields in declaration order
+
+            unsigned char atlas[] (R8 mip chain of atlasWidth x atlasWidth)
+    */
+    std::vector<char> Font::createCookedFont()
+    {
+        if (_atlasPixels.empty())
+        {
+            Debug::log(
+                "No glyphs loaded! Font::loadGlyphs needs to succeed first",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            PLATYPUS_ASSERT(false);
+            return { };
+        }
+
+        // Baking the mips here, so the texture doesn't need to blit them at runtime.
+        // NOTE: The atlas is R8_UNORM -> filtered in linear space
+        const int atlasWidth = (int)_atlasWidth;
+        if (_atlasMipLevelCount == 1)
+        {
+            _atlasMipLevelCount = get_mip_level_count(atlasWidth, atlasWidth);
+            _atlasPixels.resize(get_mip_chain_size(atlasWidth, atlasWidth, 1, _atlasMipLevelCount));
+            generate_mip_chain(_atlasPixels.data(), atlasWidth, atlasWidth, 1, _atlasMipLevelCount, false);
+        }
+
+        std::vector<uint32_t> codepoints;
+        codepoints.reserve(_glyphMapping.size());
+        for (const std::pair<const uint32_t, FontGlyphData>& glyph : _glyphMapping)
+            codepoints.push_back(glyph.first);
+        std::sort(codepoints.begin(), codepoints.end());
+
+        const size_t glyphsSize = s_cookedGlyphSize * codepoints.size();
+        std::vector<char> buffer(s_cookedFontHeaderSize + glyphsSize + _atlasPixels.size());
+        char* pBuf = buffer.data();
+
+        const uint32_t header[10] = {
+            cooked_font_magic,
+            cooked_font_version,
+            (uint32_t)_pixelSize,
+            (uint32_t)_textureAtlasRowCount,
+            (uint32_t)_textureAtlasTileWidth,
+            (uint32_t)_maxCharHeight,
+            (uint32_t)_maxBaselineDrop,
+            (uint32_t)_atlasWidth,
+            _atlasMipLevelCount,
+            (uint32_t)codepoints.size()
+        };
+        memcpy(pBuf, header, s_cookedFontHeaderSize);
+        size_t pos = s_cookedFontHeaderSize;
+
+        for (uint32_t codepoint : codepoints)
+        {
+            const FontGlyphData& glyph = _glyphMapping[codepoint];
+            const int32_t glyphData[8] = {
+                (int32_t)codepoint,
+                glyph.textureOffsetX,
+                glyph.textureOffsetY,
+                glyph.width,
+                glyph.height,
+                glyph.bearingX,
+                glyph.bearingY,
+                (int32_t)glyph.advance
+            };
+            memcpy(pBuf + pos, glyphData, s_cookedGlyphSize);
+            pos += s_cookedGlyphSize;
+        }
+
+        memcpy(pBuf + pos, _atlasPixels.data(), _atlasPixels.size());
+        return buffer;
+    }
+
+    bool Font::loadCookedFont(const DataView& data, const std::string& filepath)
+    {
+        uint32_t header[10] = { 0 };
+        if (data.size() >= s_cookedFontHeaderSize)
+            memcpy(header, data.data(), s_cookedFontHeaderSize);
+
+        if (header[0] != cooked_font_magic || header[1] != cooked_font_version)
+        {
+            Debug::log(
+                "File: " + filepath + " wasn't a cooked font or its version(" + std::to_string(header[1]) + ") "
+                "wasn't supported. Current version is " + std::to_string(cooked_font_version),
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            return false;
+        }
+
+        const int atlasWidth = (int)header[7];
+        const uint32_t atlasMipLevelCount = header[8];
+        const size_t glyphCount = (size_t)header[9];
+        const bool validAtlas = atlasWidth > 0 &&
+            atlasMipLevelCount > 0 &&
+            atlasMipLevelCount <= get_mip_level_count(atlasWidth, atlasWidth);
+        const size_t atlasSize = validAtlas ? get_mip_chain_size(atlasWidth, atlasWidth, 1, atlasMipLevelCount) : 0;
+        const size_t requiredSize = s_cookedFontHeaderSize + s_cookedGlyphSize * glyphCount + atlasSize;
+        if (!validAtlas || data.size() != requiredSize)
+        {
+            Debug::log(
+                "Cooked font: " + filepath + " had invalid atlas or size",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            return false;
+        }
+
+        if (header[2] != _pixelSize)
+        {
+            Debug::log(
+                "Cooked font: " + filepath + " was cooked with pixel size: " + std::to_string(header[2]) + " "
+                "requested pixel size: " + std::to_string(_pixelSize) + " Using the cooked size.",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_WARNING
+            );
+        }
+        _pixelSize = header[2];
+        _textureAtlasRowCount = (int)header[3];
+        _textureAtlasTileWidth = (int)header[4];
+        _maxCharHeight = (int)header[5];
+        _maxBaselineDrop = (int)header[6];
+
+        const char* pData = data.data();
+        size_t pos = s_cookedFontHeaderSize;
+        _glyphMapping.clear();
+        _glyphMapping.reserve(glyphCount);
+        for (size_t i = 0; i < glyphCount; ++i)
+        {
+            int32_t glyphData[8];
+            memcpy(glyphData, pData + pos, s_cookedGlyphSize);
+            pos += s_cookedGlyphSize;
+
+            FontGlyphData glyph =
+            {
+                glyphData[1],
+                glyphData[2],
+
+                glyphData[3],
+                glyphData[4],
+
+                glyphData[5],
+                glyphData[6],
+
+                (uint32_t)glyphData[7]
+            };
+            _glyphMapping.insert(std::make_pair((uint32_t)glyphData[0], glyph));
+        }
 
+        _atlasPixels.assign(pData + pos, pData + pos + atlasSize);
+        _atlasWidth = (unsigned int)atlasWidth;
+        _atlasMipLevelCount = atlasMipLevelCount;
         return true;
     }
 
@@ -2,12 +2,22 @@
 
 #include "Asset.hpp"
 #include "Texture.hpp"
+#include "platypus/utils/DataView.hpp"
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 
 namespace platypus
 {
+    // Cooked font = glyph metrics and the baked texture atlas with its mips,
+    // written by the asset cooker -> loading one doesn't need FreeType.
+    constexpr const char* cooked_font_extension = ".pefont";
+    constexpr uint32_t cooked_font_magic = 0x4E464550; // "PEFN"
+    constexpr uint32_t cooked_font_version = 1;
+
+    bool is_cooked_font_file(const std::string& filepath);
+
     struct FontGlyphData
     {
         // Offset in font texture atlas, where we get this glyph's visual
@@ -47,6 +57,12 @@ namespace platypus
 
         std::unordered_map<uint32_t, FontGlyphData> _glyphMapping;
 
+        // Glyphs' combined texture atlas between loadGlyphs and createTexture.
+        // Contains the atlas' mip chain if _atlasMipLevelCount > 1
+        std::vector<unsigned char> _atlasPixels;
+        unsigned int _atlasWidth = 0;
+        uint32_t _atlasMipLevelCount = 1;
+
     public:
         Font(size_t uuidPool);
         ~Font();
@@ -56,6 +72,20 @@ namespace platypus
         // TODO: Figure out way of knowing available sizes for fonts..
         bool load(const std::string& filepath, unsigned int pixelSize);
 
+        // Split parts of the load, so that the glyphs can be loaded on a worker thread:
+        //  -loadGlyphs reads the font file and builds the texture atlas.
+        //  Doesn't touch the AssetManager -> ok to call from any thread.
+        //  -createTexture creates the atlas' Image and Texture through the AssetManager
+        //  -> main thread only.
+        // NOTE: If filepath is a cooked font, pixelSize has to be the one it was cooked with.
+        bool loadGlyphs(const std::string& filepath, unsigned int pixelSize);
+        bool createTexture();
+
+        // Returns the loaded glyphs in the cooked font format (for writing to a file).
+        // Bakes the atlas' mips if they weren't already.
+        // NOTE: Has to be called between loadGlyphs and createTexture
+        std::vector<char> createCookedFont();
+
         const Texture* getTexture() const;
 
         const FontGlyphData * const getGlyph(uint32_t codepoint) const;
@@ -74,5 +104,6 @@ namespace platypus
 
     private:
         bool createFont(const std::string& filepath, std::string charsToLoad);
+        bool loadCookedFont(const DataView& data, const std::string& filepath);
     };
 }
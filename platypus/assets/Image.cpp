@@ -2,6 +2,9 @@
 #include "AssetManager.hpp"
 #include "platypus/core/Application.hpp"
 #include "platypus/core/Debug.hpp"
+#include "platypus/utils/ImageDataUtils.hpp"
+#include "platypus/utils/Compression.hpp"
+#include "platypus/utils/MappedFile.hpp"
 #include <cstring>
 
 // NOTE: When starting to use tinygltf we probably need to define STB_IMAGE_IMPLEMENTATION in the file
@@ -12,6 +15,120 @@
 
 namespace platypus
 {
+    // Set in the serialized filepath size if the pixels are embedded after the filepath.
+    // NOTE: Using a flag bit, so asset packs serialized before the embedded pixels still load.
+    static const uint32_t s_serializedEmbeddedPixelsBit = 0x80000000;
+
+    // magic, version, width, height, channels, mipLevelCount, sRGBMips, compressed, storedSize
+    static const size_t s_cookedImageHeaderSize = sizeof(uint32_t) * 6 + sizeof(uint8_t) * 2 + sizeof(uint64_t);
+
+    bool is_cooked_image_file(const std::string& filepath)
+    {
+        const size_t extensionLength = strlen(cooked_image_extension);
+        return filepath.size() >= extensionLength &&
+            filepath.compare(filepath.size() - extensionLength, extensionLength, cooked_image_extension) == 0;
+    }
+
+    static bool read_cooked_image_pixels(
+        const std::string& filepath,
+        int* pOutWidth,
+        int* pOutHeight,
+        int* pOutChannels,
+        PE_ubyte** ppPixels,
+        uint32_t* pOutMipLevelCount,
+        bool* pOutSRGBMips
+    )
+    {
+        MappedFile file;
+        if (!file.open(filepath))
+            return false;
+
+        const char* pData = file.getData();
+        if (file.getSize() < s_cookedImageHeaderSize)
+        {
+            Debug::log(
+                "File: " + filepath + " was too small to be a cooked image",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            return false;
+        }
+
+        uint32_t header[6];
+        memcpy(header, pData, sizeof(uint32_t) * 6);
+        size_t pos = sizeof(uint32_t) * 6;
+        if (header[0] != cooked_image_magic || header[1] != cooked_image_version)
+        {
+            Debug::log(
+                "File: " + filepath + " wasn't a cooked image or its version(" + std::to_string(header[1]) + ") "
+                "wasn't supported. Current version is " + std::to_string(cooked_image_version),
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            return false;
+        }
+        const int width = static_cast<int>(header[2]);
+        const int height = static_cast<int>(header[3]);
+        const int channels = static_cast<int>(header[4]);
+        const uint32_t mipLevelCount = header[5];
+
+        uint8_t flags[2];
+        memcpy(flags, pData + pos, sizeof(uint8_t) * 2);
+        pos += sizeof(uint8_t) * 2;
+
+        uint64_t storedSize = 0;
+        memcpy(&storedSize, pData + pos, sizeof(uint64_t));
+        pos += sizeof(uint64_t);
+
+        const bool validHeader = width > 0 && height > 0 && channels > 0 && channels <= 4 &&
+            mipLevelCount > 0 && mipLevelCount <= get_mip_level_count(width, height) &&
+            storedSize <= file.getSize() - pos;
+        if (!validHeader)
+        {
+            Debug::log(
+                "Cooked image: " + filepath + " had invalid header",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            return false;
+        }
+
+        const size_t chainSize = get_mip_chain_size(width, height, channels, mipLevelCount);
+        PE_ubyte* pPixels = new PE_ubyte[chainSize];
+        bool success = false;
+        if (flags[1])
+        {
+            success = lz4_decompress(pData + pos, (size_t)storedSize, (char*)pPixels, chainSize);
+        }
+        else
+        {
+            success = storedSize == chainSize;
+            if (success)
+                memcpy(pPixels, pData + pos, chainSize);
+        }
+
+        if (!success)
+        {
+            Debug::log(
+                "Cooked image: " + filepath + " had invalid pixel data",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            delete[] pPixels;
+            return false;
+        }
+
+        *pOutWidth = width;
+        *pOutHeight = height;
+        *pOutChannels = channels;
+        *ppPixels = pPixels;
+        if (pOutMipLevelCount)
+            *pOutMipLevelCount = mipLevelCount;
+        if (pOutSRGBMips)
+            *pOutSRGBMips = flags[0] != 0;
+        return true;
+    }
+
     std::string image_format_to_string(ImageFormat format)
     {
         switch (format)
@@ -185,6 +302,19 @@ namespace platypus
         return ImageFormat::NONE;
     }
 
+    bool is_srgb_format(ImageFormat format)
+    {
+        switch (format)
+        {
+            case ImageFormat::R8_SRGB: return true;
+            case ImageFormat::R8G8B8_SRGB: return true;
+            case ImageFormat::R8G8B8A8_SRGB: return true;
+            case ImageFormat::B8G8R8A8_SRGB: return true;
+            case ImageFormat::B8G8R8_SRGB: return true;
+            default: return false;
+        }
+    }
+
 
     Image::Image(
         size_t uuidPool,
@@ -195,17 +325,19 @@ namespace platypus
         ImageFormat format,
         const std::string& name,
         UUID_t id,
-        bool persistent
+        bool persistent,
+        uint32_t mipLevelCount
     ) :
         Asset(uuidPool, AssetType::ASSET_TYPE_IMAGE, name, id, persistent),
         _width(width),
         _height(height),
         _channels(channels),
+        _mipLevelCount(mipLevelCount),
         _format(format)
     {
         if (pData)
         {
-            const size_t size = getSize();
+            const size_t size = getMipChainSize();
             _pData = new PE_ubyte[size];
             memcpy(_pData, pData, size);
         }
@@ -213,7 +345,7 @@ namespace platypus
 
     Image::Image(
         AssetManager* pAssetManager,
-        const std::vector<char>& targetBuffer,
+        const DataView& targetBuffer,
         size_t bufferPos
     ) :
         Asset(pAssetManager, targetBuffer, bufferPos)
@@ -230,6 +362,8 @@ namespace platypus
         uint32_t filepathSizeU32 = 0;
         memcpy(&filepathSizeU32, pBuf + pos, sizeof(uint32_t));
         pos += sizeof(uint32_t);
+        const bool embeddedPixels = (filepathSizeU32 & s_serializedEmbeddedPixelsBit) != 0;
+        filepathSizeU32 &= ~s_serializedEmbeddedPixelsBit;
         const size_t filepathSize = static_cast<const size_t>(filepathSizeU32);
 
         char* pFilepathData = new char[filepathSize];
@@ -238,10 +372,81 @@ namespace platypus
         _filepath = std::string(pFilepathData, filepathSize);
         delete[] pFilepathData;
 
-        const size_t requiredSerializedSize = getSerializedSize();
-        PLATYPUS_ASSERT(pos == requiredSerializedSize);
+        bool pixelsLoaded = false;
+        if (embeddedPixels)
+        {
+            memcpy(&_pixelStorage, pBuf + pos, sizeof(ImagePixelStorage));
+            pos += sizeof(ImagePixelStorage);
+
+            int32_t dimensions[3];
+            memcpy(dimensions, pBuf + pos, sizeof(int32_t) * 3);
+            pos += sizeof(int32_t) * 3;
+            _width = dimensions[0];
+            _height = dimensions[1];
+            _channels = dimensions[2];
+
+            memcpy(&_mipLevelCount, pBuf + pos, sizeof(uint32_t));
+            pos += sizeof(uint32_t);
+
+            uint64_t storedSize = 0;
+            memcpy(&storedSize, pBuf + pos, sizeof(uint64_t));
+            pos += sizeof(uint64_t);
+
+            // NOTE: Truncated data (cut asset pack or file) falls back to the source file below
+            const size_t remainingSize = bufferPos + pos <= targetBuffer.size() ? targetBuffer.size() - (bufferPos + pos) : 0;
+            const size_t chainSize = getMipChainSize();
+            _pData = new PE_ubyte[chainSize];
+            if (storedSize > remainingSize)
+            {
+                Debug::log(
+                    "Embedded pixel data size: " + std::to_string(storedSize) + " of image: " + _name + " "
+                    "exceeds the remaining serialized data size: " + std::to_string(remainingSize),
+                    PLATYPUS_CURRENT_FUNC_NAME,
+                    Debug::MessageType::PLATYPUS_ERROR
+                );
+            }
+            else if (_pixelStorage == ImagePixelStorage::EMBEDDED_LZ4)
+            {
+                _compressedPixelsSize = (size_t)storedSize;
+                pixelsLoaded = lz4_decompress(
+                    pBuf + pos,
+                    (size_t)storedSize,
+                    (char*)_pData,
+                    chainSize
+                );
+            }
+            else
+            {
+                pixelsLoaded = storedSize == chainSize;
+                if (pixelsLoaded)
+                    memcpy(_pData, pBuf + pos, chainSize);
+            }
+            pos += (size_t)storedSize;
+
+            if (!pixelsLoaded)
+            {
+                Debug::log(
+                    "Invalid embedded pixel data for image: " + _name + " "
+                    "Loading from the source file: " + _filepath + " instead",
+                    PLATYPUS_CURRENT_FUNC_NAME,
+                    Debug::MessageType::PLATYPUS_ERROR
+                );
+                delete[] _pData;
+                _pData = nullptr;
+                _mipLevelCount = 1;
+                _pixelStorage = ImagePixelStorage::SOURCE_FILE;
+            }
+        }
+
+        // NOTE: Falling back to the source file changes the serialized size
+        if (pixelsLoaded || !embeddedPixels)
+        {
+            const size_t requiredSerializedSize = getSerializedSize();
+            PLATYPUS_ASSERT(pos == requiredSerializedSize);
+        }
 
-        load(_filepath, _format);
+        if (!pixelsLoaded)
+            load(_filepath, _format);
 
         pAssetManager->addExternalAsset(this);
         if (_persistent)
@@ -323,29 +528,28 @@ namespace platypus
 
     bool Image::load(const std::string& filepath, ImageFormat format)
     {
-        // TODO: On OpenGL side we need to flip?
-        bool flipVertically = false;
-        stbi_set_flip_vertically_on_load(flipVertically);
-        unsigned char* pStbImageData = stbi_load(
-            filepath.c_str(),
-            &_width,
-            &_height,
-            &_channels,
-            0
-        );
-        if (!pStbImageData)
-        {
-            stbi_image_free(pStbImageData);
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        PE_ubyte* pPixels = nullptr;
+        uint32_t mipLevelCount = 1;
+        bool sRGBMips = false;
+        if (!read_image_pixels(filepath, &width, &height, &channels, &pPixels, &mipLevelCount, &sRGBMips))
             return false;
-        }
 
-        const size_t size = getSize();
         delete[] _pData;
-        _pData = new PE_ubyte[size];
-        memcpy(_pData, pStbImageData, size);
-        stbi_image_free(pStbImageData);
+        _pData = pPixels;
+        _width = width;
+        _height = height;
+        _channels = channels;
         _filepath = filepath;
         _format = format;
+        _mipLevelCount = mipLevelCount;
+        _compressedPixelsSize = 0;
+
+        // Cooked mips filtered in different color space than the format wants -> regenerate
+        if (_mipLevelCount > 1 && sRGBMips != is_srgb_format(_format))
+            generateMipmaps();
 
         return true;
     }
@@ -359,6 +563,8 @@ namespace platypus
         //  *Not sure should this be done here, but will do for now...
         //  *THIS IS VERY SLOW!
         AssetManager* pAssetManager = Application::get_instance()->getAssetManager();
+        MasterRenderer* pMasterRenderer = Application::get_instance()->getMasterRenderer();
+        BindlessMaterialTable* pBindlessMaterialTable = pMasterRenderer ? pMasterRenderer->getBindlessMaterialTable() : nullptr;
         std::vector<Asset*> textureAssets = pAssetManager->getAssets(
             AssetType::ASSET_TYPE_TEXTURE
             //bool excludeInternalDefaults = false,
@@ -371,6 +577,9 @@ namespace platypus
             {
                 pTexture->destroy();
                 pTexture->create(this);
+                // NOTE: Same as in Texture::recreate
+                if (pBindlessMaterialTable)
+                    pBindlessMaterialTable->refreshTexture(pTexture);
             }
         }
         // Recreate every Material's shader resources if its using this reloaded image...
@@ -440,7 +649,6 @@ namespace platypus
                 pMaterial->destroyShaderResources();
                 pMaterial->createShaderResources();
 
-                MasterRenderer* pMasterRenderer = Application::get_instance()->getMasterRenderer();
                 pMasterRenderer->getBatcher().freeBatches();
             }
         }
@@ -459,19 +667,17 @@ namespace platypus
         int width = 0;
         int height = 0;
         int channels = 0;
-        // TODO: On OpenGL side we need to flip?
-        bool flipVertically = false;
-        stbi_set_flip_vertically_on_load(flipVertically);
-        unsigned char* pStbImageData = stbi_load(filepath.c_str(), &width, &height, &channels, 0);
-
-        if (!pStbImageData)
-        {
-            stbi_image_free(pStbImageData);
+        PE_ubyte* pPixels = nullptr;
+        uint32_t mipLevelCount = 1;
+        bool sRGBMips = false;
+        if (!read_image_pixels(filepath, &width, &height, &channels, &pPixels, &mipLevelCount, &sRGBMips))
             return nullptr;
-        }
-        Image* pImage = new Image(uuidPool, pStbImageData, width, height, channels, format, name, id);
+
+        Image* pImage = new Image(uuidPool, pPixels, width, height, channels, format, name, id, false, mipLevelCount);
         pImage->_filepath = filepath;
-        stbi_image_free(pStbImageData);
+        delete[] pPixels;
+        if (mipLevelCount > 1 && sRGBMips != is_srgb_format(format))
+            pImage->generateMipmaps();
         return pImage;
     }
 
@@ -480,16 +686,37 @@ namespace platypus
         int* pOutWidth,
         int* pOutHeight,
         int* pOutChannels,
-        PE_ubyte** ppPixels
+        PE_ubyte** ppPixels,
+        uint32_t* pOutMipLevelCount,
+        bool* pOutSRGBMips
     )
     {
         PLATYPUS_ASSERT(pOutWidth);
         PLATYPUS_ASSERT(pOutHeight);
         PLATYPUS_ASSERT(pOutChannels);
         PLATYPUS_ASSERT(ppPixels);
+        if (is_cooked_image_file(filepath))
+        {
+            return read_cooked_image_pixels(
+                filepath,
+                pOutWidth,
+                pOutHeight,
+                pOutChannels,
+                ppPixels,
+                pOutMipLevelCount,
+                pOutSRGBMips
+            );
+        }
+        if (pOutMipLevelCount)
+            *pOutMipLevelCount = 1;
+        if (pOutSRGBMips)
+            *pOutSRGBMips = false;
+
         // TODO: On OpenGL side we need to flip?
         bool flipVertically = false;
-        stbi_set_flip_vertically_on_load(flipVertically);
+        // NOTE: This gets called from worker threads by the async loads
+        //  -> can't touch stb's global flip flag
+        stbi_set_flip_vertically_on_load_thread(flipVertically);
         unsigned char* pStbImageData = stbi_load(filepath.c_str(), pOutWidth, pOutHeight, pOutChannels, 0);
         if (!pStbImageData)
         {
@@ -506,17 +733,131 @@ namespace platypus
         return true;
     }
 
+    /*
+        Serialized format:
+            uint32_t magic
+            uint32_t version
+            uint32_t width
+            uint32_t height
+            uint32_t channels
+            uint32_t mipLevelCount
+            uint8_t sRGBMips (were the mips filtered in linear space)
+            uint8_t compressed
+            uint64_t pixelDataSize
+            char pixelData[pixelDataSize] (whole mip chain, LZ4 compressed if compressed)
+    */
+    std::vector<char> Image::create_cooked_image(
+        const PE_ubyte* pMipChain,
+        int width,
+        int height,
+        int channels,
+        uint32_t mipLevelCount,
+        bool sRGBMips,
+        bool compress
+    )
+    {
+        const size_t chainSize = get_mip_chain_size(width, height, channels, mipLevelCount);
+        std::vector<char> compressedPixels;
+        if (compress)
+            compressedPixels = lz4_compress((const char*)pMipChain, chainSize);
+
+        const char* pPixelData = compress ? compressedPixels.data() : (const char*)pMipChain;
+        const uint64_t storedSize = compress ? compressedPixels.size() : chainSize;
+
+        std::vector<char> buffer(s_cookedImageHeaderSize + storedSize);
+        char* pBuf = buffer.data();
+        const uint32_t header[6] = {
+            cooked_image_magic,
+            cooked_image_version,
+            static_cast<uint32_t>(width),
+            static_cast<uint32_t>(height),
+            static_cast<uint32_t>(channels),
+            mipLevelCount
+        };
+        memcpy(pBuf, header, sizeof(uint32_t) * 6);
+        size_t pos = sizeof(uint32_t) * 6;
+
+        const uint8_t flags[2] = { (uint8_t)sRGBMips, (uint8_t)compress };
+        memcpy(pBuf + pos, flags, sizeof(uint8_t) * 2);
+        pos += sizeof(uint8_t) * 2;
+
+        memcpy(pBuf + pos, &storedSize, sizeof(uint64_t));
+        pos += sizeof(uint64_t);
+
+        memcpy(pBuf + pos, pPixelData, (size_t)storedSize);
+        return buffer;
+    }
+
+    void Image::generateMipmaps()
+    {
+        if (!_pData)
+        {
+            Debug::log(
+                "Image had no data",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            PLATYPUS_ASSERT(false);
+            return;
+        }
+
+        const uint32_t mipLevelCount = get_mip_level_count(_width, _height);
+        PE_ubyte* pChain = new PE_ubyte[get_mip_chain_size(_width, _height, _channels, mipLevelCount)];
+        memcpy(pChain, _pData, getSize());
+        generate_mip_chain(pChain, _width, _height, _channels, mipLevelCount, is_srgb_format(_format));
+
+        delete[] _pData;
+        _pData = pChain;
+        _mipLevelCount = mipLevelCount;
+        _compressedPixelsSize = 0;
+    }
+
+    const PE_ubyte* Image::getMipData(uint32_t level) const
+    {
+        if (!_pData || level >= _mipLevelCount)
+            return nullptr;
+        return _pData + get_mip_level_offset(_width, _height, _channels, level);
+    }
+
+    size_t Image::getMipChainSize() const
+    {
+        return get_mip_chain_size(_width, _height, _channels, _mipLevelCount);
+    }
+
+    void Image::setPixelStorage(ImagePixelStorage storage)
+    {
+        _pixelStorage = storage;
+        _compressedPixelsSize = 0;
+    }
+
     /*
         Serialized format:
             Asset serialized base data
             ImageFormat format;
-            uint32_t filepathSize
+            uint32_t filepathSize (s_serializedEmbeddedPixelsBit set if pixels are embedded)
             char filepath[filepathSize];
+
+            If pixels are embedded:
+                ImagePixelStorage pixelStorage
+                int32_t width
+                int32_t height
+                int32_t channels
+                uint32_t mipLevelCount
+                uint64_t pixelDataSize
+                char pixelData[pixelDataSize] (whole mip chain, LZ4 compressed if EMBEDDED_LZ4)
     */
     void Image::serialize(
         std::vector<char>& targetBuffer
     ) const
     {
+        const bool embedPixels = _pixelStorage != ImagePixelStorage::SOURCE_FILE && _pData;
+        std::vector<char> compressedPixels;
+        if (embedPixels && _pixelStorage == ImagePixelStorage::EMBEDDED_LZ4)
+        {
+            compressedPixels = compressPixels();
+            _compressedPixelsSize = compressedPixels.size();
+        }
+
         const size_t prevSize = targetBuffer.size();
         const size_t serializedSize = getSerializedSize();
         targetBuffer.resize(prevSize + serializedSize);
@@ -528,21 +869,74 @@ namespace platypus
         memcpy(pBuf + pos, &_format, sizeof(ImageFormat));
         pos += sizeof(ImageFormat);
 
-        const uint32_t filepathSize = static_cast<uint32_t>(_filepath.size());
+        uint32_t filepathSize = static_cast<uint32_t>(_filepath.size());
+        PLATYPUS_ASSERT(!(filepathSize & s_serializedEmbeddedPixelsBit));
+        if (embedPixels)
+            filepathSize |= s_serializedEmbeddedPixelsBit;
         memcpy(pBuf + pos, &filepathSize, sizeof(uint32_t));
         pos += sizeof(uint32_t);
 
         memcpy(pBuf + pos, _filepath.data(), _filepath.size());
         pos += _filepath.size();
 
+        if (embedPixels)
+        {
+            memcpy(pBuf + pos, &_pixelStorage, sizeof(ImagePixelStorage));
+            pos += sizeof(ImagePixelStorage);
+
+            const int32_t dimensions[3] = { _width, _height, _channels };
+            memcpy(pBuf + pos, dimensions, sizeof(int32_t) * 3);
+            pos += sizeof(int32_t) * 3;
+
+            memcpy(pBuf + pos, &_mipLevelCount, sizeof(uint32_t));
+            pos += sizeof(uint32_t);
+
+            const bool compressed = _pixelStorage == ImagePixelStorage::EMBEDDED_LZ4;
+            const uint64_t storedSize = compressed ? compressedPixels.size() : getMipChainSize();
+            memcpy(pBuf + pos, &storedSize, sizeof(uint64_t));
+            pos += sizeof(uint64_t);
+
+            memcpy(pBuf + pos, compressed ? compressedPixels.data() : (const char*)_pData, storedSize);
+            pos += storedSize;
+        }
+
         PLATYPUS_ASSERT(pos == serializedSize);
     }
 
     size_t Image::getSerializedSize() const
     {
-        return getSerializedBaseSize() +
+        size_t size = getSerializedBaseSize() +
             sizeof(ImageFormat) +
             sizeof(uint32_t) +
             _filepath.size();
+
+        if (_pixelStorage != ImagePixelStorage::SOURCE_FILE && _pData)
+            size += getEmbeddedPixelsSerializedSize();
+
+        return size;
+    }
+
+    size_t Image::getEmbeddedPixelsSerializedSize() const
+    {
+        size_t pixelDataSize = getMipChainSize();
+        if (_pixelStorage == ImagePixelStorage::EMBEDDED_LZ4)
+        {
+            // NOTE: Compressing only to find out the size if not known yet.
+            // The compression is deterministic so serialize produces the same size.
+            if (_compressedPixelsSize == 0)
+                _compressedPixelsSize = compressPixels().size();
+            pixelDataSize = _compressedPixelsSize;
+        }
+
+        return sizeof(ImagePixelStorage) +
+            sizeof(int32_t) * 3 +
+            sizeof(uint32_t) +
+            sizeof(uint64_t) +
+            pixelDataSize;
+    }
+
+    std::vector<char> Image::compressPixels() const
+    {
+        return lz4_compress((const char*)_pData, getMipChainSize());
     }
 }
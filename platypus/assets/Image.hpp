@@ -55,6 +55,26 @@ namespace platypus
         IMAGE_CHANNEL_INDEX_ALPHA
     };
 
+    // How Image::serialize stores the pixels
+    enum class ImagePixelStorage : uint8_t
+    {
+        // Only the source filepath -> pixels get decoded from the file again on deserialization
+        SOURCE_FILE,
+        // Pixels, including the mip chain if generated, are embedded
+        // -> no decoding and no source file needed on deserialization
+        EMBEDDED,
+        // Same as EMBEDDED but LZ4 compressed
+        EMBEDDED_LZ4
+    };
+
+    // Cooked image = pixels and the full mip chain, written by the asset cooker
+    // -> loading one is just reading (and LZ4 decompressing) the pixels, no decoding.
+    constexpr const char* cooked_image_extension = ".peimage";
+    constexpr uint32_t cooked_image_magic = 0x4D494550; // "PEIM"
+    constexpr uint32_t cooked_image_version = 1;
+
+    bool is_cooked_image_file(const std::string& filepath);
+
     std::string image_format_to_string(ImageFormat format);
     ImageFormat string_to_image_format(const std::string& str);
     size_t get_image_format_channel_count(ImageFormat format);
@@ -62,6 +82,7 @@ namespace platypus
     bool is_image_format_valid(ImageFormat format, int channels);
     bool is_color_format(ImageFormat format);
     ImageFormat srgb_format_to_unorm(ImageFormat srgb);
+    bool is_srgb_format(ImageFormat format);
 
 
     struct ImageImpl;
@@ -69,15 +90,23 @@ namespace platypus
     {
     private:
         ImageImpl* _pImpl = nullptr;
+        // Level 0 first, followed by the rest of the mip levels if generated
         PE_ubyte* _pData = nullptr;
         int _width = -1;
         int _height = -1;
         int _channels = -1;
+        uint32_t _mipLevelCount = 1;
         ImageFormat _format;
         std::string _filepath;
 
+        ImagePixelStorage _pixelStorage = ImagePixelStorage::SOURCE_FILE;
+        // Size of the serialized pixel data, if embedded and compressed.
+        // 0 if not known yet.
+        mutable size_t _compressedPixelsSize = 0;
+
     public:
         // NOTE: pData gets copied here, ownership doesn't transfer!
+        // pData has to contain mipLevelCount levels (see ImageDataUtils for the layout)
         Image(
             size_t uuidPool,
             PE_ubyte* pData,
@@ -87,11 +116,12 @@ namespace platypus
             ImageFormat format,
             const std::string& name = "",
             UUID_t id = NULL_UUID,
-            bool persistent = false
+            bool persistent = false,
+            uint32_t mipLevelCount = 1
         );
         Image(
             AssetManager* pAssetManager,
-            const std::vector<char>& targetBuffer,
+            const DataView& targetBuffer,
             size_t bufferPos
         );
         ~Image();
@@ -114,14 +144,40 @@ namespace platypus
         );
 
         // NOTE: This allocates ppPixels on heap which you'll need to free at some point!
+        // If the file is a cooked image, ppPixels gets its whole mip chain,
+        // pOutMipLevelCount its level count (otherwise 1) and pOutSRGBMips
+        // tells were the mips filtered in sRGB space.
         static bool read_image_pixels(
             const std::string& filepath,
             int* pOutWidth,
             int* pOutHeight,
             int* pOutChannels,
-            PE_ubyte** ppPixels
+            PE_ubyte** ppPixels,
+            uint32_t* pOutMipLevelCount = nullptr,
+            bool* pOutSRGBMips = nullptr
         );
 
+        // Returns the pixels in the cooked image format (for writing to a file)
+        static std::vector<char> create_cooked_image(
+            const PE_ubyte* pMipChain,
+            int width,
+            int height,
+            int channels,
+            uint32_t mipLevelCount,
+            bool sRGBMips,
+            bool compress
+        );
+
+        // Generates the full mip chain on the CPU.
+        // Textures created from an image with a mip chain upload it as is
+        // instead of generating the mipmaps on the GPU.
+        void generateMipmaps();
+        // Returns nullptr if the level doesn't exist
+        const PE_ubyte* getMipData(uint32_t level) const;
+        size_t getMipChainSize() const;
+
+        void setPixelStorage(ImagePixelStorage storage);
+
         virtual void serialize(
             std::vector<char>& targetBuffer
         ) const override;
@@ -130,6 +186,8 @@ namespace platypus
 
         inline const std::string& getFilepath() const { return _filepath; }
         inline void setFilepath(const std::string& filepath) { _filepath = filepath; }
+        inline ImagePixelStorage getPixelStorage() const { return _pixelStorage; }
+        inline uint32_t getMipLevelCount() const { return _mipLevelCount; }
 
         inline ImageImpl* getImpl() { return _pImpl; }
         inline const PE_ubyte* getData() const { return _pData; }
@@ -138,5 +196,9 @@ namespace platypus
         inline int getChannels() const { return _channels; }
         inline size_t getSize() const { return _width * _height * _channels; }
         inline ImageFormat getFormat() const { return _format; }
+
+    private:
+        size_t getEmbeddedPixelsSerializedSize() const;
+        std::vector<char> compressPixels() const;
     };
 }
@@ -106,7 +106,7 @@ namespace platypus
     //  *Allow specifying custom shader files
     Material::Material(
         AssetManager* pAssetManager,
-        const std::vector<char>& targetBuffer,
+        const DataView& targetBuffer,
         size_t bufferPos
     ) :
         Asset(pAssetManager, targetBuffer, bufferPos)
@@ -200,16 +200,7 @@ namespace platypus
     {
         destroyShaderResources();
         _descriptorSetLayout.destroy();
-
-        std::unordered_map<uint32_t, MaterialPipelineData*>::iterator it;
-        for (it = _pipelines.begin(); it !=_pipelines.end(); ++it)
-        {
-            // NOTE: Maybe should at least warn in this case?
-            if (!it->second)
-                continue;
-
-            delete it->second;
-        }
+        releasePipelines();
     }
 
     void Material::recreate(
@@ -258,16 +249,16 @@ namespace platypus
         // ISSUE!
         // *If recreating completely, need to solve descriptor set layouts for the pipelines of
         // each mesh type if exists!
-        //  ->ATM SOLVED IN recreateExistingPipelines()
+        //  ->ATM SOLVED by releasing the pipelines. Batcher acquires new ones
+        //  with the new layouts when recreating the batches
         //
         // *If used mesh didn't earlier have tangents and adding
         // a normal map, this gets fucked (same issues as with adding blendmap)
         //  ->figure out what to do!
         //
         // *If adding blendmap that didn't earlier exist
-        //  ->this gets fucked, because recreateExistingPipelines(),
-        //  doesn't solve new shaders that blendmapping requires!
-        //      ->figure this out!
+        //  ->new shaders are solved when the pipelines get acquired again,
+        //  but only if those shaders exist!
         //
         // *If using blendmap, shaders exists only for:
         //  -using diffuse+specular channels (bds)
@@ -290,26 +281,13 @@ namespace platypus
 
         Device::wait_for_operations();
 
-        // Testing if "really" destroying pipelines would work...
-        std::unordered_map<uint32_t, MaterialPipelineData*>::iterator it;
-        for (it = _pipelines.begin(); it !=_pipelines.end(); ++it)
-        {
-            // NOTE: Maybe should at least warn in this case?
-            if (!it->second)
-                continue;
-
-            delete it->second;
-        }
-        _pipelines.clear();
+        releasePipelines();
 
         _descriptorSetLayout.destroy();
         destroyShaderResources();
 
         createDescriptorSetLayout();
 
-        // NOTE: Need to create completely new Pipelines here or set new properties
-        // for existing pipelines for recreation!
-        //recreateExistingPipelines();
         createShaderResources();
 
         const size_t maxFramesInFlight = Application::get_instance()->getSwapchain()->getMaxFramesInFlight();
@@ -327,60 +305,66 @@ namespace platypus
         uint32_t meshPropertyFlags
     )
     {
-        std::string vertexShaderFilename = _customVertexShaderFilename;
-        if (vertexShaderFilename.empty())
+        std::unordered_map<uint32_t, Pipeline*>::const_iterator pipelineIt = _pipelines.find(meshPropertyFlags);
+        if (pipelineIt != _pipelines.end())
         {
-            vertexShaderFilename = getShaderFilename(
+            Debug::log(
+                "@Material::createPipeline "
+                "Pipeline already exists for material with ID: " + std::to_string(getID()) + " "
+                "for mesh type: " + mesh_type_to_string(get_mesh_type(meshPropertyFlags)),
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            PLATYPUS_ASSERT(false);
+            return;
+        }
+
+        PipelineRegistry& pipelineRegistry = Application::get_instance()->getMasterRenderer()->getPipelineRegistry();
+        _pipelines[meshPropertyFlags] = pipelineRegistry.acquirePipeline(
+            getPipelineDescription(pRenderPass, meshPropertyFlags)
+        );
+    }
+
+    void Material::releasePipelines()
+    {
+        if (_pipelines.empty())
+            return;
+
+        PipelineRegistry& pipelineRegistry = Application::get_instance()->getMasterRenderer()->getPipelineRegistry();
+        std::unordered_map<uint32_t, Pipeline*>::iterator it;
+        for (it = _pipelines.begin(); it != _pipelines.end(); ++it)
+            pipelineRegistry.releasePipeline(it->second);
+
+        _pipelines.clear();
+    }
+
+    PipelineDescription Material::getPipelineDescription(
+        const RenderPass* pRenderPass,
+        uint32_t meshPropertyFlags
+    )
+    {
+        PipelineDescription description;
+        description.pRenderPass = pRenderPass;
+        description.vertexShaderFilename = _customVertexShaderFilename;
+        if (description.vertexShaderFilename.empty())
+        {
+            description.vertexShaderFilename = getShaderFilename(
                 ShaderStageFlagBits::SHADER_STAGE_VERTEX_BIT,
                 meshPropertyFlags
             );
         }
-        std::string fragmentShaderFilename = _customFragmentShaderFilename;
-        if (fragmentShaderFilename.empty())
+        description.fragmentShaderFilename = _customFragmentShaderFilename;
+        if (description.fragmentShaderFilename.empty())
         {
-            fragmentShaderFilename = getShaderFilename(
+            description.fragmentShaderFilename = getShaderFilename(
                 ShaderStageFlagBits::SHADER_STAGE_FRAGMENT_BIT,
                 meshPropertyFlags
             );
         }
-        Debug::log(
-            "@Material::createPipeline Using shaders:\n    " + vertexShaderFilename + "\n    " + fragmentShaderFilename
-        );
-
-        std::unordered_map<uint32_t, MaterialPipelineData*>::const_iterator pipelineIt = _pipelines.find(meshPropertyFlags);
-        if (pipelineIt != _pipelines.end())
-        {
-            if (pipelineIt->second != nullptr)
-            {
-                Debug::log(
-                    "@Material::createPipeline "
-                    "Pipeline data already exists for material with ID: " + std::to_string(getID()) + " "
-                    "for mesh type: " + mesh_type_to_string(get_mesh_type(meshPropertyFlags)),
-                    Debug::MessageType::PLATYPUS_ERROR
-                );
-                PLATYPUS_ASSERT(false);
-                return;
-            }
-        }
 
         // TODO: Unfuck below
-        bool instanced = static_cast<bool>(meshPropertyFlags & static_cast<uint32_t>(MeshPropertyFlagBits::INSTANCED));
+        bool instanced = uses_instanced_transforms(meshPropertyFlags);
         bool skinned = static_cast<bool>(meshPropertyFlags & static_cast<uint32_t>(MeshPropertyFlagBits::TYPE_SKINNED));
 
-        _pipelines[meshPropertyFlags] = new MaterialPipelineData;
-        MaterialPipelineData* pMaterialPipelineData = _pipelines[meshPropertyFlags];
-
-        Shader* pVertexShader = new Shader(
-            vertexShaderFilename,
-            ShaderStageFlagBits::SHADER_STAGE_VERTEX_BIT
-        );
-        Shader* pFragmentShader = new Shader(
-            fragmentShaderFilename,
-            ShaderStageFlagBits::SHADER_STAGE_FRAGMENT_BIT
-        );
-        pMaterialPipelineData->pVertexShader = pVertexShader;
-        pMaterialPipelineData->pFragmentShader = pFragmentShader;
-
         MeshPropertyFlagBits meshType = get_mesh_type(meshPropertyFlags);
         bool meshHasTangents = meshPropertyFlags & static_cast<uint32_t>(MeshPropertyFlagBits::HAS_TANGENTS);
         VertexBufferLayout meshVertexBufferLayout;
@@ -401,106 +385,41 @@ namespace platypus
 
         MasterRenderer* pMasterRenderer = Application::get_instance()->getMasterRenderer();
         // Figure out all used vertex buffer layouts in addition to the mesh layout
-        std::vector<VertexBufferLayout> vertexBufferLayouts;
         pMasterRenderer->solveVertexBufferLayouts(
             meshVertexBufferLayout,
             instanced,
             skinned,
             false,
-            vertexBufferLayouts
+            description.vertexBufferLayouts
         );
         // Figure out all used descriptor set layouts in addition to the material's layout
-        std::vector<DescriptorSetLayout> descriptorSetLayouts;
         pMasterRenderer->solveDescriptorSetLayouts(
             this,
-            instanced,
             skinned,
             false,
-            descriptorSetLayouts
+            description.descriptorSetLayouts
         );
 
-        size_t pushConstantsSize = 0;
-        ShaderStageFlagBits pushConstantsStage = ShaderStageFlagBits::SHADER_STAGE_NONE;
         // If receiving shadows, need to provide shadow proj and view matrices as push constants!
         if (_receiveShadows)
         {
-            pushConstantsSize = sizeof(Matrix4f) * 2;
-            pushConstantsStage = ShaderStageFlagBits::SHADER_STAGE_VERTEX_BIT;
+            description.pushConstantSize = sizeof(Matrix4f) * 2;
+            description.pushConstantStageFlags = ShaderStageFlagBits::SHADER_STAGE_VERTEX_BIT;
         }
-
-        pMaterialPipelineData->pPipeline = new Pipeline(
-            pRenderPass,
-            vertexBufferLayouts,
-            descriptorSetLayouts,
-            pMaterialPipelineData->pVertexShader,
-            pMaterialPipelineData->pFragmentShader,
-            CullMode::CULL_MODE_BACK,
-            FrontFace::FRONT_FACE_COUNTER_CLOCKWISE,
-            true, // Enable depth test
-            !_transparent, // Enable depth write
-            _transparent ? DepthCompareOperation::COMPARE_OP_LESS_OR_EQUAL : DepthCompareOperation::COMPARE_OP_LESS,
-            true, // Enable color blend
-            pushConstantsSize, // Push constants size
-            pushConstantsStage // Push constants' stage flags
-        );
-        pMaterialPipelineData->pPipeline->create();
-    }
-
-    void Material::recreateExistingPipelines()
-    {
-        bool created = false;
-
-        std::unordered_map<uint32_t, MaterialPipelineData*>::iterator it;
-        for (it = _pipelines.begin(); it !=_pipelines.end(); ++it)
+        // Bindless Materials push their index in the material table after the above
+        if (isBindless())
         {
-            // NOTE: Maybe should at least warn in this case?
-            if (!it->second)
-                continue;
-
-            if (it->second->pPipeline)
-            {
-                MasterRenderer* pMasterRenderer = Application::get_instance()->getMasterRenderer();
-                std::vector<DescriptorSetLayout> descriptorSetLayouts;
-                uint32_t meshPropertyFlags = it->first;
-                bool skinned = meshPropertyFlags & static_cast<uint32_t>(MeshPropertyFlagBits::TYPE_SKINNED);
-                bool instanced = meshPropertyFlags & static_cast<uint32_t>(MeshPropertyFlagBits::INSTANCED);
-                pMasterRenderer->solveDescriptorSetLayouts(
-                    this,
-                    instanced, //instanced,
-                    skinned, //skinned,
-                    false,
-                    descriptorSetLayouts
-                );
-                it->second->pPipeline->setDescriptorSetLayouts(descriptorSetLayouts);
-                it->second->pPipeline->create();
-                created = true;
-            }
-        }
-
-        if (!created)
-            warnUnassigned("@Material::recreateExistingPipeline");
-    }
-
-    void Material::destroyPipelines()
-    {
-        bool destroyed = false;
-
-        std::unordered_map<uint32_t, MaterialPipelineData*>::iterator it;
-        for (it = _pipelines.begin(); it !=_pipelines.end(); ++it)
-        {
-            // NOTE: Maybe should at least warn in this case?
-            if (!it->second)
-                continue;
-
-            if (it->second->pPipeline)
-            {
-                it->second->pPipeline->destroy();
-                destroyed = true;
-            }
+            description.pushConstantSize += sizeof(uint32_t);
+            description.pushConstantStageFlags |= ShaderStageFlagBits::SHADER_STAGE_FRAGMENT_BIT;
         }
 
-        if (!destroyed)
-            warnUnassigned("@Material::destroyPipelines");
+        description.cullMode = CullMode::CULL_MODE_BACK;
+        description.frontFace = FrontFace::FRONT_FACE_COUNTER_CLOCKWISE;
+        description.enableDepthTest = true;
+        description.enableDepthWrite = !_transparent;
+        description.depthCmpOp = _transparent ? DepthCompareOperation::COMPARE_OP_LESS_OR_EQUAL : DepthCompareOperation::COMPARE_OP_LESS;
+        description.enableColorBlending = true;
+        return description;
     }
 
     void Material::createShaderResources()
@@ -527,6 +446,42 @@ namespace platypus
             return;
         }
 
+        if (canUseBindless())
+        {
+            BindlessMaterialTable* pBindlessMaterialTable = Application::get_instance()->getMasterRenderer()->getBindlessMaterialTable();
+            _bindlessMaterialIndex = pBindlessMaterialTable->allocMaterial();
+            if (_bindlessMaterialIndex == PLATYPUS_BINDLESS_INVALID_INDEX)
+            {
+                Debug::log(
+                    "Bindless material table was full. "
+                    "Material with ID: " + std::to_string(getID()) + " uses its own descriptor sets instead",
+                    PLATYPUS_CURRENT_FUNC_NAME,
+                    Debug::MessageType::PLATYPUS_WARNING
+                );
+            }
+            else if (acquireBindlessTextures())
+            {
+                // NOTE: Not all callers update the uniform buffers after this
+                // (deserialization, texture recreation) -> the table's entry has to be
+                // written here or it would keep the invalid texture indices
+                const size_t framesInFlight = Application::get_instance()->getSwapchain()->getMaxFramesInFlight();
+                for (size_t i = 0; i < framesInFlight; ++i)
+                    updateUniformBuffers(i);
+                return;
+            }
+            else
+            {
+                pBindlessMaterialTable->freeMaterial(_bindlessMaterialIndex);
+                _bindlessMaterialIndex = PLATYPUS_BINDLESS_INVALID_INDEX;
+                Debug::log(
+                    "Bindless texture array was full. "
+                    "Material with ID: " + std::to_string(getID()) + " uses its own descriptor sets instead",
+                    PLATYPUS_CURRENT_FUNC_NAME,
+                    Debug::MessageType::PLATYPUS_WARNING
+                );
+            }
+        }
+
         // Omg this is soo fucking stupid DO SOMETHING ABOUT THIS!
         DescriptorPool* pDescriptorPool = Device::get_descriptor_pool();
         size_t framesInFlight = Application::get_instance()->getSwapchain()->getMaxFramesInFlight();
@@ -590,6 +545,13 @@ namespace platypus
     {
         Device::wait_for_operations();
 
+        if (isBindless())
+        {
+            releaseBindlessTextures();
+            Application::get_instance()->getMasterRenderer()->getBindlessMaterialTable()->freeMaterial(_bindlessMaterialIndex);
+            _bindlessMaterialIndex = PLATYPUS_BINDLESS_INVALID_INDEX;
+        }
+
         for (Buffer* pBuffer : _uniformBuffers)
             delete pBuffer;
 
@@ -821,13 +783,27 @@ namespace platypus
 
     Pipeline* Material::getPipeline(uint32_t meshPropertyFlags)
     {
-        std::unordered_map<uint32_t, MaterialPipelineData*>::iterator it = _pipelines.find(meshPropertyFlags);
+        std::unordered_map<uint32_t, Pipeline*>::iterator it = _pipelines.find(meshPropertyFlags);
         if (it != _pipelines.end())
-            return it->second->pPipeline;
+            return it->second;
 
         return nullptr;
     }
 
+    const DescriptorSetLayout& Material::getDescriptorSetLayout() const
+    {
+        if (isBindless())
+            return Application::get_instance()->getMasterRenderer()->getBindlessMaterialTable()->getDescriptorSetLayout();
+        return _descriptorSetLayout;
+    }
+
+    const std::vector<DescriptorSet> Material::getDescriptorSets() const
+    {
+        if (isBindless())
+            return Application::get_instance()->getMasterRenderer()->getBindlessMaterialTable()->getDescriptorSets();
+        return _descriptorSets;
+    }
+
     /*
         Serialized format:
             Asset serialized base data
@@ -947,14 +923,22 @@ namespace platypus
             sizeof(UUID_t) * PE_MATERIAL_TEX_CHANNEL_SLOTS;  // normalTextureIDs[PE_MATERIAL_TEX_CHANNEL_SLOTS]
     }
 
-    void Material::warnUnassigned(const std::string& beginStr)
+    std::vector<UUID_t> Material::getDependencies() const
     {
-        Debug::log(
-            beginStr +
-            " Pipeline data was nullptr. "
-            "This Material may have been created but not used by any renderable component.",
-            Debug::MessageType::PLATYPUS_WARNING
-        );
+        std::vector<UUID_t> dependencies;
+        if (_blendmapTextureID != NULL_UUID)
+            dependencies.push_back(_blendmapTextureID);
+
+        for (size_t i = 0; i < PE_MATERIAL_TEX_CHANNEL_SLOTS; ++i)
+        {
+            if (_diffuseTextureIDs[i] != NULL_UUID)
+                dependencies.push_back(_diffuseTextureIDs[i]);
+            if (_specularTextureIDs[i] != NULL_UUID)
+                dependencies.push_back(_specularTextureIDs[i]);
+            if (_normalTextureIDs[i] != NULL_UUID)
+                dependencies.push_back(_normalTextureIDs[i]);
+        }
+        return dependencies;
     }
 
     // NOTE: Below setTexture funcs can atm ONLY be used if there was texture in specified slot earlier!
@@ -1067,6 +1051,23 @@ namespace platypus
         Texture* pNewTexture = reinterpret_cast<Texture*>(pNewTextureAsset);
         updateDescriptorSetTexture(pNewTexture, descriptorIndex);
         (*ppTextures)[slot]= textureID;
+
+        // Bindless Materials refer to the textures by their indices in the material data
+        if (isBindless())
+        {
+            if (!acquireBindlessTextures())
+            {
+                Debug::log(
+                    "Bindless texture array was full. "
+                    "Material with ID: " + std::to_string(getID()) + " keeps its previous textures",
+                    PLATYPUS_CURRENT_FUNC_NAME,
+                    Debug::MessageType::PLATYPUS_WARNING
+                );
+            }
+            const size_t framesInFlight = Application::get_instance()->getSwapchain()->getMaxFramesInFlight();
+            for (size_t i = 0; i < framesInFlight; ++i)
+                updateUniformBuffers(i);
+        }
     }
 
     // NOTE: NOT TESTED, MIGHT BE FUCKED!!
@@ -1156,6 +1157,8 @@ namespace platypus
 
     void Material::createDescriptorSetLayout()
     {
+        // NOTE: Created for bindless Materials too, so those can fall back
+        // to their own descriptor sets if the bindless material table is full
         std::vector<DescriptorSetLayoutBinding> layoutBindings;
         uint32_t textureBindingCount = getTotalTextureCount();
         for (uint32_t textureBinding = 0; textureBinding < textureBindingCount; ++textureBinding)
@@ -1190,6 +1193,20 @@ namespace platypus
 
     void Material::updateUniformBuffers(size_t frame)
     {
+        if (isBindless())
+        {
+            BindlessMaterialData data;
+            data.lightingProperties = _uniformBufferData.lightingProperties;
+            data.textureProperties = _uniformBufferData.textureProperties;
+            memcpy(data.textureIndices, _bindlessTextureIndices, sizeof(_bindlessTextureIndices));
+            Application::get_instance()->getMasterRenderer()->getBindlessMaterialTable()->updateMaterial(
+                _bindlessMaterialIndex,
+                data,
+                frame
+            );
+            return;
+        }
+
         #ifdef PLATYPUS_DEBUG
         if (frame >= _uniformBuffers.size())
         {
@@ -1211,13 +1228,90 @@ namespace platypus
         );
     }
 
+    bool Material::canUseBindless() const
+    {
+        MasterRenderer* pMasterRenderer = Application::get_instance()->getMasterRenderer();
+        if (!pMasterRenderer->getBindlessMaterialTable())
+            return false;
+
+        // Bindless shaders exist only for a single diffuse and specular texture
+        // with optional normal map
+        return _customVertexShaderFilename.empty() &&
+            _customFragmentShaderFilename.empty() &&
+            !_transparent &&
+            _blendmapTextureID == NULL_UUID &&
+            _diffuseTextureCount == 1 &&
+            _specularTextureCount == 1 &&
+            _normalTextureCount <= 1;
+    }
+
+    bool Material::acquireBindlessTextures()
+    {
+        BindlessMaterialTable* pBindlessMaterialTable = Application::get_instance()->getMasterRenderer()->getBindlessMaterialTable();
+        Texture* textures[3] = {
+            getDiffuseTexture(0),
+            getSpecularTexture(0),
+            _normalTextureCount > 0 ? getNormalTexture(0) : nullptr
+        };
+        // NOTE: Acquiring the new ones before releasing the previous ones, so unchanged
+        // textures keep their indices
+        UUID_t prevTextureIDs[3];
+        uint32_t prevTextureIndices[3];
+        memcpy(prevTextureIDs, _bindlessTextureIDs, sizeof(_bindlessTextureIDs));
+        memcpy(prevTextureIndices, _bindlessTextureIndices, sizeof(_bindlessTextureIndices));
+        for (size_t i = 0; i < 3; ++i)
+        {
+            if (!textures[i])
+            {
+                _bindlessTextureIDs[i] = NULL_UUID;
+                _bindlessTextureIndices[i] = PLATYPUS_BINDLESS_INVALID_INDEX;
+                continue;
+            }
+            const uint32_t textureIndex = pBindlessMaterialTable->acquireTexture(textures[i]);
+            if (textureIndex == PLATYPUS_BINDLESS_INVALID_INDEX)
+            {
+                // Texture array was full -> release the ones acquired by this call
+                // and keep the previous ones
+                for (size_t j = 0; j < i; ++j)
+                {
+                    if (_bindlessTextureIDs[j] != NULL_UUID)
+                        pBindlessMaterialTable->releaseTexture(_bindlessTextureIDs[j]);
+                }
+                memcpy(_bindlessTextureIDs, prevTextureIDs, sizeof(_bindlessTextureIDs));
+                memcpy(_bindlessTextureIndices, prevTextureIndices, sizeof(_bindlessTextureIndices));
+                return false;
+            }
+            _bindlessTextureIDs[i] = textures[i]->getID();
+            _bindlessTextureIndices[i] = textureIndex;
+        }
+        for (UUID_t textureID : prevTextureIDs)
+        {
+            if (textureID != NULL_UUID)
+                pBindlessMaterialTable->releaseTexture(textureID);
+        }
+        return true;
+    }
+
+    void Material::releaseBindlessTextures()
+    {
+        BindlessMaterialTable* pBindlessMaterialTable = Application::get_instance()->getMasterRenderer()->getBindlessMaterialTable();
+        for (size_t i = 0; i < 3; ++i)
+        {
+            if (_bindlessTextureIDs[i] != NULL_UUID)
+                pBindlessMaterialTable->releaseTexture(_bindlessTextureIDs[i]);
+            _bindlessTextureIDs[i] = NULL_UUID;
+            _bindlessTextureIndices[i] = PLATYPUS_BINDLESS_INVALID_INDEX;
+        }
+    }
+
     // TODO: Make this convoluted mess cleaner!
     std::string Material::getShaderFilename(uint32_t shaderStage, uint32_t meshPropertyFlags)
     {
         // Vertex shader "name flags":
         //  t = use tangent input
-        //  i = use instanced transforms input
         //
+        // NOTE: All static meshes use the instanced transforms input so there's no
+        // separate "instanced" variant of the shaders anymore.
         // Fragment shader "name flags":
         //  b = use blendmap
         //  d = use diffuse map
@@ -1226,9 +1320,14 @@ namespace platypus
         //  a = use depth map (a stands for "alpha", transparent pass)
 
         // Example shader names:
-        // vertex shader: "StaticVertexShader", "StaticVertexShader_t", "StaticVertexShader_ti"
+        // vertex shader: "StaticVertexShader", "StaticVertexShader_t"
         // fragment shader: "StaticFragmentShader_d", "StaticFragmentShader_ds", "SkinnedFragmentShader_dsn"
         std::string shaderName = "";
+        // Bindless fragment shaders: "bindless/StaticFragmentShader_ds", "bindless/receiveShadows/StaticFragmentShader_ds"
+        if (isBindless() && shaderStage == ShaderStageFlagBits::SHADER_STAGE_FRAGMENT_BIT)
+        {
+            shaderName += "bindless/";
+        }
         if (_receiveShadows)
         {
             shaderName += "receiveShadows/";
@@ -1257,35 +1356,18 @@ namespace platypus
         // Using same vertex shader for diffuse and diffuse+specular
         // TODO: Make this less stupid
         bool meshHasTangents = meshPropertyFlags & static_cast<uint32_t>(MeshPropertyFlagBits::HAS_TANGENTS);
-        bool instanced = meshPropertyFlags & static_cast<uint32_t>(MeshPropertyFlagBits::INSTANCED);
         if (shaderStage == ShaderStageFlagBits::SHADER_STAGE_VERTEX_BIT)
         {
             shaderName += "VertexShader";
-            if (meshHasTangents || instanced)
+            if (meshHasTangents)
             {
-                shaderName += "_";
-                if (meshHasTangents)
-                {
-                    // t stands for tangent
-                    shaderName += "t";
-                }
-                if (instanced)
-                {
-                    // i stands for instanced
-                    shaderName += "i";
-                }
+                // t stands for tangent
+                shaderName += "_t";
             }
         }
         else if (shaderStage == ShaderStageFlagBits::SHADER_STAGE_FRAGMENT_BIT)
         {
-            shaderName += "FragmentShader";
-            // If using non instanced, we got one additional descriptor set containing
-            // transformation matrix, etc. -> Need to use fragment shader that takes this into account!
-            // ...FUCKING STUPID AND ANNOYING!
-            if (instanced)
-                shaderName += "_i_";
-            else
-                shaderName += "_";
+            shaderName += "FragmentShader_";
 
             if (_blendmapTextureID != NULL_UUID)
                 shaderName += "b";
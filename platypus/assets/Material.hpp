@@ -5,6 +5,8 @@
 #include "Mesh.hpp"
 #include "platypus/graphics/Descriptors.hpp"
 #include "platypus/graphics/Pipeline.hpp"
+#include "platypus/graphics/PipelineRegistry.hpp"
+#include "platypus/graphics/renderers/BindlessMaterialTable.hpp"
 #include <vector>
 #include <unordered_map>
 
@@ -18,22 +20,6 @@
 
 namespace platypus
 {
-    struct MaterialPipelineData
-    {
-        Shader* pVertexShader;
-        Shader* pFragmentShader;
-        Pipeline* pPipeline;
-        ~MaterialPipelineData()
-        {
-            // NOTE: IMPORTANT to destroy pipeline before shaders since
-            // web impl detaches the shaders from the opengl shader program
-            // when destroying the pipeline!
-            delete pPipeline;
-            delete pVertexShader;
-            delete pFragmentShader;
-        }
-    };
-
     struct MaterialUniformBufferData
     {
         // x = specular strength,
@@ -72,7 +58,9 @@ namespace platypus
         uint32_t _sceneDepthDescriptorIndex = 0;
 
         // Key = mesh property flags
-        std::unordered_map<uint32_t, MaterialPipelineData*> _pipelines;
+        // NOTE: Pipelines are owned by MasterRenderer's PipelineRegistry and
+        // shared with other Materials using identical pipeline state
+        std::unordered_map<uint32_t, Pipeline*> _pipelines;
 
         // TODO: Material instance
         MaterialUniformBufferData _uniformBufferData;
@@ -84,6 +72,17 @@ namespace platypus
         std::string _customVertexShaderFilename;
         std::string _customFragmentShaderFilename;
 
+        // If the Material is bindless, it has no descriptor sets or uniform buffers of its own.
+        // Its data and textures are in the MasterRenderer's BindlessMaterialTable instead.
+        uint32_t _bindlessMaterialIndex = PLATYPUS_BINDLESS_INVALID_INDEX;
+        // x = diffuse, y = specular, z = normal
+        UUID_t _bindlessTextureIDs[3] = { NULL_UUID, NULL_UUID, NULL_UUID };
+        uint32_t _bindlessTextureIndices[3] = {
+            PLATYPUS_BINDLESS_INVALID_INDEX,
+            PLATYPUS_BINDLESS_INVALID_INDEX,
+            PLATYPUS_BINDLESS_INVALID_INDEX
+        };
+
     public:
         // NOTE: All transparent materials use opaque pass's depth buffer as texture!
         Material(
@@ -111,7 +110,7 @@ namespace platypus
         );
         Material(
             AssetManager* pAssetManager,
-            const std::vector<char>& targetBuffer,
+            const DataView& targetBuffer,
             size_t bufferPos
         );
         ~Material();
@@ -136,8 +135,9 @@ namespace platypus
             uint32_t meshPropertyFlags
         );
 
-        void recreateExistingPipelines();
-        void destroyPipelines();
+        // Pipelines get acquired again by the Batcher when it recreates batches
+        // using this Material
+        void releasePipelines();
 
         void createShaderResources();
         void destroyShaderResources();
@@ -165,8 +165,12 @@ namespace platypus
         ) const override;
 
         virtual size_t getSerializedSize() const override;
+        virtual std::vector<UUID_t> getDependencies() const override;
 
-        void warnUnassigned(const std::string& beginStr);
+        PipelineDescription getPipelineDescription(
+            const RenderPass* pRenderPass,
+            uint32_t meshPropertyFlags
+        );
 
         // NOTE: Below setTexture funcs can atm ONLY be used if there was texture in specified slot earlier!
         // TODO: Allow adding new textures (requires some recreation system?)
@@ -201,8 +205,12 @@ namespace platypus
         inline Vector2f getTextureOffset() const { return { _uniformBufferData.textureProperties.x, _uniformBufferData.textureProperties.y }; }
         inline Vector2f getTextureScale() const { return { _uniformBufferData.textureProperties.z, _uniformBufferData.textureProperties.w };; }
 
-        inline const DescriptorSetLayout& getDescriptorSetLayout() const { return _descriptorSetLayout; }
-        inline const std::vector<DescriptorSet> getDescriptorSets() const { return _descriptorSets; }
+        inline bool isBindless() const { return _bindlessMaterialIndex != PLATYPUS_BINDLESS_INVALID_INDEX; }
+        inline uint32_t getBindlessMaterialIndex() const { return _bindlessMaterialIndex; }
+
+        // Bindless Materials return the BindlessMaterialTable's layout and descriptor sets
+        const DescriptorSetLayout& getDescriptorSetLayout() const;
+        const std::vector<DescriptorSet> getDescriptorSets() const;
 
     private:
         void setTexture(
@@ -218,6 +226,15 @@ namespace platypus
         void createDescriptorSetLayout();
         void updateUniformBuffers(size_t frame);
 
+        // Bindless shaders exist only for some of the Materials' shader variants
+        bool canUseBindless() const;
+        // Acquires the current textures from the BindlessMaterialTable and
+        // releases the previously acquired ones.
+        // Returns false if the texture array was full. Then nothing gets acquired
+        // and the previously acquired textures are kept.
+        bool acquireBindlessTextures();
+        void releaseBindlessTextures();
+
         // Returns compiled shader filename depending on given properties
         std::string getShaderFilename(uint32_t shaderStage, uint32_t meshPropertyFlags);
     };
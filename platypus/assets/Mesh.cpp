@@ -18,6 +18,11 @@ namespace platypus
         return MeshPropertyFlagBits::NONE;
     }
 
+    bool uses_instanced_transforms(uint32_t meshPropertyFlags)
+    {
+        return get_mesh_type(meshPropertyFlags) == MeshPropertyFlagBits::TYPE_STATIC;
+    }
+
     std::string mesh_type_to_string(MeshPropertyFlagBits type)
     {
         switch (type)
@@ -53,26 +58,47 @@ namespace platypus
 
     Mesh::Mesh(
         AssetManager* pAssetManager,
-        const std::vector<char>& targetBuffer,
+        const DataView& targetBuffer,
         size_t bufferPos
     ) :
         Asset(pAssetManager, targetBuffer, bufferPos)
     {
+        const size_t baseAssetSerializedSize = getSerializedBaseSize();
+        const size_t headerSize = sizeof(uint32_t) * 2;
+        uint32_t header[2] = { 0, 0 };
+        if (bufferPos + baseAssetSerializedSize + headerSize <= targetBuffer.size())
+            memcpy(header, targetBuffer.data() + bufferPos + baseAssetSerializedSize, headerSize);
+        if (header[0] != serialized_mesh_magic || header[1] != serialized_mesh_version)
+        {
+            // NOTE: Not added to the AssetManager -> the caller deletes this
+            Debug::log(
+                "Mesh: " + _name + " was serialized using an old format or its version "
+                "wasn't supported. Current version is " + std::to_string(serialized_mesh_version) + ". "
+                "The mesh needs to be reimported",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            _valid = false;
+            return;
+        }
+
         uint8_t storeHostsideBuffersOnDeserialization = 0;
         uint32_t vertexBufferSize = 0;
         uint32_t indexBufferSize = 0;
         IndexType indexType;
-        const size_t baseAssetSerializedSize = getSerializedBaseSize();
-        const size_t baseMeshSize = sizeof(uint32_t) +
+        const size_t baseMeshSize = headerSize +
+            sizeof(uint32_t) +
             sizeof(uint8_t) +
             sizeof(uint32_t) * 2 +
             sizeof(IndexType) +
-            sizeof(UUID_t);
+            sizeof(UUID_t) +
+            sizeof(float) * 6 +
+            sizeof(float) * 4;
 
         PLATYPUS_ASSERT(bufferPos + baseAssetSerializedSize + baseMeshSize < targetBuffer.size());
 
         const char* pBuf = targetBuffer.data() + bufferPos;
-        size_t pos = baseAssetSerializedSize;
+        size_t pos = baseAssetSerializedSize + headerSize;
 
         memcpy(&_propertyFlags, pBuf + pos, sizeof(uint32_t));
         pos += sizeof(uint32_t);
@@ -93,18 +119,33 @@ namespace platypus
         memcpy(&_skeletonID, pBuf + pos, sizeof(UUID_t));
         pos += sizeof(UUID_t);
 
+        // NOTE: AABB and BoundingSphere aren't trivially copyable
+        //  -> read as floats and assigned
+        float aabbData[6];
+        memcpy(aabbData, pBuf + pos, sizeof(float) * 6);
+        pos += sizeof(float) * 6;
+        _aabb.min = Vector3f(aabbData[0], aabbData[1], aabbData[2]);
+        _aabb.max = Vector3f(aabbData[3], aabbData[4], aabbData[5]);
+
+        float boundingSphereData[4];
+        memcpy(boundingSphereData, pBuf + pos, sizeof(float) * 4);
+        pos += sizeof(float) * 4;
+        _boundingSphere.center = Vector3f(boundingSphereData[0], boundingSphereData[1], boundingSphereData[2]);
+        _boundingSphere.radius = boundingSphereData[3];
+
         VertexBufferLayout vertexBufferLayout = VertexBufferLayout::deserialize(
             targetBuffer,
             bufferPos + baseAssetSerializedSize + baseMeshSize
         );
         pos += vertexBufferLayout.getSerializedSize();
 
-        std::vector<float> vertexBufferData(vertexBufferSize / sizeof(float));
-        memcpy(vertexBufferData.data(), pBuf + pos, vertexBufferSize);
+        PLATYPUS_ASSERT(bufferPos + pos + vertexBufferSize + indexBufferSize <= targetBuffer.size());
+        // NOTE: The buffers copy the data into staging straight from the serialized data
+        //  -> no intermediate copies (the serialized data can be a memory mapped asset pack)
+        const char* pVertexBufferData = pBuf + pos;
         pos += vertexBufferSize;
 
-        std::vector<char> indexBufferData(indexBufferSize);
-        memcpy(indexBufferData.data(), pBuf + pos, indexBufferSize);
+        const char* pIndexBufferData = pBuf + pos;
 
         size_t indicesElementSize = 0;
         if (indexType == IndexType::INDEX_TYPE_UINT16)
@@ -127,9 +168,9 @@ namespace platypus
 
         _vertexBufferLayout = vertexBufferLayout;
         _pVertexBuffer = new Buffer(
-            vertexBufferData.data(),
+            pVertexBufferData,
             sizeof(float),
-            vertexBufferData.size(),
+            vertexBufferSize / sizeof(float),
             BufferUsageFlagBits::BUFFER_USAGE_VERTEX_BUFFER_BIT | BufferUsageFlagBits::BUFFER_USAGE_TRANSFER_DST_BIT,
             BufferUpdateFrequency::BUFFER_UPDATE_FREQUENCY_STATIC,
             _storeHostsideBuffersOnDeserialization
@@ -137,7 +178,7 @@ namespace platypus
 
         const size_t indicesLength = indexBufferSize / indicesElementSize;
         _pIndexBuffer = new Buffer(
-            indexBufferData.data(),
+            pIndexBufferData,
             indicesElementSize,
             indicesLength,
             BufferUsageFlagBits::BUFFER_USAGE_INDEX_BUFFER_BIT | BufferUsageFlagBits::BUFFER_USAGE_TRANSFER_DST_BIT,
@@ -166,6 +207,18 @@ namespace platypus
         return false;
     }
 
+    void Mesh::calculateBounds(const void* pVertexData, size_t vertexDataSize)
+    {
+        _aabb = create_aabb(_vertexBufferLayout, pVertexData, vertexDataSize);
+        _boundingSphere = create_bounding_sphere(_aabb, _vertexBufferLayout, pVertexData, vertexDataSize);
+    }
+
+    void Mesh::setBounds(const AABB& aabb, const BoundingSphere& boundingSphere)
+    {
+        _aabb = aabb;
+        _boundingSphere = boundingSphere;
+    }
+
     Mesh* Mesh::generate_terrain(
         size_t uuidPool,
         float tileSize,
@@ -343,6 +396,7 @@ namespace platypus
             { }, // bind pose
             { } // animations
         );
+        pMesh->calculateBounds(vertexData.data(), vertexData.size());
         return pMesh;
     }
 
@@ -350,12 +404,16 @@ namespace platypus
         Serialized format:
             Asset serialized base data
 
+            uint32_t magic (serialized_mesh_magic)
+            uint32_t version (serialized_mesh_version)
             uint32_t meshPropertyFlags
             uint8_t store hostside buffers on deserialization
             uint32_t vertexBufferDataSize
             uint32_t indexBufferDataSize
             IndexType indexType
             UUID_t skeletonAssetID
+            float aabb[6] (min xyz, max xyz)
+            float boundingSphere[4] (center xyz, radius)
 
             VertexBufferLayout serialized vbLayout data
 
@@ -404,6 +462,10 @@ namespace platypus
         serializeBase(pBuf);
         size_t pos = getSerializedBaseSize();
 
+        const uint32_t header[2] = { serialized_mesh_magic, serialized_mesh_version };
+        memcpy(pBuf + pos, header, sizeof(uint32_t) * 2);
+        pos += sizeof(uint32_t) * 2;
+
         memcpy(pBuf + pos, &_propertyFlags, sizeof(uint32_t));
         pos += sizeof(uint32_t);
 
@@ -445,6 +507,20 @@ namespace platypus
         memcpy(pBuf + pos, &_skeletonID, sizeof(UUID_t));
         pos += sizeof(UUID_t);
 
+        const float aabbData[6] = {
+            _aabb.min.x, _aabb.min.y, _aabb.min.z,
+            _aabb.max.x, _aabb.max.y, _aabb.max.z
+        };
+        memcpy(pBuf + pos, aabbData, sizeof(float) * 6);
+        pos += sizeof(float) * 6;
+
+        const float boundingSphereData[4] = {
+            _boundingSphere.center.x, _boundingSphere.center.y, _boundingSphere.center.z,
+            _boundingSphere.radius
+        };
+        memcpy(pBuf + pos, boundingSphereData, sizeof(float) * 4);
+        pos += sizeof(float) * 4;
+
         memcpy(pBuf + pos, vertexBufferLayoutData.data(), vertexBufferLayoutData.size());
         pos += vertexBufferLayoutData.size();
 
@@ -461,17 +537,27 @@ namespace platypus
     size_t Mesh::getSerializedSize() const
     {
         return getSerializedBaseSize() +
+            sizeof(uint32_t) * 2 + // magic and version
             sizeof(uint32_t) + // meshPropertyFlags
             sizeof(uint8_t) + // store hostside buffers on deserialization
             sizeof(uint32_t) + // vertexBufferDataSize
             sizeof(uint32_t) + // indexBufferDataSize
             sizeof(IndexType) + // indexType
             sizeof(UUID_t) + // skeletonAssetID
+            sizeof(float) * 6 + // aabb
+            sizeof(float) * 4 + // boundingSphere
             _vertexBufferLayout.getSerializedSize() +
             _pVertexBuffer->getTotalSize() +
             _pIndexBuffer->getTotalSize();
     }
 
+    std::vector<UUID_t> Mesh::getDependencies() const
+    {
+        if (_skeletonID == NULL_UUID)
+            return { };
+        return { _skeletonID };
+    }
+
     Skeleton* Mesh::getSkeleton() const
     {
         AssetManager* pAssetManager = Application::get_instance()->getAssetManager();
@@ -482,4 +568,41 @@ namespace platypus
 
         return nullptr;
     }
+
+    // Skinned meshes' bounds are from their bind pose
+    //  -> need some slack for the animated poses
+    static const float s_skinnedBoundsScale = 1.5f;
+
+    bool get_mesh_world_bounds(
+        const Mesh* pMesh,
+        const Matrix4f& globalMatrix,
+        Vector3f& outCenter,
+        Vector3f& outExtents
+    )
+    {
+        if (!pMesh || !pMesh->getAABB().isValid())
+            return false;
+
+        if (get_mesh_type(pMesh->getPropertyFlags()) == MeshPropertyFlagBits::TYPE_SKINNED)
+        {
+            // Renderable is at the root joint which is transformed by its bind pose
+            // NOTE: Expecting root joint to be the skeleton's first joint!
+            const Skeleton* pSkeleton = pMesh->getSkeleton();
+            Matrix4f boundsMatrix = globalMatrix;
+            if (pSkeleton && pSkeleton->getJointCount() > 0)
+                boundsMatrix = globalMatrix * pSkeleton->getJoint(0).inverseMatrix;
+
+            const BoundingSphere& sphere = pMesh->getBoundingSphere();
+            const float radius = sphere.radius * s_skinnedBoundsScale;
+            AABB sphereBounds;
+            sphereBounds.min = sphere.center - Vector3f(radius, radius, radius);
+            sphereBounds.max = sphere.center + Vector3f(radius, radius, radius);
+            transform_aabb(boundsMatrix, sphereBounds, outCenter, outExtents);
+        }
+        else
+        {
+            transform_aabb(globalMatrix, pMesh->getAABB(), outCenter, outExtents);
+        }
+        return true;
+    }
 }
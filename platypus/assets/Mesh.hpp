@@ -4,6 +4,7 @@
 #include "SkeletalAnimationData.hpp"
 #include "platypus/graphics/Buffers.hpp"
 #include "platypus/utils/Maths.hpp"
+#include "platypus/utils/Bounds.hpp"
 #include "platypus/utils/AnimationDataUtils.hpp"
 
 
@@ -20,8 +21,16 @@ namespace platypus
         INSTANCED = 0x1 << 3
     };
     MeshPropertyFlagBits get_mesh_type(uint32_t meshPropertyFlags);
+    // Static meshes get their transformation matrices from a per instance vertex buffer
+    // whether they're flagged INSTANCED or not.
+    bool uses_instanced_transforms(uint32_t meshPropertyFlags);
     std::string mesh_type_to_string(MeshPropertyFlagBits type);
 
+    // Written after the Asset base data. Bump the version when the serialized layout changes.
+    // NOTE: Meshes serialized before this have no magic and are rejected.
+    constexpr uint32_t serialized_mesh_magic = 0x4853454D; // "MESH"
+    constexpr uint32_t serialized_mesh_version = 1;
+
     class AssetManager;
     class Mesh : public Asset
     {
@@ -41,6 +50,11 @@ namespace platypus
         // *Then this was Skeleton* _pSkeleton...
         UUID_t _skeletonID = NULL_UUID;
 
+        // Bounds in the mesh's own space, used for culling.
+        // NOTE: Skinned meshes' bounds are from their bind pose!
+        AABB _aabb;
+        BoundingSphere _boundingSphere;
+
     public:
         // NOTE: Ownership of vertex and index buffer gets transferred to this Mesh
         Mesh(
@@ -57,13 +71,19 @@ namespace platypus
         );
         Mesh(
             AssetManager* pAssetManager,
-            const std::vector<char>& targetBuffer,
+            const DataView& targetBuffer,
             size_t bufferPos
         );
         ~Mesh();
 
         bool hasTangents() const;
 
+        // Calculates bounds from vertex data laid out as this mesh's vertex buffer layout.
+        // This has to be called when loading the mesh, since vertex buffers
+        // don't necessarily store their host side data.
+        void calculateBounds(const void* pVertexData, size_t vertexDataSize);
+        void setBounds(const AABB& aabb, const BoundingSphere& boundingSphere);
+
         static Mesh* generate_terrain(
             size_t uuidPool,
             float tileSize,
@@ -78,6 +98,7 @@ namespace platypus
         ) const override;
 
         virtual size_t getSerializedSize() const override;
+        virtual std::vector<UUID_t> getDependencies() const override;
 
         Skeleton* getSkeleton() const;
 
@@ -90,5 +111,18 @@ namespace platypus
         inline void storeHostsideBuffersOnDeserialization(bool arg) { _storeHostsideBuffersOnDeserialization = arg; }
         inline const Matrix4f getTransformationMatrix() const { return _transformationMatrix; }
         inline UUID_t getSkeletonID() const { return _skeletonID; }
+        inline const AABB& getAABB() const { return _aabb; }
+        inline const BoundingSphere& getBoundingSphere() const { return _boundingSphere; }
     };
+
+    // World space bounds of the mesh transformed by globalMatrix as center and half extents.
+    // Skinned meshes use their bounding sphere around the root joint with some slack
+    // for the animated poses.
+    // Returns false if the mesh has no bounds.
+    bool get_mesh_world_bounds(
+        const Mesh* pMesh,
+        const Matrix4f& globalMatrix,
+        Vector3f& outCenter,
+        Vector3f& outExtents
+    );
 }
@@ -24,7 +24,7 @@ namespace platypus
 
     Model::Model(
         AssetManager* pAssetManager,
-        const std::vector<char>& targetBuffer,
+        const DataView& targetBuffer,
         size_t bufferPos
     ) :
         Asset(pAssetManager, targetBuffer, bufferPos)
@@ -133,4 +133,12 @@ namespace platypus
             _filepath.size() +
             sizeof(UUID_t) * _meshes.size();
     }
+
+    std::vector<UUID_t> Model::getDependencies() const
+    {
+        std::vector<UUID_t> dependencies;
+        for (const Mesh* pMesh : _meshes)
+            dependencies.push_back(pMesh->getID());
+        return dependencies;
+    }
 }
@@ -36,7 +36,7 @@ namespace platypus
         );
         Model(
             AssetManager* pAssetManager,
-            const std::vector<char>& targetBuffer,
+            const DataView& targetBuffer,
             size_t bufferPos
         );
         ~Model();
@@ -46,6 +46,7 @@ namespace platypus
         ) const override;
 
         virtual size_t getSerializedSize() const override;
+        virtual std::vector<UUID_t> getDependencies() const override;
 
         inline const std::string& getFilepath() const { return _filepath; }
         inline bool isInstanced() const { return _instanced; }
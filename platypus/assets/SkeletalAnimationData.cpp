@@ -2,6 +2,7 @@
 #include "AssetManager.hpp"
 #include "platypus/core/Application.hpp"
 #include "platypus/core/Debug.hpp"
+#include <algorithm>
 
 
 namespace platypus
@@ -13,88 +14,186 @@ namespace platypus
         return midWayLength / framesDiff;
     }
 
+    // Returns index of the last key at or before time (0 if time is before the first key).
+    static uint32_t find_key(const float* pTimes, uint32_t keyCount, float time, uint32_t cursor)
+    {
+        // Usually we're still between the same keys as previously or have moved to the next ones
+        if (cursor + 1 < keyCount && pTimes[cursor] <= time)
+        {
+            if (time < pTimes[cursor + 1])
+                return cursor;
+            if (cursor + 2 < keyCount && time < pTimes[cursor + 2])
+                return cursor + 1;
+        }
+        const float* pUpper = std::upper_bound(pTimes, pTimes + keyCount, time);
+        if (pUpper == pTimes)
+            return 0;
+        return static_cast<uint32_t>(pUpper - pTimes) - 1;
+    }
+
+    // Returns index of the key to interpolate from and updates the cursor.
+    // outAmount is the interpolation amount towards the next key
+    // or 0 if time is outside the keys' range.
+    static uint32_t find_interpolation_key(
+        const float* pTimes,
+        uint32_t keyCount,
+        float time,
+        uint32_t& cursor,
+        float& outAmount
+    )
+    {
+        const uint32_t key = find_key(pTimes, keyCount, time, cursor);
+        cursor = key;
+        if (key + 1 >= keyCount || time <= pTimes[key])
+            outAmount = 0.0f;
+        else
+            outAmount = get_interpolation_amount(time, pTimes[key], pTimes[key + 1]);
+        return key;
+    }
+
+    static Vector3f sample_vector_keys(
+        const float* pTimes,
+        const Vector3f* pValues,
+        uint32_t keyCount,
+        float time,
+        uint32_t& cursor
+    )
+    {
+        float amount = 0.0f;
+        const uint32_t key = find_interpolation_key(pTimes, keyCount, time, cursor, amount);
+        if (amount > 0.0f)
+            return pValues[key].lerp(pValues[key + 1], amount);
+        return pValues[key];
+    }
+
 
     SkeletalAnimationData::SkeletalAnimationData(
         size_t uuidPool,
-        const KeyframeAnimationData& animationData
+        const KeyframeAnimationData& animationData,
+        const AnimationCompression& compression
     ) :
         Asset(uuidPool, AssetType::ASSET_TYPE_SKELETAL_ANIMATION_DATA, animationData.name, NULL_UUID, false),
         _length(animationData.length),
-        _keyframeData(animationData.keyframes)
+        _quantizedRotations(compression.quantizeRotations)
     {
+        const KeyframeAnimationData reducedData = reduce_keyframes(animationData, compression);
+        _jointKeyRanges.reserve(reducedData.keyframes.size());
+        for (const JointAnimationData& jointAnimData : reducedData.keyframes)
+            addJointKeys(jointAnimData);
 
+        _referencePoses.resize(_jointKeyRanges.size());
+        sampleJoints(0.0f, _referencePoses.data(), _referencePoses.size());
     }
 
     SkeletalAnimationData::SkeletalAnimationData(
         AssetManager* pAssetManager,
-        const std::vector<char>& targetBuffer,
+        const DataView& targetBuffer,
         size_t bufferPos
     ) :
         Asset(pAssetManager, targetBuffer, bufferPos)
     {
         const size_t serializedBaseSize = getSerializedBaseSize();
-        PLATYPUS_ASSERT(bufferPos + serializedBaseSize < targetBuffer.size());
+        const size_t headerSize = sizeof(uint32_t) * 2;
+        uint32_t header[2] = { 0, 0 };
+        if (bufferPos + serializedBaseSize + headerSize <= targetBuffer.size())
+            memcpy(header, targetBuffer.data() + bufferPos + serializedBaseSize, headerSize);
+        if (header[0] != serialized_animation_magic || header[1] != serialized_animation_version)
+        {
+            // NOTE: Not added to the AssetManager -> the caller deletes this
+            Debug::log(
+                "Animation: " + _name + " was serialized using an old format or its version "
+                "wasn't supported. Current version is " + std::to_string(serialized_animation_version) + ". "
+                "The animation needs to be reimported",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            _valid = false;
+            return;
+        }
 
         const char* pBuf = targetBuffer.data() + bufferPos;
-        size_t pos = serializedBaseSize;
+        size_t pos = serializedBaseSize + headerSize;
 
         memcpy(&_length, pBuf + pos, sizeof(float));
         pos += sizeof(float);
 
+        uint8_t quantizedRotations = 0;
+        memcpy(&quantizedRotations, pBuf + pos, sizeof(uint8_t));
+        pos += sizeof(uint8_t);
+        _quantizedRotations = quantizedRotations;
+
         uint32_t jointCountU32 = 0;
         memcpy(&jointCountU32, pBuf + pos, sizeof(uint32_t));
         pos += sizeof(uint32_t);
         const size_t jointCount = static_cast<const size_t>(jointCountU32);
-        _keyframeData.resize(jointCount);
+        _jointKeyRanges.resize(jointCount);
         for (uint32_t jointIndex = 0; jointIndex < jointCount; ++jointIndex)
         {
-            JointAnimationData& jointAnimData = _keyframeData[jointIndex];
+            JointKeyRanges& keyRanges = _jointKeyRanges[jointIndex];
             uint32_t translationKeyCountU32 = 0;
             uint32_t rotationKeyCountU32 = 0;
+            uint32_t scaleKeyCountU32 = 0;
             memcpy(&translationKeyCountU32, pBuf + pos, sizeof(uint32_t));
             pos += sizeof(uint32_t);
             memcpy(&rotationKeyCountU32, pBuf + pos, sizeof(uint32_t));
             pos += sizeof(uint32_t);
+            memcpy(&scaleKeyCountU32, pBuf + pos, sizeof(uint32_t));
+            pos += sizeof(uint32_t);
 
-            const size_t translationKeyCount = static_cast<const size_t>(translationKeyCountU32);
-            const size_t rotationKeyCount = static_cast<const size_t>(rotationKeyCountU32);
-
-            jointAnimData.translations.resize(translationKeyCount);
-            jointAnimData.rotations.resize(rotationKeyCount);
+            keyRanges.translations = { static_cast<uint32_t>(_translations.size()), translationKeyCountU32 };
+            keyRanges.rotations = { static_cast<uint32_t>(_rotationTimes.size()), rotationKeyCountU32 };
+            keyRanges.scales = { static_cast<uint32_t>(_scales.size()), scaleKeyCountU32 };
 
-            for (size_t translationKeyIndex = 0; translationKeyIndex < translationKeyCount; ++translationKeyIndex)
+            for (uint32_t translationKeyIndex = 0; translationKeyIndex < translationKeyCountU32; ++translationKeyIndex)
             {
-                memcpy(
-                    &jointAnimData.translations[translationKeyIndex].time,
-                    pBuf + pos,
-                    sizeof(float)
-                );
+                float time = 0.0f;
+                Vector3f translation;
+                memcpy(&time, pBuf + pos, sizeof(float));
                 pos += sizeof(float);
-                memcpy(
-                    &jointAnimData.translations[translationKeyIndex].translation,
-                    pBuf + pos,
-                    sizeof(Vector3f)
-                );
+                memcpy(&translation, pBuf + pos, sizeof(Vector3f));
                 pos += sizeof(Vector3f);
+                _translationTimes.push_back(time);
+                _translations.push_back(translation);
             }
 
-            for (size_t rotationKeyIndex = 0; rotationKeyIndex < rotationKeyCount; ++rotationKeyIndex)
+            for (uint32_t rotationKeyIndex = 0; rotationKeyIndex < rotationKeyCountU32; ++rotationKeyIndex)
             {
-                memcpy(
-                    &jointAnimData.rotations[rotationKeyIndex].time,
-                    pBuf + pos,
-                    sizeof(float)
-                );
+                float time = 0.0f;
+                memcpy(&time, pBuf + pos, sizeof(float));
                 pos += sizeof(float);
-                memcpy(
-                    &jointAnimData.rotations[rotationKeyIndex].rotation,
-                    pBuf + pos,
-                    sizeof(Quaternion)
-                );
-                pos += sizeof(Quaternion);
+                _rotationTimes.push_back(time);
+                if (_quantizedRotations)
+                {
+                    PackedQuaternion rotation;
+                    memcpy(&rotation, pBuf + pos, sizeof(PackedQuaternion));
+                    pos += sizeof(PackedQuaternion);
+                    _packedRotations.push_back(rotation);
+                }
+                else
+                {
+                    Quaternion rotation;
+                    memcpy(&rotation, pBuf + pos, sizeof(Quaternion));
+                    pos += sizeof(Quaternion);
+                    _rotations.push_back(rotation);
+                }
+            }
+
+            for (uint32_t scaleKeyIndex = 0; scaleKeyIndex < scaleKeyCountU32; ++scaleKeyIndex)
+            {
+                float time = 0.0f;
+                Vector3f scale;
+                memcpy(&time, pBuf + pos, sizeof(float));
+                pos += sizeof(float);
+                memcpy(&scale, pBuf + pos, sizeof(Vector3f));
+                pos += sizeof(Vector3f);
+                _scaleTimes.push_back(time);
+                _scales.push_back(scale);
             }
         }
 
+        _referencePoses.resize(_jointKeyRanges.size());
+        sampleJoints(0.0f, _referencePoses.data(), _referencePoses.size());
+
         pAssetManager->addExternalAsset(this);
         if (_persistent)
             pAssetManager->makePersistent(this);
@@ -103,76 +202,202 @@ namespace platypus
     SkeletalAnimationData::~SkeletalAnimationData()
     {}
 
-    Matrix4f SkeletalAnimationData::getBoneMatrix(float time, int boneIndex) const
+    void SkeletalAnimationData::sampleJoints(
+        float time,
+        JointPose* pOutPoses,
+        size_t jointCount,
+        KeyframeCursor* pCursors,
+        JointMask jointMask
+    ) const
     {
-        // Get interpolated translation
-        const std::vector<TranslationKey>& translationKeys = _keyframeData[boneIndex].translations;
-        TranslationKey currentTranslationKey = translationKeys[0];
-        TranslationKey nextTranslationKey = translationKeys[0];
-        for (size_t i = 0; i < translationKeys.size() - 1; ++i)
+        const size_t sampleCount = std::min(jointCount, _jointKeyRanges.size());
+
+        // Rotations needing interpolation are collected and slerped in batches
+        const size_t maxBatchSize = 16;
+        Quaternion fromRotations[maxBatchSize];
+        Quaternion toRotations[maxBatchSize];
+        float rotationAmounts[maxBatchSize];
+        Quaternion batchResults[maxBatchSize];
+        size_t batchJoints[maxBatchSize];
+        size_t batchSize = 0;
+
+        for (size_t jointIndex = 0; jointIndex < sampleCount; ++jointIndex)
         {
-            if (time < translationKeys[i + 1].time)
+            const bool skipJoint = jointIndex < joint_mask_max_joints && !(jointMask & (static_cast<JointMask>(1) << jointIndex));
+            if (skipJoint)
+                continue;
+
+            KeyframeCursor cursor;
+            if (pCursors)
+                cursor = pCursors[jointIndex];
+
+            JointPose& pose = pOutPoses[jointIndex];
+            pose = JointPose();
+            uint32_t rotationKey = 0;
+            float rotationAmount = 0.0f;
+            if (sampleJointKeys(time, jointIndex, cursor, pose, rotationKey, rotationAmount))
+            {
+                fromRotations[batchSize] = getRotation(rotationKey);
+                toRotations[batchSize] = getRotation(rotationKey + 1);
+                rotationAmounts[batchSize] = rotationAmount;
+                batchJoints[batchSize] = jointIndex;
+                ++batchSize;
+            }
+
+            if (pCursors)
+                pCursors[jointIndex] = cursor;
+
+            if (batchSize == maxBatchSize)
             {
-                currentTranslationKey = translationKeys[i];
-                nextTranslationKey = translationKeys[i + 1];
-                break;
+                slerp_quaternions(fromRotations, toRotations, rotationAmounts, batchResults, batchSize);
+                for (size_t i = 0; i < batchSize; ++i)
+                    pOutPoses[batchJoints[i]].rotation = batchResults[i];
+                batchSize = 0;
             }
         }
-        Vector3f interpolatedTranslation = currentTranslationKey.translation;
-        float translationInterpolationAmount = get_interpolation_amount(
-            time,
-            currentTranslationKey.time,
-            nextTranslationKey.time
-        );
-        if (translationInterpolationAmount <= 1.0f)
+
+        if (batchSize > 0)
         {
-            interpolatedTranslation = interpolatedTranslation.lerp(
-                nextTranslationKey.translation,
-                translationInterpolationAmount
+            slerp_quaternions(fromRotations, toRotations, rotationAmounts, batchResults, batchSize);
+            for (size_t i = 0; i < batchSize; ++i)
+                pOutPoses[batchJoints[i]].rotation = batchResults[i];
+        }
+    }
+
+    JointPose SkeletalAnimationData::sampleJoint(float time, size_t jointIndex) const
+    {
+        PLATYPUS_ASSERT(jointIndex < _jointKeyRanges.size());
+        JointPose pose;
+        // NOTE: Fresh cursor -> keys are found using binary search
+        KeyframeCursor cursor;
+        uint32_t rotationKey = 0;
+        float rotationAmount = 0.0f;
+        if (sampleJointKeys(time, jointIndex, cursor, pose, rotationKey, rotationAmount))
+            pose.rotation = getRotation(rotationKey).slerp(getRotation(rotationKey + 1), rotationAmount);
+        return pose;
+    }
+
+    Matrix4f SkeletalAnimationData::getBoneMatrix(float time, int boneIndex) const
+    {
+        const JointPose pose = sampleJoint(time, static_cast<size_t>(boneIndex));
+        return create_transformation_matrix(pose.translation, pose.rotation, pose.scale);
+    }
+
+    void SkeletalAnimationData::addJointKeys(const JointAnimationData& jointAnimationData)
+    {
+        JointKeyRanges keyRanges;
+        keyRanges.translations = {
+            static_cast<uint32_t>(_translations.size()),
+            static_cast<uint32_t>(jointAnimationData.translations.size())
+        };
+        keyRanges.rotations = {
+            static_cast<uint32_t>(_rotationTimes.size()),
+            static_cast<uint32_t>(jointAnimationData.rotations.size())
+        };
+        keyRanges.scales = {
+            static_cast<uint32_t>(_scales.size()),
+            static_cast<uint32_t>(jointAnimationData.scales.size())
+        };
+        _jointKeyRanges.push_back(keyRanges);
+
+        for (const TranslationKey& key : jointAnimationData.translations)
+        {
+            _translationTimes.push_back(key.time);
+            _translations.push_back(key.translation);
+        }
+        for (const RotationKey& key : jointAnimationData.rotations)
+        {
+            _rotationTimes.push_back(key.time);
+            if (_quantizedRotations)
+                _packedRotations.push_back(pack_quaternion(key.rotation));
+            else
+                _rotations.push_back(key.rotation);
+        }
+        for (const ScaleKey& key : jointAnimationData.scales)
+        {
+            _scaleTimes.push_back(key.time);
+            _scales.push_back(key.scale);
+        }
+    }
+
+    bool SkeletalAnimationData::sampleJointKeys(
+        float time,
+        size_t jointIndex,
+        KeyframeCursor& cursor,
+        JointPose& outPose,
+        uint32_t& outRotationKey,
+        float& outRotationAmount
+    ) const
+    {
+        const JointKeyRanges& keyRanges = _jointKeyRanges[jointIndex];
+        bool interpolateRotation = false;
+
+        if (keyRanges.translations.count > 0)
+        {
+            const uint32_t begin = keyRanges.translations.begin;
+            outPose.translation = sample_vector_keys(
+                _translationTimes.data() + begin,
+                _translations.data() + begin,
+                keyRanges.translations.count,
+                time,
+                cursor.translation
             );
         }
 
-        // Get interpolated rotation
-        const std::vector<RotationKey>& rotationKeys = _keyframeData[boneIndex].rotations;
-        RotationKey currentRotationKey = rotationKeys[0];
-        RotationKey nextRotationKey = rotationKeys[0];
-        for (size_t i = 0; i < rotationKeys.size() - 1; ++i)
+        if (keyRanges.rotations.count > 0)
         {
-            if (time < rotationKeys[i + 1].time)
+            const uint32_t begin = keyRanges.rotations.begin;
+            float amount = 0.0f;
+            const uint32_t key = begin + find_interpolation_key(
+                _rotationTimes.data() + begin,
+                keyRanges.rotations.count,
+                time,
+                cursor.rotation,
+                amount
+            );
+            if (amount > 0.0f)
             {
-                currentRotationKey = rotationKeys[i];
-                nextRotationKey = rotationKeys[i + 1];
-                break;
+                outRotationKey = key;
+                outRotationAmount = amount;
+                interpolateRotation = true;
+            }
+            else
+            {
+                outPose.rotation = getRotation(key);
             }
         }
-        Quaternion interpolatedRotation = currentRotationKey.rotation;
-        float rotationInterpolationAmount = get_interpolation_amount(
-            time,
-            currentRotationKey.time,
-            nextRotationKey.time
-        );
-        if (rotationInterpolationAmount <= 1.0f)
+
+        if (keyRanges.scales.count > 0)
         {
-            interpolatedRotation = interpolatedRotation.slerp(
-                nextRotationKey.rotation,
-                rotationInterpolationAmount
+            const uint32_t begin = keyRanges.scales.begin;
+            outPose.scale = sample_vector_keys(
+                _scaleTimes.data() + begin,
+                _scales.data() + begin,
+                keyRanges.scales.count,
+                time,
+                cursor.scale
             );
         }
-
-        // Combine and return
-        Matrix4f translationMatrix(1.0f);
-        translationMatrix[0 + 3 * 4] = interpolatedTranslation.x;
-        translationMatrix[1 + 3 * 4] = interpolatedTranslation.y;
-        translationMatrix[2 + 3 * 4] = interpolatedTranslation.z;
-        return translationMatrix * interpolatedRotation.toRotationMatrix();
+        return interpolateRotation;
     }
 
     /*
         Serialized format:
             Asset serialized base data
+            uint32_t magic
+            uint32_t version
             float animLength
+            uint8_t quantizedRotations
             uint32_t jointCount
             JointAnimationData jointAnimData[jointCount]
+                NOTE: serialized JointAnimationData format:
+                    uint32_t translationKeyCount
+                    uint32_t rotationKeyCount
+                    uint32_t scaleKeyCount
+                    TranslationKey translationKeys[translationKeyCount]
+                    RotationKey rotationKeys[rotationKeyCount]
+                        NOTE: Rotations are PackedQuaternions if quantizedRotations
+                    ScaleKey scaleKeys[scaleKeyCount]
     */
     void SkeletalAnimationData::serialize(std::vector<char>& targetBuffer) const
     {
@@ -184,42 +409,65 @@ namespace platypus
         serializeBase(pBuf);
         size_t pos = getSerializedBaseSize();
 
+        const uint32_t header[2] = { serialized_animation_magic, serialized_animation_version };
+        memcpy(pBuf + pos, header, sizeof(uint32_t) * 2);
+        pos += sizeof(uint32_t) * 2;
+
         memcpy(pBuf + pos, &_length, sizeof(float));
         pos += sizeof(float);
 
-        const size_t jointCount = _keyframeData.size();
+        const uint8_t quantizedRotations = _quantizedRotations ? 1 : 0;
+        memcpy(pBuf + pos, &quantizedRotations, sizeof(uint8_t));
+        pos += sizeof(uint8_t);
+
+        const size_t jointCount = _jointKeyRanges.size();
         const uint32_t jointCountU32 = static_cast<const uint32_t>(jointCount);
         memcpy(pBuf + pos, &jointCountU32, sizeof(uint32_t));
         pos += sizeof(uint32_t);
 
         for (size_t i = 0; i < jointCount; ++i)
         {
-            const JointAnimationData& jointAnimData = _keyframeData[i];
-            const size_t translationKeyCount = jointAnimData.translations.size();
-            const size_t rotationKeyCount = jointAnimData.rotations.size();
-            const uint32_t translationKeyCountU32 = static_cast<const uint32_t>(translationKeyCount);
-            const uint32_t rotationKeyCountU32 = static_cast<const uint32_t>(rotationKeyCount);
-            memcpy(pBuf + pos, &translationKeyCountU32, sizeof(uint32_t));
+            const JointKeyRanges& keyRanges = _jointKeyRanges[i];
+            memcpy(pBuf + pos, &keyRanges.translations.count, sizeof(uint32_t));
+            pos += sizeof(uint32_t);
+            memcpy(pBuf + pos, &keyRanges.rotations.count, sizeof(uint32_t));
             pos += sizeof(uint32_t);
-            memcpy(pBuf + pos, &rotationKeyCountU32, sizeof(uint32_t));
+            memcpy(pBuf + pos, &keyRanges.scales.count, sizeof(uint32_t));
             pos += sizeof(uint32_t);
 
-            for (size_t translationKeyIndex = 0; translationKeyIndex < translationKeyCount; ++translationKeyIndex)
+            const uint32_t translationsEnd = keyRanges.translations.begin + keyRanges.translations.count;
+            for (uint32_t keyIndex = keyRanges.translations.begin; keyIndex < translationsEnd; ++keyIndex)
             {
-                const TranslationKey& translationKey = jointAnimData.translations[translationKeyIndex];
-                memcpy(pBuf + pos, &translationKey.time, sizeof(float));
+                memcpy(pBuf + pos, &_translationTimes[keyIndex], sizeof(float));
                 pos += sizeof(float);
-                memcpy(pBuf + pos, &translationKey.translation, sizeof(Vector3f));
+                memcpy(pBuf + pos, &_translations[keyIndex], sizeof(Vector3f));
                 pos += sizeof(Vector3f);
             }
 
-            for (size_t rotationKeyIndex = 0; rotationKeyIndex < rotationKeyCount; ++rotationKeyIndex)
+            const uint32_t rotationsEnd = keyRanges.rotations.begin + keyRanges.rotations.count;
+            for (uint32_t keyIndex = keyRanges.rotations.begin; keyIndex < rotationsEnd; ++keyIndex)
             {
-                const RotationKey& rotationKey = jointAnimData.rotations[rotationKeyIndex];
-                memcpy(pBuf + pos, &rotationKey.time, sizeof(float));
+                memcpy(pBuf + pos, &_rotationTimes[keyIndex], sizeof(float));
                 pos += sizeof(float);
-                memcpy(pBuf + pos, &rotationKey.rotation, sizeof(Quaternion));
-                pos += sizeof(Quaternion);
+                if (_quantizedRotations)
+                {
+                    memcpy(pBuf + pos, &_packedRotations[keyIndex], sizeof(PackedQuaternion));
+                    pos += sizeof(PackedQuaternion);
+                }
+                else
+                {
+                    memcpy(pBuf + pos, &_rotations[keyIndex], sizeof(Quaternion));
+                    pos += sizeof(Quaternion);
+                }
+            }
+
+            const uint32_t scalesEnd = keyRanges.scales.begin + keyRanges.scales.count;
+            for (uint32_t keyIndex = keyRanges.scales.begin; keyIndex < scalesEnd; ++keyIndex)
+            {
+                memcpy(pBuf + pos, &_scaleTimes[keyIndex], sizeof(float));
+                pos += sizeof(float);
+                memcpy(pBuf + pos, &_scales[keyIndex], sizeof(Vector3f));
+                pos += sizeof(Vector3f);
             }
         }
         PLATYPUS_ASSERT(pos == serializedSize);
@@ -228,11 +476,13 @@ namespace platypus
     size_t SkeletalAnimationData::getSerializedSize() const
     {
         size_t combinedJointAnimationDataSize = 0;
-        for (size_t i = 0; i < _keyframeData.size(); ++i)
+        for (size_t i = 0; i < _jointKeyRanges.size(); ++i)
             combinedJointAnimationDataSize += getSerializedJointAnimationDataSize(i);
 
         return getSerializedBaseSize() +
+            sizeof(uint32_t) * 2 + // magic and version
             sizeof(float) + // anim length
+            sizeof(uint8_t) + // quantized rotations
             sizeof(uint32_t) + // joint count
             combinedJointAnimationDataSize;
     }
@@ -246,17 +496,25 @@ namespace platypus
     size_t SkeletalAnimationData::getSerializedRotationKeySize() const
     {
         return sizeof(float) + // time
-            sizeof(Quaternion); // rotation
+            (_quantizedRotations ? sizeof(PackedQuaternion) : sizeof(Quaternion)); // rotation
+    }
+
+    size_t SkeletalAnimationData::getSerializedScaleKeySize() const
+    {
+        return sizeof(float) + // time
+            sizeof(Vector3f); // scale
     }
 
-    // TODO: Add scale keys
     size_t SkeletalAnimationData::getSerializedJointAnimationDataSize(size_t jointIndex) const
     {
-        PLATYPUS_ASSERT(jointIndex < _keyframeData.size());
+        PLATYPUS_ASSERT(jointIndex < _jointKeyRanges.size());
+        const JointKeyRanges& keyRanges = _jointKeyRanges[jointIndex];
         return sizeof(uint32_t) + // translation key count
             sizeof(uint32_t) + // rotation key count
-            getSerializedTranslationKeySize() * _keyframeData[jointIndex].translations.size() +
-            getSerializedRotationKeySize() * _keyframeData[jointIndex].rotations.size();
+            sizeof(uint32_t) + // scale key count
+            getSerializedTranslationKeySize() * keyRanges.translations.count +
+            getSerializedRotationKeySize() * keyRanges.rotations.count +
+            getSerializedScaleKeySize() * keyRanges.scales.count;
     }
 
 
@@ -278,7 +536,7 @@ namespace platypus
 
     Skeleton::Skeleton(
         AssetManager* pAssetManager,
-        const std::vector<char>& targetBuffer,
+        const DataView& targetBuffer,
         size_t bufferPos
     ) :
         Asset(pAssetManager, targetBuffer, bufferPos)
@@ -371,6 +629,71 @@ namespace platypus
         return -1;
     }
 
+    JointMask Skeleton::getJointSubtreeMask(uint32_t rootJointIndex) const
+    {
+        JointMask mask = 0;
+        std::vector<uint32_t> toVisit = { rootJointIndex };
+        while (!toVisit.empty())
+        {
+            const uint32_t jointIndex = toVisit.back();
+            toVisit.pop_back();
+            if (jointIndex >= joint_mask_max_joints)
+            {
+                Debug::log(
+                    "Joint index " + std::to_string(jointIndex) + " doesn't fit in a JointMask",
+                    PLATYPUS_CURRENT_FUNC_NAME,
+                    Debug::MessageType::PLATYPUS_WARNING
+                );
+                continue;
+            }
+            mask |= static_cast<JointMask>(1) << jointIndex;
+            if (jointIndex < _jointChildMapping.size())
+                toVisit.insert(toVisit.end(), _jointChildMapping[jointIndex].begin(), _jointChildMapping[jointIndex].end());
+        }
+        return mask;
+    }
+
+    JointMask Skeleton::getJointDepthMask(uint32_t maxDepth) const
+    {
+        // Root joints are the ones not being anyone's child
+        std::vector<bool> isChild(_joints.size(), false);
+        for (const std::vector<uint32_t>& childIndices : _jointChildMapping)
+        {
+            for (uint32_t childIndex : childIndices)
+            {
+                if (childIndex < isChild.size())
+                    isChild[childIndex] = true;
+            }
+        }
+
+        JointMask mask = 0;
+        // Pair's first = joint index, second = depth
+        std::vector<std::pair<uint32_t, uint32_t>> toVisit;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(_joints.size()); ++i)
+        {
+            if (!isChild[i])
+                toVisit.push_back(std::make_pair(i, 0));
+        }
+        while (!toVisit.empty())
+        {
+            const uint32_t jointIndex = toVisit.back().first;
+            const uint32_t depth = toVisit.back().second;
+            toVisit.pop_back();
+            if (depth > maxDepth)
+                continue;
+
+            if (jointIndex < joint_mask_max_joints)
+                mask |= static_cast<JointMask>(1) << jointIndex;
+
+            if (jointIndex < _jointChildMapping.size())
+            {
+                for (uint32_t childIndex : _jointChildMapping[jointIndex])
+                    toVisit.push_back(std::make_pair(childIndex, depth + 1));
+            }
+        }
+        return mask;
+    }
+
     /*
         Serialized format:
             Asset serialized base data
@@ -470,6 +793,11 @@ namespace platypus
             sizeof(UUID_t) * _animationIDs.size();
     }
 
+    std::vector<UUID_t> Skeleton::getDependencies() const
+    {
+        return _animationIDs;
+    }
+
     size_t Skeleton::getSerializedJointSize(size_t jointIndex) const
     {
         PLATYPUS_ASSERT(jointIndex < _joints.size());
@@ -6,41 +6,123 @@
 
 namespace platypus
 {
+    // Written after the Asset base data, since the layout changed when the keys
+    // got stored per channel (quantized rotations and scale keys were added).
+    // NOTE: Animations serialized before this have no magic and are rejected.
+    constexpr uint32_t serialized_animation_magic = 0x4D494E41; // "ANIM"
+    constexpr uint32_t serialized_animation_version = 2;
+
     class SkeletalAnimationData : public Asset
     {
     private:
+        // Range of a single joint's keys in the key arrays below
+        struct KeyRange
+        {
+            uint32_t begin = 0;
+            uint32_t count = 0;
+        };
+
+        struct JointKeyRanges
+        {
+            KeyRange translations;
+            KeyRange rotations;
+            KeyRange scales;
+        };
+
         // NOTE: Previously had only KeyframeAnimationData member here
         float _length = 0.0f;
+
         // Indexing of these follows the bind pose's joints' indexing
         // which this animation is ment for.
-        std::vector<JointAnimationData> _keyframeData;
+        std::vector<JointKeyRanges> _jointKeyRanges;
+
+        // Keys of all joints. Times and values are stored separately so
+        // searching keys touches only the times.
+        std::vector<float> _translationTimes;
+        std::vector<Vector3f> _translations;
+        std::vector<float> _rotationTimes;
+        // Only one of these is used depending on _quantizedRotations
+        std::vector<Quaternion> _rotations;
+        std::vector<PackedQuaternion> _packedRotations;
+        bool _quantizedRotations = false;
+        std::vector<float> _scaleTimes;
+        std::vector<Vector3f> _scales;
+
+        // Pose at the beginning of the animation. Used as the reference
+        // when this animation is used as an additive layer.
+        std::vector<JointPose> _referencePoses;
 
     public:
         SkeletalAnimationData(
             size_t uuidPool,
-            const KeyframeAnimationData& animationData
+            const KeyframeAnimationData& animationData,
+            const AnimationCompression& compression = AnimationCompression()
         );
         SkeletalAnimationData(
             AssetManager* pAssetManager,
-            const std::vector<char>& targetBuffer,
+            const DataView& targetBuffer,
             size_t bufferPos
         );
         ~SkeletalAnimationData();
 
-        // Returns matrix containing the interpolated translation and rotation
-        // according to inputted time.
-        // TODO: Add scaling
-        // TODO: Optimize!
+        // Samples interpolated local translation, rotation and scale of joints
+        // [0, jointCount) at the given time into pOutPoses.
+        //
+        // If pCursors is provided (one for each joint), the keys found in
+        // the previous call are checked first and the cursors are updated.
+        // Otherwise the keys are found using binary search.
+        //
+        // Joints having no keys for some channel get the JointPose's default
+        // value for that channel. Joints not included in jointMask are left untouched.
+        void sampleJoints(
+            float time,
+            JointPose* pOutPoses,
+            size_t jointCount,
+            KeyframeCursor* pCursors = nullptr,
+            JointMask jointMask = joint_mask_all
+        ) const;
+
+        // Samples a single joint without cursors.
+        // NOTE: Prefer sampleJoints when sampling multiple joints
+        JointPose sampleJoint(float time, size_t jointIndex) const;
+
+        // Returns matrix containing the interpolated translation, rotation
+        // and scale according to inputted time.
+        // NOTE: Prefer sampleJoints when sampling the whole skeleton
         Matrix4f getBoneMatrix(float time, int boneIndex) const;
 
         virtual void serialize(std::vector<char>& targetBuffer) const override;
         virtual size_t getSerializedSize() const override;
 
         inline float getLength() const { return _length; }
+        inline size_t getJointCount() const { return _jointKeyRanges.size(); }
+        inline const JointPose* getReferencePoses() const { return _referencePoses.data(); }
+        inline bool hasQuantizedRotations() const { return _quantizedRotations; }
 
     private:
+        void addJointKeys(const JointAnimationData& jointAnimationData);
+
+        // Samples a single joint's translation and scale into outPose using and updating the cursor.
+        // Returns true if the rotation has to be interpolated from key outRotationKey to the next
+        // by outRotationAmount, otherwise outPose's rotation is sampled too.
+        // NOTE: Leaves the interpolation to the caller so sampleJoints can slerp in batches
+        bool sampleJointKeys(
+            float time,
+            size_t jointIndex,
+            KeyframeCursor& cursor,
+            JointPose& outPose,
+            uint32_t& outRotationKey,
+            float& outRotationAmount
+        ) const;
+
+        inline Quaternion getRotation(size_t keyIndex) const
+        {
+            return _quantizedRotations ? unpack_quaternion(_packedRotations[keyIndex]) : _rotations[keyIndex];
+        }
+
         size_t getSerializedTranslationKeySize() const;
         size_t getSerializedRotationKeySize() const;
+        size_t getSerializedScaleKeySize() const;
         size_t getSerializedJointAnimationDataSize(size_t jointIndex) const;
     };
 
@@ -64,7 +146,7 @@ namespace platypus
         );
         Skeleton(
             AssetManager* pAssetManager,
-            const std::vector<char>& targetBuffer,
+            const DataView& targetBuffer,
             size_t bufferPos
         );
         ~Skeleton();
@@ -72,8 +154,15 @@ namespace platypus
         // returns -1 if not found
         int32_t getAnimationIndex(const std::string& name) const;
 
+        // Returns mask containing the joint and all its descendants.
+        // Useful for layering animations for only some part of the skeleton.
+        JointMask getJointSubtreeMask(uint32_t rootJointIndex) const;
+        // Returns mask containing joints at most maxDepth levels below the root joints
+        JointMask getJointDepthMask(uint32_t maxDepth) const;
+
         virtual void serialize(std::vector<char>& targetBuffer) const override;
         virtual size_t getSerializedSize() const override;
+        virtual std::vector<UUID_t> getDependencies() const override;
 
         inline const std::vector<Joint>& getJoints() const { return _joints; }
         inline const std::vector<std::vector<uint32_t>>& getJointChildMapping() const { return _jointChildMapping; }
@@ -29,7 +29,7 @@ namespace platypus
 
     Texture::Texture(
         AssetManager* pAssetManager,
-        const std::vector<char>& targetBuffer,
+        const DataView& targetBuffer,
         size_t bufferPos
     ) :
         Asset(pAssetManager, targetBuffer, bufferPos)
@@ -77,6 +77,14 @@ namespace platypus
         _pSampler = pSampler;
         create(pImage);
 
+        // Bindless Materials sharing this texture keep its slot in the texture array
+        // -> the slot has to be rewritten or it would refer to the destroyed texture
+        MasterRenderer* pMasterRenderer = Application::get_instance()->getMasterRenderer();
+        // NOTE: Master renderer doesn't exist anymore if recreating at exit
+        BindlessMaterialTable* pBindlessMaterialTable = pMasterRenderer ? pMasterRenderer->getBindlessMaterialTable() : nullptr;
+        if (pBindlessMaterialTable)
+            pBindlessMaterialTable->refreshTexture(this);
+
         AssetManager* pAssetManager = Application::get_instance()->getAssetManager();
 
         // Update all materials using this texture so the texture change can take effect!
@@ -103,12 +111,10 @@ namespace platypus
                         PLATYPUS_CURRENT_FUNC_NAME,
                         Debug::MessageType::PLATYPUS_WARNING
                     );
-                    pMaterial->destroyPipelines();
-                    pMaterial->recreateExistingPipelines();
+                    pMaterial->releasePipelines();
                     pMaterial->destroyShaderResources();
                     pMaterial->createShaderResources();
 
-                    MasterRenderer* pMasterRenderer = Application::get_instance()->getMasterRenderer();
                     pMasterRenderer->getBatcher().freeBatches();
                     break;
                 }
@@ -177,6 +183,15 @@ namespace platypus
             sizeof(uint8_t); //  useMipmapping
     }
 
+    std::vector<UUID_t> Texture::getDependencies() const
+    {
+        // NOTE: Error image gets serialized as NULL_UUID (see serialize)
+        AssetManager* pAssetManager = Application::get_instance()->getAssetManager();
+        if (!_pImage || _pImage == pAssetManager->getErrorImage())
+            return { };
+        return { _pImage->getID() };
+    }
+
     void Texture::fixMaterialsOnDestruction()
     {
         // NOTE: Was unable to get this working properly when destroying "default assets".
@@ -98,7 +98,7 @@ namespace platypus
         );
         Texture(
             AssetManager* pAssetManager,
-            const std::vector<char>& targetBuffer,
+            const DataView& targetBuffer,
             size_t bufferPos
         );
         Texture(const Texture&) = delete;
@@ -125,6 +125,7 @@ namespace platypus
         ) const override;
 
         virtual size_t getSerializedSize() const override;
+        virtual std::vector<UUID_t> getDependencies() const override;
 
         inline const TextureImpl* getImpl() const { return _pImpl; }
         inline TextureImpl* getImpl() { return _pImpl; }
@@ -7,8 +7,10 @@
 #include "platypus/graphics/Device.hpp"
 #include "platypus/graphics/platform/desktop/DesktopDevice.hpp"
 #include "platypus/graphics/platform/desktop/DesktopCommandBuffer.hpp"
+#include "platypus/graphics/platform/desktop/DesktopUploadManager.hpp"
 #include "platypus/graphics/platform/desktop/DesktopContext.hpp"
 
+#include "platypus/utils/ImageDataUtils.hpp"
 #include "platypus/core/Debug.hpp"
 #include <vulkan/vk_enum_string_helper.h>
 #include <cmath>
@@ -80,36 +82,6 @@ namespace platypus
     }
 
 
-    static void transition_image_layout_immediate(
-        Texture* pTexture,
-        ImageLayout newLayout,
-        PipelineStage srcStage,
-        uint32_t srcAccessMask,
-        PipelineStage dstStage,
-        uint32_t dstAccessMask,
-        uint32_t mipLevelCount
-    )
-    {
-        CommandBuffer commandBuffer = Device::get_command_pool()->allocCommandBuffers(
-            1,
-            CommandBufferLevel::PRIMARY_COMMAND_BUFFER
-        )[0];
-        commandBuffer.beginSingleUse();
-
-        transition_image_layout(
-            commandBuffer,
-            pTexture,
-            newLayout,
-            srcStage,
-            srcAccessMask,
-            dstStage,
-            dstAccessMask,
-            mipLevelCount
-        );
-        commandBuffer.finishSingleUse();
-    }
-
-
     // NOTE: If formats' *_SRGB not supported by the device whole texture creation fails!
     // TODO: Query supported formats and handle depending on requested channels that way
     VkFormat to_vk_format(ImageFormat imageFormat)
@@ -237,6 +209,7 @@ namespace platypus
 
 
     static void generate_mipmaps(
+        CommandBuffer& commandBuffer,
         VkImage imageHandle,
         VkFormat imageFormat,
         int imgWidth,
@@ -245,11 +218,6 @@ namespace platypus
         VkFilter filterMode
     )
     {
-        CommandBuffer commandBuffer = Device::get_command_pool()->allocCommandBuffers(
-            1,
-            CommandBufferLevel::PRIMARY_COMMAND_BUFFER
-        )[0];
-        commandBuffer.beginSingleUse();
         VkCommandBuffer cmdBufferHandle = commandBuffer.getImpl()->handle;
 
         VkImageMemoryBarrier barrier{};
@@ -344,8 +312,6 @@ namespace platypus
             0, nullptr,
             1, &barrier
         );
-
-        commandBuffer.finishSingleUse();
     }
 
 
@@ -591,16 +557,6 @@ namespace platypus
             PLATYPUS_ASSERT(false);
         }
 
-        // NOTE: Not sure if our buffers can be used as staging buffers here without modifying?
-        Buffer* pStagingBuffer = new Buffer(
-            reinterpret_cast<const void*>(_pImage->getData()),
-            1, // Single element size is 8 bit "pixel"
-            _pImage->getSize(),
-            BufferUsageFlagBits::BUFFER_USAGE_TRANSFER_SRC_BIT,
-            BufferUpdateFrequency::BUFFER_UPDATE_FREQUENCY_STATIC,
-            false
-        );
-
         VkFormat vkImageFormat = to_vk_format(_imageFormat);
 
         // Using vkCmdBlit to create mipmaps, so make sure this is supported!
@@ -645,12 +601,14 @@ namespace platypus
 
         VkImageUsageFlags imageUsageFlags = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
         uint32_t mipLevelCount = 1;
+        // Uploading the image's own mip chain if it has one, instead of blitting
+        bool uploadMipChain = false;
         if (_pSampler->isMipmapped())
         {
-            mipLevelCount = (uint32_t)(std::floor(
-                std::log2(std::max(imageWidth, imageHeight))
-            )) + 1;
-            imageUsageFlags |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+            mipLevelCount = get_mip_level_count((int)imageWidth, (int)imageHeight);
+            uploadMipChain = _pImage->getMipLevelCount() == mipLevelCount;
+            if (!uploadMipChain)
+                imageUsageFlags |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
         }
 
         VkImageCreateInfo imageCreateInfo{};
@@ -699,49 +657,85 @@ namespace platypus
         _pImpl->vmaAllocation = vmaAllocation;
         _pImpl->imageLayout = imageCreateInfo.initialLayout;
 
-        transition_image_layout_immediate(
-            this, // NOTE: Potential DANGER!
-            ImageLayout::TRANSFER_DST_OPTIMAL,
-            PipelineStage::TOP_OF_PIPE_BIT,
-            0,
-            PipelineStage::TRANSFER_BIT,
-            MemoryAccessFlagBits::MEMORY_ACCESS_TRANSFER_WRITE_BIT,
-            mipLevelCount
-        );
-        copy_buffer_to_image(
-            pStagingBuffer->getImpl()->handle,
-            imageHandle,
-            imageWidth,
-            imageHeight
+        // Copy and mipmap generation are recorded into the current upload batch
+        // and finish before any frame submitted after this uses the texture.
+        // NOTE: Staging offset has to be a multiple of 4 and the texel size
+        const size_t stagingAlignment = 4 * (size_t)_pImage->getChannels();
+        const VkFilter mipmapFilter = to_vk_sampler_filter_mode(_pSampler->getFilterMode());
+        Device::get_impl()->pUploadManager->recordImageUpload(
+            reinterpret_cast<const void*>(_pImage->getData()),
+            uploadMipChain ? _pImage->getMipChainSize() : _pImage->getSize(),
+            stagingAlignment,
+            [&](CommandBuffer& commandBuffer, VkBuffer stagingBuffer, size_t stagingOffset)
+            {
+                transition_image_layout(
+                    commandBuffer,
+                    this, // NOTE: Potential DANGER!
+                    ImageLayout::TRANSFER_DST_OPTIMAL,
+                    PipelineStage::TOP_OF_PIPE_BIT,
+                    0,
+                    PipelineStage::TRANSFER_BIT,
+                    MemoryAccessFlagBits::MEMORY_ACCESS_TRANSFER_WRITE_BIT,
+                    mipLevelCount
+                );
+                if (uploadMipChain)
+                {
+                    // NOTE: Level offsets are multiples of the texel size, which is enough
+                    // for copies on the graphics queue
+                    for (uint32_t level = 0; level < mipLevelCount; ++level)
+                    {
+                        copy_buffer_to_image(
+                            commandBuffer,
+                            stagingBuffer,
+                            stagingOffset + (_pImage->getMipData(level) - _pImage->getData()),
+                            imageHandle,
+                            (uint32_t)get_mip_dimension((int)imageWidth, level),
+                            (uint32_t)get_mip_dimension((int)imageHeight, level),
+                            level
+                        );
+                    }
+                }
+                else
+                {
+                    copy_buffer_to_image(
+                        commandBuffer,
+                        stagingBuffer,
+                        stagingOffset,
+                        imageHandle,
+                        imageWidth,
+                        imageHeight
+                    );
+                }
+
+                if (mipLevelCount > 1 && !uploadMipChain)
+                {
+                    PLATYPUS_ASSERT(_pImpl->imageLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+                    generate_mipmaps(
+                        commandBuffer,
+                        imageHandle,
+                        vkImageFormat,
+                        imageWidth,
+                        imageHeight,
+                        mipLevelCount,
+                        mipmapFilter
+                    );
+                }
+                else
+                {
+                    transition_image_layout(
+                        commandBuffer,
+                        this, // NOTE: Potential DANGER!
+                        ImageLayout::SHADER_READ_ONLY_OPTIMAL,
+                        PipelineStage::TRANSFER_BIT,
+                        MemoryAccessFlagBits::MEMORY_ACCESS_TRANSFER_WRITE_BIT,
+                        PipelineStage::FRAGMENT_SHADER_BIT,
+                        MemoryAccessFlagBits::MEMORY_ACCESS_SHADER_READ_BIT,
+                        mipLevelCount
+                    );
+                }
+            }
         );
 
-        if (mipLevelCount > 1)
-        {
-            PLATYPUS_ASSERT(_pImpl->imageLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-            generate_mipmaps(
-                imageHandle,
-                vkImageFormat,
-                imageWidth,
-                imageHeight,
-                mipLevelCount,
-                to_vk_sampler_filter_mode(_pSampler->getFilterMode())
-            );
-        }
-        else
-        {
-            transition_image_layout_immediate(
-                this, // NOTE: Potential DANGER!
-                ImageLayout::SHADER_READ_ONLY_OPTIMAL,
-                PipelineStage::TRANSFER_BIT,
-                MemoryAccessFlagBits::MEMORY_ACCESS_TRANSFER_WRITE_BIT,
-                PipelineStage::FRAGMENT_SHADER_BIT,
-                MemoryAccessFlagBits::MEMORY_ACCESS_SHADER_READ_BIT,
-                mipLevelCount
-            );
-        }
-
-        delete pStagingBuffer;
-
         // NOTE: Possible issue here!
         // *We createsingle texture here for multiple descriptor sets.
         // *If want to create texture which is to be updated dynamically
@@ -1,6 +1,7 @@
 #include "platypus/assets/Texture.hpp"
 #include "WebTexture.hpp"
 #include "platypus/graphics/platform/web/WebContext.hpp"
+#include "platypus/utils/ImageDataUtils.hpp"
 #include "platypus/core/Debug.hpp"
 
 #include <GL/glew.h>
@@ -300,20 +301,39 @@ namespace platypus
         const int width = _pImage->getWidth();
         const int height = _pImage->getHeight();
 
+        // Uploading the image's own mip chain if it has one, instead of glGenerateMipmap
+        const bool uploadMipChain = _pSampler->isMipmapped() &&
+            _pImage->getMipLevelCount() == get_mip_level_count(width, height);
+        const uint32_t uploadLevelCount = uploadMipChain ? _pImage->getMipLevelCount() : 1;
+
         uint32_t glTextureID = 0;
         GL_FUNC(glGenTextures(1, &glTextureID));
         GL_FUNC(glBindTexture(GL_TEXTURE_2D, glTextureID));
-        GL_FUNC(glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            glInternalFormat,
-            width,
-            height,
-            0,
-            glFormat,
-            GL_UNSIGNED_BYTE,
-            reinterpret_cast<const void*>(_pImage->getData())
-        ));
+        // Rows of the smaller mip levels aren't 4 byte aligned
+        if (uploadMipChain)
+        {
+            GL_FUNC(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+        }
+
+        for (uint32_t level = 0; level < uploadLevelCount; ++level)
+        {
+            GL_FUNC(glTexImage2D(
+                GL_TEXTURE_2D,
+                level,
+                glInternalFormat,
+                get_mip_dimension(width, level),
+                get_mip_dimension(height, level),
+                0,
+                glFormat,
+                GL_UNSIGNED_BYTE,
+                reinterpret_cast<const void*>(_pImage->getMipData(level))
+            ));
+        }
+
+        if (uploadMipChain)
+        {
+            GL_FUNC(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+        }
 
         // Address mode
         switch (_pSampler->getAddressMode())
@@ -359,7 +379,10 @@ namespace platypus
                 GL_FUNC(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
             }
 
-            GL_FUNC(glGenerateMipmap(GL_TEXTURE_2D));
+            if (!uploadMipChain)
+            {
+                GL_FUNC(glGenerateMipmap(GL_TEXTURE_2D));
+            }
         }
         else
         {
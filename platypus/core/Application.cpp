@@ -22,6 +22,9 @@ namespace platypus
 
         pApp->getInputManager().pollEvents();
 
+        // Finalizing before the scene update, so the scene can use the loaded assets this frame
+        pApp->getAssetManager()->finalizeAsyncLoads();
+
         std::chrono::time_point<std::chrono::high_resolution_clock> sceneBeginTime = std::chrono::high_resolution_clock::now();
         sceneManager.update();
         std::chrono::time_point<std::chrono::high_resolution_clock> sceneEndTime = std::chrono::high_resolution_clock::now();
@@ -56,7 +59,8 @@ namespace platypus
     ) :
         _window(name, width, height, resizable, windowMode),
 
-        _inputManager(_window)
+        _inputManager(_window),
+        _jobSystem(JobSystem::get_default_worker_count())
     {
         if (s_pInstance)
         {
@@ -68,6 +72,7 @@ namespace platypus
             PLATYPUS_ASSERT(false);
         }
         s_pInstance = this;
+        std::chrono::time_point<std::chrono::high_resolution_clock> startupBeginTime = std::chrono::high_resolution_clock::now();
 
         Context::create(name.c_str(), &_window);
         Device::create(&_window, PLATYPUS_MAX_DESCRIPTOR_SETS);
@@ -112,6 +117,11 @@ namespace platypus
             );
         #endif
 
+        // NOTE: Most pipelines get created on demand when the first frames are
+        // rendered, so this doesn't include all pipeline creation
+        std::chrono::duration<float, std::milli> startupTime = std::chrono::high_resolution_clock::now() - startupBeginTime;
+        Debug::log("Application startup took: " + std::to_string(startupTime.count()) + " ms");
+
         _sceneManager.assignNextScene(pInitialScene);
         s_lastDisplayDelta = std::chrono::high_resolution_clock::now();
     }
@@ -2,6 +2,7 @@
 
 #include "Window.hpp"
 #include "InputManager.hpp"
+#include "JobSystem.hpp"
 #include "platypus/graphics/Context.hpp"
 #include "platypus/graphics/Swapchain.hpp"
 #include "platypus/graphics/renderers/MasterRenderer.hpp"
@@ -19,6 +20,7 @@ namespace platypus
         // Order of these is important for proper construction and destruction!
         Window _window;
         InputManager _inputManager;
+        JobSystem _jobSystem;
         // TODO: Fix these -> not supposed to be heap allocated?
         Swapchain* _pSwapchain = nullptr;
         AssetManager* _pAssetManager = nullptr;
@@ -44,6 +46,7 @@ namespace platypus
 
         inline Window& getWindow() { return _window; }
         inline InputManager& getInputManager() { return _inputManager; }
+        inline JobSystem& getJobSystem() { return _jobSystem; }
         inline SceneManager& getSceneManager() { return _sceneManager; }
         inline Swapchain* getSwapchain() { return _pSwapchain; }
         inline AssetManager* getAssetManager() { return _pAssetManager; }
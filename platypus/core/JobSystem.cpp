@@ -0,0 +1,264 @@
+#include "JobSystem.hpp"
+#include "Debug.hpp"
+
+#include <algorithm>
+
+
+namespace platypus
+{
+    // Index to JobSystem's _queues for the calling thread.
+    // Threads not created by the JobSystem use the queue 0.
+    static thread_local size_t s_queueIndex = 0;
+
+    JobSystem::JobSystem(size_t workerCount)
+    {
+        startWorkers(workerCount);
+    }
+
+    JobSystem::~JobSystem()
+    {
+        stopWorkers();
+    }
+
+    void JobSystem::submit(const Job& job, JobCounter* pCounter)
+    {
+        if (pCounter)
+            pCounter->value.fetch_add(1);
+
+        _queuedJobCount.fetch_add(1);
+        JobQueue* pQueue = _queues[s_queueIndex];
+        {
+            std::lock_guard<std::mutex> lock(pQueue->mutex);
+            pQueue->jobs.push_back({ job, pCounter });
+        }
+
+        if (!_workers.empty())
+        {
+            // Locking here so the notification can't get lost between the
+            // worker checking the condition and starting to wait
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+            _wakeCondition.notify_one();
+        }
+    }
+
+    void JobSystem::submitBackground(const Job& job, JobCounter* pCounter)
+    {
+        if (pCounter)
+            pCounter->value.fetch_add(1);
+
+        _queuedJobCount.fetch_add(1);
+        {
+            std::lock_guard<std::mutex> lock(_backgroundQueue.mutex);
+            _backgroundQueue.jobs.push_back({ job, pCounter });
+        }
+
+        if (!_workers.empty())
+        {
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+            _wakeCondition.notify_one();
+        }
+    }
+
+    void JobSystem::wait(JobCounter* pCounter)
+    {
+        while (pCounter->value.load() > 0)
+        {
+            if (executeNext(s_queueIndex))
+                continue;
+
+            // Without workers no one else would ever execute the background jobs
+            if (!(_workers.empty() && executeBackgroundJob()))
+                std::this_thread::yield();
+        }
+    }
+
+    bool JobSystem::executeBackgroundJob()
+    {
+        QueuedJob queuedJob;
+        {
+            std::lock_guard<std::mutex> lock(_backgroundQueue.mutex);
+            if (_backgroundQueue.jobs.empty())
+                return false;
+
+            queuedJob = std::move(_backgroundQueue.jobs.front());
+            _backgroundQueue.jobs.pop_front();
+        }
+
+        _queuedJobCount.fetch_sub(1);
+        queuedJob.job();
+        // Releasing the job's captures before signaling, so the waiting thread
+        // is the last one touching them
+        queuedJob.job = nullptr;
+        if (queuedJob.pCounter)
+            queuedJob.pCounter->value.fetch_sub(1);
+
+        return true;
+    }
+
+    void JobSystem::parallelFor(size_t count, size_t minChunkSize, const RangeJob& func)
+    {
+        if (count == 0)
+            return;
+
+        if (minChunkSize == 0)
+            minChunkSize = 1;
+
+        // Few chunks per thread so threads finishing early can steal the rest
+        const size_t maxChunks = (_workers.size() + 1) * 4;
+        size_t chunkCount = (count + minChunkSize - 1) / minChunkSize;
+        if (chunkCount > maxChunks)
+            chunkCount = maxChunks;
+
+        if (chunkCount <= 1 || _workers.empty())
+        {
+            func(0, count);
+            return;
+        }
+
+        const size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+        JobCounter counter;
+        // Executing the first chunk on this thread
+        for (size_t begin = chunkSize; begin < count; begin += chunkSize)
+        {
+            const size_t end = std::min(begin + chunkSize, count);
+            submit([&func, begin, end]() { func(begin, end); }, &counter);
+        }
+        func(0, std::min(chunkSize, count));
+        wait(&counter);
+    }
+
+    void JobSystem::setWorkerCount(size_t workerCount)
+    {
+        if (workerCount == _workers.size())
+            return;
+
+        stopWorkers();
+        startWorkers(workerCount);
+    }
+
+    size_t JobSystem::get_default_worker_count()
+    {
+        #ifdef PLATYPUS_BUILD_WEB
+            return 0;
+        #else
+            const size_t hardwareThreads = static_cast<size_t>(std::thread::hardware_concurrency());
+            return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+        #endif
+    }
+
+    void JobSystem::startWorkers(size_t workerCount)
+    {
+        #ifdef PLATYPUS_BUILD_WEB
+            if (workerCount > 0)
+            {
+                Debug::log(
+                    "Worker threads not supported on web build. "
+                    "Requested " + std::to_string(workerCount) + " workers, using 0",
+                    PLATYPUS_CURRENT_FUNC_NAME,
+                    Debug::MessageType::PLATYPUS_WARNING
+                );
+                workerCount = 0;
+            }
+        #endif
+
+        _queues.resize(workerCount + 1, nullptr);
+        for (size_t i = 0; i < _queues.size(); ++i)
+        {
+            if (!_queues[i])
+                _queues[i] = new JobQueue;
+        }
+
+        _running.store(true);
+        _workers.reserve(workerCount);
+        for (size_t i = 0; i < workerCount; ++i)
+            _workers.emplace_back(&JobSystem::workerLoop, this, i + 1);
+
+        Debug::log(
+            "Started " + std::to_string(workerCount) + " worker threads",
+            PLATYPUS_CURRENT_FUNC_NAME
+        );
+    }
+
+    void JobSystem::stopWorkers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+            _running.store(false);
+        }
+        _wakeCondition.notify_all();
+
+        for (std::thread& worker : _workers)
+            worker.join();
+        _workers.clear();
+
+        // Finish possible leftover jobs on this thread before destroying the queues
+        while (executeNext(0) || executeBackgroundJob())
+        {}
+
+        for (JobQueue* pQueue : _queues)
+            delete pQueue;
+        _queues.clear();
+    }
+
+    void JobSystem::workerLoop(size_t queueIndex)
+    {
+        s_queueIndex = queueIndex;
+        while (_running.load())
+        {
+            if (executeNext(queueIndex) || executeBackgroundJob())
+                continue;
+
+            std::unique_lock<std::mutex> lock(_wakeMutex);
+            _wakeCondition.wait(
+                lock,
+                [this]() { return !_running.load() || _queuedJobCount.load() > 0; }
+            );
+        }
+    }
+
+    bool JobSystem::executeNext(size_t queueIndex)
+    {
+        QueuedJob queuedJob;
+        if (!popLocal(queueIndex, queuedJob) && !steal(queueIndex, queuedJob))
+            return false;
+
+        _queuedJobCount.fetch_sub(1);
+        queuedJob.job();
+        // Releasing the job's captures before signaling, so the waiting thread
+        // is the last one touching them
+        queuedJob.job = nullptr;
+        if (queuedJob.pCounter)
+            queuedJob.pCounter->value.fetch_sub(1);
+
+        return true;
+    }
+
+    bool JobSystem::popLocal(size_t queueIndex, QueuedJob& outJob)
+    {
+        JobQueue* pQueue = _queues[queueIndex];
+        std::lock_guard<std::mutex> lock(pQueue->mutex);
+        if (pQueue->jobs.empty())
+            return false;
+
+        outJob = std::move(pQueue->jobs.back());
+        pQueue->jobs.pop_back();
+        return true;
+    }
+
+    bool JobSystem::steal(size_t queueIndex, QueuedJob& outJob)
+    {
+        const size_t queueCount = _queues.size();
+        for (size_t i = 1; i < queueCount; ++i)
+        {
+            JobQueue* pQueue = _queues[(queueIndex + i) % queueCount];
+            std::lock_guard<std::mutex> lock(pQueue->mutex);
+            if (pQueue->jobs.empty())
+                continue;
+
+            outJob = std::move(pQueue->jobs.front());
+            pQueue->jobs.pop_front();
+            return true;
+        }
+        return false;
+    }
+}
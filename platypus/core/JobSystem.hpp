@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+
+namespace platypus
+{
+    // Counts unfinished jobs submitted with it. JobSystem::wait() returns
+    // after the count reaches 0.
+    struct JobCounter
+    {
+        std::atomic<int32_t> value{ 0 };
+    };
+
+
+    // Thread pool running small jobs using work stealing.
+    //
+    // Each thread (including the thread that created the JobSystem) has its own
+    // job queue. Threads push and pop their own jobs from the back of their queue
+    // and steal from the front of others' queues when running out of work.
+    //
+    // Waiting threads help executing jobs instead of blocking, so jobs are
+    // allowed to submit and wait for other jobs.
+    //
+    // Long running jobs (file loading, decoding...) go to a separate background
+    // queue, which only the workers execute after running out of other work.
+    // This way a thread waiting for its frame's jobs never gets stuck executing those.
+    //
+    // With 0 workers everything gets executed by the waiting thread.
+    // NOTE: Web builds always use 0 workers!
+    class JobSystem
+    {
+    public:
+        typedef std::function<void()> Job;
+        // Called with range [begin, end)
+        typedef std::function<void(size_t, size_t)> RangeJob;
+
+    private:
+        struct QueuedJob
+        {
+            Job job;
+            JobCounter* pCounter = nullptr;
+        };
+
+        struct JobQueue
+        {
+            std::mutex mutex;
+            std::deque<QueuedJob> jobs;
+        };
+
+        std::vector<std::thread> _workers;
+        // Index 0 is for the thread that created the JobSystem,
+        // the rest for the workers
+        std::vector<JobQueue*> _queues;
+        JobQueue _backgroundQueue;
+
+        std::atomic<bool> _running{ false };
+        std::atomic<size_t> _queuedJobCount{ 0 };
+        std::mutex _wakeMutex;
+        std::condition_variable _wakeCondition;
+
+    public:
+        JobSystem(size_t workerCount);
+        JobSystem(const JobSystem& other) = delete;
+        ~JobSystem();
+
+        void submit(const Job& job, JobCounter* pCounter);
+        // Submits job to the background queue. See the class description.
+        void submitBackground(const Job& job, JobCounter* pCounter);
+        // Executes queued jobs until pCounter reaches 0
+        void wait(JobCounter* pCounter);
+
+        // Splits range [0, count) into chunks of at least minChunkSize and
+        // executes them across the workers. Returns after all chunks are done.
+        void parallelFor(size_t count, size_t minChunkSize, const RangeJob& func);
+
+        // Stops and recreates the worker threads.
+        // NOTE: Must not be called while jobs are being executed!
+        void setWorkerCount(size_t workerCount);
+
+        // Executes the oldest background job on the calling thread.
+        // Returns false if there was none.
+        // NOTE: Needed for making progress with background jobs when there are no workers!
+        bool executeBackgroundJob();
+
+        inline size_t getWorkerCount() const { return _workers.size(); }
+
+        // Hardware thread count - 1 (the main thread is working as well)
+        static size_t get_default_worker_count();
+
+    private:
+        void startWorkers(size_t workerCount);
+        void stopWorkers();
+        void workerLoop(size_t queueIndex);
+
+        // Returns false if no job was found from any queue
+        bool executeNext(size_t queueIndex);
+        bool popLocal(size_t queueIndex, QueuedJob& outJob);
+        bool steal(size_t queueIndex, QueuedJob& outJob);
+    };
+}
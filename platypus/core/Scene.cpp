@@ -11,6 +11,7 @@
 #include "platypus/ecs/systems/SkeletalAnimationSystem.hpp"
 #include "platypus/ecs/systems/TransformSystem.hpp"
 #include "platypus/ecs/systems/LightSystem.hpp"
+#include "platypus/ecs/systems/SpatialIndexSystem.hpp"
 
 
 namespace platypus
@@ -19,73 +20,38 @@ namespace platypus
         _entityHierarchyManager(this)
     {
         _entityUUIDPool = UUID::occupy_pool();
-        size_t maxPoolLength = 10000;
-        _componentPools[ComponentType::COMPONENT_TYPE_TRANSFORM] = new ComponentPool<Transform>(
-            sizeof(Transform),
-            maxPoolLength,
-            true
-        );
-        _componentPools[ComponentType::COMPONENT_TYPE_GUI_TRANSFORM] = new ComponentPool<GUITransform>(
-            sizeof(GUITransform),
-            maxPoolLength,
-            true
-        );
-        _componentPools[ComponentType::COMPONENT_TYPE_RENDERABLE3D] = new ComponentPool<Renderable3D>(
-            sizeof(Renderable3D),
-            maxPoolLength,
-            true
-        );
-        _componentPools[ComponentType::COMPONENT_TYPE_SKELETAL_ANIMATION] = new ComponentPool<SkeletalAnimation>(
-            sizeof(SkeletalAnimation),
-            maxPoolLength,
-            true
-        );
-        _componentPools[ComponentType::COMPONENT_TYPE_GUI_RENDERABLE] = new ComponentPool<GUIRenderable>(
-            sizeof(GUIRenderable),
-            maxPoolLength,
-            true
-        );
-        _componentPools[ComponentType::COMPONENT_TYPE_CAMERA] = new ComponentPool<Camera>(
-            sizeof(Camera),
-            1,
-            true
-        );
-        _componentPools[ComponentType::COMPONENT_TYPE_LIGHT] = new ComponentPool<Light>(
-            sizeof(Light),
-            1,
-            true
-        );
-        _componentPools[ComponentType::COMPONENT_TYPE_PARENT] = new ComponentPool<Parent>(
-            sizeof(Parent),
-            maxPoolLength,
-            true
-        );
-        _componentPools[ComponentType::COMPONENT_TYPE_CHILDREN] = new ComponentPool<Children>(
-            sizeof(Children),
-            maxPoolLength,
-            true
-        );
-        _componentPools[ComponentType::COMPONENT_TYPE_JOINT] = new ComponentPool<SkeletonJoint>(
-            sizeof(SkeletonJoint),
-            maxPoolLength,
-            true
-        );
-        _componentPools[ComponentType::COMPONENT_TYPE_TERRAIN] = new ComponentPool<Terrain>(
-            sizeof(Terrain),
-            1,
-            true
-        );
+        size_t initialPoolCapacity = 10000;
+        createComponentPool<Transform>(ComponentType::COMPONENT_TYPE_TRANSFORM, initialPoolCapacity);
+        createComponentPool<GUITransform>(ComponentType::COMPONENT_TYPE_GUI_TRANSFORM, initialPoolCapacity);
+        createComponentPool<Renderable3D>(ComponentType::COMPONENT_TYPE_RENDERABLE3D, initialPoolCapacity);
+        createComponentPool<SkeletalAnimation>(ComponentType::COMPONENT_TYPE_SKELETAL_ANIMATION, initialPoolCapacity);
+        createComponentPool<GUIRenderable>(ComponentType::COMPONENT_TYPE_GUI_RENDERABLE, initialPoolCapacity);
+        createComponentPool<Camera>(ComponentType::COMPONENT_TYPE_CAMERA, 1);
+        createComponentPool<Light>(ComponentType::COMPONENT_TYPE_LIGHT, 1);
+        createComponentPool<Parent>(ComponentType::COMPONENT_TYPE_PARENT, initialPoolCapacity);
+        createComponentPool<Children>(ComponentType::COMPONENT_TYPE_CHILDREN, initialPoolCapacity);
+        createComponentPool<SkeletonJoint>(ComponentType::COMPONENT_TYPE_JOINT, initialPoolCapacity);
+        createComponentPool<Terrain>(ComponentType::COMPONENT_TYPE_TERRAIN, 1);
 
         _systems.push_back(new SkeletalAnimationSystem);
         _systems.push_back(new TransformSystem);
         _systems.push_back(new LightSystem);
+        _systems.push_back(new SpatialIndexSystem);
+        _systemScheduler.build(_systems);
     }
 
     Scene::~Scene()
     {
-        std::unordered_map<ComponentType, MemoryPool*>::iterator poolIterator;
-        for (poolIterator = _componentPools.begin(); poolIterator != _componentPools.end(); ++poolIterator)
-            poolIterator->second->freeStorage();
+        for (size_t i = 0; i < max_component_types; ++i)
+        {
+            delete _componentPools[i];
+            _componentPools[i] = nullptr;
+        }
+
+        std::unordered_map<uint64_t, EntityQuery*>::iterator queryIt;
+        for (queryIt = _queries.begin(); queryIt != _queries.end(); ++queryIt)
+            delete queryIt->second;
+        _queries.clear();
 
         _entities.clear();
 
@@ -104,7 +70,15 @@ namespace platypus
             PLATYPUS_ASSERT(false);
             return nullptr;
         }
-        return _componentPools[componentType]->occupy(&target);
+        void* pComponent = getComponentPool(componentType)->occupy(target);
+        updateQueries(target);
+        return pComponent;
+    }
+
+    void Scene::addSystem(System* pSystem)
+    {
+        _systems.push_back(pSystem);
+        _systemScheduler.build(_systems);
     }
 
     entityID_t Scene::createEntity(const std::string& name, UUID_t explicitUUID)
@@ -214,6 +188,7 @@ namespace platypus
             if (_entities[entity].id != NULL_ENTITY_ID)
             {
                _entities[entity].active = arg;
+               markStructureChanged();
             }
             #ifdef PLATYPUS_DEBUG
             else
@@ -330,15 +305,15 @@ namespace platypus
         }
 
         // Destroy/free all this entity's components
-        std::unordered_map<ComponentType, MemoryPool*>::iterator poolsIt;
-        for (poolsIt = _componentPools.begin(); poolsIt != _componentPools.end(); ++poolsIt)
+        for (ComponentType componentType : get_all_component_types())
         {
-            if (_entities[entityID].componentMask & poolsIt->first)
-                poolsIt->second->clearStorage(&entityID);
+            if (_entities[entityID].componentMask & componentType)
+                getComponentPool(componentType)->clearStorage(entityID);
         }
         // Destroy/free entity itself
         _freeEntityIDs.push(entityID);
         _entities[entityID].clear(_entityUUIDPool);
+        updateQueries(entityID);
 
         // Free entity name
         std::unordered_map<entityID_t, std::string>::iterator nameIt = _entityNameMapping.find(entityID);
@@ -387,8 +362,9 @@ namespace platypus
             );
             PLATYPUS_ASSERT(false);
         }
-        _componentPools[componentType]->clearStorage(&entityID);
+        getComponentPool(componentType)->clearStorage(entityID);
         _entities[entityID].componentMask &= ~componentType;
+        updateQueries(entityID);
     }
 
     void* Scene::getComponent(ComponentType type, bool enableWarning)
@@ -398,7 +374,8 @@ namespace platypus
             PLATYPUS_ASSERT(false);
             return nullptr;
         }
-        if (_componentPools[type]->getOccupiedCount() == 0)
+        ComponentPoolBase* pPool = getComponentPool(type);
+        if (pPool->getOccupiedCount() == 0)
         {
             if (enableWarning)
             {
@@ -410,7 +387,7 @@ namespace platypus
             }
             return nullptr;
         }
-        return _componentPools[type]->any();
+        return pPool->any();
     }
 
     const void* Scene::getComponent(ComponentType type, bool enableWarning) const
@@ -420,8 +397,8 @@ namespace platypus
             PLATYPUS_ASSERT(false);
             return nullptr;
         }
-        std::unordered_map<ComponentType, MemoryPool*>::const_iterator it = _componentPools.find(type);
-        if (it->second->getOccupiedCount() == 0)
+        const ComponentPoolBase* pPool = getComponentPool(type);
+        if (pPool->getOccupiedCount() == 0)
         {
             if (enableWarning)
             {
@@ -433,7 +410,7 @@ namespace platypus
             }
             return nullptr;
         }
-        return it->second->any();
+        return pPool->any();
     }
 
     void* Scene::getComponent(
@@ -448,7 +425,8 @@ namespace platypus
             PLATYPUS_ASSERT(false);
             return nullptr;
         }
-        if (_componentPools.find(type) == _componentPools.end())
+        ComponentPoolBase* pPool = getComponentPool(type);
+        if (!pPool)
         {
             Debug::log(
                 "No component pool exists for component type: " + component_type_to_string(type),
@@ -460,9 +438,7 @@ namespace platypus
         }
         if ((_entities[entityID].componentMask & (uint64_t)type) == (uint64_t)type)
         {
-            // NOTE: Changed to using [] operator, below commented out previous way...
-            return _componentPools[type]->getElement(&entityID);
-            //return (Component*)componentPools[type].getComponent_DANGER(entityID);
+            return pPool->getElement(entityID);
         }
         if (!nestedSearch && enableWarning)
         {
@@ -492,8 +468,8 @@ namespace platypus
             PLATYPUS_ASSERT(false);
             return nullptr;
         }
-        std::unordered_map<ComponentType, MemoryPool*>::const_iterator poolIt = _componentPools.find(type);
-        if (poolIt == _componentPools.end())
+        const ComponentPoolBase* pPool = getComponentPool(type);
+        if (!pPool)
         {
             Debug::log(
                 "@Scene::getComponent (2) "
@@ -505,9 +481,7 @@ namespace platypus
         }
         if ((_entities[entityID].componentMask & (uint64_t)type) == (uint64_t)type)
         {
-            // NOTE: Changed to using [] operator, below commented out previous way...
-            return poolIt->second->getElement(&entityID);
-            //return (Component*)componentPools[type].getComponent_DANGER(entityID);
+            return pPool->getElement(entityID);
         }
         if (!nestedSearch && enableWarning)
         {
@@ -557,6 +531,7 @@ namespace platypus
             return;
         }
         entity.componentMask |= componentTypeID;
+        updateQueries(entityID);
     }
 
     void Scene::setComponentMask(entityID_t entityID, uint64_t mask)
@@ -578,9 +553,10 @@ namespace platypus
             PLATYPUS_ASSERT(false);
         }
         _entities[entityID].componentMask = mask;
+        updateQueries(entityID);
     }
 
-    bool Scene::isValidEntity(entityID_t entityID, const std::string& errLocation) const
+    bool Scene::isValidEntity(entityID_t entityID, const char* errLocation) const
     {
         bool success = true;
         if (entityID < 0 || entityID >= _entities.size())
@@ -589,7 +565,7 @@ namespace platypus
         if (!success)
         {
             Debug::log(
-                "@Scene::" + errLocation + " "
+                "@Scene::" + std::string(errLocation) + " "
                 "Invalid entityID: " + std::to_string(entityID),
                 Debug::MessageType::PLATYPUS_ERROR
             );
@@ -597,13 +573,13 @@ namespace platypus
         return success;
     }
 
-    bool Scene::isValidComponent(ComponentType type, const std::string& errLocation) const
+    bool Scene::isValidComponent(ComponentType type, const char* errLocation) const
     {
-        bool success = _componentPools.find(type) != _componentPools.end();
+        bool success = getComponentPool(type) != nullptr;
         if (!success)
         {
             Debug::log(
-                "@Scene::" + errLocation + " "
+                "@Scene::" + std::string(errLocation) + " "
                 "Invalid component type: " + component_type_to_string(type),
                 Debug::MessageType::PLATYPUS_ERROR
             );
@@ -742,7 +718,7 @@ namespace platypus
     }
 
     size_t Scene::deserializeHeader(
-        const std::vector<char>& serializedData,
+        const DataView& serializedData,
         size_t serializedDataPos,
         size_t* pEntityCount
     ) const
@@ -760,7 +736,7 @@ namespace platypus
     }
 
     entityID_t Scene::deserialize(
-        const std::vector<char>& serializedData,
+        const DataView& serializedData,
         size_t bufferReadPos,
         size_t& bufferReadEndPos
     )
@@ -836,7 +812,7 @@ namespace platypus
     }
 
     std::vector<entityID_t> Scene::deserialize(
-        const std::vector<char>& serializedData,
+        const DataView& serializedData,
         size_t serializedDataPos
     )
     {
@@ -978,4 +954,57 @@ namespace platypus
         _childrenComponentsToFinalize.clear();
         Debug::log("___TEST___Scene deserialization finalization finished!");
     }
+
+    EntityQuery* Scene::getQuery(uint64_t componentMask)
+    {
+        std::lock_guard<std::mutex> lock(_queryMutex);
+        std::unordered_map<uint64_t, EntityQuery*>::iterator it = _queries.find(componentMask);
+        if (it != _queries.end())
+            return it->second;
+
+        EntityQuery* pQuery = new EntityQuery;
+        pQuery->componentMask = componentMask;
+        for (const Entity& entity : _entities)
+        {
+            if (entity.id != NULL_ENTITY_ID && matchesQuery(entity.id, componentMask))
+                pQuery->add(entity.id);
+        }
+        _queries[componentMask] = pQuery;
+        return pQuery;
+    }
+
+    bool Scene::matchesQuery(entityID_t entityID, uint64_t componentMask) const
+    {
+        const Entity& entity = _entities[entityID];
+        if (entity.id == NULL_ENTITY_ID || (entity.componentMask & componentMask) != componentMask)
+            return false;
+
+        uint64_t remainingMask = componentMask;
+        while (remainingMask)
+        {
+            const ComponentType componentType = static_cast<ComponentType>(remainingMask & (~remainingMask + 1));
+            const ComponentPoolBase* pPool = getComponentPool(componentType);
+            if (!pPool || !pPool->contains(entityID))
+                return false;
+            remainingMask &= remainingMask - 1;
+        }
+        return true;
+    }
+
+    void Scene::updateQueries(entityID_t entityID)
+    {
+        markStructureChanged();
+
+        std::unordered_map<uint64_t, EntityQuery*>::iterator it;
+        for (it = _queries.begin(); it != _queries.end(); ++it)
+        {
+            EntityQuery* pQuery = it->second;
+            const bool matches = matchesQuery(entityID, pQuery->componentMask);
+            const bool included = pQuery->contains(entityID);
+            if (matches && !included)
+                pQuery->add(entityID);
+            else if (!matches && included)
+                pQuery->remove(entityID);
+        }
+    }
 }
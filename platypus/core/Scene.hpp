@@ -1,14 +1,19 @@
 ﻿#pragma once
 
 #include "platypus/ecs/Entity.hpp"
-#include "Memory.hpp"
 #include "platypus/ecs/components/Component.hpp"
+#include "platypus/ecs/components/ComponentPool.hpp"
+#include "platypus/ecs/View.hpp"
+#include "platypus/ecs/SpatialIndex.hpp"
 #include "platypus/ecs/systems/System.hpp"
+#include "platypus/ecs/systems/SystemScheduler.hpp"
 #include "platypus/utils/Maths.hpp"
+#include "platypus/utils/DataView.hpp"
 
 #include <unordered_map>
 #include <vector>
 #include <queue>
+#include <mutex>
 
 
 namespace platypus
@@ -21,6 +26,43 @@ namespace platypus
         Vector4f clearColor = Vector4f(0, 0, 1, 1);
     };
 
+    // Skeletal animation level of detail used for animations
+    // depending on their distance to the active camera
+    struct AnimationLODLevel
+    {
+        // Used from this distance onwards
+        float distance = 0.0f;
+        // Seconds between pose updates. 0 = every frame
+        float updateInterval = 0.0f;
+        // Joints deeper than this in the skeleton hierarchy keep their previous pose. -1 = all joints
+        int32_t maxJointDepth = -1;
+        // Pose doesn't get updated at all
+        bool frozen = false;
+    };
+
+    struct AnimationLODProperties
+    {
+        bool enabled = true;
+        // Need to be sorted by distance
+        std::vector<AnimationLODLevel> levels = {
+            { 0.0f, 0.0f, -1, false },
+            { 30.0f, 1.0f / 30.0f, -1, false },
+            { 60.0f, 1.0f / 15.0f, 3, false },
+            { 120.0f, 0.0f, -1, true }
+        };
+    };
+
+    // Skeletal animation counts of the previous update
+    struct AnimationStatistics
+    {
+        // Joints having their pose sampled
+        uint32_t evaluatedJointCount = 0;
+        // Animations having their pose updated
+        uint32_t updatedAnimationCount = 0;
+        // Animations skipped due to LOD
+        uint32_t skippedAnimationCount = 0;
+    };
+
     class Scene
     {
     private:
@@ -30,13 +72,20 @@ namespace platypus
         uint32_t _entityUUIDPool = 0;
 
         std::vector<System*> _systems;
+        SystemScheduler _systemScheduler;
         std::vector<Entity> _entities;
 
         std::unordered_map<entityID_t, std::string> _entityNameMapping;
 
         std::queue<entityID_t> _freeEntityIDs;
+        // Indexed using component_type_to_index()
         // NOTE: I don't like these being heap allocated, but want to get this just working for now...
-        std::unordered_map<ComponentType, MemoryPool*> _componentPools;
+        ComponentPoolBase* _componentPools[max_component_types] = { };
+
+        // Cached entity lists for views. key = required component mask
+        std::unordered_map<uint64_t, EntityQuery*> _queries;
+        // Systems may create views concurrently
+        std::mutex _queryMutex;
 
         std::unordered_map<UUID_t, std::vector<EntityError>> _entityErrors;
         const std::unordered_map<EntityErrorType, void(*)(Scene*, EntityError)> _entityErrorFixMapping = {
@@ -47,18 +96,36 @@ namespace platypus
 
         entityID_t _activeCameraEntity = NULL_ENTITY_ID;
 
+        AnimationStatistics _animationStatistics;
+
+        // World space bounds of Renderable3Ds, updated by SpatialIndexSystem
+        SpatialIndex _spatialIndex;
+
+        // Incremented whenever entities' components, hierarchies or active states change.
+        // Allows systems to cache things like component pointers until this changes.
+        uint64_t _structureVersion = 0;
+
         // Needed for Parent and Children components' deserialization
         std::unordered_map<entityID_t, UUID_t> _parentComponentsToFinalize;
         std::unordered_map<entityID_t, std::vector<UUID_t>> _childrenComponentsToFinalize;
 
     public:
         EnvironmentProperties environmentProperties;
+        AnimationLODProperties animationLODProperties;
 
         Scene();
         virtual ~Scene();
 
         void* allocateComponent(entityID_t target, ComponentType componentType);
 
+        // Scene takes the ownership of the system
+        void addSystem(System* pSystem);
+        inline const SystemScheduler& getSystemScheduler() const { return _systemScheduler; }
+        inline const AnimationStatistics& getAnimationStatistics() const { return _animationStatistics; }
+        inline AnimationStatistics& accessAnimationStatistics() { return _animationStatistics; }
+        inline const SpatialIndex& getSpatialIndex() const { return _spatialIndex; }
+        inline SpatialIndex& accessSpatialIndex() { return _spatialIndex; }
+
         entityID_t createEntity(const std::string& name = "", UUID_t explicitUUID = NULL_UUID);
         Entity getEntity(entityID_t entity) const;
         Entity getEntity(UUID_t entityUUID) const;
@@ -91,11 +158,37 @@ namespace platypus
 
         std::unordered_map<ComponentType, const void*> getComponents(entityID_t entityID) const;
 
+        // Allows iterating all components of some type directly
+        // Returns nullptr if no pool exists for the type
+        inline ComponentPoolBase* getComponentPool(ComponentType type)
+        {
+            return type != ComponentType::COMPONENT_TYPE_EMPTY ? _componentPools[component_type_to_index(type)] : nullptr;
+        }
+        inline const ComponentPoolBase* getComponentPool(ComponentType type) const
+        {
+            return type != ComponentType::COMPONENT_TYPE_EMPTY ? _componentPools[component_type_to_index(type)] : nullptr;
+        }
+
+        // Returns view to all entities having all components Ts...
+        //  -> for example: pScene->view<Transform, Renderable3D>().each(...)
+        // The matching entities are cached on first call and kept up to date
+        // when components get added or removed.
+        template <typename ...Ts>
+        View<Ts...> view()
+        {
+            const uint64_t componentMask = (static_cast<uint64_t>(get_component_type<Ts>()) | ...);
+            return View<Ts...>(
+                getQuery(componentMask),
+                &_entities,
+                static_cast<ComponentPool<Ts>*>(getComponentPool(get_component_type<Ts>()))...
+            );
+        }
+
         void addToComponentMask(entityID_t entityID, ComponentType componentType);
         void setComponentMask(entityID_t entityID, uint64_t mask);
         // @param errLocation This can be used to tell what func caused this to error
-        bool isValidEntity(entityID_t entityID, const std::string& errLocation) const;
-        bool isValidComponent(ComponentType, const std::string& errLocation) const;
+        bool isValidEntity(entityID_t entityID, const char* errLocation) const;
+        bool isValidComponent(ComponentType, const char* errLocation) const;
 
         void setActiveCameraEntity(entityID_t entityID);
 
@@ -123,7 +216,7 @@ namespace platypus
         // Returns the position after the header in serializedData
         // (the "actual position", including the entered serializedDataPos)
         size_t deserializeHeader(
-            const std::vector<char>& serializedData,
+            const DataView& serializedData,
             size_t serializedDataPos,
             size_t* pEntityCount
         ) const;
@@ -132,13 +225,13 @@ namespace platypus
         // Creates scene according to inputted serialized buffer.
         // NOTE: The input buffer here is currently intended to contain all assets as well
         entityID_t deserialize(
-            const std::vector<char>& serializedData,
+            const DataView& serializedData,
             size_t bufferReadPos,
             size_t& bufferReadEndPos
         );
 
         std::vector<entityID_t> deserialize(
-            const std::vector<char>& serializedData,
+            const DataView& serializedData,
             size_t serializedDataPos
         );
 
@@ -148,7 +241,24 @@ namespace platypus
         virtual void update() = 0;
 
         inline entityID_t getActiveCameraEntity() const { return _activeCameraEntity; }
+        inline void markStructureChanged() { ++_structureVersion; }
+        inline uint64_t getStructureVersion() const { return _structureVersion; }
         inline EntityHierarchyManager& getEntityHierarchyManager() { return _entityHierarchyManager; }
         inline const EntityHierarchyManager& getEntityHierarchyManager() const { return _entityHierarchyManager; }
+
+    private:
+        template <typename T>
+        void createComponentPool(ComponentType type, size_t initialCapacity)
+        {
+            _componentPools[component_type_to_index(type)] = new ComponentPool<T>(initialCapacity);
+        }
+
+        // Creates the query and fills it with existing matching entities, if not created yet
+        EntityQuery* getQuery(uint64_t componentMask);
+        // Entity's component mask needs to match and all the components need to be
+        // allocated for the entity to be included in a query
+        bool matchesQuery(entityID_t entityID, uint64_t componentMask) const;
+        // Adds or removes entity from the queries after its' components have changed
+        void updateQueries(entityID_t entityID);
     };
 }
@@ -27,13 +27,12 @@ namespace platypus
 
         _pCurrentScene->update();
 
+        Application* pApp = Application::get_instance();
+
         // Update all systems of the scene
         // NOTE: Not actually sure should system updates happen befor or after the scene's update?
-        for (System* system : _pCurrentScene->_systems)
-            system->update(_pCurrentScene);
-
+        _pCurrentScene->_systemScheduler.update(_pCurrentScene, pApp->getJobSystem());
 
-        Application* pApp = Application::get_instance();
         MasterRenderer* pMasterRenderer = pApp->getMasterRenderer();
 
         // Reset Batcher for next round of submits!
@@ -48,11 +47,7 @@ namespace platypus
         // Submit all "renderable components" for rendering.
         // NOTE: This has to be done here since need quarantee that all necessary components have been
         // properly updated before submission!
-        for (const Entity& entity : _pCurrentScene->_entities)
-        {
-            if (entity.id != NULL_ENTITY_ID && entity.active)
-                pMasterRenderer->submit(_pCurrentScene, entity);
-        }
+        pMasterRenderer->submit(_pCurrentScene);
 
 
         // CONTINUE HERE!
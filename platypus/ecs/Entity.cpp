@@ -231,6 +231,7 @@ namespace platypus
 
     int32_t EntityHierarchyManager::occupyRange(const std::vector<entityID_t>& childEntities)
     {
+        _pScene->markStructureChanged();
         // Check first if suitable free range already exists
         int32_t offset = findFreeRange(childEntities.size());
         const size_t childCount = childEntities.size();
@@ -273,6 +274,7 @@ namespace platypus
 
     void EntityHierarchyManager::freeRange(int32_t offset, size_t count)
     {
+        _pScene->markStructureChanged();
         PLATYPUS_ASSERT(offset >= 0);
         if (offset + count > _childrenContainer.size())
         {
@@ -300,6 +302,7 @@ namespace platypus
         entityID_t childEntityID
     )
     {
+        _pScene->markStructureChanged();
         const int32_t currentOffset = pChildren->offset;
         const size_t currentCount = pChildren->count;
 
@@ -361,6 +364,7 @@ namespace platypus
         entityID_t childEntityID
     )
     {
+        _pScene->markStructureChanged();
         const int32_t currentOffset = pChildren->offset;
         const size_t currentCount = pChildren->count;
         PLATYPUS_ASSERT(currentOffset >= 0);
@@ -0,0 +1,281 @@
+#include "SpatialIndex.hpp"
+#include "platypus/core/Debug.hpp"
+#include <algorithm>
+
+
+namespace platypus
+{
+    // Updates an entity's bounds need to stay the same to be moved to the static tree
+    static const uint32_t s_staticFrameThreshold = 60;
+    // Static tree is rebuilt when this fraction of its items have been
+    // removed or are waiting to be added (or the interval has passed and there are any such items)
+    static const float s_staticRebuildThreshold = 0.1f;
+    static const size_t s_staticMinRebuildChanges = 32;
+    static const size_t s_staticRebuildInterval = 600;
+    static const size_t s_dynamicRebuildInterval = 30;
+
+    static inline bool aabbs_equal(const AABB& a, const AABB& b)
+    {
+        return a.min.x == b.min.x && a.min.y == b.min.y && a.min.z == b.min.z &&
+            a.max.x == b.max.x && a.max.y == b.max.y && a.max.z == b.max.z;
+    }
+
+    void SpatialIndex::update(
+        const entityID_t* pEntities,
+        const AABB* pBounds,
+        size_t count,
+        bool entitiesChanged
+    )
+    {
+        ++_updateCount;
+        _statistics.movedEntityCount = 0;
+        _statistics.staticTreeRebuilt = false;
+        _statistics.dynamicTreeRebuilt = false;
+
+        // On the first update everything goes straight to the static tree
+        const bool initialBuild = _staticTree.empty() && _dynamicTree.empty();
+        bool rebuildStatic = false;
+        bool rebuildDynamic = false;
+
+        auto removeRecord = [&](EntityRecord& record)
+        {
+            if (record.tree == TreeType::STATIC)
+            {
+                _staticTree.setItemBounds(record.itemIndex, AABB());
+                ++_staticRemovedCount;
+            }
+            else if (record.tree == TreeType::DYNAMIC)
+            {
+                rebuildDynamic = true;
+            }
+            record.tree = TreeType::NONE;
+        };
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const entityID_t entity = pEntities[i];
+            const AABB& bounds = pBounds[i];
+            if (entity < 0)
+                continue;
+
+            if ((size_t)entity >= _records.size())
+                _records.resize((size_t)entity + 1);
+
+            EntityRecord& record = _records[entity];
+            record.lastUpdate = _updateCount;
+            if (!bounds.isValid())
+            {
+                if (record.tree != TreeType::NONE)
+                    removeRecord(record);
+                continue;
+            }
+
+            if (record.tree == TreeType::NONE)
+            {
+                record.bounds = bounds;
+                record.lastChange = _updateCount;
+                if (initialBuild)
+                {
+                    record.tree = TreeType::STATIC;
+                    rebuildStatic = true;
+                }
+                else
+                {
+                    record.tree = TreeType::DYNAMIC;
+                    rebuildDynamic = true;
+                }
+                continue;
+            }
+
+            if (aabbs_equal(record.bounds, bounds))
+                continue;
+
+            ++_statistics.movedEntityCount;
+            record.bounds = bounds;
+            record.lastChange = _updateCount;
+            if (record.tree == TreeType::STATIC)
+            {
+                // Removed from the static tree without rebuilding it
+                _staticTree.setItemBounds(record.itemIndex, AABB());
+                ++_staticRemovedCount;
+                record.tree = TreeType::DYNAMIC;
+                rebuildDynamic = true;
+            }
+            else
+            {
+                _dynamicTree.setItemBounds(record.itemIndex, bounds);
+            }
+        }
+
+        // Remove entities which weren't included anymore
+        if (entitiesChanged)
+        {
+            for (EntityRecord& record : _records)
+            {
+                if (record.tree != TreeType::NONE && record.lastUpdate != _updateCount)
+                    removeRecord(record);
+            }
+        }
+
+        // Only dynamic entities can be promoted to the static tree
+        // -> no need to visit entities that weren't given this frame
+        _staticPromotableCount = 0;
+        for (size_t i = 0; i < _dynamicTree.getItemCount(); ++i)
+        {
+            const EntityRecord& record = _records[_dynamicTree.getItemID(i)];
+            if (record.tree == TreeType::DYNAMIC && _updateCount - record.lastChange >= s_staticFrameThreshold)
+                ++_staticPromotableCount;
+        }
+
+        ++_framesSinceStaticRebuild;
+        const size_t staticChanges = _staticRemovedCount + _staticPromotableCount;
+        if (!rebuildStatic && staticChanges > 0)
+        {
+            const size_t rebuildThreshold = std::max(
+                s_staticMinRebuildChanges,
+                (size_t)((float)_staticTree.getItemCount() * s_staticRebuildThreshold)
+            );
+            rebuildStatic = staticChanges >= rebuildThreshold || _framesSinceStaticRebuild >= s_staticRebuildInterval;
+        }
+
+        if (rebuildStatic)
+        {
+            if (_staticPromotableCount > 0)
+            {
+                for (size_t i = 0; i < _dynamicTree.getItemCount(); ++i)
+                {
+                    EntityRecord& record = _records[_dynamicTree.getItemID(i)];
+                    if (record.tree == TreeType::DYNAMIC && _updateCount - record.lastChange >= s_staticFrameThreshold)
+                        record.tree = TreeType::STATIC;
+                }
+                _staticPromotableCount = 0;
+                rebuildDynamic = true;
+            }
+            rebuildTree(TreeType::STATIC);
+        }
+        else
+        {
+            _staticTree.refit();
+        }
+
+        ++_framesSinceDynamicRebuild;
+        if (rebuildDynamic || _framesSinceDynamicRebuild >= s_dynamicRebuildInterval)
+            rebuildTree(TreeType::DYNAMIC);
+        else
+            _dynamicTree.refit();
+
+        _statistics.staticEntityCount = _staticTree.getItemCount() - _staticRemovedCount;
+        _statistics.dynamicEntityCount = _dynamicTree.getItemCount();
+    }
+
+    void SpatialIndex::clear()
+    {
+        _staticTree.clear();
+        _dynamicTree.clear();
+        _records.clear();
+        _staticRemovedCount = 0;
+        _staticPromotableCount = 0;
+        _framesSinceStaticRebuild = 0;
+        _framesSinceDynamicRebuild = 0;
+        _statistics = SpatialIndexStatistics();
+    }
+
+    void SpatialIndex::queryFrustum(const Frustum& frustum, std::vector<entityID_t>& outEntities) const
+    {
+        std::vector<uint32_t> itemIDs;
+        _staticTree.queryFrustum(frustum, itemIDs);
+        _dynamicTree.queryFrustum(frustum, itemIDs);
+        outEntities.insert(outEntities.end(), itemIDs.begin(), itemIDs.end());
+    }
+
+    void SpatialIndex::queryAABB(const AABB& aabb, std::vector<entityID_t>& outEntities) const
+    {
+        std::vector<uint32_t> itemIDs;
+        _staticTree.queryAABB(aabb, itemIDs);
+        _dynamicTree.queryAABB(aabb, itemIDs);
+        outEntities.insert(outEntities.end(), itemIDs.begin(), itemIDs.end());
+    }
+
+    void SpatialIndex::querySphere(const BoundingSphere& sphere, std::vector<entityID_t>& outEntities) const
+    {
+        std::vector<uint32_t> itemIDs;
+        _staticTree.querySphere(sphere, itemIDs);
+        _dynamicTree.querySphere(sphere, itemIDs);
+        outEntities.insert(outEntities.end(), itemIDs.begin(), itemIDs.end());
+    }
+
+    void SpatialIndex::queryRay(
+        const Vector3f& origin,
+        const Vector3f& direction,
+        float maxDistance,
+        std::vector<RayQueryHit>& outHits
+    ) const
+    {
+        const size_t firstHit = outHits.size();
+        _staticTree.queryRay(origin, direction, maxDistance, outHits);
+        const size_t firstDynamicHit = outHits.size();
+        _dynamicTree.queryRay(origin, direction, maxDistance, outHits);
+        // Both trees' hits are sorted already
+        std::inplace_merge(
+            outHits.begin() + firstHit,
+            outHits.begin() + firstDynamicHit,
+            outHits.end(),
+            [](const RayQueryHit& a, const RayQueryHit& b) { return a.distance < b.distance; }
+        );
+    }
+
+    bool SpatialIndex::contains(entityID_t entity) const
+    {
+        return entity >= 0 && (size_t)entity < _records.size() && _records[entity].tree != TreeType::NONE;
+    }
+
+    const AABB* SpatialIndex::getBounds(entityID_t entity) const
+    {
+        if (!contains(entity))
+            return nullptr;
+        return &_records[entity].bounds;
+    }
+
+    void SpatialIndex::rebuildTree(TreeType treeType)
+    {
+        _buildBounds.clear();
+        _buildIDs.clear();
+        // Records are indexed by entityID_t
+        for (size_t entity = 0; entity < _records.size(); ++entity)
+        {
+            EntityRecord& record = _records[entity];
+            if (record.tree != treeType)
+                continue;
+
+            if (entity > UINT32_MAX)
+            {
+                Debug::log(
+                    "Entity ID: " + std::to_string(entity) + " too large for the spatial index",
+                    PLATYPUS_CURRENT_FUNC_NAME,
+                    Debug::MessageType::PLATYPUS_ERROR
+                );
+                PLATYPUS_ASSERT(false);
+                record.tree = TreeType::NONE;
+                continue;
+            }
+
+            record.itemIndex = (uint32_t)_buildIDs.size();
+            _buildBounds.push_back(record.bounds);
+            _buildIDs.push_back((uint32_t)entity);
+        }
+
+        if (treeType == TreeType::STATIC)
+        {
+            _staticTree.build(_buildBounds.data(), _buildIDs.data(), _buildIDs.size());
+            _staticRemovedCount = 0;
+            _framesSinceStaticRebuild = 0;
+            _statistics.staticTreeRebuilt = true;
+        }
+        else
+        {
+            _dynamicTree.build(_buildBounds.data(), _buildIDs.data(), _buildIDs.size());
+            _framesSinceDynamicRebuild = 0;
+            _statistics.dynamicTreeRebuilt = true;
+        }
+    }
+}
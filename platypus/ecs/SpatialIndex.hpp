@@ -0,0 +1,112 @@
+#pragma once
+
+#include "platypus/ecs/Entity.hpp"
+#include "platypus/utils/BVH.hpp"
+#include <vector>
+
+
+namespace platypus
+{
+    struct SpatialIndexStatistics
+    {
+        size_t staticEntityCount = 0;
+        size_t dynamicEntityCount = 0;
+        // Counts of the previous update
+        size_t movedEntityCount = 0;
+        bool staticTreeRebuilt = false;
+        bool dynamicTreeRebuilt = false;
+    };
+
+    // World space bounds of entities for frustum, AABB, sphere and ray queries.
+    //
+    // Entities are kept in two BVHs:
+    //  * Static tree for entities whose bounds haven't changed in a while.
+    //    Rebuilt rarely, only after enough entities have been added to or removed from it.
+    //  * Dynamic tree for moving and newly added entities.
+    //    Refitted each frame and rebuilt when its entities change or periodically to keep
+    //    its quality from degrading.
+    // Static entities that start moving are removed from the static tree (without rebuilding it)
+    // and moved to the dynamic tree. Dynamic entities that stay still long enough get moved to
+    // the static tree on its next rebuild.
+    //
+    // Owned by the Scene and kept up to date by the SpatialIndexSystem.
+    class SpatialIndex
+    {
+    public:
+        enum class TreeType : uint8_t
+        {
+            NONE,
+            STATIC,
+            DYNAMIC
+        };
+
+    private:
+        struct EntityRecord
+        {
+            AABB bounds;
+            // Index to the tree's items
+            uint32_t itemIndex = 0;
+            // Update count when the bounds were last changed
+            uint64_t lastChange = 0;
+            uint64_t lastUpdate = 0;
+            TreeType tree = TreeType::NONE;
+        };
+
+        BVH _staticTree;
+        BVH _dynamicTree;
+        // Indexed by entityID_t
+        std::vector<EntityRecord> _records;
+
+        // Changes to the static tree since it was built
+        size_t _staticRemovedCount = 0;
+        size_t _staticPromotableCount = 0;
+        size_t _framesSinceStaticRebuild = 0;
+        size_t _framesSinceDynamicRebuild = 0;
+        uint64_t _updateCount = 0;
+
+        SpatialIndexStatistics _statistics;
+
+        // Used when building the trees
+        std::vector<AABB> _buildBounds;
+        std::vector<uint32_t> _buildIDs;
+
+    public:
+        SpatialIndex() = default;
+        SpatialIndex(const SpatialIndex& other) = delete;
+
+        // Updates bounds of the given entities. Entities not included keep their previous bounds,
+        // so only the changed entities need to be given each frame.
+        // Entities with invalid bounds get removed. If entitiesChanged, all entities to keep
+        // indexed have to be given and the ones that were indexed but aren't included get removed.
+        void update(
+            const entityID_t* pEntities,
+            const AABB* pBounds,
+            size_t count,
+            bool entitiesChanged
+        );
+        void clear();
+
+        // Query results get appended to the out vectors
+        void queryFrustum(const Frustum& frustum, std::vector<entityID_t>& outEntities) const;
+        void queryAABB(const AABB& aabb, std::vector<entityID_t>& outEntities) const;
+        void querySphere(const BoundingSphere& sphere, std::vector<entityID_t>& outEntities) const;
+        // Hits are sorted by distance, itemIDs of the hits are the entities
+        void queryRay(
+            const Vector3f& origin,
+            const Vector3f& direction,
+            float maxDistance,
+            std::vector<RayQueryHit>& outHits
+        ) const;
+
+        bool contains(entityID_t entity) const;
+        // Returns nullptr if the entity isn't indexed
+        const AABB* getBounds(entityID_t entity) const;
+
+        inline const SpatialIndexStatistics& getStatistics() const { return _statistics; }
+        inline const BVH& getStaticTree() const { return _staticTree; }
+        inline const BVH& getDynamicTree() const { return _dynamicTree; }
+
+    private:
+        void rebuildTree(TreeType treeType);
+    };
+}
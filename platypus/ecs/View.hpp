@@ -0,0 +1,115 @@
+#pragma once
+
+#include "platypus/ecs/Entity.hpp"
+#include "platypus/ecs/components/ComponentPool.hpp"
+
+#include <vector>
+#include <tuple>
+
+
+namespace platypus
+{
+    // Cached list of entities having all components of the componentMask.
+    // Owned by the Scene which keeps the list up to date whenever entities'
+    // components get added or removed, so the list doesn't need to be
+    // rebuilt when iterating.
+    struct EntityQuery
+    {
+        uint64_t componentMask = 0;
+        std::vector<entityID_t> entities;
+        // Index to entities for each entityID_t or -1 if not included
+        std::vector<int32_t> entityIndices;
+
+        inline bool contains(entityID_t entity) const
+        {
+            const size_t index = static_cast<size_t>(entity);
+            return index < entityIndices.size() && entityIndices[index] != -1;
+        }
+
+        void add(entityID_t entity)
+        {
+            const size_t index = static_cast<size_t>(entity);
+            if (index >= entityIndices.size())
+                entityIndices.resize(index + 1, -1);
+            entityIndices[index] = static_cast<int32_t>(entities.size());
+            entities.push_back(entity);
+        }
+
+        void remove(entityID_t entity)
+        {
+            const size_t index = static_cast<size_t>(entity);
+            const int32_t removeIndex = entityIndices[index];
+            const entityID_t lastEntity = entities.back();
+            entities[removeIndex] = lastEntity;
+            entityIndices[static_cast<size_t>(lastEntity)] = removeIndex;
+            entities.pop_back();
+            entityIndices[index] = -1;
+        }
+    };
+
+
+    // Typed access to all entities having components Ts...
+    //
+    // Created using Scene::view<Ts...>(). Lookups go straight to the
+    // component pools' dense storages without void* getComponent calls.
+    //
+    // NOTE: Don't add or destroy components of the viewed types while iterating!
+    template <typename ...Ts>
+    class View
+    {
+    private:
+        const EntityQuery* _pQuery = nullptr;
+        const std::vector<Entity>* _pSceneEntities = nullptr;
+        std::tuple<ComponentPool<Ts>*...> _pools;
+
+    public:
+        View(
+            const EntityQuery* pQuery,
+            const std::vector<Entity>* pSceneEntities,
+            ComponentPool<Ts>*... pPools
+        ) :
+            _pQuery(pQuery),
+            _pSceneEntities(pSceneEntities),
+            _pools(pPools...)
+        {}
+
+        // Calls func(entityID_t, Ts&...) for each active entity
+        template <typename Func>
+        void each(Func func)
+        {
+            const std::vector<Entity>& sceneEntities = *_pSceneEntities;
+            for (entityID_t entity : _pQuery->entities)
+            {
+                if (!sceneEntities[entity].active)
+                    continue;
+                func(entity, *std::get<ComponentPool<Ts>*>(_pools)->get(entity)...);
+            }
+        }
+
+        // Same as each() but only for entities [begin, end) of getEntities().
+        // Used for splitting views into chunks with JobSystem::parallelFor
+        template <typename Func>
+        void each(size_t begin, size_t end, Func func)
+        {
+            const std::vector<Entity>& sceneEntities = *_pSceneEntities;
+            const std::vector<entityID_t>& entities = _pQuery->entities;
+            for (size_t i = begin; i < end; ++i)
+            {
+                const entityID_t entity = entities[i];
+                if (!sceneEntities[entity].active)
+                    continue;
+                func(entity, *std::get<ComponentPool<Ts>*>(_pools)->get(entity)...);
+            }
+        }
+
+        template <typename T>
+        inline T& get(entityID_t entity)
+        {
+            return *std::get<ComponentPool<T>*>(_pools)->get(entity);
+        }
+
+        // Includes also inactive entities!
+        inline const std::vector<entityID_t>& getEntities() const { return _pQuery->entities; }
+        inline size_t size() const { return _pQuery->entities.size(); }
+    };
+}
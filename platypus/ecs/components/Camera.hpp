@@ -22,6 +22,9 @@ namespace platypus
         float zFar;
     };
 
+    template <>
+    constexpr ComponentType get_component_type<Camera>() { return ComponentType::COMPONENT_TYPE_CAMERA; }
+
     Camera* create_camera(
         entityID_t target,
         float aspectRatio,
@@ -26,6 +26,22 @@ namespace platypus
     };
     std::vector<ComponentType> get_all_component_types();
 
+    // ComponentType is a single bit of the 64 bit component mask
+    constexpr size_t max_component_types = 64;
+
+    // Converts ComponentType into index of its' bit in the component mask.
+    // Used to index component storages directly instead of hashing the type.
+    // NOTE: COMPONENT_TYPE_EMPTY doesn't have a valid index!
+    inline size_t component_type_to_index(ComponentType type)
+    {
+        return static_cast<size_t>(__builtin_ctzll(static_cast<uint64_t>(type)));
+    }
+
+    // Maps component struct to its' ComponentType at compile time.
+    // Specialized after each component struct's definition.
+    template <typename T>
+    constexpr ComponentType get_component_type();
+
     std::string component_type_to_string(ComponentType type);
     size_t get_component_size(ComponentType type);
 
@@ -1,110 +1,229 @@
 #pragma once
 
-#include "platypus/core/Memory.hpp"
 #include "platypus/core/Debug.hpp"
 
 #include "platypus/ecs/Entity.hpp"
 
-#include <cstring>
-#include <unordered_map>
+#include <vector>
+#include <utility>
 
 
 namespace platypus
 {
+    // Sparse set storage for a single component type.
+    //
+    // Components are stored densely and contiguously in the order they were
+    // added. _sparse maps entityID_t directly into the dense storage, so finding
+    // entity's component is just array indexing (no hashing or searching).
+    //
+    // NOTE: Destroying a component moves the last component into the freed slot
+    // and adding components may reallocate the dense storage!
+    //  -> Don't hold on to component pointers over component creation or destruction
+    //  of the same type!
+    class ComponentPoolBase
+    {
+    protected:
+        size_t _elementSize = 0;
+
+        // Index into the dense storage for each entityID_t.
+        // -1 if the entity doesn't have component of this type
+        std::vector<int32_t> _sparse;
+        // Owner entity for each element in the dense storage
+        std::vector<entityID_t> _denseEntities;
+
+        // Points to the beginning of the typed dense storage.
+        // Kept here so lookups don't require virtual calls.
+        uint8_t* _pDenseStorage = nullptr;
+
+    public:
+        ComponentPoolBase(size_t elementSize) : _elementSize(elementSize) {}
+        ComponentPoolBase(const ComponentPoolBase& other) = delete;
+        virtual ~ComponentPoolBase() {}
+
+        // Constructs new component for entity at the back of the dense storage.
+        // Returns nullptr if the entity already has component of this type
+        virtual void* occupy(entityID_t entity) = 0;
+
+        // Destroys entity's component and fills the hole using the last component
+        virtual void clearStorage(entityID_t entity) = 0;
+
+        // Destroys all components but keeps the allocated capacity
+        virtual void clearStorage() = 0;
+
+        // Returns index to the dense storage or -1 if entity doesn't have this component
+        inline int32_t getIndex(entityID_t entity) const
+        {
+            if (entity < 0 || static_cast<size_t>(entity) >= _sparse.size())
+                return -1;
+            return _sparse[entity];
+        }
+
+        inline bool contains(entityID_t entity) const { return getIndex(entity) != -1; }
+
+        inline void* getElement(entityID_t entity)
+        {
+            const int32_t index = getIndex(entity);
+            if (index == -1)
+                return nullptr;
+            return _pDenseStorage + index * _elementSize;
+        }
+
+        inline const void* getElement(entityID_t entity) const
+        {
+            const int32_t index = getIndex(entity);
+            if (index == -1)
+                return nullptr;
+            return _pDenseStorage + index * _elementSize;
+        }
+
+        inline void* getElementAt(size_t index) { return _pDenseStorage + index * _elementSize; }
+        inline const void* getElementAt(size_t index) const { return _pDenseStorage + index * _elementSize; }
+
+        // Returns the most recently added component.
+        // *Used to quickly find "some component of this type", like the only camera or light.
+        void* any()
+        {
+            if (_denseEntities.empty())
+            {
+                Debug::log(
+                    "No occupied elements exist!",
+                    PLATYPUS_CURRENT_FUNC_NAME,
+                    Debug::MessageType::PLATYPUS_ERROR
+                );
+                PLATYPUS_ASSERT(false);
+                return nullptr;
+            }
+            return getElementAt(_denseEntities.size() - 1);
+        }
+
+        const void* any() const
+        {
+            if (_denseEntities.empty())
+            {
+                Debug::log(
+                    "No occupied elements exist!",
+                    PLATYPUS_CURRENT_FUNC_NAME,
+                    Debug::MessageType::PLATYPUS_ERROR
+                );
+                PLATYPUS_ASSERT(false);
+                return nullptr;
+            }
+            return getElementAt(_denseEntities.size() - 1);
+        }
+
+        // Owner entities of the components in the same order as the dense storage
+        inline const std::vector<entityID_t>& getEntities() const { return _denseEntities; }
+        inline size_t getOccupiedCount() const { return _denseEntities.size(); }
+        inline size_t getElementSize() const { return _elementSize; }
+    };
+
+
     template <typename T>
-    class ComponentPool : public MemoryPool
+    class ComponentPool : public ComponentPoolBase
     {
     private:
-        // Actual index for entity in the pool
-        std::unordered_map<entityID_t, size_t> _entityIndexMapping;
+        std::vector<T> _components;
 
     public:
-        ComponentPool() {}
-        ComponentPool(
-            size_t componentSize,
-            size_t maxLength,
-            bool allowResize
-        ) :
-            MemoryPool(componentSize, maxLength, allowResize)
-        {}
-
-        ComponentPool(const ComponentPool& other) :
-            MemoryPool(other), // NOTE: Not sure is this fine?
-            _entityIndexMapping(other._entityIndexMapping)
-        {}
+        ComponentPool(size_t initialCapacity) :
+            ComponentPoolBase(sizeof(T))
+        {
+            _components.reserve(initialCapacity);
+            _denseEntities.reserve(initialCapacity);
+            _pDenseStorage = reinterpret_cast<uint8_t*>(_components.data());
+        }
+
+        ComponentPool(const ComponentPool& other) = delete;
 
         ~ComponentPool() {}
 
-        virtual int32_t userDataToIndex(void* pUserData) const
+        virtual void* occupy(entityID_t entity)
         {
-            if (pUserData)
+            if (entity < 0)
             {
-                // NOTE: DANGER!?
-                entityID_t entity;
-                memcpy(reinterpret_cast<void*>(&entity), pUserData, sizeof(entityID_t));
-                std::unordered_map<entityID_t, size_t>::const_iterator it = _entityIndexMapping.find(entity);
-                if (it != _entityIndexMapping.end())
-                    return it->second;
+                Debug::log(
+                    "Invalid entity: " + std::to_string(entity),
+                    PLATYPUS_CURRENT_FUNC_NAME,
+                    Debug::MessageType::PLATYPUS_ERROR
+                );
+                PLATYPUS_ASSERT(false);
+                return nullptr;
+            }
+            if (contains(entity))
+            {
+                Debug::log(
+                    "Component already exists for entity " + std::to_string(entity),
+                    PLATYPUS_CURRENT_FUNC_NAME,
+                    Debug::MessageType::PLATYPUS_ERROR
+                );
+                PLATYPUS_ASSERT(false);
+                return nullptr;
             }
-            return -1;
+
+            const size_t sparseIndex = static_cast<size_t>(entity);
+            if (sparseIndex >= _sparse.size())
+                _sparse.resize(sparseIndex + 1, -1);
+
+            _sparse[sparseIndex] = static_cast<int32_t>(_components.size());
+            _denseEntities.push_back(entity);
+            // NOTE: Value initialization here, so members without default
+            // member initializers get zeroed like with the earlier calloc'd pools
+            _components.emplace_back();
+            _pDenseStorage = reinterpret_cast<uint8_t*>(_components.data());
+            return &_components.back();
         }
 
-        virtual void constructElement(size_t index, void* pData, void* pUserData)
+        virtual void clearStorage(entityID_t entity)
         {
-            // NOTE: DANGER!?
-            entityID_t entity;
-            memcpy(reinterpret_cast<void*>(&entity), pUserData, sizeof(entityID_t));
-
-            #ifdef PLATYPUS_DEBUG
-            if (_entityIndexMapping.find(entity) != _entityIndexMapping.end())
+            const int32_t signedIndex = getIndex(entity);
+            if (signedIndex == -1)
             {
                 Debug::log(
-                    "Index(" + std::to_string(index) + ") already exists for entity " + std::to_string(entity),
+                    "No component exists for entity " + std::to_string(entity),
                     PLATYPUS_CURRENT_FUNC_NAME,
                     Debug::MessageType::PLATYPUS_ERROR
                 );
                 PLATYPUS_ASSERT(false);
                 return;
             }
-            #endif
-            T* pComponent = new (pData) T;
-            _entityIndexMapping[entity] = index;
-        }
 
-        virtual void destroyElement(size_t index, void* pData, void* pUserData)
-        {
-            // NOTE: DANGER!?
-            if (pUserData)
+            const size_t index = static_cast<size_t>(signedIndex);
+            const size_t lastIndex = _components.size() - 1;
+            if (index != lastIndex)
             {
-                entityID_t entity = NULL_ENTITY_ID;
-                memcpy(reinterpret_cast<void*>(&entity), pUserData, sizeof(entityID_t));
-                #ifdef PLATYPUS_DEBUG
-                if (_entityIndexMapping.find(entity) == _entityIndexMapping.end())
-                {
-                    Debug::log(
-                        "No index exists for entity " + std::to_string(entity),
-                        PLATYPUS_CURRENT_FUNC_NAME,
-                        Debug::MessageType::PLATYPUS_ERROR
-                    );
-                    PLATYPUS_ASSERT(false);
-                    return;
-                }
-                #endif
-                _entityIndexMapping.erase(entity);
+                const entityID_t movedEntity = _denseEntities[lastIndex];
+                _components[index] = std::move(_components[lastIndex]);
+                _denseEntities[index] = movedEntity;
+                _sparse[static_cast<size_t>(movedEntity)] = signedIndex;
             }
+            _components.pop_back();
+            _denseEntities.pop_back();
+            _sparse[static_cast<size_t>(entity)] = -1;
+            _pDenseStorage = reinterpret_cast<uint8_t*>(_components.data());
+        }
 
-            T* pComponent = reinterpret_cast<T*>(pData);
-            pComponent->~T();
+        virtual void clearStorage()
+        {
+            _components.clear();
+            _denseEntities.clear();
+            _sparse.clear();
+            _pDenseStorage = reinterpret_cast<uint8_t*>(_components.data());
         }
 
-        virtual void onClearFullStorage()
+        inline T* get(entityID_t entity)
         {
-            _entityIndexMapping.clear();
+            const int32_t index = getIndex(entity);
+            return index != -1 ? &_components[index] : nullptr;
         }
 
-        virtual void onFreeStorage()
+        inline const T* get(entityID_t entity) const
         {
-            _entityIndexMapping.clear();
+            const int32_t index = getIndex(entity);
+            return index != -1 ? &_components[index] : nullptr;
         }
+
+        inline T* data() { return _components.data(); }
+        inline const T* data() const { return _components.data(); }
+        inline size_t size() const { return _components.size(); }
     };
 }
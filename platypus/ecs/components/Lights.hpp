@@ -36,6 +36,9 @@ namespace platypus
         uint8_t enableShadows;
     };
 
+    template <>
+    constexpr ComponentType get_component_type<Light>() { return ComponentType::COMPONENT_TYPE_LIGHT; }
+
     Light* create_directional_light(
         entityID_t target,
         const Vector3f& direction,
@@ -59,6 +59,11 @@ namespace platypus
         std::string text;
     };
 
+    template <>
+    constexpr ComponentType get_component_type<Renderable3D>() { return ComponentType::COMPONENT_TYPE_RENDERABLE3D; }
+    template <>
+    constexpr ComponentType get_component_type<GUIRenderable>() { return ComponentType::COMPONENT_TYPE_GUI_RENDERABLE; }
+
     Renderable3D* create_renderable3D(
         entityID_t target,
         UUID_t meshAssetID,
@@ -54,6 +54,90 @@ namespace platypus
     }
 
 
+    void play_animation(
+        SkeletalAnimation* pSkeletalAnimation,
+        UUID_t animationAssetID,
+        float fadeDuration
+    )
+    {
+        const SkeletalAnimationData* pAsset = (const SkeletalAnimationData*)Application::get_instance()->getAssetManager()->getAsset(
+            animationAssetID,
+            AssetType::ASSET_TYPE_SKELETAL_ANIMATION_DATA
+        );
+        if (!pAsset)
+        {
+            Debug::log(
+                "@play_animation "
+                "Failed to find animation asset with ID: " + std::to_string(animationAssetID),
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            PLATYPUS_ASSERT(false);
+            return;
+        }
+
+        if (fadeDuration > 0.0f && pSkeletalAnimation->animationID != animationAssetID)
+        {
+            pSkeletalAnimation->fadeAnimationID = pSkeletalAnimation->animationID;
+            pSkeletalAnimation->fadeAnimationTime = pSkeletalAnimation->time;
+            pSkeletalAnimation->fadeDuration = fadeDuration;
+            pSkeletalAnimation->fadeElapsed = 0.0f;
+        }
+        else
+        {
+            pSkeletalAnimation->fadeAnimationID = NULL_UUID;
+        }
+
+        pSkeletalAnimation->animationID = animationAssetID;
+        pSkeletalAnimation->time = 0.0f;
+        pSkeletalAnimation->length = pAsset->getLength();
+        pSkeletalAnimation->stopped = false;
+    }
+
+    AnimationLayer* add_animation_layer(
+        SkeletalAnimation* pSkeletalAnimation,
+        UUID_t animationAssetID,
+        AnimationBlendMode blendMode,
+        float weight,
+        JointMask jointMask
+    )
+    {
+        if (pSkeletalAnimation->layerCount >= skeletal_animation_max_layers)
+        {
+            Debug::log(
+                "@add_animation_layer "
+                "Max animation layer count(" + std::to_string(skeletal_animation_max_layers) + ") reached",
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            return nullptr;
+        }
+
+        const SkeletalAnimationData* pAsset = (const SkeletalAnimationData*)Application::get_instance()->getAssetManager()->getAsset(
+            animationAssetID,
+            AssetType::ASSET_TYPE_SKELETAL_ANIMATION_DATA
+        );
+        if (!pAsset)
+        {
+            Debug::log(
+                "@add_animation_layer "
+                "Failed to find animation asset with ID: " + std::to_string(animationAssetID),
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            PLATYPUS_ASSERT(false);
+            return nullptr;
+        }
+
+        AnimationLayer* pLayer = &pSkeletalAnimation->layers[pSkeletalAnimation->layerCount];
+        *pLayer = AnimationLayer();
+        pLayer->animationID = animationAssetID;
+        pLayer->blendMode = blendMode;
+        pLayer->length = pAsset->getLength();
+        pLayer->weight = weight;
+        pLayer->jointMask = jointMask;
+        ++pSkeletalAnimation->layerCount;
+        return pLayer;
+    }
+
+
     SkeletonJoint* create_skeleton_joint(
         entityID_t target,
         uint32_t jointIndex,
@@ -2,6 +2,7 @@
 
 #include "platypus/ecs/Entity.hpp"
 #include "platypus/utils/Maths.hpp"
+#include "platypus/utils/AnimationDataUtils.hpp"
 #include "platypus/utils/UUID.hpp"
 #include "platypus/core/Scene.hpp"
 
@@ -15,6 +16,28 @@ namespace platypus
     };
 
     constexpr size_t skeletal_animation_max_joints = 50;
+    constexpr size_t skeletal_animation_max_layers = 4;
+    static_assert(skeletal_animation_max_joints <= joint_mask_max_joints, "All joints required to fit in a JointMask");
+
+    enum class AnimationBlendMode : uint32_t
+    {
+        // Blends from the poses below towards the layer's poses by weight
+        ANIMATION_BLEND_MODE_OVERRIDE,
+        // Adds the layer's difference from its first pose on top of the poses below
+        ANIMATION_BLEND_MODE_ADDITIVE
+    };
+
+    // Additional animation applied on top of the SkeletalAnimation's main animation
+    struct AnimationLayer
+    {
+        UUID_t animationID = 0;
+        AnimationMode mode = AnimationMode::ANIMATION_MODE_LOOP;
+        AnimationBlendMode blendMode = AnimationBlendMode::ANIMATION_BLEND_MODE_OVERRIDE;
+        float time = 0.0f;
+        float length = 0.0f;
+        float weight = 1.0f;
+        JointMask jointMask = joint_mask_all;
+    };
 
     constexpr size_t serialized_skeletal_animation_size =
         sizeof(ComponentType) +
@@ -39,6 +62,31 @@ namespace platypus
         // Atm the matrices to throw to the shader
         // NOTE: Currently the joint count used, should be fetched from the Mesh asset!
         Matrix4f jointMatrices[skeletal_animation_max_joints];
+
+        // Local joint transforms at current time. Sampled by SkeletalAnimationSystem
+        // and used by TransformSystem to create the joint matrices.
+        // NOTE: These aren't serialized
+        JointPose localPoses[skeletal_animation_max_joints];
+        KeyframeCursor keyframeCursors[skeletal_animation_max_joints];
+        uint32_t sampledJointCount = 0;
+
+        // Previous animation getting faded out after switching animation using play_animation()
+        UUID_t fadeAnimationID = 0;
+        float fadeAnimationTime = 0.0f;
+        float fadeDuration = 0.0f;
+        float fadeElapsed = 0.0f;
+
+        // Applied in order on top of the main animation
+        // NOTE: Layers and fades aren't serialized atm
+        AnimationLayer layers[skeletal_animation_max_layers];
+        uint32_t layerCount = 0;
+
+        // Animation LOD state (see Scene::animationLODProperties)
+        uint32_t lodLevel = 0;
+        float timeSincePoseUpdate = 0.0f;
+        JointMask lodJointMask = joint_mask_all;
+        // If localPoses changed in the last update
+        uint8_t poseUpdated = 0;
     };
 
     // NOTE: ATM JUST TESTING WITH THIS
@@ -48,6 +96,11 @@ namespace platypus
         uint32_t jointIndex = 0;
     };
 
+    template <>
+    constexpr ComponentType get_component_type<SkeletalAnimation>() { return ComponentType::COMPONENT_TYPE_SKELETAL_ANIMATION; }
+    template <>
+    constexpr ComponentType get_component_type<SkeletonJoint>() { return ComponentType::COMPONENT_TYPE_JOINT; }
+
     SkeletalAnimation* create_skeletal_animation(
         entityID_t target,
         UUID_t animationAssetID,
@@ -55,6 +108,22 @@ namespace platypus
         bool useExplicitComponentMask = false
     );
 
+    // Switches to another animation, cross-fading from the current one over fadeDuration seconds
+    void play_animation(
+        SkeletalAnimation* pSkeletalAnimation,
+        UUID_t animationAssetID,
+        float fadeDuration = 0.0f
+    );
+
+    // Returns nullptr if skeletal_animation_max_layers reached
+    AnimationLayer* add_animation_layer(
+        SkeletalAnimation* pSkeletalAnimation,
+        UUID_t animationAssetID,
+        AnimationBlendMode blendMode,
+        float weight = 1.0f,
+        JointMask jointMask = joint_mask_all
+    );
+
     SkeletonJoint* create_skeleton_joint(
         entityID_t target,
         uint32_t jointIndex,
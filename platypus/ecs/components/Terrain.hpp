@@ -17,6 +17,9 @@ namespace platypus
         size_t verticesPerRow = 0;
     };
 
+    template <>
+    constexpr ComponentType get_component_type<Terrain>() { return ComponentType::COMPONENT_TYPE_TERRAIN; }
+
     Terrain* create_terrain(
         entityID_t target,
         float tileSize,
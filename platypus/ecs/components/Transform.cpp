@@ -65,6 +65,7 @@ namespace platypus
 
     void set_transform_position(Transform* pTransform, const Vector3f& position, bool hasParent)
     {
+        pTransform->dirty = true;
         Matrix4f& m = hasParent ? pTransform->localMatrix : pTransform->globalMatrix;
         m[0 + 3 * 4] = position.x;
         m[1 + 3 * 4] = position.y;
@@ -73,6 +74,7 @@ namespace platypus
 
     void set_transform_rotation(Transform* pTransform, float pitch, float yaw, float roll, bool hasParent)
     {
+        pTransform->dirty = true;
         Matrix4f& m = hasParent ? pTransform->localMatrix : pTransform->globalMatrix;
         Matrix4f rotationMatrix = create_rotation_matrix(pitch, yaw, roll);
 	    m[1 + 1 * 4] = rotationMatrix[1 + 1 * 4];
@@ -93,6 +95,7 @@ namespace platypus
 
     void set_transform_rotation(Transform* pTransform, const Quaternion& rotation, bool hasParent)
     {
+        pTransform->dirty = true;
         Matrix4f& m = hasParent ? pTransform->localMatrix : pTransform->globalMatrix;
         Matrix4f rotationMatrix = rotation.toRotationMatrix();
 	    m[1 + 1 * 4] = rotationMatrix[1 + 1 * 4];
@@ -113,12 +116,14 @@ namespace platypus
 
     void rotate_transform(Transform* pTransform, float pAmount, float yAmount, float rAmount, bool hasParent)
     {
+        pTransform->dirty = true;
         Matrix4f& m = hasParent ? pTransform->localMatrix : pTransform->globalMatrix;
         m = m * create_rotation_matrix(pAmount, yAmount, rAmount);
     }
 
     void set_transform_scale(Transform* pTransform, const Vector3f& scale, bool hasParent)
     {
+        pTransform->dirty = true;
         // NOTE: This might be incorrect!!!
         Matrix4f& m = hasParent ? pTransform->localMatrix : pTransform->globalMatrix;
 
@@ -541,6 +546,7 @@ namespace platypus
         {
             pChildTransform->localMatrix = pChildTransform->globalMatrix;
             pChildTransform->globalMatrix = Matrix4f(1.0f);
+            pChildTransform->dirty = true;
         }
     }
 
@@ -28,10 +28,18 @@ namespace platypus
         sizeof(ComponentType) +
         sizeof(uint32_t);
 
+    // NOTE: If modifying the matrices directly instead of using the
+    // set_transform funcs below, set dirty = true so TransformSystem knows
+    // to update the entity's children!
     struct Transform
     {
         Matrix4f localMatrix = Matrix4f(1.0f);
         Matrix4f globalMatrix = Matrix4f(1.0f);
+        // Local matrix or root entity's global matrix has changed
+        bool dirty = true;
+        // Incremented by TransformSystem when it handles the dirty flag or updates
+        // the global matrix -> other systems can compare this to see if the entity moved
+        uint32_t version = 0;
     };
 
     struct GUITransform
@@ -53,6 +61,15 @@ namespace platypus
         size_t count = 0;
     };
 
+    template <>
+    constexpr ComponentType get_component_type<Transform>() { return ComponentType::COMPONENT_TYPE_TRANSFORM; }
+    template <>
+    constexpr ComponentType get_component_type<GUITransform>() { return ComponentType::COMPONENT_TYPE_GUI_TRANSFORM; }
+    template <>
+    constexpr ComponentType get_component_type<Parent>() { return ComponentType::COMPONENT_TYPE_PARENT; }
+    template <>
+    constexpr ComponentType get_component_type<Children>() { return ComponentType::COMPONENT_TYPE_CHILDREN; }
+
 
     Transform* create_transform(
         entityID_t target,
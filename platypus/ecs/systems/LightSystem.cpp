@@ -14,6 +14,8 @@ namespace platypus
     LightSystem::LightSystem()
     {
         _requiredComponentMask = ComponentType::COMPONENT_TYPE_LIGHT;
+        _readComponentMask = ComponentType::COMPONENT_TYPE_CAMERA | ComponentType::COMPONENT_TYPE_TRANSFORM;
+        _writeComponentMask = ComponentType::COMPONENT_TYPE_LIGHT;
     }
 
     LightSystem::~LightSystem()
@@ -21,32 +23,25 @@ namespace platypus
 
     void LightSystem::update(Scene* pScene)
     {
-        for (const Entity& entity : pScene->getEntities())
-        {
-            if (!shouldUpdate(entity))
-                continue;
-
-            Light* pLightComponent = (Light*)pScene->getComponent(
-                entity.id,
-                ComponentType::COMPONENT_TYPE_LIGHT
-            );
-
-            if (pLightComponent->type == LightType::DIRECTIONAL_LIGHT)
+        pScene->view<Light>().each(
+            [this, pScene](entityID_t entity, Light& light)
             {
-                updateDirectionalLight(pScene, pLightComponent);
+                if (light.type == LightType::DIRECTIONAL_LIGHT)
+                {
+                    updateDirectionalLight(pScene, &light);
+                }
+                else
+                {
+                    Debug::log(
+                        "@LightSystem::update "
+                        "Light type was " + light_type_to_string(light.type) + " "
+                        "currently supporting only " + light_type_to_string(LightType::DIRECTIONAL_LIGHT),
+                        Debug::MessageType::PLATYPUS_ERROR
+                    );
+                    PLATYPUS_ASSERT(false);
+                }
             }
-            else
-            {
-                Debug::log(
-                    "@LightSystem::update "
-                    "Light type was " + light_type_to_string(pLightComponent->type) + " "
-                    "currently supporting only " + light_type_to_string(LightType::DIRECTIONAL_LIGHT),
-                    Debug::MessageType::PLATYPUS_ERROR
-                );
-                PLATYPUS_ASSERT(false);
-                continue;
-            }
-        }
+        );
     }
 
     static void get_view_frustum_bounds(
@@ -57,11 +52,11 @@ namespace platypus
         Vector4f points[8]
     )
     {
+        transform_points(transformationMatrix, points, points, 8);
         bool first = true;
         for (int i = 0; i < 8; ++i)
         {
-            Vector4f& p = points[i];
-            p = transformationMatrix * p;
+            const Vector4f& p = points[i];
             if (first)
             {
                 outMinX = p.x;
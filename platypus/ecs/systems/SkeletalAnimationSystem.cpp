@@ -4,13 +4,174 @@
 #include "platypus/core/Scene.hpp"
 #include "platypus/core/Debug.hpp"
 #include "platypus/core/Timing.hpp"
+#include "platypus/core/Application.hpp"
+#include "platypus/ecs/components/Transform.hpp"
+#include "platypus/ecs/components/Renderable.hpp"
+#include "platypus/assets/SkeletalAnimationData.hpp"
+#include "platypus/assets/AssetManager.hpp"
+#include <algorithm>
+#include <atomic>
 
 
 namespace platypus
 {
+    static void advance_animation_time(float& time, float length, AnimationMode mode, float deltaTime)
+    {
+        if (time < length)
+            time += 1.0f * deltaTime;
+        else if(mode == AnimationMode::ANIMATION_MODE_LOOP)
+            time = 0.0f;
+    }
+
+    static const SkeletalAnimationData* get_animation_data(AssetManager* pAssetManager, UUID_t animationID)
+    {
+        if (animationID == NULL_UUID)
+            return nullptr;
+        return static_cast<const SkeletalAnimationData*>(
+            pAssetManager->getAsset(
+                animationID,
+                AssetType::ASSET_TYPE_SKELETAL_ANIMATION_DATA
+            )
+        );
+    }
+
+    static void advance_animation_times(SkeletalAnimation& animation, AssetManager* pAssetManager, float deltaTime)
+    {
+        advance_animation_time(animation.time, animation.length, animation.mode, deltaTime);
+
+        if (animation.fadeAnimationID != NULL_UUID)
+        {
+            animation.fadeElapsed += deltaTime;
+            const SkeletalAnimationData* pFadeAnimationData = get_animation_data(pAssetManager, animation.fadeAnimationID);
+            if (!pFadeAnimationData || animation.fadeElapsed >= animation.fadeDuration)
+            {
+                animation.fadeAnimationID = NULL_UUID;
+            }
+            else
+            {
+                advance_animation_time(
+                    animation.fadeAnimationTime,
+                    pFadeAnimationData->getLength(),
+                    animation.mode,
+                    deltaTime
+                );
+            }
+        }
+
+        for (uint32_t i = 0; i < animation.layerCount; ++i)
+        {
+            AnimationLayer& layer = animation.layers[i];
+            advance_animation_time(layer.time, layer.length, layer.mode, deltaTime);
+        }
+    }
+
+    // Samples the main animation, then blends the fading out animation and
+    // the layers on top of it. Only joints in animation.lodJointMask are updated.
+    // Returns the number of sampled joints
+    static size_t sample_animation_poses(SkeletalAnimation& animation, AssetManager* pAssetManager)
+    {
+        const SkeletalAnimationData* pAnimationData = get_animation_data(pAssetManager, animation.animationID);
+        if (!pAnimationData)
+        {
+            animation.sampledJointCount = 0;
+            return 0;
+        }
+        // Joints not sampled before need to be sampled regardless of the LOD mask
+        const JointMask jointMask = animation.sampledJointCount > 0 ? animation.lodJointMask : joint_mask_all;
+        const size_t jointCount = std::min(pAnimationData->getJointCount(), skeletal_animation_max_joints);
+        pAnimationData->sampleJoints(
+            animation.time,
+            animation.localPoses,
+            jointCount,
+            animation.keyframeCursors,
+            jointMask
+        );
+        animation.sampledJointCount = static_cast<uint32_t>(jointCount);
+        size_t evaluatedJointCount = jointCount;
+
+        // NOTE: Fades and layers don't have keyframe cursors, so their keys are
+        // found using binary search
+        JointPose blendPoses[skeletal_animation_max_joints];
+        if (animation.fadeAnimationID != NULL_UUID)
+        {
+            const SkeletalAnimationData* pFadeAnimationData = get_animation_data(pAssetManager, animation.fadeAnimationID);
+            const size_t fadeJointCount = std::min(pFadeAnimationData->getJointCount(), jointCount);
+            pFadeAnimationData->sampleJoints(animation.fadeAnimationTime, blendPoses, fadeJointCount, nullptr, jointMask);
+            blend_poses(
+                blendPoses,
+                animation.localPoses,
+                animation.fadeElapsed / animation.fadeDuration,
+                jointMask,
+                animation.localPoses,
+                fadeJointCount
+            );
+            evaluatedJointCount += fadeJointCount;
+        }
+
+        for (uint32_t i = 0; i < animation.layerCount; ++i)
+        {
+            AnimationLayer& layer = animation.layers[i];
+            const SkeletalAnimationData* pLayerAnimationData = get_animation_data(pAssetManager, layer.animationID);
+            if (!pLayerAnimationData || layer.weight <= 0.0f)
+                continue;
+
+            const JointMask layerJointMask = layer.jointMask & jointMask;
+            const size_t layerJointCount = std::min(pLayerAnimationData->getJointCount(), jointCount);
+            pLayerAnimationData->sampleJoints(layer.time, blendPoses, layerJointCount, nullptr, layerJointMask);
+            if (layer.blendMode == AnimationBlendMode::ANIMATION_BLEND_MODE_ADDITIVE)
+            {
+                add_additive_poses(
+                    animation.localPoses,
+                    blendPoses,
+                    pLayerAnimationData->getReferencePoses(),
+                    layer.weight,
+                    layerJointMask,
+                    layerJointCount
+                );
+            }
+            else
+            {
+                blend_poses(
+                    animation.localPoses,
+                    blendPoses,
+                    layer.weight,
+                    layerJointMask,
+                    animation.localPoses,
+                    layerJointCount
+                );
+            }
+            evaluatedJointCount += layerJointCount;
+        }
+        return evaluatedJointCount;
+    }
+
+    static JointMask get_lod_joint_mask(
+        const AnimationLODLevel& lodLevel,
+        const Renderable3D* pRenderable,
+        AssetManager* pAssetManager
+    )
+    {
+        if (lodLevel.maxJointDepth < 0 || !pRenderable)
+            return joint_mask_all;
+
+        const Mesh* pMesh = static_cast<const Mesh*>(
+            pAssetManager->getAsset(pRenderable->meshID, AssetType::ASSET_TYPE_MESH)
+        );
+        if (!pMesh || !pMesh->getSkeleton())
+            return joint_mask_all;
+
+        return pMesh->getSkeleton()->getJointDepthMask(static_cast<uint32_t>(lodLevel.maxJointDepth));
+    }
+
+
     SkeletalAnimationSystem::SkeletalAnimationSystem()
     {
         _requiredComponentMask = ComponentType::COMPONENT_TYPE_SKELETAL_ANIMATION;
+        // Transforms for LOD distances
+        _readComponentMask = ComponentType::COMPONENT_TYPE_TRANSFORM |
+            ComponentType::COMPONENT_TYPE_CAMERA |
+            ComponentType::COMPONENT_TYPE_RENDERABLE3D;
+        _writeComponentMask = ComponentType::COMPONENT_TYPE_SKELETAL_ANIMATION;
     }
 
     SkeletalAnimationSystem::~SkeletalAnimationSystem()
@@ -18,23 +179,107 @@ namespace platypus
 
     void SkeletalAnimationSystem::update(Scene* pScene)
     {
-        for (const Entity& entity : pScene->getEntities())
-        {
-            if (!shouldUpdate(entity))
-                continue;
+        const float deltaTime = Timing::get_delta_time();
+        Application* pApp = Application::get_instance();
+        JobSystem& jobSystem = pApp->getJobSystem();
+        AssetManager* pAssetManager = pApp->getAssetManager();
 
-            void* pAnimationComponent = pScene->getComponent(
-                entity.id,
-                ComponentType::COMPONENT_TYPE_SKELETAL_ANIMATION
-            );
-            PLATYPUS_ASSERT(pAnimationComponent);
-            SkeletalAnimation* pAnimation = reinterpret_cast<SkeletalAnimation*>(pAnimationComponent);
-
-            float& animationTime = pAnimation->time;
-            if (animationTime < pAnimation->length)
-                animationTime += 1.0f * Timing::get_delta_time();
-            else if(pAnimation->mode == AnimationMode::ANIMATION_MODE_LOOP)
-                animationTime = 0.0f;
+        ComponentPool<Transform>* pTransforms = static_cast<ComponentPool<Transform>*>(
+            pScene->getComponentPool(ComponentType::COMPONENT_TYPE_TRANSFORM)
+        );
+        ComponentPool<Renderable3D>* pRenderables = static_cast<ComponentPool<Renderable3D>*>(
+            pScene->getComponentPool(ComponentType::COMPONENT_TYPE_RENDERABLE3D)
+        );
+
+        const AnimationLODProperties& lodProperties = pScene->animationLODProperties;
+        bool useLOD = lodProperties.enabled && !lodProperties.levels.empty();
+        Vector3f cameraPosition;
+        const entityID_t cameraEntity = pScene->getActiveCameraEntity();
+        const Transform* pCameraTransform = cameraEntity != NULL_ENTITY_ID ? pTransforms->get(cameraEntity) : nullptr;
+        if (pCameraTransform)
+        {
+            const Matrix4f& cameraMatrix = pCameraTransform->globalMatrix;
+            cameraPosition = Vector3f(cameraMatrix[12], cameraMatrix[13], cameraMatrix[14]);
         }
+        else
+        {
+            useLOD = false;
+        }
+
+        std::atomic<uint32_t> evaluatedJointCount(0);
+        std::atomic<uint32_t> updatedAnimationCount(0);
+        std::atomic<uint32_t> skippedAnimationCount(0);
+
+        View<SkeletalAnimation> animationView = pScene->view<SkeletalAnimation>();
+        jobSystem.parallelFor(
+            animationView.size(),
+            64,
+            [&](size_t begin, size_t end)
+            {
+                uint32_t chunkEvaluatedJointCount = 0;
+                uint32_t chunkUpdatedAnimationCount = 0;
+                uint32_t chunkSkippedAnimationCount = 0;
+                animationView.each(
+                    begin,
+                    end,
+                    [&](entityID_t entity, SkeletalAnimation& animation)
+                    {
+                        advance_animation_times(animation, pAssetManager, deltaTime);
+                        animation.poseUpdated = false;
+
+                        const Transform* pTransform = useLOD ? pTransforms->get(entity) : nullptr;
+                        uint32_t lodLevelIndex = 0;
+                        if (pTransform)
+                        {
+                            const Matrix4f& matrix = pTransform->globalMatrix;
+                            const Vector3f toCamera = Vector3f(matrix[12], matrix[13], matrix[14]) - cameraPosition;
+                            const float distance = toCamera.length();
+                            while (lodLevelIndex + 1 < lodProperties.levels.size() && distance >= lodProperties.levels[lodLevelIndex + 1].distance)
+                                ++lodLevelIndex;
+                        }
+
+                        if (lodLevelIndex != animation.lodLevel)
+                        {
+                            animation.lodLevel = lodLevelIndex;
+                            if (useLOD)
+                            {
+                                const AnimationLODLevel& lodLevel = lodProperties.levels[lodLevelIndex];
+                                animation.lodJointMask = get_lod_joint_mask(lodLevel, pRenderables->get(entity), pAssetManager);
+                                // Spread throttled updates of different entities over multiple frames
+                                animation.timeSincePoseUpdate = lodLevel.updateInterval * static_cast<float>(entity % 8) / 8.0f;
+                            }
+                            else
+                            {
+                                animation.lodJointMask = joint_mask_all;
+                            }
+                        }
+
+                        if (useLOD && animation.sampledJointCount > 0)
+                        {
+                            const AnimationLODLevel& lodLevel = lodProperties.levels[animation.lodLevel];
+                            animation.timeSincePoseUpdate += deltaTime;
+                            if (lodLevel.frozen || animation.timeSincePoseUpdate < lodLevel.updateInterval)
+                            {
+                                ++chunkSkippedAnimationCount;
+                                return;
+                            }
+                        }
+                        animation.timeSincePoseUpdate = 0.0f;
+
+                        chunkEvaluatedJointCount += static_cast<uint32_t>(sample_animation_poses(animation, pAssetManager));
+                        animation.poseUpdated = true;
+                        ++chunkUpdatedAnimationCount;
+                    }
+                );
+                evaluatedJointCount += chunkEvaluatedJointCount;
+                updatedAnimationCount += chunkUpdatedAnimationCount;
+                skippedAnimationCount += chunkSkippedAnimationCount;
+            }
+        );
+
+        AnimationStatistics& statistics = pScene->accessAnimationStatistics();
+        statistics.evaluatedJointCount = evaluatedJointCount;
+        statistics.updatedAnimationCount = updatedAnimationCount;
+        statistics.skippedAnimationCount = skippedAnimationCount;
     }
 }
@@ -0,0 +1,136 @@
+#include "SpatialIndexSystem.hpp"
+
+#include "platypus/core/Scene.hpp"
+#include "platypus/core/Application.hpp"
+
+#include "platypus/assets/AssetManager.hpp"
+#include "platypus/assets/Mesh.hpp"
+#include "platypus/ecs/components/Transform.hpp"
+#include "platypus/ecs/components/Renderable.hpp"
+
+
+namespace platypus
+{
+    SpatialIndexSystem::SpatialIndexSystem()
+    {
+        _requiredComponentMask = ComponentType::COMPONENT_TYPE_TRANSFORM | ComponentType::COMPONENT_TYPE_RENDERABLE3D;
+        // Reading transforms -> gets updated after TransformSystem
+        _readComponentMask = ComponentType::COMPONENT_TYPE_TRANSFORM | ComponentType::COMPONENT_TYPE_RENDERABLE3D;
+        _writeComponentMask = 0;
+    }
+
+    SpatialIndexSystem::~SpatialIndexSystem()
+    {
+    }
+
+    // Returns invalid bounds for entities that shouldn't be indexed
+    static AABB get_renderable_world_bounds(
+        const Entity& entity,
+        const Transform& transform,
+        const Renderable3D& renderable,
+        AssetManager* pAssetManager
+    )
+    {
+        AABB bounds;
+        // Inactive entities get removed from the index with their invalid bounds
+        if (!entity.active || renderable.meshID == NULL_UUID)
+            return bounds;
+
+        const Mesh* pMesh = (const Mesh*)pAssetManager->getAsset(
+            renderable.meshID,
+            AssetType::ASSET_TYPE_MESH
+        );
+        Vector3f center;
+        Vector3f extents;
+        if (get_mesh_world_bounds(pMesh, transform.globalMatrix, center, extents))
+        {
+            bounds.min = center - extents;
+            bounds.max = center + extents;
+        }
+        return bounds;
+    }
+
+    void SpatialIndexSystem::update(Scene* pScene)
+    {
+        bool entitiesChanged = false;
+        if (!_built || _structureVersion != pScene->getStructureVersion())
+        {
+            _structureVersion = pScene->getStructureVersion();
+            _built = true;
+            entitiesChanged = true;
+        }
+
+        View<Transform, Renderable3D> renderableView = pScene->view<Transform, Renderable3D>();
+        const std::vector<entityID_t>& viewEntities = renderableView.getEntities();
+        const size_t entityCount = viewEntities.size();
+
+        // Find entities to recalculate. On structure changes everything is given to the index
+        // so it can find the removed entities.
+        _changed.clear();
+        if (entitiesChanged)
+        {
+            _indexedEntities.resize(entityCount);
+            for (size_t i = 0; i < entityCount; ++i)
+                _changed.push_back(i);
+        }
+        else
+        {
+            for (size_t i = 0; i < entityCount; ++i)
+            {
+                const entityID_t entity = viewEntities[i];
+                const IndexedEntity& indexedEntity = _indexedEntities[i];
+                if (indexedEntity.pending ||
+                    renderableView.get<Transform>(entity).version != indexedEntity.transformVersion ||
+                    renderableView.get<Renderable3D>(entity).meshID != indexedEntity.meshID)
+                {
+                    _changed.push_back(i);
+                }
+            }
+        }
+
+        const size_t changedCount = _changed.size();
+        _entities.resize(changedCount);
+        _bounds.resize(changedCount);
+
+        Application* pApp = Application::get_instance();
+        AssetManager* pAssetManager = pApp->getAssetManager();
+        const std::vector<Entity>& sceneEntities = pScene->getEntities();
+        pApp->getJobSystem().parallelFor(
+            changedCount,
+            256,
+            [&](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    const size_t viewIndex = _changed[i];
+                    const entityID_t entity = viewEntities[viewIndex];
+                    const Transform& transform = renderableView.get<Transform>(entity);
+                    const Renderable3D& renderable = renderableView.get<Renderable3D>(entity);
+
+                    IndexedEntity& indexedEntity = _indexedEntities[viewIndex];
+                    indexedEntity.transformVersion = transform.version;
+                    indexedEntity.meshID = renderable.meshID;
+
+                    const Entity& sceneEntity = sceneEntities[entity];
+                    _entities[i] = entity;
+                    _bounds[i] = get_renderable_world_bounds(
+                        sceneEntity,
+                        transform,
+                        renderable,
+                        pAssetManager
+                    );
+                    indexedEntity.pending = sceneEntity.active &&
+                        renderable.meshID != NULL_UUID &&
+                        !_bounds[i].isValid();
+                }
+            }
+        );
+
+        pScene->accessSpatialIndex().update(
+            _entities.data(),
+            _bounds.data(),
+            changedCount,
+            entitiesChanged
+        );
+    }
+}
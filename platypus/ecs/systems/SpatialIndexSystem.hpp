@@ -0,0 +1,47 @@
+#pragma once
+
+#include "System.hpp"
+#include "platypus/utils/Bounds.hpp"
+#include <vector>
+
+
+namespace platypus
+{
+    // Keeps the Scene's SpatialIndex up to date with the world space bounds
+    // of all active Renderable3Ds.
+    //
+    // Bounds of all entities are recalculated only when the Scene's structure changes.
+    // Otherwise only the entities whose Transform::version or mesh has changed since
+    // the previous update are recalculated and given to the index.
+    class SpatialIndexSystem : public System
+    {
+    private:
+        // Inputs of the entity's bounds when they were last calculated
+        struct IndexedEntity
+        {
+            uint32_t transformVersion = 0;
+            UUID_t meshID = NULL_UUID;
+            // Mesh wasn't available yet -> retried on each update
+            bool pending = false;
+        };
+
+        // Same order as the Scene's Transform + Renderable3D view
+        std::vector<IndexedEntity> _indexedEntities;
+
+        // Entities given to the index this update
+        std::vector<entityID_t> _entities;
+        std::vector<AABB> _bounds;
+        // Indices to _indexedEntities of the entities to recalculate this update
+        std::vector<size_t> _changed;
+
+        uint64_t _structureVersion = 0;
+        bool _built = false;
+
+    public:
+        SpatialIndexSystem();
+        SpatialIndexSystem(const SpatialIndexSystem& other) = delete;
+        ~SpatialIndexSystem();
+
+        virtual void update(Scene* pScene);
+    };
+}
@@ -13,6 +13,12 @@ namespace platypus
     protected:
         uint64_t _requiredComponentMask = 0;
 
+        // Component types this system reads and writes in its update.
+        // SystemScheduler uses these to find systems that can be updated
+        // concurrently. Systems not declaring any access are always updated alone.
+        uint64_t _readComponentMask = 0;
+        uint64_t _writeComponentMask = 0;
+
     public:
         System() = default;
         System(const System& other) = delete;
@@ -24,5 +30,23 @@ namespace platypus
         {
             return ((entity.componentMask & _requiredComponentMask) == _requiredComponentMask) && entity.active;
         }
+
+        inline bool declaresAccess() const
+        {
+            return (_readComponentMask | _writeComponentMask) != 0;
+        }
+
+        // True if either of the systems writes components the other one reads or writes
+        inline bool conflictsWith(const System& other) const
+        {
+            if (!declaresAccess() || !other.declaresAccess())
+                return true;
+
+            const uint64_t otherAccess = other._readComponentMask | other._writeComponentMask;
+            return (_writeComponentMask & otherAccess) != 0 || (_readComponentMask & other._writeComponentMask) != 0;
+        }
+
+        inline uint64_t getReadComponentMask() const { return _readComponentMask; }
+        inline uint64_t getWriteComponentMask() const { return _writeComponentMask; }
     };
 }
@@ -0,0 +1,61 @@
+#include "SystemScheduler.hpp"
+#include "platypus/core/JobSystem.hpp"
+
+#include <chrono>
+
+
+namespace platypus
+{
+    void SystemScheduler::build(const std::vector<System*>& systems)
+    {
+        _stages.clear();
+        for (System* pSystem : systems)
+        {
+            // Needs to come after the last stage having a conflicting system
+            size_t stageIndex = 0;
+            for (size_t i = 0; i < _stages.size(); ++i)
+            {
+                for (const System* pStageSystem : _stages[i])
+                {
+                    if (pSystem->conflictsWith(*pStageSystem))
+                    {
+                        stageIndex = i + 1;
+                        break;
+                    }
+                }
+            }
+
+            if (stageIndex >= _stages.size())
+                _stages.push_back({ pSystem });
+            else
+                _stages[stageIndex].push_back(pSystem);
+        }
+    }
+
+    void SystemScheduler::update(Scene* pScene, JobSystem& jobSystem)
+    {
+        std::chrono::time_point<std::chrono::high_resolution_clock> beginTime = std::chrono::high_resolution_clock::now();
+
+        for (std::vector<System*>& stage : _stages)
+        {
+            if (stage.size() == 1 || jobSystem.getWorkerCount() == 0)
+            {
+                for (System* pSystem : stage)
+                    pSystem->update(pScene);
+                continue;
+            }
+
+            JobCounter counter;
+            for (size_t i = 1; i < stage.size(); ++i)
+            {
+                System* pSystem = stage[i];
+                jobSystem.submit([pSystem, pScene]() { pSystem->update(pScene); }, &counter);
+            }
+            stage[0]->update(pScene);
+            jobSystem.wait(&counter);
+        }
+
+        std::chrono::duration<float> duration = std::chrono::high_resolution_clock::now() - beginTime;
+        _lastUpdateTime = duration.count();
+    }
+}
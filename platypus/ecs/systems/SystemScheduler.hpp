@@ -0,0 +1,35 @@
+#pragma once
+
+#include "System.hpp"
+#include <vector>
+
+
+namespace platypus
+{
+    class Scene;
+    class JobSystem;
+
+    // Groups systems into stages where no system conflicts with another one
+    // in the same stage (see System::conflictsWith).
+    // Stages are updated one after another and systems within a stage concurrently.
+    //
+    // Systems keep their order relative to the systems they conflict with,
+    // so this gives the same results as updating all systems in order.
+    class SystemScheduler
+    {
+    private:
+        std::vector<std::vector<System*>> _stages;
+        float _lastUpdateTime = 0.0f;
+
+    public:
+        SystemScheduler() = default;
+        SystemScheduler(const SystemScheduler& other) = delete;
+
+        void build(const std::vector<System*>& systems);
+        void update(Scene* pScene, JobSystem& jobSystem);
+
+        inline const std::vector<std::vector<System*>>& getStages() const { return _stages; }
+        // Time in seconds the last update took
+        inline float getLastUpdateTime() const { return _lastUpdateTime; }
+    };
+}
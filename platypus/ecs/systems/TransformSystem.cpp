@@ -8,229 +8,300 @@
 #include "platypus/ecs/Entity.hpp"
 #include "platypus/ecs/components/Transform.hpp"
 #include "platypus/ecs/components/SkeletalAnimation.hpp"
+#include "platypus/ecs/components/Renderable.hpp"
+
+#include <queue>
 
 
 namespace platypus
 {
-    // ISSUES(?):
-    //      * Root joint animation issue
-    //          - If animated skeleton's root joint doesn't have a parent,
-    //          it doesn't get animated.
-    //          SOLUTION:
-    //              -> Always have some "base entity" that has the root joint entity as child
-    static void apply_transform_hierarchy(
-        Scene* pScene,
-        AssetManager* pAssetManager,
-        entityID_t entity,
-        entityID_t parent,
-        SkeletalAnimationData* pAnimationAsset,
-        SkeletalAnimation* pUseAnimation,
-        const Skeleton* pSkeleton,
-        Pose* pCurrentPose,
-        Pose* pNextPose
-    )
+    // NOTE: ISSUE!
+    //  Not allowing animating single bone skeletons
+    //  -> skipping if no Children componen found!
+    //  TODO: Fix this when animating here!
+    TransformSystem::TransformSystem()
     {
-        // Attempt to find bind pose if exists
-        // NOTE: Kind of rough to check for each possible joint...
-        Renderable3D* pRenderable = reinterpret_cast<Renderable3D*>(
-            pScene->getComponent(
-                entity,
-                ComponentType::COMPONENT_TYPE_RENDERABLE3D,
-                false,
-                false
-            )
-        );
-        if (pRenderable)
+        _requiredComponentMask = ComponentType::COMPONENT_TYPE_TRANSFORM | ComponentType::COMPONENT_TYPE_CHILDREN;
+        _readComponentMask = ComponentType::COMPONENT_TYPE_RENDERABLE3D |
+            ComponentType::COMPONENT_TYPE_PARENT |
+            ComponentType::COMPONENT_TYPE_CHILDREN |
+            ComponentType::COMPONENT_TYPE_JOINT;
+        // Writes joint matrices of SkeletalAnimation components
+        _writeComponentMask = ComponentType::COMPONENT_TYPE_TRANSFORM | ComponentType::COMPONENT_TYPE_SKELETAL_ANIMATION;
+    }
+
+    TransformSystem::~TransformSystem()
+    {
+    }
+
+    void TransformSystem::update(Scene* pScene)
+    {
+        bool rebuilt = false;
+        if (!_built || _structureVersion != pScene->getStructureVersion())
         {
-            Mesh* pMesh = reinterpret_cast<Mesh*>(
-                pAssetManager->getAsset(
-                    pRenderable->meshID,
-                    AssetType::ASSET_TYPE_MESH
-                )
-            );
-            if (pMesh)
+            buildHierarchies(pScene);
+            _structureVersion = pScene->getStructureVersion();
+            _built = true;
+            rebuilt = true;
+        }
+
+        // Nothing to recalculate for these, their global matrices are set directly
+        for (Transform* pTransform : _standaloneTransforms)
+        {
+            if (pTransform->dirty)
             {
-                if (pMesh->getPropertyFlags() & static_cast<uint32_t>(MeshPropertyFlagBits::TYPE_SKINNED))
-                    pSkeleton = pMesh->getSkeleton();
+                pTransform->dirty = false;
+                ++pTransform->version;
             }
         }
 
+        Application* pApp = Application::get_instance();
+        AssetManager* pAssetManager = pApp->getAssetManager();
 
-        // Check if animation changes for this entity and its children
-        //  -> need to find new animation asset
-        SkeletalAnimation* pEntityAnimation = reinterpret_cast<SkeletalAnimation*>(
-            pScene->getComponent(
-                entity,
-                ComponentType::COMPONENT_TYPE_SKELETAL_ANIMATION,
-                false,
-                false
-            )
-        );
-        if (pEntityAnimation && (pEntityAnimation != pUseAnimation))
-        {
-            UUID_t prevAnimAssetID = NULL_UUID;
-            if (pUseAnimation)
-                prevAnimAssetID = pUseAnimation->animationID;
-            pUseAnimation = pEntityAnimation;
-            if (prevAnimAssetID != pUseAnimation->animationID)
+        // Hierarchies don't share any nodes, so each can be handled by a different thread
+        pApp->getJobSystem().parallelFor(
+            _hierarchies.size(),
+            16,
+            [this, pAssetManager, rebuilt](size_t begin, size_t end)
             {
-                pAnimationAsset = reinterpret_cast<SkeletalAnimationData*>(
-                    pAssetManager->getAsset(
-                        pUseAnimation->animationID,
-                        AssetType::ASSET_TYPE_SKELETAL_ANIMATION_DATA
-                    )
-                );
+                for (size_t i = begin; i < end; ++i)
+                    updateHierarchy(_hierarchies[i], pAssetManager, rebuilt);
             }
-        }
+        );
+    }
+
+    void TransformSystem::buildHierarchies(Scene* pScene)
+    {
+        _nodes.clear();
+        _hierarchies.clear();
+        _animations.clear();
+        _standaloneTransforms.clear();
 
-        Transform* pTransform = reinterpret_cast<Transform*>(
-            pScene->getComponent(
-                entity,
-                ComponentType::COMPONENT_TYPE_TRANSFORM
-            )
+        ComponentPool<Transform>* pTransforms = static_cast<ComponentPool<Transform>*>(
+            pScene->getComponentPool(ComponentType::COMPONENT_TYPE_TRANSFORM)
         );
-        if (!pTransform)
+        ComponentPool<Children>* pChildrenPool = static_cast<ComponentPool<Children>*>(
+            pScene->getComponentPool(ComponentType::COMPONENT_TYPE_CHILDREN)
+        );
+        ComponentPool<SkeletonJoint>* pJoints = static_cast<ComponentPool<SkeletonJoint>*>(
+            pScene->getComponentPool(ComponentType::COMPONENT_TYPE_JOINT)
+        );
+        ComponentPool<Renderable3D>* pRenderables = static_cast<ComponentPool<Renderable3D>*>(
+            pScene->getComponentPool(ComponentType::COMPONENT_TYPE_RENDERABLE3D)
+        );
+        ComponentPool<SkeletalAnimation>* pAnimations = static_cast<ComponentPool<SkeletalAnimation>*>(
+            pScene->getComponentPool(ComponentType::COMPONENT_TYPE_SKELETAL_ANIMATION)
+        );
+        const EntityHierarchyManager& hierarchyManager = pScene->getEntityHierarchyManager();
+        const std::vector<Entity>& sceneEntities = pScene->getEntities();
+
+        const uint64_t hierarchyMask = ComponentType::COMPONENT_TYPE_PARENT | ComponentType::COMPONENT_TYPE_CHILDREN;
+        for (entityID_t entityID : pScene->view<Transform>().getEntities())
         {
-            Debug::log(
-                "Entity " + std::to_string(entity) + " doesn't have a Transform component!",
-                PLATYPUS_CURRENT_FUNC_NAME,
-                Debug::MessageType::PLATYPUS_ERROR
-            );
-            PLATYPUS_ASSERT(false);
+            const Entity& entity = sceneEntities[entityID];
+            if ((entity.componentMask & hierarchyMask) == 0 && entity.active)
+                _standaloneTransforms.push_back(pTransforms->get(entityID));
         }
 
-        // Apply animation if exists
-        Matrix4f localMatrix = pTransform->localMatrix;
-        SkeletonJoint* pJoint = nullptr;
-        if (pUseAnimation && pAnimationAsset)
+        // Pair's first = entity, second = parent's index in _nodes
+        std::queue<std::pair<entityID_t, int32_t>> toVisit;
+        for (entityID_t rootEntityID : pScene->view<Transform, Children>().getEntities())
         {
-            pJoint = reinterpret_cast<SkeletonJoint*>(
-                pScene->getComponent(
-                    entity,
-                    ComponentType::COMPONENT_TYPE_JOINT,
-                    false,
-                    false
-                )
-            );
-            if (pJoint)
-            {
-                size_t jointIndex = pJoint->jointIndex;
-                Matrix4f animatedBoneMatrix = pAnimationAsset->getBoneMatrix(
-                    pUseAnimation->time,
-                    jointIndex
-                );
-                localMatrix = animatedBoneMatrix;
-            }
-            // Went outside the bounds of prev anim joints -> reset anim
-            else
+            // Handle only root entities, their children gets added below
+            const Entity& rootEntity = sceneEntities[rootEntityID];
+            bool isRoot = (rootEntity.componentMask & ComponentType::COMPONENT_TYPE_PARENT) == 0;
+            if (!isRoot || !rootEntity.active)
+                continue;
+
+            Hierarchy hierarchy;
+            hierarchy.begin = _nodes.size();
+            hierarchy.animationsBegin = _animations.size();
+
+            toVisit.push(std::make_pair(rootEntityID, -1));
+            while (!toVisit.empty())
             {
-                pUseAnimation = nullptr;
-                pAnimationAsset = nullptr;
+                const entityID_t entity = toVisit.front().first;
+                const int32_t parentIndex = toVisit.front().second;
+                toVisit.pop();
+
+                Transform* pTransform = pTransforms->get(entity);
+                if (!pTransform)
+                {
+                    Debug::log(
+                        "Entity " + std::to_string(entity) + " doesn't have a Transform component!",
+                        PLATYPUS_CURRENT_FUNC_NAME,
+                        Debug::MessageType::PLATYPUS_ERROR
+                    );
+                    PLATYPUS_ASSERT(false);
+                    continue;
+                }
+
+                HierarchyNode node;
+                node.pTransform = pTransform;
+                node.pJoint = pJoints->get(entity);
+                node.pRenderable = pRenderables->get(entity);
+                node.pAnimation = pAnimations->get(entity);
+                node.parentIndex = parentIndex;
+
+                if (node.pAnimation)
+                {
+                    hierarchy.animated = true;
+                    _animations.push_back(node.pAnimation);
+                }
+
+                const int32_t nodeIndex = static_cast<int32_t>(_nodes.size());
+                _nodes.push_back(node);
+
+                const Children* pChildren = pChildrenPool->get(entity);
+                if (!pChildren || pChildren->count == 0)
+                    continue;
+
+                const entityID_t* pChildrenBuf = hierarchyManager.getChildEntities(pChildren);
+                for (size_t childIndex = 0; childIndex < pChildren->count; ++childIndex)
+                    toVisit.push(std::make_pair(pChildrenBuf[childIndex], nodeIndex));
             }
-        }
 
-        // Apply parent transform if exists
-        Matrix4f parentMatrix(1.0f);
-        if (parent != NULL_ENTITY_ID)
-        {
-            Transform* pParentTransform = reinterpret_cast<Transform*>(
-                pScene->getComponent(
-                    parent,
-                    ComponentType::COMPONENT_TYPE_TRANSFORM
-                )
-            );
-            parentMatrix = pParentTransform->globalMatrix;
-            pTransform->globalMatrix = parentMatrix * localMatrix;
+            hierarchy.end = _nodes.size();
+            hierarchy.animationsEnd = _animations.size();
+            _hierarchies.push_back(hierarchy);
         }
 
-        if (pJoint && pUseAnimation && pSkeleton)
-            pUseAnimation->jointMatrices[pJoint->jointIndex] = pTransform->globalMatrix * pSkeleton->getJoint(pJoint->jointIndex).inverseMatrix;
+        _nodeUpdated.resize(_nodes.size());
+        _animationStates.resize(_nodes.size());
+    }
 
-        Children* pChildren = reinterpret_cast<Children*>(
-            pScene->getComponent(
-                entity,
-                ComponentType::COMPONENT_TYPE_CHILDREN,
-                false,
-                false
-            )
-        );
-        if (!pChildren)
-            return;
+    // ISSUES(?):
+    //      * Root joint animation issue
+    //          - If animated skeleton's root joint doesn't have a parent,
+    //          it doesn't get animated.
+    //          SOLUTION:
+    //              -> Always have some "base entity" that has the root joint entity as child
+    void TransformSystem::updateHierarchy(
+        const Hierarchy& hierarchy,
+        AssetManager* pAssetManager,
+        bool forceUpdate
+    )
+    {
+        // Animations change the joints' local matrices
+        // -> no point checking dirty flags if any pose changed
+        bool posesUpdated = false;
+        for (size_t i = hierarchy.animationsBegin; i < hierarchy.animationsEnd && !posesUpdated; ++i)
+            posesUpdated = _animations[i]->poseUpdated;
 
-        // TODO: Make this less dangerous!
-        const entityID_t* pChildrenBuf = pScene->getEntityHierarchyManager().getChildEntities(pChildren);
-        for (size_t childIndex = 0; childIndex < pChildren->count; ++childIndex)
+        const bool updateAll = forceUpdate || posesUpdated;
+        for (size_t i = hierarchy.begin; i < hierarchy.end; ++i)
         {
-            entityID_t childEntity = *(pChildrenBuf + childIndex);
-            apply_transform_hierarchy(
-                pScene,
-                pAssetManager,
-                childEntity,
-                entity,
-                pAnimationAsset,
-                pUseAnimation,
-                pSkeleton,
-                pCurrentPose,
-                pNextPose
-            );
-        }
-    }
+            const HierarchyNode& node = _nodes[i];
+            Transform* pTransform = node.pTransform;
+            const int32_t parentIndex = node.parentIndex;
 
+            const bool parentUpdated = parentIndex != -1 && _nodeUpdated[parentIndex];
+            const bool updateNode = updateAll || pTransform->dirty || parentUpdated;
+            _nodeUpdated[i] = updateNode;
+            if (!updateNode)
+                continue;
 
-    // NOTE: ISSUE!
-    //  Not allowing animating single bone skeletons
-    //  -> skipping if no Children componen found!
-    //  TODO: Fix this when animating here!
-    TransformSystem::TransformSystem()
-    {
-        _requiredComponentMask = ComponentType::COMPONENT_TYPE_TRANSFORM | ComponentType::COMPONENT_TYPE_CHILDREN;
-    }
+            pTransform->dirty = false;
+            ++pTransform->version;
 
-    TransformSystem::~TransformSystem()
-    {
+            Matrix4f localMatrix = pTransform->localMatrix;
+            bool animatedJoint = false;
+            NodeAnimationState* pAnimationState = nullptr;
+            if (hierarchy.animated)
+            {
+                NodeAnimationState parentState;
+                if (parentIndex != -1)
+                    parentState = _animationStates[parentIndex];
+
+                pAnimationState = &_animationStates[i];
+                *pAnimationState = getAnimationState(node, parentState, pAssetManager);
+                if (pAnimationState->pAnimation && pAnimationState->pAnimationAsset)
+                {
+                    if (node.pJoint)
+                    {
+                        const SkeletalAnimation* pAnimation = pAnimationState->pAnimation;
+                        const uint32_t jointIndex = node.pJoint->jointIndex;
+                        // Local poses are sampled for the whole skeleton by SkeletalAnimationSystem
+                        if (jointIndex < pAnimation->sampledJointCount)
+                        {
+                            const JointPose& pose = pAnimation->localPoses[jointIndex];
+                            localMatrix = create_transformation_matrix(pose.translation, pose.rotation, pose.scale);
+                        }
+                        else
+                        {
+                            localMatrix = pAnimationState->pAnimationAsset->getBoneMatrix(
+                                pAnimation->time,
+                                jointIndex
+                            );
+                        }
+                        animatedJoint = true;
+                    }
+                    // Went outside the bounds of prev anim joints -> reset anim
+                    else
+                    {
+                        pAnimationState->pAnimation = nullptr;
+                        pAnimationState->pAnimationAsset = nullptr;
+                    }
+                }
+            }
+
+            // Apply parent transform if exists
+            if (parentIndex != -1)
+            {
+                const Matrix4f& parentMatrix = _nodes[parentIndex].pTransform->globalMatrix;
+                pTransform->globalMatrix = parentMatrix * localMatrix;
+            }
+
+            if (animatedJoint && pAnimationState->pSkeleton)
+            {
+                const uint32_t jointIndex = node.pJoint->jointIndex;
+                pAnimationState->pAnimation->jointMatrices[jointIndex] = pTransform->globalMatrix * pAnimationState->pSkeleton->getJoint(jointIndex).inverseMatrix;
+            }
+        }
     }
 
-    void TransformSystem::update(Scene* pScene)
+    TransformSystem::NodeAnimationState TransformSystem::getAnimationState(
+        const HierarchyNode& node,
+        const NodeAnimationState& parentState,
+        AssetManager* pAssetManager
+    ) const
     {
-        AssetManager* pAssetManager = Application::get_instance()->getAssetManager();
-        for (const Entity& entity : pScene->getEntities())
+        NodeAnimationState state = parentState;
+
+        // Attempt to find bind pose if exists
+        if (node.pRenderable)
         {
-            // Handle only root entities
-            // -> their children are handled by the apply_transform_hierarchy func
-            bool hasRequiredComponentMask = (entity.componentMask & _requiredComponentMask) == _requiredComponentMask;
-            bool isRoot = (entity.componentMask & ComponentType::COMPONENT_TYPE_PARENT) == 0;
-            if (!hasRequiredComponentMask || !isRoot || !entity.active)
+            Mesh* pMesh = reinterpret_cast<Mesh*>(
+                pAssetManager->getAsset(
+                    node.pRenderable->meshID,
+                    AssetType::ASSET_TYPE_MESH
+                )
+            );
+            if (pMesh)
             {
-                continue;
+                if (pMesh->getPropertyFlags() & static_cast<uint32_t>(MeshPropertyFlagBits::TYPE_SKINNED))
+                    state.pSkeleton = pMesh->getSkeleton();
             }
-            entityID_t entityID = entity.id;
+        }
 
-            SkeletalAnimation* pAnimationComponent = (SkeletalAnimation*)pScene->getComponent(
-                entityID,
-                ComponentType::COMPONENT_TYPE_SKELETAL_ANIMATION,
-                false,
-                false
-            );
-            SkeletalAnimationData* pAnimationAsset = nullptr;
-            if (pAnimationComponent)
+        // Check if animation changes for this entity and its children
+        //  -> need to find new animation asset
+        if (node.pAnimation && (node.pAnimation != state.pAnimation))
+        {
+            UUID_t prevAnimAssetID = NULL_UUID;
+            if (state.pAnimation)
+                prevAnimAssetID = state.pAnimation->animationID;
+            state.pAnimation = node.pAnimation;
+            if (prevAnimAssetID != state.pAnimation->animationID)
             {
-                pAnimationAsset = (SkeletalAnimationData*)pAssetManager->getAsset(
-                    pAnimationComponent->animationID,
-                    AssetType::ASSET_TYPE_SKELETAL_ANIMATION_DATA
+                state.pAnimationAsset = reinterpret_cast<SkeletalAnimationData*>(
+                    pAssetManager->getAsset(
+                        state.pAnimation->animationID,
+                        AssetType::ASSET_TYPE_SKELETAL_ANIMATION_DATA
+                    )
                 );
             }
-
-            apply_transform_hierarchy(
-                pScene,
-                pAssetManager,
-                entityID,
-                NULL_ENTITY_ID,
-                pAnimationAsset,
-                pAnimationComponent,
-                nullptr,
-                nullptr,
-                nullptr
-            );
         }
+        return state;
     }
 }
@@ -1,16 +1,95 @@
 #pragma once
 
 #include "System.hpp"
+#include <vector>
 
 namespace platypus
 {
+    struct Transform;
+    struct SkeletonJoint;
+    struct Renderable3D;
+    struct SkeletalAnimation;
+    class SkeletalAnimationData;
+    class Skeleton;
+    class AssetManager;
+
+    // Updates global matrices of all entity hierarchies.
+    //
+    // Hierarchies are flattened breadth-first into _nodes, so parents always come
+    // before their children and the update is a linear pass per hierarchy.
+    // The flattened hierarchies are rebuilt only when the Scene's structure changes.
+    //
+    // Only nodes whose Transform is dirty (or whose parent got updated) are
+    // recalculated. Hierarchies containing SkeletalAnimation are updated
+    // completely on frames their animations' poses get updated
+    // (see SkeletalAnimation::poseUpdated and animation LOD).
+    //
+    // Transforms outside hierarchies only get their dirty flags cleared.
+    // Each recalculated or cleared Transform's version gets incremented
+    // so later systems can find the moved entities (see SpatialIndexSystem).
     class TransformSystem : public System
     {
+    private:
+        struct HierarchyNode
+        {
+            Transform* pTransform = nullptr;
+            // Optional components affecting animation
+            SkeletonJoint* pJoint = nullptr;
+            Renderable3D* pRenderable = nullptr;
+            SkeletalAnimation* pAnimation = nullptr;
+            // Index to _nodes or -1 if root
+            int32_t parentIndex = -1;
+        };
+
+        // Single root's nodes in range [begin, end) of _nodes
+        // and its SkeletalAnimations in range [animationsBegin, animationsEnd) of _animations
+        struct Hierarchy
+        {
+            size_t begin = 0;
+            size_t end = 0;
+            size_t animationsBegin = 0;
+            size_t animationsEnd = 0;
+            bool animated = false;
+        };
+
+        // Animation used by node and its children
+        struct NodeAnimationState
+        {
+            SkeletalAnimation* pAnimation = nullptr;
+            SkeletalAnimationData* pAnimationAsset = nullptr;
+            const Skeleton* pSkeleton = nullptr;
+        };
+
+        std::vector<HierarchyNode> _nodes;
+        std::vector<Hierarchy> _hierarchies;
+        std::vector<const SkeletalAnimation*> _animations;
+        // Active entities' Transforms having no Parent nor Children
+        std::vector<Transform*> _standaloneTransforms;
+        // Per node, updated each frame
+        std::vector<uint8_t> _nodeUpdated;
+        std::vector<NodeAnimationState> _animationStates;
+
+        uint64_t _structureVersion = 0;
+        bool _built = false;
+
     public:
         TransformSystem();
         TransformSystem(const TransformSystem& other) = delete;
         ~TransformSystem();
 
         virtual void update(Scene* pScene);
+
+    private:
+        void buildHierarchies(Scene* pScene);
+        void updateHierarchy(
+            const Hierarchy& hierarchy,
+            AssetManager* pAssetManager,
+            bool forceUpdate
+        );
+        NodeAnimationState getAnimationState(
+            const HierarchyNode& node,
+            const NodeAnimationState& parentState,
+            AssetManager* pAssetManager
+        ) const;
     };
 }
@@ -3,6 +3,7 @@
 #include "platypus/core/Debug.hpp"
 #include "platypus/Common.h"
 #include <cstring>
+#include <algorithm>
 
 
 // The reason for this file:
@@ -52,7 +53,7 @@ namespace platypus
     }
 
     VertexBufferElement VertexBufferElement::deserialize(
-        const std::vector<char>& data,
+        const DataView& data,
         size_t offset
     )
     {
@@ -161,7 +162,7 @@ namespace platypus
     }
 
     VertexBufferLayout VertexBufferLayout::deserialize(
-        const std::vector<char>& data,
+        const DataView& data,
         size_t offset
     )
     {
@@ -452,5 +453,15 @@ namespace platypus
         return true;
     }
 
-
+    void Buffer::markWritten(size_t dataSize, size_t offset)
+    {
+        if (_writtenBegin >= _writtenEnd)
+        {
+            _writtenBegin = offset;
+            _writtenEnd = offset + dataSize;
+            return;
+        }
+        _writtenBegin = std::min(_writtenBegin, offset);
+        _writtenEnd = std::max(_writtenEnd, offset + dataSize);
+    }
 }
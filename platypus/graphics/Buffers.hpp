@@ -1,5 +1,6 @@
 #pragma once
 
+#include "platypus/utils/DataView.hpp"
 #include <cstdint>
 #include <cstdlib>
 #include <vector>
@@ -59,7 +60,9 @@ namespace platypus
         BUFFER_USAGE_INDEX_BUFFER_BIT = 0x2,
         BUFFER_USAGE_UNIFORM_BUFFER_BIT = 0x4,
         BUFFER_USAGE_TRANSFER_SRC_BIT = 0x8,
-        BUFFER_USAGE_TRANSFER_DST_BIT = 0x10
+        BUFFER_USAGE_TRANSFER_DST_BIT = 0x10,
+        // NOTE: Desktop only atm
+        BUFFER_USAGE_STORAGE_BUFFER_BIT = 0x20
     };
 
 
@@ -131,7 +134,7 @@ namespace platypus
 
         std::vector<char> serialize() const;
         static VertexBufferElement deserialize(
-            const std::vector<char>& data,
+            const DataView& data,
             size_t offset
         );
 
@@ -176,7 +179,7 @@ namespace platypus
 
         std::vector<char> serialize() const;
         static VertexBufferLayout deserialize(
-            const std::vector<char>& data,
+            const DataView& data,
             size_t offset
         );
         size_t getSerializedSize() const;
@@ -211,6 +214,10 @@ namespace platypus
 
         bool _hostSideUpdated = false;
 
+        // Range written with write() since the last flush()
+        size_t _writtenBegin = 0;
+        size_t _writtenEnd = 0;
+
     public:
         Buffer(
             const void* pData,
@@ -230,6 +237,16 @@ namespace platypus
         void updateDevice(void* pData, size_t dataSize, size_t offset);
         void updateDevice();
 
+        // For data rewritten every frame (batch instance data, dynamic uniform buffers...)
+        // Functions write and flush require platform impl!
+        //  -On Vulkan side, dynamic and stream buffers which aren't transfer destinations
+        //  stay persistently mapped -> write copies directly into the mapped memory
+        //  and flush only flushes the range written since the previous flush.
+        //  -On OpenGL side, write goes to the host side copy and flush uploads
+        //  the written range from it.
+        void write(void* pData, size_t dataSize, size_t offset);
+        void flush();
+
         inline const void* getData() const { return _pData; }
         inline void* accessData() { return _pData; }
         inline size_t getDataElemSize() const { return _dataElemSize; }
@@ -241,5 +258,7 @@ namespace platypus
         inline BufferImpl* getImpl() const { return _pImpl; }
     private:
         bool validateUpdate(void* pData, size_t dataSize, size_t offset);
+        // Function markWritten is platform agnostic
+        void markWritten(size_t dataSize, size_t offset);
     };
 }
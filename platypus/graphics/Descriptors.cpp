@@ -0,0 +1,31 @@
+#include "Descriptors.hpp"
+#include "platypus/utils/Hash.hpp"
+
+
+// Common funcs for all Descriptors implementations
+
+namespace platypus
+{
+    uint64_t DescriptorSetLayout::hash_bindings(
+        const std::vector<DescriptorSetLayoutBinding>& bindings,
+        uint64_t hash
+    )
+    {
+        hash = hash_value(bindings.size(), hash);
+        for (const DescriptorSetLayoutBinding& binding : bindings)
+        {
+            hash = hash_value(binding.getBinding(), hash);
+            hash = hash_value(binding.getType(), hash);
+            hash = hash_value(binding.getShaderStageFlags(), hash);
+            hash = hash_value(binding.getDescriptorCount(), hash);
+            hash = hash_value(binding.getBindingFlags(), hash);
+            hash = hash_value(binding.getUniformInfo().size(), hash);
+            for (const UniformInfo& uniformInfo : binding.getUniformInfo())
+            {
+                hash = hash_value(uniformInfo.type, hash);
+                hash = hash_value(uniformInfo.arrayLen, hash);
+            }
+        }
+        return hash;
+    }
+}
@@ -2,7 +2,10 @@
 
 #include "Buffers.hpp"
 #include <memory>
+#include <cstdint>
 
+// Max descriptor sets of a single underlying pool.
+// NOTE: DescriptorPool allocates more pools when this runs out
 #define PLATYPUS_MAX_DESCRIPTOR_SETS 1000
 
 
@@ -13,7 +16,23 @@ namespace platypus
         DESCRIPTOR_TYPE_NONE = 0x0,
         DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER = 0x1,
         DESCRIPTOR_TYPE_UNIFORM_BUFFER = 0x2,
-        DESCRIPTOR_TYPE_DYNAMIC_UNIFORM_BUFFER = 0x3
+        DESCRIPTOR_TYPE_DYNAMIC_UNIFORM_BUFFER = 0x3,
+        // NOTE: Desktop only atm
+        DESCRIPTOR_TYPE_STORAGE_BUFFER = 0x4
+    };
+
+    // NOTE: These require descriptor indexing -> check Device::supports_bindless_textures()
+    enum DescriptorBindingFlagBits
+    {
+        DESCRIPTOR_BINDING_FLAG_NONE = 0x0,
+        // Only the descriptors the shaders actually access need to be valid
+        DESCRIPTOR_BINDING_FLAG_PARTIALLY_BOUND_BIT = 0x1,
+        // Descriptors can be updated after the set has been bound in a command buffer
+        // that hasn't been submitted yet
+        DESCRIPTOR_BINDING_FLAG_UPDATE_AFTER_BIND_BIT = 0x2,
+        // Descriptors not used by pending command buffers can be updated
+        // while the set is in use by them
+        DESCRIPTOR_BINDING_FLAG_UPDATE_UNUSED_WHILE_PENDING_BIT = 0x4
     };
 
 
@@ -59,6 +78,7 @@ namespace platypus
         uint32_t _descriptorCount = 0;
 
         std::vector<UniformInfo> _uniformInfo;
+        uint32_t _bindingFlags = DescriptorBindingFlagBits::DESCRIPTOR_BINDING_FLAG_NONE;
 
     public:
 
@@ -72,13 +92,15 @@ namespace platypus
             uint32_t descriptorCount,
             DescriptorType type,
             unsigned int shaderStageFlags,
-            std::vector<UniformInfo> uniformInfo
+            std::vector<UniformInfo> uniformInfo,
+            uint32_t bindingFlags = DescriptorBindingFlagBits::DESCRIPTOR_BINDING_FLAG_NONE
         ) :
             _binding(binding),
             _type(type),
             _shaderStageFlags(shaderStageFlags),
             _descriptorCount(descriptorCount),
-            _uniformInfo(uniformInfo)
+            _uniformInfo(uniformInfo),
+            _bindingFlags(bindingFlags)
         {}
 
         DescriptorSetLayoutBinding(const DescriptorSetLayoutBinding& other) :
@@ -86,7 +108,8 @@ namespace platypus
             _type(other._type),
             _shaderStageFlags(other._shaderStageFlags),
             _descriptorCount(other._descriptorCount),
-            _uniformInfo(other._uniformInfo)
+            _uniformInfo(other._uniformInfo),
+            _bindingFlags(other._bindingFlags)
         {}
 
         ~DescriptorSetLayoutBinding() {}
@@ -97,7 +120,8 @@ namespace platypus
                 _type == other._type &&
                 _shaderStageFlags == other._shaderStageFlags &&
                 _descriptorCount == other._descriptorCount &&
-                _uniformInfo == other._uniformInfo;
+                _uniformInfo == other._uniformInfo &&
+                _bindingFlags == other._bindingFlags;
         }
 
         inline uint32_t getBinding() const { return _binding; }
@@ -105,10 +129,13 @@ namespace platypus
         inline uint32_t getShaderStageFlags() const { return _shaderStageFlags; }
         inline uint32_t getDescriptorCount() const { return _descriptorCount; }
         inline const std::vector<UniformInfo>& getUniformInfo() const { return _uniformInfo; }
+        inline uint32_t getBindingFlags() const { return _bindingFlags; }
     };
 
 
     struct DescriptorSetLayoutImpl;
+    // NOTE: Layouts with identical bindings share the same underlying layout on desktop.
+    // Each layout created with bindings still has to be destroyed once by its owner.
     class DescriptorSetLayout
     {
     private:
@@ -129,6 +156,8 @@ namespace platypus
 
         bool operator==(const DescriptorSetLayout& other) const { return _bindings == other._bindings; }
 
+        static uint64_t hash_bindings(const std::vector<DescriptorSetLayoutBinding>& bindings, uint64_t hash);
+
         inline const std::vector<DescriptorSetLayoutBinding>& getBindings() const { return _bindings; }
         inline const DescriptorSetLayoutImpl* getImpl() const { return _pImpl; }
     };
@@ -169,10 +198,12 @@ namespace platypus
 
         ~DescriptorSet();
 
+        // arrayElement is the index in the binding's descriptor array
         void update(
             DescriptorPool& descriptorPool,
             uint32_t binding,
-            DescriptorSetComponent component
+            DescriptorSetComponent component,
+            uint32_t arrayElement = 0
         );
 
         inline const DescriptorSetImpl* getImpl() const { return _pImpl.get(); }
@@ -185,15 +216,12 @@ namespace platypus
     {
     private:
         DescriptorPoolImpl* _pImpl = nullptr;
+        // Per underlying pool
         size_t _maxDescriptorSets = 0;
 
     public:
-        // NOTE: This requires swapchain ONLY to figure out how
-        // many descriptor sets can be allocated depending which
-        // depends on number of frames in flight!
-        // TODO: Maybe just have hard limit of descriptor sets
-        // per pool, no matter the num of frames in flight?
-        // DESCRIPTOR POOL SHOULD NOT "DEPEND" ON SWAPCHAIN!
+        // NOTE: maxDescriptorSets is the size of a single underlying pool.
+        // When a pool runs out, new one gets created and chained to the previous ones.
         DescriptorPool(size_t maxDescriptorSets);
         ~DescriptorPool();
 
@@ -202,7 +230,20 @@ namespace platypus
             const std::vector<DescriptorSetComponent>& components
         );
 
+        // Transient descriptor sets live only for a single frame and can't be freed individually.
+        // All transient sets of the frame get freed at once by resetTransientDescriptorSets()
+        // when the frame is being rendered the next time.
+        DescriptorSet createTransientDescriptorSet(
+            const DescriptorSetLayout& layout,
+            const std::vector<DescriptorSetComponent>& components,
+            size_t frame
+        );
+
         void freeDescriptorSets(const std::vector<DescriptorSet>& descriptorSets);
+
+        // NOTE: Frame's previous submission has to be completed before calling this!
+        void resetTransientDescriptorSets(size_t frame);
+
         inline DescriptorPoolImpl* getImpl() { return _pImpl; }
     };
 }
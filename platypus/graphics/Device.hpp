@@ -9,6 +9,10 @@
 #include <algorithm>
 
 
+// *On vulkan, pipelines are created through a pipeline cache which is loaded from
+// this file on Device::create and saved on Device::destroy.
+#define PLATYPUS_PIPELINE_CACHE_FILEPATH "pipeline-cache.bin"
+
 namespace platypus
 {
     struct DeviceImpl;
@@ -19,12 +23,14 @@ namespace platypus
         static Window* s_pWindow;
         static DescriptorPool* s_pDescriptorPool;
         static size_t s_minUniformBufferOffsetAlignment;
+        // 0 if bindless textures aren't supported
+        static uint32_t s_maxBindlessTextures;
         static CommandPool* s_pCommandPool;
         static std::vector<ImageFormat> s_supportedDepthFormats;
         static std::vector<ImageFormat> s_supportedColorFormats;
 
     public:
-        // TODO: Multiple descriptor pools
+        // NOTE: maxDescriptorSets is the size of a single pool in the descriptor pool's chain
         static void create(Window* pWindow, size_t maxDescriptorSets);
         static void destroy();
 
@@ -42,12 +48,32 @@ namespace platypus
         // by these operations
         static void wait_for_operations();
 
+        // *On vulkan side buffer and texture uploads are recorded into batches instead of
+        // waiting for each copy to finish. Recorded uploads are submitted automatically
+        // with the next frame, these are for submitting or waiting for them explicitly.
+        // *On web uploads happen immediately -> these do nothing.
+        static void submit_uploads();
+        static void wait_for_uploads();
+
         // *On vulkan, required to re query swapchain support details to recreate swapchain
         static void handle_window_resize();
 
+        // *On vulkan, writes the pipeline cache to PLATYPUS_PIPELINE_CACHE_FILEPATH.
+        // Done automatically on Device::destroy, but can be done earlier as well,
+        // so the created pipelines don't get lost if the app doesn't exit cleanly.
+        // *On web does nothing.
+        static void save_pipeline_cache();
+
         // Required for descriptor sets using dynamic offsets of uniform buffers.
         static size_t get_min_uniform_buffer_offset_align();
 
+        // *On vulkan, bindless textures require VK_EXT_descriptor_indexing with
+        // partially bound, update after bind and runtime sized sampler arrays.
+        // *On web always false.
+        static bool supports_bindless_textures() { return s_maxBindlessTextures > 0; }
+        // Max number of textures a single bindless texture array can have
+        static uint32_t get_max_bindless_textures() { return s_maxBindlessTextures; }
+
         static DescriptorPool* get_descriptor_pool();
         static CommandPool* get_command_pool();
 
@@ -88,7 +88,10 @@ namespace platypus
         uint32_t _pushConstantStageFlags = 0;
 
     public:
-        // NOTE: All pipelines currently uses the swapchain's extent as viewport extent
+        // NOTE: Viewport and scissor are always dynamic state
+        //  -> pipelines don't depend on the framebuffer's size, but
+        //  render::set_viewport() and render::set_scissor() has to be
+        //  called after binding the pipeline
         Pipeline(
             const RenderPass* pRenderPass,
             const std::vector<VertexBufferLayout>& vertexBufferLayouts,
@@ -0,0 +1,164 @@
+#include "PipelineRegistry.hpp"
+#include "platypus/core/Debug.hpp"
+#include "platypus/utils/Hash.hpp"
+
+
+namespace platypus
+{
+    bool PipelineDescription::operator==(const PipelineDescription& other) const
+    {
+        return pRenderPass == other.pRenderPass &&
+            vertexShaderFilename == other.vertexShaderFilename &&
+            fragmentShaderFilename == other.fragmentShaderFilename &&
+            vertexBufferLayouts == other.vertexBufferLayouts &&
+            descriptorSetLayouts == other.descriptorSetLayouts &&
+            cullMode == other.cullMode &&
+            frontFace == other.frontFace &&
+            enableDepthTest == other.enableDepthTest &&
+            enableDepthWrite == other.enableDepthWrite &&
+            depthCmpOp == other.depthCmpOp &&
+            enableColorBlending == other.enableColorBlending &&
+            pushConstantSize == other.pushConstantSize &&
+            pushConstantStageFlags == other.pushConstantStageFlags;
+    }
+
+    uint64_t PipelineDescription::hash() const
+    {
+        uint64_t hash = hash_value(pRenderPass);
+        hash = hash_data(vertexShaderFilename.data(), vertexShaderFilename.size() + 1, hash);
+        hash = hash_data(fragmentShaderFilename.data(), fragmentShaderFilename.size() + 1, hash);
+
+        // NOTE: Layouts' bindings are their indices
+        hash = hash_value(vertexBufferLayouts.size(), hash);
+        for (const VertexBufferLayout& layout : vertexBufferLayouts)
+        {
+            hash = hash_value(layout.getInputRate(), hash);
+            hash = hash_value(layout.getStride(), hash);
+            hash = hash_value(layout.getElements().size(), hash);
+            for (const VertexBufferElement& element : layout.getElements())
+            {
+                hash = hash_value(element.getLocation(), hash);
+                hash = hash_value(element.getDataType(), hash);
+                hash = hash_value(element.getAttribType(), hash);
+            }
+        }
+
+        hash = hash_value(descriptorSetLayouts.size(), hash);
+        for (const DescriptorSetLayout& layout : descriptorSetLayouts)
+            hash = DescriptorSetLayout::hash_bindings(layout.getBindings(), hash);
+
+        hash = hash_value(cullMode, hash);
+        hash = hash_value(frontFace, hash);
+        hash = hash_value(enableDepthTest, hash);
+        hash = hash_value(enableDepthWrite, hash);
+        hash = hash_value(depthCmpOp, hash);
+        hash = hash_value(enableColorBlending, hash);
+        hash = hash_value(pushConstantSize, hash);
+        hash = hash_value(pushConstantStageFlags, hash);
+        return hash;
+    }
+
+    PipelineRegistry::~PipelineRegistry()
+    {
+        if (!_pipelineHashes.empty())
+        {
+            Debug::log(
+                std::to_string(_pipelineHashes.size()) + " pipelines were still in use. "
+                "Destroying those anyway",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_WARNING
+            );
+        }
+        std::unordered_map<uint64_t, std::vector<RegistryEntry*>>::iterator it;
+        for (it = _entries.begin(); it != _entries.end(); ++it)
+        {
+            for (RegistryEntry* pEntry : it->second)
+                delete pEntry;
+        }
+    }
+
+    Pipeline* PipelineRegistry::acquirePipeline(const PipelineDescription& description)
+    {
+        const uint64_t hash = description.hash();
+        std::vector<RegistryEntry*>& entries = _entries[hash];
+        for (RegistryEntry* pEntry : entries)
+        {
+            if (pEntry->description == description)
+            {
+                ++pEntry->referenceCount;
+                ++_sharedCount;
+                return pEntry->pPipeline;
+            }
+        }
+
+        Debug::log(
+            "Creating pipeline using shaders:\n    " + description.vertexShaderFilename + "\n    " + description.fragmentShaderFilename
+        );
+        RegistryEntry* pEntry = new RegistryEntry;
+        pEntry->description = description;
+        pEntry->pVertexShader = new Shader(
+            description.vertexShaderFilename,
+            ShaderStageFlagBits::SHADER_STAGE_VERTEX_BIT
+        );
+        pEntry->pFragmentShader = new Shader(
+            description.fragmentShaderFilename,
+            ShaderStageFlagBits::SHADER_STAGE_FRAGMENT_BIT
+        );
+        pEntry->pPipeline = new Pipeline(
+            description.pRenderPass,
+            description.vertexBufferLayouts,
+            description.descriptorSetLayouts,
+            pEntry->pVertexShader,
+            pEntry->pFragmentShader,
+            description.cullMode,
+            description.frontFace,
+            description.enableDepthTest,
+            description.enableDepthWrite,
+            description.depthCmpOp,
+            description.enableColorBlending,
+            description.pushConstantSize,
+            description.pushConstantStageFlags
+        );
+        pEntry->pPipeline->create();
+        pEntry->referenceCount = 1;
+
+        entries.push_back(pEntry);
+        _pipelineHashes[pEntry->pPipeline] = hash;
+        ++_createdCount;
+        return pEntry->pPipeline;
+    }
+
+    void PipelineRegistry::releasePipeline(const Pipeline* pPipeline)
+    {
+        std::unordered_map<const Pipeline*, uint64_t>::iterator hashIt = _pipelineHashes.find(pPipeline);
+        if (hashIt == _pipelineHashes.end())
+        {
+            Debug::log(
+                "Pipeline wasn't acquired from this registry",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            PLATYPUS_ASSERT(false);
+            return;
+        }
+
+        std::vector<RegistryEntry*>& entries = _entries[hashIt->second];
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            RegistryEntry* pEntry = entries[i];
+            if (pEntry->pPipeline != pPipeline)
+                continue;
+
+            --pEntry->referenceCount;
+            if (pEntry->referenceCount == 0)
+            {
+                delete pEntry;
+                entries.erase(entries.begin() + i);
+                if (entries.empty())
+                    _entries.erase(hashIt->second);
+                _pipelineHashes.erase(hashIt);
+            }
+            return;
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Pipeline.hpp"
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+
+namespace platypus
+{
+    // Everything that makes a pipeline unique.
+    // NOTE: Descriptor set layouts are compared by their bindings, not by their handles.
+    // Identically defined layouts are compatible, so for example all Materials having
+    // the same textures can share pipelines even if each has its own layout.
+    struct PipelineDescription
+    {
+        const RenderPass* pRenderPass = nullptr;
+        std::string vertexShaderFilename;
+        std::string fragmentShaderFilename;
+        std::vector<VertexBufferLayout> vertexBufferLayouts;
+        std::vector<DescriptorSetLayout> descriptorSetLayouts;
+        CullMode cullMode = CullMode::CULL_MODE_BACK;
+        FrontFace frontFace = FrontFace::FRONT_FACE_COUNTER_CLOCKWISE;
+        bool enableDepthTest = true;
+        bool enableDepthWrite = true;
+        DepthCompareOperation depthCmpOp = DepthCompareOperation::COMPARE_OP_LESS;
+        bool enableColorBlending = true;
+        uint32_t pushConstantSize = 0;
+        uint32_t pushConstantStageFlags = 0;
+
+        bool operator==(const PipelineDescription& other) const;
+        uint64_t hash() const;
+    };
+
+
+    // Owns all pipelines (and their shaders) created through it.
+    // Acquiring a pipeline with a description matching an existing one returns the
+    // existing pipeline instead of creating a new one. Pipelines are reference counted
+    // and destroyed when the last user releases them.
+    class PipelineRegistry
+    {
+    private:
+        struct RegistryEntry
+        {
+            PipelineDescription description;
+            Shader* pVertexShader = nullptr;
+            Shader* pFragmentShader = nullptr;
+            Pipeline* pPipeline = nullptr;
+            size_t referenceCount = 0;
+            ~RegistryEntry()
+            {
+                // NOTE: IMPORTANT to destroy pipeline before shaders since
+                // web impl detaches the shaders from the opengl shader program
+                // when destroying the pipeline!
+                delete pPipeline;
+                delete pVertexShader;
+                delete pFragmentShader;
+            }
+        };
+
+        // key = description's hash
+        // NOTE: Multiple entries only if hashes collide
+        std::unordered_map<uint64_t, std::vector<RegistryEntry*>> _entries;
+        std::unordered_map<const Pipeline*, uint64_t> _pipelineHashes;
+
+        size_t _createdCount = 0;
+        size_t _sharedCount = 0;
+
+    public:
+        PipelineRegistry() = default;
+        PipelineRegistry(const PipelineRegistry& other) = delete;
+        ~PipelineRegistry();
+
+        // Returns existing pipeline matching the description or creates a new one.
+        // Each acquire needs to be matched with releasePipeline()
+        Pipeline* acquirePipeline(const PipelineDescription& description);
+        void releasePipeline(const Pipeline* pPipeline);
+
+        inline size_t getPipelineCount() const { return _pipelineHashes.size(); }
+        // How many pipeline creations were avoided by sharing existing pipelines
+        inline size_t getSharedCount() const { return _sharedCount; }
+        inline size_t getCreatedCount() const { return _createdCount; }
+    };
+}
@@ -87,10 +87,13 @@ namespace platypus
             const std::vector<uint32_t>& offsets
         );
 
+        // NOTE: firstInstance isn't supported on web (no base instance in WebGL2)
+        //  -> has to be 0 there!
         void draw_indexed(
             const CommandBuffer& commandBuffer,
             uint32_t count,
-            uint32_t instanceCount
+            uint32_t instanceCount,
+            uint32_t firstInstance = 0
         );
 
         void draw(
@@ -3,8 +3,10 @@
 #include "platypus/graphics/platform/desktop/DesktopCommandBuffer.hpp"
 #include "platypus/graphics/Device.hpp"
 #include "platypus/graphics/platform/desktop/DesktopDevice.hpp"
+#include "DesktopUploadManager.hpp"
 
 #include "platypus/core/Debug.hpp"
+#include "platypus/Common.h"
 
 #include <cstring>
 #include <vulkan/vk_enum_string_helper.h>
@@ -12,52 +14,23 @@
 
 namespace platypus
 {
-    void copy_buffer(VkBuffer source, VkBuffer destination, size_t size)
-    {
-        CommandBuffer commandBuffer = Device::get_command_pool()->allocCommandBuffers(
-            1,
-            CommandBufferLevel::PRIMARY_COMMAND_BUFFER
-        )[0];
-
-        commandBuffer.beginSingleUse();
-
-        VkBufferCopy copyRegion;
-        copyRegion.srcOffset = 0;
-        copyRegion.dstOffset = 0;
-        copyRegion.size = size;
-
-        vkCmdCopyBuffer(
-            commandBuffer.getImpl()->handle,
-            source,
-            destination,
-            1,
-            &copyRegion
-        );
-
-        commandBuffer.finishSingleUse();
-    }
-
     void copy_buffer_to_image(
+        CommandBuffer& commandBuffer,
         VkBuffer source,
+        size_t sourceOffset,
         VkImage destination,
         uint32_t imageWidth,
-        uint32_t imageHeight
+        uint32_t imageHeight,
+        uint32_t mipLevel
     )
     {
-        CommandBuffer commandBuffer = Device::get_command_pool()->allocCommandBuffers(
-            1,
-            CommandBufferLevel::PRIMARY_COMMAND_BUFFER
-        )[0];
-
-        commandBuffer.beginSingleUse();
-
         VkBufferImageCopy bufferImgCpy{};
-        bufferImgCpy.bufferOffset = 0;
+        bufferImgCpy.bufferOffset = sourceOffset;
         bufferImgCpy.bufferRowLength = 0;
         bufferImgCpy.bufferImageHeight = 0;
 
         bufferImgCpy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        bufferImgCpy.imageSubresource.mipLevel = 0;
+        bufferImgCpy.imageSubresource.mipLevel = mipLevel;
         bufferImgCpy.imageSubresource.baseArrayLayer = 0;
         bufferImgCpy.imageSubresource.layerCount = 1;
 
@@ -72,8 +45,6 @@ namespace platypus
             1,
             &bufferImgCpy
         );
-
-        commandBuffer.finishSingleUse();
     }
 
     VkVertexInputRate to_vk_vertex_input_rate(VertexInputRate inputRate)
@@ -117,6 +88,8 @@ namespace platypus
             vkFlags |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
         if (flags & BufferUsageFlagBits::BUFFER_USAGE_TRANSFER_DST_BIT)
             vkFlags |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        if (flags & BufferUsageFlagBits::BUFFER_USAGE_STORAGE_BUFFER_BIT)
+            vkFlags |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
         return vkFlags;
     }
 
@@ -340,32 +313,35 @@ namespace platypus
         }
 
         bool useStaging = usageFlags & BufferUsageFlagBits::BUFFER_USAGE_TRANSFER_DST_BIT;
-        Buffer* pStagingBuffer = nullptr;
-        if (useStaging)
-        {
-            pStagingBuffer = new Buffer(
-                pData,
-                elementSize,
-                dataLength,
-                BufferUsageFlagBits::BUFFER_USAGE_TRANSFER_SRC_BIT,
-                BufferUpdateFrequency::BUFFER_UPDATE_FREQUENCY_STATIC,
-                false
-            );
-        }
+        UploadManager* pUploadManager = Device::get_impl()->pUploadManager;
 
         VkBufferCreateInfo createInfo{};
         createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
         createInfo.size = getTotalSize();
         createInfo.usage = to_vk_buffer_usage_flags(_bufferUsageFlags);
         createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        // Copied on the dedicated transfer queue and used on the graphics queue
+        //  -> shared instead of transferring the queue family ownership
+        if (useStaging && pUploadManager->hasDedicatedTransferQueue())
+        {
+            const std::vector<uint32_t>& queueFamilyIndices = pUploadManager->getQueueFamilyIndices();
+            createInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+            createInfo.queueFamilyIndexCount = (uint32_t)queueFamilyIndices.size();
+            createInfo.pQueueFamilyIndices = queueFamilyIndices.data();
+        }
 
         VmaAllocationCreateInfo allocInfo{};
 
+        // Buffers rewritten every frame are kept mapped for their whole lifetime
+        // instead of mapping and unmapping on each update
+        const bool persistentlyMapped = !useStaging && updateFrequency != BufferUpdateFrequency::BUFFER_UPDATE_FREQUENCY_STATIC;
         if (!useStaging)
         {
             allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
             allocInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
             allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+            if (persistentlyMapped)
+                allocInfo.flags |= VMA_ALLOCATION_CREATE_MAPPED_BIT;
         }
         else
         {
@@ -377,13 +353,14 @@ namespace platypus
         VmaAllocator vmaAllocator = Device::get_impl()->vmaAllocator;
         VkBuffer buffer = VK_NULL_HANDLE;
         VmaAllocation vmaAllocation = VK_NULL_HANDLE;
+        VmaAllocationInfo vmaAllocationInfo{};
         VkResult createResult = vmaCreateBuffer(
             vmaAllocator,
             &createInfo,
             &allocInfo,
             &buffer,
             &vmaAllocation,
-            nullptr
+            &vmaAllocationInfo
         );
         if (createResult != VK_SUCCESS)
         {
@@ -396,9 +373,13 @@ namespace platypus
             PLATYPUS_ASSERT(false);
         }
 
-        _pImpl = new BufferImpl{ buffer, vmaAllocation };
+        _pImpl = new BufferImpl{ buffer, vmaAllocation, persistentlyMapped ? vmaAllocationInfo.pMappedData : nullptr };
 
-        if (!useStaging)
+        if (_pImpl->pMappedData)
+        {
+            memcpy(_pImpl->pMappedData, pData, getTotalSize());
+        }
+        else if (!useStaging)
         {
             vmaCopyMemoryToAllocation(
                 vmaAllocator,
@@ -410,12 +391,9 @@ namespace platypus
         }
         else
         {
-            copy_buffer(
-                pStagingBuffer->_pImpl->handle,
-                _pImpl->handle,
-                getTotalSize()
-            );
-            delete pStagingBuffer;
+            // NOTE: Doesn't wait for the copy -> the buffer can be used by
+            // commands submitted after the upload
+            pUploadManager->recordBufferUpload(pData, getTotalSize(), _pImpl->handle);
         }
     }
 
@@ -500,4 +478,58 @@ namespace platypus
         );
         _hostSideUpdated = false;
     }
+
+    void Buffer::write(void* pData, size_t dataSize, size_t offset)
+    {
+        if (!validateUpdate(pData, dataSize, offset) || offset + dataSize > getTotalSize())
+        {
+            Debug::log(
+                "Failed to write " + std::to_string(dataSize) + " bytes at offset " + std::to_string(offset) + " "
+                "to buffer with size " + std::to_string(getTotalSize()),
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            PLATYPUS_ASSERT(false);
+            return;
+        }
+
+        if (_pData)
+            memcpy((void*)((PE_byte*)_pData + offset), pData, dataSize);
+
+        // NOTE: Static buffers aren't mapped -> those still go through vmaCopyMemoryToAllocation
+        if (!_pImpl->pMappedData)
+        {
+            updateDevice(pData, dataSize, offset);
+            return;
+        }
+        memcpy((void*)((PE_byte*)_pImpl->pMappedData + offset), pData, dataSize);
+        markWritten(dataSize, offset);
+    }
+
+    void Buffer::flush()
+    {
+        if (_writtenBegin >= _writtenEnd)
+            return;
+
+        // NOTE: Memory is currently required to be host coherent, in which case VMA skips this.
+        // Still flushing, so that non coherent memory types could be allowed later.
+        VkResult flushResult = vmaFlushAllocation(
+            Device::get_impl()->vmaAllocator,
+            _pImpl->vmaAllocation,
+            _writtenBegin,
+            _writtenEnd - _writtenBegin
+        );
+        if (flushResult != VK_SUCCESS)
+        {
+            const std::string errStr(string_VkResult(flushResult));
+            Debug::log(
+                "Failed to flush buffer(vmaFlushAllocation)! VkResult: " + errStr,
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            PLATYPUS_ASSERT(false);
+        }
+        _writtenBegin = 0;
+        _writtenEnd = 0;
+    }
 }
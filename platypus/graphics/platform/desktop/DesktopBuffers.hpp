@@ -1,6 +1,7 @@
 #pragma once
 
 #include "platypus/graphics/Buffers.hpp"
+#include "platypus/graphics/CommandBuffer.hpp"
 #include <vulkan/vulkan.h>
 #include <vk_mem_alloc.h>
 
@@ -23,16 +24,20 @@ namespace platypus
     {
         VkBuffer handle = VK_NULL_HANDLE;
         VmaAllocation vmaAllocation = VK_NULL_HANDLE;
+        // Persistently mapped memory of dynamic and stream buffers, nullptr otherwise
+        void* pMappedData = nullptr;
     };
 
 
-    void copy_buffer(VkBuffer source, VkBuffer destination, size_t size);
-
+    // Records the copy into commandBuffer
     void copy_buffer_to_image(
+        CommandBuffer& commandBuffer,
         VkBuffer source,
+        size_t sourceOffset,
         VkImage destination,
         uint32_t imageWidth,
-        uint32_t imageHeight
+        uint32_t imageHeight,
+        uint32_t mipLevel = 0
     );
 
     VkVertexInputRate to_vk_vertex_input_rate(VertexInputRate inputRate);
@@ -7,6 +7,9 @@
 #include "platypus/assets/Texture.hpp"
 #include "platypus/assets/platform/desktop/DesktopTexture.hpp"
 #include "platypus/core/Debug.hpp"
+#include "platypus/utils/Hash.hpp"
+#include <unordered_map>
+#include <algorithm>
 #include <vulkan/vk_enum_string_helper.h>
 
 
@@ -19,13 +22,16 @@ namespace platypus
             case DescriptorType::DESCRIPTOR_TYPE_UNIFORM_BUFFER: return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
             case DescriptorType::DESCRIPTOR_TYPE_DYNAMIC_UNIFORM_BUFFER: return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             case DescriptorType::DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER: return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            case DescriptorType::DESCRIPTOR_TYPE_STORAGE_BUFFER: return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
             default:
                 Debug::log(
                     "@to_vk_descriptor_type "
                     "Invalid DescriptorType: " + std::to_string(type) + " "
                     "Available types are: "
                     "DESCRIPTOR_TYPE_UNIFORM_BUFFER, "
-                    "DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER",
+                    "DESCRIPTOR_TYPE_DYNAMIC_UNIFORM_BUFFER, "
+                    "DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, "
+                    "DESCRIPTOR_TYPE_STORAGE_BUFFER",
                     Debug::MessageType::PLATYPUS_ERROR
                 );
                 PLATYPUS_ASSERT(false);
@@ -34,13 +40,23 @@ namespace platypus
     }
 
 
-    DescriptorSetLayout::DescriptorSetLayout()
+    struct CachedDescriptorSetLayout
     {
-        _pImpl = new DescriptorSetLayoutImpl;
-    }
-
-    DescriptorSetLayout::DescriptorSetLayout(const std::vector<DescriptorSetLayoutBinding>& bindings) :
-        _bindings(bindings)
+        std::vector<DescriptorSetLayoutBinding> bindings;
+        VkDescriptorSetLayout handle = VK_NULL_HANDLE;
+        size_t referenceCount = 0;
+    };
+
+    // Materials, batches, etc. create their own layouts, but most of those
+    // have identical bindings -> share the vk layouts between those.
+    // key = bindings' hash
+    // NOTE: Multiple entries only if hashes collide
+    static std::unordered_map<uint64_t, std::vector<CachedDescriptorSetLayout>> s_layoutCache;
+    static std::unordered_map<VkDescriptorSetLayout, uint64_t> s_layoutHashes;
+
+    static VkDescriptorSetLayout create_vk_descriptor_set_layout(
+        const std::vector<DescriptorSetLayoutBinding>& bindings
+    )
     {
         // NOTE: Not sure is zero initialization quaranteed here always?
         std::vector<VkDescriptorSetLayoutBinding> vkLayoutBindings(bindings.size());
@@ -58,6 +74,29 @@ namespace platypus
         createInfo.bindingCount = (uint32_t)vkLayoutBindings.size();
         createInfo.pBindings = vkLayoutBindings.data();
 
+        std::vector<VkDescriptorBindingFlagsEXT> vkBindingFlags(bindings.size(), 0);
+        bool useBindingFlags = false;
+        for (size_t i = 0; i < bindings.size(); ++i)
+        {
+            const uint32_t bindingFlags = bindings[i].getBindingFlags();
+            if (bindingFlags & DescriptorBindingFlagBits::DESCRIPTOR_BINDING_FLAG_PARTIALLY_BOUND_BIT)
+                vkBindingFlags[i] |= VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT;
+            if (bindingFlags & DescriptorBindingFlagBits::DESCRIPTOR_BINDING_FLAG_UPDATE_AFTER_BIND_BIT)
+            {
+                vkBindingFlags[i] |= VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT;
+                createInfo.flags |= VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+            }
+            if (bindingFlags & DescriptorBindingFlagBits::DESCRIPTOR_BINDING_FLAG_UPDATE_UNUSED_WHILE_PENDING_BIT)
+                vkBindingFlags[i] |= VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT;
+            useBindingFlags |= bindingFlags != DescriptorBindingFlagBits::DESCRIPTOR_BINDING_FLAG_NONE;
+        }
+        VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsCreateInfo{};
+        bindingFlagsCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+        bindingFlagsCreateInfo.bindingCount = (uint32_t)vkBindingFlags.size();
+        bindingFlagsCreateInfo.pBindingFlags = vkBindingFlags.data();
+        if (useBindingFlags)
+            createInfo.pNext = &bindingFlagsCreateInfo;
+
         VkDescriptorSetLayout handle = VK_NULL_HANDLE;
         VkResult createResult = vkCreateDescriptorSetLayout(
             Device::get_impl()->device,
@@ -70,15 +109,88 @@ namespace platypus
         {
             const std::string resultStr(string_VkResult(createResult));
             Debug::log(
-                "@DescriptorSetLayout::DescriptorSetLayout "
                 "Failed to create descriptor set layout! VkResult: " + resultStr,
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            PLATYPUS_ASSERT(false);
+        }
+        return handle;
+    }
+
+    static VkDescriptorSetLayout acquire_descriptor_set_layout(
+        const std::vector<DescriptorSetLayoutBinding>& bindings
+    )
+    {
+        const uint64_t hash = DescriptorSetLayout::hash_bindings(bindings, hash_offset_basis);
+        std::vector<CachedDescriptorSetLayout>& entries = s_layoutCache[hash];
+        for (CachedDescriptorSetLayout& entry : entries)
+        {
+            if (entry.bindings == bindings)
+            {
+                ++entry.referenceCount;
+                return entry.handle;
+            }
+        }
+
+        CachedDescriptorSetLayout entry;
+        entry.bindings = bindings;
+        entry.handle = create_vk_descriptor_set_layout(bindings);
+        entry.referenceCount = 1;
+        entries.push_back(entry);
+        s_layoutHashes[entry.handle] = hash;
+        return entry.handle;
+    }
+
+    static void release_descriptor_set_layout(VkDescriptorSetLayout handle)
+    {
+        std::unordered_map<VkDescriptorSetLayout, uint64_t>::iterator hashIt = s_layoutHashes.find(handle);
+        if (hashIt == s_layoutHashes.end())
+        {
+            Debug::log(
+                "Descriptor set layout wasn't found from the layout cache",
+                PLATYPUS_CURRENT_FUNC_NAME,
                 Debug::MessageType::PLATYPUS_ERROR
             );
             PLATYPUS_ASSERT(false);
+            return;
+        }
+
+        std::vector<CachedDescriptorSetLayout>& entries = s_layoutCache[hashIt->second];
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            CachedDescriptorSetLayout& entry = entries[i];
+            if (entry.handle != handle)
+                continue;
+
+            --entry.referenceCount;
+            if (entry.referenceCount == 0)
+            {
+                vkDestroyDescriptorSetLayout(
+                    Device::get_impl()->device,
+                    entry.handle,
+                    nullptr
+                );
+                entries.erase(entries.begin() + i);
+                if (entries.empty())
+                    s_layoutCache.erase(hashIt->second);
+                s_layoutHashes.erase(hashIt);
+            }
+            return;
         }
+    }
+
+
+    DescriptorSetLayout::DescriptorSetLayout()
+    {
+        _pImpl = new DescriptorSetLayoutImpl;
+    }
 
+    DescriptorSetLayout::DescriptorSetLayout(const std::vector<DescriptorSetLayoutBinding>& bindings) :
+        _bindings(bindings)
+    {
         _pImpl = new DescriptorSetLayoutImpl;
-        _pImpl->handle = handle;
+        _pImpl->handle = acquire_descriptor_set_layout(bindings);
     }
 
     DescriptorSetLayout::DescriptorSetLayout(const DescriptorSetLayout& other) :
@@ -121,11 +233,10 @@ namespace platypus
 
     void DescriptorSetLayout::destroy()
     {
-        vkDestroyDescriptorSetLayout(
-            Device::get_impl()->device,
-            _pImpl->handle,
-            nullptr
-        );
+        // NOTE: Actual vk layout gets destroyed when all layouts sharing it are destroyed
+        if (!_pImpl || _pImpl->handle == VK_NULL_HANDLE)
+            return;
+        release_descriptor_set_layout(_pImpl->handle);
         _pImpl->handle = VK_NULL_HANDLE;
     }
 
@@ -160,20 +271,14 @@ namespace platypus
     }
 
 
-    // NOTE: Might be danger here? Not sure how to associate _components and bindings
-    //  -> I think the components are logically for each binding...
-    void DescriptorSet::update(
-        DescriptorPool& descriptorPool,
-        uint32_t binding,
-        DescriptorSetComponent component
+    // Returns true if the component is an image -> imageInfo was filled instead of bufferInfo
+    static bool fill_descriptor_info(
+        const DescriptorSetComponent& component,
+        VkDescriptorBufferInfo& bufferInfo,
+        VkDescriptorImageInfo& imageInfo
     )
     {
         DescriptorType type = component.type;
-
-        VkDescriptorBufferInfo bufferInfo{};
-        VkDescriptorImageInfo imageInfo{};
-
-        bool isTexture = false;
         if (type == DescriptorType::DESCRIPTOR_TYPE_UNIFORM_BUFFER || type == DescriptorType::DESCRIPTOR_TYPE_DYNAMIC_UNIFORM_BUFFER)
         {
             // NOTE: Danger?
@@ -187,9 +292,16 @@ namespace platypus
             //  -> YOU JUST NEED TO BE CAREFUL THAT YOU PROVIDE THE CORRECT ELEMENT SIZE!
             bufferInfo.range = pBuffer->getDataElemSize();
         }
+        else if (type == DescriptorType::DESCRIPTOR_TYPE_STORAGE_BUFFER)
+        {
+            // Storage buffers are indexed in the shader -> whole buffer
+            const Buffer* pBuffer = (const Buffer*)component.pData;
+            bufferInfo.buffer = pBuffer->getImpl()->handle;
+            bufferInfo.offset = 0;
+            bufferInfo.range = pBuffer->getTotalSize();
+        }
         else if (type == DescriptorType::DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER)
         {
-            isTexture = true;
             // NOTE: Danger?
             const Texture* pTexture = (const Texture*)component.pData;
             // NOTE: JUST TESTING ATM!
@@ -198,28 +310,47 @@ namespace platypus
             else
                 imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 
+            PLATYPUS_ASSERT(pTexture);
+            PLATYPUS_ASSERT(pTexture->getTextureSampler());
+            PLATYPUS_ASSERT(pTexture->getTextureSampler()->getImpl());
+            PLATYPUS_ASSERT(pTexture->getTextureSampler()->getImpl()->handle);
             imageInfo.imageView = pTexture->getImpl()->imageView;
             imageInfo.sampler = pTexture->getTextureSampler()->getImpl()->handle;
+            return true;
         }
         else
         {
             Debug::log(
-                "@DescriptorSet::update "
-                "Invalid descriptor type for binding: " + std::to_string(binding),
+                "Invalid descriptor type: " + std::to_string(type),
+                PLATYPUS_CURRENT_FUNC_NAME,
                 Debug::MessageType::PLATYPUS_ERROR
             );
             PLATYPUS_ASSERT(false);
         }
+        return false;
+    }
+
+
+    // NOTE: Might be danger here? Not sure how to associate _components and bindings
+    //  -> I think the components are logically for each binding...
+    void DescriptorSet::update(
+        DescriptorPool& descriptorPool,
+        uint32_t binding,
+        DescriptorSetComponent component,
+        uint32_t arrayElement
+    )
+    {
+        VkDescriptorBufferInfo bufferInfo{};
+        VkDescriptorImageInfo imageInfo{};
+        bool isTexture = fill_descriptor_info(component, bufferInfo, imageInfo);
 
-        // NOTE: No idea is this going to work...
-        // need to write to multiple bindings in some cases...
         VkWriteDescriptorSet descriptorWrite{};
         descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
         descriptorWrite.descriptorCount = 1;
         descriptorWrite.dstSet = _pImpl->handle;
         descriptorWrite.dstBinding = binding;
-        descriptorWrite.dstArrayElement = 0; // if using array descriptors, this is the first index in the array..
-        descriptorWrite.descriptorType = to_vk_descriptor_type(type);
+        descriptorWrite.dstArrayElement = arrayElement;
+        descriptorWrite.descriptorType = to_vk_descriptor_type(component.type);
 
         if (!isTexture)
             descriptorWrite.pBufferInfo = &bufferInfo;
@@ -238,40 +369,23 @@ namespace platypus
     }
 
 
-    static VkDescriptorSet alloc_descriptor_set(
-        VkDescriptorPool vkDescriptorPool,
-        const DescriptorSetLayout& layout
-    )
+    static bool requires_update_after_bind(const DescriptorSetLayout& layout)
     {
-        VkDescriptorSetAllocateInfo allocInfo{};
-        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        allocInfo.descriptorPool = vkDescriptorPool;
-        allocInfo.descriptorSetCount = 1;
-        allocInfo.pSetLayouts = &(layout.getImpl()->handle);
-
-        VkDescriptorSet descriptorSetHandle;
-        VkDevice device = Device::get_impl()->device;
-        VkResult allocResult = vkAllocateDescriptorSets(
-            device,
-            &allocInfo,
-            &descriptorSetHandle
-        );
-        if (allocResult != VK_SUCCESS)
+        for (const DescriptorSetLayoutBinding& binding : layout.getBindings())
         {
-            const std::string resultStr(string_VkResult(allocResult));
-            Debug::log(
-                "@alloc_descriptor_set "
-                "Failed to allocate descriptor set! VkResult: " + resultStr,
-                Debug::MessageType::PLATYPUS_ERROR
-            );
-            PLATYPUS_ASSERT(false);
+            if (binding.getBindingFlags() & DescriptorBindingFlagBits::DESCRIPTOR_BINDING_FLAG_UPDATE_AFTER_BIND_BIT)
+                return true;
         }
-        return descriptorSetHandle;
+        return false;
     }
 
-
-    DescriptorPool::DescriptorPool(size_t maxDescriptorSets) :
-        _maxDescriptorSets(maxDescriptorSets)
+    // NOTE: The pool is made big enough to fit at least a single set of the layout
+    // which is the case with large descriptor arrays.
+    static VkDescriptorPool create_vk_descriptor_pool(
+        uint32_t maxDescriptorSets,
+        VkDescriptorPoolCreateFlags flags,
+        const DescriptorSetLayout& layout
+    )
     {
         std::vector<VkDescriptorPoolSize> poolSizes;
 
@@ -279,18 +393,24 @@ namespace platypus
         {
             DescriptorType::DESCRIPTOR_TYPE_UNIFORM_BUFFER,
             DescriptorType::DESCRIPTOR_TYPE_DYNAMIC_UNIFORM_BUFFER,
-            DescriptorType::DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER
+            DescriptorType::DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            DescriptorType::DESCRIPTOR_TYPE_STORAGE_BUFFER
         };
 
         for (size_t i = 0; i < types.size(); ++i)
         {
+            uint32_t layoutDescriptorCount = 0;
+            for (const DescriptorSetLayoutBinding& binding : layout.getBindings())
+            {
+                if (binding.getType() == types[i])
+                    layoutDescriptorCount += binding.getDescriptorCount();
+            }
             // NOTE: poolSizes have the max allocateable(eng?:D) descriptors
-            // NOT SETS! But atm its' fine to have it be just the _maxDescriptorSets val...
-            //  -> IN THE FUTURE THIS WILL MATTER!!!
-            const uint32_t maxDescriptors = static_cast<uint32_t>(_maxDescriptorSets);
+            // NOT SETS! But atm its' fine to have it be just the maxDescriptorSets val...
+            //  -> If some type runs out first, the next pool in the chain gets used
             VkDescriptorPoolSize poolSize{};
             poolSize.type = to_vk_descriptor_type(types[i]);
-            poolSize.descriptorCount = maxDescriptors;
+            poolSize.descriptorCount = std::max(maxDescriptorSets, layoutDescriptorCount);
             poolSizes.push_back(poolSize);
         }
 
@@ -298,8 +418,8 @@ namespace platypus
         createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
         createInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
         createInfo.pPoolSizes = poolSizes.data();
-        createInfo.maxSets = static_cast<uint32_t>(_maxDescriptorSets);
-        createInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+        createInfo.maxSets = maxDescriptorSets;
+        createInfo.flags = flags;
 
         VkDescriptorPool handle = VK_NULL_HANDLE;
         VkResult createResult = vkCreateDescriptorPool(
@@ -312,14 +432,169 @@ namespace platypus
         {
             const std::string resultStr(string_VkResult(createResult));
             Debug::log(
-                "@DescriptorPool::DescriptorPool "
                 "Failed to create descriptor pool! VkResult: " + resultStr,
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            PLATYPUS_ASSERT(false);
+        }
+        return handle;
+    }
+
+    static void destroy_descriptor_pool_chain(DescriptorPoolChain& chain)
+    {
+        for (VkDescriptorPool handle : chain.handles)
+            vkDestroyDescriptorPool(Device::get_impl()->device, handle, nullptr);
+        chain.handles.clear();
+        chain.currentIndex = 0;
+    }
+
+    // NOTE: VK_ERROR_OUT_OF_POOL_MEMORY requires Vulkan 1.1
+    static bool is_pool_full(VkResult allocResult)
+    {
+        return allocResult == VK_ERROR_OUT_OF_POOL_MEMORY || allocResult == VK_ERROR_FRAGMENTED_POOL;
+    }
+
+    // Tries the chain's pools starting from the current one and
+    // adds a new pool to the chain if all of them are full.
+    static VkDescriptorSet alloc_descriptor_set(
+        DescriptorPoolChain& chain,
+        uint32_t maxDescriptorSets,
+        VkDescriptorPoolCreateFlags poolFlags,
+        const DescriptorSetLayout& layout,
+        VkDescriptorPool* pOutPoolHandle
+    )
+    {
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &(layout.getImpl()->handle);
+
+        VkDescriptorSet descriptorSetHandle = VK_NULL_HANDLE;
+        VkDevice device = Device::get_impl()->device;
+        VkResult allocResult = VK_ERROR_OUT_OF_POOL_MEMORY;
+        // NOTE: Going through the earlier pools as well, since the freed sets
+        // leave free space into those
+        const size_t poolCount = chain.handles.size();
+        for (size_t i = 0; i < poolCount; ++i)
+        {
+            const size_t poolIndex = (chain.currentIndex + i) % poolCount;
+            allocInfo.descriptorPool = chain.handles[poolIndex];
+            allocResult = vkAllocateDescriptorSets(device, &allocInfo, &descriptorSetHandle);
+            if (allocResult == VK_SUCCESS)
+            {
+                chain.currentIndex = poolIndex;
+                break;
+            }
+            if (!is_pool_full(allocResult))
+                break;
+        }
+
+        if (is_pool_full(allocResult))
+        {
+            chain.handles.push_back(create_vk_descriptor_pool(maxDescriptorSets, poolFlags, layout));
+            chain.currentIndex = chain.handles.size() - 1;
+            allocInfo.descriptorPool = chain.handles.back();
+            allocResult = vkAllocateDescriptorSets(device, &allocInfo, &descriptorSetHandle);
+            if (poolCount > 0)
+            {
+                Debug::log(
+                    "All descriptor pools were full. "
+                    "Pool count is now: " + std::to_string(chain.handles.size())
+                );
+            }
+        }
+
+        if (allocResult != VK_SUCCESS)
+        {
+            const std::string resultStr(string_VkResult(allocResult));
+            Debug::log(
+                "Failed to allocate descriptor set! VkResult: " + resultStr,
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            PLATYPUS_ASSERT(false);
+        }
+        *pOutPoolHandle = allocInfo.descriptorPool;
+        return descriptorSetHandle;
+    }
+
+    // Writes all bindings of the descriptor set using a single vkUpdateDescriptorSets call
+    static void write_descriptor_set(
+        VkDescriptorSet descriptorSetHandle,
+        const DescriptorSetLayout& layout,
+        const std::vector<DescriptorSetComponent>& components
+    )
+    {
+        const std::vector<DescriptorSetLayoutBinding>& bindings = layout.getBindings();
+        if (bindings.size() != components.size())
+        {
+            Debug::log(
+                "Component required for each layout's binding! "
+                "Provided bindings: " + std::to_string(bindings.size()) + " "
+                "components: " + std::to_string(components.size()),
+                PLATYPUS_CURRENT_FUNC_NAME,
                 Debug::MessageType::PLATYPUS_ERROR
             );
             PLATYPUS_ASSERT(false);
+            return;
+        }
+
+        // NOTE: Writes point to these, so these can't be resized after the writes are created!
+        std::vector<VkDescriptorBufferInfo> bufferInfos(bindings.size());
+        std::vector<VkDescriptorImageInfo> imageInfos(bindings.size());
+        std::vector<VkWriteDescriptorSet> descriptorWrites(bindings.size());
+
+        for (size_t i = 0; i < bindings.size(); ++i)
+        {
+            const DescriptorSetLayoutBinding& binding = bindings[i];
+
+            DescriptorType bindingType = binding.getType();
+            if (components[i].type != bindingType)
+            {
+                Debug::log(
+                    "Invalid descriptor set component type: " + std::to_string(components[i].type) + " " +
+                    "for binding at index: " + std::to_string(i) + " " +
+                    "binding is using type: " + std::to_string(bindingType),
+                    PLATYPUS_CURRENT_FUNC_NAME,
+                    Debug::MessageType::PLATYPUS_ERROR
+                );
+                PLATYPUS_ASSERT(false);
+            }
+            bool isTexture = fill_descriptor_info(components[i], bufferInfos[i], imageInfos[i]);
+
+            VkWriteDescriptorSet& descriptorWrite = descriptorWrites[i];
+            descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptorWrite.descriptorCount = 1;
+            descriptorWrite.dstSet = descriptorSetHandle;
+            descriptorWrite.dstBinding = binding.getBinding();
+            descriptorWrite.dstArrayElement = 0; // if using array descriptors, this is the first index in the array..
+            descriptorWrite.descriptorType = to_vk_descriptor_type(bindingType);
+
+            if (!isTexture)
+                descriptorWrite.pBufferInfo = &bufferInfos[i];
+            else
+                descriptorWrite.pImageInfo = &imageInfos[i];
+
+            descriptorWrite.pTexelBufferView = nullptr; // what this?
         }
+
+        vkUpdateDescriptorSets(
+            Device::get_impl()->device,
+            (uint32_t)descriptorWrites.size(),
+            descriptorWrites.data(),
+            0,
+            nullptr
+        );
+    }
+
+
+    DescriptorPool::DescriptorPool(size_t maxDescriptorSets) :
+        _maxDescriptorSets(maxDescriptorSets)
+    {
+        // NOTE: Underlying pools get created on first allocations since
+        // those are sized to fit at least a single set of the allocated layout
         _pImpl = new DescriptorPoolImpl;
-        _pImpl->handle = handle;
 
         Debug::log("Descriptor pool created");
     }
@@ -328,11 +603,10 @@ namespace platypus
     {
         if (_pImpl)
         {
-            vkDestroyDescriptorPool(
-                Device::get_impl()->device,
-                _pImpl->handle,
-                nullptr
-            );
+            destroy_descriptor_pool_chain(_pImpl->chain);
+            destroy_descriptor_pool_chain(_pImpl->updateAfterBindChain);
+            for (DescriptorPoolChain& transientChain : _pImpl->transientChains)
+                destroy_descriptor_pool_chain(transientChain);
             delete _pImpl;
         }
     }
@@ -495,111 +769,55 @@ namespace platypus
         const std::vector<DescriptorSetComponent>& components
     )
     {
-        const std::vector<DescriptorSetLayoutBinding>& bindings = layout.getBindings();
-        if (bindings.size() != components.size())
+        // Layouts having update after bind bindings can only be allocated from pools
+        // created with the update after bind flag
+        const bool updateAfterBind = requires_update_after_bind(layout);
+        VkDescriptorPoolCreateFlags poolFlags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+        if (updateAfterBind)
+            poolFlags |= VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+
+        DescriptorSet createdDescriptorSet;
+        DescriptorSetImpl* pCreatedImpl = createdDescriptorSet._pImpl.get();
+        pCreatedImpl->handle = alloc_descriptor_set(
+            updateAfterBind ? _pImpl->updateAfterBindChain : _pImpl->chain,
+            static_cast<uint32_t>(_maxDescriptorSets),
+            poolFlags,
+            layout,
+            &pCreatedImpl->poolHandle
+        );
+        write_descriptor_set(pCreatedImpl->handle, layout, components);
+        return createdDescriptorSet;
+    }
+
+    DescriptorSet DescriptorPool::createTransientDescriptorSet(
+        const DescriptorSetLayout& layout,
+        const std::vector<DescriptorSetComponent>& components,
+        size_t frame
+    )
+    {
+        if (requires_update_after_bind(layout))
         {
             Debug::log(
-                "@DescriptorPool::createDescriptorSet "
-                "Component required for each layout's binding! "
-                "Provided bindings: " + std::to_string(bindings.size()) + " "
-                "components: " + std::to_string(components.size()),
+                "Transient descriptor sets can't use update after bind layouts",
+                PLATYPUS_CURRENT_FUNC_NAME,
                 Debug::MessageType::PLATYPUS_ERROR
             );
             PLATYPUS_ASSERT(false);
         }
-
-        VkDescriptorSet vkDescriptorSetHandle = alloc_descriptor_set(_pImpl->handle, layout);
-
-        for (size_t i = 0; i < bindings.size(); ++i)
-        {
-            const DescriptorSetLayoutBinding& binding = bindings[i];
-
-            VkDescriptorBufferInfo bufferInfo{};
-            VkDescriptorImageInfo imageInfo{};
-
-            DescriptorType bindingType = binding.getType();
-            if (components[i].type != bindingType)
-            {
-                Debug::log(
-                    "@DescriptorPool::createDescriptorSet "
-                    "Invalid descriptor set component type: " + std::to_string(components[i].type) + " " +
-                    "for binding at index: " + std::to_string(i) + " " +
-                    "binding is using type: " + std::to_string(bindingType),
-                    Debug::MessageType::PLATYPUS_ERROR
-                );
-                PLATYPUS_ASSERT(false);
-            }
-
-            bool isTexture = false;
-            if (bindingType == DescriptorType::DESCRIPTOR_TYPE_UNIFORM_BUFFER || bindingType == DescriptorType::DESCRIPTOR_TYPE_DYNAMIC_UNIFORM_BUFFER)
-            {
-                // NOTE: Danger?
-                const Buffer* pBuffer = (const Buffer*)components[i].pData;
-                bufferInfo.buffer = pBuffer->getImpl()->handle;
-                bufferInfo.offset = 0;
-                // NOTE:
-                // Be careful when using dynamic uniform buffers!
-                //  -> When using dynamic offset in vkCmdBindDescriptorSets the "area of buffer that is used", is the given offset to the offset + this range
-                //  -> And range being the element size should make sense for all cases
-                //  -> YOU JUST NEED TO BE CAREFUL THAT YOU PROVIDE THE CORRECT ELEMENT SIZE!
-                bufferInfo.range = pBuffer->getDataElemSize();
-            }
-            else if (bindingType == DescriptorType::DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER)
-            {
-                isTexture = true;
-                // NOTE: Danger?
-                const Texture* pTexture = (const Texture*)components[i].pData;
-                // NOTE: JUST TESTING ATM!
-                if (components[i].depthImageTEST)
-                    imageInfo.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
-                else
-                    imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-                imageInfo.imageView = pTexture->getImpl()->imageView;
-                PLATYPUS_ASSERT(pTexture);
-                PLATYPUS_ASSERT(pTexture->getTextureSampler());
-                PLATYPUS_ASSERT(pTexture->getTextureSampler()->getImpl());
-                PLATYPUS_ASSERT(pTexture->getTextureSampler()->getImpl()->handle);
-                imageInfo.sampler = pTexture->getTextureSampler()->getImpl()->handle;
-            }
-            else
-            {
-                Debug::log(
-                    "@DescriptorPool::createDescriptorSet "
-                    "Invalid type for descriptor set layout binding at index: " + std::to_string(i),
-                    Debug::MessageType::PLATYPUS_ERROR
-                );
-                PLATYPUS_ASSERT(false);
-            }
-
-            // NOTE: No idea is this going to work...
-            // need to write to multiple bindings in some cases...
-            VkWriteDescriptorSet descriptorWrite{};
-            descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            descriptorWrite.descriptorCount = 1;
-            descriptorWrite.dstSet = vkDescriptorSetHandle;
-            descriptorWrite.dstBinding = binding.getBinding();
-            descriptorWrite.dstArrayElement = 0; // if using array descriptors, this is the first index in the array..
-            descriptorWrite.descriptorType = to_vk_descriptor_type(binding.getType());
-
-            if (!isTexture)
-                descriptorWrite.pBufferInfo = &bufferInfo;
-            else
-                descriptorWrite.pImageInfo = &imageInfo;
-
-            descriptorWrite.pTexelBufferView = nullptr; // what this?
-
-            vkUpdateDescriptorSets(
-                Device::get_impl()->device,
-                1,
-                &descriptorWrite,
-                0,
-                nullptr
-            );
-        }
+        if (frame >= _pImpl->transientChains.size())
+            _pImpl->transientChains.resize(frame + 1);
 
         DescriptorSet createdDescriptorSet;
-        createdDescriptorSet._pImpl->handle = vkDescriptorSetHandle;
+        DescriptorSetImpl* pCreatedImpl = createdDescriptorSet._pImpl.get();
+        pCreatedImpl->handle = alloc_descriptor_set(
+            _pImpl->transientChains[frame],
+            static_cast<uint32_t>(_maxDescriptorSets),
+            0,
+            layout,
+            &pCreatedImpl->poolHandle
+        );
+        pCreatedImpl->transient = true;
+        write_descriptor_set(pCreatedImpl->handle, layout, components);
         return createdDescriptorSet;
     }
 
@@ -629,12 +847,34 @@ namespace platypus
                 );
                 PLATYPUS_ASSERT(false);
             }
+            if (pDescriptorSetImpl->transient)
+            {
+                Debug::log(
+                    "@DescriptorPool::freeDescriptorSets "
+                    "Attempted to free transient descriptor set! "
+                    "Those are freed by resetTransientDescriptorSets()",
+                    Debug::MessageType::PLATYPUS_ERROR
+                );
+                PLATYPUS_ASSERT(false);
+                continue;
+            }
             vkFreeDescriptorSets(
                 Device::get_impl()->device,
-                _pImpl->handle,
+                pDescriptorSetImpl->poolHandle,
                 1,
                 &pDescriptorSetImpl->handle
             );
         }
     }
+
+    void DescriptorPool::resetTransientDescriptorSets(size_t frame)
+    {
+        if (frame >= _pImpl->transientChains.size())
+            return;
+
+        DescriptorPoolChain& transientChain = _pImpl->transientChains[frame];
+        for (VkDescriptorPool handle : transientChain.handles)
+            vkResetDescriptorPool(Device::get_impl()->device, handle, 0);
+        transientChain.currentIndex = 0;
+    }
 }
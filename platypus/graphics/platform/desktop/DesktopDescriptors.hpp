@@ -2,6 +2,7 @@
 
 #include "platypus/graphics/Descriptors.hpp"
 #include <vulkan/vulkan.h>
+#include <vector>
 
 
 namespace platypus
@@ -14,11 +15,29 @@ namespace platypus
     struct DescriptorSetImpl
     {
         VkDescriptorSet handle = VK_NULL_HANDLE;
+        // The underlying pool this was allocated from
+        VkDescriptorPool poolHandle = VK_NULL_HANDLE;
+        bool transient = false;
+    };
+
+    // Pools allocated from in order. New pool gets added when all existing ones are full.
+    struct DescriptorPoolChain
+    {
+        std::vector<VkDescriptorPool> handles;
+        // Pool which was successfully allocated from last time
+        size_t currentIndex = 0;
     };
 
     struct DescriptorPoolImpl
     {
-        VkDescriptorPool handle = VK_NULL_HANDLE;
+        // Descriptor sets which can be freed individually
+        DescriptorPoolChain chain;
+        // Same as above, but for layouts using DESCRIPTOR_BINDING_FLAG_UPDATE_AFTER_BIND_BIT
+        DescriptorPoolChain updateAfterBindChain;
+        // Index = frame
+        // NOTE: These are created without VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT
+        // and only ever reset as a whole
+        std::vector<DescriptorPoolChain> transientChains;
     };
 
     VkDescriptorType to_vk_descriptor_type(const DescriptorType& type);
@@ -5,10 +5,14 @@
 #include "platypus/graphics/Swapchain.hpp"
 #include "DesktopSwapchain.hpp"
 #include "DesktopCommandBuffer.hpp"
+#include "DesktopUploadManager.hpp"
 #include "platypus/core/platform/desktop/DesktopWindow.hpp"
 #include "platypus/assets/platform/desktop/DesktopTexture.hpp"
+#include "platypus/utils/FileUtils.hpp"
 #include <vulkan/vk_enum_string_helper.h>
 #include <cstring>
+#include <cstdlib>
+#include <cstdio>
 #include <set>
 #include <vulkan/vulkan_core.h>
 
@@ -143,6 +147,7 @@ namespace platypus
         std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
         vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
         int index = 0;
+        bool transferOnly = false;
         for (const VkQueueFamilyProperties& queueFamilyProperties : queueFamilies)
         {
             if (queueFamilyProperties.queueFlags & VK_QUEUE_GRAPHICS_BIT)
@@ -150,6 +155,13 @@ namespace platypus
                 result.queueFlags |= QueueFamilyFlagBits::QUEUE_FAMILY_GRAPHICS;
                 result.graphicsFamilyIndex = index;
             }
+            // Prefer the transfer family without compute too (usually the DMA engine)
+            else if ((queueFamilyProperties.queueFlags & VK_QUEUE_TRANSFER_BIT) && !transferOnly)
+            {
+                result.queueFlags |= QueueFamilyFlagBits::QUEUE_FAMILY_TRANSFER;
+                result.transferFamilyIndex = index;
+                transferOnly = !(queueFamilyProperties.queueFlags & VK_QUEUE_COMPUTE_BIT);
+            }
             VkBool32 presentSupport = false;
             vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, index, surface, &presentSupport);
             if (presentSupport)
@@ -311,10 +323,187 @@ namespace platypus
         return physicalDevices[highestIndex];
     }
 
+    // Selects the first device whose name contains the PLATYPUS_DEVICE environment variable's value,
+    // for example PLATYPUS_DEVICE=llvmpipe to use a software implementation (lavapipe).
+    // Returns false if the variable isn't set or no such device was found.
+    static bool get_requested_device(
+        const std::vector<PhysicalDevice>& physicalDevices,
+        PhysicalDevice& outDevice
+    )
+    {
+        const char* pRequestedName = getenv("PLATYPUS_DEVICE");
+        if (!pRequestedName || strlen(pRequestedName) == 0)
+            return false;
+
+        for (const PhysicalDevice& physicalDevice : physicalDevices)
+        {
+            if (strstr(physicalDevice.properties.deviceName, pRequestedName))
+            {
+                outDevice = physicalDevice;
+                return true;
+            }
+        }
+        Debug::log(
+            "Requested device: " + std::string(pRequestedName) + " not found from usable devices",
+            PLATYPUS_CURRENT_FUNC_NAME,
+            Debug::MessageType::PLATYPUS_WARNING
+        );
+        return false;
+    }
+
+    static bool has_extension(const PhysicalDevice& physicalDevice, const char* extensionName)
+    {
+        for (const VkExtensionProperties& extension : physicalDevice.extensionProperties)
+        {
+            if (strcmp(extensionName, extension.extensionName) == 0)
+                return true;
+        }
+        return false;
+    }
+
+    // Returns max number of textures in a bindless texture array or 0 if
+    // the device doesn't support everything required for bindless textures.
+    // NOTE: Requires Vulkan 1.1 for vkGetPhysicalDeviceFeatures2 and
+    // VK_EXT_descriptor_indexing
+    static uint32_t get_max_bindless_textures(const PhysicalDevice& physicalDevice)
+    {
+        if (physicalDevice.properties.apiVersion < VK_API_VERSION_1_1)
+            return 0;
+        if (!has_extension(physicalDevice, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME))
+            return 0;
+
+        VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures{};
+        indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+        VkPhysicalDeviceFeatures2 features{};
+        features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features.pNext = &indexingFeatures;
+        vkGetPhysicalDeviceFeatures2(physicalDevice.handle, &features);
+
+        if (!features.features.shaderSampledImageArrayDynamicIndexing ||
+            !indexingFeatures.shaderSampledImageArrayNonUniformIndexing ||
+            !indexingFeatures.runtimeDescriptorArray ||
+            !indexingFeatures.descriptorBindingPartiallyBound ||
+            !indexingFeatures.descriptorBindingSampledImageUpdateAfterBind ||
+            !indexingFeatures.descriptorBindingUpdateUnusedWhilePending)
+        {
+            return 0;
+        }
+
+        VkPhysicalDeviceDescriptorIndexingPropertiesEXT indexingProperties{};
+        indexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+        VkPhysicalDeviceProperties2 properties{};
+        properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        properties.pNext = &indexingProperties;
+        vkGetPhysicalDeviceProperties2(physicalDevice.handle, &properties);
+
+        return std::min(
+            indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages,
+            std::min(
+                indexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                indexingProperties.maxPerStageDescriptorUpdateAfterBindSamplers
+            )
+        );
+    }
+
+    // Staging memory each upload batch suballocates from
+    static const size_t s_uploadStagingBlockSize = 16 * 1024 * 1024;
+
+    // Size of the pipeline cache header version one
+    // (uint32_t headerSize, headerVersion, vendorID, deviceID, uint8_t pipelineCacheUUID[VK_UUID_SIZE])
+    static const size_t s_pipelineCacheHeaderSize = sizeof(uint32_t) * 4 + VK_UUID_SIZE;
+
+    // Returns the cache data from the file if it was created by the same driver and device.
+    // NOTE: Drivers are supposed to validate the data themselves, but some
+    // have had issues with data from other drivers -> checking the header here as well.
+    static std::vector<char> read_pipeline_cache_data(
+        const std::string& filepath,
+        const VkPhysicalDeviceProperties& properties
+    )
+    {
+        std::string error;
+        if (!validate_file(filepath, error))
+        {
+            Debug::log("No pipeline cache found from: " + filepath + " Creating empty cache");
+            return { };
+        }
+
+        std::vector<char> data = read_file(filepath);
+        uint32_t header[4] = { 0, 0, 0, 0 };
+        uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+        memset(pipelineCacheUUID, 0, VK_UUID_SIZE);
+        if (data.size() >= s_pipelineCacheHeaderSize)
+        {
+            memcpy(header, data.data(), sizeof(uint32_t) * 4);
+            memcpy(pipelineCacheUUID, data.data() + sizeof(uint32_t) * 4, VK_UUID_SIZE);
+        }
+
+        const bool valid = header[0] >= s_pipelineCacheHeaderSize &&
+            header[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+            header[2] == properties.vendorID &&
+            header[3] == properties.deviceID &&
+            memcmp(pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+        if (!valid)
+        {
+            Debug::log(
+                "Pipeline cache: " + filepath + " was created by different device or driver version. "
+                "Creating empty cache",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_WARNING
+            );
+            return { };
+        }
+        return data;
+    }
+
+    static VkPipelineCache create_pipeline_cache(
+        VkDevice device,
+        const VkPhysicalDeviceProperties& properties,
+        const std::string& filepath
+    )
+    {
+        const std::vector<char> initialData = read_pipeline_cache_data(filepath, properties);
+
+        VkPipelineCacheCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.initialDataSize = initialData.size();
+        createInfo.pInitialData = initialData.empty() ? nullptr : initialData.data();
+
+        VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+        VkResult createResult = vkCreatePipelineCache(device, &createInfo, nullptr, &pipelineCache);
+        if (createResult != VK_SUCCESS && !initialData.empty())
+        {
+            Debug::log(
+                "Failed to create pipeline cache from: " + filepath + " "
+                "VkResult: " + std::string(string_VkResult(createResult)) + " "
+                "Creating empty cache",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_WARNING
+            );
+            createInfo.initialDataSize = 0;
+            createInfo.pInitialData = nullptr;
+            createResult = vkCreatePipelineCache(device, &createInfo, nullptr, &pipelineCache);
+        }
+
+        if (createResult != VK_SUCCESS)
+        {
+            Debug::log(
+                "Failed to create pipeline cache! Creating pipelines without cache. "
+                "VkResult: " + std::string(string_VkResult(createResult)),
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            return VK_NULL_HANDLE;
+        }
+        if (!initialData.empty())
+            Debug::log("Loaded pipeline cache from: " + filepath + " (" + std::to_string(initialData.size()) + " bytes)");
+        return pipelineCache;
+    }
+
     DeviceImpl* Device::s_pImpl = nullptr;
     Window* Device::s_pWindow = nullptr;
     DescriptorPool* Device::s_pDescriptorPool = nullptr;
     size_t Device::s_minUniformBufferOffsetAlignment = 0;
+    uint32_t Device::s_maxBindlessTextures = 0;
     CommandPool* Device::s_pCommandPool = nullptr;
     std::vector<ImageFormat> Device::s_supportedDepthFormats;
     std::vector<ImageFormat> Device::s_supportedColorFormats;
@@ -409,8 +598,10 @@ namespace platypus
         for (const PhysicalDevice& adequateDevice : adequateDevices)
             Debug::log("    " + std::string(adequateDevice.properties.deviceName));
 
-        // Score adequate devices and select best one
-        PhysicalDevice selectedPhysicalDevice = get_highest_score_device(adequateDevices);
+        // Score adequate devices and select best one, unless some device was requested
+        PhysicalDevice selectedPhysicalDevice;
+        if (!get_requested_device(adequateDevices, selectedPhysicalDevice))
+            selectedPhysicalDevice = get_highest_score_device(adequateDevices);
         Debug::log("Selected device: " + std::string(selectedPhysicalDevice.properties.deviceName));
         s_minUniformBufferOffsetAlignment = selectedPhysicalDevice.properties.limits.minUniformBufferOffsetAlignment;
         QueueProperties queueProperties = selectedPhysicalDevice.queueProperties;
@@ -421,6 +612,11 @@ namespace platypus
             queueProperties.graphicsFamilyIndex,
             queueProperties.presentFamilyIndex
         };
+        // Uploads go through the dedicated transfer queue if there is one
+        if (queueProperties.queueFlags & QueueFamilyFlagBits::QUEUE_FAMILY_TRANSFER)
+            uniqueQueueFamilyIndices.insert(queueProperties.transferFamilyIndex);
+        else
+            queueProperties.transferFamilyIndex = queueProperties.graphicsFamilyIndex;
 
         std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
         float queuePriority = 1.0f;
@@ -442,6 +638,23 @@ namespace platypus
         deviceCreateInfo.pQueueCreateInfos = queueCreateInfos.data();
         deviceCreateInfo.pEnabledFeatures = &physicalDeviceFeatures;
 
+        // Bindless textures are optional -> enabled only if everything required is supported
+        s_maxBindlessTextures = get_max_bindless_textures(selectedPhysicalDevice);
+        VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures{};
+        indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+        if (s_maxBindlessTextures > 0)
+        {
+            physicalDeviceFeatures.shaderSampledImageArrayDynamicIndexing = VK_TRUE;
+            indexingFeatures.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+            indexingFeatures.runtimeDescriptorArray = VK_TRUE;
+            indexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+            indexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+            indexingFeatures.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+            deviceCreateInfo.pNext = &indexingFeatures;
+            requiredExtensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+            Debug::log("Bindless textures supported. Max textures: " + std::to_string(s_maxBindlessTextures));
+        }
+
         std::vector<const char*> useExtensions(requiredExtensions.size());
         for (size_t i = 0; i < requiredExtensions.size(); ++i)
             useExtensions[i] = requiredExtensions[i].c_str();
@@ -474,12 +687,16 @@ namespace platypus
         // in addition to the family indices?
         vkGetDeviceQueue(device, queueProperties.graphicsFamilyIndex, 0, &graphicsQueue);
         vkGetDeviceQueue(device, queueProperties.presentFamilyIndex, 0, &presentQueue);
+        VkQueue transferQueue = VK_NULL_HANDLE;
+        vkGetDeviceQueue(device, queueProperties.transferFamilyIndex, 0, &transferQueue);
 
         s_pImpl = new DeviceImpl;
         s_pImpl->physicalDevice = selectedPhysicalDevice;
         s_pImpl->device = device;
         s_pImpl->graphicsQueue = graphicsQueue;
         s_pImpl->presentQueue = presentQueue;
+        s_pImpl->transferQueue = transferQueue;
+        s_pImpl->physicalDevice.queueProperties.transferFamilyIndex = queueProperties.transferFamilyIndex;
 
         // Fucking dumb, but will do for now...
         for (VkFormat colorFormat : get_color_formats(selectedPhysicalDevice))
@@ -510,13 +727,30 @@ namespace platypus
 
         s_pImpl->vmaAllocator = vmaAllocator;
 
+        s_pImpl->pipelineCache = create_pipeline_cache(
+            device,
+            selectedPhysicalDevice.properties,
+            PLATYPUS_PIPELINE_CACHE_FILEPATH
+        );
+
         s_pCommandPool = new CommandPool;
 
+        s_pImpl->pUploadManager = new UploadManager(
+            device,
+            vmaAllocator,
+            graphicsQueue,
+            queueProperties.graphicsFamilyIndex,
+            transferQueue,
+            queueProperties.transferFamilyIndex,
+            s_uploadStagingBlockSize
+        );
+
         s_pDescriptorPool = new DescriptorPool(maxDescriptorSets);
     }
 
     void Device::destroy()
     {
+        s_maxBindlessTextures = 0;
         s_supportedColorFormats.clear();
         s_supportedDepthFormats.clear();
 
@@ -529,8 +763,19 @@ namespace platypus
             );
             PLATYPUS_ASSERT(false);
         }
+        // Waits for the uploads in flight
+        delete s_pImpl->pUploadManager;
+        s_pImpl->pUploadManager = nullptr;
         delete s_pCommandPool;
         delete s_pDescriptorPool;
+
+        save_pipeline_cache();
+        if (s_pImpl->pipelineCache != VK_NULL_HANDLE)
+        {
+            vkDestroyPipelineCache(s_pImpl->device, s_pImpl->pipelineCache, nullptr);
+            s_pImpl->pipelineCache = VK_NULL_HANDLE;
+        }
+
         vmaDestroyAllocator(s_pImpl->vmaAllocator);
         vkDestroyDevice(s_pImpl->device, nullptr);
 
@@ -543,6 +788,9 @@ namespace platypus
         size_t frame
     )
     {
+        // Uploads recorded for this frame need to be in the queue before the frame's commands
+        s_pImpl->pUploadManager->submit();
+
         SwapchainImpl* pSwapchainImpl = swapchain.getImpl();
 
         // NOTE: This could be its own Swapchain member function since we're waiting for the
@@ -597,9 +845,23 @@ namespace platypus
 
     void Device::wait_for_operations()
     {
+        // Recorded uploads may refer to resources which are about to be destroyed
+        //  -> those need to be submitted to be waited as well
+        if (s_pImpl->pUploadManager)
+            s_pImpl->pUploadManager->submit();
         vkDeviceWaitIdle(s_pImpl->device);
     }
 
+    void Device::submit_uploads()
+    {
+        s_pImpl->pUploadManager->submit();
+    }
+
+    void Device::wait_for_uploads()
+    {
+        s_pImpl->pUploadManager->waitForUploads();
+    }
+
     void Device::handle_window_resize()
     {
         s_pImpl->physicalDevice.windowSurfaceProperties = get_window_surface_properties(
@@ -608,6 +870,47 @@ namespace platypus
         );
     }
 
+    void Device::save_pipeline_cache()
+    {
+        if (!s_pImpl || s_pImpl->pipelineCache == VK_NULL_HANDLE)
+            return;
+
+        VkDevice device = s_pImpl->device;
+        size_t dataSize = 0;
+        VkResult getResult = vkGetPipelineCacheData(device, s_pImpl->pipelineCache, &dataSize, nullptr);
+        std::vector<char> data(dataSize);
+        if (getResult == VK_SUCCESS && dataSize > 0)
+            getResult = vkGetPipelineCacheData(device, s_pImpl->pipelineCache, &dataSize, data.data());
+
+        if (getResult != VK_SUCCESS || dataSize == 0)
+        {
+            Debug::log(
+                "Failed to get pipeline cache data. VkResult: " + std::string(string_VkResult(getResult)),
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            return;
+        }
+        data.resize(dataSize);
+
+        // Writing to a temporary file first, so a crash while writing
+        // can't leave a partially written cache behind
+        const std::string filepath = PLATYPUS_PIPELINE_CACHE_FILEPATH;
+        const std::string tmpFilepath = filepath + ".tmp";
+        write_file(tmpFilepath, data);
+        if (std::rename(tmpFilepath.c_str(), filepath.c_str()) != 0)
+        {
+            Debug::log(
+                "Failed to replace pipeline cache: " + filepath,
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            std::remove(tmpFilepath.c_str());
+            return;
+        }
+        Debug::log("Saved pipeline cache to: " + filepath + " (" + std::to_string(dataSize) + " bytes)");
+    }
+
     size_t Device::get_min_uniform_buffer_offset_align()
     {
         return s_minUniformBufferOffsetAlignment;
@@ -8,6 +8,8 @@
 
 namespace platypus
 {
+    class UploadManager;
+
     // *Maybe this should rather be in DesktopWindow?
     struct WindowSurfaceProperties
     {
@@ -21,12 +23,15 @@ namespace platypus
         QUEUE_FAMILY_NONE = 0x0,
         QUEUE_FAMILY_GRAPHICS = 0x1,
         QUEUE_FAMILY_PRESENT = 0x2,
+        // Transfer queue family without graphics support
+        QUEUE_FAMILY_TRANSFER = 0x4
     };
 
     struct QueueProperties
     {
         uint32_t graphicsFamilyIndex;
         uint32_t presentFamilyIndex;
+        uint32_t transferFamilyIndex;
         uint32_t queueFlags = QueueFamilyFlagBits::QUEUE_FAMILY_NONE;
     };
 
@@ -48,8 +53,16 @@ namespace platypus
 
         VkQueue graphicsQueue;
         VkQueue presentQueue;
+        // Graphics queue if the device has no dedicated transfer queue
+        VkQueue transferQueue;
 
         VmaAllocator vmaAllocator;
+
+        // Shared by all pipeline creation. VK_NULL_HANDLE if creating it failed
+        // -> pipelines get created without cache.
+        VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+
+        UploadManager* pUploadManager = nullptr;
     };
 
     bool is_format_supported(VkFormat format);
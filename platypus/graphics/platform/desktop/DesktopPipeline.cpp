@@ -12,6 +12,7 @@
 #include <vulkan/vulkan.h>
 #include <vulkan/vk_enum_string_helper.h>
 #include <vulkan/vulkan_core.h>
+#include <chrono>
 
 
 namespace platypus
@@ -165,32 +166,11 @@ namespace platypus
         inputAssemblyCreateInfo.primitiveRestartEnable = VK_FALSE;
 
         // Specify viewport
-        // IMPORTANT::LATEST --------------------------------------------------------
-        // NOTE: UPDATE TO ALL BELOW: Using dynamic viewport stage atm
-        //  -> did this very drunk, not sure what consequences is it really
-        //  okay to flip the same way using just vkCmdViewport: WHICH I DIDN'T DO! -> FUCKING MYSTERIOUS SHIT ONCE AGAIN!
-        //  ------------------------------------------------------------------------- -> FUCKING MYSTERIOUS SHIT ONCE AGAIN!
-        //
-        // TODO: Allow specifying other than swapchain's extent
-        /*
-        const Swapchain& swapchain = Application::get_instance()->getMasterRenderer()->getSwapchain();
-        Extent2D swapchainExtent = swapchain.getExtent();
-        Rect2D viewportScissor = {
-            0, 0, swapchainExtent.width, swapchainExtent.height
-        };
-        */
-        // ----------------
-        // NOTE: Flipping the viewpot height here to have y point up so
+        // NOTE: Viewport and scissor are dynamic state (set using vkCmdSetViewport and
+        // vkCmdSetScissor when recording), so the pipeline doesn't need to be recreated
+        // when the framebuffer's size changes.
+        // The viewport's height gets flipped in render::set_viewport() to have y point up so
         // it's consistent with opengl and how gltf files' vertices go
-        /*
-        VkViewport viewport{};
-        viewport.x = 0;
-        viewport.y = (float)swapchainExtent.height;
-        viewport.width = (float)swapchainExtent.width;
-        viewport.height = -((float)swapchainExtent.height);
-        viewport.minDepth = 0.0f;
-        viewport.maxDepth = 1.0f;
-        */
         VkPipelineViewportStateCreateInfo viewportCreateInfo{};
         viewportCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
         viewportCreateInfo.viewportCount = 1;
@@ -370,10 +350,11 @@ namespace platypus
         pipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
         pipelineCreateInfo.basePipelineIndex = -1;
 
+        std::chrono::time_point<std::chrono::high_resolution_clock> beginTime = std::chrono::high_resolution_clock::now();
         VkPipeline pipeline = VK_NULL_HANDLE;
         VkResult createResult = vkCreateGraphicsPipelines(
             device,
-            VK_NULL_HANDLE,
+            Device::get_impl()->pipelineCache,
             1,
             &pipelineCreateInfo,
             nullptr,
@@ -394,7 +375,8 @@ namespace platypus
         _pImpl->layout = pipelineLayout;
         _pImpl->handle = pipeline;
 
-        Debug::log("Pipeline created");
+        std::chrono::duration<float, std::milli> createTime = std::chrono::high_resolution_clock::now() - beginTime;
+        Debug::log("Pipeline created in " + std::to_string(createTime.count()) + " ms");
     }
 
     void Pipeline::destroy()
@@ -338,7 +338,8 @@ namespace platypus
         void draw_indexed(
             const CommandBuffer& commandBuffer,
             uint32_t count,
-            uint32_t instanceCount
+            uint32_t instanceCount,
+            uint32_t firstInstance
         )
         {
             vkCmdDrawIndexed(
@@ -347,7 +348,7 @@ namespace platypus
                 instanceCount,
                 0,
                 0,
-                0
+                firstInstance
             );
         }
 
@@ -23,24 +23,29 @@ namespace platypus
     }
 
 
+    // NOTE: shaderStageFlags can have multiple bits set
     VkShaderStageFlags to_vk_shader_stage_flags(uint32_t shaderStageFlags)
     {
-        switch (shaderStageFlags)
+        const uint32_t availableBits = ShaderStageFlagBits::SHADER_STAGE_VERTEX_BIT | ShaderStageFlagBits::SHADER_STAGE_FRAGMENT_BIT;
+        if (shaderStageFlags == 0 || (shaderStageFlags & ~availableBits) != 0)
         {
-            case ShaderStageFlagBits::SHADER_STAGE_VERTEX_BIT: return VK_SHADER_STAGE_VERTEX_BIT;
-            case ShaderStageFlagBits::SHADER_STAGE_FRAGMENT_BIT: return VK_SHADER_STAGE_FRAGMENT_BIT;
-            default:
-                Debug::log(
-                    "@to_vk_shader_stage_flags "
-                    "Invalid shaderStageFlags: " + std::to_string(shaderStageFlags) + " "
-                    "Available flag bits are currently: "
-                    "VK_SHADER_STAGE_VERTEX_BIT, "
-                    "VK_SHADER_STAGE_FRAGMENT_BIT",
-                    Debug::MessageType::PLATYPUS_ERROR
-                );
-                PLATYPUS_ASSERT(false);
+            Debug::log(
+                "@to_vk_shader_stage_flags "
+                "Invalid shaderStageFlags: " + std::to_string(shaderStageFlags) + " "
+                "Available flag bits are currently: "
+                "VK_SHADER_STAGE_VERTEX_BIT, "
+                "VK_SHADER_STAGE_FRAGMENT_BIT",
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            PLATYPUS_ASSERT(false);
+            return 0;
         }
-        return 0;
+        VkShaderStageFlags vkFlags = 0;
+        if (shaderStageFlags & ShaderStageFlagBits::SHADER_STAGE_VERTEX_BIT)
+            vkFlags |= VK_SHADER_STAGE_VERTEX_BIT;
+        if (shaderStageFlags & ShaderStageFlagBits::SHADER_STAGE_FRAGMENT_BIT)
+            vkFlags |= VK_SHADER_STAGE_FRAGMENT_BIT;
+        return vkFlags;
     }
 
     Shader::Shader(const std::string& filename, ShaderStageFlagBits stage) :
@@ -0,0 +1,393 @@
+#include "DesktopUploadManager.hpp"
+#include "DesktopCommandBuffer.hpp"
+#include "platypus/core/Debug.hpp"
+#include <vulkan/vk_enum_string_helper.h>
+#include <cstring>
+
+
+namespace platypus
+{
+    // Submitting waits for the oldest batch after this many are in flight
+    static const size_t s_maxSubmittedBatches = 3;
+    // Finished batches kept for reuse, rest of them are destroyed to free their staging blocks
+    static const size_t s_maxFreeBatches = 3;
+
+    static bool validate_result(VkResult result, const std::string& operation, const char* funcName)
+    {
+        if (result == VK_SUCCESS)
+            return true;
+
+        const std::string errStr(string_VkResult(result));
+        Debug::log(
+            "Failed to " + operation + "! VkResult: " + errStr,
+            funcName,
+            Debug::MessageType::PLATYPUS_ERROR
+        );
+        PLATYPUS_ASSERT(false);
+        return false;
+    }
+
+    static size_t align_offset(size_t offset, size_t alignment)
+    {
+        if (alignment <= 1)
+            return offset;
+        return ((offset + alignment - 1) / alignment) * alignment;
+    }
+
+
+    UploadBatch::UploadBatch(const CommandBuffer& graphicsCommandBuffer) :
+        graphicsCommandBuffer(graphicsCommandBuffer)
+    {
+    }
+
+
+    UploadManager::UploadManager(
+        VkDevice device,
+        VmaAllocator vmaAllocator,
+        VkQueue graphicsQueue,
+        uint32_t graphicsFamilyIndex,
+        VkQueue transferQueue,
+        uint32_t transferFamilyIndex,
+        size_t stagingBlockSize
+    ) :
+        _device(device),
+        _vmaAllocator(vmaAllocator),
+        _graphicsQueue(graphicsQueue),
+        _transferQueue(transferQueue),
+        _stagingBlockSize(stagingBlockSize)
+    {
+        _queueFamilyIndices.push_back(graphicsFamilyIndex);
+        if (transferFamilyIndex != graphicsFamilyIndex)
+            _queueFamilyIndices.push_back(transferFamilyIndex);
+
+        _pGraphicsCommandPool = new CommandPool;
+
+        VkCommandPoolCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        createInfo.queueFamilyIndex = transferFamilyIndex;
+        createInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        VkResult createResult = vkCreateCommandPool(_device, &createInfo, nullptr, &_transferCommandPool);
+        validate_result(createResult, "create transfer command pool", PLATYPUS_CURRENT_FUNC_NAME);
+
+        Debug::log(
+            "Upload manager created. Using " +
+            std::string(hasDedicatedTransferQueue() ? "dedicated transfer queue" : "graphics queue") + " "
+            "for buffer uploads"
+        );
+    }
+
+    UploadManager::~UploadManager()
+    {
+        waitForUploads();
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_pRecordingBatch)
+            destroyBatch(_pRecordingBatch);
+        _pRecordingBatch = nullptr;
+        for (UploadBatch* pBatch : _submittedBatches)
+            destroyBatch(pBatch);
+        for (UploadBatch* pBatch : _freeBatches)
+            destroyBatch(pBatch);
+        _submittedBatches.clear();
+        _freeBatches.clear();
+
+        vkDestroyCommandPool(_device, _transferCommandPool, nullptr);
+        delete _pGraphicsCommandPool;
+    }
+
+    void UploadManager::recordBufferUpload(const void* pData, size_t dataSize, VkBuffer destination)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        size_t stagingOffset = 0;
+        StagingBuffer& stagingBuffer = allocateStaging(dataSize, 1, stagingOffset);
+        memcpy((void*)((char*)stagingBuffer.pMappedData + stagingOffset), pData, dataSize);
+        vmaFlushAllocation(_vmaAllocator, stagingBuffer.vmaAllocation, stagingOffset, dataSize);
+
+        UploadBatch* pBatch = _pRecordingBatch;
+        if (!pBatch->transferRecording)
+        {
+            VkCommandBufferBeginInfo beginInfo{};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            VkResult beginResult = vkBeginCommandBuffer(pBatch->transferCommandBuffer, &beginInfo);
+            validate_result(beginResult, "begin transfer command buffer", PLATYPUS_CURRENT_FUNC_NAME);
+            pBatch->transferRecording = true;
+        }
+
+        VkBufferCopy copyRegion{};
+        copyRegion.srcOffset = stagingOffset;
+        copyRegion.dstOffset = 0;
+        copyRegion.size = dataSize;
+        vkCmdCopyBuffer(
+            pBatch->transferCommandBuffer,
+            stagingBuffer.handle,
+            destination,
+            1,
+            &copyRegion
+        );
+        ++pBatch->uploadCount;
+    }
+
+    void UploadManager::recordImageUpload(
+        const void* pData,
+        size_t dataSize,
+        size_t alignment,
+        const std::function<void(CommandBuffer&, VkBuffer, size_t)>& recordFunc
+    )
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        size_t stagingOffset = 0;
+        StagingBuffer& stagingBuffer = allocateStaging(dataSize, alignment, stagingOffset);
+        memcpy((void*)((char*)stagingBuffer.pMappedData + stagingOffset), pData, dataSize);
+        vmaFlushAllocation(_vmaAllocator, stagingBuffer.vmaAllocation, stagingOffset, dataSize);
+
+        UploadBatch* pBatch = _pRecordingBatch;
+        if (!pBatch->graphicsRecording)
+        {
+            pBatch->graphicsCommandBuffer.beginSingleUse();
+            pBatch->graphicsRecording = true;
+        }
+        recordFunc(pBatch->graphicsCommandBuffer, stagingBuffer.handle, stagingOffset);
+        ++pBatch->uploadCount;
+    }
+
+    void UploadManager::submit()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        submitRecordingBatch();
+        recycleFinishedBatches(false);
+    }
+
+    void UploadManager::waitForUploads()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        submitRecordingBatch();
+        recycleFinishedBatches(true);
+    }
+
+    StagingBuffer& UploadManager::allocateStaging(size_t dataSize, size_t alignment, size_t& outOffset)
+    {
+        UploadBatch* pBatch = accessRecordingBatch();
+        if (dataSize > _stagingBlockSize)
+        {
+            pBatch->dedicatedStagingBuffers.push_back(createStagingBuffer(dataSize));
+            outOffset = 0;
+            return pBatch->dedicatedStagingBuffers.back();
+        }
+
+        size_t offset = align_offset(pBatch->stagingOffset, alignment);
+        if (offset + dataSize > _stagingBlockSize)
+        {
+            submitRecordingBatch();
+            pBatch = accessRecordingBatch();
+            offset = 0;
+        }
+        pBatch->stagingOffset = offset + dataSize;
+        outOffset = offset;
+        return pBatch->stagingBlock;
+    }
+
+    UploadBatch* UploadManager::accessRecordingBatch()
+    {
+        if (_pRecordingBatch)
+            return _pRecordingBatch;
+
+        recycleFinishedBatches(false);
+        if (!_freeBatches.empty())
+        {
+            _pRecordingBatch = _freeBatches.back();
+            _freeBatches.pop_back();
+        }
+        else
+        {
+            _pRecordingBatch = createBatch();
+        }
+        return _pRecordingBatch;
+    }
+
+    UploadBatch* UploadManager::createBatch()
+    {
+        UploadBatch* pBatch = new UploadBatch(
+            _pGraphicsCommandPool->allocCommandBuffers(
+                1,
+                CommandBufferLevel::PRIMARY_COMMAND_BUFFER
+            )[0]
+        );
+        pBatch->stagingBlock = createStagingBuffer(_stagingBlockSize);
+
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = _transferCommandPool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = 1;
+        VkResult allocResult = vkAllocateCommandBuffers(_device, &allocInfo, &pBatch->transferCommandBuffer);
+        validate_result(allocResult, "allocate transfer command buffer", PLATYPUS_CURRENT_FUNC_NAME);
+
+        VkSemaphoreCreateInfo semaphoreCreateInfo{};
+        semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        VkResult semaphoreResult = vkCreateSemaphore(
+            _device,
+            &semaphoreCreateInfo,
+            nullptr,
+            &pBatch->transferFinishedSemaphore
+        );
+        validate_result(semaphoreResult, "create semaphore", PLATYPUS_CURRENT_FUNC_NAME);
+
+        VkFenceCreateInfo fenceCreateInfo{};
+        fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        VkResult fenceResult = vkCreateFence(_device, &fenceCreateInfo, nullptr, &pBatch->fence);
+        validate_result(fenceResult, "create fence", PLATYPUS_CURRENT_FUNC_NAME);
+
+        return pBatch;
+    }
+
+    void UploadManager::destroyBatch(UploadBatch* pBatch)
+    {
+        destroyStagingBuffer(pBatch->stagingBlock);
+        for (StagingBuffer& stagingBuffer : pBatch->dedicatedStagingBuffers)
+            destroyStagingBuffer(stagingBuffer);
+
+        vkFreeCommandBuffers(_device, _transferCommandPool, 1, &pBatch->transferCommandBuffer);
+        pBatch->graphicsCommandBuffer.free();
+        vkDestroySemaphore(_device, pBatch->transferFinishedSemaphore, nullptr);
+        vkDestroyFence(_device, pBatch->fence, nullptr);
+        delete pBatch;
+    }
+
+    void UploadManager::submitRecordingBatch()
+    {
+        UploadBatch* pBatch = _pRecordingBatch;
+        if (!pBatch || pBatch->uploadCount == 0)
+            return;
+        _pRecordingBatch = nullptr;
+
+        const bool transferUsed = pBatch->transferRecording;
+        if (transferUsed)
+        {
+            VkResult endResult = vkEndCommandBuffer(pBatch->transferCommandBuffer);
+            validate_result(endResult, "end transfer command buffer", PLATYPUS_CURRENT_FUNC_NAME);
+
+            VkSubmitInfo submitInfo{};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &pBatch->transferCommandBuffer;
+            submitInfo.signalSemaphoreCount = 1;
+            submitInfo.pSignalSemaphores = &pBatch->transferFinishedSemaphore;
+            VkResult submitResult = vkQueueSubmit(_transferQueue, 1, &submitInfo, VK_NULL_HANDLE);
+            validate_result(submitResult, "submit uploads to transfer queue", PLATYPUS_CURRENT_FUNC_NAME);
+        }
+
+        if (!pBatch->graphicsRecording)
+        {
+            pBatch->graphicsCommandBuffer.beginSingleUse();
+            pBatch->graphicsRecording = true;
+        }
+        VkCommandBuffer graphicsCommandBuffer = pBatch->graphicsCommandBuffer.getImpl()->handle;
+        if (transferUsed)
+        {
+            // Chained with the semaphore wait below
+            //  -> everything later in the graphics queue sees the copied buffers
+            VkMemoryBarrier barrier{};
+            barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+            vkCmdPipelineBarrier(
+                graphicsCommandBuffer,
+                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                0,
+                1, &barrier,
+                0, nullptr,
+                0, nullptr
+            );
+        }
+        pBatch->graphicsCommandBuffer.end();
+
+        VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        if (transferUsed)
+        {
+            submitInfo.waitSemaphoreCount = 1;
+            submitInfo.pWaitSemaphores = &pBatch->transferFinishedSemaphore;
+            submitInfo.pWaitDstStageMask = &waitStage;
+        }
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &graphicsCommandBuffer;
+        VkResult submitResult = vkQueueSubmit(_graphicsQueue, 1, &submitInfo, pBatch->fence);
+        validate_result(submitResult, "submit uploads to graphics queue", PLATYPUS_CURRENT_FUNC_NAME);
+
+        _submittedBatches.push_back(pBatch);
+        // Limit the staging memory in flight when uploading a lot at once
+        if (_submittedBatches.size() > s_maxSubmittedBatches)
+        {
+            vkWaitForFences(_device, 1, &_submittedBatches[0]->fence, VK_TRUE, UINT64_MAX);
+            recycleFinishedBatches(false);
+        }
+    }
+
+    void UploadManager::recycleFinishedBatches(bool wait)
+    {
+        // All batches finish in the order they were submitted to the graphics queue
+        size_t finishedCount = 0;
+        for (UploadBatch* pBatch : _submittedBatches)
+        {
+            VkResult fenceStatus = wait ?
+                vkWaitForFences(_device, 1, &pBatch->fence, VK_TRUE, UINT64_MAX) :
+                vkGetFenceStatus(_device, pBatch->fence);
+            if (fenceStatus != VK_SUCCESS)
+                break;
+
+            ++finishedCount;
+            if (_freeBatches.size() >= s_maxFreeBatches)
+            {
+                destroyBatch(pBatch);
+                continue;
+            }
+
+            vkResetFences(_device, 1, &pBatch->fence);
+            for (StagingBuffer& stagingBuffer : pBatch->dedicatedStagingBuffers)
+                destroyStagingBuffer(stagingBuffer);
+            pBatch->dedicatedStagingBuffers.clear();
+            pBatch->stagingOffset = 0;
+            pBatch->transferRecording = false;
+            pBatch->graphicsRecording = false;
+            pBatch->uploadCount = 0;
+            _freeBatches.push_back(pBatch);
+        }
+        _submittedBatches.erase(_submittedBatches.begin(), _submittedBatches.begin() + finishedCount);
+    }
+
+    StagingBuffer UploadManager::createStagingBuffer(size_t size)
+    {
+        VkBufferCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        createInfo.size = size;
+        createInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        VmaAllocationCreateInfo allocInfo{};
+        allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+        allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+        StagingBuffer stagingBuffer;
+        VmaAllocationInfo vmaAllocationInfo{};
+        VkResult createResult = vmaCreateBuffer(
+            _vmaAllocator,
+            &createInfo,
+            &allocInfo,
+            &stagingBuffer.handle,
+            &stagingBuffer.vmaAllocation,
+            &vmaAllocationInfo
+        );
+        if (validate_result(createResult, "create staging buffer(vmaCreateBuffer)", PLATYPUS_CURRENT_FUNC_NAME))
+            stagingBuffer.pMappedData = vmaAllocationInfo.pMappedData;
+        return stagingBuffer;
+    }
+
+    void UploadManager::destroyStagingBuffer(StagingBuffer& stagingBuffer)
+    {
+        if (stagingBuffer.handle != VK_NULL_HANDLE)
+            vmaDestroyBuffer(_vmaAllocator, stagingBuffer.handle, stagingBuffer.vmaAllocation);
+        stagingBuffer = StagingBuffer();
+    }
+}
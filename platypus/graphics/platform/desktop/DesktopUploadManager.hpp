@@ -0,0 +1,130 @@
+#pragma once
+
+#include "platypus/graphics/CommandBuffer.hpp"
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+#include <vector>
+#include <functional>
+#include <mutex>
+
+
+namespace platypus
+{
+    struct StagingBuffer
+    {
+        VkBuffer handle = VK_NULL_HANDLE;
+        VmaAllocation vmaAllocation = VK_NULL_HANDLE;
+        void* pMappedData = nullptr;
+    };
+
+    // All uploads recorded between two submits.
+    //  -Buffer copies are recorded into the transfer command buffer, which gets submitted
+    //  to the dedicated transfer queue if the device has one (graphics queue otherwise).
+    //  -Image copies, layout transitions and mipmap blits need the graphics queue
+    //  -> recorded into the graphics command buffer.
+    // The graphics submission waits for the transfer submission, so the batch's
+    // fence signals when everything in it has finished.
+    struct UploadBatch
+    {
+        // Staging memory is suballocated linearly from the block.
+        // Uploads which don't fit in an empty block get their own staging buffer.
+        StagingBuffer stagingBlock;
+        size_t stagingOffset = 0;
+        std::vector<StagingBuffer> dedicatedStagingBuffers;
+
+        VkCommandBuffer transferCommandBuffer = VK_NULL_HANDLE;
+        CommandBuffer graphicsCommandBuffer;
+        bool transferRecording = false;
+        bool graphicsRecording = false;
+
+        VkSemaphore transferFinishedSemaphore = VK_NULL_HANDLE;
+        VkFence fence = VK_NULL_HANDLE;
+
+        size_t uploadCount = 0;
+
+        UploadBatch(const CommandBuffer& graphicsCommandBuffer);
+    };
+
+    // Replaces the old blocking single use command buffers (vkQueueSubmit + vkQueueWaitIdle per copy).
+    // Uploads are recorded into the current batch, which gets submitted:
+    //  -when the Device submits a frame
+    //  -when the staging block gets full
+    //  -when Device::submit_uploads or Device::wait_for_operations is called
+    // Finished batches are recycled with their staging blocks and command buffers.
+    //
+    // NOTE: Using fences and binary semaphores, since the device is created
+    // for Vulkan 1.0 (no timeline semaphores)
+    class UploadManager
+    {
+    private:
+        VkDevice _device = VK_NULL_HANDLE;
+        VmaAllocator _vmaAllocator = VK_NULL_HANDLE;
+        VkQueue _graphicsQueue = VK_NULL_HANDLE;
+        VkQueue _transferQueue = VK_NULL_HANDLE;
+        std::vector<uint32_t> _queueFamilyIndices;
+        // Own pools, so that recording uploads doesn't need to be synchronized
+        // with anything else using the Device's command pool
+        CommandPool* _pGraphicsCommandPool = nullptr;
+        VkCommandPool _transferCommandPool = VK_NULL_HANDLE;
+        size_t _stagingBlockSize = 0;
+
+        UploadBatch* _pRecordingBatch = nullptr;
+        // Oldest first
+        std::vector<UploadBatch*> _submittedBatches;
+        std::vector<UploadBatch*> _freeBatches;
+
+        // NOTE: Guards only the manager's own state. Submitting uses the queues without
+        // synchronizing with the Device's frame submission -> record uploads on the main thread.
+        std::mutex _mutex;
+
+    public:
+        UploadManager(
+            VkDevice device,
+            VmaAllocator vmaAllocator,
+            VkQueue graphicsQueue,
+            uint32_t graphicsFamilyIndex,
+            VkQueue transferQueue,
+            uint32_t transferFamilyIndex,
+            size_t stagingBlockSize
+        );
+        UploadManager(const UploadManager& other) = delete;
+        ~UploadManager();
+
+        // Copies pData to staging memory and records its copy to the start of destination
+        void recordBufferUpload(const void* pData, size_t dataSize, VkBuffer destination);
+
+        // Copies pData to staging memory at an offset aligned to alignment.
+        // The recordFunc records the actual copy commands into the graphics command buffer
+        // and gets the staging buffer and the data's offset in it.
+        void recordImageUpload(
+            const void* pData,
+            size_t dataSize,
+            size_t alignment,
+            const std::function<void(CommandBuffer&, VkBuffer, size_t)>& recordFunc
+        );
+
+        // Submits the recorded uploads without waiting for them
+        void submit();
+        // Submits the recorded uploads and blocks until all of them have finished
+        void waitForUploads();
+
+        inline bool hasDedicatedTransferQueue() const { return _queueFamilyIndices.size() > 1; }
+        // Queue families accessing buffers which are uploaded through this.
+        // If there are multiple, those buffers need to be created with VK_SHARING_MODE_CONCURRENT
+        inline const std::vector<uint32_t>& getQueueFamilyIndices() const { return _queueFamilyIndices; }
+
+    private:
+        // Returns staging memory for dataSize bytes in the recording batch.
+        // Submits the recording batch first if its block can't fit the data.
+        StagingBuffer& allocateStaging(size_t dataSize, size_t alignment, size_t& outOffset);
+        UploadBatch* accessRecordingBatch();
+        UploadBatch* createBatch();
+        void destroyBatch(UploadBatch* pBatch);
+        void submitRecordingBatch();
+        // Moves finished batches to the free batches
+        void recycleFinishedBatches(bool wait);
+
+        StagingBuffer createStagingBuffer(size_t size);
+        void destroyStagingBuffer(StagingBuffer& stagingBuffer);
+    };
+}
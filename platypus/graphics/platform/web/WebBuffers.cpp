@@ -290,4 +290,46 @@ namespace platypus
         GL_FUNC(glBufferData(glBufferType, dataSize, _pData, glBufferUpdateFrequency));
         GL_FUNC(glBindBuffer(glBufferType, 0));
     }
+
+    void Buffer::write(void* pData, size_t dataSize, size_t offset)
+    {
+        if (!_pData)
+        {
+            Debug::log(
+                "No buffer allocated host side!",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            PLATYPUS_ASSERT(false);
+            return;
+        }
+        if (!validateUpdate(pData, dataSize, offset) || offset + dataSize > getTotalSize())
+        {
+            Debug::log(
+                "Failed to write " + std::to_string(dataSize) + " bytes at offset " + std::to_string(offset) + " "
+                "to buffer with size " + std::to_string(getTotalSize()),
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            PLATYPUS_ASSERT(false);
+            return;
+        }
+        memcpy((void*)((PE_byte*)_pData + offset), pData, dataSize);
+        _hostSideUpdated = true;
+        markWritten(dataSize, offset);
+    }
+
+    void Buffer::flush()
+    {
+        if (_writtenBegin >= _writtenEnd)
+            return;
+
+        updateDevice(
+            (void*)((PE_byte*)_pData + _writtenBegin),
+            _writtenEnd - _writtenBegin,
+            _writtenBegin
+        );
+        _writtenBegin = 0;
+        _writtenEnd = 0;
+    }
 }
@@ -114,10 +114,12 @@ namespace platypus
     {
     }
 
+    // NOTE: Web doesn't have descriptor arrays -> arrayElement is ignored
     void DescriptorSet::update(
         DescriptorPool& descriptorPool,
         uint32_t binding,
-        DescriptorSetComponent component
+        DescriptorSetComponent component,
+        uint32_t arrayElement
     )
     {
         update_descriptor_pool_set(
@@ -165,6 +167,20 @@ namespace platypus
         return newDescriptorSet;
     }
 
+    DescriptorSet DescriptorPool::createTransientDescriptorSet(
+        const DescriptorSetLayout& layout,
+        const std::vector<DescriptorSetComponent>& components,
+        size_t frame
+    )
+    {
+        if (frame >= _pImpl->transientDescriptorSets.size())
+            _pImpl->transientDescriptorSets.resize(frame + 1);
+
+        DescriptorSet newDescriptorSet = createDescriptorSet(layout, components);
+        _pImpl->transientDescriptorSets[frame].push_back(newDescriptorSet._pImpl->id);
+        return newDescriptorSet;
+    }
+
     // NOTE: No idea if this works properly!
     void DescriptorPool::freeDescriptorSets(const std::vector<DescriptorSet>& descriptorSets)
     {
@@ -191,4 +207,18 @@ namespace platypus
         for (UUID_t idToErase : idsToErase)
             poolSetData.erase(idToErase);
     }
+
+    void DescriptorPool::resetTransientDescriptorSets(size_t frame)
+    {
+        if (frame >= _pImpl->transientDescriptorSets.size())
+            return;
+
+        std::vector<UUID_t>& frameDescriptorSets = _pImpl->transientDescriptorSets[frame];
+        for (UUID_t id : frameDescriptorSets)
+        {
+            _pImpl->descriptorSetData.erase(id);
+            UUID::erase(id, _pImpl->uuidPool);
+        }
+        frameDescriptorSets.clear();
+    }
 }
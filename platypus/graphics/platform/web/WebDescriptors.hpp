@@ -16,6 +16,8 @@ namespace platypus
     {
         size_t uuidPool = NULL_UUID;
         std::unordered_map<UUID_t, std::vector<DescriptorSetComponent>> descriptorSetData;
+        // Index = frame
+        std::vector<std::vector<UUID_t>> transientDescriptorSets;
 
         DescriptorPoolImpl();
         ~DescriptorPoolImpl();
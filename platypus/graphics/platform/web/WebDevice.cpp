@@ -13,6 +13,7 @@ namespace platypus
     Window* Device::s_pWindow = nullptr;
     DescriptorPool* Device::s_pDescriptorPool = nullptr;
     size_t Device::s_minUniformBufferOffsetAlignment = 0;
+    uint32_t Device::s_maxBindlessTextures = 0;
     CommandPool* Device::s_pCommandPool = nullptr;
 
     // NOTE: Not sure are these really all supported...
@@ -69,10 +70,22 @@ namespace platypus
     {
     }
 
+    void Device::submit_uploads()
+    {
+    }
+
+    void Device::wait_for_uploads()
+    {
+    }
+
     void Device::handle_window_resize()
     {
     }
 
+    void Device::save_pipeline_cache()
+    {
+    }
+
     size_t Device::get_min_uniform_buffer_offset_align()
     {
         return s_minUniformBufferOffsetAlignment;
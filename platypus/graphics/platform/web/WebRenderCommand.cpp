@@ -684,9 +684,19 @@ namespace platypus
         void draw_indexed(
             const CommandBuffer& commandBuffer,
             uint32_t count,
-            uint32_t instanceCount
+            uint32_t instanceCount,
+            uint32_t firstInstance
         )
         {
+            if (firstInstance != 0)
+            {
+                Debug::log(
+                    "@draw_indexed "
+                    "firstInstance(" + std::to_string(firstInstance) + ") not supported on web!",
+                    Debug::MessageType::PLATYPUS_ERROR
+                );
+                PLATYPUS_ASSERT(false);
+            }
             const IndexType& indexType = commandBuffer.getImpl()->drawIndexedType;
             // NOTE: Don't remember why not giving the ptr to the indices here..
             GL_FUNC(glDrawElementsInstanced(
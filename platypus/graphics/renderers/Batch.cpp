@@ -2,6 +2,7 @@
 #include "platypus/core/Application.hpp"
 #include "platypus/core/Debug.hpp"
 #include "platypus/graphics/Device.hpp"
+#include <algorithm>
 
 
 // NOTE: IMPORTANT!
@@ -26,9 +27,16 @@ namespace platypus
         RenderPassType::SCREEN_PASS
     };
 
-    DescriptorSetLayout Batcher::s_staticDescriptorSetLayout;
     DescriptorSetLayout Batcher::s_jointDescriptorSetLayout;
 
+    // Batch buffers are written straight to their persistently mapped memory on desktop.
+    // On web the host side copy is still needed for the "descriptor sets".
+    #ifdef PLATYPUS_BUILD_WEB
+    static const bool s_storeBatchBuffersHostSide = true;
+    #else
+    static const bool s_storeBatchBuffersHostSide = false;
+    #endif
+
     Batcher::Batcher(
         MasterRenderer& masterRenderer,
         DescriptorPool& descriptorPool,
@@ -44,25 +52,21 @@ namespace platypus
         _maxSkinnedBatchLength(maxSkinnedBatchLength),
         _maxSkinnedMeshJoints(maxSkinnedMeshJoints)
     {
-        s_staticDescriptorSetLayout = DescriptorSetLayout(
-            {
-                {
-                    0,
-                    1,
-                    DescriptorType::DESCRIPTOR_TYPE_DYNAMIC_UNIFORM_BUFFER,
-                    ShaderStageFlagBits::SHADER_STAGE_VERTEX_BIT,
-                    {
-                        { ShaderDataType::Mat4 }
-                    }
-                }
-            }
-        );
+        // Skinned meshes' joint palettes.
+        // On desktop the palettes of the whole batch are in a single storage buffer which
+        // the vertex shader indexes using the instance index.
+        // WebGL2 has no storage buffers -> each palette is a dynamic uniform buffer element.
+        #ifdef PLATYPUS_BUILD_WEB
+        const DescriptorType jointDescriptorType = DescriptorType::DESCRIPTOR_TYPE_DYNAMIC_UNIFORM_BUFFER;
+        #else
+        const DescriptorType jointDescriptorType = DescriptorType::DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        #endif
         s_jointDescriptorSetLayout = DescriptorSetLayout(
             {
                 {
                     0,
                     1,
-                    DescriptorType::DESCRIPTOR_TYPE_DYNAMIC_UNIFORM_BUFFER,
+                    jointDescriptorType,
                     ShaderStageFlagBits::SHADER_STAGE_VERTEX_BIT,
                     { { ShaderDataType::Mat4, (int)_maxSkinnedMeshJoints } }
                 }
@@ -70,27 +74,24 @@ namespace platypus
         );
 
         // Create batch templates
-        const size_t staticBatchDynamicUBOElemSize = get_dynamic_uniform_buffer_element_size(
-            sizeof(Matrix4f)
-        );
+        //
+        // Static meshes' transformation matrices go to the instanced vertex buffer
+        // -> whole batch gets drawn with a single instanced draw call.
+        // Skinned meshes' joint palettes go to the joint storage buffer
+        // -> whole batch gets drawn with a single instanced draw call as well.
+        // On web skinned meshes are drawn once per repeat using the palette's
+        // dynamic uniform buffer offset instead.
         const uint32_t staticMeshPropertyFlags = static_cast<uint32_t>(MeshPropertyFlagBits::TYPE_STATIC);
         const uint32_t staticInstancedMeshPropertyFlags = staticMeshPropertyFlags | static_cast<uint32_t>(MeshPropertyFlagBits::INSTANCED);
         const uint32_t skinnedMeshPropertyFlags = static_cast<uint32_t>(MeshPropertyFlagBits::TYPE_SKINNED);
         _batchTemplates[staticMeshPropertyFlags] = {
             _maxStaticBatchLength, // maxBatchLength
-            (uint32_t)_maxStaticBatchLength, // maxRepeatCount
-            1, // repeatAdvance,
-            1, // maxInstanceCount,
-            0, // instanceAdvance,
-            0, // instance buffer elem size
-            {
-                {
-                    ShaderResourceType::ANY,
-                    staticBatchDynamicUBOElemSize,
-                    s_staticDescriptorSetLayout,
-                    { }
-                }
-            } // uniform resource layouts
+            1, // maxRepeatCount,
+            0, // repeatAdvance,
+            (uint32_t)_maxStaticBatchLength, // maxInstanceCount,
+            1, // instanceAdvance,
+            sizeof(Matrix4f), // instance buffer elem size
+            { } // uniform resource layouts
         };
 
         _batchTemplates[staticInstancedMeshPropertyFlags] = {
@@ -103,6 +104,7 @@ namespace platypus
             { } // uniform resource layouts
         };
 
+        #ifdef PLATYPUS_BUILD_WEB
         const size_t dynamicJointBufferElemSize = get_dynamic_uniform_buffer_element_size(
             sizeof(Matrix4f) * _maxSkinnedMeshJoints
         );
@@ -122,13 +124,30 @@ namespace platypus
                 }
             }, // uniform resource layouts
         };
+        #else
+        _batchTemplates[skinnedMeshPropertyFlags] = {
+            _maxSkinnedBatchLength,
+            1, // maxRepeatCount,
+            0, // repeatAdvance,
+            (uint32_t)_maxSkinnedBatchLength, // maxInstanceCount,
+            1, // instanceAdvance,
+            0, // instance buffer elem size
+            {
+                {
+                    ShaderResourceType::ANY,
+                    sizeof(Matrix4f) * _maxSkinnedMeshJoints, // NOTE: No alignment requirement for storage buffer elements
+                    s_jointDescriptorSetLayout,
+                    { }
+                }
+            }, // uniform resource layouts
+        };
+        #endif
     }
 
     Batcher::~Batcher()
     {
-        destroyManagedPipelines();
+        releaseManagedPipelines();
 
-        s_staticDescriptorSetLayout.destroy();
         s_jointDescriptorSetLayout.destroy();
     }
 
@@ -138,17 +157,13 @@ namespace platypus
     )
     {
         std::string shaderName = "shadows/";
-        std::string extension;
 
         bool isStatic = meshPropertyFlags & static_cast<uint32_t>(MeshPropertyFlagBits::TYPE_STATIC);
-        bool instanced = meshPropertyFlags & static_cast<uint32_t>(MeshPropertyFlagBits::INSTANCED);
         bool isSkinned = meshPropertyFlags & static_cast<uint32_t>(MeshPropertyFlagBits::TYPE_SKINNED);
 
         if (isStatic)
         {
             shaderName += "Static";
-            if (instanced)
-                extension = shaderStage == ShaderStageFlagBits::SHADER_STAGE_VERTEX_BIT ? "_i" : "";
         }
         else if (isSkinned)
         {
@@ -206,48 +221,7 @@ namespace platypus
                 return "";
             }
         }
-        return shaderName + "Shader" + extension;
-    }
-
-    BatchPipelineData* Batcher::createBatchPipelineData(
-        const RenderPass* pRenderPass,
-        const std::string& vertexShaderFilename,
-        const std::string& fragmentShaderFilename,
-        const std::vector<VertexBufferLayout>& vertexBufferLayouts,
-        const std::vector<DescriptorSetLayout>& descriptorSetLayouts,
-        CullMode cullMode,
-        size_t pushConstantsSize,
-        ShaderStageFlagBits pushConstantsShaderStage
-    )
-    {
-        BatchPipelineData* pPipelineData = new BatchPipelineData;
-        pPipelineData = new BatchPipelineData;
-        pPipelineData->pVertexShader = new Shader(
-            vertexShaderFilename,
-            ShaderStageFlagBits::SHADER_STAGE_VERTEX_BIT
-        );
-        pPipelineData->pFragmentShader = new Shader(
-            fragmentShaderFilename,
-            ShaderStageFlagBits::SHADER_STAGE_FRAGMENT_BIT
-        );
-
-        pPipelineData->pPipeline = new Pipeline(
-            pRenderPass,
-            vertexBufferLayouts,
-            descriptorSetLayouts,
-            pPipelineData->pVertexShader,
-            pPipelineData->pFragmentShader,
-            cullMode,
-            FrontFace::FRONT_FACE_COUNTER_CLOCKWISE,
-            true, // Enable depth test
-            true, // Enable depth write
-            DepthCompareOperation::COMPARE_OP_LESS,
-            true, // Enable color blend
-            pushConstantsSize, // Push constants size
-            pushConstantsShaderStage // Push constants' stage flags
-        );
-        pPipelineData->pPipeline->create();
-        return pPipelineData;
+        return shaderName + "Shader";
     }
 
     void Batcher::updateDeviceSideBuffers(size_t currentFrame)
@@ -257,15 +231,12 @@ namespace platypus
         {
             for (BatchShaderResource& resource : it->second)
             {
-                // NOTE: Do we need to really update the whole buffer if it's not used entirely?
-                Buffer* pBuffer = resource.buffer[currentFrame];
-                pBuffer->updateDevice();
-                // NOTE: Why the fuck was below done earlier?
-                //pBuffer->updateDevice(
-                //    pBuffer->accessData(),
-                //    pBuffer->getTotalSize(),
-                //    0
-                //);
+                if (!resource.requiresDeviceUpdate || resource.buffer.empty())
+                    continue;
+
+                // Only the range written this frame gets flushed
+                resource.buffer[currentFrame]->flush();
+                resource.requiresDeviceUpdate = false;
             }
         }
     }
@@ -282,20 +253,35 @@ namespace platypus
                 Batch* pBatch = batchIt->second;
                 pBatch->instanceCount = 0;
                 pBatch->repeatCount = 0;
+                pBatch->firstRepeat = 0;
+                pBatch->culledCount = 0;
+                pBatch->minDepth = 0.0f;
+                pBatch->maxDepth = 0.0f;
             }
         }
+
+        std::unordered_map<UUID_t, uint32_t>::iterator entryCountIt;
+        for (entryCountIt = _sharedEntryCounts.begin(); entryCountIt != _sharedEntryCounts.end(); ++entryCountIt)
+            entryCountIt->second = 0;
+
+        std::unordered_map<UUID_t, BatchChunks>::iterator chunksIt;
+        for (chunksIt = _batchChunks.begin(); chunksIt != _batchChunks.end(); ++chunksIt)
+            chunksIt->second.activeChunk = 0;
     }
 
     void Batcher::freeBatch(UUID_t batchID)
     {
+        // Chunks of this batch need to be freed as well
+        freeBatchChunks(batchID);
+
         Device::wait_for_operations();
         // NOTE: Don't remember are manager pipelines shared?
         //  -> seems fine atm...?
-        std::unordered_map<UUID_t, BatchPipelineData*>::iterator managedPipelineIt = _managedPipelineData.find(batchID);
-        if (managedPipelineIt != _managedPipelineData.end())
+        std::unordered_map<UUID_t, Pipeline*>::iterator managedPipelineIt = _managedPipelines.find(batchID);
+        if (managedPipelineIt != _managedPipelines.end())
         {
-            delete managedPipelineIt->second;
-            _managedPipelineData.erase(batchID);
+            _masterRendererRef.getPipelineRegistry().releasePipeline(managedPipelineIt->second);
+            _managedPipelines.erase(managedPipelineIt);
         }
 
         bool destroyResources = false;
@@ -341,6 +327,7 @@ namespace platypus
                 passBatches.erase(batchID);
             }
         }
+        _sharedEntryCounts.erase(batchID);
     }
 
     void Batcher::freeBatches()
@@ -374,7 +361,8 @@ namespace platypus
             for (batchIt = passBatches.begin(); batchIt != passBatches.end(); ++batchIt)
             {
                 Batch* pBatch = batchIt->second;
-                if (pBatch->repeatCount == 0)
+                // Batches having only culled entries are still in use
+                if (pBatch->repeatCount == 0 && pBatch->culledCount == 0)
                     batchesToPrune[passBatchIt->first].insert(batchIt->first);
             }
         }
@@ -400,11 +388,6 @@ namespace platypus
         }
     }
 
-    const DescriptorSetLayout& Batcher::get_static_descriptor_set_layout()
-    {
-        return s_staticDescriptorSetLayout;
-    }
-
     const DescriptorSetLayout& Batcher::get_joint_descriptor_set_layout()
     {
         return s_jointDescriptorSetLayout;
@@ -427,7 +410,7 @@ namespace platypus
                 maxBatchLength,
                 BufferUsageFlagBits::BUFFER_USAGE_VERTEX_BUFFER_BIT,
                 BufferUpdateFrequency::BUFFER_UPDATE_FREQUENCY_STREAM,
-                true
+                s_storeBatchBuffersHostSide
             );
         }
         addToAllocatedShaderResources(identifier, outBuffers, {});
@@ -478,19 +461,23 @@ namespace platypus
                         ++useTextureIndex;
                     }
                     else if (descriptorType == DescriptorType::DESCRIPTOR_TYPE_UNIFORM_BUFFER ||
-                            descriptorType == DescriptorType::DESCRIPTOR_TYPE_DYNAMIC_UNIFORM_BUFFER
+                            descriptorType == DescriptorType::DESCRIPTOR_TYPE_DYNAMIC_UNIFORM_BUFFER ||
+                            descriptorType == DescriptorType::DESCRIPTOR_TYPE_STORAGE_BUFFER
                             )
                     {
                         const size_t bufferElementSize = resourceLayout.uniformBufferElementSize;
                         std::vector<char> bufferData(bufferElementSize * maxBatchLength);
                         memset(bufferData.data(), 0, bufferData.size());
+                        const BufferUsageFlagBits bufferUsage = descriptorType == DescriptorType::DESCRIPTOR_TYPE_STORAGE_BUFFER ?
+                            BufferUsageFlagBits::BUFFER_USAGE_STORAGE_BUFFER_BIT :
+                            BufferUsageFlagBits::BUFFER_USAGE_UNIFORM_BUFFER_BIT;
                         Buffer* pUniformBuffer = new Buffer(
                             bufferData.data(),
                             bufferElementSize,
                             maxBatchLength,
-                            BufferUsageFlagBits::BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                            bufferUsage,
                             BufferUpdateFrequency::BUFFER_UPDATE_FREQUENCY_DYNAMIC,
-                            true
+                            s_storeBatchBuffersHostSide
                         );
                         outResource.buffer[frameIndex] = pUniformBuffer;
 
@@ -629,24 +616,14 @@ namespace platypus
 
     }
 
-    void Batcher::destroyManagedPipelines()
+    void Batcher::releaseManagedPipelines()
     {
-        std::unordered_map<UUID_t, BatchPipelineData*>::iterator it;
-        for (it = _managedPipelineData.begin(); it != _managedPipelineData.end(); ++it)
-            delete it->second;
-
-        _managedPipelineData.clear();
-    }
+        PipelineRegistry& pipelineRegistry = _masterRendererRef.getPipelineRegistry();
+        std::unordered_map<UUID_t, Pipeline*>::iterator it;
+        for (it = _managedPipelines.begin(); it != _managedPipelines.end(); ++it)
+            pipelineRegistry.releasePipeline(it->second);
 
-    void Batcher::recreateManagedPipelines()
-    {
-        std::unordered_map<UUID_t, BatchPipelineData*>::iterator it;
-        for (it = _managedPipelineData.begin(); it != _managedPipelineData.end(); ++it)
-        {
-            Pipeline* pPipeline = it->second->pPipeline;
-            pPipeline->destroy();
-            pPipeline->create();
-        }
+        _managedPipelines.clear();
     }
 
     void Batcher::createBatch(
@@ -660,10 +637,12 @@ namespace platypus
         size_t instanceBufferElementSize,
         const std::vector<ShaderResourceLayout>& uniformResourceLayouts,
         const Light * const pDirectionalLight,
-        const RenderPass* pRenderPass
+        const RenderPass* pRenderPass,
+        size_t chunkIndex
     )
     {
-        UUID_t batchID = UUID::hash(meshID, materialID);
+        const UUID_t firstChunkID = UUID::hash(meshID, materialID);
+        UUID_t batchID = get_batch_chunk_id(firstChunkID, chunkIndex);
         RenderPassType renderPassType = pRenderPass->getType();
         if (!validateBatchDoesntExist("Batcher::createBatch", renderPassType, batchID))
             return;
@@ -781,6 +760,15 @@ namespace platypus
             pPushConstantsData = (void*)pDirectionalLight;
         }
 
+        // Bindless Materials' index is pushed to the fragment shader
+        //  -> if also receiving shadows, the whole push constant range is used by both stages
+        uint32_t bindlessMaterialIndex = PLATYPUS_BINDLESS_INVALID_INDEX;
+        if (pMaterial && !shadowPass && pMaterial->isBindless())
+        {
+            bindlessMaterialIndex = pMaterial->getBindlessMaterialIndex();
+            pushConstantsShaderStage = (ShaderStageFlagBits)(pushConstantsShaderStage | ShaderStageFlagBits::SHADER_STAGE_FRAGMENT_BIT);
+        }
+
         // Shared shader resources (uniform buffers + descriptor sets)
         uint32_t dynamicUniformBufferElementSize = 0;
         if (!uniformResourceLayouts.empty())
@@ -804,7 +792,11 @@ namespace platypus
                 uniformResourceLayouts,
                 framesInFlight
             );
-            dynamicUniformBufferElementSize = uniformResourceLayouts[0].uniformBufferElementSize;
+            // NOTE: Storage buffer elements are indexed in the shader instead of
+            // using dynamic offsets
+            const DescriptorSetLayoutBinding& resourceBinding = uniformResourceLayouts[0].descriptorSetLayout.getBindings()[0];
+            if (resourceBinding.getType() == DescriptorType::DESCRIPTOR_TYPE_DYNAMIC_UNIFORM_BUFFER)
+                dynamicUniformBufferElementSize = uniformResourceLayouts[0].uniformBufferElementSize;
             for (BatchShaderResource& resource : createdShaderResources)
                 usedDescriptorSets.push_back(resource.descriptorSet);
         }
@@ -823,43 +815,39 @@ namespace platypus
         // Allow some more flexible way of creating pipelines without Materials?
         if (!pPipeline)
         {
-            bool instanced = meshPropertyFlags & static_cast<uint32_t>(MeshPropertyFlagBits::INSTANCED);
+            PipelineDescription pipelineDescription;
+            pipelineDescription.pRenderPass = pRenderPass;
+            pipelineDescription.vertexShaderFilename = get_shadowpass_shader_name(
+                ShaderStageFlagBits::SHADER_STAGE_VERTEX_BIT,
+                meshPropertyFlags
+            );
+            pipelineDescription.fragmentShaderFilename = get_shadowpass_shader_name(
+                ShaderStageFlagBits::SHADER_STAGE_FRAGMENT_BIT,
+                meshPropertyFlags
+            );
+
+            bool instanced = uses_instanced_transforms(meshPropertyFlags);
             bool skinned = meshPropertyFlags & static_cast<uint32_t>(MeshPropertyFlagBits::TYPE_SKINNED);
-            std::vector<VertexBufferLayout> usedVertexBufferLayouts;
             _masterRendererRef.solveVertexBufferLayouts(
                 pMesh->getVertexBufferLayout(),
                 instanced,
                 skinned,
                 shadowPass, // shadow pipeline?
-                usedVertexBufferLayouts
+                pipelineDescription.vertexBufferLayouts
             );
             // NOTE: WARNING! There's an issue if the pipeline requires more descriptor set layouts
             // than provided with the inputted uniformResourceLayouts!
-            std::vector<DescriptorSetLayout> usedDescriptorSetLayouts;
             for (const ShaderResourceLayout& resourceLayout : uniformResourceLayouts)
-                usedDescriptorSetLayouts.push_back(resourceLayout.descriptorSetLayout);
+                pipelineDescription.descriptorSetLayouts.push_back(resourceLayout.descriptorSetLayout);
 
-            std::string vertexShaderFilename = get_shadowpass_shader_name(
-                ShaderStageFlagBits::SHADER_STAGE_VERTEX_BIT,
-                meshPropertyFlags
-            );
-            std::string fragmentShaderFilename = get_shadowpass_shader_name(
-                ShaderStageFlagBits::SHADER_STAGE_FRAGMENT_BIT,
-                meshPropertyFlags
-            );
-            BatchPipelineData* pPipelineData = createBatchPipelineData(
-                pRenderPass,
-                vertexShaderFilename,
-                fragmentShaderFilename,
-                usedVertexBufferLayouts,
-                usedDescriptorSetLayouts,
-                CullMode::CULL_MODE_FRONT,
-                pushConstantsSize,
-                pushConstantsShaderStage
-            );
-            PLATYPUS_ASSERT(_managedPipelineData.find(batchID) == _managedPipelineData.end());
-            _managedPipelineData[batchID] = pPipelineData;
-            pPipeline = pPipelineData->pPipeline;
+            pipelineDescription.cullMode = CullMode::CULL_MODE_FRONT;
+            pipelineDescription.pushConstantSize = (uint32_t)pushConstantsSize;
+            pipelineDescription.pushConstantStageFlags = pushConstantsShaderStage;
+
+            // NOTE: Chunks and batches of other meshes of the same type get the same pipeline
+            pPipeline = _masterRendererRef.getPipelineRegistry().acquirePipeline(pipelineDescription);
+            PLATYPUS_ASSERT(_managedPipelines.find(batchID) == _managedPipelines.end());
+            _managedPipelines[batchID] = pPipeline;
         }
 
         Batch* pBatch = new Batch{
@@ -873,7 +861,7 @@ namespace platypus
             pushConstantsSize,
             pushConstantsUniformInfos,
             pPushConstantsData,
-            // Atm push constants should ONLY be used in vertex shaders!
+            // Atm push constants are used in vertex shaders, except bindless Materials' index
             pushConstantsShaderStage,
             0, // repeat count
             maxRepeatCount, // max repeat count
@@ -882,15 +870,42 @@ namespace platypus
             maxInstanceCount, // max instance count
             instanceAdvance // instance advance
         };
+        pBatch->pRenderPass = pRenderPass;
+        pBatch->meshID = meshID;
+        pBatch->materialID = materialID;
+        pBatch->bindlessMaterialIndex = bindlessMaterialIndex;
 
         _batches[renderPassType][batchID] = pBatch;
+
+        BatchChunks& chunks = _batchChunks[firstChunkID];
+        chunks.meshID = meshID;
+        chunks.materialID = materialID;
+        chunks.pDirectionalLight = pDirectionalLight;
+        if (chunks.chunkIDs.size() <= chunkIndex)
+            chunks.chunkIDs.resize(chunkIndex + 1, NULL_UUID);
+        chunks.chunkIDs[chunkIndex] = batchID;
+        if (chunkIndex > 0)
+            _chunkBaseIDs[batchID] = firstChunkID;
+
+        // If the first chunk's batch was created for a new render pass, the existing
+        // following chunks need it too
+        if (chunkIndex == 0)
+        {
+            const size_t chunkCount = chunks.chunkIDs.size();
+            for (size_t i = 1; i < chunkCount; ++i)
+            {
+                if (!getBatch(renderPassType, get_batch_chunk_id(firstChunkID, i)))
+                    createBatch(meshID, materialID, pDirectionalLight, pRenderPass, i);
+            }
+        }
     }
 
     void Batcher::createBatch(
         UUID_t meshID,
         UUID_t materialID,
         const Light * const pDirectionalLight,
-        const RenderPass* pRenderPass
+        const RenderPass* pRenderPass,
+        size_t chunkIndex
     )
     {
         AssetManager* pAssetManager = Application::get_instance()->getAssetManager();
@@ -933,48 +948,81 @@ namespace platypus
             creationTemplate.instanceBufferElementSize,
             creationTemplate.uniformResourceLayouts,
             pDirectionalLight,
-            pRenderPass
+            pRenderPass,
+            chunkIndex
         );
     }
 
     void Batcher::addToBatch(
-        UUID_t batchID,
+        UUID_t firstChunkID,
         void* pData,
         size_t dataSize,
         const std::vector<size_t>& dataElementSizes,
-        size_t currentFrame
+        size_t currentFrame,
+        uint32_t renderPassMask,
+        float viewDepth
     )
     {
-        // Need to update each render passes batches' instance or/and repeat counts
-        // BUT update their shared transforms buffer ONLY ONCE!
-        // ...this is quite dumb I know...
-        bool resourcesUpdated = false;
-        for (Batch* pBatch : getBatches(batchID))
+        // Each render pass' batch of the same batchID shares the same resources
+        // -> the entry gets written ONLY ONCE to the shared resources and the batches
+        // of the passes in renderPassMask draw the shared entries in range
+        // [firstRepeat, firstRepeat + repeatCount).
+        const UUID_t batchID = getNextEntryChunk(firstChunkID);
+        if (batchID == NULL_UUID)
+            return;
+
+        Batch* passBatches[PLATYPUS_BATCHER_AVAILABLE_RENDER_PASSES];
+        #ifdef PLATYPUS_BUILD_WEB
+        bool instanced = false;
+        #endif
+        for (size_t i = 0; i < PLATYPUS_BATCHER_AVAILABLE_RENDER_PASSES; ++i)
         {
-            // TODO: allow using both, instance and uniform buffers!
-            bool usingInstanceBuffer = pBatch->instanceAdvance > 0;
+            passBatches[i] = getBatch(s_availableRenderPasses[i], batchID);
+            #ifdef PLATYPUS_BUILD_WEB
+            if (passBatches[i] && passBatches[i]->instanceAdvance > 0)
+                instanced = true;
+            #endif
+        }
+        // Instanced batches can't start drawing from an offset on web, since base instance
+        // isn't available -> those are added to all passes if any of the passes wants it.
+        #ifdef PLATYPUS_BUILD_WEB
+        if (instanced && renderPassMask != 0)
+            renderPassMask = render_pass_mask_all;
+        #endif
+
+        uint32_t& sharedEntryCount = _sharedEntryCounts[batchID];
+        bool addedToAnyPass = false;
+        for (size_t i = 0; i < PLATYPUS_BATCHER_AVAILABLE_RENDER_PASSES; ++i)
+        {
+            Batch* pBatch = passBatches[i];
+            if (!pBatch)
+                continue;
+
+            if ((renderPassMask & render_pass_bit(s_availableRenderPasses[i])) == 0)
+            {
+                ++pBatch->culledCount;
+                continue;
+            }
 
-            // TODO: Create new batch if this one is full!
-            //  -> Need to have some kind of thing where multiple batches can exist for the same
-            //  identifier for the same render pass
-            if (pBatch->repeatCount >= pBatch->maxRepeatCount && pBatch->repeatAdvance > 0)
+            // NOTE: Shouldn't happen since getNextEntryChunk gives a chunk with free space
+            if (sharedEntryCount >= pBatch->maxRepeatCount && pBatch->repeatAdvance > 0)
             {
                 Debug::log(
                     "@Batcher::addToBatch "
                     "BatchID: " + std::to_string(batchID) + " "
-                    "repeat count(" + std::to_string(pBatch->repeatCount) + ") "
+                    "repeat count(" + std::to_string(sharedEntryCount) + ") "
                     "reached its maximum(" + std::to_string(pBatch->maxRepeatCount) + ")",
                     Debug::MessageType::PLATYPUS_ERROR
                 );
                 PLATYPUS_ASSERT(false);
                 return;
             }
-            if (pBatch->instanceCount >= pBatch->maxInstanceCount && pBatch->instanceAdvance > 0)
+            if (sharedEntryCount >= pBatch->maxInstanceCount && pBatch->instanceAdvance > 0)
             {
                 Debug::log(
                     "@Batcher::addToBatch "
                     "BatchID: " + std::to_string(batchID) + " "
-                    "instance count(" + std::to_string(pBatch->instanceCount) + ") "
+                    "instance count(" + std::to_string(sharedEntryCount) + ") "
                     "reached its maximum(" + std::to_string(pBatch->maxInstanceCount) + ")",
                     Debug::MessageType::PLATYPUS_ERROR
                 );
@@ -982,89 +1030,135 @@ namespace platypus
                 return;
             }
 
-            if (!resourcesUpdated)
+            // Batch can only draw a contiguous range of the shared entries
+            const uint32_t drawnEntryCount = pBatch->repeatAdvance > 0 ? pBatch->repeatCount : pBatch->instanceCount;
+            if (drawnEntryCount > 0 && pBatch->firstRepeat + drawnEntryCount != sharedEntryCount)
             {
-                if (batchResourcesExist(batchID))
-                {
-                    size_t inputDataIndex = 0;
-                    size_t inputDataOffset = 0;
-                    const uint32_t entryCount = usingInstanceBuffer ? pBatch->instanceCount : pBatch->repeatCount;
-                    for (BatchShaderResource& resource : accessSharedBatchResources(batchID))
-                    {
-                        if (resource.buffer.empty())
-                            continue;
+                Debug::log(
+                    "@Batcher::addToBatch "
+                    "BatchID: " + std::to_string(batchID) + " "
+                    "entries for render pass: " + render_pass_type_to_string(s_availableRenderPasses[i]) + " "
+                    "weren't added contiguously. Add entries for different render pass masks in separate groups!",
+                    Debug::MessageType::PLATYPUS_ERROR
+                );
+                PLATYPUS_ASSERT(false);
+                return;
+            }
+            addedToAnyPass = true;
+        }
 
-                        Buffer* pBuffer = resource.buffer[currentFrame];
+        if (!addedToAnyPass)
+            return;
 
+        if (batchResourcesExist(batchID))
+        {
+            size_t inputDataIndex = 0;
+            size_t inputDataOffset = 0;
+            for (BatchShaderResource& resource : accessSharedBatchResources(batchID))
+            {
+                if (resource.buffer.empty())
+                    continue;
 
-                        // FUCKED UP ATM! NEED TO ADVANCE INPUT BUFFER AT DIFFERENT PACE THAN
-                        // THE RESOURCE BUFFER, SINCE RESOURCE BUFFER'S ELEM SIZE CAN BE BIGGER
-                        // THAN THE ACTUAL DATA ELEM SIZE (dyamic uniform buffer offset alignment
-                        // requirement)!!!
-                        const size_t bufferUpdateSize = pBuffer->getDataElemSize();
-                        const size_t bufferUpdateOffset = pBuffer->getDataElemSize() * entryCount;
+                Buffer* pBuffer = resource.buffer[currentFrame];
 
-                        // Make sure inside input data range
-                        if (inputDataIndex > dataElementSizes.size())
-                        {
-                            Debug::log(
-                                "@Batcher::addToBatch "
-                                "inputDataIndex(" + std::to_string(inputDataIndex) + ") out of bounds! "
-                                "Provided data element sizes: " + std::to_string(dataElementSizes.size()),
-                                Debug::MessageType::PLATYPUS_ERROR
-                            );
-                            PLATYPUS_ASSERT(false);
-                            return;
-                        }
-                        if (inputDataOffset > dataSize)
-                        {
-                            Debug::log(
-                                "@Batcher::addToBatch "
-                                "inputDataOffset(" + std::to_string(inputDataOffset) + ") out of bounds! "
-                                "Inputted data size: " + std::to_string(dataSize),
-                                Debug::MessageType::PLATYPUS_ERROR
-                            );
-                            PLATYPUS_ASSERT(false);
-                            return;
-                        }
 
-                        // Make sure inside resource range
-                        if (bufferUpdateSize + bufferUpdateOffset > pBuffer->getTotalSize())
-                        {
-                            Debug::log(
-                                "@Batcher::addToBatch "
-                                "buffer updateOffset(" + std::to_string(bufferUpdateOffset) + ") "
-                                "out of bounds. Buffer's total size: " + std::to_string(pBuffer->getTotalSize()) + " "
-                                "buffer element size: " + std::to_string(pBuffer->getDataElemSize()),
-                                Debug::MessageType::PLATYPUS_ERROR
-                            );
-                            PLATYPUS_ASSERT(false);
-                            return;
-                        }
+                // FUCKED UP ATM! NEED TO ADVANCE INPUT BUFFER AT DIFFERENT PACE THAN
+                // THE RESOURCE BUFFER, SINCE RESOURCE BUFFER'S ELEM SIZE CAN BE BIGGER
+                // THAN THE ACTUAL DATA ELEM SIZE (dyamic uniform buffer offset alignment
+                // requirement)!!!
+                const size_t bufferUpdateSize = pBuffer->getDataElemSize();
+                const size_t bufferUpdateOffset = pBuffer->getDataElemSize() * sharedEntryCount;
 
-                        pBuffer->updateHost(
-                            (void*)((PE_ubyte*)pData + inputDataOffset),
-                            bufferUpdateSize,
-                            bufferUpdateOffset
-                        );
-                        resource.requiresDeviceUpdate = true;
-                        inputDataOffset += dataElementSizes[inputDataIndex];
-                        ++inputDataIndex;
-                    }
-                    resourcesUpdated = true;
+                // Make sure inside input data range
+                if (inputDataIndex > dataElementSizes.size())
+                {
+                    Debug::log(
+                        "@Batcher::addToBatch "
+                        "inputDataIndex(" + std::to_string(inputDataIndex) + ") out of bounds! "
+                        "Provided data element sizes: " + std::to_string(dataElementSizes.size()),
+                        Debug::MessageType::PLATYPUS_ERROR
+                    );
+                    PLATYPUS_ASSERT(false);
+                    return;
                 }
+                if (inputDataOffset > dataSize)
+                {
+                    Debug::log(
+                        "@Batcher::addToBatch "
+                        "inputDataOffset(" + std::to_string(inputDataOffset) + ") out of bounds! "
+                        "Inputted data size: " + std::to_string(dataSize),
+                        Debug::MessageType::PLATYPUS_ERROR
+                    );
+                    PLATYPUS_ASSERT(false);
+                    return;
+                }
+
+                // Make sure inside resource range
+                if (bufferUpdateSize + bufferUpdateOffset > pBuffer->getTotalSize())
+                {
+                    Debug::log(
+                        "@Batcher::addToBatch "
+                        "buffer updateOffset(" + std::to_string(bufferUpdateOffset) + ") "
+                        "out of bounds. Buffer's total size: " + std::to_string(pBuffer->getTotalSize()) + " "
+                        "buffer element size: " + std::to_string(pBuffer->getDataElemSize()),
+                        Debug::MessageType::PLATYPUS_ERROR
+                    );
+                    PLATYPUS_ASSERT(false);
+                    return;
+                }
+
+                pBuffer->write(
+                    (void*)((PE_ubyte*)pData + inputDataOffset),
+                    bufferUpdateSize,
+                    bufferUpdateOffset
+                );
+                resource.requiresDeviceUpdate = true;
+                inputDataOffset += dataElementSizes[inputDataIndex];
+                ++inputDataIndex;
+            }
+        }
+
+        for (size_t i = 0; i < PLATYPUS_BATCHER_AVAILABLE_RENDER_PASSES; ++i)
+        {
+            Batch* pBatch = passBatches[i];
+            if (!pBatch || (renderPassMask & render_pass_bit(s_availableRenderPasses[i])) == 0)
+                continue;
+
+            const uint32_t drawnEntryCount = pBatch->repeatAdvance > 0 ? pBatch->repeatCount : pBatch->instanceCount;
+            if (drawnEntryCount == 0)
+            {
+                pBatch->minDepth = viewDepth;
+                pBatch->maxDepth = viewDepth;
+            }
+            else
+            {
+                pBatch->minDepth = std::min(pBatch->minDepth, viewDepth);
+                pBatch->maxDepth = std::max(pBatch->maxDepth, viewDepth);
             }
 
             if (pBatch->repeatAdvance == 0)
+            {
                 pBatch->repeatCount = 1;
+            }
             else
+            {
+                if (pBatch->repeatCount == 0)
+                    pBatch->firstRepeat = sharedEntryCount;
                 pBatch->repeatCount += pBatch->repeatAdvance;
+            }
 
             if (pBatch->instanceAdvance == 0)
+            {
                 pBatch->instanceCount = 1;
+            }
             else
+            {
+                if (pBatch->instanceCount == 0)
+                    pBatch->firstRepeat = sharedEntryCount;
                 pBatch->instanceCount += pBatch->instanceAdvance;
+            }
         }
+        ++sharedEntryCount;
     }
 
     std::vector<RenderPassType> Batcher::get_available_render_passes()
@@ -1074,6 +1168,133 @@ namespace platypus
         return outPassTypes;
     }
 
+    UUID_t Batcher::get_batch_chunk_id(UUID_t batchID, size_t chunkIndex)
+    {
+        if (chunkIndex == 0)
+            return batchID;
+        return UUID::hash(batchID, static_cast<UUID_t>(chunkIndex));
+    }
+
+    std::vector<UUID_t> Batcher::getBatchChunkIDs(UUID_t batchID) const
+    {
+        std::unordered_map<UUID_t, BatchChunks>::const_iterator chunksIt = _batchChunks.find(batchID);
+        if (chunksIt == _batchChunks.end())
+            return { };
+        return chunksIt->second.chunkIDs;
+    }
+
+    UUID_t Batcher::getNextEntryChunk(UUID_t batchID)
+    {
+        std::unordered_map<UUID_t, BatchChunks>::iterator chunksIt = _batchChunks.find(batchID);
+        if (chunksIt == _batchChunks.end())
+            return batchID;
+
+        BatchChunks& chunks = chunksIt->second;
+        while (true)
+        {
+            const UUID_t chunkID = chunks.chunkIDs[chunks.activeChunk];
+            Batch* pChunkBatch = nullptr;
+            for (size_t i = 0; i < PLATYPUS_BATCHER_AVAILABLE_RENDER_PASSES && !pChunkBatch; ++i)
+                pChunkBatch = getBatch(s_availableRenderPasses[i], chunkID);
+
+            if (!pChunkBatch)
+            {
+                Debug::log(
+                    "No batches found for chunk: " + std::to_string(chunks.activeChunk) + " "
+                    "of batchID: " + std::to_string(batchID),
+                    PLATYPUS_CURRENT_FUNC_NAME,
+                    Debug::MessageType::PLATYPUS_ERROR
+                );
+                PLATYPUS_ASSERT(false);
+                return NULL_UUID;
+            }
+
+            const uint32_t maxEntries = pChunkBatch->repeatAdvance > 0 ? pChunkBatch->maxRepeatCount : pChunkBatch->maxInstanceCount;
+            if (_sharedEntryCounts[chunkID] < maxEntries)
+                return chunkID;
+
+            ++chunks.activeChunk;
+            if (chunks.activeChunk >= chunks.chunkIDs.size())
+            {
+                createBatchChunk(batchID, chunks.activeChunk);
+                if (chunks.activeChunk >= chunks.chunkIDs.size())
+                {
+                    Debug::log(
+                        "Failed to create chunk: " + std::to_string(chunks.activeChunk) + " "
+                        "for batchID: " + std::to_string(batchID),
+                        PLATYPUS_CURRENT_FUNC_NAME,
+                        Debug::MessageType::PLATYPUS_ERROR
+                    );
+                    PLATYPUS_ASSERT(false);
+                    return NULL_UUID;
+                }
+            }
+        }
+    }
+
+    void Batcher::createBatchChunk(UUID_t batchID, size_t chunkIndex)
+    {
+        // Copying since createBatch modifies the chunks
+        const BatchChunks chunks = _batchChunks[batchID];
+        // NOTE: createBatch also registers the chunk to _batchChunks
+        for (size_t i = 0; i < PLATYPUS_BATCHER_AVAILABLE_RENDER_PASSES; ++i)
+        {
+            const Batch* pFirstChunkBatch = getBatch(s_availableRenderPasses[i], batchID);
+            if (!pFirstChunkBatch)
+                continue;
+
+            createBatch(
+                chunks.meshID,
+                chunks.materialID,
+                chunks.pDirectionalLight,
+                pFirstChunkBatch->pRenderPass,
+                chunkIndex
+            );
+        }
+        Debug::log(
+            "@Batcher::createBatchChunk "
+            "Created chunk " + std::to_string(chunkIndex) + " for batchID: " + std::to_string(batchID)
+        );
+    }
+
+    void Batcher::freeBatchChunks(UUID_t batchID)
+    {
+        std::vector<UUID_t> toFree;
+        std::unordered_map<UUID_t, BatchChunks>::iterator chunksIt = _batchChunks.find(batchID);
+        if (chunksIt != _batchChunks.end())
+        {
+            toFree.assign(chunksIt->second.chunkIDs.begin() + 1, chunksIt->second.chunkIDs.end());
+            _batchChunks.erase(chunksIt);
+        }
+        else
+        {
+            // If freeing a chunk, the chunks after it would be empty as well
+            std::unordered_map<UUID_t, UUID_t>::iterator chunkBaseIt = _chunkBaseIDs.find(batchID);
+            if (chunkBaseIt == _chunkBaseIDs.end())
+                return;
+
+            chunksIt = _batchChunks.find(chunkBaseIt->second);
+            _chunkBaseIDs.erase(chunkBaseIt);
+            if (chunksIt == _batchChunks.end())
+                return;
+
+            BatchChunks& chunks = chunksIt->second;
+            std::vector<UUID_t>::iterator chunkIt = std::find(chunks.chunkIDs.begin(), chunks.chunkIDs.end(), batchID);
+            if (chunkIt == chunks.chunkIDs.end())
+                return;
+
+            toFree.assign(chunkIt + 1, chunks.chunkIDs.end());
+            chunks.chunkIDs.erase(chunkIt, chunks.chunkIDs.end());
+            chunks.activeChunk = std::min(chunks.activeChunk, chunks.chunkIDs.size() - 1);
+        }
+
+        for (UUID_t chunkID : toFree)
+        {
+            _chunkBaseIDs.erase(chunkID);
+            freeBatch(chunkID);
+        }
+    }
+
     void Batcher::addToAllocatedShaderResources(
         UUID_t batchID,
         std::vector<BatchShaderResource>& shaderResources
@@ -7,6 +7,7 @@
 #include "platypus/assets/Texture.hpp"
 #include "platypus/assets/Mesh.hpp"
 #include "platypus/ecs/components/Lights.hpp"
+#include "BindlessMaterialTable.hpp"
 #include <unordered_map>
 
 // TODO: Some better way to deal with this...
@@ -15,6 +16,13 @@
 
 namespace platypus
 {
+    // Render pass masks for Batcher::addToBatch
+    inline uint32_t render_pass_bit(RenderPassType renderPassType)
+    {
+        return 0x1 << static_cast<uint32_t>(renderPassType);
+    }
+    constexpr uint32_t render_pass_mask_all = 0xFFFFFFFF;
+
     enum class ShaderResourceType
     {
         ANY, // TODO: Rename this UNIFORM_BUFFER or something instead?
@@ -59,7 +67,7 @@ namespace platypus
         std::vector<UniformInfo> pushConstantsUniformInfos;
         void* pPushConstantsData = nullptr;
 
-        // Atm push constants should ONLY be used in vertex shaders!
+        // Atm push constants are used in vertex shaders, except bindless Materials' index
         ShaderStageFlagBits pushConstantsShaderStage = ShaderStageFlagBits::SHADER_STAGE_NONE;
 
         // Repeat count should be 1 if instanced
@@ -70,6 +78,28 @@ namespace platypus
         uint32_t instanceCount = 0;
         uint32_t maxInstanceCount = 0;
         uint32_t instanceAdvance = 0;
+
+        // Index of the first shared batch resource entry this batch draws.
+        // Batches of different render passes may draw different ranges of the
+        // same shared entries if they were culled differently.
+        // Instanced batches draw their range as first instance
+        // (on web all passes draw all instances since base instance isn't available).
+        uint32_t firstRepeat = 0;
+        // Entries skipped for this batch's render pass this frame
+        uint32_t culledCount = 0;
+
+        // Used to create the following chunks of this batch when it gets full
+        const RenderPass* pRenderPass = nullptr;
+
+        // Used by the RenderQueue to sort batches
+        UUID_t meshID = NULL_UUID;
+        UUID_t materialID = NULL_UUID;
+        // View space depth range of the entries drawn this frame
+        float minDepth = 0.0f;
+        float maxDepth = 0.0f;
+
+        // Pushed after the above push constants if the Material is bindless
+        uint32_t bindlessMaterialIndex = PLATYPUS_BINDLESS_INVALID_INDEX;
     };
 
     struct BatchTemplate
@@ -97,24 +127,28 @@ namespace platypus
         }
     };
 
-    struct BatchPipelineData
-    {
-        Shader* pVertexShader = nullptr;
-        Shader* pFragmentShader = nullptr;
-        Pipeline* pPipeline = nullptr;
-        ~BatchPipelineData()
-        {
-            delete pPipeline; // IMPORTANT! Pipeline needs to be destroyed before the associated shaders (web impl detaches shaders from "program" in pipeline's destructor)
-            delete pVertexShader;
-            delete pFragmentShader;
-        }
-    };
-
     class MasterRenderer;
     // TODO: A way to update batch descriptor sets if those were changed (count may have changed as well!)
+    //
+    // Batches have a fixed max length. When a batch gets full, the entries continue
+    // into a chained "chunk" batch of the same mesh and material, which is created
+    // with its own shared resources if it doesn't exist yet.
+    // Chunks are drawn like any other batch and get freed by pruneEmptyBatches
+    // once they're not needed anymore.
     class Batcher
     {
     private:
+        struct BatchChunks
+        {
+            UUID_t meshID = NULL_UUID;
+            UUID_t materialID = NULL_UUID;
+            const Light* pDirectionalLight = nullptr;
+            // First one is the batch's own ID
+            std::vector<UUID_t> chunkIDs;
+            // Chunk where the next entry goes (if it's not full)
+            size_t activeChunk = 0;
+        };
+
         MasterRenderer& _masterRendererRef;
         DescriptorPool& _descriptorPoolRef;
 
@@ -128,6 +162,7 @@ namespace platypus
         //  -static bit
         //  -static and instanced bits
         //  -skinned bit
+        // Both static templates are instanced, they differ only by their max length.
         // IMPORTANT TO NOTE:
         //  These don't contain info about other flags such as HAS_TANGENTS bit
         //    ->SO: in order to find the correct batch template, you need to check for
@@ -138,8 +173,10 @@ namespace platypus
 
         // Additional batch pipelines that aren't managed elsewhere
         // (for example shadow pass pipelines are managed here)
+        // NOTE: Acquired from MasterRenderer's PipelineRegistry -> batches with
+        // the same pipeline state share the pipeline
         // key = batchID
-        std::unordered_map<UUID_t, BatchPipelineData*> _managedPipelineData;
+        std::unordered_map<UUID_t, Pipeline*> _managedPipelines;
         // NOTE: The ID here can be anything, not just hash(meshID, materialID)
         //  -> when accessing these pipelines you need to know how the ID was originally created!
         //std::unordered_map<RenderPassType, std::unordered_map<ID_t, size_t>> _identifierPipelineDataMapping;
@@ -150,7 +187,6 @@ namespace platypus
         size_t _maxSkinnedMeshJoints;
 
         static RenderPassType s_availableRenderPasses[PLATYPUS_BATCHER_AVAILABLE_RENDER_PASSES];
-        static DescriptorSetLayout s_staticDescriptorSetLayout; // single transformation mat as dynamic ubo for all batch members
         static DescriptorSetLayout s_jointDescriptorSetLayout;
 
         // NOTE: Currently assuming these are modified frequently
@@ -163,6 +199,13 @@ namespace platypus
         //  freed/destroyed. ..ref count kind of thing...
         //  TODO: Maybe make this shit a bit less convoluted?
         std::unordered_map<UUID_t, size_t> _allocatedShaderResourceUseCount;
+        // Entries added to each batchID's shared resources this frame
+        std::unordered_map<UUID_t, uint32_t> _sharedEntryCounts;
+
+        // key = batchID of the first chunk
+        std::unordered_map<UUID_t, BatchChunks> _batchChunks;
+        // key = chunk's batchID, value = batchID of the first chunk
+        std::unordered_map<UUID_t, UUID_t> _chunkBaseIDs;
 
     public:
         Batcher(
@@ -175,17 +218,6 @@ namespace platypus
         );
         ~Batcher();
 
-        BatchPipelineData* createBatchPipelineData(
-            const RenderPass* pRenderPass,
-            const std::string& vertexShaderFilename,
-            const std::string& fragmentShaderFilename,
-            const std::vector<VertexBufferLayout>& vertexBufferLayouts,
-            const std::vector<DescriptorSetLayout>& descriptorSetLayouts,
-            CullMode cullMode,
-            size_t pushConstantsSize,
-            ShaderStageFlagBits pushConstantsShaderStage
-        );
-
         // This also updates stuff that doesn't need to be done per instance but for whole
         // batch. Material data for example(if some properties have changed).
         void updateDeviceSideBuffers(size_t currentFrame);
@@ -204,7 +236,6 @@ namespace platypus
         // Returns batches sharing the same ID for all render passes
         std::vector<Batch*> getBatches(UUID_t identifier);
 
-        static const DescriptorSetLayout& get_static_descriptor_set_layout();
         static const DescriptorSetLayout& get_joint_descriptor_set_layout();
 
         BatchShaderResource* getSharedBatchResource(UUID_t batchID, size_t resourceIndex);
@@ -253,8 +284,7 @@ namespace platypus
             UUID_t batchID
         ) const;
 
-        void destroyManagedPipelines();
-        void recreateManagedPipelines();
+        void releaseManagedPipelines();
 
         void createBatch(
             UUID_t meshID,
@@ -267,26 +297,44 @@ namespace platypus
             size_t instanceBufferElementSize,
             const std::vector<ShaderResourceLayout>& uniformResourceLayouts,
             const Light * const pDirectionalLight,
-            const RenderPass* pRenderPass
+            const RenderPass* pRenderPass,
+            size_t chunkIndex = 0
         );
 
         void createBatch(
             UUID_t meshID,
             UUID_t materialID,
             const Light * const pDirectionalLight,
-            const RenderPass* pRenderPass
+            const RenderPass* pRenderPass,
+            size_t chunkIndex = 0
         );
 
         // totalDataSize has to be the size of provided pData and sum of values in pData
+        //
+        // Adds entry only to the batches of render passes in renderPassMask (see render_pass_bit).
+        // Other batches of the batchID count the entry as culled.
+        // If the batch is full, the entry goes to its next chunk.
+        // NOTE: Each batch draws a contiguous range of the shared entries, so entries with
+        // different render pass masks have to be added in groups where the
+        // entries for each pass stay contiguous (for example: main pass only, main and shadow pass, shadow pass only)
+        //
+        // viewDepth is the entry's distance along the camera's forward axis, used for
+        // sorting the batches (see RenderQueue).
         void addToBatch(
             UUID_t batchID,
             void* pData,
             size_t dataSize,
             const std::vector<size_t>& dataElementSizes,
-            size_t currentFrame
+            size_t currentFrame,
+            uint32_t renderPassMask = render_pass_mask_all,
+            float viewDepth = 0.0f
         );
 
         static std::vector<RenderPassType> get_available_render_passes();
+        // Chunk 0 is the batch itself
+        static UUID_t get_batch_chunk_id(UUID_t batchID, size_t chunkIndex);
+        // Returns all chunks' batchIDs of the batch (empty if no such batch)
+        std::vector<UUID_t> getBatchChunkIDs(UUID_t batchID) const;
 
         inline size_t getMaxStaticBatchLength() const { return _maxStaticBatchLength; }
         inline size_t getMaxStaticInstancedBatchLength() const { return _maxStaticInstancedBatchLength; }
@@ -294,6 +342,13 @@ namespace platypus
         inline size_t getMaxSkinnedMeshJoints() const { return _maxSkinnedMeshJoints; }
 
     private:
+        // Returns the batchID of the chunk where the next entry of the batch should go
+        // and creates a new chunk if all existing chunks are full.
+        UUID_t getNextEntryChunk(UUID_t batchID);
+        void createBatchChunk(UUID_t batchID, size_t chunkIndex);
+        // Frees the batch's following chunks, or if it's a chunk, the chunks after it
+        void freeBatchChunks(UUID_t batchID);
+
         void addToAllocatedShaderResources(
             UUID_t batchID,
             std::vector<BatchShaderResource>& shaderResources
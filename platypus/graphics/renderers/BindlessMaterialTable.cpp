@@ -0,0 +1,279 @@
+#include "BindlessMaterialTable.hpp"
+#include "platypus/graphics/Device.hpp"
+#include "platypus/core/Debug.hpp"
+#include <algorithm>
+
+
+namespace platypus
+{
+    BindlessMaterialTable::BindlessMaterialTable(
+        DescriptorPool& descriptorPool,
+        size_t framesInFlight,
+        Texture* pShadowmapTexture
+    ) :
+        _descriptorPoolRef(descriptorPool),
+        _framesInFlight(framesInFlight)
+    {
+        if (!Device::supports_bindless_textures())
+        {
+            Debug::log(
+                "Device doesn't support bindless textures",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            PLATYPUS_ASSERT(false);
+            return;
+        }
+        _maxTextures = std::min((uint32_t)PLATYPUS_MAX_BINDLESS_TEXTURES, Device::get_max_bindless_textures());
+
+        _descriptorSetLayout = {
+            {
+                {
+                    0,
+                    1,
+                    DescriptorType::DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                    ShaderStageFlagBits::SHADER_STAGE_FRAGMENT_BIT,
+                    { { } }
+                },
+                {
+                    1,
+                    _maxTextures,
+                    DescriptorType::DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                    ShaderStageFlagBits::SHADER_STAGE_FRAGMENT_BIT,
+                    { { } },
+                    DescriptorBindingFlagBits::DESCRIPTOR_BINDING_FLAG_PARTIALLY_BOUND_BIT |
+                    DescriptorBindingFlagBits::DESCRIPTOR_BINDING_FLAG_UPDATE_AFTER_BIND_BIT |
+                    DescriptorBindingFlagBits::DESCRIPTOR_BINDING_FLAG_UPDATE_UNUSED_WHILE_PENDING_BIT
+                }
+            }
+        };
+
+        _slotTextures.resize(_maxTextures, nullptr);
+        _slotTextures[PLATYPUS_BINDLESS_SHADOWMAP_TEXTURE_INDEX] = pShadowmapTexture;
+        _pendingSlotWrites.resize(framesInFlight);
+
+        std::vector<BindlessMaterialData> initialData(PLATYPUS_MAX_BINDLESS_MATERIALS);
+        for (size_t i = 0; i < framesInFlight; ++i)
+        {
+            Buffer* pMaterialBuffer = new Buffer(
+                initialData.data(),
+                sizeof(BindlessMaterialData),
+                initialData.size(),
+                BufferUsageFlagBits::BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                BufferUpdateFrequency::BUFFER_UPDATE_FREQUENCY_DYNAMIC,
+                false
+            );
+            _materialBuffers.push_back(pMaterialBuffer);
+
+            // NOTE: Shadowmap is the texture array's first element, the rest
+            // get written when Materials acquire textures
+            _descriptorSets.push_back(
+                _descriptorPoolRef.createDescriptorSet(
+                    _descriptorSetLayout,
+                    {
+                        { DescriptorType::DESCRIPTOR_TYPE_STORAGE_BUFFER, pMaterialBuffer },
+                        { DescriptorType::DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, pShadowmapTexture }
+                    }
+                )
+            );
+        }
+        Debug::log(
+            "Bindless material table created. "
+            "Max textures: " + std::to_string(_maxTextures) + " "
+            "max materials: " + std::to_string(PLATYPUS_MAX_BINDLESS_MATERIALS)
+        );
+    }
+
+    BindlessMaterialTable::~BindlessMaterialTable()
+    {
+        if (!_textures.empty())
+        {
+            Debug::log(
+                std::to_string(_textures.size()) + " textures were still in use",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_WARNING
+            );
+        }
+        Device::wait_for_operations();
+        _descriptorPoolRef.freeDescriptorSets(_descriptorSets);
+        for (Buffer* pBuffer : _materialBuffers)
+            delete pBuffer;
+        _descriptorSetLayout.destroy();
+    }
+
+    void BindlessMaterialTable::beginFrame(size_t frame)
+    {
+        ++_frameCount;
+
+        // Frame's previous submission has finished -> its descriptor set isn't in use anymore
+        std::vector<uint32_t>& pendingWrites = _pendingSlotWrites[frame];
+        for (uint32_t index : pendingWrites)
+        {
+            // Slot got released after queuing the write
+            Texture* pTexture = _slotTextures[index];
+            if (!pTexture)
+                continue;
+            DescriptorSetComponent component{
+                DescriptorType::DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                pTexture
+            };
+            _descriptorSets[frame].update(_descriptorPoolRef, 1, component, index);
+        }
+        pendingWrites.clear();
+
+        // Frames begun before the release have all finished once framesInFlight
+        // more frames have begun
+        size_t i = 0;
+        while (i < _releasedTextureIndices.size())
+        {
+            if (_frameCount - _releasedTextureIndices[i].second >= _framesInFlight)
+            {
+                _freeTextureIndices.push_back(_releasedTextureIndices[i].first);
+                _releasedTextureIndices[i] = _releasedTextureIndices.back();
+                _releasedTextureIndices.pop_back();
+                continue;
+            }
+            ++i;
+        }
+    }
+
+    uint32_t BindlessMaterialTable::acquireTexture(Texture* pTexture)
+    {
+        PLATYPUS_ASSERT(pTexture);
+        std::unordered_map<UUID_t, TextureEntry>::iterator it = _textures.find(pTexture->getID());
+        if (it != _textures.end())
+        {
+            ++it->second.referenceCount;
+            return it->second.index;
+        }
+
+        uint32_t index = PLATYPUS_BINDLESS_INVALID_INDEX;
+        if (!_freeTextureIndices.empty())
+        {
+            index = _freeTextureIndices.back();
+            _freeTextureIndices.pop_back();
+        }
+        else if (_nextTextureIndex < _maxTextures)
+        {
+            index = _nextTextureIndex++;
+        }
+        else
+        {
+            // NOTE: Not an error, Materials fall back to their own descriptor sets
+            Debug::log(
+                "Texture array full! Max textures: " + std::to_string(_maxTextures),
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_WARNING
+            );
+            return PLATYPUS_BINDLESS_INVALID_INDEX;
+        }
+
+        // Free slots aren't used by any pending command buffers -> all sets can be written
+        writeTexture(pTexture, index);
+        _slotTextures[index] = pTexture;
+        _textures[pTexture->getID()] = { index, 1 };
+        return index;
+    }
+
+    void BindlessMaterialTable::releaseTexture(UUID_t textureID)
+    {
+        std::unordered_map<UUID_t, TextureEntry>::iterator it = _textures.find(textureID);
+        if (it == _textures.end())
+        {
+            Debug::log(
+                "Texture with ID: " + std::to_string(textureID) + " wasn't acquired from this table",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            PLATYPUS_ASSERT(false);
+            return;
+        }
+        --it->second.referenceCount;
+        if (it->second.referenceCount == 0)
+        {
+            // NOTE: The descriptor isn't cleared. Partially bound -> fine as long as
+            // no Material refers to the index anymore. Frames in flight may still use it
+            // so it can't be rewritten until they've finished (see beginFrame)
+            _slotTextures[it->second.index] = nullptr;
+            _releasedTextureIndices.push_back(std::make_pair(it->second.index, _frameCount));
+            _textures.erase(it);
+        }
+    }
+
+    void BindlessMaterialTable::refreshTexture(Texture* pTexture)
+    {
+        PLATYPUS_ASSERT(pTexture);
+        std::unordered_map<UUID_t, TextureEntry>::const_iterator it = _textures.find(pTexture->getID());
+        if (it == _textures.end())
+            return;
+        _slotTextures[it->second.index] = pTexture;
+        queueSlotWrite(it->second.index);
+    }
+
+    void BindlessMaterialTable::setShadowmapTexture(Texture* pShadowmapTexture)
+    {
+        _slotTextures[PLATYPUS_BINDLESS_SHADOWMAP_TEXTURE_INDEX] = pShadowmapTexture;
+        queueSlotWrite(PLATYPUS_BINDLESS_SHADOWMAP_TEXTURE_INDEX);
+    }
+
+    uint32_t BindlessMaterialTable::allocMaterial()
+    {
+        if (!_freeMaterialIndices.empty())
+        {
+            const uint32_t index = _freeMaterialIndices.back();
+            _freeMaterialIndices.pop_back();
+            return index;
+        }
+        if (_nextMaterialIndex >= PLATYPUS_MAX_BINDLESS_MATERIALS)
+            return PLATYPUS_BINDLESS_INVALID_INDEX;
+        return _nextMaterialIndex++;
+    }
+
+    void BindlessMaterialTable::freeMaterial(uint32_t materialIndex)
+    {
+        PLATYPUS_ASSERT(materialIndex < _nextMaterialIndex);
+        _freeMaterialIndices.push_back(materialIndex);
+    }
+
+    void BindlessMaterialTable::updateMaterial(
+        uint32_t materialIndex,
+        const BindlessMaterialData& data,
+        size_t frame
+    )
+    {
+        #ifdef PLATYPUS_DEBUG
+        if (materialIndex >= _nextMaterialIndex || frame >= _materialBuffers.size())
+        {
+            Debug::log(
+                "Invalid material index: " + std::to_string(materialIndex) + " "
+                "or frame: " + std::to_string(frame),
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            PLATYPUS_ASSERT(false);
+            return;
+        }
+        #endif
+        _materialBuffers[frame]->updateDevice(
+            (void*)&data,
+            sizeof(BindlessMaterialData),
+            sizeof(BindlessMaterialData) * materialIndex
+        );
+    }
+
+    void BindlessMaterialTable::writeTexture(Texture* pTexture, uint32_t index)
+    {
+        DescriptorSetComponent component{
+            DescriptorType::DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            pTexture
+        };
+        for (DescriptorSet& descriptorSet : _descriptorSets)
+            descriptorSet.update(_descriptorPoolRef, 1, component, index);
+    }
+
+    void BindlessMaterialTable::queueSlotWrite(uint32_t index)
+    {
+        for (std::vector<uint32_t>& pendingWrites : _pendingSlotWrites)
+            pendingWrites.push_back(index);
+    }
+}
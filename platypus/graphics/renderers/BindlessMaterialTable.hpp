@@ -0,0 +1,128 @@
+#pragma once
+
+#include "platypus/graphics/Descriptors.hpp"
+#include "platypus/graphics/Buffers.hpp"
+#include "platypus/assets/Texture.hpp"
+#include "platypus/utils/Maths.hpp"
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+// Texture array length is the smaller of this and Device::get_max_bindless_textures()
+#define PLATYPUS_MAX_BINDLESS_TEXTURES 4096
+#define PLATYPUS_MAX_BINDLESS_MATERIALS 1024
+// NOTE: Texture at index 0 is always the shadowmap
+#define PLATYPUS_BINDLESS_SHADOWMAP_TEXTURE_INDEX 0
+#define PLATYPUS_BINDLESS_INVALID_INDEX 0xFFFFFFFF
+
+
+namespace platypus
+{
+    // Single element of the material storage buffer.
+    // NOTE: Has to match the shaders' std430 layout!
+    struct BindlessMaterialData
+    {
+        // Same as MaterialUniformBufferData
+        Vector4f lightingProperties;
+        Vector4f textureProperties;
+        // Indices to the texture array
+        // x = diffuse, y = specular, z = normal, w = unused atm
+        uint32_t textureIndices[4] = {
+            PLATYPUS_BINDLESS_INVALID_INDEX,
+            PLATYPUS_BINDLESS_INVALID_INDEX,
+            PLATYPUS_BINDLESS_INVALID_INDEX,
+            PLATYPUS_BINDLESS_INVALID_INDEX
+        };
+    };
+
+    // All bindless Materials' data in a single storage buffer and all their
+    // textures in a single texture array, so every bindless Material uses the
+    // same descriptor set. Materials only push their index in the storage buffer.
+    //
+    // Layout:
+    //  binding 0 = material storage buffer
+    //  binding 1 = texture array (partially bound, update after bind, update unused while pending)
+    //
+    // Only slots no pending command buffer uses get written to all descriptor sets right away.
+    // Released slots are reused after the frames in flight have finished, and slots in use
+    // (refreshed textures, shadowmap) get rewritten for each frame's descriptor set
+    // when that frame begins (see beginFrame()).
+    //
+    // NOTE: Desktop only. Requires Device::supports_bindless_textures()
+    class BindlessMaterialTable
+    {
+    private:
+        struct TextureEntry
+        {
+            uint32_t index = PLATYPUS_BINDLESS_INVALID_INDEX;
+            size_t referenceCount = 0;
+        };
+
+        DescriptorPool& _descriptorPoolRef;
+        uint32_t _maxTextures = 0;
+        size_t _framesInFlight = 0;
+        // Number of frames begun
+        uint64_t _frameCount = 0;
+
+        DescriptorSetLayout _descriptorSetLayout;
+        // *Per each frame in flight
+        std::vector<Buffer*> _materialBuffers;
+        std::vector<DescriptorSet> _descriptorSets;
+
+        // key = texture asset's ID
+        std::unordered_map<UUID_t, TextureEntry> _textures;
+        std::vector<uint32_t> _freeTextureIndices;
+        // Released indices wait here until the frames in flight that may use them have finished.
+        // Pair's first = index, second = _frameCount when released
+        std::vector<std::pair<uint32_t, uint64_t>> _releasedTextureIndices;
+        uint32_t _nextTextureIndex = PLATYPUS_BINDLESS_SHADOWMAP_TEXTURE_INDEX + 1;
+        // Texture of each used slot, nullptr if the slot is free
+        std::vector<Texture*> _slotTextures;
+        // *Per each frame in flight, slots to rewrite when the frame begins
+        std::vector<std::vector<uint32_t>> _pendingSlotWrites;
+
+        std::vector<uint32_t> _freeMaterialIndices;
+        uint32_t _nextMaterialIndex = 0;
+
+    public:
+        BindlessMaterialTable(
+            DescriptorPool& descriptorPool,
+            size_t framesInFlight,
+            Texture* pShadowmapTexture
+        );
+        BindlessMaterialTable(const BindlessMaterialTable& other) = delete;
+        ~BindlessMaterialTable();
+
+        // Needs to be called each frame after waiting for the frame's previous submission
+        // and before recording it.
+        void beginFrame(size_t frame);
+
+        // Returns the texture's index in the texture array or
+        // PLATYPUS_BINDLESS_INVALID_INDEX if the texture array is full.
+        // Each successful acquire needs to be matched with releaseTexture()
+        uint32_t acquireTexture(Texture* pTexture);
+        void releaseTexture(UUID_t textureID);
+        // Rewrites the texture's slot if it's in the texture array.
+        // Needs to be called when the texture's image view or sampler changes,
+        // since the slot is written only when it's acquired the first time.
+        // NOTE: The slot may be in use -> each frame's descriptor set gets rewritten
+        // when the frame begins
+        void refreshTexture(Texture* pTexture);
+        void setShadowmapTexture(Texture* pShadowmapTexture);
+
+        // Returns PLATYPUS_BINDLESS_INVALID_INDEX if the table is full
+        uint32_t allocMaterial();
+        void freeMaterial(uint32_t materialIndex);
+        void updateMaterial(uint32_t materialIndex, const BindlessMaterialData& data, size_t frame);
+
+        inline const DescriptorSetLayout& getDescriptorSetLayout() const { return _descriptorSetLayout; }
+        inline const std::vector<DescriptorSet>& getDescriptorSets() const { return _descriptorSets; }
+        inline size_t getTextureCount() const { return _textures.size(); }
+
+    private:
+        // Writes to all descriptor sets
+        // -> the slot mustn't be in use by pending command buffers!
+        void writeTexture(Texture* pTexture, uint32_t index);
+        void queueSlotWrite(uint32_t index);
+    };
+}
@@ -188,11 +188,7 @@ namespace platypus
         _commandBuffers.clear();
     }
 
-    void GUIRenderer::createPipeline(
-        const RenderPass& renderPass,
-        float viewportWidth,
-        float viewportHeight
-    )
+    void GUIRenderer::createPipeline(const RenderPass& renderPass)
     {
         _imgPipeline.create();
         _fontPipeline.create();
@@ -98,11 +98,9 @@ namespace platypus
         void allocCommandBuffers(uint32_t count);
         void freeCommandBuffers();
 
-        void createPipeline(
-            const RenderPass& renderPass,
-            float viewportWidth,
-            float viewportHeight
-        );
+        // NOTE: Pipelines don't depend on the viewport's size
+        //  -> no need to recreate on window resize
+        void createPipeline(const RenderPass& renderPass);
 
         void destroyPipeline();
 
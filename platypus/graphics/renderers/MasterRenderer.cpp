@@ -12,6 +12,9 @@
 #include "platypus/ecs/components/Lights.hpp"
 #include "platypus/ecs/components/Component.hpp"
 #include "platypus/ecs/components/SkeletalAnimation.hpp"
+#include "platypus/utils/Bounds.hpp"
+#include <algorithm>
+#include <chrono>
 
 
 namespace platypus
@@ -26,9 +29,10 @@ namespace platypus
         _batcher(
             *this,
             _descriptorPoolRef,
-            1000, // max static batch len
-            1000, // max static instanced batch len
-            500,  // max skinned batch len
+            // NOTE: Batches chain more chunks of these lengths when they get full
+            512, // max static batch len
+            1024, // max static instanced batch len
+            64,  // max skinned batch len
             50 // max skinned mesh joints
         ),
 
@@ -131,8 +135,29 @@ namespace platypus
             _offscreenColorFormat,
             _offscreenDepthFormat
         );
+        createShadowPassResources();
         createOffscreenPassResources();
 
+        #ifdef PLATYPUS_BINDLESS_MATERIALS
+        if (Device::supports_bindless_textures())
+        {
+            _pBindlessMaterialTable = std::make_unique<BindlessMaterialTable>(
+                _descriptorPoolRef,
+                _swapchainRef.getMaxFramesInFlight(),
+                _shadowPassInstance.getFramebuffer(0)->getDepthAttachment()
+            );
+        }
+        else
+        {
+            Debug::log(
+                "Bindless materials requested, but not supported by the device. "
+                "Materials use their own descriptor sets instead",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_WARNING
+            );
+        }
+        #endif
+
         _pPostProcessingRenderer->createFramebuffers();
         _pPostProcessingRenderer->createShaderResources(_pColorAttachment);
 
@@ -144,7 +169,10 @@ namespace platypus
 
     MasterRenderer::~MasterRenderer()
     {
+        // NOTE: All Materials need to be destroyed before this
+        _pBindlessMaterialTable.reset();
         destroyOffscreenPassResources();
+        destroyShadowPassResources();
         _shadowPass.destroy();
         _opaquePass.destroy();
         _transparentPass.destroy();
@@ -171,147 +199,328 @@ namespace platypus
         freeCommandBuffers();
     }
 
-    void MasterRenderer::submit(Scene * const pScene, const Entity& entity)
+    enum CullVisibilityFlagBits : uint8_t
+    {
+        CULL_VISIBLE_NONE = 0x0,
+        CULL_VISIBLE_MAIN_PASS = 0x1,
+        CULL_VISIBLE_SHADOW_PASS = 0x2,
+        CULL_VISIBLE_ALL = CULL_VISIBLE_MAIN_PASS | CULL_VISIBLE_SHADOW_PASS
+    };
+
+    static void get_active_camera(
+        Scene * const pScene,
+        const Camera*& outCamera,
+        const Transform*& outCameraTransform
+    )
     {
-        uint64_t requiredMask1 = ComponentType::COMPONENT_TYPE_TRANSFORM | ComponentType::COMPONENT_TYPE_RENDERABLE3D;
-        uint64_t requiredMask2 = ComponentType::COMPONENT_TYPE_GUI_TRANSFORM | ComponentType::COMPONENT_TYPE_GUI_RENDERABLE;
-        if (!(entity.componentMask & requiredMask1) &&
-            !(entity.componentMask & requiredMask2))
+        outCamera = nullptr;
+        outCameraTransform = nullptr;
+        const entityID_t cameraEntity = pScene->getActiveCameraEntity();
+        if (cameraEntity != NULL_ENTITY_ID)
         {
-            return;
+            outCamera = (const Camera*)pScene->getComponent(cameraEntity, ComponentType::COMPONENT_TYPE_CAMERA);
+            outCameraTransform = (const Transform*)pScene->getComponent(cameraEntity, ComponentType::COMPONENT_TYPE_TRANSFORM);
         }
+    }
 
-        Light* pDirectionalLight = (Light*)pScene->getComponent(
-            ComponentType::COMPONENT_TYPE_LIGHT
-        );
-
-        // NOTE: Below should rather be done by the "batcher" since these are kind of batching related things?
-        Transform* pTransform = (Transform*)pScene->getComponent(
-            entity.id,
-            ComponentType::COMPONENT_TYPE_TRANSFORM,
-            false,
-            false
-        );
-
-        Renderable3D* pRenderable3D = (Renderable3D*)pScene->getComponent(
-            entity.id,
-            ComponentType::COMPONENT_TYPE_RENDERABLE3D,
-            false,
-            false
-        );
-        if (pRenderable3D && pTransform)
+    void MasterRenderer::submit(Scene * const pScene)
+    {
+        View<Transform, Renderable3D> renderable3DView = pScene->view<Transform, Renderable3D>();
+        if (renderable3DView.size() > 0)
         {
-            AssetManager* pAssetManager = Application::get_instance()->getAssetManager();
-            const UUID_t meshID = pRenderable3D->meshID;
-            const UUID_t materialID = pRenderable3D->materialID;
-
-            // NOTE: Atm allowing renderables to have meshes and materials as NULL_UUIDs!
-            // TODO: Make this nicer!
-            if (meshID != NULL_UUID && materialID != NULL_UUID)
-            {
-                const Mesh * const pMesh = (Mesh*)pAssetManager->getAsset(meshID, AssetType::ASSET_TYPE_MESH);
-                if (!pMesh)
+            const Light* pDirectionalLight = (const Light*)pScene->getComponent(
+                ComponentType::COMPONENT_TYPE_LIGHT
+            );
+            _cullCandidates.clear();
+            renderable3DView.each(
+                [this](entityID_t entity, Transform& transform, Renderable3D& renderable)
                 {
-                    pScene->insertError(
-                        entity.uuid,
-                        {
-                            EntityErrorType::COMPONENT_RENDERABLE3D_MESH_UNAVAILABLE,
-                            { {ComponentType::COMPONENT_TYPE_RENDERABLE3D, reinterpret_cast<void*>(pRenderable3D)} },
-                            { }
-                        }
-                    );
-                    return;
+                    _cullCandidates.push_back({ entity, &transform, &renderable });
                 }
+            );
 
-                const Material * const pMaterial = (Material*)pAssetManager->getAsset(materialID, AssetType::ASSET_TYPE_MATERIAL);
-                if (!pMaterial)
+            // Ordering the entries inside batches front to back, except transparent ones back to front.
+            // Batches themselves get ordered by the RenderQueue.
+            const Camera* pCamera = nullptr;
+            const Transform* pCameraTransform = nullptr;
+            get_active_camera(pScene, pCamera, pCameraTransform);
+            if (pCameraTransform)
+            {
+                AssetManager* pAssetManager = Application::get_instance()->getAssetManager();
+                const Matrix4f& cameraMatrix = pCameraTransform->globalMatrix;
+                const Vector3f cameraPosition(cameraMatrix[12], cameraMatrix[13], cameraMatrix[14]);
+                // Camera looks towards -z
+                const Vector3f cameraForward(-cameraMatrix[8], -cameraMatrix[9], -cameraMatrix[10]);
+                for (CullCandidate& candidate : _cullCandidates)
                 {
-                    pScene->insertError(
-                        entity.uuid,
-                        {
-                            EntityErrorType::COMPONENT_RENDERABLE3D_MATERIAL_UNAVAILABLE,
-                            { {ComponentType::COMPONENT_TYPE_RENDERABLE3D, reinterpret_cast<void*>(pRenderable3D)} },
-                            { }
-                        }
-                    );
-                    return;
+                    const Matrix4f& matrix = candidate.pTransform->globalMatrix;
+                    const Vector3f toCandidate = Vector3f(matrix[12], matrix[13], matrix[14]) - cameraPosition;
+                    candidate.viewDepth = toCandidate.dotp(cameraForward);
+                    candidate.sortDepth = candidate.viewDepth;
+
+                    const UUID_t materialID = candidate.pRenderable->materialID;
+                    if (materialID == NULL_UUID)
+                        continue;
+                    const Material* pMaterial = (const Material*)pAssetManager->getAsset(materialID, AssetType::ASSET_TYPE_MATERIAL);
+                    if (pMaterial && pMaterial->isTransparent())
+                        candidate.sortDepth = -candidate.viewDepth;
                 }
+                std::stable_sort(
+                    _cullCandidates.begin(),
+                    _cullCandidates.end(),
+                    [](const CullCandidate& a, const CullCandidate& b) { return a.sortDepth < b.sortDepth; }
+                );
+            }
+            cullRenderables(pScene, pDirectionalLight);
+
+            // Submitting in groups by visibility, so the entries of each render pass stay
+            // contiguous in the batches' shared resources (see Batcher::addToBatch).
+            // Completely culled renderables are still submitted with an empty mask
+            // so their batches don't get pruned and recreated.
+            const uint8_t submitGroups[4] = {
+                CULL_VISIBLE_MAIN_PASS,
+                CULL_VISIBLE_ALL,
+                CULL_VISIBLE_SHADOW_PASS,
+                CULL_VISIBLE_NONE
+            };
+            const uint32_t mainPassMask = render_pass_bit(RenderPassType::OPAQUE_PASS) | render_pass_bit(RenderPassType::TRANSPARENT_PASS);
+            const uint32_t shadowPassMask = render_pass_bit(RenderPassType::SHADOW_PASS);
+            const std::vector<Entity>& sceneEntities = pScene->getEntities();
+            for (uint8_t group : submitGroups)
+            {
+                uint32_t renderPassMask = 0;
+                if (group & CULL_VISIBLE_MAIN_PASS)
+                    renderPassMask |= mainPassMask;
+                if (group & CULL_VISIBLE_SHADOW_PASS)
+                    renderPassMask |= shadowPassMask;
 
-                #ifdef PLATYPUS_DEBUG
-                if (!mesh_and_material_compatible(pMesh, pMaterial))
+                for (size_t i = 0; i < _cullCandidates.size(); ++i)
                 {
-                    Debug::log(
-                        "Not submitting Renderable3D for rendering due to incompatible Mesh and Material!",
-                        PLATYPUS_CURRENT_FUNC_NAME,
-                        Debug::MessageType::PLATYPUS_ERROR
-                    );
-                    pScene->insertError(
-                        entity.uuid,
-                        {
-                            EntityErrorType::COMPONENT_RENDERABLE3D_INCOMPATIBLE_MESH_MATERIAL,
-                            { {ComponentType::COMPONENT_TYPE_RENDERABLE3D, reinterpret_cast<void*>(pRenderable3D)} },
-                            { }
-                        }
+                    if (_cullResults[i] != group)
+                        continue;
+
+                    const CullCandidate& candidate = _cullCandidates[i];
+                    submitRenderable3D(
+                        pScene,
+                        sceneEntities[candidate.entity],
+                        *candidate.pTransform,
+                        *candidate.pRenderable,
+                        pDirectionalLight,
+                        renderPassMask,
+                        candidate.viewDepth
                     );
-                    return;
                 }
-                #endif
+            }
+        }
+
+        pScene->view<GUITransform, GUIRenderable>().each(
+            [this, pScene](entityID_t entity, GUITransform& transform, GUIRenderable& renderable)
+            {
+                _pGUIRenderer->submit(pScene, entity);
+            }
+        );
+    }
 
+    void MasterRenderer::cullRenderables(Scene * const pScene, const Light * const pDirectionalLight)
+    {
+        const size_t candidateCount = _cullCandidates.size();
+        _cullResults.assign(candidateCount, CULL_VISIBLE_NONE);
+        _cullingStatistics = CullingStatistics();
+        _cullingStatistics.testedCount = candidateCount;
+
+        const Camera* pCamera = nullptr;
+        const Transform* pCameraTransform = nullptr;
+        get_active_camera(pScene, pCamera, pCameraTransform);
+        if (!_frustumCulling || !pCamera || !pCameraTransform)
+        {
+            _cullResults.assign(candidateCount, CULL_VISIBLE_ALL);
+            _cullingStatistics.mainPassVisibleCount = candidateCount;
+            _cullingStatistics.shadowPassVisibleCount = candidateCount;
+            return;
+        }
 
-                const MeshPropertyFlagBits meshType = get_mesh_type(pMesh->getPropertyFlags());
+        const SpatialIndex& spatialIndex = pScene->getSpatialIndex();
+        const size_t sceneEntityCount = pScene->getEntities().size();
+        _entityVisibility.assign(sceneEntityCount, CULL_VISIBLE_NONE);
 
-                // TODO: IMPORTANT! -> Stop using hashed UUIDs for batch IDs?
-                // UPDATE TO ABOVE: Why not? Batch UUIDs don't occupy actual
-                // UUID space for any pool
-                UUID_t batchID = UUID::hash(meshID, materialID);
-                if (pMaterial->isTransparent())
+        const Frustum cameraFrustum = create_frustum(
+            pCamera->perspectiveProjectionMatrix * pCameraTransform->globalMatrix.inverse()
+        );
+
+        // Without shadows the shadow pass batches are left unculled
+        const bool cullShadowPass = pDirectionalLight && pDirectionalLight->enableShadows;
+
+        // Light's frustum gets queried by a worker while this thread queries the camera's
+        JobSystem& jobSystem = Application::get_instance()->getJobSystem();
+        JobCounter counter;
+        _shadowVisibleEntities.clear();
+        if (cullShadowPass)
+        {
+            const Frustum lightFrustum = create_frustum(
+                pDirectionalLight->shadowProjectionMatrix * pDirectionalLight->shadowViewMatrix
+            );
+            jobSystem.submit(
+                [this, &spatialIndex, lightFrustum]()
                 {
-                    // Create transparent batch (if required)
-                    if (!_batcher.getBatch(RenderPassType::TRANSPARENT_PASS, batchID))
-                        _batcher.createBatch(meshID, materialID, pDirectionalLight, &_transparentPass);
-                }
-                else
+                    spatialIndex.queryFrustum(lightFrustum, _shadowVisibleEntities);
+                },
+                &counter
+            );
+        }
+        _visibleEntities.clear();
+        spatialIndex.queryFrustum(cameraFrustum, _visibleEntities);
+        jobSystem.wait(&counter);
+
+        for (entityID_t entity : _visibleEntities)
+        {
+            if ((size_t)entity < sceneEntityCount)
+                _entityVisibility[entity] |= CULL_VISIBLE_MAIN_PASS;
+        }
+        for (entityID_t entity : _shadowVisibleEntities)
+        {
+            if ((size_t)entity < sceneEntityCount)
+                _entityVisibility[entity] |= CULL_VISIBLE_SHADOW_PASS;
+        }
+
+        for (size_t i = 0; i < candidateCount; ++i)
+        {
+            const entityID_t entity = _cullCandidates[i].entity;
+            // Let submitRenderable3D deal with the missing assets
+            // and don't cull meshes without bounds
+            uint8_t result = CULL_VISIBLE_ALL;
+            if (spatialIndex.contains(entity) && (size_t)entity < sceneEntityCount)
+            {
+                result = _entityVisibility[entity];
+                if (!cullShadowPass)
+                    result |= CULL_VISIBLE_SHADOW_PASS;
+            }
+            _cullResults[i] = result;
+
+            _cullingStatistics.mainPassVisibleCount += (result & CULL_VISIBLE_MAIN_PASS) ? 1 : 0;
+            _cullingStatistics.shadowPassVisibleCount += (result & CULL_VISIBLE_SHADOW_PASS) ? 1 : 0;
+            _cullingStatistics.culledCount += result == CULL_VISIBLE_NONE ? 1 : 0;
+        }
+    }
+
+    void MasterRenderer::submitRenderable3D(
+        Scene * const pScene,
+        const Entity& entity,
+        const Transform& transform,
+        Renderable3D& renderable,
+        const Light * const pDirectionalLight,
+        uint32_t renderPassMask,
+        float viewDepth
+    )
+    {
+        AssetManager* pAssetManager = Application::get_instance()->getAssetManager();
+        const UUID_t meshID = renderable.meshID;
+        const UUID_t materialID = renderable.materialID;
+
+        // NOTE: Atm allowing renderables to have meshes and materials as NULL_UUIDs!
+        // TODO: Make this nicer!
+        if (meshID == NULL_UUID || materialID == NULL_UUID)
+            return;
+
+        const Mesh * const pMesh = (Mesh*)pAssetManager->getAsset(meshID, AssetType::ASSET_TYPE_MESH);
+        if (!pMesh)
+        {
+            pScene->insertError(
+                entity.uuid,
                 {
-                    // Create opaque batch (if required)
-                    if (!_batcher.getBatch(RenderPassType::OPAQUE_PASS, batchID))
-                        _batcher.createBatch(meshID, materialID, pDirectionalLight, &_opaquePass);
+                    EntityErrorType::COMPONENT_RENDERABLE3D_MESH_UNAVAILABLE,
+                    { {ComponentType::COMPONENT_TYPE_RENDERABLE3D, reinterpret_cast<void*>(&renderable)} },
+                    { }
                 }
+            );
+            return;
+        }
 
-                // Create shadow batch (if required)
-                if (pMaterial->castsShadows() && !_batcher.getBatch(RenderPassType::SHADOW_PASS, batchID))
-                    _batcher.createBatch(meshID, materialID, pDirectionalLight, &(_shadowPassInstance.getRenderPass()));
-
-                if (meshType == MeshPropertyFlagBits::TYPE_STATIC)
+        const Material * const pMaterial = (Material*)pAssetManager->getAsset(materialID, AssetType::ASSET_TYPE_MATERIAL);
+        if (!pMaterial)
+        {
+            pScene->insertError(
+                entity.uuid,
                 {
-                    _batcher.addToBatch(
-                        batchID,
-                        (void*)&(pTransform->globalMatrix),
-                        sizeof(Matrix4f),
-                        { sizeof(Matrix4f) },
-                        _currentFrame
-                    );
+                    EntityErrorType::COMPONENT_RENDERABLE3D_MATERIAL_UNAVAILABLE,
+                    { {ComponentType::COMPONENT_TYPE_RENDERABLE3D, reinterpret_cast<void*>(&renderable)} },
+                    { }
                 }
-                else if (meshType == MeshPropertyFlagBits::TYPE_SKINNED)
+            );
+            return;
+        }
+
+        #ifdef PLATYPUS_DEBUG
+        if (!mesh_and_material_compatible(pMesh, pMaterial))
+        {
+            Debug::log(
+                "Not submitting Renderable3D for rendering due to incompatible Mesh and Material!",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            pScene->insertError(
+                entity.uuid,
                 {
-                    const SkeletalAnimation* pAnimation = (const SkeletalAnimation*)pScene->getComponent(
-                        entity.id,
-                        ComponentType::COMPONENT_TYPE_SKELETAL_ANIMATION
-                    );
-                    const size_t jointCount = pMesh->getSkeleton()->getJointCount();
-                    _batcher.addToBatch(
-                        batchID,
-                        (void*)pAnimation->jointMatrices,
-                        sizeof(Matrix4f) * jointCount,
-                        { sizeof(Matrix4f) * jointCount },
-                        _currentFrame
-                    );
+                    EntityErrorType::COMPONENT_RENDERABLE3D_INCOMPATIBLE_MESH_MATERIAL,
+                    { {ComponentType::COMPONENT_TYPE_RENDERABLE3D, reinterpret_cast<void*>(&renderable)} },
+                    { }
                 }
-            }
+            );
+            return;
         }
+        #endif
 
-        if ((entity.componentMask & _pGUIRenderer->getRequiredComponentsMask()) == _pGUIRenderer->getRequiredComponentsMask())
+
+        const MeshPropertyFlagBits meshType = get_mesh_type(pMesh->getPropertyFlags());
+
+        // TODO: IMPORTANT! -> Stop using hashed UUIDs for batch IDs?
+        // UPDATE TO ABOVE: Why not? Batch UUIDs don't occupy actual
+        // UUID space for any pool
+        UUID_t batchID = UUID::hash(meshID, materialID);
+        if (pMaterial->isTransparent())
+        {
+            // Create transparent batch (if required)
+            if (!_batcher.getBatch(RenderPassType::TRANSPARENT_PASS, batchID))
+                _batcher.createBatch(meshID, materialID, pDirectionalLight, &_transparentPass);
+        }
+        else
+        {
+            // Create opaque batch (if required)
+            if (!_batcher.getBatch(RenderPassType::OPAQUE_PASS, batchID))
+                _batcher.createBatch(meshID, materialID, pDirectionalLight, &_opaquePass);
+        }
+
+        // Create shadow batch (if required)
+        if (pMaterial->castsShadows() && !_batcher.getBatch(RenderPassType::SHADOW_PASS, batchID))
+            _batcher.createBatch(meshID, materialID, pDirectionalLight, &(_shadowPassInstance.getRenderPass()));
+
+        if (meshType == MeshPropertyFlagBits::TYPE_STATIC)
+        {
+            _batcher.addToBatch(
+                batchID,
+                (void*)&(transform.globalMatrix),
+                sizeof(Matrix4f),
+                { sizeof(Matrix4f) },
+                _currentFrame,
+                renderPassMask,
+                viewDepth
+            );
+        }
+        else if (meshType == MeshPropertyFlagBits::TYPE_SKINNED)
         {
-            _pGUIRenderer->submit(pScene, entity.id);
+            const SkeletalAnimation* pAnimation = (const SkeletalAnimation*)pScene->getComponent(
+                entity.id,
+                ComponentType::COMPONENT_TYPE_SKELETAL_ANIMATION
+            );
+            const size_t jointCount = pMesh->getSkeleton()->getJointCount();
+            _batcher.addToBatch(
+                batchID,
+                (void*)pAnimation->jointMatrices,
+                sizeof(Matrix4f) * jointCount,
+                { sizeof(Matrix4f) * jointCount },
+                _currentFrame,
+                renderPassMask,
+                viewDepth
+            );
         }
     }
 
@@ -333,6 +542,11 @@ namespace platypus
         }
         else
         {
+            // Acquiring waited for the frame's previous submission
+            //  -> its transient descriptor sets aren't in use anymore
+            Device::get_descriptor_pool()->resetTransientDescriptorSets(_swapchainRef.getCurrentFrame());
+            if (_pBindlessMaterialTable)
+                _pBindlessMaterialTable->beginFrame(_currentFrame);
             const CommandBuffer& cmdBuf = recordCommandBuffer();
             Device::submit_primary_command_buffer(
                 _swapchainRef,
@@ -403,7 +617,6 @@ namespace platypus
 
     void MasterRenderer::solveDescriptorSetLayouts(
         const Material* pMaterial,
-        bool instanced,
         bool skinned,
         bool shadowPipeline,
         std::vector<DescriptorSetLayout>& outDescriptorSetLayouts
@@ -422,15 +635,6 @@ namespace platypus
                 );
                 PLATYPUS_ASSERT(false);
             }
-            if (instanced && usingBlendmap)
-            {
-                Debug::log(
-                    "@MasterRenderer::solveDescriptorSetLayouts "
-                    "Currently not supporting Materials with blendmaps for instanced meshes!",
-                    Debug::MessageType::PLATYPUS_ERROR
-                );
-                PLATYPUS_ASSERT(false);
-            }
         }
 
         if (!shadowPipeline)
@@ -443,14 +647,9 @@ namespace platypus
             //outDescriptorSetLayouts.push_back(_scene3DDataDescriptorSetLayout);
         }
 
+        // NOTE: Static meshes' transformation matrices come from the instanced vertex buffer
         if (skinned)
-        {
             outDescriptorSetLayouts.push_back(Batcher::get_joint_descriptor_set_layout());
-        }
-        else if (!instanced)
-        {
-            outDescriptorSetLayouts.push_back(Batcher::get_static_descriptor_set_layout());
-        }
 
         // Checking if shadow pipeline here, since need to add the Material descriptor set layout
         // last if it's used!
@@ -506,21 +705,14 @@ namespace platypus
             swapchainExtent.height
         );
 
-        _shadowPassInstance.create();
-
         // NOTE: This is so wrong way of dealing with Materials that are relying on this kind of
         // external stuff...
         //
-        // Update new shadow texture for materials that receive shadows
         // Update new "scene depth texture" for materials that are transparent
         // TODO: Some way to know if Material uses framebuffer attachment as texture?
-        Texture* pDepthAttachment = _shadowPassInstance.getFramebuffer(0)->getDepthAttachment();
         for (Asset* pAsset : pAssetManager->getAssets(AssetType::ASSET_TYPE_MATERIAL))
         {
             Material* pMaterial = (Material*)pAsset;
-            if (pMaterial->receivesShadows())
-                pMaterial->updateShadowmapDescriptorSet(pDepthAttachment);
-
             if (pMaterial->isTransparent())
                 pMaterial->updateSceneDepthDescriptorSet(_pOpaqueFramebuffer->getDepthAttachment());
         }
@@ -537,7 +729,31 @@ namespace platypus
         Application::get_instance()->getAssetManager()->destroyAsset(_pDepthAttachment->getID());
         _pColorAttachment = nullptr;
         _pDepthAttachment = nullptr;
+    }
+
+    // NOTE: Shadowmap's size doesn't depend on the window's size
+    //  -> no need to recreate these on window resize
+    void MasterRenderer::createShadowPassResources()
+    {
+        _shadowPassInstance.create();
+
+        // Update new shadow texture for materials that receive shadows
+        //  -> bindless Materials share the table's shadowmap
+        Texture* pDepthAttachment = _shadowPassInstance.getFramebuffer(0)->getDepthAttachment();
+        if (_pBindlessMaterialTable)
+            _pBindlessMaterialTable->setShadowmapTexture(pDepthAttachment);
+
+        AssetManager* pAssetManager = Application::get_instance()->getAssetManager();
+        for (Asset* pAsset : pAssetManager->getAssets(AssetType::ASSET_TYPE_MATERIAL))
+        {
+            Material* pMaterial = (Material*)pAsset;
+            if (pMaterial->receivesShadows() && !pMaterial->isBindless())
+                pMaterial->updateShadowmapDescriptorSet(pDepthAttachment);
+        }
+    }
 
+    void MasterRenderer::destroyShadowPassResources()
+    {
         _shadowPassInstance.destroy();
     }
 
@@ -568,22 +784,9 @@ namespace platypus
 
     void MasterRenderer::createPipelines()
     {
-        const Extent2D swapchainExtent = _swapchainRef.getExtent();
-
         _pPostProcessingRenderer->createPipelines(_swapchainRef.getRenderPass());
-
-        _pGUIRenderer->createPipeline(
-            _swapchainRef.getRenderPass(),
-            swapchainExtent.width,
-            swapchainExtent.height
-        );
-
-        // NOTE: Materials' pipelines gets initially created by Batcher.
-        // If swapchain recreation occurs this makes the Materials to also recreate
-        // their pipelines according to the current situation
-        AssetManager* pAssetManager = Application::get_instance()->getAssetManager();
-        for (Asset* pAsset : pAssetManager->getAssets(AssetType::ASSET_TYPE_MATERIAL))
-            ((Material*)pAsset)->recreateExistingPipelines();
+        _pGUIRenderer->createPipeline(_swapchainRef.getRenderPass());
+        // NOTE: Materials' pipelines gets created by Batcher when creating batches
     }
 
     void MasterRenderer::destroyPipelines()
@@ -593,7 +796,7 @@ namespace platypus
 
         AssetManager* pAssetManager = Application::get_instance()->getAssetManager();
         for (Asset* pAsset : pAssetManager->getAssets(AssetType::ASSET_TYPE_MATERIAL))
-            ((Material*)pAsset)->destroyPipelines();
+            ((Material*)pAsset)->releasePipelines();
     }
 
     void MasterRenderer::createShaderResources()
@@ -771,6 +974,23 @@ namespace platypus
         //      because when adding to a batch, it only updates the host side!
         _batcher.updateDeviceSideBuffers(_currentFrame);
 
+        // Sorting all passes' batches to minimize state changes
+        _renderQueue.begin(pCamera ? pCamera->zFar : 1000.0f);
+        const RenderPassType queuedRenderPasses[3] = {
+            RenderPassType::SHADOW_PASS,
+            RenderPassType::OPAQUE_PASS,
+            RenderPassType::TRANSPARENT_PASS
+        };
+        for (RenderPassType renderPassType : queuedRenderPasses)
+        {
+            for (Batch* pBatch : _batcher.getBatches(renderPassType))
+            {
+                if (pBatch->repeatCount > 0 && pBatch->instanceCount > 0)
+                    _renderQueue.add(renderPassType, pBatch);
+            }
+        }
+        _renderQueue.sort();
+
         CommandBuffer& currentCommandBuffer = _primaryCommandBuffers[_currentFrame];
         currentCommandBuffer.begin(nullptr);
 
@@ -797,16 +1017,16 @@ namespace platypus
             pShadowFramebuffer,
             { 1, 0, 0, 1 }
         );
-        std::vector<CommandBuffer> shadowpassCommandBuffers;
-        shadowpassCommandBuffers.push_back(
-            _pRenderer3D->recordCommandBuffer(
+        render::exec_secondary_command_buffers(
+            currentCommandBuffer,
+            _pRenderer3D->recordCommandBuffers(
                 _shadowPassInstance.getRenderPass(),
                 (float)pShadowFramebuffer->getWidth(),
                 (float)pShadowFramebuffer->getHeight(),
-                _batcher.getBatches(RenderPassType::SHADOW_PASS)
+                _renderQueue.getBatches(RenderPassType::SHADOW_PASS),
+                _renderQueue.accessStatistics(RenderPassType::SHADOW_PASS)
             )
         );
-        render::exec_secondary_command_buffers(currentCommandBuffer, shadowpassCommandBuffers);
         render::end_render_pass(currentCommandBuffer, _shadowPassInstance.getRenderPass());
 
         // Transition shadowmap into correct format for opaque pass to sample
@@ -828,16 +1048,16 @@ namespace platypus
             _pOpaqueFramebuffer,
             sceneEnvProperties.clearColor
         );
-        std::vector<CommandBuffer> opaquePassCommandBuffers;
-        opaquePassCommandBuffers.push_back(
-            _pRenderer3D->recordCommandBuffer(
+        render::exec_secondary_command_buffers(
+            currentCommandBuffer,
+            _pRenderer3D->recordCommandBuffers(
                 _opaquePass,
                 (float)_pOpaqueFramebuffer->getWidth(),
                 (float)_pOpaqueFramebuffer->getHeight(),
-                _batcher.getBatches(RenderPassType::OPAQUE_PASS)
+                _renderQueue.getBatches(RenderPassType::OPAQUE_PASS),
+                _renderQueue.accessStatistics(RenderPassType::OPAQUE_PASS)
             )
         );
-        render::exec_secondary_command_buffers(currentCommandBuffer, opaquePassCommandBuffers);
         render::end_render_pass(currentCommandBuffer, _opaquePass);
 
         // Transition opaque pass' depthmap to samplable for transparent pass
@@ -859,16 +1079,16 @@ namespace platypus
             _pTransparentFramebuffer,
             { 0, 1, 0, 1 }
         );
-        std::vector<CommandBuffer> transparentPassCommandBuffers;
-        transparentPassCommandBuffers.push_back(
-            _pRenderer3D->recordCommandBuffer(
+        render::exec_secondary_command_buffers(
+            currentCommandBuffer,
+            _pRenderer3D->recordCommandBuffers(
                 _transparentPass,
                 (float)_pTransparentFramebuffer->getWidth(),
                 (float)_pTransparentFramebuffer->getHeight(),
-                _batcher.getBatches(RenderPassType::TRANSPARENT_PASS)
+                _renderQueue.getBatches(RenderPassType::TRANSPARENT_PASS),
+                _renderQueue.accessStatistics(RenderPassType::TRANSPARENT_PASS)
             )
         );
-        render::exec_secondary_command_buffers(currentCommandBuffer, transparentPassCommandBuffers);
         render::end_render_pass(currentCommandBuffer, _transparentPass);
 
         // Transition color attachment samplable for the post processing pass
@@ -933,21 +1153,42 @@ namespace platypus
         Window& window = pApp->getWindow();
         if (!window.isMinimized())
         {
+            std::chrono::time_point<std::chrono::high_resolution_clock> beginTime = std::chrono::high_resolution_clock::now();
+            // NOTE: All pipelines use dynamic viewport and scissor, so they don't depend
+            // on the window's size. They only need to be recreated if the swapchain's
+            // render pass becomes incompatible with them (formats change)
+            const ImageFormat prevSwapchainColorFormat = _swapchainRef.getRenderPass().getColorFormat();
+            const ImageFormat prevSwapchainDepthFormat = _swapchainRef.getRenderPass().getDepthFormat();
+
             Device::handle_window_resize();
             _swapchainRef.recreate(window);
+
+            if (_swapchainRef.getRenderPass().getColorFormat() != prevSwapchainColorFormat ||
+                _swapchainRef.getRenderPass().getDepthFormat() != prevSwapchainDepthFormat)
+            {
+                Debug::log(
+                    "Swapchain's formats changed! "
+                    "Recreating pipelines using the swapchain's render pass...",
+                    PLATYPUS_CURRENT_FUNC_NAME,
+                    Debug::MessageType::PLATYPUS_WARNING
+                );
+                _pPostProcessingRenderer->destroyPipelines();
+                _pPostProcessingRenderer->createPipelines(_swapchainRef.getRenderPass());
+                _pGUIRenderer->destroyPipeline();
+                _pGUIRenderer->createPipeline(_swapchainRef.getRenderPass());
+            }
+
             if (_swapchainRef.imageCountChanged())
             {
                 Debug::log(
                     "@MasterRenderer::handleWindowResize "
                     "Swapchain's image count changed! "
-                    "Recreating shader resources, command buffers, pipelines and batches...",
+                    "Recreating shader resources, command buffers and batches...",
                     Debug::MessageType::PLATYPUS_WARNING
                 );
                 destroyCommonShaderResources();
-                destroyPipelines();
                 freeCommandBuffers();
                 allocCommandBuffers(_swapchainRef.getMaxFramesInFlight());
-                createPipelines();
 
                 createCommonShaderResources();
                 destroyOffscreenPassResources();
@@ -960,51 +1201,29 @@ namespace platypus
                 createShaderResources();
 
                 // NOTE: Freeing batches which causes each batch to be created again when submitting.
-                // For this to work, batcher also needs to destroy all managed pipelines!
-                //      BUT it may be okay to NOT destroy and recreate existing pipelines since the created batches
-                //      will always have same IDs
-                //          -> u might be able to just recreate existing managed pipelines?? -> TEST THIS PLZ!
-                //  -> Makes window resizing even slower.
-                //  -> Required tho, because need to get new descriptor sets for batches!
+                // Managed pipelines are kept, since the recreated batches will have the same IDs.
+                //  -> Required, because need to get new descriptor sets for batches!
                 _batcher.freeBatches();
                 _pGUIRenderer->freeBatches();
-
-
-                _pPostProcessingRenderer->destroyShaderResources();
-                _pPostProcessingRenderer->destroyPipelines();
-                _pPostProcessingRenderer->destroyFramebuffers();
-
-                _pPostProcessingRenderer->createFramebuffers();
-                _pPostProcessingRenderer->createShaderResources(_pColorAttachment);
-                _pPostProcessingRenderer->createPipelines(_swapchainRef.getRenderPass());
             }
             else
             {
-                Debug::log(
-                    "@MasterRenderer::handleWindowResize "
-                    "Swapchain's image count didn't change. "
-                    "Recreating pipelines...",
-                    Debug::MessageType::PLATYPUS_WARNING
-                );
-                destroyPipelines();
-                createPipelines();
-
+                // Only the size dependent attachments and whatever refers to them
                 destroyOffscreenPassResources();
                 createOffscreenPassResources();
+            }
 
-                _batcher.recreateManagedPipelines();
-
-                _pPostProcessingRenderer->destroyShaderResources();
-                _pPostProcessingRenderer->destroyPipelines();
-                _pPostProcessingRenderer->destroyFramebuffers();
+            _pPostProcessingRenderer->destroyShaderResources();
+            _pPostProcessingRenderer->destroyFramebuffers();
 
-                _pPostProcessingRenderer->createFramebuffers();
-                _pPostProcessingRenderer->createShaderResources(_pColorAttachment);
-                _pPostProcessingRenderer->createPipelines(_swapchainRef.getRenderPass());
-            }
+            _pPostProcessingRenderer->createFramebuffers();
+            _pPostProcessingRenderer->createShaderResources(_pColorAttachment);
 
             _swapchainRef.resetChangedImageCount();
             window.resetResized();
+
+            std::chrono::duration<float, std::milli> resizeTime = std::chrono::high_resolution_clock::now() - beginTime;
+            Debug::log("Window resize handling took: " + std::to_string(resizeTime.count()) + " ms");
         }
         else
         {
@@ -6,12 +6,16 @@
 #include "platypus/graphics/Framebuffer.hpp"
 #include "platypus/graphics/RenderPass.hpp"
 #include "platypus/graphics/RenderPassInstance.hpp"
+#include "platypus/graphics/PipelineRegistry.hpp"
 #include "platypus/ecs/components/Renderable.hpp"
+#include "platypus/ecs/components/Transform.hpp"
 #include "platypus/assets/Material.hpp"
 #include "GUIRenderer.hpp"
 #include "Renderer3D.hpp"
 #include "PostProcessingRenderer.hpp"
 #include "Batch.hpp"
+#include "RenderQueue.hpp"
+#include "BindlessMaterialTable.hpp"
 
 #include <memory>
 
@@ -34,14 +38,38 @@ namespace platypus
         alignas(16) float time = 0.0f;
     };
 
+    // Per frame counts of the frustum culling done before batching
+    struct CullingStatistics
+    {
+        size_t testedCount = 0;
+        size_t mainPassVisibleCount = 0;
+        size_t shadowPassVisibleCount = 0;
+        // Culled from all passes
+        size_t culledCount = 0;
+    };
+
     class MasterRenderer
     {
     private:
+        // Renderable3Ds submitted this frame and their culling results
+        struct CullCandidate
+        {
+            entityID_t entity = NULL_ENTITY_ID;
+            const Transform* pTransform = nullptr;
+            Renderable3D* pRenderable = nullptr;
+            // Distance along the camera's forward axis
+            float viewDepth = 0.0f;
+            // Transparent candidates get the negated view depth -> sorted back to front
+            float sortDepth = 0.0f;
+        };
+
         DescriptorPool& _descriptorPoolRef;
         Swapchain& _swapchainRef;
         // NOTE: MasterRenderer shouldn't own DescriptorPool
         // since, for example some Assets are using it too...
         //  -> issue how MasterRenderer and AssetManager gets destroyed!
+        // NOTE: Needs to outlive the Batcher since it releases its pipelines here
+        PipelineRegistry _pipelineRegistry;
         Batcher _batcher;
         std::vector<CommandBuffer> _primaryCommandBuffers;
 
@@ -74,8 +102,24 @@ namespace platypus
         RenderPassInstance _shadowPassInstance;
         DescriptorSetLayout _shadowmapDescriptorSetLayout;
 
+        // Only if built with PLATYPUS_BINDLESS_MATERIALS and the device supports it
+        std::unique_ptr<BindlessMaterialTable> _pBindlessMaterialTable;
+
         size_t _currentFrame = 0;
 
+        bool _frustumCulling = true;
+        std::vector<CullCandidate> _cullCandidates;
+        // Results of the Scene's SpatialIndex queries
+        std::vector<entityID_t> _visibleEntities;
+        std::vector<entityID_t> _shadowVisibleEntities;
+        // CullVisibilityFlagBits for each entityID_t
+        std::vector<uint8_t> _entityVisibility;
+        // CullVisibilityFlagBits for each candidate
+        std::vector<uint8_t> _cullResults;
+        CullingStatistics _cullingStatistics;
+
+        RenderQueue _renderQueue;
+
     public:
         // NOTE: CommandPool and Device must exist when creating this
         MasterRenderer(
@@ -88,7 +132,8 @@ namespace platypus
 
         void cleanRenderers();
         void cleanUp();
-        void submit(Scene * const pScene, const Entity& entity);
+        // Submits all active renderable entities of the scene for rendering
+        void submit(Scene * const pScene);
         void render(const Window& window);
 
         void solveVertexBufferLayouts(
@@ -100,7 +145,6 @@ namespace platypus
         ) const;
         void solveDescriptorSetLayouts(
             const Material* pMaterial,
-            bool instanced,
             bool skinned,
             bool shadowPipeline,
             std::vector<DescriptorSetLayout>& outDescriptorSetLayouts
@@ -121,12 +165,28 @@ namespace platypus
 
         inline size_t getCurrentFrame() const { return _currentFrame; }
 
+        // Frustum culling queries the Scene's SpatialIndex with the camera's and
+        // the directional light's frustums before adding Renderable3Ds to batches
+        inline void setFrustumCulling(bool enable) { _frustumCulling = enable; }
+        inline bool isFrustumCullingEnabled() const { return _frustumCulling; }
+        inline const CullingStatistics& getCullingStatistics() const { return _cullingStatistics; }
+        // Bind counts of the last recorded frame
+        inline const RenderQueueStatistics& getRenderQueueStatistics(RenderPassType renderPassType) const { return _renderQueue.getStatistics(renderPassType); }
+        // Seconds spent recording the 3D render passes' command buffers on the last frame
+        inline float getRecordingTime() const { return _pRenderer3D->getLastRecordingTime(); }
+
+        inline PipelineRegistry& getPipelineRegistry() { return _pipelineRegistry; }
+        // nullptr if Materials use their own descriptor sets
+        inline BindlessMaterialTable* getBindlessMaterialTable() { return _pBindlessMaterialTable.get(); }
         inline Batcher& getBatcher() { return _batcher; }
         inline const Batcher& getBatcher() const { return _batcher; }
 
     private:
+        // Resources depending on the swapchain's extent
         void createOffscreenPassResources();
         void destroyOffscreenPassResources();
+        void createShadowPassResources();
+        void destroyShadowPassResources();
 
         void allocCommandBuffers(uint32_t count);
         void freeCommandBuffers();
@@ -138,6 +198,22 @@ namespace platypus
         void createCommonShaderResources();
         void destroyCommonShaderResources();
 
+        // Fills _cullResults for _cullCandidates.
+        // Candidates not found from the SpatialIndex (no mesh or bounds) are never culled.
+        // Camera's and directional light's frustums are queried concurrently using the JobSystem.
+        void cullRenderables(Scene * const pScene, const Light * const pDirectionalLight);
+
+        // Adds the renderable only to the batches of the passes in renderPassMask
+        void submitRenderable3D(
+            Scene * const pScene,
+            const Entity& entity,
+            const Transform& transform,
+            Renderable3D& renderable,
+            const Light * const pDirectionalLight,
+            uint32_t renderPassMask,
+            float viewDepth
+        );
+
         const CommandBuffer& recordCommandBuffer();
         void handleWindowResize();
     };
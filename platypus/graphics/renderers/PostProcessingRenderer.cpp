@@ -413,8 +413,7 @@ namespace platypus
                 pushConstantShaderStage = ShaderStageFlagBits::SHADER_STAGE_VERTEX_BIT;
             }
 
-            // TODO: Don't recrete pipelines on window resize
-            // -> unnecessary since using dynamic viewport atm!
+            // NOTE: Using dynamic viewport -> pipelines don't need to be recreated on window resize
             stageData.pPipeline = new Pipeline(
                 passIt->second,
                 { }, // Vertex buffer layouts
@@ -444,8 +443,6 @@ namespace platypus
             {
                 // NOTE: Don't delete pPipeline here?
                 // -> u could just use the destroy() and create()
-                //  -> which also shouldn't be required anymore since using pipeline's
-                //  dynamic viewport stage
                 stageData.pPipeline->destroy();
                 delete stageData.pPipeline;
                 stageData.pPipeline = nullptr;
@@ -0,0 +1,172 @@
+#include "RenderQueue.hpp"
+#include "platypus/core/Debug.hpp"
+#include <algorithm>
+#include <cstring>
+
+
+namespace platypus
+{
+    static const uint64_t s_passBits = 3;
+    static const uint64_t s_sortIDBits = 16;
+    static const uint64_t s_opaqueDepthBits = 13;
+    static const uint64_t s_transparentDepthBits = 29;
+    // Below this the radix sort's histograms cost more than comparison sorting
+    static const size_t s_radixSortMinCount = 1024;
+
+    static inline uint64_t quantize_depth(float depth, float maxDepth, uint64_t bits)
+    {
+        const uint64_t maxValue = (1ull << bits) - 1;
+        if (maxDepth <= 0.0f)
+            return 0;
+        const float normalized = std::max(0.0f, std::min(depth / maxDepth, 1.0f));
+        return (uint64_t)(normalized * (float)maxValue);
+    }
+
+    void RenderQueue::begin(float maxDepth)
+    {
+        _items.clear();
+        _maxDepth = maxDepth;
+        for (size_t i = 0; i < PLATYPUS_RENDER_QUEUE_MAX_RENDER_PASSES; ++i)
+        {
+            _sortedBatches[i].clear();
+            _statistics[i] = RenderQueueStatistics();
+        }
+    }
+
+    void RenderQueue::add(RenderPassType renderPassType, Batch* pBatch)
+    {
+        if ((size_t)renderPassType >= PLATYPUS_RENDER_QUEUE_MAX_RENDER_PASSES)
+        {
+            Debug::log(
+                "Invalid render pass type: " + render_pass_type_to_string(renderPassType),
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            PLATYPUS_ASSERT(false);
+            return;
+        }
+
+        // Transparent batches are sorted by their farthest entry and opaque ones by their closest
+        const float depth = renderPassType == RenderPassType::TRANSPARENT_PASS ? pBatch->maxDepth : pBatch->minDepth;
+        const uint64_t sortKey = create_sort_key(
+            renderPassType,
+            getSortID<const Pipeline*>(_pipelineSortIDs, pBatch->pPipeline),
+            getSortID<UUID_t>(_materialSortIDs, pBatch->materialID),
+            getSortID<UUID_t>(_meshSortIDs, pBatch->meshID),
+            depth,
+            _maxDepth
+        );
+        _items.push_back({ sortKey, pBatch });
+    }
+
+    void RenderQueue::sort()
+    {
+        _sortBuffer.resize(_items.size());
+        radix_sort(_items.data(), _sortBuffer.data(), _items.size());
+
+        for (const RenderQueueItem& item : _items)
+        {
+            const size_t passIndex = (size_t)(item.sortKey >> (64 - s_passBits));
+            _sortedBatches[passIndex].push_back(item.pBatch);
+            ++_statistics[passIndex].batchCount;
+        }
+    }
+
+    const std::vector<Batch*>& RenderQueue::getBatches(RenderPassType renderPassType) const
+    {
+        return _sortedBatches[(size_t)renderPassType];
+    }
+
+    const RenderQueueStatistics& RenderQueue::getStatistics(RenderPassType renderPassType) const
+    {
+        return _statistics[(size_t)renderPassType];
+    }
+
+    RenderQueueStatistics& RenderQueue::accessStatistics(RenderPassType renderPassType)
+    {
+        return _statistics[(size_t)renderPassType];
+    }
+
+    uint64_t RenderQueue::create_sort_key(
+        RenderPassType renderPassType,
+        uint16_t pipelineSortID,
+        uint16_t materialSortID,
+        uint16_t meshSortID,
+        float depth,
+        float maxDepth
+    )
+    {
+        uint64_t sortKey = (uint64_t)renderPassType << (64 - s_passBits);
+        if (renderPassType == RenderPassType::TRANSPARENT_PASS)
+        {
+            // Back to front -> farther batches get smaller keys
+            const uint64_t maxDepthValue = (1ull << s_transparentDepthBits) - 1;
+            const uint64_t invertedDepth = maxDepthValue - quantize_depth(depth, maxDepth, s_transparentDepthBits);
+            sortKey |= invertedDepth << (s_sortIDBits * 2);
+            sortKey |= (uint64_t)pipelineSortID << s_sortIDBits;
+            sortKey |= (uint64_t)materialSortID;
+        }
+        else
+        {
+            sortKey |= (uint64_t)pipelineSortID << (s_sortIDBits * 2 + s_opaqueDepthBits);
+            sortKey |= (uint64_t)materialSortID << (s_sortIDBits + s_opaqueDepthBits);
+            sortKey |= (uint64_t)meshSortID << s_opaqueDepthBits;
+            sortKey |= quantize_depth(depth, maxDepth, s_opaqueDepthBits);
+        }
+        return sortKey;
+    }
+
+    void RenderQueue::radix_sort(RenderQueueItem* pItems, RenderQueueItem* pBuffer, size_t count)
+    {
+        if (count < 2)
+            return;
+
+        if (count < s_radixSortMinCount)
+        {
+            std::stable_sort(
+                pItems,
+                pItems + count,
+                [](const RenderQueueItem& a, const RenderQueueItem& b) { return a.sortKey < b.sortKey; }
+            );
+            return;
+        }
+
+        // Histograms of all digits in a single pass over the keys
+        size_t histograms[8][256];
+        memset(histograms, 0, sizeof(histograms));
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint64_t key = pItems[i].sortKey;
+            for (size_t digit = 0; digit < 8; ++digit)
+                ++histograms[digit][(key >> (digit * 8)) & 0xFF];
+        }
+
+        RenderQueueItem* pSource = pItems;
+        RenderQueueItem* pDestination = pBuffer;
+        for (size_t digit = 0; digit < 8; ++digit)
+        {
+            size_t* pHistogram = histograms[digit];
+            // All keys have the same value for this digit -> nothing to do
+            if (pHistogram[(pSource[0].sortKey >> (digit * 8)) & 0xFF] == count)
+                continue;
+
+            size_t offset = 0;
+            for (size_t bucket = 0; bucket < 256; ++bucket)
+            {
+                const size_t bucketCount = pHistogram[bucket];
+                pHistogram[bucket] = offset;
+                offset += bucketCount;
+            }
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const size_t bucket = (pSource[i].sortKey >> (digit * 8)) & 0xFF;
+                pDestination[pHistogram[bucket]++] = pSource[i];
+            }
+            std::swap(pSource, pDestination);
+        }
+
+        if (pSource != pItems)
+            memcpy(pItems, pSource, sizeof(RenderQueueItem) * count);
+    }
+}
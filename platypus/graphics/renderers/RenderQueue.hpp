@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Batch.hpp"
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+#define PLATYPUS_RENDER_QUEUE_MAX_RENDER_PASSES 8
+
+
+namespace platypus
+{
+    // Per frame counts of the state changes Renderer3D recorded for a render pass.
+    // "Saved" counts are the binds skipped because the previous batch used the same state
+    // (without sorting, each batch bound all of its state).
+    struct RenderQueueStatistics
+    {
+        size_t batchCount = 0;
+        size_t drawCount = 0;
+        size_t pipelineBinds = 0;
+        size_t pipelineBindsSaved = 0;
+        size_t vertexBufferBinds = 0;
+        size_t vertexBufferBindsSaved = 0;
+        size_t indexBufferBinds = 0;
+        size_t indexBufferBindsSaved = 0;
+        size_t descriptorSetBinds = 0;
+        size_t descriptorSetBindsSaved = 0;
+    };
+
+    struct RenderQueueItem
+    {
+        uint64_t sortKey = 0;
+        Batch* pBatch = nullptr;
+    };
+
+    // Orders the batches of each render pass by a 64 bit sort key,
+    // so that consecutive batches share as much state as possible.
+    //
+    // Key layouts (most significant bits first):
+    //  -opaque and shadow: pass(3) | pipeline(16) | material(16) | mesh(16) | depth(13) (front to back)
+    //  -transparent: pass(3) | inverted depth(29) (back to front) | pipeline(16) | material(16)
+    //
+    // Pipelines, materials and meshes get compact 16 bit sort IDs in the order they were
+    // first seen. Depths are quantized against the camera's far plane.
+    // NOTE: Batches are sorted as whole, the entries inside a batch are drawn
+    // in the order they were added to the batch.
+    class RenderQueue
+    {
+    private:
+        std::vector<RenderQueueItem> _items;
+        std::vector<RenderQueueItem> _sortBuffer;
+
+        std::unordered_map<const Pipeline*, uint16_t> _pipelineSortIDs;
+        std::unordered_map<UUID_t, uint16_t> _materialSortIDs;
+        std::unordered_map<UUID_t, uint16_t> _meshSortIDs;
+
+        float _maxDepth = 1000.0f;
+
+        // Indexed by RenderPassType
+        std::vector<Batch*> _sortedBatches[PLATYPUS_RENDER_QUEUE_MAX_RENDER_PASSES];
+        RenderQueueStatistics _statistics[PLATYPUS_RENDER_QUEUE_MAX_RENDER_PASSES];
+
+    public:
+        RenderQueue() = default;
+        RenderQueue(const RenderQueue& other) = delete;
+
+        // Clears the previous frame's batches and statistics
+        void begin(float maxDepth);
+        void add(RenderPassType renderPassType, Batch* pBatch);
+        // Sorts all added batches and splits them by render pass
+        void sort();
+
+        const std::vector<Batch*>& getBatches(RenderPassType renderPassType) const;
+        const RenderQueueStatistics& getStatistics(RenderPassType renderPassType) const;
+        RenderQueueStatistics& accessStatistics(RenderPassType renderPassType);
+
+        static uint64_t create_sort_key(
+            RenderPassType renderPassType,
+            uint16_t pipelineSortID,
+            uint16_t materialSortID,
+            uint16_t meshSortID,
+            float depth,
+            float maxDepth
+        );
+        // Stable LSD radix sort by sortKey with 8 bit digits.
+        // Digits which are the same for all keys are skipped.
+        // Small counts are sorted with std::stable_sort instead.
+        // pBuffer has to have space for count items.
+        static void radix_sort(RenderQueueItem* pItems, RenderQueueItem* pBuffer, size_t count);
+
+    private:
+        template <typename T>
+        uint16_t getSortID(std::unordered_map<T, uint16_t>& sortIDs, T key)
+        {
+            typename std::unordered_map<T, uint16_t>::const_iterator it = sortIDs.find(key);
+            if (it != sortIDs.end())
+                return it->second;
+
+            // NOTE: IDs only affect the sorting -> starting over if running out of them
+            if (sortIDs.size() >= UINT16_MAX)
+                sortIDs.clear();
+
+            const uint16_t sortID = (uint16_t)sortIDs.size();
+            sortIDs[key] = sortID;
+            return sortID;
+        }
+    };
+}
@@ -4,10 +4,41 @@
 #include "platypus/graphics/RenderCommand.hpp"
 #include "platypus/core/Application.hpp"
 #include "platypus/core/Debug.hpp"
+#include <algorithm>
+#include <chrono>
 
 
 namespace platypus
 {
+    static bool descriptor_sets_equal(
+        const std::vector<DescriptorSet>& a,
+        const std::vector<DescriptorSet>& b
+    )
+    {
+        if (a.size() != b.size())
+            return false;
+
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (a[i].getImpl() != b[i].getImpl())
+                return false;
+        }
+        return true;
+    }
+
+    static void add_statistics(RenderQueueStatistics& target, const RenderQueueStatistics& source)
+    {
+        target.drawCount += source.drawCount;
+        target.pipelineBinds += source.pipelineBinds;
+        target.pipelineBindsSaved += source.pipelineBindsSaved;
+        target.vertexBufferBinds += source.vertexBufferBinds;
+        target.vertexBufferBindsSaved += source.vertexBufferBindsSaved;
+        target.indexBufferBinds += source.indexBufferBinds;
+        target.indexBufferBindsSaved += source.indexBufferBindsSaved;
+        target.descriptorSetBinds += source.descriptorSetBinds;
+        target.descriptorSetBindsSaved += source.descriptorSetBindsSaved;
+    }
+
     Renderer3D::Renderer3D(MasterRenderer& masterRendererRef) :
         _masterRendererRef(masterRendererRef)
     {
@@ -17,53 +48,146 @@ namespace platypus
     {
     }
 
-    CommandBuffer& Renderer3D::recordCommandBuffer(
+    const std::vector<CommandBuffer>& Renderer3D::recordCommandBuffers(
         const RenderPass& renderPass,
         float viewportWidth,
         float viewportHeight,
-        const std::vector<Batch*>& toRender
+        const std::vector<Batch*>& toRender,
+        RenderQueueStatistics& outStatistics
     )
     {
+        std::chrono::time_point<std::chrono::high_resolution_clock> beginTime = std::chrono::high_resolution_clock::now();
+        _recordedCommandBuffers.clear();
+
         RenderPassType renderPassType = renderPass.getType();
-        if (_commandBuffers.find(renderPassType) == _commandBuffers.end())
+        if (_recordingSlots.empty() || _recordingSlots[0].commandBuffers.find(renderPassType) == _recordingSlots[0].commandBuffers.end())
         {
             Debug::log(
-                "@Renderer3D::recordCommandBuffer "
+                "@Renderer3D::recordCommandBuffers "
                 "No allocated command buffers found for render pass type: " + render_pass_type_to_string(renderPassType),
                 Debug::MessageType::PLATYPUS_ERROR
             );
             PLATYPUS_ASSERT(false);
+            return _recordedCommandBuffers;
         }
-        if (_currentFrame >= _commandBuffers[renderPassType].size())
+        if (_currentFrame >= _recordingSlots[0].commandBuffers[renderPassType].size())
         {
             Debug::log(
-                "@Renderer3D::recordCommandBuffer "
+                "@Renderer3D::recordCommandBuffers "
                 "Frame index(" + std::to_string(_currentFrame) + ") out of bounds for render pass type: " + render_pass_type_to_string(renderPassType) + " "
-                "Allocated command buffer count is " + std::to_string(_commandBuffers[renderPassType].size()),
+                "Allocated command buffer count is " + std::to_string(_recordingSlots[0].commandBuffers[renderPassType].size()),
                 Debug::MessageType::PLATYPUS_ERROR
             );
             PLATYPUS_ASSERT(false);
+            return _recordedCommandBuffers;
         }
 
-        CommandBuffer& currentCommandBuffer = _commandBuffers[renderPass.getType()][_currentFrame];
-        currentCommandBuffer.begin(&renderPass);
+        // Each range of the batches gets recorded into its own slot's command buffer
+        // and the command buffers are executed in the same order as the ranges.
+        JobSystem& jobSystem = Application::get_instance()->getJobSystem();
+        const size_t batchCount = toRender.size();
+        size_t rangeCount = std::min(_recordingSlots.size(), jobSystem.getWorkerCount() + 1);
+        rangeCount = std::min(rangeCount, (batchCount + _minBatchesPerSlot - 1) / _minBatchesPerSlot);
+        rangeCount = std::max<size_t>(rangeCount, 1);
+        const size_t rangeSize = (batchCount + rangeCount - 1) / rangeCount;
 
+        Batch* const* ppBatches = toRender.data();
+        auto recordRange = [this, &renderPass, renderPassType, viewportWidth, viewportHeight, ppBatches, batchCount, rangeSize](size_t rangeIndex)
+        {
+            RecordingSlot& slot = _recordingSlots[rangeIndex];
+            slot.statistics = RenderQueueStatistics();
+            const size_t begin = std::min(rangeIndex * rangeSize, batchCount);
+            const size_t end = std::min(begin + rangeSize, batchCount);
+            CommandBuffer& commandBuffer = slot.commandBuffers[renderPassType][_currentFrame];
+            commandBuffer.begin(&renderPass);
+            recordBatches(
+                commandBuffer,
+                viewportWidth,
+                viewportHeight,
+                ppBatches + begin,
+                end - begin,
+                slot.statistics
+            );
+            commandBuffer.end();
+        };
+
+        if (rangeCount == 1)
+        {
+            recordRange(0);
+        }
+        else
+        {
+            JobCounter counter;
+            for (size_t rangeIndex = 1; rangeIndex < rangeCount; ++rangeIndex)
+                jobSystem.submit([&recordRange, rangeIndex]() { recordRange(rangeIndex); }, &counter);
+            recordRange(0);
+            jobSystem.wait(&counter);
+        }
+
+        for (size_t rangeIndex = 0; rangeIndex < rangeCount; ++rangeIndex)
+        {
+            RecordingSlot& slot = _recordingSlots[rangeIndex];
+            _recordedCommandBuffers.push_back(slot.commandBuffers[renderPassType][_currentFrame]);
+            add_statistics(outStatistics, slot.statistics);
+        }
+
+        std::chrono::duration<float> duration = std::chrono::high_resolution_clock::now() - beginTime;
+        _recordingTime += duration.count();
+        return _recordedCommandBuffers;
+    }
+
+    void Renderer3D::recordBatches(
+        CommandBuffer& currentCommandBuffer,
+        float viewportWidth,
+        float viewportHeight,
+        Batch* const* ppBatches,
+        size_t batchCount,
+        RenderQueueStatistics& outStatistics
+    )
+    {
         const size_t currentFrame = _masterRendererRef.getCurrentFrame();
-        for (Batch* pBatch : toRender)
+
+        // State of the previous batch
+        const Pipeline* pBoundPipeline = nullptr;
+        std::vector<const Buffer*> boundVertexBuffers;
+        const Buffer* pBoundIndexBuffer = nullptr;
+        const std::vector<DescriptorSet>* pBoundDescriptorSets = nullptr;
+
+        std::vector<const Buffer*> vertexBuffers;
+        for (size_t batchIndex = 0; batchIndex < batchCount; ++batchIndex)
         {
+            Batch* pBatch = ppBatches[batchIndex];
             // DANGER! Might dereference nullptr!
-            render::bind_pipeline(
-                currentCommandBuffer,
-                *pBatch->pPipeline
-            );
-            render::set_viewport(currentCommandBuffer, 0, 0, viewportWidth, viewportHeight, 0.0f, 1.0f);
-            render::set_scissor(currentCommandBuffer, { 0, 0, (uint32_t)viewportWidth, (uint32_t)viewportHeight });
-
-            // TODO: Fix this mess!
-            //      * Should have better way of grouping all
-            // TODO: Don't alloc each time here!
-            std::vector<const Buffer*> vertexBuffers;
-            vertexBuffers.reserve(pBatch->staticVertexBuffers.size() + pBatch->dynamicVertexBuffers.size());
+            if (pBatch->pPipeline != pBoundPipeline)
+            {
+                render::bind_pipeline(
+                    currentCommandBuffer,
+                    *pBatch->pPipeline
+                );
+                ++outStatistics.pipelineBinds;
+                // Viewport and scissor are dynamic state -> need to set only once per command buffer
+                if (!pBoundPipeline)
+                {
+                    render::set_viewport(currentCommandBuffer, 0, 0, viewportWidth, viewportHeight, 0.0f, 1.0f);
+                    render::set_scissor(currentCommandBuffer, { 0, 0, (uint32_t)viewportWidth, (uint32_t)viewportHeight });
+                }
+                pBoundPipeline = pBatch->pPipeline;
+
+                // Different pipelines may have incompatible descriptor set layouts.
+                // On web the vertex and index buffers are part of the pipeline's
+                // vertex array object, so those need to be bound again as well.
+                pBoundDescriptorSets = nullptr;
+                #ifdef PLATYPUS_BUILD_WEB
+                boundVertexBuffers.clear();
+                pBoundIndexBuffer = nullptr;
+                #endif
+            }
+            else
+            {
+                ++outStatistics.pipelineBindsSaved;
+            }
+
+            vertexBuffers.clear();
             for (const Buffer* pBuffer : pBatch->staticVertexBuffers)
                 vertexBuffers.emplace_back(pBuffer);
             for (std::vector<Buffer*>& dynamicVertexBuffers : pBatch->dynamicVertexBuffers)
@@ -73,96 +197,192 @@ namespace platypus
                 vertexBuffers.emplace_back(pDynamicVertexBuffer);
             }
 
-            render::bind_vertex_buffers(
-                currentCommandBuffer,
-                vertexBuffers
-            );
-            render::bind_index_buffer(currentCommandBuffer, pBatch->pIndexBuffer);
+            if (vertexBuffers != boundVertexBuffers)
+            {
+                render::bind_vertex_buffers(
+                    currentCommandBuffer,
+                    vertexBuffers
+                );
+                boundVertexBuffers = vertexBuffers;
+                ++outStatistics.vertexBufferBinds;
+            }
+            else
+            {
+                ++outStatistics.vertexBufferBindsSaved;
+            }
 
-            for (uint32_t repeatIndex = 0; repeatIndex < pBatch->repeatCount; ++repeatIndex)
+            if (pBatch->pIndexBuffer != pBoundIndexBuffer)
             {
-                if (pBatch->pushConstantsSize > 0)
-                {
-                    render::push_constants(
-                        currentCommandBuffer,
-                        pBatch->pushConstantsShaderStage,
-                        0,
-                        pBatch->pushConstantsSize,
-                        pBatch->pPushConstantsData,
-                        pBatch->pushConstantsUniformInfos
-                    );
-                }
+                render::bind_index_buffer(currentCommandBuffer, pBatch->pIndexBuffer);
+                pBoundIndexBuffer = pBatch->pIndexBuffer;
+                ++outStatistics.indexBufferBinds;
+            }
+            else
+            {
+                ++outStatistics.indexBufferBindsSaved;
+            }
 
+            // NOTE: Push constants' data may differ between batches of the same pipeline
+            //  -> always pushed
+            if (pBatch->pushConstantsSize > 0)
+            {
+                render::push_constants(
+                    currentCommandBuffer,
+                    pBatch->pushConstantsShaderStage,
+                    0,
+                    pBatch->pushConstantsSize,
+                    pBatch->pPushConstantsData,
+                    pBatch->pushConstantsUniformInfos
+                );
+            }
+            if (pBatch->bindlessMaterialIndex != PLATYPUS_BINDLESS_INVALID_INDEX)
+            {
+                render::push_constants(
+                    currentCommandBuffer,
+                    pBatch->pushConstantsShaderStage,
+                    (uint32_t)pBatch->pushConstantsSize,
+                    sizeof(uint32_t),
+                    &pBatch->bindlessMaterialIndex,
+                    { }
+                );
+            }
+
+            const uint32_t indexCount = (uint32_t)pBatch->pIndexBuffer->getDataLength();
+            // Instanced batches' per object data is in the instanced vertex buffer
+            // or in a storage buffer indexed by the instance index (skinned meshes' joint palettes)
+            //  -> whole batch in a single draw
+            if (pBatch->instanceAdvance > 0)
+            {
                 if (!pBatch->descriptorSets.empty())
                 {
-                    if (pBatch->dynamicUniformBufferElementSize == 0)
+                    const std::vector<DescriptorSet>& descriptorSets = pBatch->descriptorSets[_currentFrame];
+                    if (!pBoundDescriptorSets || !descriptor_sets_equal(*pBoundDescriptorSets, descriptorSets))
                     {
                         render::bind_descriptor_sets(
                             currentCommandBuffer,
-                            pBatch->descriptorSets[_currentFrame],
+                            descriptorSets,
                             { }
                         );
+                        pBoundDescriptorSets = &descriptorSets;
+                        ++outStatistics.descriptorSetBinds;
                     }
                     else
                     {
-                        uint32_t dynamicUniformBufferOffset = repeatIndex * pBatch->dynamicUniformBufferElementSize;
+                        ++outStatistics.descriptorSetBindsSaved;
+                    }
+                }
+                render::draw_indexed(
+                    currentCommandBuffer,
+                    indexCount,
+                    pBatch->instanceCount,
+                    pBatch->firstRepeat
+                );
+                ++outStatistics.drawCount;
+                continue;
+            }
+
+            // NOTE: Only used on web atm, where skinned meshes' joint palettes are
+            // in a dynamic uniform buffer since there are no storage buffers
+            for (uint32_t repeatIndex = 0; repeatIndex < pBatch->repeatCount; ++repeatIndex)
+            {
+                if (!pBatch->descriptorSets.empty())
+                {
+                    const std::vector<DescriptorSet>& descriptorSets = pBatch->descriptorSets[_currentFrame];
+                    if (pBatch->dynamicUniformBufferElementSize == 0)
+                    {
+                        if (!pBoundDescriptorSets || !descriptor_sets_equal(*pBoundDescriptorSets, descriptorSets))
+                        {
+                            render::bind_descriptor_sets(
+                                currentCommandBuffer,
+                                descriptorSets,
+                                { }
+                            );
+                            pBoundDescriptorSets = &descriptorSets;
+                            ++outStatistics.descriptorSetBinds;
+                        }
+                        else
+                        {
+                            ++outStatistics.descriptorSetBindsSaved;
+                        }
+                    }
+                    else
+                    {
+                        // Dynamic offset changes for each repeat -> always bound
+                        uint32_t dynamicUniformBufferOffset = (pBatch->firstRepeat + repeatIndex) * pBatch->dynamicUniformBufferElementSize;
                         render::bind_descriptor_sets(
                             currentCommandBuffer,
-                            pBatch->descriptorSets[_currentFrame],
+                            descriptorSets,
                             { dynamicUniformBufferOffset }
                         );
+                        pBoundDescriptorSets = nullptr;
+                        ++outStatistics.descriptorSetBinds;
                     }
                 }
 
                 render::draw_indexed(
                     currentCommandBuffer,
-                    (uint32_t)pBatch->pIndexBuffer->getDataLength(),
+                    indexCount,
                     pBatch->instanceCount
                 );
+                ++outStatistics.drawCount;
             }
         }
 
-        currentCommandBuffer.end();
-
-        return currentCommandBuffer;
     }
 
     void Renderer3D::advanceFrame()
     {
         size_t maxFramesInFlight = Application::get_instance()->getSwapchain()->getMaxFramesInFlight();
         _currentFrame = (_currentFrame + 1) % maxFramesInFlight;
+        _lastRecordingTime = _recordingTime;
+        _recordingTime = 0.0f;
     }
 
     void Renderer3D::allocCommandBuffers()
     {
         size_t maxFramesInFlight = Application::get_instance()->getSwapchain()->getMaxFramesInFlight();
-        _commandBuffers[RenderPassType::SCREEN_PASS] = Device::get_command_pool()->allocCommandBuffers(
-            maxFramesInFlight,
-            CommandBufferLevel::SECONDARY_COMMAND_BUFFER
-        );
-        _commandBuffers[RenderPassType::SHADOW_PASS] = Device::get_command_pool()->allocCommandBuffers(
-            maxFramesInFlight,
-            CommandBufferLevel::SECONDARY_COMMAND_BUFFER
-        );
-        _commandBuffers[RenderPassType::OPAQUE_PASS] = Device::get_command_pool()->allocCommandBuffers(
-            maxFramesInFlight,
-            CommandBufferLevel::SECONDARY_COMMAND_BUFFER
-        );
-        _commandBuffers[RenderPassType::TRANSPARENT_PASS] = Device::get_command_pool()->allocCommandBuffers(
-            maxFramesInFlight,
-            CommandBufferLevel::SECONDARY_COMMAND_BUFFER
-        );
+        // Command pools can't be used from multiple threads at the same time
+        //  -> each slot that may get recorded in parallel has its own pool.
+        // NOTE: Web build records everything immediately on the main thread
+        //  -> always using a single slot there
+        #ifdef PLATYPUS_BUILD_WEB
+        const size_t slotCount = 1;
+        #else
+        const size_t slotCount = JobSystem::get_default_worker_count() + 1;
+        #endif
+        const RenderPassType renderPassTypes[4] = {
+            RenderPassType::SCREEN_PASS,
+            RenderPassType::SHADOW_PASS,
+            RenderPassType::OPAQUE_PASS,
+            RenderPassType::TRANSPARENT_PASS
+        };
+        _recordingSlots.resize(slotCount);
+        for (RecordingSlot& slot : _recordingSlots)
+        {
+            slot.pCommandPool = std::make_unique<CommandPool>();
+            for (RenderPassType renderPassType : renderPassTypes)
+            {
+                slot.commandBuffers[renderPassType] = slot.pCommandPool->allocCommandBuffers(
+                    maxFramesInFlight,
+                    CommandBufferLevel::SECONDARY_COMMAND_BUFFER
+                );
+            }
+        }
     }
 
     void Renderer3D::freeCommandBuffers()
     {
-        std::unordered_map<RenderPassType, std::vector<CommandBuffer>>::iterator it;
-        for (it = _commandBuffers.begin(); it != _commandBuffers.end(); ++it)
+        for (RecordingSlot& slot : _recordingSlots)
         {
-            for (CommandBuffer& commandBuffer : it->second)
-                commandBuffer.free();
+            std::unordered_map<RenderPassType, std::vector<CommandBuffer>>::iterator it;
+            for (it = slot.commandBuffers.begin(); it != slot.commandBuffers.end(); ++it)
+            {
+                for (CommandBuffer& commandBuffer : it->second)
+                    commandBuffer.free();
+            }
         }
-
-        _commandBuffers.clear();
+        _recordedCommandBuffers.clear();
+        // Pools get destroyed after all their command buffers were freed
+        _recordingSlots.clear();
     }
 }
@@ -2,7 +2,9 @@
 
 #include "platypus/graphics/CommandBuffer.hpp"
 #include "Batch.hpp"
+#include "RenderQueue.hpp"
 #include <unordered_map>
+#include <memory>
 
 
 namespace platypus
@@ -11,25 +13,61 @@ namespace platypus
     class Renderer3D
     {
     private:
+        // Range of a render pass' batches recorded by a single job
+        struct RecordingSlot
+        {
+            std::unique_ptr<CommandPool> pCommandPool;
+            // Secondary command buffer for each frame in flight
+            std::unordered_map<RenderPassType, std::vector<CommandBuffer>> commandBuffers;
+            RenderQueueStatistics statistics;
+        };
+
         MasterRenderer& _masterRendererRef;
 
-        std::unordered_map<RenderPassType, std::vector<CommandBuffer>> _commandBuffers;
+        std::vector<RecordingSlot> _recordingSlots;
+        std::vector<CommandBuffer> _recordedCommandBuffers;
+        // Render passes with less batches than this per slot are recorded using fewer slots
+        size_t _minBatchesPerSlot = 32;
         size_t _currentFrame = 0;
 
+        float _recordingTime = 0.0f;
+        float _lastRecordingTime = 0.0f;
+
     public:
         Renderer3D(MasterRenderer& masterRendererRef);
         ~Renderer3D();
 
-        CommandBuffer& recordCommandBuffer(
+        // Records only the state changes between consecutive batches
+        // -> give the batches sorted (see RenderQueue).
+        // Bind counts get added to outStatistics.
+        //
+        // The batches are split into ranges recorded in parallel using the JobSystem.
+        // Returned secondary command buffers have to be executed in the returned order.
+        const std::vector<CommandBuffer>& recordCommandBuffers(
             const RenderPass& renderPass,
             float viewportWidth,
             float viewportHeight,
-            const std::vector<Batch*>& toRender
+            const std::vector<Batch*>& toRender,
+            RenderQueueStatistics& outStatistics
         );
 
         void advanceFrame();
 
         void allocCommandBuffers();
         void freeCommandBuffers();
+
+        inline void setMinBatchesPerSlot(size_t count) { _minBatchesPerSlot = count > 0 ? count : 1; }
+        // Seconds spent in recordCommandBuffers() during the previous frame
+        inline float getLastRecordingTime() const { return _lastRecordingTime; }
+
+    private:
+        void recordBatches(
+            CommandBuffer& commandBuffer,
+            float viewportWidth,
+            float viewportHeight,
+            Batch* const* ppBatches,
+            size_t batchCount,
+            RenderQueueStatistics& outStatistics
+        );
     };
 }
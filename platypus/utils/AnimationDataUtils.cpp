@@ -0,0 +1,225 @@
+#include "AnimationDataUtils.hpp"
+#include <cmath>
+#include <algorithm>
+
+
+namespace platypus
+{
+    static const float s_smallestThreeMax = 0.70710678f; // 1 / sqrt(2)
+    static const float s_packedQuaternionMaxValue = 32767.0f;
+
+    PackedQuaternion pack_quaternion(const Quaternion& quaternion)
+    {
+        const Quaternion normalized = quaternion.normalize();
+        float components[4] = { normalized.x, normalized.y, normalized.z, normalized.w };
+
+        uint16_t largestIndex = 0;
+        for (uint16_t i = 1; i < 4; ++i)
+        {
+            if (std::abs(components[i]) > std::abs(components[largestIndex]))
+                largestIndex = i;
+        }
+        // q and -q are the same rotation -> make the dropped component positive
+        // so it can be recalculated without knowing its sign
+        const float sign = components[largestIndex] < 0.0f ? -1.0f : 1.0f;
+
+        PackedQuaternion packedQuaternion;
+        uint16_t dataIndex = 0;
+        for (uint16_t i = 0; i < 4; ++i)
+        {
+            if (i == largestIndex)
+                continue;
+            float value = components[i] * sign / s_smallestThreeMax;
+            value = std::min(std::max(value, -1.0f), 1.0f);
+            const float normalizedValue = (value * 0.5f + 0.5f) * s_packedQuaternionMaxValue;
+            packedQuaternion.data[dataIndex] = static_cast<uint16_t>(normalizedValue + 0.5f);
+            ++dataIndex;
+        }
+        packedQuaternion.data[0] |= static_cast<uint16_t>((largestIndex & 1) << 15);
+        packedQuaternion.data[1] |= static_cast<uint16_t>((largestIndex >> 1) << 15);
+        return packedQuaternion;
+    }
+
+    Quaternion unpack_quaternion(const PackedQuaternion& packedQuaternion)
+    {
+        const uint16_t largestIndex = (packedQuaternion.data[0] >> 15) | ((packedQuaternion.data[1] >> 15) << 1);
+        float components[4];
+        float squaredSum = 0.0f;
+        uint16_t dataIndex = 0;
+        for (uint16_t i = 0; i < 4; ++i)
+        {
+            if (i == largestIndex)
+                continue;
+            const float normalizedValue = static_cast<float>(packedQuaternion.data[dataIndex] & 0x7FFF) / s_packedQuaternionMaxValue;
+            const float value = (normalizedValue * 2.0f - 1.0f) * s_smallestThreeMax;
+            components[i] = value;
+            squaredSum += value * value;
+            ++dataIndex;
+        }
+        components[largestIndex] = std::sqrt(std::max(0.0f, 1.0f - squaredSum));
+        return { components[0], components[1], components[2], components[3] };
+    }
+
+
+    static float get_max_difference(const Vector3f& a, const Vector3f& b)
+    {
+        return std::max(std::abs(a.x - b.x), std::max(std::abs(a.y - b.y), std::abs(a.z - b.z)));
+    }
+
+    static float get_max_difference(const Quaternion& a, const Quaternion& b)
+    {
+        // q and -q are the same rotation
+        const float sign = a.dotp(b) < 0.0f ? -1.0f : 1.0f;
+        return std::max(
+            std::max(std::abs(a.x - b.x * sign), std::abs(a.y - b.y * sign)),
+            std::max(std::abs(a.z - b.z * sign), std::abs(a.w - b.w * sign))
+        );
+    }
+
+    static Vector3f interpolate(const Vector3f& a, const Vector3f& b, float amount)
+    {
+        return a.lerp(b, amount);
+    }
+
+    static Quaternion interpolate(const Quaternion& a, const Quaternion& b, float amount)
+    {
+        return a.slerp(b, amount);
+    }
+
+    // Removes keys between the kept keys if all of them can be interpolated
+    // from the kept ones within the tolerance.
+    template <typename KeyType, typename ValueType>
+    static std::vector<KeyType> reduce_keys(
+        const std::vector<KeyType>& keys,
+        ValueType KeyType::* value,
+        float tolerance
+    )
+    {
+        if (keys.size() <= 2 || tolerance <= 0.0f)
+            return keys;
+
+        bool allSame = true;
+        for (size_t i = 1; i < keys.size() && allSame; ++i)
+            allSame = get_max_difference(keys[0].*value, keys[i].*value) <= tolerance;
+        if (allSame)
+            return { keys[0] };
+
+        std::vector<KeyType> reducedKeys;
+        reducedKeys.push_back(keys[0]);
+        size_t anchor = 0;
+        while (anchor < keys.size() - 1)
+        {
+            // Find the furthest key which can be used as the next key
+            // without any key between differing too much
+            size_t next = anchor + 1;
+            for (size_t candidate = anchor + 2; candidate < keys.size(); ++candidate)
+            {
+                const KeyType& from = keys[anchor];
+                const KeyType& to = keys[candidate];
+                bool fits = true;
+                for (size_t i = anchor + 1; i < candidate && fits; ++i)
+                {
+                    const float amount = (keys[i].time - from.time) / (to.time - from.time);
+                    const ValueType interpolated = interpolate(from.*value, to.*value, amount);
+                    fits = get_max_difference(interpolated, keys[i].*value) <= tolerance;
+                }
+                if (!fits)
+                    break;
+                next = candidate;
+            }
+            reducedKeys.push_back(keys[next]);
+            anchor = next;
+        }
+        return reducedKeys;
+    }
+
+    KeyframeAnimationData reduce_keyframes(
+        const KeyframeAnimationData& animationData,
+        const AnimationCompression& compression
+    )
+    {
+        KeyframeAnimationData reducedData;
+        reducedData.length = animationData.length;
+        reducedData.name = animationData.name;
+        reducedData.keyframes.resize(animationData.keyframes.size());
+        for (size_t i = 0; i < animationData.keyframes.size(); ++i)
+        {
+            const JointAnimationData& jointAnimData = animationData.keyframes[i];
+            JointAnimationData& reducedJointAnimData = reducedData.keyframes[i];
+            reducedJointAnimData.translations = reduce_keys(
+                jointAnimData.translations,
+                &TranslationKey::translation,
+                compression.translationTolerance
+            );
+            reducedJointAnimData.rotations = reduce_keys(
+                jointAnimData.rotations,
+                &RotationKey::rotation,
+                compression.rotationTolerance
+            );
+            reducedJointAnimData.scales = reduce_keys(
+                jointAnimData.scales,
+                &ScaleKey::scale,
+                compression.scaleTolerance
+            );
+        }
+        return reducedData;
+    }
+
+
+    void blend_poses(
+        const JointPose* pFromPoses,
+        const JointPose* pToPoses,
+        float weight,
+        JointMask jointMask,
+        JointPose* pOutPoses,
+        size_t jointCount
+    )
+    {
+        for (size_t i = 0; i < jointCount; ++i)
+        {
+            const bool masked = i >= joint_mask_max_joints || (jointMask & (static_cast<JointMask>(1) << i));
+            if (!masked)
+                continue;
+            const JointPose& from = pFromPoses[i];
+            const JointPose& to = pToPoses[i];
+            JointPose& out = pOutPoses[i];
+            out.translation = from.translation.lerp(to.translation, weight);
+            out.rotation = from.rotation.slerp(to.rotation, weight);
+            out.scale = from.scale.lerp(to.scale, weight);
+        }
+    }
+
+    void add_additive_poses(
+        JointPose* pPoses,
+        const JointPose* pAdditivePoses,
+        const JointPose* pReferencePoses,
+        float weight,
+        JointMask jointMask,
+        size_t jointCount
+    )
+    {
+        const Quaternion identity;
+        for (size_t i = 0; i < jointCount && i < joint_mask_max_joints; ++i)
+        {
+            if (!(jointMask & (static_cast<JointMask>(1) << i)))
+                continue;
+
+            JointPose& pose = pPoses[i];
+            const JointPose& additive = pAdditivePoses[i];
+            const JointPose& reference = pReferencePoses[i];
+
+            pose.translation = pose.translation + (additive.translation - reference.translation) * weight;
+
+            // Rotation from the reference to the additive pose
+            const Quaternion deltaRotation = additive.rotation.normalize() * reference.rotation.normalize().conjugate();
+            pose.rotation = identity.slerp(deltaRotation, weight) * pose.rotation;
+
+            const Vector3f deltaScale(
+                reference.scale.x != 0.0f ? additive.scale.x / reference.scale.x : 1.0f,
+                reference.scale.y != 0.0f ? additive.scale.y / reference.scale.y : 1.0f,
+                reference.scale.z != 0.0f ? additive.scale.z / reference.scale.z : 1.0f
+            );
+            pose.scale = pose.scale * Vector3f(1.0f, 1.0f, 1.0f).lerp(deltaScale, weight);
+        }
+    }
+}
@@ -36,13 +36,63 @@ namespace platypus
         Quaternion rotation;
     };
 
-    // TODO: Add scale keys
+    struct ScaleKey
+    {
+        float time = 0.0f;
+        Vector3f scale;
+    };
+
     struct JointAnimationData
     {
         std::vector<TranslationKey> translations;
         std::vector<RotationKey> rotations;
+        std::vector<ScaleKey> scales;
+    };
+
+    // Interpolated local transform of a single joint at some point of an animation
+    struct JointPose
+    {
+        Vector3f translation;
+        Quaternion rotation;
+        Vector3f scale = Vector3f(1.0f, 1.0f, 1.0f);
+    };
+
+    // Keyframe indices of a joint found when sampling the previous time.
+    // Since animation time usually advances only a little between samples,
+    // these can be checked first instead of searching the keys again.
+    struct KeyframeCursor
+    {
+        uint32_t translation = 0;
+        uint32_t rotation = 0;
+        uint32_t scale = 0;
     };
 
+    // Quaternion quantized using the "smallest three" method: the largest component
+    // is dropped and recalculated from the other three which are stored in 15 bits each.
+    // The dropped component's index is stored in the top bits of the first two values.
+    struct PackedQuaternion
+    {
+        uint16_t data[3] = { 0, 0, 0 };
+    };
+
+    // Lossy compression applied when creating SkeletalAnimationData
+    struct AnimationCompression
+    {
+        // Keys which can be interpolated from the remaining keys within these
+        // tolerances get removed. 0 = keep all keys
+        float translationTolerance = 0.0f;
+        float rotationTolerance = 0.0f; // Max difference of quaternion components
+        float scaleTolerance = 0.0f;
+        // Store rotation keys as PackedQuaternions (6 bytes instead of 16)
+        bool quantizeRotations = false;
+    };
+
+    // Bit per joint telling which joints a pose blend affects.
+    // NOTE: Limits skeletons using masks to 64 joints!
+    typedef uint64_t JointMask;
+    constexpr JointMask joint_mask_all = ~static_cast<JointMask>(0);
+    constexpr size_t joint_mask_max_joints = sizeof(JointMask) * 8;
+
     struct KeyframeAnimationData
     {
         float length = 0.0f;
@@ -58,4 +108,39 @@ namespace platypus
         Pose bindPose;
         std::vector<KeyframeAnimationData> animations;
     };
+
+
+    PackedQuaternion pack_quaternion(const Quaternion& quaternion);
+    Quaternion unpack_quaternion(const PackedQuaternion& packedQuaternion);
+
+    // Returns copy of the animation having keys removed according to the
+    // compression's tolerances. First and last keys of each channel are always kept
+    // unless all of the channel's keys are the same, in which case only a single key is kept.
+    KeyframeAnimationData reduce_keyframes(
+        const KeyframeAnimationData& animationData,
+        const AnimationCompression& compression
+    );
+
+    // Interpolates from pFromPoses towards pToPoses for joints included in jointMask.
+    // Joints not included in the mask are left untouched in pOutPoses.
+    // NOTE: pOutPoses may be the same as pFromPoses or pToPoses
+    void blend_poses(
+        const JointPose* pFromPoses,
+        const JointPose* pToPoses,
+        float weight,
+        JointMask jointMask,
+        JointPose* pOutPoses,
+        size_t jointCount
+    );
+
+    // Adds the difference between pAdditivePoses and pReferencePoses on top
+    // of pPoses for joints included in jointMask.
+    void add_additive_poses(
+        JointPose* pPoses,
+        const JointPose* pAdditivePoses,
+        const JointPose* pReferencePoses,
+        float weight,
+        JointMask jointMask,
+        size_t jointCount
+    );
 }
@@ -0,0 +1,644 @@
+#include "BVH.hpp"
+#include "platypus/core/Debug.hpp"
+#include <algorithm>
+#include <cmath>
+
+
+namespace platypus
+{
+    static const size_t s_sahBinCount = 12;
+    // If more leaves than this fraction of all leaves are dirty,
+    // refit updates all nodes instead of walking up from each dirty leaf
+    static const float s_fullRefitThreshold = 0.25f;
+    // Queries use fixed size traversal stacks so the tree's depth is limited.
+    // Past this depth nodes get split at the median instead of using SAH.
+    static const uint32_t s_maxSAHDepth = 32;
+
+    static inline float get_axis(const Vector3f& v, int axis)
+    {
+        return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+    }
+
+    static inline void grow_aabb(AABB& aabb, const AABB& other)
+    {
+        aabb.min.x = std::min(aabb.min.x, other.min.x);
+        aabb.min.y = std::min(aabb.min.y, other.min.y);
+        aabb.min.z = std::min(aabb.min.z, other.min.z);
+        aabb.max.x = std::max(aabb.max.x, other.max.x);
+        aabb.max.y = std::max(aabb.max.y, other.max.y);
+        aabb.max.z = std::max(aabb.max.z, other.max.z);
+    }
+
+    static inline void grow_aabb(AABB& aabb, const Vector3f& point)
+    {
+        aabb.min.x = std::min(aabb.min.x, point.x);
+        aabb.min.y = std::min(aabb.min.y, point.y);
+        aabb.min.z = std::min(aabb.min.z, point.z);
+        aabb.max.x = std::max(aabb.max.x, point.x);
+        aabb.max.y = std::max(aabb.max.y, point.y);
+        aabb.max.z = std::max(aabb.max.z, point.z);
+    }
+
+    static inline float get_surface_area(const AABB& aabb)
+    {
+        if (!aabb.isValid())
+            return 0.0f;
+        const Vector3f size = aabb.max - aabb.min;
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    static inline bool aabbs_equal(const AABB& a, const AABB& b)
+    {
+        return a.min.x == b.min.x && a.min.y == b.min.y && a.min.z == b.min.z &&
+            a.max.x == b.max.x && a.max.y == b.max.y && a.max.z == b.max.z;
+    }
+
+    static inline bool aabbs_overlap(const AABB& a, const AABB& b)
+    {
+        return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+            a.min.y <= b.max.y && a.max.y >= b.min.y &&
+            a.min.z <= b.max.z && a.max.z >= b.min.z;
+    }
+
+    static inline bool aabb_sphere_overlap(const AABB& aabb, const BoundingSphere& sphere)
+    {
+        const float x = std::max(aabb.min.x, std::min(sphere.center.x, aabb.max.x)) - sphere.center.x;
+        const float y = std::max(aabb.min.y, std::min(sphere.center.y, aabb.max.y)) - sphere.center.y;
+        const float z = std::max(aabb.min.z, std::min(sphere.center.z, aabb.max.z)) - sphere.center.z;
+        return x * x + y * y + z * z <= sphere.radius * sphere.radius;
+    }
+
+    // Slab test. Returns false if the ray misses or the entry point is further than maxDistance.
+    static inline bool ray_aabb_intersect(
+        const Vector3f& origin,
+        const Vector3f& inverseDirection,
+        float maxDistance,
+        const AABB& aabb,
+        float& outDistance
+    )
+    {
+        const float tx0 = (aabb.min.x - origin.x) * inverseDirection.x;
+        const float tx1 = (aabb.max.x - origin.x) * inverseDirection.x;
+        const float ty0 = (aabb.min.y - origin.y) * inverseDirection.y;
+        const float ty1 = (aabb.max.y - origin.y) * inverseDirection.y;
+        const float tz0 = (aabb.min.z - origin.z) * inverseDirection.z;
+        const float tz1 = (aabb.max.z - origin.z) * inverseDirection.z;
+
+        const float tEnter = std::max(std::max(std::min(tx0, tx1), std::min(ty0, ty1)), std::max(std::min(tz0, tz1), 0.0f));
+        const float tExit = std::min(std::min(std::max(tx0, tx1), std::max(ty0, ty1)), std::min(std::max(tz0, tz1), maxDistance));
+        // NOTE: NaNs (ray exactly on a slab's plane with 0 direction) make both comparisons fail -> treated as miss
+        if (!(tEnter <= tExit))
+            return false;
+
+        outDistance = tEnter;
+        return true;
+    }
+
+
+    void BVH::build(const AABB* pItemBounds, const uint32_t* pItemIDs, size_t count)
+    {
+        clear();
+        if (count == 0)
+            return;
+
+        if (count > (size_t)UINT32_MAX / 2)
+        {
+            Debug::log(
+                "Too many items: " + std::to_string(count),
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            PLATYPUS_ASSERT(false);
+            return;
+        }
+
+        _itemBounds.assign(pItemBounds, pItemBounds + count);
+        _itemIDs.assign(pItemIDs, pItemIDs + count);
+        _itemLeaves.resize(count, 0);
+        _itemOrder.resize(count);
+
+        // Items get reordered into leaf order while subdividing
+        //  -> each node's items are contiguous in memory
+        std::vector<BuildItem> buildItems(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            BuildItem& buildItem = buildItems[i];
+            buildItem.bounds = _itemBounds[i];
+            buildItem.centroid = buildItem.bounds.isValid() ? buildItem.bounds.getCenter() : Vector3f(0, 0, 0);
+            buildItem.itemIndex = (uint32_t)i;
+        }
+
+        _nodes.reserve(count * 2 - 1);
+        _nodeParents.reserve(count * 2 - 1);
+
+        Node root;
+        root.leftOrFirst = 0;
+        root.count = (uint32_t)count;
+        _nodes.push_back(root);
+        _nodeParents.push_back(0);
+
+        std::vector<uint32_t> nodeDepths;
+        nodeDepths.reserve(count * 2 - 1);
+        nodeDepths.push_back(0);
+
+        std::vector<uint32_t> stack;
+        stack.push_back(0);
+        while (!stack.empty())
+        {
+            const uint32_t nodeIndex = stack.back();
+            stack.pop_back();
+            subdivide(nodeIndex, buildItems, nodeDepths, stack);
+        }
+
+        for (size_t i = 0; i < count; ++i)
+            _itemOrder[i] = buildItems[i].itemIndex;
+
+        _leafDirty.resize(_nodes.size(), 0);
+    }
+
+    void BVH::clear()
+    {
+        _nodes.clear();
+        _nodeParents.clear();
+        _itemBounds.clear();
+        _itemIDs.clear();
+        _itemLeaves.clear();
+        _itemOrder.clear();
+        _dirtyLeaves.clear();
+        _leafDirty.clear();
+    }
+
+    void BVH::setItemBounds(size_t itemIndex, const AABB& bounds)
+    {
+        _itemBounds[itemIndex] = bounds;
+        const uint32_t leafIndex = _itemLeaves[itemIndex];
+        if (!_leafDirty[leafIndex])
+        {
+            _leafDirty[leafIndex] = 1;
+            _dirtyLeaves.push_back(leafIndex);
+        }
+    }
+
+    void BVH::refit()
+    {
+        if (_dirtyLeaves.empty())
+            return;
+
+        const size_t leafCount = (_nodes.size() + 1) / 2;
+        if ((float)_dirtyLeaves.size() > (float)leafCount * s_fullRefitThreshold)
+        {
+            // Children always come after their parents
+            // -> single reverse pass updates everything bottom up
+            for (size_t i = _nodes.size(); i > 0; --i)
+            {
+                const uint32_t nodeIndex = (uint32_t)(i - 1);
+                Node& node = _nodes[nodeIndex];
+                if (node.isLeaf())
+                {
+                    updateNodeBounds(nodeIndex);
+                }
+                else
+                {
+                    node.bounds = _nodes[node.leftOrFirst].bounds;
+                    grow_aabb(node.bounds, _nodes[node.leftOrFirst + 1].bounds);
+                }
+            }
+        }
+        else
+        {
+            for (uint32_t leafIndex : _dirtyLeaves)
+            {
+                updateNodeBounds(leafIndex);
+                uint32_t nodeIndex = leafIndex;
+                while (nodeIndex != 0)
+                {
+                    nodeIndex = _nodeParents[nodeIndex];
+                    Node& parent = _nodes[nodeIndex];
+                    AABB bounds = _nodes[parent.leftOrFirst].bounds;
+                    grow_aabb(bounds, _nodes[parent.leftOrFirst + 1].bounds);
+                    // Stop early if nothing changed above this point
+                    if (aabbs_equal(bounds, parent.bounds))
+                        break;
+                    parent.bounds = bounds;
+                }
+            }
+        }
+
+        for (uint32_t leafIndex : _dirtyLeaves)
+            _leafDirty[leafIndex] = 0;
+        _dirtyLeaves.clear();
+    }
+
+    void BVH::queryFrustum(const Frustum& frustum, std::vector<uint32_t>& outItemIDs) const
+    {
+        if (_nodes.empty())
+            return;
+
+        // Tests up to 4 AABBs at a time:
+        //  * items of a leaf
+        //  * children of a node, or grandchildren if the child isn't a leaf
+        //    (child's bounds contain its children's so the child itself can be skipped)
+        // Stack contains only nodes already known to intersect the frustum.
+        // NOTE: Each visited node pushes up to 4 nodes from the next 2 levels
+        //  -> up to 3 of them can be waiting per node on the current path
+        uint32_t stack[64 * 3 + 4];
+        size_t stackSize = 0;
+
+        const AABB* laneBounds[4];
+        uint32_t laneIndices[4];
+        uint32_t insideMask = 0;
+
+        // NOTE: Nodes having only removed items have invalid bounds
+        const Node& root = _nodes[0];
+        if (!root.bounds.isValid())
+            return;
+        laneBounds[0] = &root.bounds;
+        if (test_frustum_aabbs(frustum, laneBounds, 1, insideMask) == 0)
+            return;
+        if (insideMask)
+        {
+            addSubtree(0, outItemIDs);
+            return;
+        }
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0)
+        {
+            const Node& node = _nodes[stack[--stackSize]];
+            if (node.isLeaf())
+            {
+                const uint32_t end = node.leftOrFirst + node.count;
+                uint32_t i = node.leftOrFirst;
+                while (i < end)
+                {
+                    size_t laneCount = 0;
+                    for (; i < end && laneCount < 4; ++i)
+                    {
+                        const uint32_t itemIndex = _itemOrder[i];
+                        if (!_itemBounds[itemIndex].isValid())
+                            continue;
+                        laneBounds[laneCount] = &_itemBounds[itemIndex];
+                        laneIndices[laneCount] = itemIndex;
+                        ++laneCount;
+                    }
+                    const uint32_t visibleMask = test_frustum_aabbs(frustum, laneBounds, laneCount, insideMask);
+                    for (size_t lane = 0; lane < laneCount; ++lane)
+                    {
+                        if (visibleMask & (1u << lane))
+                            outItemIDs.push_back(_itemIDs[laneIndices[lane]]);
+                    }
+                }
+                continue;
+            }
+
+            size_t laneCount = 0;
+            for (uint32_t childIndex = node.leftOrFirst; childIndex < node.leftOrFirst + 2; ++childIndex)
+            {
+                const Node& child = _nodes[childIndex];
+                if (child.isLeaf())
+                {
+                    laneIndices[laneCount++] = childIndex;
+                }
+                else
+                {
+                    laneIndices[laneCount++] = child.leftOrFirst;
+                    laneIndices[laneCount++] = child.leftOrFirst + 1;
+                }
+            }
+            size_t validCount = 0;
+            for (size_t lane = 0; lane < laneCount; ++lane)
+            {
+                const Node& laneNode = _nodes[laneIndices[lane]];
+                if (!laneNode.bounds.isValid())
+                    continue;
+                laneBounds[validCount] = &laneNode.bounds;
+                laneIndices[validCount] = laneIndices[lane];
+                ++validCount;
+            }
+
+            const uint32_t visibleMask = test_frustum_aabbs(frustum, laneBounds, validCount, insideMask);
+            // Pushed in reverse so the nodes get visited left to right
+            for (size_t lane = validCount; lane-- > 0;)
+            {
+                if ((visibleMask & (1u << lane)) == 0)
+                    continue;
+                if (insideMask & (1u << lane))
+                    addSubtree(laneIndices[lane], outItemIDs);
+                else
+                    stack[stackSize++] = laneIndices[lane];
+            }
+        }
+    }
+
+    void BVH::queryAABB(const AABB& aabb, std::vector<uint32_t>& outItemIDs) const
+    {
+        if (_nodes.empty())
+            return;
+
+        uint32_t stack[64];
+        size_t stackSize = 0;
+        stack[stackSize++] = 0;
+        while (stackSize > 0)
+        {
+            const Node& node = _nodes[stack[--stackSize]];
+            if (!aabbs_overlap(node.bounds, aabb))
+                continue;
+
+            if (node.isLeaf())
+            {
+                for (uint32_t i = node.leftOrFirst; i < node.leftOrFirst + node.count; ++i)
+                {
+                    const uint32_t itemIndex = _itemOrder[i];
+                    if (aabbs_overlap(_itemBounds[itemIndex], aabb))
+                        outItemIDs.push_back(_itemIDs[itemIndex]);
+                }
+            }
+            else
+            {
+                stack[stackSize++] = node.leftOrFirst + 1;
+                stack[stackSize++] = node.leftOrFirst;
+            }
+        }
+    }
+
+    void BVH::querySphere(const BoundingSphere& sphere, std::vector<uint32_t>& outItemIDs) const
+    {
+        if (_nodes.empty())
+            return;
+
+        uint32_t stack[64];
+        size_t stackSize = 0;
+        stack[stackSize++] = 0;
+        while (stackSize > 0)
+        {
+            const Node& node = _nodes[stack[--stackSize]];
+            if (!aabb_sphere_overlap(node.bounds, sphere))
+                continue;
+
+            if (node.isLeaf())
+            {
+                for (uint32_t i = node.leftOrFirst; i < node.leftOrFirst + node.count; ++i)
+                {
+                    const uint32_t itemIndex = _itemOrder[i];
+                    if (aabb_sphere_overlap(_itemBounds[itemIndex], sphere))
+                        outItemIDs.push_back(_itemIDs[itemIndex]);
+                }
+            }
+            else
+            {
+                stack[stackSize++] = node.leftOrFirst + 1;
+                stack[stackSize++] = node.leftOrFirst;
+            }
+        }
+    }
+
+    void BVH::queryRay(
+        const Vector3f& origin,
+        const Vector3f& direction,
+        float maxDistance,
+        std::vector<RayQueryHit>& outHits
+    ) const
+    {
+        if (_nodes.empty())
+            return;
+
+        const Vector3f inverseDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+        const size_t firstHit = outHits.size();
+
+        uint32_t stack[64];
+        size_t stackSize = 0;
+        stack[stackSize++] = 0;
+        while (stackSize > 0)
+        {
+            const Node& node = _nodes[stack[--stackSize]];
+            float distance = 0.0f;
+            if (!node.bounds.isValid() || !ray_aabb_intersect(origin, inverseDirection, maxDistance, node.bounds, distance))
+                continue;
+
+            if (node.isLeaf())
+            {
+                for (uint32_t i = node.leftOrFirst; i < node.leftOrFirst + node.count; ++i)
+                {
+                    const uint32_t itemIndex = _itemOrder[i];
+                    const AABB& itemBounds = _itemBounds[itemIndex];
+                    if (itemBounds.isValid() && ray_aabb_intersect(origin, inverseDirection, maxDistance, itemBounds, distance))
+                        outHits.push_back({ _itemIDs[itemIndex], distance });
+                }
+            }
+            else
+            {
+                stack[stackSize++] = node.leftOrFirst + 1;
+                stack[stackSize++] = node.leftOrFirst;
+            }
+        }
+
+        std::sort(
+            outHits.begin() + firstHit,
+            outHits.end(),
+            [](const RayQueryHit& a, const RayQueryHit& b) { return a.distance < b.distance; }
+        );
+    }
+
+    void BVH::subdivide(
+        uint32_t nodeIndex,
+        std::vector<BuildItem>& buildItems,
+        std::vector<uint32_t>& nodeDepths,
+        std::vector<uint32_t>& stack
+    )
+    {
+        const uint32_t first = _nodes[nodeIndex].leftOrFirst;
+        const uint32_t count = _nodes[nodeIndex].count;
+        BuildItem* pItems = buildItems.data() + first;
+
+        AABB bounds;
+        AABB centroidBounds;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (pItems[i].bounds.isValid())
+                grow_aabb(bounds, pItems[i].bounds);
+            grow_aabb(centroidBounds, pItems[i].centroid);
+        }
+        _nodes[nodeIndex].bounds = bounds;
+
+        if (count <= _maxLeafItems)
+        {
+            for (uint32_t i = 0; i < count; ++i)
+                _itemLeaves[pItems[i].itemIndex] = nodeIndex;
+            return;
+        }
+
+        // Binned SAH: find the cheapest split plane among the bin boundaries of all axes.
+        // All axes are binned in the same pass over the items.
+        const uint32_t depth = nodeDepths[nodeIndex];
+        AABB binBounds[3][s_sahBinCount];
+        uint32_t binCounts[3][s_sahBinCount] = { };
+        float axisMins[3];
+        float axisScales[3];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const float axisMin = get_axis(centroidBounds.min, axis);
+            const float axisMax = get_axis(centroidBounds.max, axis);
+            axisMins[axis] = axisMin;
+            axisScales[axis] = axisMax > axisMin ? (float)s_sahBinCount / (axisMax - axisMin) : 0.0f;
+        }
+
+        int bestAxis = -1;
+        size_t bestSplit = 0;
+        if (depth < s_maxSAHDepth)
+        {
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                const BuildItem& item = pItems[i];
+                for (int axis = 0; axis < 3; ++axis)
+                {
+                    const size_t bin = std::min(
+                        s_sahBinCount - 1,
+                        (size_t)((get_axis(item.centroid, axis) - axisMins[axis]) * axisScales[axis])
+                    );
+                    ++binCounts[axis][bin];
+                    if (item.bounds.isValid())
+                        grow_aabb(binBounds[axis][bin], item.bounds);
+                }
+            }
+
+            float bestCost = INFINITY;
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                if (axisScales[axis] == 0.0f)
+                    continue;
+
+                // Sweep from both sides to get the areas and counts left and right of each split
+                float leftAreas[s_sahBinCount - 1];
+                float rightAreas[s_sahBinCount - 1];
+                uint32_t leftCounts[s_sahBinCount - 1];
+                uint32_t rightCounts[s_sahBinCount - 1];
+                AABB leftBounds;
+                AABB rightBounds;
+                uint32_t leftCount = 0;
+                uint32_t rightCount = 0;
+                for (size_t i = 0; i < s_sahBinCount - 1; ++i)
+                {
+                    leftCount += binCounts[axis][i];
+                    grow_aabb(leftBounds, binBounds[axis][i]);
+                    leftCounts[i] = leftCount;
+                    leftAreas[i] = get_surface_area(leftBounds);
+
+                    rightCount += binCounts[axis][s_sahBinCount - 1 - i];
+                    grow_aabb(rightBounds, binBounds[axis][s_sahBinCount - 1 - i]);
+                    rightCounts[s_sahBinCount - 2 - i] = rightCount;
+                    rightAreas[s_sahBinCount - 2 - i] = get_surface_area(rightBounds);
+                }
+
+                for (size_t i = 0; i < s_sahBinCount - 1; ++i)
+                {
+                    if (leftCounts[i] == 0 || rightCounts[i] == 0)
+                        continue;
+                    const float cost = leftCounts[i] * leftAreas[i] + rightCounts[i] * rightAreas[i];
+                    if (cost < bestCost)
+                    {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestSplit = i;
+                    }
+                }
+            }
+        }
+
+        uint32_t leftCount = 0;
+        if (bestAxis >= 0)
+        {
+            const float axisMin = axisMins[bestAxis];
+            const float scale = axisScales[bestAxis];
+            BuildItem* pMiddle = std::partition(
+                pItems,
+                pItems + count,
+                [&](const BuildItem& item)
+                {
+                    const size_t bin = std::min(
+                        s_sahBinCount - 1,
+                        (size_t)((get_axis(item.centroid, bestAxis) - axisMin) * scale)
+                    );
+                    return bin <= bestSplit;
+                }
+            );
+            leftCount = (uint32_t)(pMiddle - pItems);
+        }
+
+        // Too deep or all centroids at the same point
+        // -> split at the median of the longest axis to keep the tree balanced
+        if (leftCount == 0 || leftCount == count)
+        {
+            const Vector3f size = centroidBounds.max - centroidBounds.min;
+            const int axis = size.x >= size.y && size.x >= size.z ? 0 : (size.y >= size.z ? 1 : 2);
+            leftCount = count / 2;
+            std::nth_element(
+                pItems,
+                pItems + leftCount,
+                pItems + count,
+                [axis](const BuildItem& a, const BuildItem& b)
+                {
+                    return get_axis(a.centroid, axis) < get_axis(b.centroid, axis);
+                }
+            );
+        }
+
+        const uint32_t leftIndex = (uint32_t)_nodes.size();
+        Node left;
+        left.leftOrFirst = first;
+        left.count = leftCount;
+        Node right;
+        right.leftOrFirst = first + leftCount;
+        right.count = count - leftCount;
+        _nodes.push_back(left);
+        _nodes.push_back(right);
+        _nodeParents.push_back(nodeIndex);
+        _nodeParents.push_back(nodeIndex);
+        nodeDepths.push_back(depth + 1);
+        nodeDepths.push_back(depth + 1);
+
+        Node& node = _nodes[nodeIndex];
+        node.leftOrFirst = leftIndex;
+        node.count = 0;
+
+        stack.push_back(leftIndex + 1);
+        stack.push_back(leftIndex);
+    }
+
+    void BVH::updateNodeBounds(uint32_t nodeIndex)
+    {
+        Node& node = _nodes[nodeIndex];
+        AABB bounds;
+        for (uint32_t i = node.leftOrFirst; i < node.leftOrFirst + node.count; ++i)
+        {
+            const uint32_t itemIndex = _itemOrder[i];
+            if (_itemBounds[itemIndex].isValid())
+                grow_aabb(bounds, _itemBounds[itemIndex]);
+        }
+        node.bounds = bounds;
+    }
+
+    void BVH::addSubtree(uint32_t nodeIndex, std::vector<uint32_t>& outItemIDs) const
+    {
+        uint32_t stack[64];
+        size_t stackSize = 0;
+        stack[stackSize++] = nodeIndex;
+        while (stackSize > 0)
+        {
+            const Node& node = _nodes[stack[--stackSize]];
+            if (node.isLeaf())
+            {
+                for (uint32_t i = node.leftOrFirst; i < node.leftOrFirst + node.count; ++i)
+                {
+                    const uint32_t itemIndex = _itemOrder[i];
+                    if (_itemBounds[itemIndex].isValid())
+                        outItemIDs.push_back(_itemIDs[itemIndex]);
+                }
+            }
+            else
+            {
+                stack[stackSize++] = node.leftOrFirst + 1;
+                stack[stackSize++] = node.leftOrFirst;
+            }
+        }
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Bounds.hpp"
+#include <vector>
+#include <cstdint>
+
+
+namespace platypus
+{
+    struct RayQueryHit
+    {
+        uint32_t itemID = 0;
+        // Distance along the ray where it enters the item's bounds
+        float distance = 0.0f;
+    };
+
+    // Bounding volume hierarchy of AABBs with user provided uint32_t item IDs.
+    //
+    // build() creates the tree from scratch using binned SAH. Moving items can be
+    // updated with setItemBounds() + refit() which only updates the bounds of the
+    // nodes above the changed items (or all nodes in a single pass if many items changed),
+    // but the tree's quality degrades over time if items move a lot
+    // -> rebuild every now and then.
+    //
+    // Nodes are stored so that children always come after their parent and
+    // both children of a node are next to each other.
+    class BVH
+    {
+    public:
+        struct Node
+        {
+            AABB bounds;
+            // Leaf: index to first item in _itemOrder, otherwise index to left child (right = left + 1)
+            uint32_t leftOrFirst = 0;
+            // Item count if leaf, 0 otherwise
+            uint32_t count = 0;
+
+            inline bool isLeaf() const { return count > 0; }
+        };
+
+    private:
+        struct BuildItem
+        {
+            AABB bounds;
+            Vector3f centroid;
+            uint32_t itemIndex = 0;
+        };
+
+        std::vector<Node> _nodes;
+        std::vector<uint32_t> _nodeParents;
+
+        // Indexed by item index (the order items were given to build())
+        std::vector<AABB> _itemBounds;
+        std::vector<uint32_t> _itemIDs;
+        std::vector<uint32_t> _itemLeaves;
+        // Item indices in leaf order
+        std::vector<uint32_t> _itemOrder;
+
+        std::vector<uint32_t> _dirtyLeaves;
+        std::vector<uint8_t> _leafDirty;
+
+        size_t _maxLeafItems = 4;
+
+    public:
+        BVH() = default;
+        BVH(const BVH& other) = delete;
+
+        void build(const AABB* pItemBounds, const uint32_t* pItemIDs, size_t count);
+        void clear();
+
+        // Changes the bounds of item at itemIndex (NOT itemID).
+        // Tree's nodes aren't updated until calling refit().
+        // Items with invalid bounds are never returned by queries
+        //  -> can be used to remove items without rebuilding.
+        void setItemBounds(size_t itemIndex, const AABB& bounds);
+        void refit();
+
+        // Query results' item IDs get appended to the out vectors
+        void queryFrustum(const Frustum& frustum, std::vector<uint32_t>& outItemIDs) const;
+        void queryAABB(const AABB& aabb, std::vector<uint32_t>& outItemIDs) const;
+        void querySphere(const BoundingSphere& sphere, std::vector<uint32_t>& outItemIDs) const;
+        // Hits get sorted by distance
+        void queryRay(
+            const Vector3f& origin,
+            const Vector3f& direction,
+            float maxDistance,
+            std::vector<RayQueryHit>& outHits
+        ) const;
+
+        inline bool empty() const { return _nodes.empty(); }
+        inline size_t getItemCount() const { return _itemIDs.size(); }
+        inline size_t getNodeCount() const { return _nodes.size(); }
+        inline const std::vector<Node>& getNodes() const { return _nodes; }
+        inline const AABB& getItemBounds(size_t itemIndex) const { return _itemBounds[itemIndex]; }
+        inline uint32_t getItemID(size_t itemIndex) const { return _itemIDs[itemIndex]; }
+        inline void setMaxLeafItems(size_t count) { _maxLeafItems = count > 0 ? count : 1; }
+
+    private:
+        void subdivide(
+            uint32_t nodeIndex,
+            std::vector<BuildItem>& buildItems,
+            std::vector<uint32_t>& nodeDepths,
+            std::vector<uint32_t>& stack
+        );
+        void updateNodeBounds(uint32_t nodeIndex);
+        // Adds all items under the node without testing
+        void addSubtree(uint32_t nodeIndex, std::vector<uint32_t>& outItemIDs) const;
+    };
+}
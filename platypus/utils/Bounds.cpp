@@ -0,0 +1,261 @@
+#include "Bounds.hpp"
+#include "platypus/graphics/Buffers.hpp"
+#include "platypus/core/Debug.hpp"
+#include "platypus/Common.h"
+#include <cmath>
+#include <algorithm>
+
+#ifdef PLATYPUS_MATHS_SSE
+    #include <immintrin.h>
+#endif
+
+
+namespace platypus
+{
+    // Finds byte offset of the Float3 POSITION element in the layout's vertices
+    static bool get_position_offset(const VertexBufferLayout& layout, size_t& outOffset)
+    {
+        size_t offset = 0;
+        for (const VertexBufferElement& element : layout.getElements())
+        {
+            if (element.getAttribType() == VertexAttributeType::POSITION)
+            {
+                if (element.getDataType() != ShaderDataType::Float3)
+                    return false;
+
+                outOffset = offset;
+                return true;
+            }
+            offset += get_shader_datatype_size(element.getDataType());
+        }
+        return false;
+    }
+
+    AABB create_aabb(const void* pPositions, size_t vertexCount, size_t stride)
+    {
+        AABB aabb;
+        const PE_ubyte* pData = reinterpret_cast<const PE_ubyte*>(pPositions);
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            float position[3];
+            memcpy(position, pData + i * stride, sizeof(float) * 3);
+            aabb.min.x = std::min(aabb.min.x, position[0]);
+            aabb.min.y = std::min(aabb.min.y, position[1]);
+            aabb.min.z = std::min(aabb.min.z, position[2]);
+            aabb.max.x = std::max(aabb.max.x, position[0]);
+            aabb.max.y = std::max(aabb.max.y, position[1]);
+            aabb.max.z = std::max(aabb.max.z, position[2]);
+        }
+        return aabb;
+    }
+
+    AABB create_aabb(
+        const VertexBufferLayout& layout,
+        const void* pVertexData,
+        size_t vertexDataSize
+    )
+    {
+        size_t positionOffset = 0;
+        if (!get_position_offset(layout, positionOffset) || layout.getStride() <= 0)
+        {
+            Debug::log(
+                "Vertex buffer layout has no Float3 positions",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_WARNING
+            );
+            return create_aabb(nullptr, 0, 0);
+        }
+        const size_t stride = (size_t)layout.getStride();
+        const size_t vertexCount = vertexDataSize / stride;
+        return create_aabb(
+            reinterpret_cast<const PE_ubyte*>(pVertexData) + positionOffset,
+            vertexCount,
+            stride
+        );
+    }
+
+    BoundingSphere create_bounding_sphere(
+        const AABB& aabb,
+        const VertexBufferLayout& layout,
+        const void* pVertexData,
+        size_t vertexDataSize
+    )
+    {
+        BoundingSphere sphere;
+        size_t positionOffset = 0;
+        if (!aabb.isValid() || !get_position_offset(layout, positionOffset) || layout.getStride() <= 0)
+            return sphere;
+
+        sphere.center = aabb.getCenter();
+        const size_t stride = (size_t)layout.getStride();
+        const size_t vertexCount = vertexDataSize / stride;
+        const PE_ubyte* pData = reinterpret_cast<const PE_ubyte*>(pVertexData) + positionOffset;
+        float maxDistanceSquared = 0.0f;
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            float position[3];
+            memcpy(position, pData + i * stride, sizeof(float) * 3);
+            const float x = position[0] - sphere.center.x;
+            const float y = position[1] - sphere.center.y;
+            const float z = position[2] - sphere.center.z;
+            maxDistanceSquared = std::max(maxDistanceSquared, x * x + y * y + z * z);
+        }
+        sphere.radius = std::sqrt(maxDistanceSquared);
+        return sphere;
+    }
+
+    Frustum create_frustum(const Matrix4f& projectionViewMatrix)
+    {
+        const Matrix4f& m = projectionViewMatrix;
+        // Matrices are column major -> row i is m[i], m[i + 4], m[i + 8], m[i + 12]
+        Vector4f rows[4];
+        for (int i = 0; i < 4; ++i)
+            rows[i] = Vector4f(m[i], m[i + 1 * 4], m[i + 2 * 4], m[i + 3 * 4]);
+
+        Frustum frustum;
+        frustum.planes[0] = rows[3] + rows[0]; // left
+        frustum.planes[1] = rows[3] - rows[0]; // right
+        frustum.planes[2] = rows[3] + rows[1]; // bottom
+        frustum.planes[3] = rows[3] - rows[1]; // top
+        frustum.planes[4] = rows[3] + rows[2]; // near
+        frustum.planes[5] = rows[3] - rows[2]; // far
+
+        for (Vector4f& plane : frustum.planes)
+        {
+            const float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+            if (length > 0.0f)
+                plane = plane * (1.0f / length);
+        }
+        return frustum;
+    }
+
+    void transform_aabb(
+        const Matrix4f& matrix,
+        const AABB& aabb,
+        Vector3f& outCenter,
+        Vector3f& outExtents
+    )
+    {
+        const Vector3f center = aabb.getCenter();
+        const Vector3f extents = aabb.getExtents();
+    #ifdef PLATYPUS_MATHS_SSE
+        const float* pMatrix = matrix.getRawArray();
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        const __m128 c0 = _mm_loadu_ps(pMatrix);
+        const __m128 c1 = _mm_loadu_ps(pMatrix + 4);
+        const __m128 c2 = _mm_loadu_ps(pMatrix + 8);
+        const __m128 c3 = _mm_loadu_ps(pMatrix + 12);
+
+        __m128 worldCenter = _mm_add_ps(c3, _mm_mul_ps(c0, _mm_set1_ps(center.x)));
+        worldCenter = _mm_add_ps(worldCenter, _mm_mul_ps(c1, _mm_set1_ps(center.y)));
+        worldCenter = _mm_add_ps(worldCenter, _mm_mul_ps(c2, _mm_set1_ps(center.z)));
+
+        // Extents get projected on each axis using the absolute values of the rotation/scale part
+        __m128 worldExtents = _mm_mul_ps(_mm_andnot_ps(signMask, c0), _mm_set1_ps(extents.x));
+        worldExtents = _mm_add_ps(worldExtents, _mm_mul_ps(_mm_andnot_ps(signMask, c1), _mm_set1_ps(extents.y)));
+        worldExtents = _mm_add_ps(worldExtents, _mm_mul_ps(_mm_andnot_ps(signMask, c2), _mm_set1_ps(extents.z)));
+
+        float results[8];
+        _mm_storeu_ps(results, worldCenter);
+        _mm_storeu_ps(results + 4, worldExtents);
+        outCenter = Vector3f(results[0], results[1], results[2]);
+        outExtents = Vector3f(results[4], results[5], results[6]);
+    #else
+        const Matrix4f& m = matrix;
+        outCenter = Vector3f(
+            m[0] * center.x + m[4] * center.y + m[8] * center.z + m[12],
+            m[1] * center.x + m[5] * center.y + m[9] * center.z + m[13],
+            m[2] * center.x + m[6] * center.y + m[10] * center.z + m[14]
+        );
+        outExtents = Vector3f(
+            std::abs(m[0]) * extents.x + std::abs(m[4]) * extents.y + std::abs(m[8]) * extents.z,
+            std::abs(m[1]) * extents.x + std::abs(m[5]) * extents.y + std::abs(m[9]) * extents.z,
+            std::abs(m[2]) * extents.x + std::abs(m[6]) * extents.y + std::abs(m[10]) * extents.z
+        );
+    #endif
+    }
+
+    uint32_t test_frustum_aabbs(
+        const Frustum& frustum,
+        const AABB* const* pAABBs,
+        size_t count,
+        uint32_t& outInsideMask
+    )
+    {
+        PLATYPUS_ASSERT(count <= 4);
+        outInsideMask = 0;
+        if (count == 0)
+            return 0;
+
+    #ifdef PLATYPUS_MATHS_SSE
+        // Unused lanes duplicate the first AABB and get masked out
+        const AABB* lanes[4];
+        for (size_t i = 0; i < 4; ++i)
+            lanes[i] = pAABBs[i < count ? i : 0];
+
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 minX = _mm_setr_ps(lanes[0]->min.x, lanes[1]->min.x, lanes[2]->min.x, lanes[3]->min.x);
+        const __m128 minY = _mm_setr_ps(lanes[0]->min.y, lanes[1]->min.y, lanes[2]->min.y, lanes[3]->min.y);
+        const __m128 minZ = _mm_setr_ps(lanes[0]->min.z, lanes[1]->min.z, lanes[2]->min.z, lanes[3]->min.z);
+        const __m128 maxX = _mm_setr_ps(lanes[0]->max.x, lanes[1]->max.x, lanes[2]->max.x, lanes[3]->max.x);
+        const __m128 maxY = _mm_setr_ps(lanes[0]->max.y, lanes[1]->max.y, lanes[2]->max.y, lanes[3]->max.y);
+        const __m128 maxZ = _mm_setr_ps(lanes[0]->max.z, lanes[1]->max.z, lanes[2]->max.z, lanes[3]->max.z);
+        const __m128 cx = _mm_mul_ps(_mm_add_ps(minX, maxX), half);
+        const __m128 cy = _mm_mul_ps(_mm_add_ps(minY, maxY), half);
+        const __m128 cz = _mm_mul_ps(_mm_add_ps(minZ, maxZ), half);
+        const __m128 ex = _mm_mul_ps(_mm_sub_ps(maxX, minX), half);
+        const __m128 ey = _mm_mul_ps(_mm_sub_ps(maxY, minY), half);
+        const __m128 ez = _mm_mul_ps(_mm_sub_ps(maxZ, minZ), half);
+
+        const __m128 zero = _mm_setzero_ps();
+        __m128 outside = zero;
+        __m128 intersects = zero;
+        for (const Vector4f& plane : frustum.planes)
+        {
+            __m128 distance = _mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(plane.x)), _mm_set1_ps(plane.w));
+            distance = _mm_add_ps(distance, _mm_mul_ps(cy, _mm_set1_ps(plane.y)));
+            distance = _mm_add_ps(distance, _mm_mul_ps(cz, _mm_set1_ps(plane.z)));
+
+            __m128 radius = _mm_mul_ps(ex, _mm_set1_ps(std::abs(plane.x)));
+            radius = _mm_add_ps(radius, _mm_mul_ps(ey, _mm_set1_ps(std::abs(plane.y))));
+            radius = _mm_add_ps(radius, _mm_mul_ps(ez, _mm_set1_ps(std::abs(plane.z))));
+
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+            intersects = _mm_or_ps(intersects, _mm_cmplt_ps(_mm_sub_ps(distance, radius), zero));
+        }
+
+        const uint32_t countMask = (1u << count) - 1u;
+        const uint32_t outsideMask = (uint32_t)_mm_movemask_ps(outside);
+        const uint32_t intersectsMask = (uint32_t)_mm_movemask_ps(intersects);
+        outInsideMask = ~intersectsMask & countMask;
+        return ~outsideMask & countMask;
+    #else
+        uint32_t visibleMask = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Vector3f center = pAABBs[i]->getCenter();
+            const Vector3f extents = pAABBs[i]->getExtents();
+            bool outside = false;
+            bool intersects = false;
+            for (const Vector4f& plane : frustum.planes)
+            {
+                const float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+                const float radius = std::abs(plane.x) * extents.x + std::abs(plane.y) * extents.y + std::abs(plane.z) * extents.z;
+                if (distance + radius < 0.0f)
+                {
+                    outside = true;
+                    break;
+                }
+                if (distance - radius < 0.0f)
+                    intersects = true;
+            }
+            if (outside)
+                continue;
+            visibleMask |= 1u << i;
+            if (!intersects)
+                outInsideMask |= 1u << i;
+        }
+        return visibleMask;
+    #endif
+    }
+}
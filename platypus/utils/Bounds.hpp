@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Maths.hpp"
+#include <cstdint>
+#include <cmath>
+
+
+namespace platypus
+{
+    class VertexBufferLayout;
+
+    // Default constructed AABB is empty (invalid) until points are added to it
+    struct AABB
+    {
+        Vector3f min = Vector3f(INFINITY, INFINITY, INFINITY);
+        Vector3f max = Vector3f(-INFINITY, -INFINITY, -INFINITY);
+
+        inline Vector3f getCenter() const { return (min + max) * 0.5f; }
+        inline Vector3f getExtents() const { return (max - min) * 0.5f; }
+        inline bool isValid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+    };
+
+    struct BoundingSphere
+    {
+        Vector3f center;
+        float radius = 0.0f;
+    };
+
+    // Planes are stored as (normal, distance) with normals pointing inside the frustum.
+    // Order: left, right, bottom, top, near, far
+    struct Frustum
+    {
+        Vector4f planes[6];
+    };
+
+    // pPositions points to the first vertex's position (3 floats),
+    // stride is the byte offset between consecutive vertices' positions.
+    AABB create_aabb(const void* pPositions, size_t vertexCount, size_t stride);
+    // Uses the POSITION element of the layout.
+    // Returns invalid AABB if the layout has no Float3 positions.
+    AABB create_aabb(
+        const VertexBufferLayout& layout,
+        const void* pVertexData,
+        size_t vertexDataSize
+    );
+
+    // Sphere around the aabb's center containing all the positions
+    BoundingSphere create_bounding_sphere(
+        const AABB& aabb,
+        const VertexBufferLayout& layout,
+        const void* pVertexData,
+        size_t vertexDataSize
+    );
+
+    // Extracts the planes from combined projection and view matrix.
+    // NOTE: Near plane is taken as if clip space z was [-w, w] which is a bit
+    // conservative for projections using [0, w] (Vulkan style)
+    Frustum create_frustum(const Matrix4f& projectionViewMatrix);
+
+    // World space center and half extents of the aabb transformed by matrix
+    void transform_aabb(
+        const Matrix4f& matrix,
+        const AABB& aabb,
+        Vector3f& outCenter,
+        Vector3f& outExtents
+    );
+
+    // Tests up to 4 AABBs against the frustum at once using SSE if available.
+    // Returns mask where bit i is set if pAABBs[i] is at least partially inside the frustum.
+    // Bit i of outInsideMask is set if pAABBs[i] is completely inside the frustum.
+    // NOTE: The AABBs have to be valid
+    uint32_t test_frustum_aabbs(
+        const Frustum& frustum,
+        const AABB* const* pAABBs,
+        size_t count,
+        uint32_t& outInsideMask
+    );
+}
@@ -0,0 +1,227 @@
+#include "Compression.hpp"
+#include <cstdint>
+#include <cstring>
+
+
+namespace platypus
+{
+    // LZ4 block format:
+    //  Sequence = token, [literal length bytes], literals, match offset (2 bytes LE), [match length bytes]
+    //  token's high 4 bits = literal length, low 4 bits = match length - s_minMatch.
+    //  15 means that the length continues in the following bytes (each 255 means more follows).
+    //  The last sequence has only literals.
+    static const size_t s_minMatch = 4;
+    // The last match has to start at least this many bytes before the end
+    static const size_t s_matchFindLimit = 12;
+    // The last bytes are always literals
+    static const size_t s_lastLiterals = 5;
+    static const size_t s_maxOffset = 65535;
+    static const uint32_t s_hashLog = 16;
+
+    static inline uint32_t read_u32(const uint8_t* pData)
+    {
+        uint32_t value = 0;
+        memcpy(&value, pData, sizeof(uint32_t));
+        return value;
+    }
+
+    static inline uint32_t hash_sequence(uint32_t sequence)
+    {
+        return (sequence * 2654435761U) >> (32 - s_hashLog);
+    }
+
+    static inline uint8_t* write_length(uint8_t* pOut, size_t length)
+    {
+        while (length >= 255)
+        {
+            *pOut++ = 255;
+            length -= 255;
+        }
+        *pOut++ = static_cast<uint8_t>(length);
+        return pOut;
+    }
+
+    static uint8_t* write_sequence(
+        uint8_t* pOut,
+        const uint8_t* pLiterals,
+        size_t literalLength,
+        size_t offset,
+        size_t matchLength
+    )
+    {
+        uint8_t* pToken = pOut++;
+        uint8_t token = 0;
+        if (literalLength >= 15)
+        {
+            token = 15 << 4;
+            pOut = write_length(pOut, literalLength - 15);
+        }
+        else
+        {
+            token = static_cast<uint8_t>(literalLength << 4);
+        }
+        if (literalLength > 0)
+            memcpy(pOut, pLiterals, literalLength);
+        pOut += literalLength;
+
+        // Last sequence has only literals
+        if (matchLength > 0)
+        {
+            *pOut++ = static_cast<uint8_t>(offset & 0xFF);
+            *pOut++ = static_cast<uint8_t>((offset >> 8) & 0xFF);
+
+            const size_t matchLengthCode = matchLength - s_minMatch;
+            if (matchLengthCode >= 15)
+            {
+                token |= 15;
+                pOut = write_length(pOut, matchLengthCode - 15);
+            }
+            else
+            {
+                token |= static_cast<uint8_t>(matchLengthCode);
+            }
+        }
+        *pToken = token;
+        return pOut;
+    }
+
+    std::vector<char> lz4_compress(const char* pData, size_t dataSize)
+    {
+        // Worst case: everything as literals
+        std::vector<char> compressed(dataSize + dataSize / 255 + 16);
+        uint8_t* pOut = reinterpret_cast<uint8_t*>(compressed.data());
+
+        const uint8_t* pBegin = reinterpret_cast<const uint8_t*>(pData);
+        const uint8_t* pEnd = pBegin + dataSize;
+        const uint8_t* pAnchor = pBegin;
+
+        if (dataSize > s_matchFindLimit)
+        {
+            // Positions + 1 of the previous sequences with the same hash (0 = none)
+            std::vector<uint32_t> hashTable((size_t)1 << s_hashLog, 0);
+            const uint8_t* pMatchFindEnd = pEnd - s_matchFindLimit;
+            const uint8_t* pMatchEnd = pEnd - s_lastLiterals;
+
+            const uint8_t* pCurrent = pBegin;
+            // Skipping faster through data which doesn't compress
+            size_t missCount = 0;
+            while (pCurrent <= pMatchFindEnd)
+            {
+                const uint32_t sequence = read_u32(pCurrent);
+                const uint32_t hash = hash_sequence(sequence);
+                const uint32_t candidatePos = hashTable[hash];
+                hashTable[hash] = static_cast<uint32_t>(pCurrent - pBegin) + 1;
+
+                const uint8_t* pCandidate = candidatePos > 0 ? pBegin + candidatePos - 1 : nullptr;
+                if (!pCandidate ||
+                    (size_t)(pCurrent - pCandidate) > s_maxOffset ||
+                    read_u32(pCandidate) != sequence)
+                {
+                    pCurrent += (missCount++ >> 6) + 1;
+                    continue;
+                }
+                missCount = 0;
+
+                const uint8_t* pMatchCurrent = pCurrent + s_minMatch;
+                const uint8_t* pMatchCandidate = pCandidate + s_minMatch;
+                while (pMatchCurrent < pMatchEnd && *pMatchCurrent == *pMatchCandidate)
+                {
+                    ++pMatchCurrent;
+                    ++pMatchCandidate;
+                }
+
+                pOut = write_sequence(
+                    pOut,
+                    pAnchor,
+                    pCurrent - pAnchor,
+                    pCurrent - pCandidate,
+                    pMatchCurrent - pCurrent
+                );
+                pCurrent = pMatchCurrent;
+                pAnchor = pCurrent;
+            }
+        }
+        pOut = write_sequence(pOut, pAnchor, pEnd - pAnchor, 0, 0);
+
+        compressed.resize(pOut - reinterpret_cast<uint8_t*>(compressed.data()));
+        return compressed;
+    }
+
+    // Returns false if the length goes past the end of the input
+    static inline bool read_length(const uint8_t*& pIn, const uint8_t* pInEnd, size_t& length)
+    {
+        uint8_t value = 0;
+        do
+        {
+            if (pIn >= pInEnd)
+                return false;
+            value = *pIn++;
+            length += value;
+        } while (value == 255);
+        return true;
+    }
+
+    bool lz4_decompress(
+        const char* pCompressedData,
+        size_t compressedSize,
+        char* pOutData,
+        size_t dataSize
+    )
+    {
+        const uint8_t* pIn = reinterpret_cast<const uint8_t*>(pCompressedData);
+        const uint8_t* pInEnd = pIn + compressedSize;
+        uint8_t* pOutBegin = reinterpret_cast<uint8_t*>(pOutData);
+        uint8_t* pOut = pOutBegin;
+        uint8_t* pOutEnd = pOut + dataSize;
+
+        while (pIn < pInEnd)
+        {
+            const uint8_t token = *pIn++;
+
+            size_t literalLength = token >> 4;
+            if (literalLength == 15 && !read_length(pIn, pInEnd, literalLength))
+                return false;
+
+            if (literalLength > (size_t)(pInEnd - pIn) || literalLength > (size_t)(pOutEnd - pOut))
+                return false;
+
+            if (literalLength > 0)
+                memcpy(pOut, pIn, literalLength);
+            pIn += literalLength;
+            pOut += literalLength;
+
+            // Last sequence has only literals
+            if (pIn == pInEnd)
+                break;
+
+            if (pInEnd - pIn < 2)
+                return false;
+            const size_t offset = (size_t)pIn[0] | ((size_t)pIn[1] << 8);
+            pIn += 2;
+            if (offset == 0 || offset > (size_t)(pOut - pOutBegin))
+                return false;
+
+            size_t matchLength = token & 15;
+            if (matchLength == 15 && !read_length(pIn, pInEnd, matchLength))
+                return false;
+            matchLength += s_minMatch;
+
+            if (matchLength > (size_t)(pOutEnd - pOut))
+                return false;
+
+            const uint8_t* pMatch = pOut - offset;
+            if (offset >= matchLength)
+            {
+                memcpy(pOut, pMatch, matchLength);
+                pOut += matchLength;
+            }
+            else
+            {
+                // Overlapping match repeats the last offset bytes
+                for (size_t i = 0; i < matchLength; ++i)
+                    *pOut++ = pMatch[i];
+            }
+        }
+        return pOut == pOutEnd;
+    }
+}
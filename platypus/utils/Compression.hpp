@@ -0,0 +1,22 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+
+namespace platypus
+{
+    // Compression using the LZ4 block format (no frame format, no checksums).
+    // Fast to decompress -> meant for asset data which is compressed once
+    // and loaded many times.
+    std::vector<char> lz4_compress(const char* pData, size_t dataSize);
+
+    // pOutData has to be exactly dataSize (the uncompressed size) bytes.
+    // Returns false if the compressed data was invalid or didn't decompress to dataSize bytes.
+    bool lz4_decompress(
+        const char* pCompressedData,
+        size_t compressedSize,
+        char* pOutData,
+        size_t dataSize
+    );
+}
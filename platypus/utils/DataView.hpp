@@ -0,0 +1,40 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+
+namespace platypus
+{
+    // Read only view to serialized data which can be owned by a std::vector
+    // or be somewhere else entirely, like in a memory mapped file.
+    // NOTE: Doesn't own the data -> the data has to outlive the view!
+    class DataView
+    {
+    private:
+        const char* _pData = nullptr;
+        size_t _size = 0;
+
+    public:
+        DataView() = default;
+        DataView(const char* pData, size_t size) :
+            _pData(pData),
+            _size(size)
+        {}
+        // NOTE: Implicit on purpose, so the deserialization funcs taking a DataView
+        // accept std::vector<char> like before
+        DataView(const std::vector<char>& data) :
+            _pData(data.data()),
+            _size(data.size())
+        {}
+
+        inline DataView subView(size_t offset, size_t size) const
+        {
+            return DataView(_pData + offset, size);
+        }
+
+        inline const char* data() const { return _pData; }
+        inline size_t size() const { return _size; }
+        inline bool empty() const { return _size == 0; }
+    };
+}
@@ -0,0 +1,18 @@
+#include "Hash.hpp"
+
+
+namespace platypus
+{
+    static const uint64_t s_fnvPrime = 0x100000001b3ULL;
+
+    uint64_t hash_data(const void* pData, size_t size, uint64_t hash)
+    {
+        const unsigned char* pBytes = (const unsigned char*)pData;
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= (uint64_t)pBytes[i];
+            hash *= s_fnvPrime;
+        }
+        return hash;
+    }
+}
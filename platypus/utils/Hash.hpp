@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+
+namespace platypus
+{
+    // 64 bit FNV-1a
+    // NOTE: Not for anything security related, only for cache keys and such.
+    const uint64_t hash_offset_basis = 0xcbf29ce484222325ULL;
+
+    uint64_t hash_data(const void* pData, size_t size, uint64_t hash = hash_offset_basis);
+
+    // NOTE: Hashes the value's bytes -> T shouldn't have padding or pointers to the actual data
+    template <typename T>
+    inline uint64_t hash_value(const T& value, uint64_t hash = hash_offset_basis)
+    {
+        return hash_data(&value, sizeof(T), hash);
+    }
+}
@@ -0,0 +1,122 @@
+#include "ImageDataUtils.hpp"
+#include <algorithm>
+#include <cmath>
+
+
+namespace platypus
+{
+    // Linear values are encoded back to sRGB using this many steps
+    static const size_t s_linearToSRGBTableSize = 4096;
+
+    struct SRGBTables
+    {
+        float toLinear[256];
+        PE_ubyte toSRGB[s_linearToSRGBTableSize];
+
+        SRGBTables()
+        {
+            for (int i = 0; i < 256; ++i)
+            {
+                const float value = (float)i / 255.0f;
+                toLinear[i] = value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+            }
+            for (size_t i = 0; i < s_linearToSRGBTableSize; ++i)
+            {
+                const float value = (float)i / (float)(s_linearToSRGBTableSize - 1);
+                const float encoded = value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+                toSRGB[i] = (PE_ubyte)std::min(255.0f, std::round(encoded * 255.0f));
+            }
+        }
+    };
+
+    // NOTE: Function local static so the tables are initialized thread safely on first use
+    static const SRGBTables& get_srgb_tables()
+    {
+        static const SRGBTables s_tables;
+        return s_tables;
+    }
+
+    uint32_t get_mip_level_count(int width, int height)
+    {
+        const int maxSize = std::max(std::max(width, height), 1);
+        return (uint32_t)std::floor(std::log2(maxSize)) + 1;
+    }
+
+    int get_mip_dimension(int size, uint32_t level)
+    {
+        return std::max(size >> level, 1);
+    }
+
+    size_t get_mip_level_offset(int width, int height, int channels, uint32_t level)
+    {
+        return get_mip_chain_size(width, height, channels, level);
+    }
+
+    size_t get_mip_chain_size(int width, int height, int channels, uint32_t levelCount)
+    {
+        size_t size = 0;
+        for (uint32_t level = 0; level < levelCount; ++level)
+        {
+            size += (size_t)get_mip_dimension(width, level) *
+                (size_t)get_mip_dimension(height, level) *
+                (size_t)channels;
+        }
+        return size;
+    }
+
+    void generate_mip_chain(
+        PE_ubyte* pChain,
+        int width,
+        int height,
+        int channels,
+        uint32_t levelCount,
+        bool sRGB
+    )
+    {
+        const SRGBTables& tables = get_srgb_tables();
+        const float* pToLinear = tables.toLinear;
+        const PE_ubyte* pToSRGB = tables.toSRGB;
+        // Alpha stays linear
+        const int sRGBChannels = sRGB ? std::min(channels, 3) : 0;
+
+        for (uint32_t level = 1; level < levelCount; ++level)
+        {
+            const int srcWidth = get_mip_dimension(width, level - 1);
+            const int srcHeight = get_mip_dimension(height, level - 1);
+            const int dstWidth = get_mip_dimension(width, level);
+            const int dstHeight = get_mip_dimension(height, level);
+            const PE_ubyte* pSrc = pChain + get_mip_level_offset(width, height, channels, level - 1);
+            PE_ubyte* pDst = pChain + get_mip_level_offset(width, height, channels, level);
+
+            for (int y = 0; y < dstHeight; ++y)
+            {
+                // Clamping for odd and 1 pixel dimensions
+                const int srcY0 = std::min(y * 2, srcHeight - 1);
+                const int srcY1 = std::min(y * 2 + 1, srcHeight - 1);
+                for (int x = 0; x < dstWidth; ++x)
+                {
+                    const int srcX0 = std::min(x * 2, srcWidth - 1);
+                    const int srcX1 = std::min(x * 2 + 1, srcWidth - 1);
+                    const PE_ubyte* p00 = pSrc + (srcX0 + srcY0 * srcWidth) * channels;
+                    const PE_ubyte* p10 = pSrc + (srcX1 + srcY0 * srcWidth) * channels;
+                    const PE_ubyte* p01 = pSrc + (srcX0 + srcY1 * srcWidth) * channels;
+                    const PE_ubyte* p11 = pSrc + (srcX1 + srcY1 * srcWidth) * channels;
+                    PE_ubyte* pOut = pDst + (x + y * dstWidth) * channels;
+
+                    for (int c = 0; c < channels; ++c)
+                    {
+                        if (c < sRGBChannels)
+                        {
+                            const float linear = (pToLinear[p00[c]] + pToLinear[p10[c]] + pToLinear[p01[c]] + pToLinear[p11[c]]) * 0.25f;
+                            pOut[c] = pToSRGB[(size_t)(linear * (float)(s_linearToSRGBTableSize - 1) + 0.5f)];
+                        }
+                        else
+                        {
+                            pOut[c] = (PE_ubyte)(((int)p00[c] + (int)p10[c] + (int)p01[c] + (int)p11[c] + 2) / 4);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "platypus/Common.h"
+#include <cstdint>
+#include <cstddef>
+
+
+namespace platypus
+{
+    // Mip chains are stored tightly packed, level 0 first.
+    // Level's width and height are max(1, size >> level) like on the GPU side.
+
+    // Level count of a full mip chain down to 1x1
+    uint32_t get_mip_level_count(int width, int height);
+    int get_mip_dimension(int size, uint32_t level);
+    // Byte offset of the level from the beginning of the chain
+    size_t get_mip_level_offset(int width, int height, int channels, uint32_t level);
+    size_t get_mip_chain_size(int width, int height, int channels, uint32_t levelCount);
+
+    // Fills levels 1..levelCount-1 of pChain by box filtering the previous level.
+    // Level 0 has to be at the beginning of pChain already.
+    // If sRGB, filtering happens in linear space (4th channel is always linear alpha),
+    // matching what the GPU does when blitting sRGB images.
+    void generate_mip_chain(
+        PE_ubyte* pChain,
+        int width,
+        int height,
+        int channels,
+        uint32_t levelCount,
+        bool sRGB
+    );
+}
@@ -0,0 +1,99 @@
+#include "MappedFile.hpp"
+#include "FileUtils.hpp"
+#include "platypus/core/Debug.hpp"
+
+#ifndef PLATYPUS_BUILD_WEB
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <cerrno>
+    #include <cstring>
+#endif
+
+
+namespace platypus
+{
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+    bool MappedFile::open(const std::string& filepath)
+    {
+        if (isOpen())
+            close();
+
+    #ifdef PLATYPUS_BUILD_WEB
+        _fileData = read_file(filepath);
+        if (_fileData.empty())
+        {
+            Debug::log(
+                "Failed to read file: " + filepath,
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            return false;
+        }
+        _pData = _fileData.data();
+        _size = _fileData.size();
+    #else
+        const int fd = ::open(filepath.c_str(), O_RDONLY);
+        if (fd == -1)
+        {
+            Debug::log(
+                "Failed to open file: " + filepath + " " + std::string(strerror(errno)),
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            return false;
+        }
+
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) == -1 || fileStat.st_size <= 0)
+        {
+            Debug::log(
+                "Failed to get size of file: " + filepath + " or the file was empty",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            ::close(fd);
+            return false;
+        }
+        const size_t fileSize = static_cast<size_t>(fileStat.st_size);
+
+        void* pMapped = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        // NOTE: The mapping stays valid after closing the file descriptor
+        ::close(fd);
+        if (pMapped == MAP_FAILED)
+        {
+            Debug::log(
+                "Failed to map file: " + filepath + " " + std::string(strerror(errno)),
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            return false;
+        }
+        _pData = static_cast<const char*>(pMapped);
+        _size = fileSize;
+    #endif
+        _filepath = filepath;
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+        if (!isOpen())
+            return;
+
+    #ifdef PLATYPUS_BUILD_WEB
+        _fileData.clear();
+        _fileData.shrink_to_fit();
+    #else
+        munmap(const_cast<char*>(_pData), _size);
+    #endif
+        _pData = nullptr;
+        _size = 0;
+        _filepath.clear();
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "DataView.hpp"
+#include <string>
+#include <vector>
+
+
+namespace platypus
+{
+    // Read only memory mapped file.
+    // Pages get read from disk only when they're accessed, so reading
+    // a small part of a large file doesn't read the whole file.
+    // NOTE: On web there's no mmap that would avoid the copy
+    //  -> the whole file is read into memory on open instead.
+    class MappedFile
+    {
+    private:
+        std::string _filepath;
+        const char* _pData = nullptr;
+        size_t _size = 0;
+    #ifdef PLATYPUS_BUILD_WEB
+        std::vector<char> _fileData;
+    #endif
+
+    public:
+        MappedFile() = default;
+        MappedFile(const MappedFile&) = delete;
+        ~MappedFile();
+
+        bool open(const std::string& filepath);
+        void close();
+
+        inline bool isOpen() const { return _pData != nullptr; }
+        inline const std::string& getFilepath() const { return _filepath; }
+        inline const char* getData() const { return _pData; }
+        inline size_t getSize() const { return _size; }
+        inline DataView getView() const { return DataView(_pData, _size); }
+    };
+}
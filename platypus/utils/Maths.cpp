@@ -3,9 +3,224 @@
 #include <cstring>
 #include <cmath>
 
+#ifdef PLATYPUS_MATHS_SSE
+    #include <immintrin.h>
+#endif
+
 
 namespace platypus
 {
+    // If quaternions are closer than this in slerp, using normalized lerp instead
+    #define QUATERNION_SLERP__DOT_THRESHOLD 0.9995f
+
+#ifdef PLATYPUS_MATHS_SSE
+    static_assert(sizeof(Vector4f) == sizeof(float) * 4, "Vector4f required to be tightly packed for SSE");
+    static_assert(sizeof(Quaternion) == sizeof(float) * 4, "Quaternion required to be tightly packed for SSE");
+
+    // x, y, z, w = source lanes of the result lanes 0, 1, 2, 3
+    #define PLATYPUS_SSE_SHUFFLE_MASK(x, y, z, w) ((x) | ((y) << 2) | ((z) << 4) | ((w) << 6))
+    #define PLATYPUS_SSE_SWIZZLE(v, x, y, z, w) _mm_shuffle_ps(v, v, PLATYPUS_SSE_SHUFFLE_MASK(x, y, z, w))
+    #define PLATYPUS_SSE_SHUFFLE(v1, v2, x, y, z, w) _mm_shuffle_ps(v1, v2, PLATYPUS_SSE_SHUFFLE_MASK(x, y, z, w))
+
+    // Returns sum of all lanes in all lanes
+    static inline __m128 horizontal_add_sse(__m128 v)
+    {
+        __m128 shuffled = PLATYPUS_SSE_SWIZZLE(v, 1, 0, 3, 2);
+        __m128 sums = _mm_add_ps(v, shuffled);
+        shuffled = PLATYPUS_SSE_SWIZZLE(sums, 2, 3, 0, 1);
+        return _mm_add_ps(sums, shuffled);
+    }
+
+    static inline __m128 dotp_sse(__m128 a, __m128 b)
+    {
+        return horizontal_add_sse(_mm_mul_ps(a, b));
+    }
+
+    static inline __m128 normalize_sse(__m128 v)
+    {
+        return _mm_div_ps(v, _mm_sqrt_ps(dotp_sse(v, v)));
+    }
+
+    // Matrices here are column major float[16]
+    // pResult is allowed to be the same as pLeft or pRight
+    static inline void multiply_sse(const float* pLeft, const float* pRight, float* pResult)
+    {
+    #ifdef PLATYPUS_MATHS_AVX
+        // Calculating 2 result columns at once
+        const __m256 c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(pLeft));
+        const __m256 c1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(pLeft + 4));
+        const __m256 c2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(pLeft + 8));
+        const __m256 c3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(pLeft + 12));
+        for (int i = 0; i < 16; i += 8)
+        {
+            const __m256 r = _mm256_loadu_ps(pRight + i);
+            __m256 result = _mm256_mul_ps(c0, _mm256_shuffle_ps(r, r, 0x00));
+            result = _mm256_add_ps(result, _mm256_mul_ps(c1, _mm256_shuffle_ps(r, r, 0x55)));
+            result = _mm256_add_ps(result, _mm256_mul_ps(c2, _mm256_shuffle_ps(r, r, 0xAA)));
+            result = _mm256_add_ps(result, _mm256_mul_ps(c3, _mm256_shuffle_ps(r, r, 0xFF)));
+            _mm256_storeu_ps(pResult + i, result);
+        }
+    #else
+        const __m128 c0 = _mm_loadu_ps(pLeft);
+        const __m128 c1 = _mm_loadu_ps(pLeft + 4);
+        const __m128 c2 = _mm_loadu_ps(pLeft + 8);
+        const __m128 c3 = _mm_loadu_ps(pLeft + 12);
+        for (int i = 0; i < 16; i += 4)
+        {
+            __m128 result = _mm_mul_ps(c0, _mm_set1_ps(pRight[i]));
+            result = _mm_add_ps(result, _mm_mul_ps(c1, _mm_set1_ps(pRight[i + 1])));
+            result = _mm_add_ps(result, _mm_mul_ps(c2, _mm_set1_ps(pRight[i + 2])));
+            result = _mm_add_ps(result, _mm_mul_ps(c3, _mm_set1_ps(pRight[i + 3])));
+            _mm_storeu_ps(pResult + i, result);
+        }
+    #endif
+    }
+
+    static inline __m128 transform_point_sse(
+        __m128 c0, __m128 c1, __m128 c2, __m128 c3,
+        const float* pPoint
+    )
+    {
+        __m128 result = _mm_mul_ps(c0, _mm_set1_ps(pPoint[0]));
+        result = _mm_add_ps(result, _mm_mul_ps(c1, _mm_set1_ps(pPoint[1])));
+        result = _mm_add_ps(result, _mm_mul_ps(c2, _mm_set1_ps(pPoint[2])));
+        return _mm_add_ps(result, _mm_mul_ps(c3, _mm_set1_ps(pPoint[3])));
+    }
+
+    static inline void transform_point_sse(const float* pMatrix, const float* pPoint, float* pResult)
+    {
+        _mm_storeu_ps(
+            pResult,
+            transform_point_sse(
+                _mm_loadu_ps(pMatrix),
+                _mm_loadu_ps(pMatrix + 4),
+                _mm_loadu_ps(pMatrix + 8),
+                _mm_loadu_ps(pMatrix + 12),
+                pPoint
+            )
+        );
+    }
+
+    // 2x2 matrix funcs for inverse_sse. 2x2 matrices are stored as (m00, m01, m10, m11)
+    // A * B
+    static inline __m128 mat2_multiply_sse(__m128 a, __m128 b)
+    {
+        return _mm_add_ps(
+            _mm_mul_ps(a, PLATYPUS_SSE_SWIZZLE(b, 0, 3, 0, 3)),
+            _mm_mul_ps(PLATYPUS_SSE_SWIZZLE(a, 1, 0, 3, 2), PLATYPUS_SSE_SWIZZLE(b, 2, 1, 2, 1))
+        );
+    }
+    // adjugate(A) * B
+    static inline __m128 mat2_adjugate_multiply_sse(__m128 a, __m128 b)
+    {
+        return _mm_sub_ps(
+            _mm_mul_ps(PLATYPUS_SSE_SWIZZLE(a, 3, 3, 0, 0), b),
+            _mm_mul_ps(PLATYPUS_SSE_SWIZZLE(a, 1, 1, 2, 2), PLATYPUS_SSE_SWIZZLE(b, 2, 3, 0, 1))
+        );
+    }
+    // A * adjugate(B)
+    static inline __m128 mat2_multiply_adjugate_sse(__m128 a, __m128 b)
+    {
+        return _mm_sub_ps(
+            _mm_mul_ps(a, PLATYPUS_SSE_SWIZZLE(b, 3, 0, 3, 0)),
+            _mm_mul_ps(PLATYPUS_SSE_SWIZZLE(a, 1, 0, 3, 2), PLATYPUS_SSE_SWIZZLE(b, 2, 1, 2, 1))
+        );
+    }
+
+    // Inverse using 2x2 block matrices.
+    // Based on: https://lxjk.github.io/2017/09/03/Fast-4x4-Matrix-Inverse-with-SSE-SIMD-Explained.html
+    // That is written for row major matrices, but since inverse(transpose(M)) = transpose(inverse(M))
+    // it works the same for column major.
+    // NOTE: Like the scalar version, if determinant is 0 this returns the adjugate matrix
+    static void inverse_sse(const float* pMatrix, float* pResult)
+    {
+        const __m128 m0 = _mm_loadu_ps(pMatrix);
+        const __m128 m1 = _mm_loadu_ps(pMatrix + 4);
+        const __m128 m2 = _mm_loadu_ps(pMatrix + 8);
+        const __m128 m3 = _mm_loadu_ps(pMatrix + 12);
+
+        // Sub matrices
+        const __m128 a = _mm_movelh_ps(m0, m1);
+        const __m128 b = _mm_movehl_ps(m1, m0);
+        const __m128 c = _mm_movelh_ps(m2, m3);
+        const __m128 d = _mm_movehl_ps(m3, m2);
+
+        // Determinants of the sub matrices as (|A|, |B|, |C|, |D|)
+        const __m128 subDeterminants = _mm_sub_ps(
+            _mm_mul_ps(PLATYPUS_SSE_SHUFFLE(m0, m2, 0, 2, 0, 2), PLATYPUS_SSE_SHUFFLE(m1, m3, 1, 3, 1, 3)),
+            _mm_mul_ps(PLATYPUS_SSE_SHUFFLE(m0, m2, 1, 3, 1, 3), PLATYPUS_SSE_SHUFFLE(m1, m3, 0, 2, 0, 2))
+        );
+        const __m128 detA = PLATYPUS_SSE_SWIZZLE(subDeterminants, 0, 0, 0, 0);
+        const __m128 detB = PLATYPUS_SSE_SWIZZLE(subDeterminants, 1, 1, 1, 1);
+        const __m128 detC = PLATYPUS_SSE_SWIZZLE(subDeterminants, 2, 2, 2, 2);
+        const __m128 detD = PLATYPUS_SSE_SWIZZLE(subDeterminants, 3, 3, 3, 3);
+
+        const __m128 adjDC = mat2_adjugate_multiply_sse(d, c);
+        const __m128 adjAB = mat2_adjugate_multiply_sse(a, b);
+
+        // Adjugates of the result's sub matrices
+        __m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), mat2_multiply_sse(b, adjDC));
+        __m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), mat2_multiply_sse(c, adjAB));
+        __m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), mat2_multiply_adjugate_sse(d, adjAB));
+        __m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), mat2_multiply_adjugate_sse(a, adjDC));
+
+        // |M| = |A|*|D| + |B|*|C| - trace(adjugate(A)B * adjugate(D)C)
+        __m128 determinant = _mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC));
+        const __m128 trace = horizontal_add_sse(_mm_mul_ps(adjAB, PLATYPUS_SSE_SWIZZLE(adjDC, 0, 2, 1, 3)));
+        determinant = _mm_sub_ps(determinant, trace);
+
+        const __m128 adjugateSign = _mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f);
+        __m128 scale = adjugateSign;
+        if (_mm_cvtss_f32(determinant) != 0.0f)
+            scale = _mm_div_ps(adjugateSign, determinant);
+
+        x = _mm_mul_ps(x, scale);
+        y = _mm_mul_ps(y, scale);
+        z = _mm_mul_ps(z, scale);
+        w = _mm_mul_ps(w, scale);
+
+        _mm_storeu_ps(pResult, PLATYPUS_SSE_SHUFFLE(x, y, 3, 1, 3, 1));
+        _mm_storeu_ps(pResult + 4, PLATYPUS_SSE_SHUFFLE(x, y, 2, 0, 2, 0));
+        _mm_storeu_ps(pResult + 8, PLATYPUS_SSE_SHUFFLE(z, w, 3, 1, 3, 1));
+        _mm_storeu_ps(pResult + 12, PLATYPUS_SSE_SHUFFLE(z, w, 2, 0, 2, 0));
+    }
+
+    // Quaternions here are float[4] (x, y, z, w)
+    // Same as the scalar version, but the vector operations using SSE
+    static void slerp_sse(const float* pFrom, const float* pTo, float amount, float* pResult)
+    {
+        const __m128 from = normalize_sse(_mm_loadu_ps(pFrom));
+        __m128 to = normalize_sse(_mm_loadu_ps(pTo));
+
+        float dot = _mm_cvtss_f32(dotp_sse(from, to));
+        // Take the shorter path
+        if (dot < 0.0f)
+        {
+            to = _mm_sub_ps(_mm_setzero_ps(), to);
+            dot = -dot;
+        }
+
+        if (dot > QUATERNION_SLERP__DOT_THRESHOLD)
+        {
+            const __m128 result = _mm_add_ps(from, _mm_mul_ps(_mm_sub_ps(to, from), _mm_set1_ps(amount)));
+            _mm_storeu_ps(pResult, normalize_sse(result));
+            return;
+        }
+
+        const float theta0 = acos(dot);
+        const float theta = theta0 * amount;
+        const float sinTheta = sin(theta);
+        const float sinTheta0 = sin(theta0);
+
+        const float s0 = cos(theta) - dot * sinTheta / sinTheta0;
+        const float s1 = sinTheta / sinTheta0;
+        _mm_storeu_ps(
+            pResult,
+            _mm_add_ps(_mm_mul_ps(from, _mm_set1_ps(s0)), _mm_mul_ps(to, _mm_set1_ps(s1)))
+        );
+    }
+#endif
+
     float Vector2f::dotp(const Vector2f& other) const
     {
         return (x * other.x) + (y * other.y);
@@ -188,134 +403,15 @@ namespace platypus
             _data[i + i * 4] = 1.0f;
     }
 
-    // Found from: https://stackoverflow.com/questions/1148309/inverting-a-4x4-matrix
-    //     Comment on the site about this :
-    //         "This was lifted from MESA implementation of the GLU library."
     Matrix4f Matrix4f::inverse() const
     {
+    #ifdef PLATYPUS_MATHS_SSE
         Matrix4f inverseMatrix;
-        inverseMatrix._data[0] = _data[5] * _data[10] * _data[15] -
-            _data[5] * _data[11] * _data[14] -
-            _data[9] * _data[6] * _data[15] +
-            _data[9] * _data[7] * _data[14] +
-            _data[13] * _data[6] * _data[11] -
-            _data[13] * _data[7] * _data[10];
-
-        inverseMatrix._data[4] = -_data[4] * _data[10] * _data[15] +
-            _data[4] * _data[11] * _data[14] +
-            _data[8] * _data[6] * _data[15] -
-            _data[8] * _data[7] * _data[14] -
-            _data[12] * _data[6] * _data[11] +
-            _data[12] * _data[7] * _data[10];
-
-        inverseMatrix._data[8] = _data[4] * _data[9] * _data[15] -
-            _data[4] * _data[11] * _data[13] -
-            _data[8] * _data[5] * _data[15] +
-            _data[8] * _data[7] * _data[13] +
-            _data[12] * _data[5] * _data[11] -
-            _data[12] * _data[7] * _data[9];
-
-        inverseMatrix._data[12] = -_data[4] * _data[9] * _data[14] +
-            _data[4] * _data[10] * _data[13] +
-            _data[8] * _data[5] * _data[14] -
-            _data[8] * _data[6] * _data[13] -
-            _data[12] * _data[5] * _data[10] +
-            _data[12] * _data[6] * _data[9];
-
-        inverseMatrix._data[1] = -_data[1] * _data[10] * _data[15] +
-            _data[1] * _data[11] * _data[14] +
-            _data[9] * _data[2] * _data[15] -
-            _data[9] * _data[3] * _data[14] -
-            _data[13] * _data[2] * _data[11] +
-            _data[13] * _data[3] * _data[10];
-
-        inverseMatrix._data[5] = _data[0] * _data[10] * _data[15] -
-            _data[0] * _data[11] * _data[14] -
-            _data[8] * _data[2] * _data[15] +
-            _data[8] * _data[3] * _data[14] +
-            _data[12] * _data[2] * _data[11] -
-            _data[12] * _data[3] * _data[10];
-
-        inverseMatrix._data[9] = -_data[0] * _data[9] * _data[15] +
-            _data[0] * _data[11] * _data[13] +
-            _data[8] * _data[1] * _data[15] -
-            _data[8] * _data[3] * _data[13] -
-            _data[12] * _data[1] * _data[11] +
-            _data[12] * _data[3] * _data[9];
-
-        inverseMatrix._data[13] = _data[0] * _data[9] * _data[14] -
-            _data[0] * _data[10] * _data[13] -
-            _data[8] * _data[1] * _data[14] +
-            _data[8] * _data[2] * _data[13] +
-            _data[12] * _data[1] * _data[10] -
-            _data[12] * _data[2] * _data[9];
-
-        inverseMatrix._data[2] = _data[1] * _data[6] * _data[15] -
-            _data[1] * _data[7] * _data[14] -
-            _data[5] * _data[2] * _data[15] +
-            _data[5] * _data[3] * _data[14] +
-            _data[13] * _data[2] * _data[7] -
-            _data[13] * _data[3] * _data[6];
-
-        inverseMatrix._data[6] = -_data[0] * _data[6] * _data[15] +
-            _data[0] * _data[7] * _data[14] +
-            _data[4] * _data[2] * _data[15] -
-            _data[4] * _data[3] * _data[14] -
-            _data[12] * _data[2] * _data[7] +
-            _data[12] * _data[3] * _data[6];
-
-        inverseMatrix._data[10] = _data[0] * _data[5] * _data[15] -
-            _data[0] * _data[7] * _data[13] -
-            _data[4] * _data[1] * _data[15] +
-            _data[4] * _data[3] * _data[13] +
-            _data[12] * _data[1] * _data[7] -
-            _data[12] * _data[3] * _data[5];
-
-        inverseMatrix._data[14] = -_data[0] * _data[5] * _data[14] +
-            _data[0] * _data[6] * _data[13] +
-            _data[4] * _data[1] * _data[14] -
-            _data[4] * _data[2] * _data[13] -
-            _data[12] * _data[1] * _data[6] +
-            _data[12] * _data[2] * _data[5];
-
-        inverseMatrix._data[3] = -_data[1] * _data[6] * _data[11] +
-            _data[1] * _data[7] * _data[10] +
-            _data[5] * _data[2] * _data[11] -
-            _data[5] * _data[3] * _data[10] -
-            _data[9] * _data[2] * _data[7] +
-            _data[9] * _data[3] * _data[6];
-
-        inverseMatrix._data[7] = _data[0] * _data[6] * _data[11] -
-            _data[0] * _data[7] * _data[10] -
-            _data[4] * _data[2] * _data[11] +
-            _data[4] * _data[3] * _data[10] +
-            _data[8] * _data[2] * _data[7] -
-            _data[8] * _data[3] * _data[6];
-
-        inverseMatrix._data[11] = -_data[0] * _data[5] * _data[11] +
-            _data[0] * _data[7] * _data[9] +
-            _data[4] * _data[1] * _data[11] -
-            _data[4] * _data[3] * _data[9] -
-            _data[8] * _data[1] * _data[7] +
-            _data[8] * _data[3] * _data[5];
-
-        inverseMatrix._data[15] = _data[0] * _data[5] * _data[10] -
-            _data[0] * _data[6] * _data[9] -
-            _data[4] * _data[1] * _data[10] +
-            _data[4] * _data[2] * _data[9] +
-            _data[8] * _data[1] * _data[6] -
-            _data[8] * _data[2] * _data[5];
-
-
-        float determinant = _data[0] * inverseMatrix._data[0] + _data[1] * inverseMatrix._data[4] + _data[2] * inverseMatrix._data[8] + _data[3] * inverseMatrix._data[12];
-
-        if (determinant == 0)
-            return inverseMatrix;
-
-        for (int i = 0; i < 16; ++i)
-            inverseMatrix[i] *= (1.0f / determinant);
-
+        inverse_sse(_data, &inverseMatrix[0]);
         return inverseMatrix;
+    #else
+        return scalar::inverse(*this);
+    #endif
     }
 
     Matrix4f Matrix4f::transpose() const
@@ -338,31 +434,24 @@ namespace platypus
 
     Matrix4f operator*(const Matrix4f& left, const Matrix4f& right)
     {
+    #ifdef PLATYPUS_MATHS_SSE
         Matrix4f result;
-
-        for (int y = 0; y < 4; ++y)
-        {
-            for (int x = 0; x < 4; ++x)
-            {
-                result[y + x * 4] =
-                    left[y + 0 * 4] * right[0 + x * 4] +
-                    left[y + 1 * 4] * right[1 + x * 4] +
-                    left[y + 2 * 4] * right[2 + x * 4] +
-                    left[y + 3 * 4] * right[3 + x * 4];
-            }
-        }
-
+        multiply_sse(left.getRawArray(), right.getRawArray(), &result[0]);
         return result;
+    #else
+        return scalar::multiply(left, right);
+    #endif
     }
 
     Vector4f operator*(const Matrix4f& left, const Vector4f& right)
     {
+    #ifdef PLATYPUS_MATHS_SSE
         Vector4f result;
-        result.x = left[0 + 0 * 4] * right.x + left[0 + 1 * 4] * right.y + left[0 + 2 * 4] * right.z + left[0 + 3 * 4] * right.w;
-        result.y = left[1 + 0 * 4] * right.x + left[1 + 1 * 4] * right.y + left[1 + 2 * 4] * right.z + left[1 + 3 * 4] * right.w;
-        result.z = left[2 + 0 * 4] * right.x + left[2 + 1 * 4] * right.y + left[2 + 2 * 4] * right.z + left[2 + 3 * 4] * right.w;
-        result.w = left[3 + 0 * 4] * right.x + left[3 + 1 * 4] * right.y + left[3 + 2 * 4] * right.z + left[3 + 3 * 4] * right.w;
+        transform_point_sse(left.getRawArray(), &right.x, &result.x);
         return result;
+    #else
+        return scalar::multiply(left, right);
+    #endif
     }
 
     std::string Matrix4f::toString() const
@@ -447,45 +536,15 @@ namespace platypus
         return rotationMatrix;
     }
 
-    // Copied from wikipedia : https://en.wikipedia.org/wiki/Slerp
-    #define QUATERNION_SLERP__DOT_THRESHOLD 0.9995f
     Quaternion Quaternion::slerp(const Quaternion& other, float amount) const
     {
-        // Only unit quaternions are valid rotations.
-        // Normalize to avoid undefined behavior.
-        Quaternion ua = normalize();
-        Quaternion ub = other.normalize();
-
-        // Compute the cosine of the angle between the two vectors.
-        float dot = ua.dotp(ub);
-
-        // If the dot product is negative, slerp won't take
-        // the shorter path. Note that v1 and -v1 are equivalent when
-        // the negation is applied to all four components. Fix by
-        // reversing one quaternion.
-        if (dot < 0.0f) {
-            ub = ub * -1.0f;
-            dot = -dot;
-        }
-
-        if (dot > QUATERNION_SLERP__DOT_THRESHOLD)
-        {
-            // If the inputs are too close for comfort, linearly interpolate
-            // and normalize the result.
-            Quaternion result = ua + ((ub - ua) * amount);
-            return result.normalize();
-        }
-
-        // Since dot is in range [0, DOT_THRESHOLD], acos is safe
-        float theta_0 = acos(dot);        // theta_0 = angle between input vectors
-        float theta = theta_0 * amount;   // theta = angle between v0 and result
-        float sin_theta = sin(theta);     // compute this value only once
-        float sin_theta_0 = sin(theta_0); // compute this value only once
-
-        float s0 = cos(theta) - dot * sin_theta / sin_theta_0;  // == sin(theta_0 - theta) / sin(theta_0)
-        float s1 = sin_theta / sin_theta_0;
-
-        return (ua * s0) + (ub * s1);
+    #ifdef PLATYPUS_MATHS_SSE
+        Quaternion result;
+        slerp_sse(&x, &other.x, amount, &result.x);
+        return result;
+    #else
+        return scalar::slerp(*this, other, amount);
+    #endif
     }
 
     Quaternion Quaternion::operator+(const Quaternion& other) const
@@ -525,20 +584,27 @@ namespace platypus
         const Vector3f& scale
     )
     {
-        Matrix4f translationMatrix(1.0f);
-        translationMatrix[0 + 3 * 4] = pos.x;
-        translationMatrix[1 + 3 * 4] = pos.y;
-        translationMatrix[2 + 3 * 4] = pos.z;
-
-        Matrix4f scaleMatrix(1.0f);
-        scaleMatrix[0 + 0 * 4] = scale.x;
-        scaleMatrix[1 + 1 * 4] = scale.y;
-        scaleMatrix[2 + 2 * 4] = scale.z;
-
-        Matrix4f rotationMatrix = rotation.toRotationMatrix();
-
-        // NOTE: Not sure is the order correct...
-        return translationMatrix * rotationMatrix * scaleMatrix;
+        // Same as translationMatrix * rotationMatrix * scaleMatrix
+        // without the full matrix multiplications
+        Matrix4f result = rotation.toRotationMatrix();
+        float* pResult = &result[0];
+    #ifdef PLATYPUS_MATHS_SSE
+        _mm_storeu_ps(pResult, _mm_mul_ps(_mm_loadu_ps(pResult), _mm_set1_ps(scale.x)));
+        _mm_storeu_ps(pResult + 4, _mm_mul_ps(_mm_loadu_ps(pResult + 4), _mm_set1_ps(scale.y)));
+        _mm_storeu_ps(pResult + 8, _mm_mul_ps(_mm_loadu_ps(pResult + 8), _mm_set1_ps(scale.z)));
+    #else
+        for (int i = 0; i < 4; ++i)
+        {
+            pResult[i + 0 * 4] *= scale.x;
+            pResult[i + 1 * 4] *= scale.y;
+            pResult[i + 2 * 4] *= scale.z;
+        }
+    #endif
+        pResult[0 + 3 * 4] = pos.x;
+        pResult[1 + 3 * 4] = pos.y;
+        pResult[2 + 3 * 4] = pos.z;
+        pResult[3 + 3 * 4] = 1.0f;
+        return result;
     }
 
 
@@ -683,4 +749,428 @@ namespace platypus
         result.erase(result.find_last_not_of('.') + 1, std::string::npos);
         return result;
     }
+
+
+    void multiply_matrices(
+        const Matrix4f* pLeft,
+        const Matrix4f* pRight,
+        Matrix4f* pOutResults,
+        size_t count
+    )
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+        #ifdef PLATYPUS_MATHS_SSE
+            multiply_sse(pLeft[i].getRawArray(), pRight[i].getRawArray(), &pOutResults[i][0]);
+        #else
+            pOutResults[i] = scalar::multiply(pLeft[i], pRight[i]);
+        #endif
+        }
+    }
+
+    void multiply_matrices(
+        const Matrix4f& left,
+        const Matrix4f* pRight,
+        Matrix4f* pOutResults,
+        size_t count
+    )
+    {
+    #ifdef PLATYPUS_MATHS_SSE
+        // Copy in case left is one of the outputs
+        const Matrix4f leftCopy = left;
+        for (size_t i = 0; i < count; ++i)
+            multiply_sse(leftCopy.getRawArray(), pRight[i].getRawArray(), &pOutResults[i][0]);
+    #else
+        const Matrix4f leftCopy = left;
+        for (size_t i = 0; i < count; ++i)
+            pOutResults[i] = scalar::multiply(leftCopy, pRight[i]);
+    #endif
+    }
+
+    void transform_points(
+        const Matrix4f& matrix,
+        const Vector4f* pPoints,
+        Vector4f* pOutResults,
+        size_t count
+    )
+    {
+    #ifdef PLATYPUS_MATHS_SSE
+        const float* pMatrix = matrix.getRawArray();
+        const __m128 c0 = _mm_loadu_ps(pMatrix);
+        const __m128 c1 = _mm_loadu_ps(pMatrix + 4);
+        const __m128 c2 = _mm_loadu_ps(pMatrix + 8);
+        const __m128 c3 = _mm_loadu_ps(pMatrix + 12);
+        for (size_t i = 0; i < count; ++i)
+            _mm_storeu_ps(&pOutResults[i].x, transform_point_sse(c0, c1, c2, c3, &pPoints[i].x));
+    #else
+        for (size_t i = 0; i < count; ++i)
+            pOutResults[i] = scalar::multiply(matrix, pPoints[i]);
+    #endif
+    }
+
+    void slerp_quaternions(
+        const Quaternion* pFrom,
+        const Quaternion* pTo,
+        const float* pAmounts,
+        Quaternion* pOutResults,
+        size_t count
+    )
+    {
+        size_t i = 0;
+    #ifdef PLATYPUS_MATHS_SSE
+        // Handling 4 quaternions at once with their components in separate registers
+        // (x0 x1 x2 x3), (y0 y1 y2 y3)... Only the trigonometric funcs are done per quaternion.
+        const __m128 dotThreshold = _mm_set1_ps(QUATERNION_SLERP__DOT_THRESHOLD);
+        const __m128 signBit = _mm_set1_ps(-0.0f);
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 ax = _mm_loadu_ps(&pFrom[i].x);
+            __m128 ay = _mm_loadu_ps(&pFrom[i + 1].x);
+            __m128 az = _mm_loadu_ps(&pFrom[i + 2].x);
+            __m128 aw = _mm_loadu_ps(&pFrom[i + 3].x);
+            _MM_TRANSPOSE4_PS(ax, ay, az, aw);
+
+            __m128 bx = _mm_loadu_ps(&pTo[i].x);
+            __m128 by = _mm_loadu_ps(&pTo[i + 1].x);
+            __m128 bz = _mm_loadu_ps(&pTo[i + 2].x);
+            __m128 bw = _mm_loadu_ps(&pTo[i + 3].x);
+            _MM_TRANSPOSE4_PS(bx, by, bz, bw);
+
+            const __m128 amounts = _mm_loadu_ps(pAmounts + i);
+
+            // Normalize
+            __m128 aLength = _mm_sqrt_ps(
+                _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(ax, ax), _mm_mul_ps(ay, ay)),
+                    _mm_add_ps(_mm_mul_ps(az, az), _mm_mul_ps(aw, aw))
+                )
+            );
+            ax = _mm_div_ps(ax, aLength);
+            ay = _mm_div_ps(ay, aLength);
+            az = _mm_div_ps(az, aLength);
+            aw = _mm_div_ps(aw, aLength);
+
+            __m128 bLength = _mm_sqrt_ps(
+                _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(bx, bx), _mm_mul_ps(by, by)),
+                    _mm_add_ps(_mm_mul_ps(bz, bz), _mm_mul_ps(bw, bw))
+                )
+            );
+            bx = _mm_div_ps(bx, bLength);
+            by = _mm_div_ps(by, bLength);
+            bz = _mm_div_ps(bz, bLength);
+            bw = _mm_div_ps(bw, bLength);
+
+            __m128 dot = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)),
+                _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw))
+            );
+
+            // Take the shorter path by flipping b where dot is negative
+            const __m128 negativeSign = _mm_and_ps(dot, signBit);
+            bx = _mm_xor_ps(bx, negativeSign);
+            by = _mm_xor_ps(by, negativeSign);
+            bz = _mm_xor_ps(bz, negativeSign);
+            bw = _mm_xor_ps(bw, negativeSign);
+            dot = _mm_xor_ps(dot, negativeSign);
+
+            const __m128 lerpMask = _mm_cmpgt_ps(dot, dotThreshold);
+
+            alignas(16) float dots[4];
+            alignas(16) float amountValues[4];
+            alignas(16) float s0Values[4];
+            alignas(16) float s1Values[4];
+            _mm_store_ps(dots, dot);
+            _mm_store_ps(amountValues, amounts);
+            const int lerpBits = _mm_movemask_ps(lerpMask);
+            for (int j = 0; j < 4; ++j)
+            {
+                if (lerpBits & (1 << j))
+                {
+                    s0Values[j] = 1.0f - amountValues[j];
+                    s1Values[j] = amountValues[j];
+                    continue;
+                }
+                const float theta0 = acos(dots[j]);
+                const float theta = theta0 * amountValues[j];
+                const float sinTheta = sin(theta);
+                const float sinTheta0 = sin(theta0);
+                s0Values[j] = cos(theta) - dots[j] * sinTheta / sinTheta0;
+                s1Values[j] = sinTheta / sinTheta0;
+            }
+            const __m128 s0 = _mm_load_ps(s0Values);
+            const __m128 s1 = _mm_load_ps(s1Values);
+
+            __m128 rx = _mm_add_ps(_mm_mul_ps(ax, s0), _mm_mul_ps(bx, s1));
+            __m128 ry = _mm_add_ps(_mm_mul_ps(ay, s0), _mm_mul_ps(by, s1));
+            __m128 rz = _mm_add_ps(_mm_mul_ps(az, s0), _mm_mul_ps(bz, s1));
+            __m128 rw = _mm_add_ps(_mm_mul_ps(aw, s0), _mm_mul_ps(bw, s1));
+
+            // Lerped ones need to be normalized
+            if (lerpBits)
+            {
+                const __m128 length = _mm_sqrt_ps(
+                    _mm_add_ps(
+                        _mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)),
+                        _mm_add_ps(_mm_mul_ps(rz, rz), _mm_mul_ps(rw, rw))
+                    )
+                );
+                const __m128 divisor = _mm_or_ps(
+                    _mm_and_ps(lerpMask, length),
+                    _mm_andnot_ps(lerpMask, _mm_set1_ps(1.0f))
+                );
+                rx = _mm_div_ps(rx, divisor);
+                ry = _mm_div_ps(ry, divisor);
+                rz = _mm_div_ps(rz, divisor);
+                rw = _mm_div_ps(rw, divisor);
+            }
+
+            _MM_TRANSPOSE4_PS(rx, ry, rz, rw);
+            _mm_storeu_ps(&pOutResults[i].x, rx);
+            _mm_storeu_ps(&pOutResults[i + 1].x, ry);
+            _mm_storeu_ps(&pOutResults[i + 2].x, rz);
+            _mm_storeu_ps(&pOutResults[i + 3].x, rw);
+        }
+    #endif
+        for (; i < count; ++i)
+            pOutResults[i] = pFrom[i].slerp(pTo[i], pAmounts[i]);
+    }
+
+    void create_transformation_matrices(
+        const Vector3f* pPositions,
+        const Quaternion* pRotations,
+        const Vector3f* pScales,
+        Matrix4f* pOutResults,
+        size_t count
+    )
+    {
+        for (size_t i = 0; i < count; ++i)
+            pOutResults[i] = create_transformation_matrix(pPositions[i], pRotations[i], pScales[i]);
+    }
+
+
+    namespace scalar
+    {
+        Matrix4f multiply(const Matrix4f& left, const Matrix4f& right)
+        {
+            Matrix4f result;
+
+            for (int y = 0; y < 4; ++y)
+            {
+                for (int x = 0; x < 4; ++x)
+                {
+                    result[y + x * 4] =
+                        left[y + 0 * 4] * right[0 + x * 4] +
+                        left[y + 1 * 4] * right[1 + x * 4] +
+                        left[y + 2 * 4] * right[2 + x * 4] +
+                        left[y + 3 * 4] * right[3 + x * 4];
+                }
+            }
+
+            return result;
+        }
+
+        Vector4f multiply(const Matrix4f& left, const Vector4f& right)
+        {
+            Vector4f result;
+            result.x = left[0 + 0 * 4] * right.x + left[0 + 1 * 4] * right.y + left[0 + 2 * 4] * right.z + left[0 + 3 * 4] * right.w;
+            result.y = left[1 + 0 * 4] * right.x + left[1 + 1 * 4] * right.y + left[1 + 2 * 4] * right.z + left[1 + 3 * 4] * right.w;
+            result.z = left[2 + 0 * 4] * right.x + left[2 + 1 * 4] * right.y + left[2 + 2 * 4] * right.z + left[2 + 3 * 4] * right.w;
+            result.w = left[3 + 0 * 4] * right.x + left[3 + 1 * 4] * right.y + left[3 + 2 * 4] * right.z + left[3 + 3 * 4] * right.w;
+            return result;
+        }
+
+        // Found from: https://stackoverflow.com/questions/1148309/inverting-a-4x4-matrix
+        //     Comment on the site about this :
+        //         "This was lifted from MESA implementation of the GLU library."
+        Matrix4f inverse(const Matrix4f& matrix)
+        {
+            const float* m = matrix.getRawArray();
+            Matrix4f inverseMatrix;
+            inverseMatrix[0] = m[5] * m[10] * m[15] -
+                m[5] * m[11] * m[14] -
+                m[9] * m[6] * m[15] +
+                m[9] * m[7] * m[14] +
+                m[13] * m[6] * m[11] -
+                m[13] * m[7] * m[10];
+
+            inverseMatrix[4] = -m[4] * m[10] * m[15] +
+                m[4] * m[11] * m[14] +
+                m[8] * m[6] * m[15] -
+                m[8] * m[7] * m[14] -
+                m[12] * m[6] * m[11] +
+                m[12] * m[7] * m[10];
+
+            inverseMatrix[8] = m[4] * m[9] * m[15] -
+                m[4] * m[11] * m[13] -
+                m[8] * m[5] * m[15] +
+                m[8] * m[7] * m[13] +
+                m[12] * m[5] * m[11] -
+                m[12] * m[7] * m[9];
+
+            inverseMatrix[12] = -m[4] * m[9] * m[14] +
+                m[4] * m[10] * m[13] +
+                m[8] * m[5] * m[14] -
+                m[8] * m[6] * m[13] -
+                m[12] * m[5] * m[10] +
+                m[12] * m[6] * m[9];
+
+            inverseMatrix[1] = -m[1] * m[10] * m[15] +
+                m[1] * m[11] * m[14] +
+                m[9] * m[2] * m[15] -
+                m[9] * m[3] * m[14] -
+                m[13] * m[2] * m[11] +
+                m[13] * m[3] * m[10];
+
+            inverseMatrix[5] = m[0] * m[10] * m[15] -
+                m[0] * m[11] * m[14] -
+                m[8] * m[2] * m[15] +
+                m[8] * m[3] * m[14] +
+                m[12] * m[2] * m[11] -
+                m[12] * m[3] * m[10];
+
+            inverseMatrix[9] = -m[0] * m[9] * m[15] +
+                m[0] * m[11] * m[13] +
+                m[8] * m[1] * m[15] -
+                m[8] * m[3] * m[13] -
+                m[12] * m[1] * m[11] +
+                m[12] * m[3] * m[9];
+
+            inverseMatrix[13] = m[0] * m[9] * m[14] -
+                m[0] * m[10] * m[13] -
+                m[8] * m[1] * m[14] +
+                m[8] * m[2] * m[13] +
+                m[12] * m[1] * m[10] -
+                m[12] * m[2] * m[9];
+
+            inverseMatrix[2] = m[1] * m[6] * m[15] -
+                m[1] * m[7] * m[14] -
+                m[5] * m[2] * m[15] +
+                m[5] * m[3] * m[14] +
+                m[13] * m[2] * m[7] -
+                m[13] * m[3] * m[6];
+
+            inverseMatrix[6] = -m[0] * m[6] * m[15] +
+                m[0] * m[7] * m[14] +
+                m[4] * m[2] * m[15] -
+                m[4] * m[3] * m[14] -
+                m[12] * m[2] * m[7] +
+                m[12] * m[3] * m[6];
+
+            inverseMatrix[10] = m[0] * m[5] * m[15] -
+                m[0] * m[7] * m[13] -
+                m[4] * m[1] * m[15] +
+                m[4] * m[3] * m[13] +
+                m[12] * m[1] * m[7] -
+                m[12] * m[3] * m[5];
+
+            inverseMatrix[14] = -m[0] * m[5] * m[14] +
+                m[0] * m[6] * m[13] +
+                m[4] * m[1] * m[14] -
+                m[4] * m[2] * m[13] -
+                m[12] * m[1] * m[6] +
+                m[12] * m[2] * m[5];
+
+            inverseMatrix[3] = -m[1] * m[6] * m[11] +
+                m[1] * m[7] * m[10] +
+                m[5] * m[2] * m[11] -
+                m[5] * m[3] * m[10] -
+                m[9] * m[2] * m[7] +
+                m[9] * m[3] * m[6];
+
+            inverseMatrix[7] = m[0] * m[6] * m[11] -
+                m[0] * m[7] * m[10] -
+                m[4] * m[2] * m[11] +
+                m[4] * m[3] * m[10] +
+                m[8] * m[2] * m[7] -
+                m[8] * m[3] * m[6];
+
+            inverseMatrix[11] = -m[0] * m[5] * m[11] +
+                m[0] * m[7] * m[9] +
+                m[4] * m[1] * m[11] -
+                m[4] * m[3] * m[9] -
+                m[8] * m[1] * m[7] +
+                m[8] * m[3] * m[5];
+
+            inverseMatrix[15] = m[0] * m[5] * m[10] -
+                m[0] * m[6] * m[9] -
+                m[4] * m[1] * m[10] +
+                m[4] * m[2] * m[9] +
+                m[8] * m[1] * m[6] -
+                m[8] * m[2] * m[5];
+
+
+            float determinant = m[0] * inverseMatrix[0] + m[1] * inverseMatrix[4] + m[2] * inverseMatrix[8] + m[3] * inverseMatrix[12];
+
+            if (determinant == 0)
+                return inverseMatrix;
+
+            for (int i = 0; i < 16; ++i)
+                inverseMatrix[i] *= (1.0f / determinant);
+
+            return inverseMatrix;
+        }
+
+        // Copied from wikipedia : https://en.wikipedia.org/wiki/Slerp
+        Quaternion slerp(const Quaternion& from, const Quaternion& to, float amount)
+        {
+            // Only unit quaternions are valid rotations.
+            // Normalize to avoid undefined behavior.
+            Quaternion ua = from.normalize();
+            Quaternion ub = to.normalize();
+
+            // Compute the cosine of the angle between the two vectors.
+            float dot = ua.dotp(ub);
+
+            // If the dot product is negative, slerp won't take
+            // the shorter path. Note that v1 and -v1 are equivalent when
+            // the negation is applied to all four components. Fix by
+            // reversing one quaternion.
+            if (dot < 0.0f) {
+                ub = ub * -1.0f;
+                dot = -dot;
+            }
+
+            if (dot > QUATERNION_SLERP__DOT_THRESHOLD)
+            {
+                // If the inputs are too close for comfort, linearly interpolate
+                // and normalize the result.
+                Quaternion result = ua + ((ub - ua) * amount);
+                return result.normalize();
+            }
+
+            // Since dot is in range [0, DOT_THRESHOLD], acos is safe
+            float theta_0 = acos(dot);        // theta_0 = angle between input vectors
+            float theta = theta_0 * amount;   // theta = angle between v0 and result
+            float sin_theta = sin(theta);     // compute this value only once
+            float sin_theta_0 = sin(theta_0); // compute this value only once
+
+            float s0 = cos(theta) - dot * sin_theta / sin_theta_0;  // == sin(theta_0 - theta) / sin(theta_0)
+            float s1 = sin_theta / sin_theta_0;
+
+            return (ua * s0) + (ub * s1);
+        }
+
+        Matrix4f create_transformation_matrix(
+            const Vector3f& pos,
+            const Quaternion& rotation,
+            const Vector3f& scale
+        )
+        {
+            Matrix4f translationMatrix(1.0f);
+            translationMatrix[0 + 3 * 4] = pos.x;
+            translationMatrix[1 + 3 * 4] = pos.y;
+            translationMatrix[2 + 3 * 4] = pos.z;
+
+            Matrix4f scaleMatrix(1.0f);
+            scaleMatrix[0 + 0 * 4] = scale.x;
+            scaleMatrix[1 + 1 * 4] = scale.y;
+            scaleMatrix[2 + 2 * 4] = scale.z;
+
+            Matrix4f rotationMatrix = rotation.toRotationMatrix();
+
+            // NOTE: Not sure is the order correct...
+            return translationMatrix * rotationMatrix * scaleMatrix;
+        }
+    }
 }
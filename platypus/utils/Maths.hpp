@@ -5,6 +5,16 @@
 
 #define PLATY_MATH_PI 3.14159265358979323846
 
+// Matrix multiplication, inverse, slerp and transformation matrix creation
+// use SSE if available (AVX additionally for matrix multiplication if compiled
+// with AVX enabled). Define PLATYPUS_MATHS_NO_SIMD to use only the scalar versions.
+#if !defined(PLATYPUS_MATHS_NO_SIMD) && !defined(PLATYPUS_BUILD_WEB) && (defined(__SSE2__) || defined(_M_X64))
+    #define PLATYPUS_MATHS_SSE 1
+    #if defined(__AVX__)
+        #define PLATYPUS_MATHS_AVX 1
+    #endif
+#endif
+
 
 namespace platypus
 {
@@ -190,4 +200,61 @@ namespace platypus
     );
 
     std::string to_string(float value);
+
+
+    // Batch versions of the heavier operations for processing whole arrays at once.
+    // Output arrays may be the same as the input arrays.
+
+    // pOutResults[i] = pLeft[i] * pRight[i]
+    void multiply_matrices(
+        const Matrix4f* pLeft,
+        const Matrix4f* pRight,
+        Matrix4f* pOutResults,
+        size_t count
+    );
+    // pOutResults[i] = left * pRight[i]
+    void multiply_matrices(
+        const Matrix4f& left,
+        const Matrix4f* pRight,
+        Matrix4f* pOutResults,
+        size_t count
+    );
+    // pOutResults[i] = matrix * pPoints[i]
+    void transform_points(
+        const Matrix4f& matrix,
+        const Vector4f* pPoints,
+        Vector4f* pOutResults,
+        size_t count
+    );
+    // pOutResults[i] = pFrom[i].slerp(pTo[i], pAmounts[i])
+    void slerp_quaternions(
+        const Quaternion* pFrom,
+        const Quaternion* pTo,
+        const float* pAmounts,
+        Quaternion* pOutResults,
+        size_t count
+    );
+    void create_transformation_matrices(
+        const Vector3f* pPositions,
+        const Quaternion* pRotations,
+        const Vector3f* pScales,
+        Matrix4f* pOutResults,
+        size_t count
+    );
+
+
+    // Plain scalar versions of the SIMD accelerated operations.
+    // Used if SIMD isn't available and for comparing the results and performance.
+    namespace scalar
+    {
+        Matrix4f multiply(const Matrix4f& left, const Matrix4f& right);
+        Vector4f multiply(const Matrix4f& left, const Vector4f& right);
+        Matrix4f inverse(const Matrix4f& matrix);
+        Quaternion slerp(const Quaternion& from, const Quaternion& to, float amount);
+        Matrix4f create_transformation_matrix(
+            const Vector3f& pos,
+            const Quaternion& rotation,
+            const Vector3f& scale
+        );
+    }
 }
@@ -132,6 +132,7 @@ namespace platypus
             ComponentType::COMPONENT_TYPE_TRANSFORM
         );
         pTransform->globalMatrix = translationMatrix * create_rotation_matrix(-_pitch, -_yaw, 0.0f);
+        pTransform->dirty = true;
     }
 
     void CameraController::set(
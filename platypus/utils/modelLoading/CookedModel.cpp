@@ -0,0 +1,366 @@
+#include "CookedModel.hpp"
+#include "platypus/utils/MappedFile.hpp"
+#include "platypus/core/Debug.hpp"
+#include <cstring>
+
+
+namespace platypus
+{
+    static void write_bytes(std::vector<char>& buffer, const void* pData, size_t size)
+    {
+        const size_t prevSize = buffer.size();
+        buffer.resize(prevSize + size);
+        if (size > 0)
+            memcpy(buffer.data() + prevSize, pData, size);
+    }
+
+    template <typename T>
+    static void write_value(std::vector<char>& buffer, const T& value)
+    {
+        write_bytes(buffer, &value, sizeof(T));
+    }
+
+    static void write_string(std::vector<char>& buffer, const std::string& str)
+    {
+        write_value(buffer, static_cast<uint32_t>(str.size()));
+        write_bytes(buffer, str.data(), str.size());
+    }
+
+    template <typename T>
+    static void write_array(std::vector<char>& buffer, const std::vector<T>& values)
+    {
+        write_value(buffer, static_cast<uint32_t>(values.size()));
+        write_bytes(buffer, values.data(), sizeof(T) * values.size());
+    }
+
+    static void write_mesh_buffer(std::vector<char>& buffer, const MeshBufferData& bufferData)
+    {
+        write_value(buffer, static_cast<uint64_t>(bufferData.elementSize));
+        write_value(buffer, static_cast<uint64_t>(bufferData.length));
+        write_value(buffer, static_cast<uint64_t>(bufferData.rawData.size()));
+        write_bytes(buffer, bufferData.rawData.data(), bufferData.rawData.size());
+    }
+
+    // Reading stops at the first read past the end of the data
+    struct CookedDataReader
+    {
+        DataView data;
+        size_t pos = 0;
+        bool valid = true;
+
+        bool read(void* pOut, size_t size)
+        {
+            if (!valid || size > data.size() - pos)
+            {
+                valid = false;
+                return false;
+            }
+            if (size > 0)
+                memcpy(pOut, data.data() + pos, size);
+            pos += size;
+            return true;
+        }
+
+        template <typename T>
+        T readValue()
+        {
+            T value{};
+            read(&value, sizeof(T));
+            return value;
+        }
+
+        std::string readString()
+        {
+            const size_t size = readValue<uint32_t>();
+            if (!valid || size > data.size() - pos)
+            {
+                valid = false;
+                return "";
+            }
+            std::string str(data.data() + pos, size);
+            pos += size;
+            return str;
+        }
+
+        template <typename T>
+        void readArray(std::vector<T>& outValues)
+        {
+            const size_t count = readValue<uint32_t>();
+            if (!valid || count > (data.size() - pos) / sizeof(T))
+            {
+                valid = false;
+                return;
+            }
+            outValues.resize(count);
+            read(outValues.data(), sizeof(T) * count);
+        }
+
+        void readMeshBuffer(MeshBufferData& outBufferData)
+        {
+            outBufferData.elementSize = static_cast<size_t>(readValue<uint64_t>());
+            outBufferData.length = static_cast<size_t>(readValue<uint64_t>());
+            const size_t size = static_cast<size_t>(readValue<uint64_t>());
+            if (!valid || size > data.size() - pos || size != outBufferData.elementSize * outBufferData.length)
+            {
+                valid = false;
+                return;
+            }
+            outBufferData.rawData.resize(size);
+            read(outBufferData.rawData.data(), size);
+        }
+    };
+
+    bool is_cooked_model_file(const std::string& filepath)
+    {
+        const size_t extensionLength = strlen(cooked_model_extension);
+        return filepath.size() >= extensionLength &&
+            filepath.compare(filepath.size() - extensionLength, extensionLength, cooked_model_extension) == 0;
+    }
+
+    void shrink_index_buffers(MeshData& meshData)
+    {
+        for (MeshBufferData& indexBuffer : meshData.indexBufferData)
+        {
+            if (indexBuffer.elementSize != sizeof(uint32_t))
+                continue;
+
+            const uint32_t* pIndices = reinterpret_cast<const uint32_t*>(indexBuffer.rawData.data());
+            bool fits = true;
+            for (size_t i = 0; i < indexBuffer.length && fits; ++i)
+                fits = pIndices[i] <= 0xFFFF;
+            if (!fits)
+                continue;
+
+            std::vector<PE_byte> shrunk(sizeof(uint16_t) * indexBuffer.length);
+            uint16_t* pShrunk = reinterpret_cast<uint16_t*>(shrunk.data());
+            for (size_t i = 0; i < indexBuffer.length; ++i)
+                pShrunk[i] = static_cast<uint16_t>(pIndices[i]);
+
+            indexBuffer.elementSize = sizeof(uint16_t);
+            indexBuffer.rawData.swap(shrunk);
+        }
+    }
+
+    /*
+        Serialized format:
+            uint32_t magic
+            uint32_t version
+
+            uint32_t meshCount
+            For each mesh:
+                string name (uint32_t size, char data[size])
+                Matrix4f transformationMatrix
+                AABB aabb
+                BoundingSphere boundingSphere
+                uint32_t vertexBufferLayoutSize
+                char vertexBufferLayout[vertexBufferLayoutSize]
+                mesh buffer (uint64_t elementSize, uint64_t length, uint64_t size, char data[size])
+                uint32_t indexBufferCount
+                mesh buffer indexBuffers[indexBufferCount]
+
+            uint32_t skeletonCount
+            For each skeleton:
+                string name
+                uint32_t jointCount
+                For each joint:
+                    Vector3f translation, Quaternion rotation, Vector3f scale
+                    Matrix4f matrix, Matrix4f inverseMatrix
+                    string name
+                    uint32_t childCount, uint32_t children[childCount]
+                uint32_t animationCount
+                For each animation:
+                    float length
+                    string name
+                    uint32_t jointCount
+                    For each joint: translation, rotation and scale key arrays
+                    (uint32_t count, keys[count])
+    */
+    std::vector<char> create_cooked_model(
+        const std::vector<MeshData>& meshes,
+        const std::vector<SkeletonData>& skeletons
+    )
+    {
+        std::vector<char> buffer;
+        write_value(buffer, cooked_model_magic);
+        write_value(buffer, cooked_model_version);
+
+        write_value(buffer, static_cast<uint32_t>(meshes.size()));
+        for (const MeshData& meshData : meshes)
+        {
+            write_string(buffer, meshData.name);
+            write_value(buffer, meshData.transformationMatrix);
+            write_value(buffer, meshData.aabb);
+            write_value(buffer, meshData.boundingSphere);
+
+            const std::vector<char> layoutData = meshData.vertexBufferLayout.serialize();
+            write_value(buffer, static_cast<uint32_t>(layoutData.size()));
+            write_bytes(buffer, layoutData.data(), layoutData.size());
+
+            write_mesh_buffer(buffer, meshData.vertexBufferData);
+            write_value(buffer, static_cast<uint32_t>(meshData.indexBufferData.size()));
+            for (const MeshBufferData& indexBuffer : meshData.indexBufferData)
+                write_mesh_buffer(buffer, indexBuffer);
+        }
+
+        write_value(buffer, static_cast<uint32_t>(skeletons.size()));
+        for (const SkeletonData& skeletonData : skeletons)
+        {
+            write_string(buffer, skeletonData.name);
+
+            const Pose& bindPose = skeletonData.bindPose;
+            write_value(buffer, static_cast<uint32_t>(bindPose.joints.size()));
+            for (size_t i = 0; i < bindPose.joints.size(); ++i)
+            {
+                const Joint& joint = bindPose.joints[i];
+                write_value(buffer, joint.translation);
+                write_value(buffer, joint.rotation);
+                write_value(buffer, joint.scale);
+                write_value(buffer, joint.matrix);
+                write_value(buffer, joint.inverseMatrix);
+                write_string(buffer, joint.name);
+                if (i < bindPose.jointChildMapping.size())
+                    write_array(buffer, bindPose.jointChildMapping[i]);
+                else
+                    write_value(buffer, static_cast<uint32_t>(0));
+            }
+
+            write_value(buffer, static_cast<uint32_t>(skeletonData.animations.size()));
+            for (const KeyframeAnimationData& animation : skeletonData.animations)
+            {
+                write_value(buffer, animation.length);
+                write_string(buffer, animation.name);
+                write_value(buffer, static_cast<uint32_t>(animation.keyframes.size()));
+                for (const JointAnimationData& jointAnimation : animation.keyframes)
+                {
+                    write_array(buffer, jointAnimation.translations);
+                    write_array(buffer, jointAnimation.rotations);
+                    write_array(buffer, jointAnimation.scales);
+                }
+            }
+        }
+        return buffer;
+    }
+
+    bool deserialize_cooked_model(
+        const DataView& data,
+        std::vector<MeshData>& outMeshes,
+        std::vector<SkeletonData>& outSkeletons
+    )
+    {
+        CookedDataReader reader{ data };
+        const uint32_t magic = reader.readValue<uint32_t>();
+        const uint32_t version = reader.readValue<uint32_t>();
+        if (magic != cooked_model_magic || version != cooked_model_version)
+        {
+            Debug::log(
+                "Data wasn't a cooked model or its version(" + std::to_string(version) + ") "
+                "wasn't supported. Current version is " + std::to_string(cooked_model_version),
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            return false;
+        }
+
+        const uint32_t meshCount = reader.readValue<uint32_t>();
+        for (uint32_t meshIndex = 0; meshIndex < meshCount && reader.valid; ++meshIndex)
+        {
+            MeshData meshData;
+            meshData.name = reader.readString();
+            meshData.transformationMatrix = reader.readValue<Matrix4f>();
+            meshData.aabb = reader.readValue<AABB>();
+            meshData.boundingSphere = reader.readValue<BoundingSphere>();
+
+            const size_t layoutSize = reader.readValue<uint32_t>();
+            if (!reader.valid || layoutSize > data.size() - reader.pos)
+                break;
+            meshData.vertexBufferLayout = VertexBufferLayout::deserialize(data, reader.pos);
+            reader.pos += layoutSize;
+
+            reader.readMeshBuffer(meshData.vertexBufferData);
+            const uint32_t indexBufferCount = reader.readValue<uint32_t>();
+            for (uint32_t i = 0; i < indexBufferCount && reader.valid; ++i)
+            {
+                MeshBufferData indexBuffer;
+                reader.readMeshBuffer(indexBuffer);
+                meshData.indexBufferData.push_back(std::move(indexBuffer));
+            }
+            outMeshes.push_back(std::move(meshData));
+        }
+
+        const uint32_t skeletonCount = reader.readValue<uint32_t>();
+        for (uint32_t skeletonIndex = 0; skeletonIndex < skeletonCount && reader.valid; ++skeletonIndex)
+        {
+            SkeletonData skeletonData;
+            skeletonData.name = reader.readString();
+
+            const uint32_t jointCount = reader.readValue<uint32_t>();
+            for (uint32_t i = 0; i < jointCount && reader.valid; ++i)
+            {
+                Joint joint;
+                joint.translation = reader.readValue<Vector3f>();
+                joint.rotation = reader.readValue<Quaternion>();
+                joint.scale = reader.readValue<Vector3f>();
+                joint.matrix = reader.readValue<Matrix4f>();
+                joint.inverseMatrix = reader.readValue<Matrix4f>();
+                joint.name = reader.readString();
+                skeletonData.bindPose.joints.push_back(joint);
+
+                std::vector<uint32_t> childIndices;
+                reader.readArray(childIndices);
+                skeletonData.bindPose.jointChildMapping.push_back(childIndices);
+            }
+
+            const uint32_t animationCount = reader.readValue<uint32_t>();
+            for (uint32_t i = 0; i < animationCount && reader.valid; ++i)
+            {
+                KeyframeAnimationData animation;
+                animation.length = reader.readValue<float>();
+                animation.name = reader.readString();
+                const uint32_t animatedJointCount = reader.readValue<uint32_t>();
+                for (uint32_t j = 0; j < animatedJointCount && reader.valid; ++j)
+                {
+                    JointAnimationData jointAnimation;
+                    reader.readArray(jointAnimation.translations);
+                    reader.readArray(jointAnimation.rotations);
+                    reader.readArray(jointAnimation.scales);
+                    animation.keyframes.push_back(std::move(jointAnimation));
+                }
+                skeletonData.animations.push_back(std::move(animation));
+            }
+            outSkeletons.push_back(std::move(skeletonData));
+        }
+
+        if (!reader.valid)
+        {
+            Debug::log(
+                "Cooked model data ended unexpectedly",
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            return false;
+        }
+        return true;
+    }
+
+    bool load_cooked_model(
+        const std::string& filepath,
+        std::vector<MeshData>& outMeshes,
+        std::vector<SkeletonData>& outSkeletons
+    )
+    {
+        MappedFile file;
+        if (!file.open(filepath))
+            return false;
+
+        if (!deserialize_cooked_model(file.getView(), outMeshes, outSkeletons))
+        {
+            Debug::log(
+                "Failed to load cooked model from: " + filepath,
+                PLATYPUS_CURRENT_FUNC_NAME,
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+            return false;
+        }
+        return true;
+    }
+}
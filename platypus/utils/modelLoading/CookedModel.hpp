@@ -0,0 +1,40 @@
+#pragma once
+
+#include "RawMeshData.hpp"
+#include "platypus/utils/DataView.hpp"
+#include <vector>
+#include <string>
+
+
+namespace platypus
+{
+    // Cooked model = the MeshData and SkeletonData as load_gltf_model outputs them,
+    // written by the asset cooker.
+    // -> Loading one is just reading the data, no glTF parsing or vertex attribute processing.
+    // NOTE: Written in the cooking machine's native byte order and struct layouts!
+    constexpr const char* cooked_model_extension = ".pemodel";
+    constexpr uint32_t cooked_model_magic = 0x444D4550; // "PEMD"
+    constexpr uint32_t cooked_model_version = 1;
+
+    bool is_cooked_model_file(const std::string& filepath);
+
+    // Converts 32 bit indices to 16 bit if all the indices fit
+    void shrink_index_buffers(MeshData& meshData);
+
+    std::vector<char> create_cooked_model(
+        const std::vector<MeshData>& meshes,
+        const std::vector<SkeletonData>& skeletons
+    );
+
+    bool deserialize_cooked_model(
+        const DataView& data,
+        std::vector<MeshData>& outMeshes,
+        std::vector<SkeletonData>& outSkeletons
+    );
+
+    bool load_cooked_model(
+        const std::string& filepath,
+        std::vector<MeshData>& outMeshes,
+        std::vector<SkeletonData>& outSkeletons
+    );
+}
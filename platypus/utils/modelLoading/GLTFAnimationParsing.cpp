@@ -215,7 +215,6 @@ namespace platypus
                 PE_byte* pAnimData = (PE_byte*)&animDataBuffer.data[animDataAccessor.byteOffset + bufferView.byteOffset];
 
                 const std::string& path = channel.target_path;
-                // TODO: Scale
                 if (path == "translation")
                 {
                     std::vector<Vector3f> data(animDataAccessor.count);
@@ -266,6 +265,30 @@ namespace platypus
                         );
                     }
                 }
+                else if (path == "scale")
+                {
+                    std::vector<Vector3f> data(animDataAccessor.count);
+                    memcpy((void*)data.data(), pAnimData, animDataAccessor.count * sizeof(Vector3f));
+
+                    if (keyframes.size() != data.size())
+                    {
+                        Debug::log(
+                            "@load_gltf_animations "
+                            "Mismatch in keyframe and joint scale counts!",
+                            Debug::MessageType::PLATYPUS_ERROR
+                        );
+                        PLATYPUS_ASSERT(false);
+                        return { };
+                    }
+                    for (size_t i = 0; i < data.size(); ++i)
+                    {
+                        float time = keyframes[i];
+                        maxKeyframeTime = std::max(maxKeyframeTime, time);
+                        animations[animationIndex].keyframes[targetPoseJoint].scales.push_back(
+                            { time, data[i] }
+                        );
+                    }
+                }
             }
             animations[animationIndex].length = maxKeyframeTime;
             animations[animationIndex].name = gltfAnimation.name;
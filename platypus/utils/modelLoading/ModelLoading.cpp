@@ -1,4 +1,5 @@
 #include "ModelLoading.hpp"
+#include "CookedModel.hpp"
 #include "platypus/core/Debug.hpp"
 #include <unordered_map>
 
@@ -39,7 +40,9 @@ namespace platypus
         std::string error;
         std::string warning;
 
-        std::string ext = filepath.substr(filepath.find("."), filepath.size());
+        // NOTE: Using the last dot, so relative paths like "../assets/model.glb" work
+        const size_t extPos = filepath.find_last_of('.');
+        std::string ext = extPos != std::string::npos ? filepath.substr(extPos) : "";
         bool ret = false;
         if (ext == ".glb")
             ret = loader.LoadBinaryFromFile(&gltfModel, &error, &warning, filepath); // for binary glTF(.glb)
@@ -159,6 +162,17 @@ namespace platypus
             m.vertexBufferData = vertexBuffer;
             m.indexBufferData = indexBuffers;
             m.transformationMatrix = transformationMatrix;
+            m.aabb = create_aabb(
+                vertexBufferLayout,
+                vertexBuffer.rawData.data(),
+                vertexBuffer.rawData.size()
+            );
+            m.boundingSphere = create_bounding_sphere(
+                m.aabb,
+                vertexBufferLayout,
+                vertexBuffer.rawData.data(),
+                vertexBuffer.rawData.size()
+            );
             m.name = node.name;
 
             outMeshes.push_back(m);
@@ -186,4 +200,16 @@ namespace platypus
 
         return true;
     }
+
+    bool load_model_data(
+        const std::string& filepath,
+        std::vector<MeshData>& outMeshes,
+        std::vector<SkeletonData>& outSkeletons
+    )
+    {
+        if (is_cooked_model_file(filepath))
+            return load_cooked_model(filepath, outMeshes, outSkeletons);
+
+        return load_gltf_model(filepath, outMeshes, outSkeletons);
+    }
 }
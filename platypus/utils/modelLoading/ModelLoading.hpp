@@ -19,4 +19,11 @@ namespace platypus
         std::vector<MeshData>& outMeshes,
         std::vector<SkeletonData>& outSkeletons
     );
+
+    // Loads either glTF(.glb, .gltf) or cooked(.pemodel) model depending on the file extension
+    bool load_model_data(
+        const std::string& filepath,
+        std::vector<MeshData>& outMeshes,
+        std::vector<SkeletonData>& outSkeletons
+    );
 }
@@ -3,6 +3,7 @@
 #include "platypus/graphics/Buffers.hpp"
 #include "platypus/utils/Maths.hpp"
 #include "platypus/utils/AnimationDataUtils.hpp"
+#include "platypus/utils/Bounds.hpp"
 #include "platypus/Common.h"
 #include <vector>
 
@@ -22,6 +23,8 @@ namespace platypus
         MeshBufferData vertexBufferData;
         std::vector<MeshBufferData> indexBufferData;
         Matrix4f transformationMatrix = Matrix4f(1.0f);
+        AABB aabb;
+        BoundingSphere boundingSphere;
         std::string name;
     };
 
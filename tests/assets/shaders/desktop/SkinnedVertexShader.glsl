@@ -22,9 +22,10 @@ layout(set = 0, binding = 0) uniform SceneData
 
 
 const int maxJoints = 50;
-layout(set = 1, binding = 0) uniform JointData
+// Joint palettes of all the batch's instances, each maxJoints long
+layout(std430, set = 1, binding = 0) readonly buffer JointData
 {
-    mat4 data[maxJoints];
+    mat4 data[];
 } jointData;
 
 layout(location = 0) out vec3 var_normal;
@@ -40,18 +41,20 @@ void main() {
     //gl_Position = constants.projectionMatrix * camera.viewMatrix * translatedPos;
     //vec4 rotatedNormal = constants.transformationMatrix * vec4(normal, 0.0);
 
+    // NOTE: gl_InstanceIndex includes the batch's first instance
+    int jointOffset = gl_InstanceIndex * maxJoints;
     float weightSum = weights[0] + weights[1] + weights[2] + weights[3];
-    mat4 jointTransform = jointData.data[0];
+    mat4 jointTransform = jointData.data[jointOffset];
     if (weightSum >= 1.0)
     {
-        jointTransform =  jointData.data[int(jointIDs[0])] * weights[0];
-	    jointTransform += jointData.data[int(jointIDs[1])] * weights[1];
-	    jointTransform += jointData.data[int(jointIDs[2])] * weights[2];
-	    jointTransform += jointData.data[int(jointIDs[3])] * weights[3];
+        jointTransform =  jointData.data[jointOffset + int(jointIDs[0])] * weights[0];
+	    jointTransform += jointData.data[jointOffset + int(jointIDs[1])] * weights[1];
+	    jointTransform += jointData.data[jointOffset + int(jointIDs[2])] * weights[2];
+	    jointTransform += jointData.data[jointOffset + int(jointIDs[3])] * weights[3];
     }
     else
     {
-        jointTransform = jointData.data[int(jointIDs[0])];
+        jointTransform = jointData.data[jointOffset + int(jointIDs[0])];
     }
 
     vec4 translatedPos = jointTransform * vec4(position, 1.0);
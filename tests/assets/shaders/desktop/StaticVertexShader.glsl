@@ -3,6 +3,7 @@
 layout(location = 0) in vec3 position;
 layout(location = 1) in vec3 normal;
 layout(location = 2) in vec2 texCoord;
+layout(location = 3) in mat4 transformationMatrix;
 
 layout(set = 0, binding = 0) uniform SceneData
 {
@@ -17,11 +18,6 @@ layout(set = 0, binding = 0) uniform SceneData
     vec4 shadowProperties;
 } sceneData;
 
-layout(set = 1, binding = 0) uniform InstanceData
-{
-    mat4 transformationMatrix;
-} instanceData;
-
 layout(location = 0) out vec3 var_normal;
 layout(location = 1) out vec2 var_texCoord;
 layout(location = 2) out vec3 var_fragPos;
@@ -31,9 +27,9 @@ layout(location = 5) out vec4 var_lightColor;
 layout(location = 6) out vec4 var_ambientLightColor;
 
 void main() {
-    vec4 translatedPos = instanceData.transformationMatrix * vec4(position, 1.0);
+    vec4 translatedPos = transformationMatrix * vec4(position, 1.0);
     gl_Position = sceneData.projectionMatrix * sceneData.viewMatrix * translatedPos;
-    vec4 rotatedNormal = instanceData.transformationMatrix * vec4(normal, 0.0);
+    vec4 rotatedNormal = transformationMatrix * vec4(normal, 0.0);
     var_normal = rotatedNormal.xyz;
     var_texCoord = texCoord;
     var_fragPos = translatedPos.xyz;
@@ -4,6 +4,7 @@ layout(location = 0) in vec3 position;
 layout(location = 1) in vec3 normal;
 layout(location = 2) in vec2 texCoord;
 layout(location = 3) in vec4 tangent;
+layout(location = 4) in mat4 transformationMatrix;
 
 layout(set = 0, binding = 0) uniform SceneData
 {
@@ -18,11 +19,6 @@ layout(set = 0, binding = 0) uniform SceneData
     vec4 shadowProperties;
 } sceneData;
 
-layout(set = 1, binding = 0) uniform InstanceData
-{
-    mat4 transformationMatrix;
-} instanceData;
-
 layout(location = 0) out vec3 var_normal;
 layout(location = 1) out vec2 var_texCoord;
 layout(location = 2) out vec3 var_fragPos; // in tangent space
@@ -38,8 +34,8 @@ layout(location = 10) out vec4 var_tangent;
 // It seems with specularity as if the light is coming from the opposite direction
 void main()
 {
-    mat4 toCameraSpace = sceneData.viewMatrix * instanceData.transformationMatrix;
-    vec4 transformedPos = instanceData.transformationMatrix * vec4(position, 1.0);
+    mat4 toCameraSpace = sceneData.viewMatrix * transformationMatrix;
+    vec4 transformedPos = transformationMatrix * vec4(position, 1.0);
     gl_Position = sceneData.projectionMatrix * sceneData.viewMatrix * transformedPos;
     var_texCoord = texCoord;
 
@@ -1,4 +1,5 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 layout(location = 0) in vec3 var_normal;
 layout(location = 1) in vec2 var_texCoord;
@@ -8,9 +9,9 @@ layout(location = 4) in vec3 var_lightDir;
 layout(location = 5) in vec4 var_lightColor;
 layout(location = 6) in vec4 var_ambientLightColor;
 
-layout(set = 1, binding = 0) uniform sampler2D diffuseTextureSampler;
-layout(set = 1, binding = 1) uniform sampler2D specularTextureSampler;
-layout(set = 1, binding = 2) uniform MaterialData
+// Material's textures are in the texture array and its data in the material storage buffer.
+// NOTE: textures[0] is always the shadowmap
+struct MaterialData
 {
     // x = specular strength
     // y = shininess
@@ -21,18 +22,34 @@ layout(set = 1, binding = 2) uniform MaterialData
     // x,y = texture offset
     // z,w = texture scale
     vec4 textureProperties;
-} materialData;
+
+    // Indices to the texture array
+    // x = diffuse, y = specular, z = normal, w = unused
+    uvec4 textureIndices;
+};
+layout(std430, set = 2, binding = 0) readonly buffer MaterialBuffer
+{
+    MaterialData materials[];
+};
+layout(set = 2, binding = 1) uniform sampler2D textures[];
+
+layout(push_constant) uniform PushConstants
+{
+    uint materialIndex;
+} pushConstants;
 
 
 layout(location = 0) out vec4 outColor;
 
 void main()
 {
+    MaterialData materialData = materials[pushConstants.materialIndex];
+
     vec2 finalTexCoord = var_texCoord * materialData.textureProperties.zw;
     finalTexCoord = finalTexCoord + materialData.textureProperties.xy;
 
-    vec4 diffuseTextureColor = texture(diffuseTextureSampler, finalTexCoord);
-    vec4 specularTextureColor = texture(specularTextureSampler, finalTexCoord);
+    vec4 diffuseTextureColor = texture(textures[materialData.textureIndices.x], finalTexCoord);
+    vec4 specularTextureColor = texture(textures[materialData.textureIndices.y], finalTexCoord);
 
     float specularStrength = materialData.lightingProperties.x;
     float shininess = materialData.lightingProperties.y;
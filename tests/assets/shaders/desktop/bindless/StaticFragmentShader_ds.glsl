@@ -0,0 +1,84 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(location = 0) in vec3 var_normal;
+layout(location = 1) in vec2 var_texCoord;
+layout(location = 2) in vec3 var_fragPos;
+layout(location = 3) in vec3 var_cameraPos;
+layout(location = 4) in vec3 var_lightDir;
+layout(location = 5) in vec4 var_lightColor;
+layout(location = 6) in vec4 var_ambientLightColor;
+
+// Material's textures are in the texture array and its data in the material storage buffer.
+// NOTE: textures[0] is always the shadowmap
+struct MaterialData
+{
+    // x = specular strength
+    // y = shininess
+    // z = is shadeless
+    // w = unused
+    vec4 lightingProperties;
+
+    // x,y = texture offset
+    // z,w = texture scale
+    vec4 textureProperties;
+
+    // Indices to the texture array
+    // x = diffuse, y = specular, z = normal, w = unused
+    uvec4 textureIndices;
+};
+layout(std430, set = 1, binding = 0) readonly buffer MaterialBuffer
+{
+    MaterialData materials[];
+};
+layout(set = 1, binding = 1) uniform sampler2D textures[];
+
+layout(push_constant) uniform PushConstants
+{
+    uint materialIndex;
+} pushConstants;
+
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+    MaterialData materialData = materials[pushConstants.materialIndex];
+
+    vec2 finalTexCoord = var_texCoord * materialData.textureProperties.zw;
+    finalTexCoord = finalTexCoord + materialData.textureProperties.xy;
+
+    vec4 diffuseTextureColor = texture(textures[materialData.textureIndices.x], finalTexCoord);
+    vec4 specularTextureColor = texture(textures[materialData.textureIndices.y], finalTexCoord);
+    vec4 finalColor = diffuseTextureColor;
+
+    float isShadeless = materialData.lightingProperties.z;
+    if (isShadeless != 1.0)
+    {
+        float specularStrength = materialData.lightingProperties.x;
+        float shininess = materialData.lightingProperties.y;
+
+        vec3 unitLightDir = normalize(var_lightDir.xyz);
+        vec3 toLight = -unitLightDir;
+        vec3 unitNormal = normalize(var_normal);
+        vec3 toCamera = normalize(var_cameraPos - var_fragPos);
+        vec4 lightColor = vec4(var_lightColor.rgb, 1.0);
+
+        float diffuseFactor = max(dot(toLight, unitNormal), 0.0);
+        vec4 lightDiffuseColor = diffuseFactor * lightColor;
+
+        //vec3 reflectedLight = normalize(reflect(unitLightDir, unitNormal));
+        vec3 halfWay = normalize(toLight + toCamera);
+
+        float specularFactor = pow(max(dot(unitNormal, halfWay), 0.0), shininess);
+        vec4 specularColor = lightColor * specularFactor * specularStrength * specularTextureColor;
+
+        finalColor = (var_ambientLightColor + lightDiffuseColor + specularColor) * diffuseTextureColor;
+    }
+
+    if (diffuseTextureColor.a < 0.1)
+    {
+        discard;
+    }
+    outColor = finalColor;
+}
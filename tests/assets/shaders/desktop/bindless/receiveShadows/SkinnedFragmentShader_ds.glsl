@@ -1,4 +1,5 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 layout(location = 0) in vec3 var_normal;
 layout(location = 1) in vec2 var_texCoord;
@@ -11,11 +12,9 @@ layout(location = 6) in vec4 var_ambientLightColor;
 layout(location = 7) in vec4 var_fragPosLightSpace;
 layout(location = 8) in vec4 var_shadowProperties;
 
-//layout(set = 1, binding = 0) uniform sampler2D textureSampler;
-layout(set = 1, binding = 0) uniform sampler2D diffuseTextureSampler;
-layout(set = 1, binding = 1) uniform sampler2D specularTextureSampler;
-layout(set = 1, binding = 2) uniform sampler2D shadowmapTexture;
-layout(set = 1, binding = 3) uniform MaterialData
+// Material's textures are in the texture array and its data in the material storage buffer.
+// NOTE: textures[0] is always the shadowmap
+struct MaterialData
 {
     // x = specular strength
     // y = shininess
@@ -26,11 +25,26 @@ layout(set = 1, binding = 3) uniform MaterialData
     // x,y = texture offset
     // z,w = texture scale
     vec4 textureProperties;
-} materialData;
+
+    // Indices to the texture array
+    // x = diffuse, y = specular, z = normal, w = unused
+    uvec4 textureIndices;
+};
+layout(std430, set = 2, binding = 0) readonly buffer MaterialBuffer
+{
+    MaterialData materials[];
+};
+layout(set = 2, binding = 1) uniform sampler2D textures[];
+
+layout(push_constant) uniform PushConstants
+{
+    layout(offset = 128) uint materialIndex;
+} pushConstants;
 
 
 layout(location = 0) out vec4 outColor;
 
+
 const float minBias = 0.0025;
 const float maxBias = 0.01;
 
@@ -56,7 +70,7 @@ float calcShadow(float bias, int pcfCount)
             if (sampleCoord.x > 1.0 || sampleCoord.x < 0.0 || sampleCoord.y > 1.0 || sampleCoord.y < 0.0)
                 continue;
 
-            float d = texture(shadowmapTexture, sampleCoord).r;
+            float d = texture(textures[0], sampleCoord).r;
             shadow += var_fragPosLightSpace.z > d + bias  ? 1.0 : 0.0;
         }
     }
@@ -68,14 +82,15 @@ float calcShadow(float bias, int pcfCount)
     return shadow;
 }
 
-
 void main()
 {
+    MaterialData materialData = materials[pushConstants.materialIndex];
+
     vec2 finalTexCoord = var_texCoord * materialData.textureProperties.zw;
     finalTexCoord = finalTexCoord + materialData.textureProperties.xy;
 
-    vec4 diffuseTextureColor = texture(diffuseTextureSampler, finalTexCoord);
-    vec4 specularTextureColor = texture(specularTextureSampler, finalTexCoord);
+    vec4 diffuseTextureColor = texture(textures[materialData.textureIndices.x], finalTexCoord);
+    vec4 specularTextureColor = texture(textures[materialData.textureIndices.y], finalTexCoord);
 
     float specularStrength = materialData.lightingProperties.x;
     float shininess = materialData.lightingProperties.y;
@@ -101,7 +116,7 @@ void main()
     float bias = max(maxBias * (1.0 - dot(unitNormal, toLight)), minBias);
     float shadow = min(calcShadow(bias, shadowPCFSampleRadius), shadowStrength);
 
-    vec4 finalColor = (var_ambientLightColor + (1.0 - shadow) * (lightDiffuseColor + specularColor)) * diffuseTextureColor;
+    vec4 finalColor = (var_ambientLightColor + (1.0 - shadow) * lightDiffuseColor + specularColor) * diffuseTextureColor;
 
     if (diffuseTextureColor.a < 0.1)
     {
@@ -1,21 +1,21 @@
-#version 300 es
-precision mediump float;
-
-in vec3 var_normal;
-in vec2 var_texCoord;
-in vec3 var_fragPos;
-in vec3 var_cameraPos;
-in vec4 var_lightDir;
-in vec4 var_lightColor;
-in vec4 var_ambientLightColor;
-
-in vec4 var_fragPosLightSpace;
-in vec4 var_shadowProperties;
-
-uniform sampler2D diffuseTextureSampler;
-uniform sampler2D specularTextureSampler;
-uniform sampler2D shadowmapTexture;
-layout( std140 ) uniform MaterialData
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+
+layout(location = 0) in vec3 var_normal;
+layout(location = 1) in vec2 var_texCoord;
+layout(location = 2) in vec3 var_fragPos;
+layout(location = 3) in vec3 var_cameraPos;
+layout(location = 4) in vec3 var_lightDir;
+layout(location = 5) in vec4 var_lightColor;
+layout(location = 6) in vec4 var_ambientLightColor;
+
+layout(location = 7) in vec4 var_fragPosLightSpace;
+layout(location = 8) in vec4 var_shadowProperties;
+
+// Material's textures are in the texture array and its data in the material storage buffer.
+// NOTE: textures[0] is always the shadowmap
+struct MaterialData
 {
     // x = specular strength
     // y = shininess
@@ -26,7 +26,21 @@ layout( std140 ) uniform MaterialData
     // x,y = texture offset
     // z,w = texture scale
     vec4 textureProperties;
-} materialData;
+
+    // Indices to the texture array
+    // x = diffuse, y = specular, z = normal, w = unused
+    uvec4 textureIndices;
+};
+layout(std430, set = 1, binding = 0) readonly buffer MaterialBuffer
+{
+    MaterialData materials[];
+};
+layout(set = 1, binding = 1) uniform sampler2D textures[];
+
+layout(push_constant) uniform PushConstants
+{
+    layout(offset = 128) uint materialIndex;
+} pushConstants;
 
 
 layout(location = 0) out vec4 outColor;
@@ -43,7 +57,10 @@ float calcShadow(float bias, int pcfCount)
     int texelCount =  texelsCount_width * texelsCount_width;
     vec2 texelSize = 1.0 / vec2(shadowmapWidth, shadowmapWidth);
 
-    vec3 shadowmapCoord = var_fragPosLightSpace.xyz / var_fragPosLightSpace.w;
+    // WHY THE FUCK DOES THIS WORK!!?!?!?!?!?!?!
+    vec4 flippedFragPosLightSpace = var_fragPosLightSpace;
+    flippedFragPosLightSpace.y *= -1.0;
+    vec3 shadowmapCoord = flippedFragPosLightSpace.xyz / flippedFragPosLightSpace.w;
     shadowmapCoord = 0.5 + 0.5 * shadowmapCoord;
 
     for (int x = -pcfCount; x <= pcfCount; x++)
@@ -54,25 +71,27 @@ float calcShadow(float bias, int pcfCount)
             if (sampleCoord.x > 1.0 || sampleCoord.x < 0.0 || sampleCoord.y > 1.0 || sampleCoord.y < 0.0)
                 continue;
 
-            float d = texture(shadowmapTexture, sampleCoord).r;
-            shadow += shadowmapCoord.z > d + bias  ? 1.0 : 0.0;
+            float d = texture(textures[0], sampleCoord).r;
+            shadow += var_fragPosLightSpace.z > d + bias  ? 1.0 : 0.0;
         }
     }
     shadow /= float(texelCount);
 
     // that weird far plane shadow
-    if (shadowmapCoord.z > 1.0)
+    if (var_fragPosLightSpace.z > 1.0)
         return 0.0;
     return shadow;
 }
 
 void main()
 {
+    MaterialData materialData = materials[pushConstants.materialIndex];
+
     vec2 finalTexCoord = var_texCoord * materialData.textureProperties.zw;
     finalTexCoord = finalTexCoord + materialData.textureProperties.xy;
 
-    vec4 diffuseTextureColor = texture(diffuseTextureSampler, finalTexCoord);
-    vec4 specularTextureColor = texture(specularTextureSampler, finalTexCoord);
+    vec4 diffuseTextureColor = texture(textures[materialData.textureIndices.x], finalTexCoord);
+    vec4 specularTextureColor = texture(textures[materialData.textureIndices.y], finalTexCoord);
 
     float specularStrength = materialData.lightingProperties.x;
     float shininess = materialData.lightingProperties.y;
@@ -104,6 +123,5 @@ void main()
     {
         discard;
     }
-
-    outColor = finalColor;;
+    outColor = finalColor;
 }
@@ -0,0 +1,133 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+
+layout(location = 0) in vec3 var_normal;
+layout(location = 1) in vec2 var_texCoord;
+layout(location = 2) in vec3 var_fragPos; // in tangent space
+layout(location = 3) in vec3 var_toCamera; // in tangent space
+layout(location = 4) in vec3 var_lightDir; // in tangent space
+layout(location = 5) in vec4 var_lightColor;
+layout(location = 6) in vec4 var_ambientLightColor;
+
+layout(location = 7) in mat3 var_toTangentSpace; // uses locations 7-9
+layout(location = 10) in vec4 var_tangent;
+
+layout(location = 11) in vec4 var_fragPosLightSpace;
+layout(location = 12) in vec4 var_shadowProperties;
+
+// Material's textures are in the texture array and its data in the material storage buffer.
+// NOTE: textures[0] is always the shadowmap
+struct MaterialData
+{
+    // x = specular strength
+    // y = shininess
+    // z = is shadeless
+    // w = unused
+    vec4 lightingProperties;
+
+    // x,y = texture offset
+    // z,w = texture scale
+    vec4 textureProperties;
+
+    // Indices to the texture array
+    // x = diffuse, y = specular, z = normal, w = unused
+    uvec4 textureIndices;
+};
+layout(std430, set = 1, binding = 0) readonly buffer MaterialBuffer
+{
+    MaterialData materials[];
+};
+layout(set = 1, binding = 1) uniform sampler2D textures[];
+
+layout(push_constant) uniform PushConstants
+{
+    layout(offset = 128) uint materialIndex;
+} pushConstants;
+
+
+layout(location = 0) out vec4 outColor;
+
+
+const float minBias = 0.0025;
+const float maxBias = 0.01;
+
+float calcShadow(float bias, int pcfCount)
+{
+    float shadow = 0.0;
+    int shadowmapWidth = int(var_shadowProperties.x);
+    int texelsCount_width = (2 * pcfCount + 1);
+    int texelCount =  texelsCount_width * texelsCount_width;
+    vec2 texelSize = 1.0 / vec2(shadowmapWidth, shadowmapWidth);
+
+    // WHY THE FUCK DOES THIS WORK!!?!?!?!?!?!?!
+    vec4 flippedFragPosLightSpace = var_fragPosLightSpace;
+    flippedFragPosLightSpace.y *= -1.0;
+    vec3 shadowmapCoord = flippedFragPosLightSpace.xyz / flippedFragPosLightSpace.w;
+    shadowmapCoord = 0.5 + 0.5 * shadowmapCoord;
+
+    for (int x = -pcfCount; x <= pcfCount; x++)
+    {
+        for (int y = -pcfCount; y <= pcfCount; y++)
+        {
+            vec2 sampleCoord = shadowmapCoord.xy + vec2(x, y) * texelSize;
+            if (sampleCoord.x > 1.0 || sampleCoord.x < 0.0 || sampleCoord.y > 1.0 || sampleCoord.y < 0.0)
+                continue;
+
+            float d = texture(textures[0], sampleCoord).r;
+            shadow += var_fragPosLightSpace.z > d + bias  ? 1.0 : 0.0;
+        }
+    }
+    shadow /= float(texelCount);
+
+    // that weird far plane shadow
+    if (var_fragPosLightSpace.z > 1.0)
+        return 0.0;
+    return shadow;
+}
+
+void main()
+{
+    MaterialData materialData = materials[pushConstants.materialIndex];
+
+    vec2 finalTexCoord = var_texCoord * materialData.textureProperties.zw;
+    finalTexCoord = finalTexCoord + materialData.textureProperties.xy;
+
+    vec4 diffuseTextureColor = texture(textures[materialData.textureIndices.x], finalTexCoord);
+    vec4 specularTextureColor = texture(textures[materialData.textureIndices.y], finalTexCoord);
+    vec4 normalTextureColor = texture(textures[materialData.textureIndices.z], finalTexCoord);
+
+    // Make it between -1 and 1
+    vec3 normalMapNormal = normalTextureColor.rgb * 2.0 - 1.0;
+    vec3 unitNormal = normalize(normalMapNormal);
+
+    float specularStrength = materialData.lightingProperties.x;
+    float shininess = materialData.lightingProperties.y;
+    float isShadeless = materialData.lightingProperties.z;
+
+    vec3 unitLightDir = normalize(var_lightDir.xyz);
+    vec3 toLight = -unitLightDir;
+    vec4 lightColor = vec4(var_lightColor.rgb, 1.0);
+
+    float diffuseFactor = max(dot(toLight, unitNormal), 0.0);
+    vec4 lightDiffuseColor = diffuseFactor * lightColor;
+
+    //vec3 reflectedLight = normalize(reflect(unitLightDir, unitNormal));
+    vec3 halfWay = normalize(toLight + var_toCamera);
+
+    float specularFactor = pow(max(dot(unitNormal, halfWay), 0.0), shininess);
+    vec4 specularColor = lightColor * specularFactor * specularStrength * specularTextureColor;
+
+    int shadowPCFSampleRadius = int(var_shadowProperties.y);
+    float shadowStrength = var_shadowProperties.z;
+    float bias = max(maxBias * (1.0 - dot(unitNormal, toLight)), minBias);
+    float shadow = min(calcShadow(bias, shadowPCFSampleRadius), shadowStrength);
+
+    vec4 finalColor = (var_ambientLightColor + (1.0 - shadow) * lightDiffuseColor + specularColor) * diffuseTextureColor;
+
+    if (diffuseTextureColor.a < 0.1)
+    {
+        discard;
+    }
+    outColor = finalColor;
+}
@@ -14,30 +14,30 @@ layout(location = 10) in vec4 var_tangent;
 layout(location = 11) in vec4 var_fragPosLightSpace;
 layout(location = 12) in vec4 var_shadowProperties;
 
-layout(set = 2, binding = 0) uniform sampler2D blendmapTexture;
+layout(set = 1, binding = 0) uniform sampler2D blendmapTexture;
 
-layout(set = 2, binding = 1) uniform sampler2D diffuseTextureChannel0;
-layout(set = 2, binding = 2) uniform sampler2D diffuseTextureChannel1;
-layout(set = 2, binding = 3) uniform sampler2D diffuseTextureChannel2;
-layout(set = 2, binding = 4) uniform sampler2D diffuseTextureChannel3;
-layout(set = 2, binding = 5) uniform sampler2D diffuseTextureChannel4;
+layout(set = 1, binding = 1) uniform sampler2D diffuseTextureChannel0;
+layout(set = 1, binding = 2) uniform sampler2D diffuseTextureChannel1;
+layout(set = 1, binding = 3) uniform sampler2D diffuseTextureChannel2;
+layout(set = 1, binding = 4) uniform sampler2D diffuseTextureChannel3;
+layout(set = 1, binding = 5) uniform sampler2D diffuseTextureChannel4;
 
-layout(set = 2, binding = 6) uniform sampler2D specularTextureChannel0;
-layout(set = 2, binding = 7) uniform sampler2D specularTextureChannel1;
-layout(set = 2, binding = 8) uniform sampler2D specularTextureChannel2;
-layout(set = 2, binding = 9) uniform sampler2D specularTextureChannel3;
-layout(set = 2, binding = 10) uniform sampler2D specularTextureChannel4;
+layout(set = 1, binding = 6) uniform sampler2D specularTextureChannel0;
+layout(set = 1, binding = 7) uniform sampler2D specularTextureChannel1;
+layout(set = 1, binding = 8) uniform sampler2D specularTextureChannel2;
+layout(set = 1, binding = 9) uniform sampler2D specularTextureChannel3;
+layout(set = 1, binding = 10) uniform sampler2D specularTextureChannel4;
 
-layout(set = 2, binding = 11) uniform sampler2D normalTextureChannel0;
-layout(set = 2, binding = 12) uniform sampler2D normalTextureChannel1;
-layout(set = 2, binding = 13) uniform sampler2D normalTextureChannel2;
-layout(set = 2, binding = 14) uniform sampler2D normalTextureChannel3;
-layout(set = 2, binding = 15) uniform sampler2D normalTextureChannel4;
+layout(set = 1, binding = 11) uniform sampler2D normalTextureChannel0;
+layout(set = 1, binding = 12) uniform sampler2D normalTextureChannel1;
+layout(set = 1, binding = 13) uniform sampler2D normalTextureChannel2;
+layout(set = 1, binding = 14) uniform sampler2D normalTextureChannel3;
+layout(set = 1, binding = 15) uniform sampler2D normalTextureChannel4;
 
-layout(set = 2, binding = 16) uniform sampler2D shadowmapTexture;
+layout(set = 1, binding = 16) uniform sampler2D shadowmapTexture;
 
 // NOTE: Not sure if need to pass that kind of material stuff here just yet
-layout(set = 2, binding = 17) uniform MaterialData
+layout(set = 1, binding = 17) uniform MaterialData
 {
     // x = specular strength
     // y = shininess
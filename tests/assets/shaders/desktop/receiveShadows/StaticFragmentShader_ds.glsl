@@ -15,10 +15,10 @@ layout(location = 7) in vec4 var_fragPosLightSpace;
 layout(location = 8) in vec4 var_shadowProperties;
 
 //layout(set = 1, binding = 0) uniform sampler2D textureSampler;
-layout(set = 2, binding = 0) uniform sampler2D diffuseTextureSampler;
-layout(set = 2, binding = 1) uniform sampler2D specularTextureSampler;
-layout(set = 2, binding = 2) uniform sampler2D shadowmapTexture;
-layout(set = 2, binding = 3) uniform MaterialData
+layout(set = 1, binding = 0) uniform sampler2D diffuseTextureSampler;
+layout(set = 1, binding = 1) uniform sampler2D specularTextureSampler;
+layout(set = 1, binding = 2) uniform sampler2D shadowmapTexture;
+layout(set = 1, binding = 3) uniform MaterialData
 {
     // x = specular strength
     // y = shininess
@@ -4,6 +4,7 @@ precision mediump float;
 layout(location = 0) in vec3 position;
 layout(location = 1) in vec3 normal;
 layout(location = 2) in vec2 texCoord;
+layout(location = 3) in mat4 transformationMatrix;
 
 layout(std140) uniform SceneData
 {
@@ -19,11 +20,6 @@ layout(std140) uniform SceneData
     float time;
 } sceneData;
 
-layout(std140) uniform InstanceData
-{
-    mat4 transformationMatrix;
-} instanceData;
-
 out vec3 var_normal;
 out vec2 var_texCoord;
 out vec3 var_fragPos;
@@ -34,9 +30,9 @@ out vec4 var_ambientLightColor;
 
 void main()
 {
-    vec4 translatedPos = instanceData.transformationMatrix * vec4(position, 1.0);
+    vec4 translatedPos = transformationMatrix * vec4(position, 1.0);
     gl_Position = sceneData.projectionMatrix * sceneData.viewMatrix * translatedPos;
-    vec4 rotatedNormal = instanceData.transformationMatrix * vec4(normal, 0.0);
+    vec4 rotatedNormal = transformationMatrix * vec4(normal, 0.0);
     var_normal = rotatedNormal.xyz;
 
     //float tileSize = instanceData.meshProperties.x;
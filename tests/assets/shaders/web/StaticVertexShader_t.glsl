@@ -5,6 +5,7 @@ layout(location = 0) in vec3 position;
 layout(location = 1) in vec3 normal;
 layout(location = 2) in vec2 texCoord;
 layout(location = 3) in vec4 tangent;
+layout(location = 4) in mat4 transformationMatrix;
 
 layout(std140) uniform SceneData
 {
@@ -20,11 +21,6 @@ layout(std140) uniform SceneData
     float time;
 } sceneData;
 
-layout(std140) uniform InstanceData
-{
-    mat4 transformationMatrix;
-} instanceData;
-
 out vec3 var_normal;
 out vec2 var_texCoord;
 out vec3 var_fragPos; // in tangent space
@@ -38,8 +34,8 @@ out vec4 var_tangent;
 
 void main()
 {
-    mat4 toCameraSpace = sceneData.viewMatrix * instanceData.transformationMatrix;
-    vec4 transformedPos = instanceData.transformationMatrix * vec4(position, 1.0);
+    mat4 toCameraSpace = sceneData.viewMatrix * transformationMatrix;
+    vec4 transformedPos = transformationMatrix * vec4(position, 1.0);
     gl_Position = sceneData.projectionMatrix * sceneData.viewMatrix * transformedPos;
 
     //float tileSize = instanceData.meshProperties.x;
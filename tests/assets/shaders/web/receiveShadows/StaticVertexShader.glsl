@@ -4,6 +4,7 @@ precision mediump float;
 layout(location = 0) in vec3 position;
 layout(location = 1) in vec3 normal;
 layout(location = 2) in vec2 texCoord;
+layout(location = 3) in mat4 transformationMatrix;
 
 struct PushConstants
 {
@@ -25,11 +26,6 @@ layout(std140) uniform SceneData
     vec4 shadowProperties;
 } sceneData;
 
-layout(std140) uniform InstanceData
-{
-    mat4 transformationMatrix;
-} instanceData;
-
 out vec3 var_normal;
 out vec2 var_texCoord;
 out vec3 var_fragPos;
@@ -43,9 +39,9 @@ out vec4 var_shadowProperties;
 
 void main()
 {
-    vec4 transformedPos = instanceData.transformationMatrix * vec4(position, 1.0);
+    vec4 transformedPos = transformationMatrix * vec4(position, 1.0);
     gl_Position = sceneData.projectionMatrix * sceneData.viewMatrix * transformedPos;
-    vec4 rotatedNormal = instanceData.transformationMatrix * vec4(normal, 0.0);
+    vec4 rotatedNormal = transformationMatrix * vec4(normal, 0.0);
     var_normal = rotatedNormal.xyz;
     var_texCoord = texCoord;
     var_fragPos = transformedPos.xyz;
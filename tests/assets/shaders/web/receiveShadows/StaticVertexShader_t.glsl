@@ -5,6 +5,7 @@ layout(location = 0) in vec3 position;
 layout(location = 1) in vec3 normal;
 layout(location = 2) in vec2 texCoord;
 layout(location = 3) in vec4 tangent;
+layout(location = 4) in mat4 transformationMatrix;
 
 struct PushConstants
 {
@@ -26,11 +27,6 @@ layout(std140) uniform SceneData
     vec4 shadowProperties;
 } sceneData;
 
-layout(std140) uniform InstanceData
-{
-    mat4 transformationMatrix;
-} instanceData;
-
 out vec3 var_normal;
 out vec2 var_texCoord;
 out vec3 var_fragPos; // in tangent space
@@ -47,8 +43,8 @@ out vec4 var_shadowProperties;
 
 void main()
 {
-    mat4 toCameraSpace = sceneData.viewMatrix * instanceData.transformationMatrix;
-    vec4 transformedPos = instanceData.transformationMatrix * vec4(position, 1.0);
+    mat4 toCameraSpace = sceneData.viewMatrix * transformationMatrix;
+    vec4 transformedPos = transformationMatrix * vec4(position, 1.0);
     gl_Position = sceneData.projectionMatrix * sceneData.viewMatrix * transformedPos;
 
     //const float tileSize = instanceData.meshProperties.x;
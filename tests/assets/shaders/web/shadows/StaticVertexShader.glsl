@@ -2,6 +2,7 @@
 precision mediump float;
 
 layout(location = 0) in vec3 position;
+layout(location = 1) in mat4 transformationMatrix;
 
 struct PushConstants
 {
@@ -10,12 +11,7 @@ struct PushConstants
 };
 uniform PushConstants pushConstants;
 
-layout (std140) uniform InstanceData
-{
-    mat4 transformationMatrix;
-} instanceData;
-
 void main()
 {
-    gl_Position = pushConstants.projectionMatrix * pushConstants.viewMatrix * instanceData.transformationMatrix * vec4(position, 1.0);
+    gl_Position = pushConstants.projectionMatrix * pushConstants.viewMatrix * transformationMatrix * vec4(position, 1.0);
 }
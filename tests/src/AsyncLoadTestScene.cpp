@@ -0,0 +1,179 @@
+#include "AsyncLoadTestScene.hpp"
+#include "SkinnedMeshTestScene.hpp"
+#include <string>
+#include <algorithm>
+
+
+using namespace platypus;
+
+
+AsyncLoadTestScene::AsyncLoadTestScene()
+{
+}
+
+AsyncLoadTestScene::~AsyncLoadTestScene()
+{
+}
+
+void AsyncLoadTestScene::init()
+{
+    Debug::log("___TEST___init AsyncLoadTestScene");
+    initBase();
+
+    AssetManager* pAssetManager = Application::get_instance()->getAssetManager();
+
+    _cameraController.init(_cameraEntity);
+    _cameraController.set(
+        0.6f,    // pitch
+        0.0f,    // yaw
+        0.0025f, // rot speed
+        40.0f,   // zoom
+        120.0f,  // max zoom
+        1.25f    // zoom speed
+    );
+    _cameraController.setOffsetPos({ 0, 0, 0 });
+
+    const TextureSampler* pSampler = pAssetManager->getOrCreateTextureSampler(
+        TextureSamplerFilterMode::SAMPLER_FILTER_MODE_LINEAR,
+        TextureSamplerAddressMode::SAMPLER_ADDRESS_MODE_REPEAT,
+        true
+    );
+
+    // All of these return immediately, the files get read and decoded on the background queue
+    _modelFuture = pAssetManager->loadModelAsync("assets/TestCube.glb", false, "AsyncCube");
+    _diffuseTextureFuture = pAssetManager->loadTextureAsync(
+        "assets/textures/DiffuseTest.png",
+        ImageFormat::R8G8B8A8_SRGB,
+        pSampler
+    );
+    _specularTextureFuture = pAssetManager->loadTextureAsync(
+        "assets/textures/characterTest.png",
+        ImageFormat::R8G8B8A8_SRGB,
+        pSampler
+    );
+
+    const AssetFuture diffuseTextureFuture = _diffuseTextureFuture;
+    const AssetFuture specularTextureFuture = _specularTextureFuture;
+    _materialFuture = pAssetManager->whenLoaded(
+        { diffuseTextureFuture, specularTextureFuture },
+        [pAssetManager, diffuseTextureFuture, specularTextureFuture]()
+        {
+            return pAssetManager->createMaterial(
+                NULL_UUID,
+                { diffuseTextureFuture.getID() },
+                { specularTextureFuture.getID() },
+                { },
+                0.8f,
+                16.0f
+            );
+        }
+    );
+
+    _missingTextureFuture = pAssetManager->loadTextureAsync(
+        "assets/textures/AsyncLoadTestMissing.png",
+        ImageFormat::R8G8B8A8_SRGB,
+        pSampler
+    );
+
+    Light* pDirLight = (Light*)getComponent(
+        _lightEntity,
+        ComponentType::COMPONENT_TYPE_LIGHT
+    );
+    pDirLight->direction = { 0.75f, -1.5f, 1.0f };
+
+    Debug::log(
+        "___TEST___AsyncLoadTestScene "
+        "Pending async loads after init: " + std::to_string(pAssetManager->getPendingAsyncLoadCount())
+    );
+}
+
+void AsyncLoadTestScene::update()
+{
+    _cameraController.update();
+
+    Application* pApp = Application::get_instance();
+    InputManager& inputManager = pApp->getInputManager();
+    if (inputManager.isKeyDown(KeyName::KEY_0))
+    {
+        pApp->getSceneManager().assignNextScene(new SkinnedMeshTestScene);
+        return;
+    }
+
+    if (!_missingTextureChecked && _missingTextureFuture.isDone())
+    {
+        _missingTextureChecked = true;
+        if (_missingTextureFuture.hasFailed())
+        {
+            Debug::log(
+                "___TEST___AsyncLoadTestScene "
+                "Missing texture failed as expected: " + _missingTextureFuture.getError()
+            );
+        }
+        else
+        {
+            Debug::log(
+                "___TEST___AsyncLoadTestScene Missing texture didn't fail!",
+                Debug::MessageType::PLATYPUS_ERROR
+            );
+        }
+    }
+
+    if (_entitiesCreated)
+        return;
+
+    // NOTE: Loads get finalized by the Application before the scene's update
+    // -> the first frame's delta time includes init
+    const float deltaTime = Timing::get_delta_time();
+    if (_loadingFrames > 0)
+        _maxLoadingFrameTime = std::max(_maxLoadingFrameTime, deltaTime);
+    _loadingTime += deltaTime;
+    ++_loadingFrames;
+
+    if (!_modelFuture.isDone() || !_materialFuture.isDone())
+        return;
+
+    _entitiesCreated = true;
+    if (_modelFuture.hasFailed() || _materialFuture.hasFailed())
+    {
+        const std::string error = _modelFuture.hasFailed() ? _modelFuture.getError() : _materialFuture.getError();
+        Debug::log(
+            "___TEST___AsyncLoadTestScene Failed to load assets: " + error,
+            Debug::MessageType::PLATYPUS_ERROR
+        );
+        return;
+    }
+
+    createEntities();
+
+    const AssetManager* pAssetManager = pApp->getAssetManager();
+    Debug::log(
+        "___TEST___AsyncLoadTestScene "
+        "Assets loaded in " + std::to_string(_loadingTime * 1000.0f) + "ms "
+        "over " + std::to_string(_loadingFrames) + " frames, "
+        "longest frame: " + std::to_string(_maxLoadingFrameTime * 1000.0f) + "ms "
+        "(async load budget: " + std::to_string(pAssetManager->getAsyncLoadBudget()) + "ms)"
+    );
+}
+
+void AsyncLoadTestScene::createEntities()
+{
+    Model* pModel = _modelFuture.getAs<Model>();
+    const UUID_t meshID = pModel->getMeshes()[0]->getID();
+    const UUID_t materialID = _materialFuture.getID();
+
+    const float spacing = 3.0f;
+    const float offset = (float)_gridWidth * spacing * 0.5f;
+    for (int x = 0; x < _gridWidth; ++x)
+    {
+        for (int z = 0; z < _gridWidth; ++z)
+        {
+            createStaticMeshEntity(
+                { x * spacing - offset, 0, z * spacing - offset },
+                { { 0, 1, 0 }, 0.0f },
+                { 1, 1, 1 },
+                meshID,
+                materialID
+            );
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "platypus/Platypus.h"
+#include "BaseScene.hpp"
+
+
+// Loads the scene's assets using AssetManager's async load funcs and creates
+// the entities once they've been finalized.
+//
+// The material gets created with whenLoaded after its textures. Also requests
+// a texture that doesn't exist to test the failing of loads.
+// Logs the time it took for everything to load and the longest frame during
+// the loading, which should stay around the async load budget.
+class AsyncLoadTestScene : public BaseScene
+{
+private:
+    const int _gridWidth = 8;
+
+    platypus::AssetFuture _modelFuture;
+    platypus::AssetFuture _diffuseTextureFuture;
+    platypus::AssetFuture _specularTextureFuture;
+    platypus::AssetFuture _materialFuture;
+    platypus::AssetFuture _missingTextureFuture;
+
+    size_t _loadingFrames = 0;
+    float _loadingTime = 0.0f;
+    float _maxLoadingFrameTime = 0.0f;
+    bool _entitiesCreated = false;
+    bool _missingTextureChecked = false;
+
+public:
+    AsyncLoadTestScene();
+    ~AsyncLoadTestScene();
+
+    virtual void init();
+    virtual void update();
+
+private:
+    void createEntities();
+};
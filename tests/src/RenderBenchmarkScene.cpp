@@ -0,0 +1,191 @@
+#include "RenderBenchmarkScene.hpp"
+#include "SkinnedMeshTestScene.hpp"
+#include <string>
+
+
+using namespace platypus;
+
+
+RenderBenchmarkScene::RenderBenchmarkScene()
+{
+}
+
+RenderBenchmarkScene::~RenderBenchmarkScene()
+{
+}
+
+void RenderBenchmarkScene::init()
+{
+    Debug::log("___TEST___init RenderBenchmarkScene");
+    initBase();
+
+    AssetManager* pAssetManager = Application::get_instance()->getAssetManager();
+
+    _cameraController.init(_cameraEntity);
+    _cameraController.set(
+        0.6f,    // pitch
+        0.0f,    // yaw
+        0.0025f, // rot speed
+        120.0f,  // zoom
+        240.0f,  // max zoom
+        1.25f    // zoom speed
+    );
+    _cameraController.setOffsetPos({ 0, 0, 0 });
+
+    Mesh* pMesh = pAssetManager->loadModel("assets/TestCube.glb", false, "BenchmarkCube")->getMeshes()[0];
+
+    // Each material gets its own batches
+    const TextureSampler* pSampler = pAssetManager->getOrCreateTextureSampler(
+        TextureSamplerFilterMode::SAMPLER_FILTER_MODE_LINEAR,
+        TextureSamplerAddressMode::SAMPLER_ADDRESS_MODE_REPEAT,
+        true
+    );
+    Texture* pTexture = pAssetManager->loadTexture(
+        "assets/textures/characterTest.png",
+        ImageFormat::R8G8B8A8_SRGB,
+        pSampler
+    );
+    std::vector<UUID_t> materialIDs;
+    for (size_t i = 0; i < _materialCount; ++i)
+    {
+        Material* pMaterial = pAssetManager->createMaterial(
+            NULL_UUID,
+            { pTexture->getID() },
+            { pAssetManager->getWhiteTexture()->getID() },
+            { },
+            0.625f, // specular strength
+            16.0f, // shininess
+            { 0, 0 },
+            { 1, 1 },
+            true, // cast shadows
+            false, // receive shadows
+            false, // transparent
+            false // shadeless
+        );
+        materialIDs.push_back(pMaterial->getID());
+    }
+
+    const float spacing = 3.0f;
+    const float offset = (float)_gridWidth * spacing * 0.5f;
+    for (int x = 0; x < _gridWidth; ++x)
+    {
+        for (int z = 0; z < _gridWidth; ++z)
+        {
+            createStaticMeshEntity(
+                { x * spacing - offset, 0, z * spacing - offset },
+                { { 0, 1, 0 }, 0.0f },
+                { 1, 1, 1 },
+                pMesh->getID(),
+                materialIDs[(size_t)(x * _gridWidth + z) % _materialCount]
+            );
+        }
+    }
+
+    Light* pDirLight = (Light*)getComponent(
+        _lightEntity,
+        ComponentType::COMPONENT_TYPE_LIGHT
+    );
+    pDirLight->direction = { 0.75f, -1.5f, 1.0f };
+
+    // Recording all batches regardless of where the camera is looking at
+    Application::get_instance()->getMasterRenderer()->setFrustumCulling(false);
+
+    _maxWorkerCount = JobSystem::get_default_worker_count();
+    _currentWorkerCount = 0;
+    Application::get_instance()->getJobSystem().setWorkerCount(_currentWorkerCount);
+
+    Debug::log(
+        "___TEST___RenderBenchmarkScene "
+        "Benchmarking " + std::to_string(_gridWidth * _gridWidth) + " cubes "
+        "with " + std::to_string(_materialCount) + " materials "
+        "using 0.." + std::to_string(_maxWorkerCount) + " workers"
+    );
+}
+
+void RenderBenchmarkScene::update()
+{
+    _cameraController.update();
+
+    Application* pApp = Application::get_instance();
+    InputManager& inputManager = pApp->getInputManager();
+    if (inputManager.isKeyDown(KeyName::KEY_0))
+    {
+        pApp->getMasterRenderer()->setFrustumCulling(true);
+        pApp->getJobSystem().setWorkerCount(JobSystem::get_default_worker_count());
+        pApp->getSceneManager().assignNextScene(new SkinnedMeshTestScene);
+        return;
+    }
+
+    if (_finished)
+        return;
+
+    ++_frameCount;
+    if (_frameCount <= _warmupFrames)
+        return;
+
+    // NOTE: This is the previous frame's recording time since rendering
+    // happens after the scene's update
+    const MasterRenderer* pMasterRenderer = pApp->getMasterRenderer();
+    _recordingTimeSum += pMasterRenderer->getRecordingTime();
+    _frameTimeSum += Timing::get_delta_time();
+
+    if (_frameCount < _warmupFrames + _samplesPerStep)
+        return;
+
+    const RenderQueueStatistics& shadowStatistics = pMasterRenderer->getRenderQueueStatistics(RenderPassType::SHADOW_PASS);
+    const RenderQueueStatistics& opaqueStatistics = pMasterRenderer->getRenderQueueStatistics(RenderPassType::OPAQUE_PASS);
+
+    BenchmarkResult result;
+    result.workerCount = _currentWorkerCount;
+    result.avgRecordingTime = _recordingTimeSum / (float)_samplesPerStep;
+    result.avgFrameTime = _frameTimeSum / (float)_samplesPerStep;
+    result.batchCount = shadowStatistics.batchCount + opaqueStatistics.batchCount;
+    result.drawCount = shadowStatistics.drawCount + opaqueStatistics.drawCount;
+    _results.push_back(result);
+
+    Debug::log(
+        "___TEST___RenderBenchmarkScene "
+        "workers: " + std::to_string(result.workerCount) + " "
+        "avg recording time: " + std::to_string(result.avgRecordingTime * 1000.0f) + "ms "
+        "avg frame time: " + std::to_string(result.avgFrameTime * 1000.0f) + "ms "
+        "batches: " + std::to_string(result.batchCount) + " "
+        "draws: " + std::to_string(result.drawCount)
+    );
+
+    _frameCount = 0;
+    _recordingTimeSum = 0.0f;
+    _frameTimeSum = 0.0f;
+
+    JobSystem& jobSystem = pApp->getJobSystem();
+    if (_currentWorkerCount < _maxWorkerCount)
+    {
+        ++_currentWorkerCount;
+        jobSystem.setWorkerCount(_currentWorkerCount);
+    }
+    else
+    {
+        _finished = true;
+        logResults();
+        jobSystem.setWorkerCount(JobSystem::get_default_worker_count());
+    }
+}
+
+void RenderBenchmarkScene::logResults() const
+{
+    if (_results.empty())
+        return;
+
+    const float baseTime = _results[0].avgRecordingTime;
+    std::string summary = "___TEST___RenderBenchmarkScene results:\n";
+    for (const BenchmarkResult& result : _results)
+    {
+        const float speedup = result.avgRecordingTime > 0.0f ? baseTime / result.avgRecordingTime : 0.0f;
+        summary += "    workers: " + std::to_string(result.workerCount) + " "
+            "recording: " + std::to_string(result.avgRecordingTime * 1000.0f) + "ms "
+            "frame: " + std::to_string(result.avgFrameTime * 1000.0f) + "ms "
+            "batches: " + std::to_string(result.batchCount) + " "
+            "draws: " + std::to_string(result.drawCount) + " "
+            "speedup: " + std::to_string(speedup) + "x\n";
+    }
+    Debug::log(summary);
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "platypus/Platypus.h"
+#include "BaseScene.hpp"
+
+
+// Measures how the CPU time of recording the 3D render passes' command buffers
+// scales with the JobSystem's worker count.
+//
+// Creates a grid of cubes using many different materials (-> many batches per pass)
+// and steps through worker counts 0..max, sampling each for a fixed number of frames.
+// Results are logged after each step and as a summary at the end.
+//
+// NOTE: Runs on software Vulkan implementations as well, for example with lavapipe:
+//  PLATYPUS_DEVICE=llvmpipe
+class RenderBenchmarkScene : public BaseScene
+{
+private:
+    struct BenchmarkResult
+    {
+        size_t workerCount = 0;
+        float avgRecordingTime = 0.0f;
+        float avgFrameTime = 0.0f;
+        size_t batchCount = 0;
+        size_t drawCount = 0;
+    };
+
+    const size_t _materialCount = 256;
+    const int _gridWidth = 48;
+    const size_t _samplesPerStep = 240;
+    // Skipping few frames after changing worker count
+    const size_t _warmupFrames = 30;
+
+    size_t _maxWorkerCount = 0;
+    size_t _currentWorkerCount = 0;
+    size_t _frameCount = 0;
+    float _recordingTimeSum = 0.0f;
+    float _frameTimeSum = 0.0f;
+    bool _finished = false;
+
+    std::vector<BenchmarkResult> _results;
+
+public:
+    RenderBenchmarkScene();
+    ~RenderBenchmarkScene();
+
+    virtual void init();
+    virtual void update();
+
+private:
+    void logResults() const;
+};
@@ -1,5 +1,8 @@
 #include "SkinnedMeshTestScene.hpp"
 #include "WaterTestScene.hpp"
+#include "SystemBenchmarkScene.hpp"
+#include "RenderBenchmarkScene.hpp"
+#include "AsyncLoadTestScene.hpp"
 #include <string>
 
 
@@ -268,4 +271,16 @@ void SkinnedMeshTestScene::update()
     {
         Application::get_instance()->getSceneManager().assignNextScene(new WaterTestScene);
     }
+    else if (inputManager.isKeyDown(KeyName::KEY_9))
+    {
+        Application::get_instance()->getSceneManager().assignNextScene(new SystemBenchmarkScene);
+    }
+    else if (inputManager.isKeyDown(KeyName::KEY_8))
+    {
+        Application::get_instance()->getSceneManager().assignNextScene(new RenderBenchmarkScene);
+    }
+    else if (inputManager.isKeyDown(KeyName::KEY_7))
+    {
+        Application::get_instance()->getSceneManager().assignNextScene(new AsyncLoadTestScene);
+    }
 }
@@ -0,0 +1,188 @@
+#include "SystemBenchmarkScene.hpp"
+#include "SkinnedMeshTestScene.hpp"
+#include <string>
+
+
+using namespace platypus;
+
+
+SystemBenchmarkScene::SystemBenchmarkScene()
+{
+}
+
+SystemBenchmarkScene::~SystemBenchmarkScene()
+{
+}
+
+void SystemBenchmarkScene::init()
+{
+    Debug::log("___TEST___init SystemBenchmarkScene");
+    initBase();
+
+    AssetManager* pAssetManager = Application::get_instance()->getAssetManager();
+
+    _cameraController.init(_cameraEntity);
+    _cameraController.set(
+        0.4f,    // pitch
+        0.0f,    // yaw
+        0.0025f, // rot speed
+        60.0f,   // zoom
+        120.0f,  // max zoom
+        1.25f    // zoom speed
+    );
+    _cameraController.setOffsetPos({ 0, 0, 0 });
+
+    Model* pAnimatedModel = pAssetManager->loadModel(
+        "assets/models/MultiAnimSkeletonTest.glb",
+        false,
+        "AnimatedModel"
+    );
+    Mesh* pAnimatedMesh = pAnimatedModel->getMeshes()[0];
+    Skeleton* pSkeleton = pAnimatedMesh->getSkeleton();
+    std::vector<UUID_t> animationIDs = pSkeleton->getAnimationIDs();
+    SkeletalAnimationData* pAnimationAsset = (SkeletalAnimationData*)pAssetManager->getAsset(
+        animationIDs.back(),
+        AssetType::ASSET_TYPE_SKELETAL_ANIMATION_DATA
+    );
+
+    Material* pMaterial = createMeshMaterial(
+        pAssetManager,
+        "assets/textures/characterTest.png"
+    );
+
+    const float spacing = 3.0f;
+    const float offset = (float)_gridWidth * spacing * 0.5f;
+    for (int x = 0; x < _gridWidth; ++x)
+    {
+        for (int z = 0; z < _gridWidth; ++z)
+        {
+            std::vector<entityID_t> jointEntities;
+            createSkinnedMeshEntity(
+                { x * spacing - offset, 0, z * spacing - offset },
+                { { 0, 1, 0 }, 0.0f },
+                { 1, 1, 1 },
+                pAnimatedMesh,
+                pAnimationAsset,
+                pMaterial->getID(),
+                jointEntities
+            );
+        }
+    }
+
+    Light* pDirLight = (Light*)getComponent(
+        _lightEntity,
+        ComponentType::COMPONENT_TYPE_LIGHT
+    );
+    pDirLight->direction = { 0.75f, -1.5f, 1.0f };
+
+    _maxWorkerCount = JobSystem::get_default_worker_count();
+    _currentWorkerCount = 0;
+    Application::get_instance()->getJobSystem().setWorkerCount(_currentWorkerCount);
+
+    Debug::log(
+        "___TEST___SystemBenchmarkScene "
+        "Benchmarking " + std::to_string(_gridWidth * _gridWidth) + " skinned meshes "
+        "using 0.." + std::to_string(_maxWorkerCount) + " workers"
+    );
+}
+
+void SystemBenchmarkScene::update()
+{
+    _cameraController.update();
+
+    InputManager& inputManager = Application::get_instance()->getInputManager();
+    if (inputManager.isKeyDown(KeyName::KEY_0))
+    {
+        Application::get_instance()->getJobSystem().setWorkerCount(JobSystem::get_default_worker_count());
+        Application::get_instance()->getSceneManager().assignNextScene(new SkinnedMeshTestScene);
+        return;
+    }
+
+    // Toggling LOD doesn't restart the benchmark -> only affects the following steps
+    if (inputManager.isKeyDown(KeyName::KEY_L))
+    {
+        if (!_lodKeyDown)
+        {
+            animationLODProperties.enabled = !animationLODProperties.enabled;
+            Debug::log(
+                "___TEST___SystemBenchmarkScene animation LOD " + std::string(animationLODProperties.enabled ? "enabled" : "disabled")
+            );
+        }
+        _lodKeyDown = true;
+    }
+    else
+    {
+        _lodKeyDown = false;
+    }
+
+    if (_finished)
+        return;
+
+    ++_frameCount;
+    if (_frameCount <= _warmupFrames)
+        return;
+
+    // NOTE: This is the previous frame's systems update time since systems
+    // are updated after the scene
+    _systemsTimeSum += getSystemScheduler().getLastUpdateTime();
+    _frameTimeSum += Timing::get_delta_time();
+    _evaluatedJointsSum += getAnimationStatistics().evaluatedJointCount;
+
+    if (_frameCount < _warmupFrames + _samplesPerStep)
+        return;
+
+    BenchmarkResult result;
+    result.workerCount = _currentWorkerCount;
+    result.avgSystemsTime = _systemsTimeSum / (float)_samplesPerStep;
+    result.avgFrameTime = _frameTimeSum / (float)_samplesPerStep;
+    result.avgEvaluatedJoints = (float)_evaluatedJointsSum / (float)_samplesPerStep;
+    result.animationLOD = animationLODProperties.enabled;
+    _results.push_back(result);
+
+    Debug::log(
+        "___TEST___SystemBenchmarkScene "
+        "workers: " + std::to_string(result.workerCount) + " "
+        "avg systems time: " + std::to_string(result.avgSystemsTime * 1000.0f) + "ms "
+        "avg frame time: " + std::to_string(result.avgFrameTime * 1000.0f) + "ms "
+        "avg joints evaluated: " + std::to_string(result.avgEvaluatedJoints) + " "
+        "animation LOD: " + std::string(result.animationLOD ? "on" : "off")
+    );
+
+    _frameCount = 0;
+    _systemsTimeSum = 0.0f;
+    _frameTimeSum = 0.0f;
+    _evaluatedJointsSum = 0;
+
+    JobSystem& jobSystem = Application::get_instance()->getJobSystem();
+    if (_currentWorkerCount < _maxWorkerCount)
+    {
+        ++_currentWorkerCount;
+        jobSystem.setWorkerCount(_currentWorkerCount);
+    }
+    else
+    {
+        _finished = true;
+        logResults();
+        jobSystem.setWorkerCount(JobSystem::get_default_worker_count());
+    }
+}
+
+void SystemBenchmarkScene::logResults() const
+{
+    if (_results.empty())
+        return;
+
+    const float baseTime = _results[0].avgSystemsTime;
+    std::string summary = "___TEST___SystemBenchmarkScene results:\n";
+    for (const BenchmarkResult& result : _results)
+    {
+        const float speedup = result.avgSystemsTime > 0.0f ? baseTime / result.avgSystemsTime : 0.0f;
+        summary += "    workers: " + std::to_string(result.workerCount) + " "
+            "systems: " + std::to_string(result.avgSystemsTime * 1000.0f) + "ms "
+            "frame: " + std::to_string(result.avgFrameTime * 1000.0f) + "ms "
+            "joints: " + std::to_string(result.avgEvaluatedJoints) + " "
+            "LOD: " + std::string(result.animationLOD ? "on" : "off") + " "
+            "speedup: " + std::to_string(speedup) + "x\n";
+    }
+    Debug::log(summary);
+}
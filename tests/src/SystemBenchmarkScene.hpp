@@ -0,0 +1,51 @@
+#pragma once
+
+#include "platypus/Platypus.h"
+#include "BaseScene.hpp"
+
+
+// Measures how systems' update time scales with the JobSystem's worker count.
+//
+// Creates a grid of animated skinned meshes and steps through worker counts
+// 0..max, sampling each for a fixed number of frames. Results are logged
+// after each step and as a summary at the end.
+//
+// Press L to toggle animation LOD for the following steps.
+class SystemBenchmarkScene : public BaseScene
+{
+private:
+    struct BenchmarkResult
+    {
+        size_t workerCount = 0;
+        float avgSystemsTime = 0.0f;
+        float avgFrameTime = 0.0f;
+        float avgEvaluatedJoints = 0.0f;
+        bool animationLOD = false;
+    };
+
+    const int _gridWidth = 20;
+    const size_t _samplesPerStep = 240;
+    // Skipping few frames after changing worker count
+    const size_t _warmupFrames = 30;
+
+    size_t _maxWorkerCount = 0;
+    size_t _currentWorkerCount = 0;
+    size_t _frameCount = 0;
+    float _systemsTimeSum = 0.0f;
+    float _frameTimeSum = 0.0f;
+    size_t _evaluatedJointsSum = 0;
+    bool _finished = false;
+    bool _lodKeyDown = false;
+
+    std::vector<BenchmarkResult> _results;
+
+public:
+    SystemBenchmarkScene();
+    ~SystemBenchmarkScene();
+
+    virtual void init();
+    virtual void update();
+
+private:
+    void logResults() const;
+};